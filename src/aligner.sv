@@ -0,0 +1,131 @@
+/*           __        _
+ *  ________/ /  ___ _(_)__  ___
+ * / __/ __/ _ \/ _ `/ / _ \/ -_)
+ * \__/\__/_//_/\_,_/_/_//_/\__/
+ *
+ * Copyright (C) Clément Chaine
+ * This file is part of ECAP5-DPROC <https://github.com/ecap5/ECAP5-DPROC>
+ *
+ * ECAP5-DPROC is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ECAP5-DPROC is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ECAP5-DPROC.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+module aligner (
+  input   logic        clk_i,
+  input   logic        rst_i,
+  // Flush request
+  input   logic        flush_i,
+  // Input handshake
+  output  logic        input_ready_o,
+  input   logic        input_valid_i,
+  // Fetch inputs
+  input   logic[31:0]  instr_i,
+  input   logic[31:0]  pc_i,
+  // Output handshake
+  input   logic        output_ready_i,
+  output  logic        output_valid_o,
+  // Decode outputs
+  output  logic[31:0]  instr_o,
+  output  logic[31:0]  pc_o,
+  output  logic        compressed_o
+);
+
+/*****************************************/
+/*            Internal signals           */
+/*****************************************/
+logic[15:0]  half_d,        half_q;         // Upper half of the last word
+logic[31:0]  half_pc_d,     half_pc_q;
+logic        half_valid_d,  half_valid_q /* verilator public */;
+
+/*
+ * The input words are split into 16-bit halves, the upper half of a word being
+ * held until it is either output as a compressed instruction or concatenated
+ * with the lower half of the next word. A word fetched with bit 1 of its
+ * address set, after a jump, only provides its upper half.
+ */
+always_comb begin : alignment
+  half_d       = half_q;
+  half_pc_d    = half_pc_q;
+  half_valid_d = half_valid_q;
+
+  if(half_valid_q) begin
+    if(half_q[1:0] != 2'b11) begin
+      // The held half is a compressed instruction, the input word is kept
+      output_valid_o = 1;
+      instr_o        = {16'h0, half_q};
+      pc_o           = half_pc_q;
+      compressed_o   = 1;
+      input_ready_o  = 0;
+      if(output_ready_i) begin
+        half_valid_d = 0;
+      end
+    end else begin
+      // The held half is the lower half of an instruction crossing a word
+      output_valid_o = input_valid_i;
+      instr_o        = {instr_i[15:0], half_q};
+      pc_o           = half_pc_q;
+      compressed_o   = 0;
+      input_ready_o  = output_ready_i;
+      if(input_valid_i && output_ready_i) begin
+        half_d    = instr_i[31:16];
+        half_pc_d = {pc_i[31:2], 2'b10};
+      end
+    end
+  end else if(pc_i[1]) begin
+    output_valid_o = input_valid_i && (instr_i[17:16] != 2'b11);
+    instr_o        = {16'h0, instr_i[31:16]};
+    pc_o           = pc_i;
+    compressed_o   = 1;
+    if(instr_i[17:16] != 2'b11) begin
+      input_ready_o = output_ready_i;
+    end else begin
+      // The upper half is held until the next word is received
+      input_ready_o = 1;
+      if(input_valid_i) begin
+        half_d       = instr_i[31:16];
+        half_pc_d    = pc_i;
+        half_valid_d = 1;
+      end
+    end
+  end else begin
+    output_valid_o = input_valid_i;
+    instr_o        = instr_i;
+    pc_o           = pc_i;
+    compressed_o   = (instr_i[1:0] != 2'b11);
+    input_ready_o  = output_ready_i;
+    if(compressed_o && input_valid_i && output_ready_i) begin
+      // The upper half holds the next instruction
+      half_d       = instr_i[31:16];
+      half_pc_d    = {pc_i[31:2], 2'b10};
+      half_valid_d = 1;
+    end
+  end
+
+  if(flush_i) begin
+    half_valid_d = 0;
+  end
+end
+
+always_ff @(posedge clk_i) begin
+  if(rst_i) begin
+    half_q        <=  '0;
+    half_pc_q     <=  '0;
+    half_valid_q  <=   0;
+  end else begin
+    half_q        <=  half_d;
+    half_pc_q     <=  half_pc_d;
+    half_valid_q  <=  half_valid_d;
+  end
+end
+
+endmodule // aligner
@@ -0,0 +1,225 @@
+/*           __        _
+ *  ________/ /  ___ _(_)__  ___
+ * / __/ __/ _ \/ _ `/ / _ \/ -_)
+ * \__/\__/_//_/\_,_/_/_//_/\__/
+ * 
+ * Copyright (C) Clément Chaine
+ * This file is part of ECAP5-DPROC <https://github.com/ecap5/ECAP5-DPROC>
+ *
+ * ECAP5-DPROC is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ECAP5-DPROC is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ECAP5-DPROC.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+module axi_bridge #(
+  parameter int OUTSTANDING_DEPTH = 4
+)(
+  input   logic        clk_i,
+  input   logic        rst_i,
+
+  //=================================
+  //    Slave port
+  //
+  // Wishbone pipelined requests, the data of byte and halfword accesses
+  // being aligned on the least significant bits.
+
+  input   logic[31:0]  s_wb_adr_i,
+  output  logic[31:0]  s_wb_dat_o,
+  input   logic[31:0]  s_wb_dat_i,
+  input   logic        s_wb_we_i,
+  input   logic[3:0]   s_wb_sel_i,
+  input   logic        s_wb_stb_i,
+  output  logic        s_wb_ack_o,
+  input   logic        s_wb_cyc_i,
+  output  logic        s_wb_stall_o,
+
+  //=================================
+  //    Master port
+  //
+  // AXI4 single-beat transactions, the data being placed on the byte lanes
+  // selected by the address.
+
+  output  logic[31:0]  m_axi_awaddr_o,
+  output  logic[7:0]   m_axi_awlen_o,
+  output  logic[2:0]   m_axi_awsize_o,
+  output  logic[1:0]   m_axi_awburst_o,
+  output  logic        m_axi_awvalid_o,
+  input   logic        m_axi_awready_i,
+
+  output  logic[31:0]  m_axi_wdata_o,
+  output  logic[3:0]   m_axi_wstrb_o,
+  output  logic        m_axi_wlast_o,
+  output  logic        m_axi_wvalid_o,
+  input   logic        m_axi_wready_i,
+
+  input   logic[1:0]   m_axi_bresp_i,
+  input   logic        m_axi_bvalid_i,
+  output  logic        m_axi_bready_o,
+
+  output  logic[31:0]  m_axi_araddr_o,
+  output  logic[7:0]   m_axi_arlen_o,
+  output  logic[2:0]   m_axi_arsize_o,
+  output  logic[1:0]   m_axi_arburst_o,
+  output  logic        m_axi_arvalid_o,
+  input   logic        m_axi_arready_i,
+
+  input   logic[31:0]  m_axi_rdata_i,
+  input   logic[1:0]   m_axi_rresp_i,
+  input   logic        m_axi_rlast_i,
+  input   logic        m_axi_rvalid_i,
+  output  logic        m_axi_rready_o
+);
+
+localparam int PTR_WIDTH = (OUTSTANDING_DEPTH > 1) ? $clog2(OUTSTANDING_DEPTH) : 1;
+localparam int CNT_WIDTH = $clog2(OUTSTANDING_DEPTH + 1);
+localparam logic[CNT_WIDTH-1:0] MAX_COUNT = CNT_WIDTH'(OUTSTANDING_DEPTH);
+
+localparam logic[1:0] BURST_INCR = 2'b01;
+
+/*****************************************/
+/*            Internal signals           */
+/*****************************************/
+
+logic request;
+// The request can be issued on the AXI channels
+logic issue;
+// The request is accepted, its address and data being transmitted
+logic accept;
+// A response is received on the read or write response channel
+logic response;
+logic aw_handshake, w_handshake, ar_handshake, r_handshake, b_handshake;
+
+logic[CNT_WIDTH-1:0]  count_d,  count_q;   // Transactions in flight
+logic                 write_d,  write_q;   // Type of the transactions in flight
+logic                 aw_done_d, aw_done_q;  // Write address already transmitted
+logic                 w_done_d,  w_done_q;   // Write data already transmitted
+
+// Byte offset and select of the reads in flight, used to align the data
+logic[PTR_WIDTH-1:0]  head_d,   head_q;
+logic[PTR_WIDTH-1:0]  tail_d,   tail_q;
+logic[1:0]            offset_q  [OUTSTANDING_DEPTH];
+logic[3:0]            sel_q     [OUTSTANDING_DEPTH];
+
+logic[1:0]   offset;
+logic[2:0]   size;
+logic[31:0]  read_mask;
+
+function automatic logic[PTR_WIDTH-1:0] next_index(input logic[PTR_WIDTH-1:0] index);
+  next_index = (index == PTR_WIDTH'(OUTSTANDING_DEPTH - 1)) ? '0 : index + 1'b1;
+endfunction
+
+assign request = s_wb_stb_i && s_wb_cyc_i;
+assign offset  = s_wb_adr_i[1:0];
+
+always_comb begin : transfer_size
+  case(s_wb_sel_i)
+    4'h1:    size = 3'b000;
+    4'h3:    size = 3'b001;
+    default: size = 3'b010;
+  endcase
+end
+
+/*
+ * AXI doesn't order the read transactions with regard to the write
+ * transactions. A request is therefore only issued once the transactions of
+ * the other type are completed, both response channels being always ready as
+ * responses are only received for the single type of transactions in flight.
+ * The write address and data are transmitted independently, the request
+ * being accepted once both of them are.
+ */
+always_comb begin : transaction_management
+  issue = request && (count_q != MAX_COUNT) &&
+          ((count_q == 0) || (write_q == s_wb_we_i));
+
+  aw_handshake = m_axi_awvalid_o && m_axi_awready_i;
+  w_handshake  = m_axi_wvalid_o  && m_axi_wready_i;
+  ar_handshake = m_axi_arvalid_o && m_axi_arready_i;
+  r_handshake  = m_axi_rvalid_i  && m_axi_rready_o;
+  b_handshake  = m_axi_bvalid_i  && m_axi_bready_o;
+
+  accept = ar_handshake ||
+           (issue && s_wb_we_i && (aw_handshake || aw_done_q) && (w_handshake || w_done_q));
+  response = r_handshake || b_handshake;
+
+  aw_done_d = accept ? 0 : (aw_done_q || aw_handshake);
+  w_done_d  = accept ? 0 : (w_done_q  || w_handshake);
+  write_d   = accept ? s_wb_we_i : write_q;
+
+  count_d = count_q;
+  if(accept && !response) begin
+    count_d = count_q + 1'b1;
+  end else if(!accept && response) begin
+    count_d = count_q - 1'b1;
+  end
+
+  head_d = r_handshake                   ? next_index(head_q) : head_q;
+  tail_d = (accept && !s_wb_we_i)        ? next_index(tail_q) : tail_q;
+end
+
+always_comb begin : read_alignment
+  read_mask = {{8{sel_q[head_q][3]}}, {8{sel_q[head_q][2]}},
+               {8{sel_q[head_q][1]}}, {8{sel_q[head_q][0]}}};
+  s_wb_dat_o = r_handshake ? ((m_axi_rdata_i >> {offset_q[head_q], 3'b000}) & read_mask) : '0;
+end
+
+always_ff @(posedge clk_i) begin
+  if(rst_i) begin
+    count_q    <=  '0;
+    write_q    <=   0;
+    aw_done_q  <=   0;
+    w_done_q   <=   0;
+    head_q     <=  '0;
+    tail_q     <=  '0;
+  end else begin
+    count_q    <=  count_d;
+    write_q    <=  write_d;
+    aw_done_q  <=  aw_done_d;
+    w_done_q   <=  w_done_d;
+    head_q     <=  head_d;
+    tail_q     <=  tail_d;
+
+    if(accept && !s_wb_we_i) begin
+      offset_q[tail_q]  <=  offset;
+      sel_q[tail_q]     <=  s_wb_sel_i;
+    end
+  end
+end
+
+/*****************************************/
+/*         Assign output signals         */
+/*****************************************/
+
+assign  s_wb_ack_o       =  response;
+assign  s_wb_stall_o     =  !accept;
+
+assign  m_axi_awaddr_o   =  s_wb_adr_i;
+assign  m_axi_awlen_o    =  '0;
+assign  m_axi_awsize_o   =  size;
+assign  m_axi_awburst_o  =  BURST_INCR;
+assign  m_axi_awvalid_o  =  issue && s_wb_we_i && !aw_done_q;
+
+assign  m_axi_wdata_o    =  s_wb_dat_i << {offset, 3'b000};
+assign  m_axi_wstrb_o    =  s_wb_sel_i << offset;
+assign  m_axi_wlast_o    =  1;
+assign  m_axi_wvalid_o   =  issue && s_wb_we_i && !w_done_q;
+
+assign  m_axi_bready_o   =  1;
+
+assign  m_axi_araddr_o   =  s_wb_adr_i;
+assign  m_axi_arlen_o    =  '0;
+assign  m_axi_arsize_o   =  size;
+assign  m_axi_arburst_o  =  BURST_INCR;
+assign  m_axi_arvalid_o  =  issue && !s_wb_we_i;
+
+assign  m_axi_rready_o   =  1;
+
+endmodule // axi_bridge
@@ -0,0 +1,191 @@
+/*           __        _
+ *  ________/ /  ___ _(_)__  ___
+ * / __/ __/ _ \/ _ `/ / _ \/ -_)
+ * \__/\__/_//_/\_,_/_/_//_/\__/
+ *
+ * Copyright (C) Clément Chaine
+ * This file is part of ECAP5-DPROC <https://github.com/ecap5/ECAP5-DPROC>
+ *
+ * ECAP5-DPROC is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ECAP5-DPROC is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ECAP5-DPROC.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+module branch_predictor #(
+  parameter int ENTRIES        = 16,
+  parameter int WAYS           = 1,
+  parameter int HISTORY_LENGTH = 0
+)(
+  input   logic        clk_i,
+  input   logic        rst_i,
+
+  //=================================
+  //    Lookup interface
+  //
+  // Provides the prediction of the conditional branch located at
+  // lookup_pc_i, the branch being predicted taken on a hit only.
+
+  input   logic[31:0]  lookup_pc_i,
+  output  logic        lookup_hit_o,
+  output  logic        lookup_taken_o,
+  output  logic[31:0]  lookup_target_o,
+
+  //=================================
+  //    Update interface
+  //
+  // Outcome of a conditional branch resolved by the pipeline.
+
+  input   logic        update_i,
+  input   logic[31:0]  update_pc_i,
+  input   logic        update_taken_i,
+  input   logic[31:0]  update_target_i,
+  input   logic        update_mispredict_i
+);
+
+localparam int SETS          = ENTRIES / WAYS;
+localparam int SET_WIDTH     = (SETS > 1) ? $clog2(SETS) : 1;
+localparam int WAY_WIDTH     = (WAYS > 1) ? $clog2(WAYS) : 1;
+localparam int INDEX_WIDTH   = (ENTRIES > 1) ? $clog2(ENTRIES) : 1;
+localparam int HISTORY_WIDTH = (HISTORY_LENGTH > 0) ? HISTORY_LENGTH : 1;
+
+/*****************************************/
+/*         Branch target buffer          */
+/*****************************************/
+
+// The whole address is stored as tag so that an instruction which is not a
+// conditional branch can never be predicted.
+logic                 btb_valid_q   [ENTRIES];
+logic[29:0]           btb_tag_q     [ENTRIES];
+logic[31:0]           btb_target_q  [ENTRIES];
+logic[WAY_WIDTH-1:0]  btb_victim_q  [SETS];
+
+/*****************************************/
+/*        Branch history table           */
+/*****************************************/
+
+// Two-bit saturating counters, the branch being predicted taken when the
+// most significant bit is set.
+logic[1:0]            bht_q         [ENTRIES];
+logic[HISTORY_WIDTH-1:0]  history_q;
+
+/*****************************************/
+/*          Performance counters         */
+/*****************************************/
+
+logic[31:0]  branch_count_q      /* verilator public */;
+logic[31:0]  hit_count_q         /* verilator public */;
+logic[31:0]  mispredict_count_q  /* verilator public */;
+
+/*****************************************/
+/*            Internal signals           */
+/*****************************************/
+
+logic                  update_hit;
+logic[WAY_WIDTH-1:0]   update_way;
+
+function automatic logic[SET_WIDTH-1:0] set_index(input logic[31:0] pc);
+  set_index = (SETS > 1) ? pc[2 +: SET_WIDTH] : '0;
+endfunction
+
+function automatic logic[INDEX_WIDTH-1:0] entry_index(input logic[SET_WIDTH-1:0] set, input logic[WAY_WIDTH-1:0] way);
+  entry_index = INDEX_WIDTH'(set * WAYS + way);
+endfunction
+
+// The counters are indexed by the address of the branch, hashed with the
+// global history when HISTORY_LENGTH is not null (gshare).
+function automatic logic[INDEX_WIDTH-1:0] bht_index(input logic[31:0] pc, input logic[HISTORY_WIDTH-1:0] history);
+  bht_index = pc[2 +: INDEX_WIDTH];
+  if(HISTORY_LENGTH > 0) begin
+    bht_index = bht_index ^ INDEX_WIDTH'(history);
+  end
+endfunction
+
+always_comb begin : lookup
+  lookup_hit_o = 0;
+  lookup_target_o = '0;
+  for(int way = 0; way < WAYS; way++) begin
+    if(btb_valid_q[entry_index(set_index(lookup_pc_i), WAY_WIDTH'(way))] &&
+       (btb_tag_q[entry_index(set_index(lookup_pc_i), WAY_WIDTH'(way))] == lookup_pc_i[31:2])) begin
+      lookup_hit_o = 1;
+      lookup_target_o = btb_target_q[entry_index(set_index(lookup_pc_i), WAY_WIDTH'(way))];
+    end
+  end
+  lookup_taken_o = lookup_hit_o && bht_q[bht_index(lookup_pc_i, history_q)][1];
+end
+
+always_comb begin : update_search
+  update_hit = 0;
+  update_way = btb_victim_q[set_index(update_pc_i)];
+  for(int way = 0; way < WAYS; way++) begin
+    if(btb_valid_q[entry_index(set_index(update_pc_i), WAY_WIDTH'(way))] &&
+       (btb_tag_q[entry_index(set_index(update_pc_i), WAY_WIDTH'(way))] == update_pc_i[31:2])) begin
+      update_hit = 1;
+      update_way = WAY_WIDTH'(way);
+    end
+  end
+end
+
+/*
+ * The history is updated with the resolved outcomes only. The counter of a
+ * branch is therefore trained with the history available at resolution
+ * time, which may differ from the one used for its lookup.
+ * An entry of the branch target buffer is only allocated to a taken branch,
+ * the entries of a set being replaced in a round-robin fashion.
+ */
+always_ff @(posedge clk_i) begin
+  if(rst_i) begin
+    for(int i = 0; i < ENTRIES; i++) begin
+      btb_valid_q[i]  <=  0;
+      bht_q[i]        <=  2'b01;
+    end
+    for(int i = 0; i < SETS; i++) begin
+      btb_victim_q[i] <=  '0;
+    end
+    history_q           <=  '0;
+    branch_count_q      <=  '0;
+    hit_count_q         <=  '0;
+    mispredict_count_q  <=  '0;
+  end else begin
+    if(update_i) begin
+      if(update_taken_i) begin
+        if(bht_q[bht_index(update_pc_i, history_q)] != 2'b11) begin
+          bht_q[bht_index(update_pc_i, history_q)] <= bht_q[bht_index(update_pc_i, history_q)] + 1'b1;
+        end
+      end else begin
+        if(bht_q[bht_index(update_pc_i, history_q)] != 2'b00) begin
+          bht_q[bht_index(update_pc_i, history_q)] <= bht_q[bht_index(update_pc_i, history_q)] - 1'b1;
+        end
+      end
+
+      if(HISTORY_LENGTH > 0) begin
+        history_q <= HISTORY_WIDTH'({history_q, update_taken_i});
+      end
+
+      if(update_hit || update_taken_i) begin
+        btb_valid_q[entry_index(set_index(update_pc_i), update_way)]  <=  1;
+        btb_tag_q[entry_index(set_index(update_pc_i), update_way)]    <=  update_pc_i[31:2];
+        btb_target_q[entry_index(set_index(update_pc_i), update_way)] <=  update_target_i;
+      end
+      if(!update_hit && update_taken_i) begin
+        btb_victim_q[set_index(update_pc_i)] <= (btb_victim_q[set_index(update_pc_i)] == WAY_WIDTH'(WAYS - 1))
+                                                    ? '0
+                                                    : btb_victim_q[set_index(update_pc_i)] + 1'b1;
+      end
+
+      branch_count_q      <=  branch_count_q + 1;
+      hit_count_q         <=  hit_count_q + {31'h0, update_hit};
+      mispredict_count_q  <=  mispredict_count_q + {31'h0, update_mispredict_i};
+    end
+  end
+end
+
+endmodule // branch_predictor
@@ -0,0 +1,446 @@
+/*           __        _
+ *  ________/ /  ___ _(_)__  ___
+ * / __/ __/ _ \/ _ `/ / _ \/ -_)
+ * \__/\__/_//_/\_,_/_/_//_/\__/
+ *
+ * Copyright (C) Clément Chaine
+ * This file is part of ECAP5-DPROC <https://github.com/ecap5/ECAP5-DPROC>
+ *
+ * ECAP5-DPROC is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ECAP5-DPROC is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ECAP5-DPROC.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+module dcache import ecap5_dproc_pkg::*; #(
+  parameter int          SIZE           = 1024,
+  parameter int          LINE_SIZE      = 16,
+  parameter int          WAYS           = 1,
+  parameter logic[31:0]  UNCACHED_BASE  = 32'h80000000,
+  parameter logic[31:0]  UNCACHED_LIMIT = 32'hFFFFFFFF
+)(
+  input   logic        clk_i,
+  input   logic        rst_i,
+
+  //=================================
+  //    Slave port
+  //
+  // Requests of the loadstore module. The address is a byte address and the
+  // data is right-aligned.
+
+  input   logic[31:0]  s_wb_adr_i,
+  output  logic[31:0]  s_wb_dat_o,
+  input   logic[31:0]  s_wb_dat_i,
+  input   logic        s_wb_we_i,
+  input   logic[3:0]   s_wb_sel_i,
+  input   logic        s_wb_stb_i,
+  output  logic        s_wb_ack_o,
+  input   logic        s_wb_cyc_i,
+  output  logic        s_wb_stall_o,
+
+  //=================================
+  //    Master port
+  //
+  // Line write-backs and refills, performed as sequential pipelined requests
+  // identified as incrementing bursts, and uncached requests, forwarded as is.
+
+  output  logic[31:0]  m_wb_adr_o,
+  input   logic[31:0]  m_wb_dat_i,
+  output  logic[31:0]  m_wb_dat_o,
+  output  logic        m_wb_we_o,
+  output  logic[3:0]   m_wb_sel_o,
+  output  logic        m_wb_stb_o,
+  input   logic        m_wb_ack_i,
+  output  logic        m_wb_cyc_o,
+  input   logic        m_wb_stall_i,
+  output  logic[2:0]   m_wb_cti_o,
+  output  logic[1:0]   m_wb_bte_o
+);
+
+localparam int LINES        = SIZE / LINE_SIZE;
+localparam int SETS         = LINES / WAYS;
+localparam int LINE_WORDS   = LINE_SIZE / 4;
+localparam int WORD_WIDTH   = (LINE_WORDS > 1) ? $clog2(LINE_WORDS) : 1;
+localparam int SET_WIDTH    = (SETS > 1) ? $clog2(SETS) : 1;
+localparam int WAY_WIDTH    = (WAYS > 1) ? $clog2(WAYS) : 1;
+localparam int LINE_WIDTH   = (LINES > 1) ? $clog2(LINES) : 1;
+localparam int INDEX_WIDTH  = (LINES * LINE_WORDS > 1) ? $clog2(LINES * LINE_WORDS) : 1;
+localparam int OFFSET_WIDTH = $clog2(LINE_SIZE);
+localparam int TAG_LSB      = OFFSET_WIDTH + ((SETS > 1) ? $clog2(SETS) : 0);
+localparam int TAG_WIDTH    = 32 - TAG_LSB;
+localparam int CNT_WIDTH    = $clog2(LINE_WORDS + 1);
+
+typedef enum logic[2:0] {
+  IDLE,       // 0
+  WRITEBACK,  // 1
+  REFILL,     // 2
+  COMPLETE,   // 3
+  UNCACHED    // 4
+} state_t;
+state_t state_d, state_q;
+
+/*****************************************/
+/*                Storage                */
+/*****************************************/
+
+logic                 valid_q   [LINES];
+logic                 dirty_q   [LINES];
+logic[TAG_WIDTH-1:0]  tag_q     [LINES];
+logic[31:0]           data_q    [LINES * LINE_WORDS];
+// Age of each line within its set, the ages of a set being a permutation in
+// which the least recently used line has the age WAYS-1
+logic[WAY_WIDTH-1:0]  age_q     [LINES];
+
+/*****************************************/
+/*          Performance counters         */
+/*****************************************/
+
+logic[31:0]  hit_count_q        /* verilator public */;
+logic[31:0]  miss_count_q       /* verilator public */;
+logic[31:0]  writeback_count_q  /* verilator public */;
+
+/*****************************************/
+/*            Internal signals           */
+/*****************************************/
+
+logic                  request;
+logic                  uncached;
+logic                  lookup_hit;
+logic[WAY_WIDTH-1:0]   lookup_way;
+logic[INDEX_WIDTH-1:0] lookup_index;
+logic[WAY_WIDTH-1:0]   victim_way;
+logic[LINE_WIDTH-1:0]  victim_line;
+
+logic[31:0]            req_adr_d,       req_adr_q;     // Request being served
+logic[31:0]            req_dat_d,       req_dat_q;
+logic                  req_we_d,        req_we_q;
+logic[3:0]             req_sel_d,       req_sel_q;
+logic[WAY_WIDTH-1:0]   miss_way_d,      miss_way_q;
+logic[CNT_WIDTH-1:0]   req_count_d,     req_count_q;   // Number of words requested
+logic[CNT_WIDTH-1:0]   ack_count_d,     ack_count_q;   // Number of words acknowledged
+logic[INDEX_WIDTH-1:0] miss_index;
+
+logic[31:0]  m_wb_adr_d,  m_wb_adr_q;
+logic[31:0]  m_wb_dat_d,  m_wb_dat_q;
+logic        m_wb_we_d,   m_wb_we_q;
+logic[3:0]   m_wb_sel_d,  m_wb_sel_q;
+logic        m_wb_stb_d,  m_wb_stb_q;
+logic        m_wb_cyc_d,  m_wb_cyc_q;
+logic[31:0]  s_wb_dat_d,  s_wb_dat_q;
+logic        s_wb_ack_d,  s_wb_ack_q;
+
+function automatic logic[SET_WIDTH-1:0] set_index(input logic[31:0] adr);
+  set_index = (SETS > 1) ? adr[OFFSET_WIDTH +: SET_WIDTH] : '0;
+endfunction
+
+function automatic logic[WORD_WIDTH-1:0] word_index(input logic[31:0] adr);
+  word_index = (LINE_WORDS > 1) ? adr[2 +: WORD_WIDTH] : '0;
+endfunction
+
+function automatic logic[LINE_WIDTH-1:0] line_index(input logic[SET_WIDTH-1:0] set, input logic[WAY_WIDTH-1:0] way);
+  line_index = LINE_WIDTH'(set * WAYS + way);
+endfunction
+
+function automatic logic[INDEX_WIDTH-1:0] data_index(input logic[SET_WIDTH-1:0] set, input logic[WAY_WIDTH-1:0] way,
+                                                     input logic[WORD_WIDTH-1:0] word);
+  data_index = INDEX_WIDTH'((set * WAYS + way) * LINE_WORDS + word);
+endfunction
+
+function automatic logic[31:0] line_address(input logic[TAG_WIDTH-1:0] tag, input logic[SET_WIDTH-1:0] set);
+  line_address = (32'(tag) << TAG_LSB) | ((SETS > 1) ? (32'(set) << OFFSET_WIDTH) : 32'h0);
+endfunction
+
+// Extracts the right-aligned data of a load from a cached word
+function automatic logic[31:0] load_data(input logic[31:0] word, input logic[31:0] adr, input logic[3:0] sel);
+  logic[31:0] shifted;
+  shifted = word >> {adr[1:0], 3'b000};
+  case(sel)
+    4'h1:    load_data = {24'h0, shifted[7:0]};
+    4'h3:    load_data = {16'h0, shifted[15:0]};
+    4'h7:    load_data = {8'h0, shifted[23:0]};
+    default: load_data = shifted;
+  endcase
+endfunction
+
+// Merges the right-aligned data of a store into a cached word
+function automatic logic[31:0] store_data(input logic[31:0] word, input logic[31:0] adr, input logic[3:0] sel,
+                                          input logic[31:0] data);
+  logic[3:0]  mask;
+  logic[31:0] shifted;
+  mask    = sel << adr[1:0];
+  shifted = data << {adr[1:0], 3'b000};
+  store_data = word;
+  for(int i = 0; i < 4; i++) begin
+    if(mask[i]) begin
+      store_data[i*8 +: 8] = shifted[i*8 +: 8];
+    end
+  end
+endfunction
+
+// A request is only accepted while no miss or uncached request is being served
+assign request = s_wb_stb_i && s_wb_cyc_i && (state_q == IDLE);
+assign uncached = (s_wb_adr_i >= UNCACHED_BASE) && (s_wb_adr_i <= UNCACHED_LIMIT);
+
+always_comb begin : lookup
+  lookup_hit = 0;
+  lookup_way = '0;
+  for(int way = 0; way < WAYS; way++) begin
+    if(valid_q[line_index(set_index(s_wb_adr_i), WAY_WIDTH'(way))] &&
+       (tag_q[line_index(set_index(s_wb_adr_i), WAY_WIDTH'(way))] == s_wb_adr_i[31:TAG_LSB])) begin
+      lookup_hit = 1;
+      lookup_way = WAY_WIDTH'(way);
+    end
+  end
+
+  // The least recently used line of the set is replaced on a miss
+  victim_way = '0;
+  for(int way = 0; way < WAYS; way++) begin
+    if(age_q[line_index(set_index(s_wb_adr_i), WAY_WIDTH'(way))] == WAY_WIDTH'(WAYS - 1)) begin
+      victim_way = WAY_WIDTH'(way);
+    end
+  end
+end
+
+assign lookup_index = data_index(set_index(s_wb_adr_i), lookup_way, word_index(s_wb_adr_i));
+assign victim_line  = line_index(set_index(s_wb_adr_i), victim_way);
+assign miss_index   = data_index(set_index(req_adr_q), miss_way_q, word_index(req_adr_q));
+
+/*
+ * A hit is acknowledged on the following cycle. On a miss, the victim line is
+ * written back to memory if it is dirty, the requested line is then fetched
+ * from its first word and the request is finally performed on the new line.
+ * Uncached requests are forwarded to memory without being modified.
+ */
+always_comb begin : state_machine
+  state_d     = state_q;
+  req_adr_d   = req_adr_q;
+  req_dat_d   = req_dat_q;
+  req_we_d    = req_we_q;
+  req_sel_d   = req_sel_q;
+  miss_way_d  = miss_way_q;
+  req_count_d = req_count_q;
+  ack_count_d = ack_count_q;
+
+  m_wb_adr_d  = m_wb_adr_q;
+  m_wb_dat_d  = m_wb_dat_q;
+  m_wb_we_d   = m_wb_we_q;
+  m_wb_sel_d  = m_wb_sel_q;
+  m_wb_stb_d  = m_wb_stb_q;
+  m_wb_cyc_d  = m_wb_cyc_q;
+
+  s_wb_ack_d  = 0;
+  s_wb_dat_d  = s_wb_dat_q;
+
+  case(state_q)
+    IDLE: begin
+      if(request) begin
+        req_adr_d = s_wb_adr_i;
+        req_dat_d = s_wb_dat_i;
+        req_we_d  = s_wb_we_i;
+        req_sel_d = s_wb_sel_i;
+        if(uncached) begin
+          state_d    = UNCACHED;
+          m_wb_adr_d = s_wb_adr_i;
+          m_wb_dat_d = s_wb_dat_i;
+          m_wb_we_d  = s_wb_we_i;
+          m_wb_sel_d = s_wb_sel_i;
+          m_wb_stb_d = 1;
+          m_wb_cyc_d = 1;
+        end else if(lookup_hit) begin
+          s_wb_ack_d = 1;
+          if(!s_wb_we_i) begin
+            s_wb_dat_d = load_data(data_q[lookup_index], s_wb_adr_i, s_wb_sel_i);
+          end
+        end else begin
+          miss_way_d  = victim_way;
+          req_count_d = '0;
+          ack_count_d = '0;
+
+          m_wb_sel_d  = 4'hF;
+          m_wb_stb_d  = 1;
+          m_wb_cyc_d  = 1;
+          if(valid_q[victim_line] && dirty_q[victim_line]) begin
+            state_d    = WRITEBACK;
+            m_wb_adr_d = line_address(tag_q[victim_line], set_index(s_wb_adr_i));
+            m_wb_we_d  = 1;
+          end else begin
+            state_d    = REFILL;
+            m_wb_adr_d = { s_wb_adr_i[31:OFFSET_WIDTH], {OFFSET_WIDTH{1'b0}} };
+            m_wb_we_d  = 0;
+          end
+        end
+      end
+    end
+    WRITEBACK, REFILL: begin
+      // The next word is requested once the current request is accepted
+      if(m_wb_stb_q && !m_wb_stall_i) begin
+        req_count_d = req_count_q + 1'b1;
+        m_wb_adr_d  = m_wb_adr_q + 4;
+        if(req_count_d == CNT_WIDTH'(LINE_WORDS)) begin
+          m_wb_stb_d = 0;
+        end
+      end
+      if(m_wb_ack_i) begin
+        ack_count_d = ack_count_q + 1'b1;
+        if(ack_count_d == CNT_WIDTH'(LINE_WORDS)) begin
+          if(state_q == WRITEBACK) begin
+            // The refill is started while keeping the bus cycle
+            state_d     = REFILL;
+            req_count_d = '0;
+            ack_count_d = '0;
+            m_wb_adr_d  = { req_adr_q[31:OFFSET_WIDTH], {OFFSET_WIDTH{1'b0}} };
+            m_wb_we_d   = 0;
+            m_wb_stb_d  = 1;
+          end else begin
+            state_d    = COMPLETE;
+            m_wb_cyc_d = 0;
+          end
+        end
+      end
+    end
+    COMPLETE: begin
+      state_d    = IDLE;
+      s_wb_ack_d = 1;
+      if(!req_we_q) begin
+        s_wb_dat_d = load_data(data_q[miss_index], req_adr_q, req_sel_q);
+      end
+    end
+    UNCACHED: begin
+      if(m_wb_stb_q && !m_wb_stall_i) begin
+        m_wb_stb_d = 0;
+      end
+      if(m_wb_ack_i) begin
+        state_d    = IDLE;
+        m_wb_cyc_d = 0;
+        s_wb_ack_d = 1;
+        s_wb_dat_d = m_wb_dat_i;
+      end
+    end
+    default: begin end
+  endcase
+end
+
+always_ff @(posedge clk_i) begin
+  if(rst_i) begin
+    state_q           <=  IDLE;
+    req_adr_q         <=  '0;
+    req_dat_q         <=  '0;
+    req_we_q          <=   0;
+    req_sel_q         <=  '0;
+    miss_way_q        <=  '0;
+    req_count_q       <=  '0;
+    ack_count_q       <=  '0;
+    m_wb_adr_q        <=  '0;
+    m_wb_dat_q        <=  '0;
+    m_wb_we_q         <=   0;
+    m_wb_sel_q        <=  '0;
+    m_wb_stb_q        <=   0;
+    m_wb_cyc_q        <=   0;
+    s_wb_ack_q        <=   0;
+    s_wb_dat_q        <=  '0;
+    for(int i = 0; i < LINES; i++) begin
+      valid_q[i]      <=  0;
+      dirty_q[i]      <=  0;
+    end
+    for(int i = 0; i < LINES; i++) begin
+      age_q[i]        <=  WAY_WIDTH'(WAYS - 1 - (i % WAYS));
+    end
+    hit_count_q       <=  '0;
+    miss_count_q      <=  '0;
+    writeback_count_q <=  '0;
+  end else begin
+    state_q           <=  state_d;
+    req_adr_q         <=  req_adr_d;
+    req_dat_q         <=  req_dat_d;
+    req_we_q          <=  req_we_d;
+    req_sel_q         <=  req_sel_d;
+    miss_way_q        <=  miss_way_d;
+    req_count_q       <=  req_count_d;
+    ack_count_q       <=  ack_count_d;
+    m_wb_adr_q        <=  m_wb_adr_d;
+    m_wb_dat_q        <=  m_wb_dat_d;
+    m_wb_we_q         <=  m_wb_we_d;
+    m_wb_sel_q        <=  m_wb_sel_d;
+    m_wb_stb_q        <=  m_wb_stb_d;
+    m_wb_cyc_q        <=  m_wb_cyc_d;
+    s_wb_ack_q        <=  s_wb_ack_d;
+    s_wb_dat_q        <=  s_wb_dat_d;
+
+    if(request && !uncached) begin
+      if(lookup_hit) begin
+        // The accessed line becomes the most recently used of its set
+        for(int way = 0; way < WAYS; way++) begin
+          if(age_q[line_index(set_index(s_wb_adr_i), WAY_WIDTH'(way))] < age_q[line_index(set_index(s_wb_adr_i), lookup_way)]) begin
+            age_q[line_index(set_index(s_wb_adr_i), WAY_WIDTH'(way))] <= age_q[line_index(set_index(s_wb_adr_i), WAY_WIDTH'(way))] + 1'b1;
+          end
+        end
+        age_q[line_index(set_index(s_wb_adr_i), lookup_way)] <= '0;
+        hit_count_q <= hit_count_q + 1;
+        if(s_wb_we_i) begin
+          data_q[lookup_index] <= store_data(data_q[lookup_index], s_wb_adr_i, s_wb_sel_i, s_wb_dat_i);
+          dirty_q[line_index(set_index(s_wb_adr_i), lookup_way)] <= 1;
+        end
+      end else begin
+        // The line is invalidated until refilled, its tag and dirty state
+        // being kept for the write-back
+        valid_q[victim_line] <= 0;
+        miss_count_q <= miss_count_q + 1;
+        if(valid_q[victim_line] && dirty_q[victim_line]) begin
+          writeback_count_q <= writeback_count_q + 1;
+        end
+      end
+    end
+
+    if((state_q == REFILL) && m_wb_ack_i) begin
+      data_q[data_index(set_index(req_adr_q), miss_way_q, WORD_WIDTH'(ack_count_q))] <= m_wb_dat_i;
+      if(ack_count_d == CNT_WIDTH'(LINE_WORDS)) begin
+        valid_q[line_index(set_index(req_adr_q), miss_way_q)] <= 1;
+        dirty_q[line_index(set_index(req_adr_q), miss_way_q)] <= 0;
+        tag_q[line_index(set_index(req_adr_q), miss_way_q)]   <= req_adr_q[31:TAG_LSB];
+        for(int way = 0; way < WAYS; way++) begin
+          if(age_q[line_index(set_index(req_adr_q), WAY_WIDTH'(way))] < age_q[line_index(set_index(req_adr_q), miss_way_q)]) begin
+            age_q[line_index(set_index(req_adr_q), WAY_WIDTH'(way))] <= age_q[line_index(set_index(req_adr_q), WAY_WIDTH'(way))] + 1'b1;
+          end
+        end
+        age_q[line_index(set_index(req_adr_q), miss_way_q)] <= '0;
+      end
+    end
+
+    if((state_q == COMPLETE) && req_we_q) begin
+      data_q[miss_index] <= store_data(data_q[miss_index], req_adr_q, req_sel_q, req_dat_q);
+      dirty_q[line_index(set_index(req_adr_q), miss_way_q)] <= 1;
+    end
+  end
+end
+
+/*****************************************/
+/*         Assign output signals         */
+/*****************************************/
+
+assign  s_wb_dat_o    =  s_wb_dat_q;
+assign  s_wb_ack_o    =  s_wb_ack_q;
+assign  s_wb_stall_o  =  (state_q != IDLE);
+
+assign  m_wb_adr_o    =  m_wb_adr_q;
+// Write-backs send the word matching the current request
+assign  m_wb_dat_o    =  (state_q == WRITEBACK) ? data_q[data_index(set_index(req_adr_q), miss_way_q, WORD_WIDTH'(req_count_q))]
+                                                : m_wb_dat_q;
+assign  m_wb_we_o     =  m_wb_we_q;
+assign  m_wb_sel_o    =  m_wb_sel_q;
+assign  m_wb_stb_o    =  m_wb_stb_q;
+assign  m_wb_cyc_o    =  m_wb_cyc_q;
+// The last request of a write-back or refill ends the burst
+assign  m_wb_cti_o    =  ((state_q != WRITEBACK) && (state_q != REFILL))  ?  CTI_CLASSIC :
+                         (req_count_q == CNT_WIDTH'(LINE_WORDS - 1))        ?  CTI_END
+                                                                            :  CTI_INCREMENTING;
+assign  m_wb_bte_o    =  BTE_LINEAR;
+
+endmodule // dcache
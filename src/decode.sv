@@ -20,8 +20,14 @@
  * along with ECAP5-DPROC.  If not, see <http://www.gnu.org/licenses/>.
  */
 
-module decode 
-(
+module decode #(
+  parameter logic DECODE_BRANCH = 0,
+  parameter logic MULDIV        = 0,
+  parameter logic BITMANIP      = 0,
+  parameter logic FUSION        = 0,
+  parameter logic ATOMIC        = 0,
+  parameter logic FENCE_I       = 0
+)(
   input   logic         clk_i,
   input   logic         rst_i,
 
@@ -36,6 +42,20 @@ module decode
    
   input   logic[31:0]   instr_i,
   input   logic[31:0]   pc_i,
+  input   logic         compressed_i,
+  input   logic         pred_taken_i,
+  input   logic[31:0]   pred_target_i,
+
+  //`````````````````````````````````
+  //    Fusion window
+  //
+  // Instruction following the decoded one, consumed along with it when
+  // both instructions are fused, when FUSION is set.
+
+  input   logic         next_valid_i,
+  input   logic[31:0]   next_instr_i,
+  input   logic         next_pred_taken_i,
+  output  logic         fuse_o,
 
   //=================================
   //    Register interface
@@ -55,14 +75,26 @@ module decode
   //    Execute interface 
   
   output   logic[31:0]  pc_o,
+  output   logic        compressed_o,
   output   logic[31:0]  alu_operand1_o,
   output   logic[31:0]  alu_operand2_o, 
-  output   logic[2:0]   alu_op_o,
+  output   logic[4:0]   alu_op_o,
   output   logic        alu_sub_o,
   output   logic        alu_shift_left_o,
   output   logic        alu_signed_shift_o,
   output   logic[2:0]   branch_cond_o,
   output   logic[19:0]  branch_offset_o,
+  output   logic        pred_taken_o,
+  output   logic[31:0]  pred_target_o,
+  output   logic        muldiv_enable_o,
+  output   logic[2:0]   muldiv_op_o,
+
+  //`````````````````````````````````
+  //    Forwarding interface 
+
+  output   logic[4:0]   alu_operand1_reg_o,
+  output   logic[4:0]   alu_operand2_reg_o,
+  output   logic[4:0]   ls_write_data_reg_o,
 
   //`````````````````````````````````
   //    Write-back pass-through 
@@ -78,11 +110,39 @@ module decode
   output   logic[31:0]  ls_write_data_o,
   output   logic[3:0]   ls_sel_o,
   output   logic        ls_unsigned_load_o,
+  output   logic        ls_atomic_o,
+  output   logic[4:0]   ls_atomic_op_o,
+
+  //`````````````````````````````````
+  //    Instruction cache pass-through
+
+  output   logic        fence_i_o,
+
+  //=================================
+  //    Fetch interface
+  //
+  // Jumps and branches resolved in decode, when DECODE_BRANCH is set.
+
+  output   logic        branch_o,
+  output   logic[31:0]  branch_target_o,
+
+  //`````````````````````````````````
+  //    Branch predictor interface
+  //
+  // Outcome of the conditional branches resolved in decode.
+
+  output   logic        bp_update_o,
+  output   logic[31:0]  bp_pc_o,
+  output   logic        bp_taken_o,
+  output   logic[31:0]  bp_target_o,
+  output   logic        bp_mispredict_o,
 
   //=================================
   //    Hazard interface
   
-  input    logic   stall_request_i
+  input    logic   stall_request_i,
+  input    logic   discard_request_i,
+  output   logic   branch_compare_o
 
 );
 import ecap5_dproc_pkg::*;
@@ -95,26 +155,69 @@ import riscv_pkg::*;
 logic[6:0] opcode;
 logic[4:0] rd;
 logic[2:0] func3;
+logic[6:0] func7;
 logic[31:0] immediate;
+logic[31:0] instr_size;
 
 logic[2:0] branch_cond;
-logic[2:0] op_alu_op;
+logic[4:0] op_alu_op;
+logic      bitmanip;
+logic[4:0] bitmanip_alu_op;
+logic      atomic;
+logic      fence_i;
+
+/*****************************************/
+/*            Fusion signals             */
+/*****************************************/
+
+logic[6:0]   next_opcode;
+logic[4:0]   next_rd;
+logic[4:0]   next_rs1;
+logic[2:0]   next_func3;
+logic[31:0]  next_immediate;
+logic        fuse;
+logic        fuse_jump;
+
+/*****************************************/
+/*       Branch resolution signals       */
+/*****************************************/
+
+logic        operands_eq,
+             operands_lt,
+             operands_ltu;
+logic        branch_taken;
+logic[31:0]  branch_target;
+
+/*****************************************/
+/*          Performance counters         */
+/*****************************************/
+
+logic[31:0]  fused_count_q  /* verilator public */;
 
 /*****************************************/
 /*             Stage outputs             */
 /*****************************************/
 
 logic[31:0]  pc_q;
+logic        compressed_q;
 
 logic[31:0]  alu_operand1_d,      alu_operand1_q;
 logic[31:0]  alu_operand2_d,      alu_operand2_q;      
-logic[2:0]   alu_op_d,            alu_op_q;
+logic[4:0]   alu_op_d,            alu_op_q;
 logic        alu_sub_d,           alu_sub_q;
 logic        alu_shift_left_d,    alu_shift_left_q;
 logic        alu_signed_shift_d,  alu_signed_shift_q;
+logic        muldiv_enable_d,     muldiv_enable_q;
+logic[2:0]   muldiv_op_d,         muldiv_op_q;
 
 logic[2:0]   branch_cond_d,       branch_cond_q;
 logic[19:0]  branch_offset_d,     branch_offset_q;
+logic        pred_taken_q;
+logic[31:0]  pred_target_q;
+
+logic[4:0]   alu_operand1_reg_d,  alu_operand1_reg_q;
+logic[4:0]   alu_operand2_reg_d,  alu_operand2_reg_q;
+logic[4:0]   ls_write_data_reg_d, ls_write_data_reg_q;
 
 logic        reg_write_d,         reg_write_q;
 logic[4:0]   reg_addr_d,          reg_addr_q;
@@ -124,6 +227,10 @@ logic        ls_write_d,          ls_write_q;
 logic[31:0]  ls_write_data_d,     ls_write_data_q;
 logic[3:0]   ls_sel_d,            ls_sel_q;
 logic        ls_unsigned_load_d,  ls_unsigned_load_q;
+logic        ls_atomic_d,         ls_atomic_q;
+logic[4:0]   ls_atomic_op_d,      ls_atomic_op_q;
+
+logic        fence_i_q;
 
 logic        output_valid_d,      output_valid_q;
 
@@ -132,6 +239,23 @@ logic        output_valid_d,      output_valid_q;
 assign  opcode  =  instr_i[6:0];
 assign  rd      =  instr_i[11:7];
 assign  func3   =  instr_i[14:12];
+assign  func7   =  instr_i[31:25];
+
+// Size of the instruction, a compressed instruction being expanded by the expander module
+assign  instr_size  =  compressed_i ? 32'h2 : 32'h4;
+
+assign  next_opcode     =  next_instr_i[6:0];
+assign  next_rd         =  next_instr_i[11:7];
+assign  next_rs1        =  next_instr_i[19:15];
+assign  next_func3      =  next_instr_i[14:12];
+assign  next_immediate  =  { {21{next_instr_i[31]}}, next_instr_i[30:20] };
+
+// The atomic instructions are only supported on words, when ATOMIC is set
+assign  atomic  =  ATOMIC && (opcode == OPCODE_AMO) && (func3 == FUNC3_AMO_W);
+
+// FENCE.I is performed as a jump to the next instruction, discarding the
+// instructions already fetched, when FENCE_I is set
+assign  fence_i  =  FENCE_I && (opcode == OPCODE_MISC_MEM) && (func3 == FUNC3_FENCE_I);
 
 assign raddr1_o = instr_i[19:15];
 assign raddr2_o = instr_i[24:20];
@@ -159,12 +283,53 @@ always_comb begin : immediate_decoding
   endcase
 end
 
+/*
+ * When FUSION is set, the following pairs of instructions are fused into a
+ * single operation when the second instruction reads and overwrites the
+ * destination register of the first one :
+ *  - LUI  + ADDI : 32-bit constant, computed as an addition of the immediates
+ *  - AUIPC + ADDI : PC-relative address, computed as above from the pc
+ *  - AUIPC + JALR : far call, jumping to the pc plus both immediates
+ *  - SLLI + SRLI : zero-extension, computed as a mask when both shift
+ *                  amounts are equal
+ * The second instruction is taken from the prefetch queue and shall not have
+ * been predicted taken, the first one following its fall-through path.
+ */
+always_comb begin : fusion_detection
+  fuse = 0;
+  fuse_jump = 0;
+  if(FUSION && next_valid_i && !pred_taken_i && !next_pred_taken_i
+      && (rd != 5'h0) && (next_rd == rd) && (next_rs1 == rd)) begin
+    case(opcode)
+      OPCODE_LUI: begin
+        fuse = (next_opcode == OPCODE_OP_IMM) && (next_func3 == FUNC3_ADD);
+      end
+      OPCODE_AUIPC: begin
+        fuse_jump = (next_opcode == OPCODE_JALR) && (next_func3 == FUNC3_JALR);
+        fuse = fuse_jump || ((next_opcode == OPCODE_OP_IMM) && (next_func3 == FUNC3_ADD));
+      end
+      OPCODE_OP_IMM: begin
+        fuse = (func3 == FUNC3_SLL) && (func7 == 7'h0)
+                && (next_opcode == OPCODE_OP_IMM) && (next_func3 == FUNC3_SRL)
+                && (next_instr_i[31:25] == 7'h0) && (next_instr_i[24:20] == instr_i[24:20]);
+      end
+      default: begin
+      end
+    endcase
+  end
+end
+
 always_comb begin : alu_interface
   case(opcode)
     OPCODE_AUIPC, OPCODE_JAL:                  
       alu_operand1_d = pc_i;
     OPCODE_JALR, OPCODE_BRANCH, OPCODE_OP, OPCODE_OP_IMM, OPCODE_LOAD, OPCODE_STORE:  
       alu_operand1_d = rdata1_i;
+    // The address of an atomic instruction is read from rs1 without offset
+    OPCODE_AMO:
+      alu_operand1_d = atomic ? rdata1_i : '0;
+    OPCODE_MISC_MEM:
+      alu_operand1_d = fence_i ? pc_i : '0;
     default:                                               
       alu_operand1_d = '0;
   endcase
@@ -172,11 +337,13 @@ always_comb begin : alu_interface
   case(opcode)
     OPCODE_LUI,
     OPCODE_AUIPC,
-    OPCODE_JAL,
     OPCODE_JALR,
     OPCODE_OP_IMM,
     OPCODE_LOAD,
     OPCODE_STORE: alu_operand2_d = immediate;
+    // The return address of a jump resolved in decode is computed by the alu
+    OPCODE_JAL:    alu_operand2_d = DECODE_BRANCH ? instr_size : immediate;
+    OPCODE_MISC_MEM: alu_operand2_d = fence_i ? instr_size : '0;
     OPCODE_BRANCH,
     OPCODE_OP:     alu_operand2_d = rdata2_i;
     default:       alu_operand2_d = '0;
@@ -194,13 +361,91 @@ always_comb begin : alu_interface
   endcase
   case(opcode)
     OPCODE_OP,
-    OPCODE_OP_IMM: alu_op_d = op_alu_op;
+    OPCODE_OP_IMM: alu_op_d = bitmanip ? bitmanip_alu_op : op_alu_op;
     default:       alu_op_d = '0;
   endcase
 
   alu_shift_left_d = (func3 == FUNC3_SLL);
   alu_signed_shift_d = (instr_i[30] == 1'b1);
   alu_sub_d = (opcode == OPCODE_OP) && (instr_i[30] == 1'b1);
+
+  // The operation of the multiply/divide unit is selected by func3
+  muldiv_enable_d = MULDIV && (opcode == OPCODE_OP) && (instr_i[31:25] == FUNC7_MULDIV);
+  muldiv_op_d = func3;
+
+  if(fuse) begin
+    if(opcode == OPCODE_OP_IMM) begin
+      alu_operand2_d = 32'hFFFFFFFF >> instr_i[24:20];
+      alu_op_d = ALU_AND;
+    end else begin
+      alu_operand2_d = immediate + next_immediate;
+    end
+  end
+end
+
+/*
+ * When BITMANIP is set, the instructions of the Zba, Zbb and Zbs extensions
+ * are identified by their func7 field, and their rs2 field for the unary
+ * instructions. They reuse the operands of the OP and OP_IMM instructions, the
+ * shift amount encoding providing the bit index of the Zbs immediate forms.
+ */
+always_comb begin : bitmanip_decoding
+  bitmanip = BITMANIP;
+  bitmanip_alu_op = ALU_ADD;
+  if(opcode == OPCODE_OP) begin
+    case({func7, func3})
+      {7'b0010000, 3'b010}: bitmanip_alu_op = ALU_SH1ADD;
+      {7'b0010000, 3'b100}: bitmanip_alu_op = ALU_SH2ADD;
+      {7'b0010000, 3'b110}: bitmanip_alu_op = ALU_SH3ADD;
+      {7'b0100000, 3'b111}: bitmanip_alu_op = ALU_ANDN;
+      {7'b0100000, 3'b110}: bitmanip_alu_op = ALU_ORN;
+      {7'b0100000, 3'b100}: bitmanip_alu_op = ALU_XNOR;
+      {7'b0000101, 3'b100}: bitmanip_alu_op = ALU_MIN;
+      {7'b0000101, 3'b101}: bitmanip_alu_op = ALU_MINU;
+      {7'b0000101, 3'b110}: bitmanip_alu_op = ALU_MAX;
+      {7'b0000101, 3'b111}: bitmanip_alu_op = ALU_MAXU;
+      {7'b0000100, 3'b100}: begin
+        bitmanip_alu_op = ALU_ZEXT_H;
+        bitmanip = bitmanip && (instr_i[24:20] == 5'b00000);
+      end
+      {7'b0110000, 3'b001}: bitmanip_alu_op = ALU_ROL;
+      {7'b0110000, 3'b101}: bitmanip_alu_op = ALU_ROR;
+      {7'b0010100, 3'b001}: bitmanip_alu_op = ALU_BSET;
+      {7'b0100100, 3'b001}: bitmanip_alu_op = ALU_BCLR;
+      {7'b0110100, 3'b001}: bitmanip_alu_op = ALU_BINV;
+      {7'b0100100, 3'b101}: bitmanip_alu_op = ALU_BEXT;
+      default:              bitmanip = 0;
+    endcase
+  end else if(opcode == OPCODE_OP_IMM) begin
+    case({func7, func3})
+      {7'b0110000, 3'b001}: begin
+        case(instr_i[24:20])
+          5'b00000: bitmanip_alu_op = ALU_CLZ;
+          5'b00001: bitmanip_alu_op = ALU_CTZ;
+          5'b00010: bitmanip_alu_op = ALU_CPOP;
+          5'b00100: bitmanip_alu_op = ALU_SEXT_B;
+          5'b00101: bitmanip_alu_op = ALU_SEXT_H;
+          default:  bitmanip = 0;
+        endcase
+      end
+      {7'b0110000, 3'b101}: bitmanip_alu_op = ALU_ROR;
+      {7'b0010100, 3'b101}: begin
+        bitmanip_alu_op = ALU_ORC_B;
+        bitmanip = bitmanip && (instr_i[24:20] == 5'b00111);
+      end
+      {7'b0110100, 3'b101}: begin
+        bitmanip_alu_op = ALU_REV8;
+        bitmanip = bitmanip && (instr_i[24:20] == 5'b11000);
+      end
+      {7'b0010100, 3'b001}: bitmanip_alu_op = ALU_BSET;
+      {7'b0100100, 3'b001}: bitmanip_alu_op = ALU_BCLR;
+      {7'b0110100, 3'b001}: bitmanip_alu_op = ALU_BINV;
+      {7'b0100100, 3'b101}: bitmanip_alu_op = ALU_BEXT;
+      default:              bitmanip = 0;
+    endcase
+  end else begin
+    bitmanip = 0;
+  end
 end
 
 always_comb begin : branch_interface
@@ -214,9 +459,10 @@ always_comb begin : branch_interface
     default:    branch_cond = NO_BRANCH;
   endcase
 
-  if(opcode == OPCODE_BRANCH) begin
+  // Jumps and branches resolved in decode are not forwarded to the execute module
+  if((opcode == OPCODE_BRANCH) && !DECODE_BRANCH) begin
     branch_cond_d = branch_cond;
-  end else if((opcode == OPCODE_JAL) || (opcode == OPCODE_JALR)) begin
+  end else if(((opcode == OPCODE_JAL) && !DECODE_BRANCH) || (opcode == OPCODE_JALR) || fuse_jump || fence_i) begin
     branch_cond_d = BRANCH_UNCOND;
   end else begin
     branch_cond_d = NO_BRANCH;
@@ -225,13 +471,67 @@ always_comb begin : branch_interface
   branch_offset_d = immediate[19:0];
 end
 
+/*
+ * When DECODE_BRANCH is set, JAL and conditional branches are resolved from
+ * the register values read by decode, using a dedicated comparator and
+ * target adder. The branch request is issued to the fetch module during the
+ * input handshake of the instruction so that no wrong-path instruction enters
+ * the decode module. JALR is still resolved by the execute module.
+ */
+always_comb begin : branch_resolution
+  operands_eq  = (rdata1_i == rdata2_i);
+  operands_lt  = ($signed(rdata1_i) < $signed(rdata2_i));
+  operands_ltu = (rdata1_i < rdata2_i);
+
+  case(branch_cond)
+    BRANCH_BEQ:  branch_taken =  operands_eq;
+    BRANCH_BNE:  branch_taken = ~operands_eq;
+    BRANCH_BLT:  branch_taken =  operands_lt;
+    BRANCH_BLTU: branch_taken =  operands_ltu;
+    BRANCH_BGE:  branch_taken = ~operands_lt;
+    BRANCH_BGEU: branch_taken = ~operands_ltu;
+    default:     branch_taken =  0;
+  endcase
+
+  if(opcode == OPCODE_JAL) begin
+    branch_taken = 1;
+  end else if(opcode != OPCODE_BRANCH) begin
+    branch_taken = 0;
+  end
+
+  // A branch predicted taken by the fetch module only requires a redirection
+  // when it is not taken, in which case the fall-through address is used.
+  branch_target = branch_taken ? (pc_i + immediate) : (pc_i + instr_size);
+end
+
+// The source register of each operand is provided to the execute module for
+// forwarding, x0 being used when the operand is not read from the register file.
+always_comb begin : forwarding_interface
+  case(opcode)
+    OPCODE_JALR, OPCODE_BRANCH, OPCODE_OP, OPCODE_OP_IMM, OPCODE_LOAD, OPCODE_STORE:
+      alu_operand1_reg_d = raddr1_o;
+    OPCODE_AMO:
+      alu_operand1_reg_d = atomic ? raddr1_o : '0;
+    default:
+      alu_operand1_reg_d = '0;
+  endcase
+
+  case(opcode)
+    OPCODE_BRANCH,
+    OPCODE_OP:     alu_operand2_reg_d = raddr2_o;
+    default:       alu_operand2_reg_d = '0;
+  endcase
+
+  ls_write_data_reg_d = ((opcode == OPCODE_STORE) || atomic) ? raddr2_o : '0;
+end
+
 always_comb begin : writeback_interface
   reg_write_d = !((opcode == OPCODE_STORE) || (opcode == OPCODE_BRANCH));
   reg_addr_d = rd;
 end
 
 always_comb begin : loadstore_interface
-  ls_enable_d = (opcode == OPCODE_LOAD) || (opcode == OPCODE_STORE);
+  ls_enable_d = (opcode == OPCODE_LOAD) || (opcode == OPCODE_STORE) || atomic;
   ls_write_d = (opcode == OPCODE_STORE);
   ls_write_data_d = rdata2_i;
   case(func3[1:0])
@@ -241,6 +541,10 @@ always_comb begin : loadstore_interface
     default: ls_sel_d = '0;
   endcase
   ls_unsigned_load_d = (func3 == FUNC3_LBU) || (func3 == FUNC3_LHU);
+  // The operation of an atomic instruction is selected by its func5 field,
+  // the write of its operand being performed by the loadstore module
+  ls_atomic_d = atomic;
+  ls_atomic_op_d = instr_i[31:27];
 end
 
 always_comb begin : output_handshake
@@ -258,9 +562,17 @@ always_ff @(posedge clk_i) begin
     alu_sub_q           <=   0;
     alu_shift_left_q    <=   0;
     alu_signed_shift_q  <=   0;
+    muldiv_enable_q     <=   0;
+    muldiv_op_q         <=  '0;
 
     branch_cond_q       <=  '0;
     branch_offset_q     <=  '0;
+    pred_taken_q        <=   0;
+    pred_target_q       <=  '0;
+
+    alu_operand1_reg_q  <=  '0;
+    alu_operand2_reg_q  <=  '0;
+    ls_write_data_reg_q <=  '0;
 
     reg_write_q         <=   0;
     reg_addr_q          <=  '0;
@@ -270,11 +582,20 @@ always_ff @(posedge clk_i) begin
     ls_write_data_q     <=  '0;
     ls_sel_q            <=  '0;
     ls_unsigned_load_q  <=   0;
+    ls_atomic_q         <=   0;
+    ls_atomic_op_q      <=  '0;
+
+    fence_i_q           <=   0;
 
     output_valid_q      <=   0;
+
+    fused_count_q       <=  '0;
   end else begin
     if(output_ready_i && ~stall_request_i) begin
-      pc_q                <=  pc_i;
+      // A fused operation is output with the pc of its second instruction,
+      // providing the return address of a fused jump
+      pc_q                <=  fuse ? (pc_i + 32'h4) : pc_i;
+      compressed_q        <=  compressed_i;
 
       alu_operand1_q      <=  input_valid_i ? alu_operand1_d : '0;
       alu_operand2_q      <=  input_valid_i ? alu_operand2_d : '0;
@@ -282,9 +603,17 @@ always_ff @(posedge clk_i) begin
       alu_sub_q           <=  input_valid_i ? alu_sub_d : 0;
       alu_shift_left_q    <=  alu_shift_left_d;
       alu_signed_shift_q  <=  alu_signed_shift_d;
+      muldiv_enable_q     <=  input_valid_i ? muldiv_enable_d : 0;
+      muldiv_op_q         <=  muldiv_op_d;
 
       branch_cond_q       <=  input_valid_i ? branch_cond_d : NO_BRANCH;
       branch_offset_q     <=  branch_offset_d;
+      pred_taken_q        <=  input_valid_i ? pred_taken_i : 0;
+      pred_target_q       <=  pred_target_i;
+
+      alu_operand1_reg_q  <=  input_valid_i ? alu_operand1_reg_d : '0;
+      alu_operand2_reg_q  <=  input_valid_i ? alu_operand2_reg_d : '0;
+      ls_write_data_reg_q <=  input_valid_i ? ls_write_data_reg_d : '0;
 
       reg_write_q         <=  input_valid_i ? reg_write_d : 0;
       reg_addr_q          <=  reg_addr_d;
@@ -294,14 +623,27 @@ always_ff @(posedge clk_i) begin
       ls_write_data_q     <=  ls_write_data_d;
       ls_sel_q            <=  ls_sel_d;
       ls_unsigned_load_q  <=  ls_unsigned_load_d;
+      ls_atomic_q         <=  input_valid_i ? ls_atomic_d : 0;
+      ls_atomic_op_q      <=  ls_atomic_op_d;
+
+      fence_i_q           <=  input_valid_i ? fence_i : 0;
     end
-    if(stall_request_i) begin
+    // A bubble is output in place of the stalled instruction, an instruction
+    // held by the following module is kept until it is consumed
+    if(output_ready_i && stall_request_i) begin
       ls_enable_q <= 0;
+      ls_atomic_q <= 0;
+      fence_i_q <= 0;
       reg_write_q <= 0;
       reg_addr_q <= 0;
+      muldiv_enable_q <= 0;
     end
 
     output_valid_q    <= output_valid_d;
+
+    if(fuse_o && input_ready_o && ~discard_request_i) begin
+      fused_count_q <= fused_count_q + 1;
+    end
   end
 end
 
@@ -310,8 +652,10 @@ end
 /*****************************************/
 
 assign  input_ready_o       =  output_ready_i && ~stall_request_i;
+assign  fuse_o              =  input_valid_i && fuse;
 
 assign  pc_o                =  pc_q;
+assign  compressed_o        =  compressed_q;
 
 assign  alu_operand1_o      =  alu_operand1_q;
 assign  alu_operand2_o      =  alu_operand2_q;
@@ -319,9 +663,17 @@ assign  alu_op_o            =  alu_op_q;
 assign  alu_sub_o           =  alu_sub_q;
 assign  alu_shift_left_o    =  alu_shift_left_q;
 assign  alu_signed_shift_o  =  alu_signed_shift_q;
+assign  muldiv_enable_o     =  muldiv_enable_q;
+assign  muldiv_op_o         =  muldiv_op_q;
 
 assign  branch_cond_o       =  branch_cond_q;
 assign  branch_offset_o     =  branch_offset_q;
+assign  pred_taken_o        =  pred_taken_q;
+assign  pred_target_o       =  pred_target_q;
+
+assign  alu_operand1_reg_o  =  alu_operand1_reg_q;
+assign  alu_operand2_reg_o  =  alu_operand2_reg_q;
+assign  ls_write_data_reg_o =  ls_write_data_reg_q;
 
 assign  reg_write_o         =  reg_write_q;
 assign  reg_addr_o          =  reg_addr_q;
@@ -331,7 +683,28 @@ assign  ls_write_o          =  ls_write_q;
 assign  ls_write_data_o     =  ls_write_data_q;
 assign  ls_sel_o            =  ls_sel_q;
 assign  ls_unsigned_load_o    =  ls_unsigned_load_q;
+assign  ls_atomic_o         =  ls_atomic_q;
+assign  ls_atomic_op_o      =  ls_atomic_op_q;
+
+assign  fence_i_o           =  fence_i_q;
 
 assign  output_valid_o = output_valid_q;
 
+// A branch is not requested for a wrong-path instruction when the execute
+// module is already performing a branch, nor when the outcome matches the
+// prediction of the fetch module. The prediction of a JALR is checked by the
+// execute module.
+assign  branch_o          =  DECODE_BRANCH && input_valid_i && input_ready_o && ~discard_request_i
+                               && ((opcode == OPCODE_JAL) || (opcode == OPCODE_BRANCH))
+                               && (branch_taken != pred_taken_i);
+assign  branch_target_o   =  branch_target;
+assign  branch_compare_o  =  DECODE_BRANCH && (opcode == OPCODE_BRANCH);
+
+assign  bp_update_o       =  DECODE_BRANCH && input_valid_i && input_ready_o && ~discard_request_i
+                               && (opcode == OPCODE_BRANCH);
+assign  bp_pc_o           =  pc_i;
+assign  bp_taken_o        =  branch_taken;
+assign  bp_target_o       =  pc_i + immediate;
+assign  bp_mispredict_o   =  (branch_taken != pred_taken_i);
+
 endmodule // decode
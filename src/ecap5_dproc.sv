@@ -21,7 +21,51 @@
  */
 
 module ecap5_dproc #(
-  parameter logic[31:0] BOOT_ADDRESS      = 32'h00001000
+  parameter logic[31:0] BOOT_ADDRESS           = 32'h00001000,
+  parameter logic       PIPELINED_FETCH        = 0,
+  parameter int         FETCH_DEPTH            = 4,
+  parameter int         PREFETCH_QUEUE_DEPTH   = 0,
+  parameter logic       FORWARDING             = 0,
+  parameter logic       REGISTER_WRITE_THROUGH = 0,
+  parameter logic       DECODE_BRANCH          = 0,
+  parameter logic       BRANCH_PREDICTION      = 0,
+  parameter logic       BRANCH_PREDICTOR       = 0,
+  parameter int         BP_ENTRIES             = 16,
+  parameter int         BP_WAYS                = 1,
+  parameter int         BP_HISTORY_LENGTH      = 0,
+  parameter int         RAS_DEPTH              = 0,
+  parameter logic       MULDIV                 = 0,
+  parameter int         MUL_STAGES             = 1,
+  parameter int         DIV_RADIX              = 2,
+  parameter logic       BITMANIP               = 0,
+  parameter logic       COMPRESSED             = 0,
+  parameter logic       FUSION                 = 0,
+  parameter int         STORE_BUFFER_DEPTH     = 0,
+  parameter logic       NON_BLOCKING_LOADS     = 0,
+  parameter logic       MISALIGNED_ACCESS      = 0,
+  parameter logic       ATOMIC                 = 0,
+  parameter logic       ITCM                   = 0,
+  parameter logic[31:0] ITCM_BASE              = 32'h00001000,
+  parameter int         ITCM_SIZE              = 4096,
+  parameter logic       DTCM                   = 0,
+  parameter logic[31:0] DTCM_BASE              = 32'h00004000,
+  parameter int         DTCM_SIZE              = 4096,
+  parameter logic       ICACHE                 = 0,
+  parameter int         ICACHE_SIZE            = 1024,
+  parameter int         ICACHE_LINE_SIZE       = 16,
+  parameter int         ICACHE_WAYS            = 1,
+  parameter logic       DCACHE                 = 0,
+  parameter int         DCACHE_SIZE            = 1024,
+  parameter int         DCACHE_LINE_SIZE       = 16,
+  parameter int         DCACHE_WAYS            = 1,
+  parameter logic[31:0] DCACHE_UNCACHED_BASE   = 32'h80000000,
+  parameter logic[31:0] DCACHE_UNCACHED_LIMIT  = 32'hFFFFFFFF,
+  parameter logic       MEMORY_FAST_SWITCH     = 0,
+  parameter int         MEMORY_OUTSTANDING     = 0,
+  parameter logic[1:0]  MEMORY_ARBITRATION     = 0,
+  parameter logic       HARVARD                = 0,
+  parameter logic       AXI                    = 0,
+  parameter int         AXI_OUTSTANDING        = 4
 )(
   input  logic        clk_i,
   input  logic        rst_i,
@@ -34,7 +78,67 @@ module ecap5_dproc #(
   output logic        wb_stb_o,
   input  logic        wb_ack_i,
   output logic        wb_cyc_o,
-  input  logic        wb_stall_i
+  input  logic        wb_stall_i,
+  output logic[2:0]   wb_cti_o,
+  output logic[1:0]   wb_bte_o,
+
+  // Instruction bus, used instead of the wb bus when HARVARD is set
+  output logic[31:0]  ibus_adr_o,
+  input  logic[31:0]  ibus_dat_i,
+  output logic[3:0]   ibus_sel_o,
+  output logic        ibus_we_o,
+  output logic        ibus_stb_o,
+  input  logic        ibus_ack_i,
+  output logic        ibus_cyc_o,
+  input  logic        ibus_stall_i,
+  output logic[2:0]   ibus_cti_o,
+  output logic[1:0]   ibus_bte_o,
+
+  // Data bus, used instead of the wb bus when HARVARD is set
+  output logic[31:0]  dbus_adr_o,
+  input  logic[31:0]  dbus_dat_i,
+  output logic[31:0]  dbus_dat_o,
+  output logic[3:0]   dbus_sel_o,
+  output logic        dbus_we_o,
+  output logic        dbus_stb_o,
+  input  logic        dbus_ack_i,
+  output logic        dbus_cyc_o,
+  input  logic        dbus_stall_i,
+  output logic[2:0]   dbus_cti_o,
+  output logic[1:0]   dbus_bte_o,
+
+  // AXI4 bus, used instead of the wb bus when AXI is set
+  output logic[31:0]  axi_awaddr_o,
+  output logic[7:0]   axi_awlen_o,
+  output logic[2:0]   axi_awsize_o,
+  output logic[1:0]   axi_awburst_o,
+  output logic        axi_awvalid_o,
+  input  logic        axi_awready_i,
+  output logic[31:0]  axi_wdata_o,
+  output logic[3:0]   axi_wstrb_o,
+  output logic        axi_wlast_o,
+  output logic        axi_wvalid_o,
+  input  logic        axi_wready_i,
+  input  logic[1:0]   axi_bresp_i,
+  input  logic        axi_bvalid_i,
+  output logic        axi_bready_o,
+  output logic[31:0]  axi_araddr_o,
+  output logic[7:0]   axi_arlen_o,
+  output logic[2:0]   axi_arsize_o,
+  output logic[1:0]   axi_arburst_o,
+  output logic        axi_arvalid_o,
+  input  logic        axi_arready_i,
+  input  logic[31:0]  axi_rdata_i,
+  input  logic[1:0]   axi_rresp_i,
+  input  logic        axi_rlast_i,
+  input  logic        axi_rvalid_i,
+  output logic        axi_rready_o,
+
+  // Word reserved by LR, the reservation being invalidated by the system
+  // through the kill input when another master writes the reserved word
+  output logic        reservation_valid_o,
+  output logic[31:0]  reservation_adr_o,
+  input  logic        reservation_kill_i
 );
 
 // registers interface
@@ -45,6 +149,11 @@ logic       reg_write;
 // branch interface
 logic       branch;
 logic[31:0] branch_target;
+logic       dec_branch;
+logic[31:0] dec_branch_target;
+logic       ex_branch;
+logic[31:0] ex_branch_target;
+logic       ex_fence_i;
 
 // fetch wishbone
 logic[31:0]  if_wb_adr_o;
@@ -56,20 +165,98 @@ logic        if_wb_ack_i;
 logic        if_wb_cyc_o;
 logic        if_wb_stall_i;
 
+// instruction tightly-coupled memory wishbone
+logic[31:0]  it_wb_adr_o;
+logic[31:0]  it_wb_dat_i;
+logic        it_wb_we_o;
+logic[3:0]   it_wb_sel_o;
+logic        it_wb_stb_o;
+logic        it_wb_ack_i;
+logic        it_wb_cyc_o;
+logic        it_wb_stall_i;
+
+// instruction cache wishbone
+logic[31:0]  ic_wb_adr_o;
+logic[31:0]  ic_wb_dat_i;
+logic        ic_wb_we_o;
+logic[3:0]   ic_wb_sel_o;
+logic        ic_wb_stb_o;
+logic        ic_wb_ack_i;
+logic        ic_wb_cyc_o;
+logic        ic_wb_stall_i;
+logic[2:0]   ic_wb_cti_o;
+logic[1:0]   ic_wb_bte_o;
+
+// branch predictor interface
+logic[31:0] bp_lookup_pc;
+logic       bp_lookup_hit;
+logic       bp_lookup_taken;
+logic[31:0] bp_lookup_target;
+logic       bp_update;
+logic[31:0] bp_pc;
+logic       bp_taken;
+logic[31:0] bp_target;
+logic       bp_mispredict;
+logic       dec_bp_update;
+logic[31:0] dec_bp_pc;
+logic       dec_bp_taken;
+logic[31:0] dec_bp_target;
+logic       dec_bp_mispredict;
+logic       ex_bp_update;
+logic[31:0] ex_bp_pc;
+logic       ex_bp_taken;
+logic[31:0] ex_bp_target;
+logic       ex_bp_mispredict;
+
 // fetch output
 logic[31:0] if_instr;
 logic[31:0] if_pc;
+logic       if_pred_taken;
+logic[31:0] if_pred_target;
+
+// prefetch queue output
+logic[31:0] pq_instr;
+logic[31:0] pq_pc;
+logic       pq_pred_taken;
+logic[31:0] pq_pred_target;
+logic       pq_next_valid;
+logic[31:0] pq_next_instr;
+logic       pq_next_pred_taken;
+logic       pq_skip;
+
+// aligner output
+logic[31:0] al_aligned_instr;
+logic[31:0] al_instr;
+logic[31:0] al_pc;
+logic       al_compressed;
+logic       al_pred_taken;
+logic[31:0] al_pred_target;
+logic       al_next_valid;
+logic[31:0] al_next_instr;
+logic       al_next_pred_taken;
+
+// expander output
+logic[31:0] exp_instr;
 
 // decode output
+logic        dec_fuse;
 logic[31:0]  dec_pc;
+logic        dec_compressed;
 logic[31:0]  dec_alu_operand1;
 logic[31:0]  dec_alu_operand2;
-logic[2:0]   dec_alu_op;
+logic[4:0]   dec_alu_op;
 logic        dec_alu_sub;
 logic        dec_alu_shift_left;
 logic        dec_alu_signed_shift;
+logic        dec_muldiv_enable;
+logic[2:0]   dec_muldiv_op;
 logic[2:0]   dec_branch_cond;
 logic[19:0]  dec_branch_offset;
+logic        dec_pred_taken;
+logic[31:0]  dec_pred_target;
+logic[4:0]   dec_alu_operand1_reg;
+logic[4:0]   dec_alu_operand2_reg;
+logic[4:0]   dec_ls_write_data_reg;
 logic        dec_reg_write;
 logic[4:0]   dec_reg_addr;
 logic        dec_ls_enable;
@@ -77,6 +264,10 @@ logic        dec_ls_write;
 logic[31:0]  dec_ls_write_data;
 logic[3:0]   dec_ls_sel;
 logic        dec_ls_unsigned_load;
+logic        dec_ls_atomic;
+logic[4:0]   dec_ls_atomic_op;
+logic        dec_fence_i;
+logic        dec_branch_compare;
 
 // execute output
 logic[31:0] ex_result;
@@ -85,6 +276,8 @@ logic       ex_ls_write;
 logic[31:0] ex_ls_write_data;
 logic[3:0]  ex_ls_sel;
 logic       ex_ls_unsigned_load;
+logic       ex_ls_atomic;
+logic[4:0]  ex_ls_atomic_op;
 logic       ex_reg_write;
 logic[4:0]  ex_reg_addr;
 
@@ -99,22 +292,78 @@ logic        ls_wb_ack_i;
 logic        ls_wb_cyc_o;
 logic        ls_wb_stall_i;
 
+// data port of the instruction tightly-coupled memory wishbone
+logic[31:0]  id_wb_adr_o;
+logic[31:0]  id_wb_dat_i;
+logic[31:0]  id_wb_dat_o;
+logic        id_wb_we_o;
+logic[3:0]   id_wb_sel_o;
+logic        id_wb_stb_o;
+logic        id_wb_ack_i;
+logic        id_wb_cyc_o;
+logic        id_wb_stall_i;
+
+// data tightly-coupled memory wishbone
+logic[31:0]  dt_wb_adr_o;
+logic[31:0]  dt_wb_dat_i;
+logic[31:0]  dt_wb_dat_o;
+logic        dt_wb_we_o;
+logic[3:0]   dt_wb_sel_o;
+logic        dt_wb_stb_o;
+logic        dt_wb_ack_i;
+logic        dt_wb_cyc_o;
+logic        dt_wb_stall_i;
+
+// data cache wishbone
+logic[31:0]  dc_wb_adr_o;
+logic[31:0]  dc_wb_dat_i;
+logic[31:0]  dc_wb_dat_o;
+logic        dc_wb_we_o;
+logic[3:0]   dc_wb_sel_o;
+logic        dc_wb_stb_o;
+logic        dc_wb_ack_i;
+logic        dc_wb_cyc_o;
+logic        dc_wb_stall_i;
+logic[2:0]   dc_wb_cti_o;
+logic[1:0]   dc_wb_bte_o;
+
+// memory wishbone
+logic[31:0]  mem_wb_adr_o;
+logic[31:0]  mem_wb_dat_i;
+logic[31:0]  mem_wb_dat_o;
+logic        mem_wb_we_o;
+logic[3:0]   mem_wb_sel_o;
+logic        mem_wb_stb_o;
+logic        mem_wb_ack_i;
+logic        mem_wb_cyc_o;
+logic        mem_wb_stall_i;
+logic[2:0]   mem_wb_cti_o;
+logic[1:0]   mem_wb_bte_o;
+
 // loadstore output
 logic       ls_reg_write;
 logic[4:0]  ls_reg_addr;
 logic[31:0] ls_reg_data;
+logic[31:0] ls_scoreboard;
 
 // hazard output
 logic       hzd_ex_discard_request;
+logic       hzd_dec_discard_request;
 logic       hzd_dec_stall_request;
+logic[31:0] hzd_dec_rdata1;
+logic[31:0] hzd_dec_rdata2;
 
 // handshake
-logic  if_dec_ready,  if_dec_valid,
+logic  if_pq_ready,   if_pq_valid,
+       pq_al_ready,   pq_al_valid,
+       if_dec_ready,  if_dec_valid,
        dec_ex_ready,  dec_ex_valid,  
        ex_ls_ready,   ex_ls_valid,   
        ls_valid;                        
 
-registers registers_inst (
+registers #(
+ .WRITE_THROUGH (REGISTER_WRITE_THROUGH)
+) registers_inst (
   .clk_i     (clk_i),
 
   .raddr1_i  (reg_raddr1),
@@ -128,8 +377,18 @@ registers registers_inst (
   .wdata_i   (reg_wdata)
 );
 
+// The branch requested by the execute module takes precedence as it belongs
+// to an older instruction.
+assign branch        = ex_branch || dec_branch;
+assign branch_target = ex_branch ? ex_branch_target : dec_branch_target;
+
 fetch #(
- .BOOT_ADDRESS      (BOOT_ADDRESS)
+ .BOOT_ADDRESS      (BOOT_ADDRESS),
+ .PIPELINED_FETCH   (PIPELINED_FETCH),
+ .FETCH_DEPTH       (FETCH_DEPTH),
+ .BRANCH_PREDICTION (BRANCH_PREDICTION),
+ .RAS_DEPTH         (RAS_DEPTH),
+ .COMPRESSED        (COMPRESSED)
 ) fetch_inst (
   .clk_i            (clk_i),
   .rst_i            (rst_i),
@@ -146,32 +405,193 @@ fetch #(
   .wb_cyc_o         (if_wb_cyc_o),
   .wb_stall_i       (if_wb_stall_i),
 
-  .output_ready_i   (if_dec_ready),
-  .output_valid_o   (if_dec_valid),
+  .output_ready_i   (if_pq_ready),
+  .output_valid_o   (if_pq_valid),
 
   .instr_o          (if_instr),
-  .pc_o             (if_pc)
+  .pc_o             (if_pc),
+  .pred_taken_o     (if_pred_taken),
+  .pred_target_o    (if_pred_target),
+
+  .bp_lookup_pc_o     (bp_lookup_pc),
+  .bp_lookup_hit_i    (bp_lookup_hit),
+  .bp_lookup_taken_i  (bp_lookup_taken),
+  .bp_lookup_target_i (bp_lookup_target)
 );
 
-decode decode_inst (
+// The branch predictor is trained by the module resolving the conditional
+// branches.
+assign bp_update     = DECODE_BRANCH ? dec_bp_update     : ex_bp_update;
+assign bp_pc         = DECODE_BRANCH ? dec_bp_pc         : ex_bp_pc;
+assign bp_taken      = DECODE_BRANCH ? dec_bp_taken      : ex_bp_taken;
+assign bp_target     = DECODE_BRANCH ? dec_bp_target     : ex_bp_target;
+assign bp_mispredict = DECODE_BRANCH ? dec_bp_mispredict : ex_bp_mispredict;
+
+generate
+  if(BRANCH_PREDICTOR) begin : branch_predictor_gen
+    branch_predictor #(
+     .ENTRIES              (BP_ENTRIES),
+     .WAYS                 (BP_WAYS),
+     .HISTORY_LENGTH       (BP_HISTORY_LENGTH)
+    ) branch_predictor_inst (
+      .clk_i                (clk_i),
+      .rst_i                (rst_i),
+
+      .lookup_pc_i          (bp_lookup_pc),
+      .lookup_hit_o         (bp_lookup_hit),
+      .lookup_taken_o       (bp_lookup_taken),
+      .lookup_target_o      (bp_lookup_target),
+
+      .update_i             (bp_update),
+      .update_pc_i          (bp_pc),
+      .update_taken_i       (bp_taken),
+      .update_target_i      (bp_target),
+      .update_mispredict_i  (bp_mispredict)
+    );
+  end else begin : branch_predictor_bypass
+    assign bp_lookup_hit     =  0;
+    assign bp_lookup_taken   =  0;
+    assign bp_lookup_target  =  '0;
+  end
+endgenerate
+
+generate
+  if(PREFETCH_QUEUE_DEPTH > 0) begin : prefetch_queue_gen
+    prefetch_queue #(
+     .DEPTH            (PREFETCH_QUEUE_DEPTH)
+    ) prefetch_queue_inst (
+      .clk_i            (clk_i),
+      .rst_i            (rst_i),
+
+      .flush_i          (branch),
+
+      .input_ready_o    (if_pq_ready),
+      .input_valid_i    (if_pq_valid),
+
+      .instr_i          (if_instr),
+      .pc_i             (if_pc),
+      .pred_taken_i     (if_pred_taken),
+      .pred_target_i    (if_pred_target),
+
+      .output_ready_i   (pq_al_ready),
+      .output_valid_o   (pq_al_valid),
+
+      .instr_o          (pq_instr),
+      .pc_o             (pq_pc),
+      .pred_taken_o     (pq_pred_taken),
+      .pred_target_o    (pq_pred_target),
+
+      .output_skip_i      (pq_skip),
+      .next_valid_o       (pq_next_valid),
+      .next_instr_o       (pq_next_instr),
+      .next_pred_taken_o  (pq_next_pred_taken)
+    );
+  end else begin : prefetch_queue_bypass
+    assign if_pq_ready   =  pq_al_ready;
+    assign pq_al_valid   =  if_pq_valid;
+    assign pq_instr       =  if_instr;
+    assign pq_pc          =  if_pc;
+    assign pq_pred_taken  =  if_pred_taken;
+    assign pq_pred_target =  if_pred_target;
+    // No instruction is available for fusion without the prefetch queue
+    assign pq_next_valid      =  0;
+    assign pq_next_instr      =  '0;
+    assign pq_next_pred_taken =  0;
+  end
+endgenerate
+
+// The compressed instructions are extracted from the fetched words by the
+// aligner and expanded into their 32-bit equivalent in front of decode. The
+// prediction of the fetch module and the fusion of instructions are not
+// available in this configuration.
+generate
+  if(COMPRESSED) begin : compressed_gen
+    aligner aligner_inst (
+      .clk_i            (clk_i),
+      .rst_i            (rst_i),
+
+      .flush_i          (branch),
+
+      .input_ready_o    (pq_al_ready),
+      .input_valid_i    (pq_al_valid),
+
+      .instr_i          (pq_instr),
+      .pc_i             (pq_pc),
+
+      .output_ready_i   (if_dec_ready),
+      .output_valid_o   (if_dec_valid),
+
+      .instr_o          (al_aligned_instr),
+      .pc_o             (al_pc),
+      .compressed_o     (al_compressed)
+    );
+
+    expander expander_inst (
+      .instr_i          (al_aligned_instr[15:0]),
+      .instr_o          (exp_instr)
+    );
+
+    assign al_instr       =  al_compressed ? exp_instr : al_aligned_instr;
+    assign al_pred_taken  =  0;
+    assign al_pred_target =  '0;
+
+    assign al_next_valid      =  0;
+    assign al_next_instr      =  '0;
+    assign al_next_pred_taken =  0;
+    assign pq_skip            =  0;
+  end else begin : compressed_bypass
+    assign pq_al_ready      =  if_dec_ready;
+    assign if_dec_valid     =  pq_al_valid;
+    assign al_aligned_instr =  pq_instr;
+    assign al_instr         =  pq_instr;
+    assign al_pc            =  pq_pc;
+    assign al_compressed    =  0;
+    assign al_pred_taken    =  pq_pred_taken;
+    assign al_pred_target   =  pq_pred_target;
+    assign exp_instr        =  '0;
+
+    assign al_next_valid      =  pq_next_valid;
+    assign al_next_instr      =  pq_next_instr;
+    assign al_next_pred_taken =  pq_next_pred_taken;
+    assign pq_skip            =  dec_fuse;
+  end
+endgenerate
+
+decode #(
+ .DECODE_BRANCH       (DECODE_BRANCH),
+ .MULDIV              (MULDIV),
+ .BITMANIP            (BITMANIP),
+ .FUSION              (FUSION),
+ .ATOMIC              (ATOMIC),
+ .FENCE_I             (ICACHE)
+) decode_inst (
   .clk_i               (clk_i),
   .rst_i               (rst_i),
 
   .input_ready_o       (if_dec_ready),
   .input_valid_i       (if_dec_valid),
 
-  .instr_i             (if_instr),
-  .pc_i                (if_pc),
+  .instr_i             (al_instr),
+  .pc_i                (al_pc),
+  .compressed_i        (al_compressed),
+  .pred_taken_i        (al_pred_taken),
+  .pred_target_i       (al_pred_target),
+
+  .next_valid_i        (al_next_valid),
+  .next_instr_i        (al_next_instr),
+  .next_pred_taken_i   (al_next_pred_taken),
+  .fuse_o              (dec_fuse),
 
   .raddr1_o            (reg_raddr1),
-  .rdata1_i            (reg_rdata1),
+  .rdata1_i            (hzd_dec_rdata1),
   .raddr2_o            (reg_raddr2),
-  .rdata2_i            (reg_rdata2),
+  .rdata2_i            (hzd_dec_rdata2),
 
   .output_ready_i      (dec_ex_ready),
   .output_valid_o      (dec_ex_valid),
 
   .pc_o                (dec_pc),
+  .compressed_o        (dec_compressed),
 
   .alu_operand1_o      (dec_alu_operand1),
   .alu_operand2_o      (dec_alu_operand2),
@@ -179,9 +599,17 @@ decode decode_inst (
   .alu_sub_o           (dec_alu_sub),
   .alu_shift_left_o    (dec_alu_shift_left),
   .alu_signed_shift_o  (dec_alu_signed_shift),
+  .muldiv_enable_o     (dec_muldiv_enable),
+  .muldiv_op_o         (dec_muldiv_op),
 
   .branch_cond_o       (dec_branch_cond),
   .branch_offset_o     (dec_branch_offset),
+  .pred_taken_o        (dec_pred_taken),
+  .pred_target_o       (dec_pred_target),
+
+  .alu_operand1_reg_o  (dec_alu_operand1_reg),
+  .alu_operand2_reg_o  (dec_alu_operand2_reg),
+  .ls_write_data_reg_o (dec_ls_write_data_reg),
 
   .reg_write_o         (dec_reg_write),
   .reg_addr_o          (dec_reg_addr),
@@ -191,11 +619,32 @@ decode decode_inst (
   .ls_write_data_o     (dec_ls_write_data),
   .ls_sel_o            (dec_ls_sel),
   .ls_unsigned_load_o  (dec_ls_unsigned_load),
+  .ls_atomic_o         (dec_ls_atomic),
+  .ls_atomic_op_o      (dec_ls_atomic_op),
 
-  .stall_request_i     (hzd_dec_stall_request)
+  .fence_i_o           (dec_fence_i),
+
+  .branch_o            (dec_branch),
+  .branch_target_o     (dec_branch_target),
+
+  .bp_update_o         (dec_bp_update),
+  .bp_pc_o             (dec_bp_pc),
+  .bp_taken_o          (dec_bp_taken),
+  .bp_target_o         (dec_bp_target),
+  .bp_mispredict_o     (dec_bp_mispredict),
+
+  .stall_request_i     (hzd_dec_stall_request),
+  .discard_request_i   (hzd_dec_discard_request),
+  .branch_compare_o    (dec_branch_compare)
 );
 
-execute execute_inst (
+execute #(
+ .FORWARDING          (FORWARDING),
+ .MULDIV              (MULDIV),
+ .MUL_STAGES          (MUL_STAGES),
+ .DIV_RADIX           (DIV_RADIX),
+ .BITMANIP            (BITMANIP)
+) execute_inst (
   .clk_i               (clk_i),
   .rst_i               (rst_i),
 
@@ -203,6 +652,7 @@ execute execute_inst (
   .input_valid_i       (dec_ex_valid),
 
   .pc_i                (dec_pc),
+  .compressed_i        (dec_compressed),
 
   .alu_operand1_i      (dec_alu_operand1),
   .alu_operand2_i      (dec_alu_operand2),
@@ -210,18 +660,30 @@ execute execute_inst (
   .alu_sub_i           (dec_alu_sub),
   .alu_shift_left_i    (dec_alu_shift_left),
   .alu_signed_shift_i  (dec_alu_signed_shift),
+  .muldiv_enable_i     (dec_muldiv_enable),
+  .muldiv_op_i         (dec_muldiv_op),
+
+  .alu_operand1_reg_i  (dec_alu_operand1_reg),
+  .alu_operand2_reg_i  (dec_alu_operand2_reg),
+  .ls_write_data_reg_i (dec_ls_write_data_reg),
 
   .ls_enable_i         (dec_ls_enable),
   .ls_write_i          (dec_ls_write),
   .ls_write_data_i     (dec_ls_write_data),
   .ls_sel_i            (dec_ls_sel),
   .ls_unsigned_load_i  (dec_ls_unsigned_load),
+  .ls_atomic_i         (dec_ls_atomic),
+  .ls_atomic_op_i      (dec_ls_atomic_op),
+
+  .fence_i_i           (dec_fence_i),
 
   .reg_write_i         (dec_reg_write),
   .reg_addr_i          (dec_reg_addr),
 
   .branch_cond_i       (dec_branch_cond),
   .branch_offset_i     (dec_branch_offset),
+  .pred_taken_i        (dec_pred_taken),
+  .pred_target_i       (dec_pred_target),
 
   .output_ready_i      (ex_ls_ready),
   .output_valid_o      (ex_ls_valid),
@@ -233,17 +695,31 @@ execute execute_inst (
   .ls_write_data_o     (ex_ls_write_data),
   .ls_sel_o            (ex_ls_sel),
   .ls_unsigned_load_o  (ex_ls_unsigned_load),
+  .ls_atomic_o         (ex_ls_atomic),
+  .ls_atomic_op_o      (ex_ls_atomic_op),
 
   .reg_write_o         (ex_reg_write),
   .reg_addr_o          (ex_reg_addr),
 
-  .branch_o            (branch),
-  .branch_target_o     (branch_target),
+  .branch_o            (ex_branch),
+  .branch_target_o     (ex_branch_target),
+  .fence_i_o           (ex_fence_i),
+
+  .bp_update_o         (ex_bp_update),
+  .bp_pc_o             (ex_bp_pc),
+  .bp_taken_o          (ex_bp_taken),
+  .bp_target_o         (ex_bp_target),
+  .bp_mispredict_o     (ex_bp_mispredict),
 
   .discard_request_i   (hzd_ex_discard_request)
 );
 
-loadstore loadstore_inst (
+loadstore #(
+ .STORE_BUFFER_DEPTH (STORE_BUFFER_DEPTH),
+ .NON_BLOCKING_LOADS (NON_BLOCKING_LOADS),
+ .MISALIGNED_ACCESS  (MISALIGNED_ACCESS),
+ .ATOMIC             (ATOMIC)
+) loadstore_inst (
   .clk_i            (clk_i),
   .rst_i            (rst_i),
 
@@ -256,6 +732,12 @@ loadstore loadstore_inst (
   .write_data_i     (ex_ls_write_data),
   .sel_i            (ex_ls_sel),
   .unsigned_load_i  (ex_ls_unsigned_load),
+  .atomic_i         (ex_ls_atomic),
+  .atomic_op_i      (ex_ls_atomic_op),
+
+  .reservation_kill_i  (reservation_kill_i),
+  .reservation_valid_o (reservation_valid_o),
+  .reservation_adr_o   (reservation_adr_o),
 
   .reg_write_i      (ex_reg_write),
   .reg_addr_i       (ex_reg_addr),
@@ -274,7 +756,9 @@ loadstore loadstore_inst (
 
   .reg_write_o      (ls_reg_write),
   .reg_addr_o       (ls_reg_addr),
-  .reg_data_o       (ls_reg_data)
+  .reg_data_o       (ls_reg_data),
+
+  .scoreboard_o     (ls_scoreboard)
 );
 
 writeback writeback_inst (
@@ -292,47 +776,449 @@ writeback writeback_inst (
   .reg_data_o     (reg_wdata)
 );
 
-memory memory_inst (
-  .clk_i (clk_i),
-  .rst_i (rst_i),
-
-  .s1_wb_adr_i   (if_wb_adr_o),
-  .s1_wb_dat_o   (if_wb_dat_i),
-  .s1_wb_dat_i   ('0),
-  .s1_wb_we_i    (if_wb_we_o),
-  .s1_wb_sel_i   (if_wb_sel_o),
-  .s1_wb_stb_i   (if_wb_stb_o),
-  .s1_wb_ack_o   (if_wb_ack_i),
-  .s1_wb_cyc_i   (if_wb_cyc_o),
-  .s1_wb_stall_o (if_wb_stall_i),
-
-  .s2_wb_adr_i   (ls_wb_adr_o),
-  .s2_wb_dat_o   (ls_wb_dat_i),
-  .s2_wb_dat_i   (ls_wb_dat_o),
-  .s2_wb_we_i    (ls_wb_we_o),
-  .s2_wb_sel_i   (ls_wb_sel_o),
-  .s2_wb_stb_i   (ls_wb_stb_o),
-  .s2_wb_ack_o   (ls_wb_ack_i),
-  .s2_wb_cyc_i   (ls_wb_cyc_o),
-  .s2_wb_stall_o (ls_wb_stall_i),
-
-  .m_wb_adr_o   (wb_adr_o),
-  .m_wb_dat_i   (wb_dat_i),
-  .m_wb_dat_o   (wb_dat_o),
-  .m_wb_we_o    (wb_we_o),
-  .m_wb_sel_o   (wb_sel_o),
-  .m_wb_stb_o   (wb_stb_o),
-  .m_wb_ack_i   (wb_ack_i),
-  .m_wb_cyc_o   (wb_cyc_o),
-  .m_wb_stall_i (wb_stall_i)
-);
-
-hazard hazard_inst (
+generate
+  if(ITCM) begin : itcm_gen
+    tcm #(
+     .BASE            (ITCM_BASE),
+     .SIZE            (ITCM_SIZE)
+    ) itcm_inst (
+      .clk_i          (clk_i),
+      .rst_i          (rst_i),
+
+      .s_wb_adr_i     (if_wb_adr_o),
+      .s_wb_dat_o     (if_wb_dat_i),
+      .s_wb_dat_i     ('0),
+      .s_wb_we_i      (if_wb_we_o),
+      .s_wb_sel_i     (if_wb_sel_o),
+      .s_wb_stb_i     (if_wb_stb_o),
+      .s_wb_ack_o     (if_wb_ack_i),
+      .s_wb_cyc_i     (if_wb_cyc_o),
+      .s_wb_stall_o   (if_wb_stall_i),
+
+      .m_wb_adr_o     (it_wb_adr_o),
+      .m_wb_dat_i     (it_wb_dat_i),
+      .m_wb_dat_o     (),
+      .m_wb_we_o      (it_wb_we_o),
+      .m_wb_sel_o     (it_wb_sel_o),
+      .m_wb_stb_o     (it_wb_stb_o),
+      .m_wb_ack_i     (it_wb_ack_i),
+      .m_wb_cyc_o     (it_wb_cyc_o),
+      .m_wb_stall_i   (it_wb_stall_i),
+
+      // The loadstore module accesses the memory through the second port,
+      // its requests outside of the memory range being forwarded to the
+      // data tightly-coupled memory.
+      .s2_wb_adr_i    (ls_wb_adr_o),
+      .s2_wb_dat_o    (ls_wb_dat_i),
+      .s2_wb_dat_i    (ls_wb_dat_o),
+      .s2_wb_we_i     (ls_wb_we_o),
+      .s2_wb_sel_i    (ls_wb_sel_o),
+      .s2_wb_stb_i    (ls_wb_stb_o),
+      .s2_wb_ack_o    (ls_wb_ack_i),
+      .s2_wb_cyc_i    (ls_wb_cyc_o),
+      .s2_wb_stall_o  (ls_wb_stall_i),
+
+      .m2_wb_adr_o    (id_wb_adr_o),
+      .m2_wb_dat_i    (id_wb_dat_i),
+      .m2_wb_dat_o    (id_wb_dat_o),
+      .m2_wb_we_o     (id_wb_we_o),
+      .m2_wb_sel_o    (id_wb_sel_o),
+      .m2_wb_stb_o    (id_wb_stb_o),
+      .m2_wb_ack_i    (id_wb_ack_i),
+      .m2_wb_cyc_o    (id_wb_cyc_o),
+      .m2_wb_stall_i  (id_wb_stall_i)
+    );
+  end else begin : itcm_bypass
+    assign it_wb_adr_o   =  if_wb_adr_o;
+    assign if_wb_dat_i   =  it_wb_dat_i;
+    assign it_wb_we_o    =  if_wb_we_o;
+    assign it_wb_sel_o   =  if_wb_sel_o;
+    assign it_wb_stb_o   =  if_wb_stb_o;
+    assign if_wb_ack_i   =  it_wb_ack_i;
+    assign it_wb_cyc_o   =  if_wb_cyc_o;
+    assign if_wb_stall_i =  it_wb_stall_i;
+
+    assign id_wb_adr_o   =  ls_wb_adr_o;
+    assign ls_wb_dat_i   =  id_wb_dat_i;
+    assign id_wb_dat_o   =  ls_wb_dat_o;
+    assign id_wb_we_o    =  ls_wb_we_o;
+    assign id_wb_sel_o   =  ls_wb_sel_o;
+    assign id_wb_stb_o   =  ls_wb_stb_o;
+    assign ls_wb_ack_i   =  id_wb_ack_i;
+    assign id_wb_cyc_o   =  ls_wb_cyc_o;
+    assign ls_wb_stall_i =  id_wb_stall_i;
+  end
+endgenerate
+
+generate
+  if(ICACHE) begin : icache_gen
+    icache #(
+     .SIZE            (ICACHE_SIZE),
+     .LINE_SIZE       (ICACHE_LINE_SIZE),
+     .WAYS            (ICACHE_WAYS)
+    ) icache_inst (
+      .clk_i          (clk_i),
+      .rst_i          (rst_i),
+
+      .invalidate_i   (ex_fence_i),
+
+      .s_wb_adr_i     (it_wb_adr_o),
+      .s_wb_dat_o     (it_wb_dat_i),
+      .s_wb_we_i      (it_wb_we_o),
+      .s_wb_sel_i     (it_wb_sel_o),
+      .s_wb_stb_i     (it_wb_stb_o),
+      .s_wb_ack_o     (it_wb_ack_i),
+      .s_wb_cyc_i     (it_wb_cyc_o),
+      .s_wb_stall_o   (it_wb_stall_i),
+
+      .m_wb_adr_o     (ic_wb_adr_o),
+      .m_wb_dat_i     (ic_wb_dat_i),
+      .m_wb_we_o      (ic_wb_we_o),
+      .m_wb_sel_o     (ic_wb_sel_o),
+      .m_wb_stb_o     (ic_wb_stb_o),
+      .m_wb_ack_i     (ic_wb_ack_i),
+      .m_wb_cyc_o     (ic_wb_cyc_o),
+      .m_wb_stall_i   (ic_wb_stall_i),
+      .m_wb_cti_o     (ic_wb_cti_o),
+      .m_wb_bte_o     (ic_wb_bte_o)
+    );
+  end else begin : icache_bypass
+    assign ic_wb_adr_o   =  it_wb_adr_o;
+    assign it_wb_dat_i   =  ic_wb_dat_i;
+    assign ic_wb_we_o    =  it_wb_we_o;
+    assign ic_wb_sel_o   =  it_wb_sel_o;
+    assign ic_wb_stb_o   =  it_wb_stb_o;
+    assign it_wb_ack_i   =  ic_wb_ack_i;
+    assign ic_wb_cyc_o   =  it_wb_cyc_o;
+    assign it_wb_stall_i =  ic_wb_stall_i;
+    assign ic_wb_cti_o   =  '0;
+    assign ic_wb_bte_o   =  '0;
+  end
+endgenerate
+
+generate
+  if(DTCM) begin : dtcm_gen
+    tcm #(
+     .BASE            (DTCM_BASE),
+     .SIZE            (DTCM_SIZE)
+    ) dtcm_inst (
+      .clk_i          (clk_i),
+      .rst_i          (rst_i),
+
+      .s_wb_adr_i     (id_wb_adr_o),
+      .s_wb_dat_o     (id_wb_dat_i),
+      .s_wb_dat_i     (id_wb_dat_o),
+      .s_wb_we_i      (id_wb_we_o),
+      .s_wb_sel_i     (id_wb_sel_o),
+      .s_wb_stb_i     (id_wb_stb_o),
+      .s_wb_ack_o     (id_wb_ack_i),
+      .s_wb_cyc_i     (id_wb_cyc_o),
+      .s_wb_stall_o   (id_wb_stall_i),
+
+      .m_wb_adr_o     (dt_wb_adr_o),
+      .m_wb_dat_i     (dt_wb_dat_i),
+      .m_wb_dat_o     (dt_wb_dat_o),
+      .m_wb_we_o      (dt_wb_we_o),
+      .m_wb_sel_o     (dt_wb_sel_o),
+      .m_wb_stb_o     (dt_wb_stb_o),
+      .m_wb_ack_i     (dt_wb_ack_i),
+      .m_wb_cyc_o     (dt_wb_cyc_o),
+      .m_wb_stall_i   (dt_wb_stall_i),
+
+      .s2_wb_adr_i    ('0),
+      .s2_wb_dat_o    (),
+      .s2_wb_dat_i    ('0),
+      .s2_wb_we_i     (0),
+      .s2_wb_sel_i    ('0),
+      .s2_wb_stb_i    (0),
+      .s2_wb_ack_o    (),
+      .s2_wb_cyc_i    (0),
+      .s2_wb_stall_o  (),
+
+      .m2_wb_adr_o    (),
+      .m2_wb_dat_i    ('0),
+      .m2_wb_dat_o    (),
+      .m2_wb_we_o     (),
+      .m2_wb_sel_o    (),
+      .m2_wb_stb_o    (),
+      .m2_wb_ack_i    (0),
+      .m2_wb_cyc_o    (),
+      .m2_wb_stall_i  (0)
+    );
+  end else begin : dtcm_bypass
+    assign dt_wb_adr_o   =  id_wb_adr_o;
+    assign id_wb_dat_i   =  dt_wb_dat_i;
+    assign dt_wb_dat_o   =  id_wb_dat_o;
+    assign dt_wb_we_o    =  id_wb_we_o;
+    assign dt_wb_sel_o   =  id_wb_sel_o;
+    assign dt_wb_stb_o   =  id_wb_stb_o;
+    assign id_wb_ack_i   =  dt_wb_ack_i;
+    assign dt_wb_cyc_o   =  id_wb_cyc_o;
+    assign id_wb_stall_i =  dt_wb_stall_i;
+  end
+endgenerate
+
+generate
+  if(DCACHE) begin : dcache_gen
+    dcache #(
+     .SIZE            (DCACHE_SIZE),
+     .LINE_SIZE       (DCACHE_LINE_SIZE),
+     .WAYS            (DCACHE_WAYS),
+     .UNCACHED_BASE   (DCACHE_UNCACHED_BASE),
+     .UNCACHED_LIMIT  (DCACHE_UNCACHED_LIMIT)
+    ) dcache_inst (
+      .clk_i          (clk_i),
+      .rst_i          (rst_i),
+
+      .s_wb_adr_i     (dt_wb_adr_o),
+      .s_wb_dat_o     (dt_wb_dat_i),
+      .s_wb_dat_i     (dt_wb_dat_o),
+      .s_wb_we_i      (dt_wb_we_o),
+      .s_wb_sel_i     (dt_wb_sel_o),
+      .s_wb_stb_i     (dt_wb_stb_o),
+      .s_wb_ack_o     (dt_wb_ack_i),
+      .s_wb_cyc_i     (dt_wb_cyc_o),
+      .s_wb_stall_o   (dt_wb_stall_i),
+
+      .m_wb_adr_o     (dc_wb_adr_o),
+      .m_wb_dat_i     (dc_wb_dat_i),
+      .m_wb_dat_o     (dc_wb_dat_o),
+      .m_wb_we_o      (dc_wb_we_o),
+      .m_wb_sel_o     (dc_wb_sel_o),
+      .m_wb_stb_o     (dc_wb_stb_o),
+      .m_wb_ack_i     (dc_wb_ack_i),
+      .m_wb_cyc_o     (dc_wb_cyc_o),
+      .m_wb_stall_i   (dc_wb_stall_i),
+      .m_wb_cti_o     (dc_wb_cti_o),
+      .m_wb_bte_o     (dc_wb_bte_o)
+    );
+  end else begin : dcache_bypass
+    assign dc_wb_adr_o   =  dt_wb_adr_o;
+    assign dt_wb_dat_i   =  dc_wb_dat_i;
+    assign dc_wb_dat_o   =  dt_wb_dat_o;
+    assign dc_wb_we_o    =  dt_wb_we_o;
+    assign dc_wb_sel_o   =  dt_wb_sel_o;
+    assign dc_wb_stb_o   =  dt_wb_stb_o;
+    assign dt_wb_ack_i   =  dc_wb_ack_i;
+    assign dc_wb_cyc_o   =  dt_wb_cyc_o;
+    assign dt_wb_stall_i =  dc_wb_stall_i;
+    assign dc_wb_cti_o   =  '0;
+    assign dc_wb_bte_o   =  '0;
+  end
+endgenerate
+
+generate
+  if(HARVARD) begin : harvard_gen
+    // The fetch and loadstore modules perform their requests on separate
+    // buses without arbitration
+    assign ibus_adr_o    =  ic_wb_adr_o;
+    assign ic_wb_dat_i   =  ibus_dat_i;
+    assign ibus_sel_o    =  ic_wb_sel_o;
+    assign ibus_we_o     =  ic_wb_we_o;
+    assign ibus_stb_o    =  ic_wb_stb_o;
+    assign ic_wb_ack_i   =  ibus_ack_i;
+    assign ibus_cyc_o    =  ic_wb_cyc_o;
+    assign ic_wb_stall_i =  ibus_stall_i;
+    assign ibus_cti_o    =  ic_wb_cti_o;
+    assign ibus_bte_o    =  ic_wb_bte_o;
+
+    assign dbus_adr_o    =  dc_wb_adr_o;
+    assign dc_wb_dat_i   =  dbus_dat_i;
+    assign dbus_dat_o    =  dc_wb_dat_o;
+    assign dbus_sel_o    =  dc_wb_sel_o;
+    assign dbus_we_o     =  dc_wb_we_o;
+    assign dbus_stb_o    =  dc_wb_stb_o;
+    assign dc_wb_ack_i   =  dbus_ack_i;
+    assign dbus_cyc_o    =  dc_wb_cyc_o;
+    assign dc_wb_stall_i =  dbus_stall_i;
+    assign dbus_cti_o    =  dc_wb_cti_o;
+    assign dbus_bte_o    =  dc_wb_bte_o;
+
+    assign wb_adr_o      =  '0;
+    assign wb_dat_o      =  '0;
+    assign wb_sel_o      =  '0;
+    assign wb_we_o       =   0;
+    assign wb_stb_o      =   0;
+    assign wb_cyc_o      =   0;
+    assign wb_cti_o      =  '0;
+    assign wb_bte_o      =  '0;
+
+    assign axi_awaddr_o  =  '0;
+    assign axi_awlen_o   =  '0;
+    assign axi_awsize_o  =  '0;
+    assign axi_awburst_o =  '0;
+    assign axi_awvalid_o =   0;
+    assign axi_wdata_o   =  '0;
+    assign axi_wstrb_o   =  '0;
+    assign axi_wlast_o   =   0;
+    assign axi_wvalid_o  =   0;
+    assign axi_bready_o  =   0;
+    assign axi_araddr_o  =  '0;
+    assign axi_arlen_o   =  '0;
+    assign axi_arsize_o  =  '0;
+    assign axi_arburst_o =  '0;
+    assign axi_arvalid_o =   0;
+    assign axi_rready_o  =   0;
+  end else begin : memory_gen
+    memory #(
+     .FAST_SWITCH       (MEMORY_FAST_SWITCH),
+     .OUTSTANDING_DEPTH (MEMORY_OUTSTANDING),
+     .ARBITRATION       (MEMORY_ARBITRATION)
+    ) memory_inst (
+      .clk_i (clk_i),
+      .rst_i (rst_i),
+
+      .s1_wb_adr_i   (ic_wb_adr_o),
+      .s1_wb_dat_o   (ic_wb_dat_i),
+      .s1_wb_dat_i   ('0),
+      .s1_wb_we_i    (ic_wb_we_o),
+      .s1_wb_sel_i   (ic_wb_sel_o),
+      .s1_wb_stb_i   (ic_wb_stb_o),
+      .s1_wb_ack_o   (ic_wb_ack_i),
+      .s1_wb_cyc_i   (ic_wb_cyc_o),
+      .s1_wb_stall_o (ic_wb_stall_i),
+      .s1_wb_cti_i   (ic_wb_cti_o),
+      .s1_wb_bte_i   (ic_wb_bte_o),
+
+      .s2_wb_adr_i   (dc_wb_adr_o),
+      .s2_wb_dat_o   (dc_wb_dat_i),
+      .s2_wb_dat_i   (dc_wb_dat_o),
+      .s2_wb_we_i    (dc_wb_we_o),
+      .s2_wb_sel_i   (dc_wb_sel_o),
+      .s2_wb_stb_i   (dc_wb_stb_o),
+      .s2_wb_ack_o   (dc_wb_ack_i),
+      .s2_wb_cyc_i   (dc_wb_cyc_o),
+      .s2_wb_stall_o (dc_wb_stall_i),
+      .s2_wb_cti_i   (dc_wb_cti_o),
+      .s2_wb_bte_i   (dc_wb_bte_o),
+
+      .m_wb_adr_o   (mem_wb_adr_o),
+      .m_wb_dat_i   (mem_wb_dat_i),
+      .m_wb_dat_o   (mem_wb_dat_o),
+      .m_wb_we_o    (mem_wb_we_o),
+      .m_wb_sel_o   (mem_wb_sel_o),
+      .m_wb_stb_o   (mem_wb_stb_o),
+      .m_wb_ack_i   (mem_wb_ack_i),
+      .m_wb_cyc_o   (mem_wb_cyc_o),
+      .m_wb_stall_i (mem_wb_stall_i),
+      .m_wb_cti_o   (mem_wb_cti_o),
+      .m_wb_bte_o   (mem_wb_bte_o)
+    );
+
+    if(AXI) begin : axi_gen
+      // The requests of the memory module are converted into AXI4
+      // transactions
+      axi_bridge #(
+        .OUTSTANDING_DEPTH (AXI_OUTSTANDING)
+      ) axi_bridge_inst (
+        .clk_i (clk_i),
+        .rst_i (rst_i),
+
+        .s_wb_adr_i   (mem_wb_adr_o),
+        .s_wb_dat_o   (mem_wb_dat_i),
+        .s_wb_dat_i   (mem_wb_dat_o),
+        .s_wb_we_i    (mem_wb_we_o),
+        .s_wb_sel_i   (mem_wb_sel_o),
+        .s_wb_stb_i   (mem_wb_stb_o),
+        .s_wb_ack_o   (mem_wb_ack_i),
+        .s_wb_cyc_i   (mem_wb_cyc_o),
+        .s_wb_stall_o (mem_wb_stall_i),
+
+        .m_axi_awaddr_o  (axi_awaddr_o),
+        .m_axi_awlen_o   (axi_awlen_o),
+        .m_axi_awsize_o  (axi_awsize_o),
+        .m_axi_awburst_o (axi_awburst_o),
+        .m_axi_awvalid_o (axi_awvalid_o),
+        .m_axi_awready_i (axi_awready_i),
+        .m_axi_wdata_o   (axi_wdata_o),
+        .m_axi_wstrb_o   (axi_wstrb_o),
+        .m_axi_wlast_o   (axi_wlast_o),
+        .m_axi_wvalid_o  (axi_wvalid_o),
+        .m_axi_wready_i  (axi_wready_i),
+        .m_axi_bresp_i   (axi_bresp_i),
+        .m_axi_bvalid_i  (axi_bvalid_i),
+        .m_axi_bready_o  (axi_bready_o),
+        .m_axi_araddr_o  (axi_araddr_o),
+        .m_axi_arlen_o   (axi_arlen_o),
+        .m_axi_arsize_o  (axi_arsize_o),
+        .m_axi_arburst_o (axi_arburst_o),
+        .m_axi_arvalid_o (axi_arvalid_o),
+        .m_axi_arready_i (axi_arready_i),
+        .m_axi_rdata_i   (axi_rdata_i),
+        .m_axi_rresp_i   (axi_rresp_i),
+        .m_axi_rlast_i   (axi_rlast_i),
+        .m_axi_rvalid_i  (axi_rvalid_i),
+        .m_axi_rready_o  (axi_rready_o)
+      );
+
+      assign wb_adr_o      =  '0;
+      assign wb_dat_o      =  '0;
+      assign wb_sel_o      =  '0;
+      assign wb_we_o       =   0;
+      assign wb_stb_o      =   0;
+      assign wb_cyc_o      =   0;
+      assign wb_cti_o      =  '0;
+      assign wb_bte_o      =  '0;
+    end else begin : wishbone_gen
+      assign wb_adr_o       =  mem_wb_adr_o;
+      assign mem_wb_dat_i   =  wb_dat_i;
+      assign wb_dat_o       =  mem_wb_dat_o;
+      assign wb_sel_o       =  mem_wb_sel_o;
+      assign wb_we_o        =  mem_wb_we_o;
+      assign wb_stb_o       =  mem_wb_stb_o;
+      assign mem_wb_ack_i   =  wb_ack_i;
+      assign wb_cyc_o       =  mem_wb_cyc_o;
+      assign mem_wb_stall_i =  wb_stall_i;
+      assign wb_cti_o       =  mem_wb_cti_o;
+      assign wb_bte_o       =  mem_wb_bte_o;
+
+      assign axi_awaddr_o   =  '0;
+      assign axi_awlen_o    =  '0;
+      assign axi_awsize_o   =  '0;
+      assign axi_awburst_o  =  '0;
+      assign axi_awvalid_o  =   0;
+      assign axi_wdata_o    =  '0;
+      assign axi_wstrb_o    =  '0;
+      assign axi_wlast_o    =   0;
+      assign axi_wvalid_o   =   0;
+      assign axi_bready_o   =   0;
+      assign axi_araddr_o   =  '0;
+      assign axi_arlen_o    =  '0;
+      assign axi_arsize_o   =  '0;
+      assign axi_arburst_o  =  '0;
+      assign axi_arvalid_o  =   0;
+      assign axi_rready_o   =   0;
+    end
+
+    assign ibus_adr_o    =  '0;
+    assign ibus_sel_o    =  '0;
+    assign ibus_we_o     =   0;
+    assign ibus_stb_o    =   0;
+    assign ibus_cyc_o    =   0;
+    assign ibus_cti_o    =  '0;
+    assign ibus_bte_o    =  '0;
+
+    assign dbus_adr_o    =  '0;
+    assign dbus_dat_o    =  '0;
+    assign dbus_sel_o    =  '0;
+    assign dbus_we_o     =   0;
+    assign dbus_stb_o    =   0;
+    assign dbus_cyc_o    =   0;
+    assign dbus_cti_o    =  '0;
+    assign dbus_bte_o    =  '0;
+  end
+endgenerate
+
+hazard #(
+ .FORWARDING              (FORWARDING),
+ .REGISTER_WRITE_THROUGH  (REGISTER_WRITE_THROUGH)
+) hazard_inst (
   .clk_i (clk_i),
   .rst_i (rst_i),
 
-  .branch_i (branch),
+  .branch_i (ex_branch),
   .ex_discard_request_o  (hzd_ex_discard_request),
+  .dec_discard_request_o (hzd_dec_discard_request),
 
   .reg_raddr1_i (reg_raddr1),
   .reg_raddr2_i (reg_raddr2),
@@ -342,9 +1228,22 @@ hazard hazard_inst (
   .ex_reg_addr_i (ex_reg_addr),
   .ls_reg_write_i (ls_reg_write),
   .ls_reg_addr_i (ls_reg_addr),
+  .ls_scoreboard_i (ls_scoreboard),
   .reg_write_i (reg_write),
   .reg_waddr_i (reg_waddr),
-  .dec_stall_request_o (hzd_dec_stall_request)
+  .dec_stall_request_o (hzd_dec_stall_request),
+  .dec_branch_compare_i (dec_branch_compare),
+
+  .reg_rdata1_i (reg_rdata1),
+  .reg_rdata2_i (reg_rdata2),
+  .dec_ls_enable_i (dec_ls_enable),
+  .ex_ls_enable_i (ex_ls_enable),
+  .ex_result_i (ex_result),
+  .ls_valid_i (ls_valid),
+  .ls_reg_data_i (ls_reg_data),
+  .reg_wdata_i (reg_wdata),
+  .dec_rdata1_o (hzd_dec_rdata1),
+  .dec_rdata2_o (hzd_dec_rdata2)
 );
 
 endmodule // ecap5_dproc
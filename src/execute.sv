@@ -20,8 +20,13 @@
  * along with ECAP5-DPROC.  If not, see <http://www.gnu.org/licenses/>.
  */
 
-module execute
-(
+module execute #(
+  parameter logic FORWARDING = 0,
+  parameter logic BITMANIP   = 0,
+  parameter logic MULDIV     = 0,
+  parameter int   MUL_STAGES = 1,
+  parameter int   DIV_RADIX  = 2
+)(
   input   logic        clk_i,
   input   logic        rst_i,
 
@@ -32,22 +37,43 @@ module execute
   input   logic        input_valid_i,
 
   input   logic[31:0]  pc_i,
+  input   logic        compressed_i,
 
   //`````````````````````````````````
   //    ALU inputs 
    
   input   logic[31:0]  alu_operand1_i,
   input   logic[31:0]  alu_operand2_i, 
-  input   logic[2:0]   alu_op_i,
+  input   logic[4:0]   alu_op_i,
   input   logic        alu_sub_i,
   input   logic        alu_shift_left_i,
   input   logic        alu_signed_shift_i,
 
+  //`````````````````````````````````
+  //    Multiply/divide inputs
+  //
+  // The operation is selected by the func3 field of the instruction.
+
+  input   logic        muldiv_enable_i,
+  input   logic[2:0]   muldiv_op_i,
+
+  //`````````````````````````````````
+  //    Forwarding inputs
+  //
+  // Source register of each operand, or x0 when the operand is not read
+  // from the register file.
+
+  input   logic[4:0]   alu_operand1_reg_i,
+  input   logic[4:0]   alu_operand2_reg_i,
+  input   logic[4:0]   ls_write_data_reg_i,
+
   //`````````````````````````````````
   //    Branch inputs 
    
   input   logic[2:0]   branch_cond_i,
   input   logic[19:0]  branch_offset_i,
+  input   logic        pred_taken_i,
+  input   logic[31:0]  pred_target_i,
 
   //`````````````````````````````````
   //    Load-Store pass-through inputs 
@@ -57,6 +83,13 @@ module execute
   input   logic[31:0]  ls_write_data_i,
   input   logic[3:0]   ls_sel_i,
   input   logic        ls_unsigned_load_i,
+  input   logic        ls_atomic_i,
+  input   logic[4:0]   ls_atomic_op_i,
+
+  //`````````````````````````````````
+  //    Instruction cache pass-through inputs
+
+  input   logic        fence_i_i,
 
   //`````````````````````````````````
   //    Write-back pass-through inputs 
@@ -79,6 +112,8 @@ module execute
   output   logic[31:0]  ls_write_data_o,
   output   logic[3:0]   ls_sel_o,
   output   logic        ls_unsigned_load_o,
+  output   logic        ls_atomic_o,
+  output   logic[4:0]   ls_atomic_op_o,
 
   //`````````````````````````````````
   //    Write-back pass-through
@@ -93,6 +128,25 @@ module execute
   output  logic        branch_o,
   output  logic[31:0]  branch_target_o,
 
+  //`````````````````````````````````
+  //    Instruction cache interface
+  //
+  // Invalidation of the instruction cache on FENCE.I, output along with the
+  // jump refetching the following instructions.
+
+  output  logic        fence_i_o,
+
+  //`````````````````````````````````
+  //    Branch predictor interface 
+  //
+  // Outcome of the conditional branches, used to train the branch predictor.
+
+  output  logic        bp_update_o,
+  output  logic[31:0]  bp_pc_o,
+  output  logic        bp_taken_o,
+  output  logic[31:0]  bp_target_o,
+  output  logic        bp_mispredict_o,
+
   //=================================
   //    Hazard interface 
   //
@@ -101,6 +155,15 @@ module execute
 );
 import ecap5_dproc_pkg::*;
 
+/*****************************************/
+/*      Forwarding internal signals      */
+/*****************************************/
+
+logic        forward_result;
+logic[31:0]  alu_operand1,
+             alu_operand2;
+logic[31:0]  ls_write_data;
+
 /*****************************************/
 /*         ALU internal signals          */
 /*****************************************/
@@ -108,6 +171,7 @@ import ecap5_dproc_pkg::*;
 logic signed[31:0] alu_signed_operand1,
                    alu_signed_operand2;
 
+logic[31:0] alu_sum_operand1;
 logic[31:0] alu_sum_operand2;
 
 logic[31:0] alu_shift0,
@@ -127,7 +191,29 @@ logic[31:0] alu_sum_output,
             alu_shift_output;
 logic[31:0] alu_output;
 logic alu_sum_z;
+
+/*****************************************/
+/*     Bit-manipulation ALU signals      */
+/*****************************************/
+
+logic[5:0]  alu_clz,
+            alu_ctz,
+            alu_cpop;
+logic[63:0] alu_rotate;
+logic[31:0] alu_bit;
+logic[31:0] alu_bitmanip_output;
+
+/*****************************************/
+/*       Multiply/divide signals         */
+/*****************************************/
+
+logic        muldiv_request;
+logic        muldiv_valid;
+logic[31:0]  muldiv_result;
+logic        muldiv_stall;
 logic[31:0] pc_next;
+logic branch_taken;
+logic branch_mispredict;
 logic is_bubble;
 
 /*****************************************/
@@ -142,19 +228,46 @@ logic        ls_write_q;
 logic[31:0]  ls_write_data_q;
 logic[3:0]   ls_sel_q;
 logic        ls_unsigned_load_q;
+logic        ls_atomic_q;
+logic[4:0]   ls_atomic_op_q;
 logic        branch_d, branch_q;
+logic        fence_i_q;
 logic[31:0]  branch_target_d, branch_target_q;
+logic        bp_update_q;
+logic[31:0]  bp_pc_q;
+logic        bp_taken_q;
+logic[31:0]  bp_target_q;
 logic        output_valid_d, output_valid_q;
 
 /*****************************************/
 
-assign pc_next = pc_i + 32'h4;
+// The address of the next instruction depends on the size of the current one
+assign pc_next = pc_i + (compressed_i ? 32'h2 : 32'h4);
 
 assign is_bubble = ~input_valid_i || discard_request_i;
 
+/*
+ * The result of the previous instruction is forwarded to the operands which
+ * read its destination register. The result of a load is not available yet,
+ * such a dependency is handled by the hazard module through a stall.
+ */
+always_comb begin : operand_forwarding
+  forward_result = FORWARDING && result_write_q && ~ls_enable_q && (result_addr_q != 5'h0);
+
+  alu_operand1 = (forward_result && (alu_operand1_reg_i == result_addr_q))
+                      ? result_q
+                      : alu_operand1_i;
+  alu_operand2 = (forward_result && (alu_operand2_reg_i == result_addr_q))
+                      ? result_q
+                      : alu_operand2_i;
+  ls_write_data = (forward_result && (ls_write_data_reg_i == result_addr_q))
+                      ? result_q
+                      : ls_write_data_i;
+end
+
 always_comb begin : alu
-  alu_signed_operand1 = $signed(alu_operand1_i);
-  alu_signed_operand2 = $signed(alu_operand2_i);
+  alu_signed_operand1 = $signed(alu_operand1);
+  alu_signed_operand2 = $signed(alu_operand2);
 
   // The second alu operand is inverted in the following cases :
   //   . The requested alu operation is a substraction (alu_sub_q)
@@ -163,31 +276,38 @@ always_comb begin : alu
   alu_sum_operand2 = alu_sub_i || (branch_cond_i == BRANCH_BEQ || branch_cond_i == BRANCH_BNE)
                           ? (-alu_signed_operand2)
                           :   alu_signed_operand2;
-  alu_sum_output   =  alu_signed_operand1 + alu_sum_operand2;
+  // The first alu operand is shifted by the shift-and-add operations (Zba)
+  case(alu_op_i)
+    ALU_SH1ADD: alu_sum_operand1 = alu_operand1 << 1;
+    ALU_SH2ADD: alu_sum_operand1 = alu_operand1 << 2;
+    ALU_SH3ADD: alu_sum_operand1 = alu_operand1 << 3;
+    default:    alu_sum_operand1 = alu_operand1;
+  endcase
+  alu_sum_output   =  alu_sum_operand1 + alu_sum_operand2;
   // A flag indicating if the output of the sum is zero is computed to be used with branch operations
   alu_sum_z = (alu_sum_output == 32'h0);
 
-  alu_xor_output   =  alu_operand1_i  ^  alu_operand2_i;
-  alu_or_output    =  alu_operand1_i  |  alu_operand2_i;
-  alu_and_output   =  alu_operand1_i  &  alu_operand2_i;
+  alu_xor_output   =  alu_operand1  ^  alu_operand2;
+  alu_or_output    =  alu_operand1  |  alu_operand2;
+  alu_and_output   =  alu_operand1  &  alu_operand2;
   alu_slt_output   =  {31'h0, alu_signed_operand1 < alu_signed_operand2};
-  alu_sltu_output  =  {31'h0,      alu_operand1_i <      alu_operand2_i};
+  alu_sltu_output  =  {31'h0,      alu_operand1 <      alu_operand2};
 
   // The bitorder of the first shift operand is inverted in case of a left shift
   alu_shift_operand1 = alu_shift_left_i
-                            ? {<<{alu_operand1_i}}
-                            :     alu_operand1_i;
+                            ? {<<{alu_operand1}}
+                            :     alu_operand1;
   // The bits are filled with ones instead of zero when the requested shift is a right signed shift (SRA) with
   // a negative operand.
-  alu_shift_fill = (~alu_shift_left_i && alu_signed_shift_i && alu_operand1_i[31])
+  alu_shift_fill = (~alu_shift_left_i && alu_signed_shift_i && alu_operand1[31])
                         ? 32'hFFFFFFFF
                         : 32'h00000000;
   // Barrel shifter implementation
-  alu_shift0  =  alu_operand2_i[0]  ?  {    alu_shift_fill[0],  alu_shift_operand1[31:1]}  :  alu_shift_operand1;
-  alu_shift1  =  alu_operand2_i[1]  ?  {  alu_shift_fill[1:0],          alu_shift0[31:2]}  :          alu_shift0;
-  alu_shift2  =  alu_operand2_i[2]  ?  {  alu_shift_fill[3:0],          alu_shift1[31:4]}  :          alu_shift1;
-  alu_shift3  =  alu_operand2_i[3]  ?  {  alu_shift_fill[7:0],          alu_shift2[31:8]}  :          alu_shift2;
-  alu_shift4  =  alu_operand2_i[4]  ?  { alu_shift_fill[15:0],         alu_shift3[31:16]}  :          alu_shift3;
+  alu_shift0  =  alu_operand2[0]  ?  {    alu_shift_fill[0],  alu_shift_operand1[31:1]}  :  alu_shift_operand1;
+  alu_shift1  =  alu_operand2[1]  ?  {  alu_shift_fill[1:0],          alu_shift0[31:2]}  :          alu_shift0;
+  alu_shift2  =  alu_operand2[2]  ?  {  alu_shift_fill[3:0],          alu_shift1[31:4]}  :          alu_shift1;
+  alu_shift3  =  alu_operand2[3]  ?  {  alu_shift_fill[7:0],          alu_shift2[31:8]}  :          alu_shift2;
+  alu_shift4  =  alu_operand2[4]  ?  { alu_shift_fill[15:0],         alu_shift3[31:16]}  :          alu_shift3;
   // The bitorder of the shift output is re-inverted in case of a left shift
   alu_shift_output = alu_shift_left_i
                           ? {<<{alu_shift4}}
@@ -201,32 +321,136 @@ always_comb begin : alu
     ALU_SLT:    alu_output  =  alu_slt_output;
     ALU_SLTU:   alu_output  =  alu_sltu_output;
     ALU_SHIFT:  alu_output  =  alu_shift_output;
-    default:    alu_output  =  '0;
+    default:    alu_output  =  BITMANIP ? alu_bitmanip_output : '0;
+  endcase
+end
+
+/*
+ * Operations of the bit-manipulation extensions (Zba, Zbb, Zbs). The
+ * shift-and-add operations reuse the adder and the comparisons reuse the
+ * outputs of SLT and SLTU. The rotations are computed on the operand
+ * concatenated with itself.
+ */
+always_comb begin : bitmanip_alu
+  alu_clz  = leading_zeros(alu_operand1);
+  alu_ctz  = 6'd32;
+  alu_cpop = '0;
+  for(int i = 0; i < 32; i++) begin
+    if(alu_operand1[31 - i]) begin
+      alu_ctz = 6'(31 - i);
+    end
+    alu_cpop = alu_cpop + {5'h0, alu_operand1[i]};
+  end
+
+  // A left rotation by n is performed as a right rotation by 32-n
+  alu_rotate = {alu_operand1, alu_operand1} >> ((alu_op_i == ALU_ROL)
+                                                    ? (6'd32 - {1'b0, alu_operand2[4:0]})
+                                                    : {1'b0, alu_operand2[4:0]});
+
+  // Single bit selected by the Zbs operations
+  alu_bit = 32'h1 << alu_operand2[4:0];
+
+  case(alu_op_i)
+    ALU_SH1ADD,
+    ALU_SH2ADD,
+    ALU_SH3ADD: alu_bitmanip_output  =  alu_sum_output;
+    ALU_ANDN:   alu_bitmanip_output  =  alu_operand1  & ~alu_operand2;
+    ALU_ORN:    alu_bitmanip_output  =  alu_operand1  | ~alu_operand2;
+    ALU_XNOR:   alu_bitmanip_output  =  ~alu_xor_output;
+    ALU_CLZ:    alu_bitmanip_output  =  {26'h0, alu_clz};
+    ALU_CTZ:    alu_bitmanip_output  =  {26'h0, alu_ctz};
+    ALU_CPOP:   alu_bitmanip_output  =  {26'h0, alu_cpop};
+    ALU_MIN:    alu_bitmanip_output  =  alu_slt_output[0]  ? alu_operand1 : alu_operand2;
+    ALU_MAX:    alu_bitmanip_output  =  alu_slt_output[0]  ? alu_operand2 : alu_operand1;
+    ALU_MINU:   alu_bitmanip_output  =  alu_sltu_output[0] ? alu_operand1 : alu_operand2;
+    ALU_MAXU:   alu_bitmanip_output  =  alu_sltu_output[0] ? alu_operand2 : alu_operand1;
+    ALU_SEXT_B: alu_bitmanip_output  =  {{24{alu_operand1[7]}}, alu_operand1[7:0]};
+    ALU_SEXT_H: alu_bitmanip_output  =  {{16{alu_operand1[15]}}, alu_operand1[15:0]};
+    ALU_ZEXT_H: alu_bitmanip_output  =  {16'h0, alu_operand1[15:0]};
+    ALU_ROL,
+    ALU_ROR:    alu_bitmanip_output  =  alu_rotate[31:0];
+    ALU_ORC_B:  alu_bitmanip_output  =  {{8{|alu_operand1[31:24]}}, {8{|alu_operand1[23:16]}},
+                                         {8{|alu_operand1[15:8]}},  {8{|alu_operand1[7:0]}}};
+    ALU_REV8:   alu_bitmanip_output  =  {alu_operand1[7:0], alu_operand1[15:8],
+                                         alu_operand1[23:16], alu_operand1[31:24]};
+    ALU_BSET:   alu_bitmanip_output  =  alu_operand1  |  alu_bit;
+    ALU_BCLR:   alu_bitmanip_output  =  alu_operand1  & ~alu_bit;
+    ALU_BINV:   alu_bitmanip_output  =  alu_operand1  ^  alu_bit;
+    ALU_BEXT:   alu_bitmanip_output  =  {31'h0, |(alu_operand1 & alu_bit)};
+    default:    alu_bitmanip_output  =  '0;
   endcase
 end
 
+/*
+ * The multiplications and divisions are performed by a multi-cycle unit. The
+ * input handshake is held until its result is available, bubbles being output
+ * in the meantime.
+ */
+generate
+  if(MULDIV) begin : muldiv_gen
+    muldiv #(
+     .MUL_STAGES  (MUL_STAGES),
+     .DIV_RADIX   (DIV_RADIX)
+    ) muldiv_inst (
+      .clk_i       (clk_i),
+      .rst_i       (rst_i),
+
+      .request_i   (muldiv_request),
+      .op_i        (muldiv_op_i),
+      .operand1_i  (alu_operand1),
+      .operand2_i  (alu_operand2),
+
+      .valid_o     (muldiv_valid),
+      .ack_i       (output_ready_i),
+      .result_o    (muldiv_result)
+    );
+  end else begin : muldiv_bypass
+    assign muldiv_valid   =  0;
+    assign muldiv_result  =  '0;
+  end
+endgenerate
+
+assign muldiv_request = MULDIV && muldiv_enable_i && ~is_bubble;
+assign muldiv_stall   = muldiv_request && ~muldiv_valid;
+
 always_comb begin : result_mux
-  result_d = (branch_cond_i == BRANCH_UNCOND)
-                ? pc_next
-                : alu_output;
+  if(branch_cond_i == BRANCH_UNCOND) begin
+    result_d = pc_next;
+  end else if(muldiv_request) begin
+    result_d = muldiv_result;
+  end else begin
+    result_d = alu_output;
+  end
 end
 
 always_comb begin : branch_interface
   case(branch_cond_i)
-    NO_BRANCH:     branch_d  =   0;
-    BRANCH_BEQ:    branch_d  =   alu_sum_z;
-    BRANCH_BNE:    branch_d  =  ~alu_sum_z;
-    BRANCH_BLT:    branch_d  =   alu_slt_output[0];
-    BRANCH_BLTU:   branch_d  =   alu_sltu_output[0];
-    BRANCH_BGE:    branch_d  =  ~alu_slt_output[0];
-    BRANCH_BGEU:   branch_d  =  ~alu_sltu_output[0];
-    BRANCH_UNCOND: branch_d  =   1;
-    default:       branch_d  =   0;
+    NO_BRANCH:     branch_taken  =   0;
+    BRANCH_BEQ:    branch_taken  =   alu_sum_z;
+    BRANCH_BNE:    branch_taken  =  ~alu_sum_z;
+    BRANCH_BLT:    branch_taken  =   alu_slt_output[0];
+    BRANCH_BLTU:   branch_taken  =   alu_sltu_output[0];
+    BRANCH_BGE:    branch_taken  =  ~alu_slt_output[0];
+    BRANCH_BGEU:   branch_taken  =  ~alu_sltu_output[0];
+    BRANCH_UNCOND: branch_taken  =   1;
+    default:       branch_taken  =   0;
   endcase
 
-  branch_target_d = (branch_cond_i == BRANCH_UNCOND)
-                        ? alu_sum_output
-                        : (pc_i + {{12{branch_offset_i[19]}}, branch_offset_i}); 
+  // The fetch module already follows the branches it predicted taken, a
+  // branch is only requested when the prediction is wrong. As the target of
+  // an unconditional jump depends on a register, it is also compared with
+  // the predicted target.
+  branch_mispredict = pred_taken_i && (branch_cond_i != NO_BRANCH) && ~branch_taken;
+  branch_d = (branch_taken ^ (pred_taken_i && (branch_cond_i != NO_BRANCH)))
+                || (pred_taken_i && (branch_cond_i == BRANCH_UNCOND) && (alu_sum_output != pred_target_i));
+
+  if(branch_mispredict) begin
+    branch_target_d = pc_next;
+  end else begin
+    branch_target_d = (branch_cond_i == BRANCH_UNCOND)
+                          ? alu_sum_output
+                          : (pc_i + {{12{branch_offset_i[19]}}, branch_offset_i}); 
+  end
 end
 
 always_comb begin : output_handshake
@@ -244,24 +468,35 @@ always_ff @(posedge clk_i) begin
 
     result_q            <=  '0;
     branch_q            <=   0;
+    fence_i_q           <=   0;
+    bp_update_q         <=   0;
 
     output_valid_q      <=   0;
   end else begin
     if(output_ready_i) begin
-      result_write_q      <=  is_bubble ? 0 : reg_write_i;
+      result_write_q      <=  (is_bubble || muldiv_stall) ? 0 : reg_write_i;
       result_addr_q       <=  reg_addr_i;
       branch_target_q     <=  branch_target_d;
 
       result_q          <=  result_d;
 
-      ls_enable_q         <=  is_bubble ? 0 : ls_enable_i;
-      ls_write_q          <=  is_bubble ? 0 : ls_write_i;
-      ls_write_data_q     <=  ls_write_data_i;
+      ls_enable_q         <=  (is_bubble || muldiv_stall) ? 0 : ls_enable_i;
+      ls_write_q          <=  (is_bubble || muldiv_stall) ? 0 : ls_write_i;
+      ls_write_data_q     <=  ls_write_data;
       ls_sel_q            <=  ls_sel_i;
       ls_unsigned_load_q  <=  ls_unsigned_load_i;
+      ls_atomic_q         <=  ls_atomic_i;
+      ls_atomic_op_q      <=  ls_atomic_op_i;
+
+      branch_q          <= (is_bubble || muldiv_stall) ? 0 : branch_d; 
+      fence_i_q         <= (is_bubble || muldiv_stall) ? 0 : fence_i_i;
 
-      branch_q          <= is_bubble ? 0 : branch_d; 
+      bp_pc_q             <=  pc_i;
+      bp_taken_q          <=  branch_taken;
+      bp_target_q         <=  pc_i + {{12{branch_offset_i[19]}}, branch_offset_i};
     end
+    // The branch predictor is trained once per conditional branch
+    bp_update_q <= output_ready_i && ~is_bubble && ~muldiv_stall && (branch_cond_i != NO_BRANCH) && (branch_cond_i != BRANCH_UNCOND);
 
     output_valid_q    <= output_valid_d;
   end
@@ -271,7 +506,7 @@ end
 /*         Assign output signals         */
 /*****************************************/
 
-assign  input_ready_o       =  output_ready_i;
+assign  input_ready_o       =  output_ready_i && ~muldiv_stall;
 
 assign  result_o            =  result_q;
 
@@ -280,9 +515,18 @@ assign  ls_write_o          =  ls_write_q;
 assign  ls_write_data_o     =  ls_write_data_q;
 assign  ls_sel_o            =  ls_sel_q;
 assign  ls_unsigned_load_o  =  ls_unsigned_load_q;
+assign  ls_atomic_o         =  ls_atomic_q;
+assign  ls_atomic_op_o      =  ls_atomic_op_q;
 
 assign  branch_o            =  branch_q;
 assign  branch_target_o     =  branch_target_q;
+assign  fence_i_o           =  fence_i_q;
+
+assign  bp_update_o         =  bp_update_q;
+assign  bp_pc_o             =  bp_pc_q;
+assign  bp_taken_o          =  bp_taken_q;
+assign  bp_target_o         =  bp_target_q;
+assign  bp_mispredict_o     =  branch_q;
 
 assign  reg_write_o         =  result_write_q;
 assign  reg_addr_o          =  result_addr_q;
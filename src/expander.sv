@@ -0,0 +1,176 @@
+/*           __        _
+ *  ________/ /  ___ _(_)__  ___
+ * / __/ __/ _ \/ _ `/ / _ \/ -_)
+ * \__/\__/_//_/\_,_/_/_//_/\__/
+ *
+ * Copyright (C) Clément Chaine
+ * This file is part of ECAP5-DPROC <https://github.com/ecap5/ECAP5-DPROC>
+ *
+ * ECAP5-DPROC is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ECAP5-DPROC is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ECAP5-DPROC.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+module expander (
+  input   logic[15:0]  instr_i,
+  output  logic[31:0]  instr_o
+);
+import riscv_pkg::*;
+
+/*****************************************/
+/*            Internal signals           */
+/*****************************************/
+logic[4:0]  rd,  rs2;
+logic[4:0]  rd_prime, rs1_prime, rs2_prime;
+
+assign rd  = instr_i[11:7];
+assign rs2 = instr_i[6:2];
+
+// Registers x8 to x15 encoded on 3 bits
+assign rd_prime  = {2'b01, instr_i[4:2]};
+assign rs1_prime = {2'b01, instr_i[9:7]};
+assign rs2_prime = {2'b01, instr_i[4:2]};
+
+/*
+ * Each compressed instruction is expanded into its 32-bit equivalent, selected
+ * by its quadrant (bits 1:0) and its func3 field (bits 15:13). The compressed
+ * floating-point loads and stores as well as the reserved encodings are
+ * expanded into an all-zero instruction, which is not a valid instruction.
+ */
+always_comb begin : expansion
+  instr_o = '0;
+
+  case({instr_i[1:0], instr_i[15:13]})
+    //=================================
+    //    Quadrant 0
+    5'b00_000: begin
+      // C.ADDI4SPN
+      if(instr_i[12:5] != '0) begin
+        instr_o = {2'b00, instr_i[10:7], instr_i[12:11], instr_i[5], instr_i[6], 2'b00,
+                   5'd2, 3'b000, rd_prime, OPCODE_OP_IMM};
+      end
+    end
+    5'b00_010: begin
+      // C.LW
+      instr_o = {5'b00000, instr_i[5], instr_i[12:10], instr_i[6], 2'b00,
+                 rs1_prime, 3'b010, rd_prime, OPCODE_LOAD};
+    end
+    5'b00_110: begin
+      // C.SW
+      instr_o = {5'b00000, instr_i[5], instr_i[12], rs2_prime, rs1_prime, 3'b010,
+                 instr_i[11:10], instr_i[6], 2'b00, OPCODE_STORE};
+    end
+
+    //=================================
+    //    Quadrant 1
+    5'b01_000: begin
+      // C.ADDI, C.NOP
+      instr_o = {{7{instr_i[12]}}, instr_i[6:2], rd, 3'b000, rd, OPCODE_OP_IMM};
+    end
+    5'b01_001,
+    5'b01_101: begin
+      // C.JAL, C.J
+      instr_o = {instr_i[12], instr_i[8], instr_i[10:9], instr_i[6], instr_i[7], instr_i[2],
+                 instr_i[11], instr_i[5:3], instr_i[12], {8{instr_i[12]}},
+                 instr_i[15] ? 5'd0 : 5'd1, OPCODE_JAL};
+    end
+    5'b01_010: begin
+      // C.LI
+      instr_o = {{7{instr_i[12]}}, instr_i[6:2], 5'd0, 3'b000, rd, OPCODE_OP_IMM};
+    end
+    5'b01_011: begin
+      if(rd == 5'd2) begin
+        // C.ADDI16SP
+        instr_o = {{3{instr_i[12]}}, instr_i[4:3], instr_i[5], instr_i[2], instr_i[6], 4'b0000,
+                   5'd2, 3'b000, 5'd2, OPCODE_OP_IMM};
+      end else begin
+        // C.LUI
+        instr_o = {{15{instr_i[12]}}, instr_i[6:2], rd, OPCODE_LUI};
+      end
+    end
+    5'b01_100: begin
+      case(instr_i[11:10])
+        // C.SRLI
+        2'b00: instr_o = {7'b0000000, instr_i[6:2], rs1_prime, 3'b101, rs1_prime, OPCODE_OP_IMM};
+        // C.SRAI
+        2'b01: instr_o = {7'b0100000, instr_i[6:2], rs1_prime, 3'b101, rs1_prime, OPCODE_OP_IMM};
+        // C.ANDI
+        2'b10: instr_o = {{7{instr_i[12]}}, instr_i[6:2], rs1_prime, 3'b111, rs1_prime, OPCODE_OP_IMM};
+        default: begin
+          if(!instr_i[12]) begin
+            case(instr_i[6:5])
+              // C.SUB
+              2'b00: instr_o = {7'b0100000, rs2_prime, rs1_prime, 3'b000, rs1_prime, OPCODE_OP};
+              // C.XOR
+              2'b01: instr_o = {7'b0000000, rs2_prime, rs1_prime, 3'b100, rs1_prime, OPCODE_OP};
+              // C.OR
+              2'b10: instr_o = {7'b0000000, rs2_prime, rs1_prime, 3'b110, rs1_prime, OPCODE_OP};
+              // C.AND
+              default: instr_o = {7'b0000000, rs2_prime, rs1_prime, 3'b111, rs1_prime, OPCODE_OP};
+            endcase
+          end
+        end
+      endcase
+    end
+    5'b01_110,
+    5'b01_111: begin
+      // C.BEQZ, C.BNEZ
+      instr_o = {{4{instr_i[12]}}, instr_i[6:5], instr_i[2], 5'd0, rs1_prime, 2'b00, instr_i[13],
+                 instr_i[11:10], instr_i[4:3], instr_i[12], OPCODE_BRANCH};
+    end
+
+    //=================================
+    //    Quadrant 2
+    5'b10_000: begin
+      // C.SLLI
+      instr_o = {7'b0000000, instr_i[6:2], rd, 3'b001, rd, OPCODE_OP_IMM};
+    end
+    5'b10_010: begin
+      // C.LWSP
+      instr_o = {4'b0000, instr_i[3:2], instr_i[12], instr_i[6:4], 2'b00,
+                 5'd2, 3'b010, rd, OPCODE_LOAD};
+    end
+    5'b10_100: begin
+      if(!instr_i[12]) begin
+        if(rs2 == 5'd0) begin
+          // C.JR
+          instr_o = {12'h0, rd, 3'b000, 5'd0, OPCODE_JALR};
+        end else begin
+          // C.MV
+          instr_o = {7'b0000000, rs2, 5'd0, 3'b000, rd, OPCODE_OP};
+        end
+      end else begin
+        if(rs2 == 5'd0) begin
+          if(rd == 5'd0) begin
+            // C.EBREAK
+            instr_o = 32'h00100073;
+          end else begin
+            // C.JALR
+            instr_o = {12'h0, rd, 3'b000, 5'd1, OPCODE_JALR};
+          end
+        end else begin
+          // C.ADD
+          instr_o = {7'b0000000, rs2, rd, 3'b000, rd, OPCODE_OP};
+        end
+      end
+    end
+    5'b10_110: begin
+      // C.SWSP
+      instr_o = {4'b0000, instr_i[8:7], instr_i[12], rs2, 5'd2, 3'b010,
+                 instr_i[11:9], 2'b00, OPCODE_STORE};
+    end
+    default: begin
+    end
+  endcase
+end
+
+endmodule // expander
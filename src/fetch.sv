@@ -21,7 +21,12 @@
  */
 
 module fetch #(
-  parameter logic[31:0] BOOT_ADDRESS      = 32'h00001000
+  parameter logic[31:0] BOOT_ADDRESS      = 32'h00001000,
+  parameter logic       PIPELINED_FETCH   = 0,
+  parameter int         FETCH_DEPTH       = 4,
+  parameter logic       BRANCH_PREDICTION = 0,
+  parameter int         RAS_DEPTH         = 0,
+  parameter logic       COMPRESSED        = 0
 )(
   input   logic        clk_i,
   input   logic        rst_i,
@@ -42,8 +47,16 @@ module fetch #(
   output  logic        output_valid_o,
   // DECM outputs
   output  logic[31:0]  instr_o,
-  output  logic[31:0]  pc_o
+  output  logic[31:0]  pc_o,
+  output  logic        pred_taken_o,
+  output  logic[31:0]  pred_target_o,
+  // Branch predictor interface
+  output  logic[31:0]  bp_lookup_pc_o,
+  input   logic        bp_lookup_hit_i,
+  input   logic        bp_lookup_taken_i,
+  input   logic[31:0]  bp_lookup_target_i
 );
+import riscv_pkg::*;
 
 typedef enum logic [2:0] {
   IDLE,          // 0
@@ -53,14 +66,28 @@ typedef enum logic [2:0] {
   MEMORY_STALL,  // 4
   PIPELINE_STALL // 5
 } state_t; 
-state_t state_d, state_q /* verilator public */;
+// The state machine is only used in sequential mode
+state_t state_q /* verilator public */;
 
 /*****************************************/
 /*            Internal signals           */
 /*****************************************/
-logic        rst_q,           rst_qq;          
-logic        pending_jump_d,  pending_jump_q;  
-logic        fetch_request;                    
+logic        lookup_hit;                       
+
+/*****************************************/
+/*         Return address stack          */
+/*****************************************/
+localparam int RAS_SIZE      = (RAS_DEPTH > 0) ? RAS_DEPTH : 1;
+localparam int RAS_PTR_WIDTH = (RAS_SIZE > 1) ? $clog2(RAS_SIZE) : 1;
+localparam int RAS_CNT_WIDTH = $clog2(RAS_SIZE + 1);
+
+logic[31:0]               ras_q       [RAS_SIZE];
+logic[RAS_PTR_WIDTH-1:0]  ras_top_q;              // Most recently pushed entry
+logic[RAS_CNT_WIDTH-1:0]  ras_count_q;            // Number of valid entries
+logic                     ras_valid;
+logic                     ras_push;
+logic                     ras_pop;
+logic[31:0]               ras_push_value;
 
 /*****************************************/
 /*        Wishbone output signals        */
@@ -70,74 +97,306 @@ logic        wb_stb_d,        wb_stb_q;
 logic        wb_cyc_d,        wb_cyc_q;        
 
 /*****************************************/
-/*             Stage outputs             */
+/*        Pipelined mode signals         */
 /*****************************************/
-logic[31:0]  pc_d,            pc_q,            pc_qq;
-logic[31:0]  instr_d,         instr_q;         
-logic        output_valid_d,  output_valid_q;  
-
-// A memory fetch is triggered in the following cases :
-//   . After a falling edge of rst
-//   . After a successfull output handshake
-//   . After a jump was requested
-assign fetch_request = (rst_qq && !rst_i) || (output_valid_q && output_ready_i) || (pending_jump_q);
-
-always_comb begin : state_machine
-  state_d = state_q;
-
-  case(state_q)
-    IDLE: begin
-      if(fetch_request) begin
-        // A memory request shall be triggered
-        if(wb_stall_i) begin
-          // The memory is stalled
-          state_d = MEMORY_STALL;
-        end else begin
-          // The memory is ready
-          state_d = REQUEST;
-        end
-      end
+localparam int PTR_WIDTH = (FETCH_DEPTH > 1) ? $clog2(FETCH_DEPTH) : 1;
+localparam int CNT_WIDTH = $clog2(FETCH_DEPTH + 1);
+localparam logic[CNT_WIDTH-1:0] DEPTH = CNT_WIDTH'(FETCH_DEPTH);
+
+logic[31:0]           req_pc_d,   req_pc_q;
+logic[PTR_WIDTH-1:0]  head_d,     head_q;     // Oldest buffer entry
+logic[PTR_WIDTH-1:0]  fill_d,     fill_q;     // Next entry to receive a response
+logic[PTR_WIDTH-1:0]  tail_d,     tail_q;     // Next entry to allocate
+logic[CNT_WIDTH-1:0]  count_d,    count_q;    // Number of allocated entries
+logic[CNT_WIDTH-1:0]  filled_d,   filled_q;   // Number of entries holding an instruction
+logic[CNT_WIDTH-1:0]  pending_d,  pending_q;  // Number of entries waiting for a response
+logic[CNT_WIDTH-1:0]  drop_d,     drop_q;     // Number of responses to be dropped
+logic[31:0]           buffer_instr_q  [FETCH_DEPTH];
+logic[31:0]           buffer_pc_q     [FETCH_DEPTH];
+logic                 buffer_pred_q   [FETCH_DEPTH];
+logic                 buffer_hit_q    [FETCH_DEPTH];
+logic[31:0]           buffer_target_q [FETCH_DEPTH];
+logic                 response_pred_taken;
+logic[31:0]           response_pred_target;
+logic[31:0]           issue_pc;
+logic                 request_accepted;
+logic                 request_issued;
+logic[31:0]           request_pc;
+logic[PTR_WIDTH-1:0]  issue_index;
+logic                 response_kept;
+logic                 output_pop;
+
+function automatic logic[PTR_WIDTH-1:0] next_index(input logic[PTR_WIDTH-1:0] index);
+  next_index = (index == PTR_WIDTH'(FETCH_DEPTH - 1)) ? '0 : index + 1'b1;
+endfunction
+
+/*
+ * Static backward-taken/forward-not-taken prediction. Jumps (JAL) and
+ * backward conditional branches are predicted taken. JALR is only predicted
+ * when it is a return, using the return address stack.
+ */
+function automatic logic predecode_taken(input logic[31:0] instr);
+  predecode_taken = BRANCH_PREDICTION && !COMPRESSED && ((instr[6:0] == OPCODE_JAL) ||
+                                                         ((instr[6:0] == OPCODE_BRANCH) && instr[31]));
+endfunction
+
+function automatic logic[31:0] predecode_target(input logic[31:0] instr, input logic[31:0] pc);
+  if(instr[6:0] == OPCODE_JAL) begin
+    predecode_target = pc + { {12{instr[31]}}, instr[19:12], instr[20], instr[30:21], 1'b0 };
+  end else begin
+    predecode_target = pc + { {20{instr[31]}}, instr[7], instr[30:25], instr[11:8], 1'b0 };
+  end
+endfunction
+
+function automatic logic is_link(input logic[4:0] register);
+  is_link = (register == 5'd1) || (register == 5'd5);
+endfunction
+
+/*
+ * Calls are jumps (JAL or JALR) writing the return address in a link
+ * register (x1 or x5). Returns are indirect jumps (JALR) reading a link
+ * register and discarding their own return address.
+ */
+function automatic logic predecode_call(input logic[31:0] instr);
+  predecode_call = (RAS_DEPTH > 0) && !COMPRESSED && ((instr[6:0] == OPCODE_JAL) || (instr[6:0] == OPCODE_JALR))
+                                                  && is_link(instr[11:7]);
+endfunction
+
+function automatic logic predecode_return(input logic[31:0] instr);
+  predecode_return = (RAS_DEPTH > 0) && !COMPRESSED && (instr[6:0] == OPCODE_JALR)
+                                                    && (instr[11:7] == 5'd0) && is_link(instr[19:15]);
+endfunction
+
+// The return target is computed as the JALR target would be in the execute
+// stage so that both can be compared.
+function automatic logic[31:0] return_target(input logic[31:0] instr);
+  return_target = ras_q[ras_top_q] + { {20{instr[31]}}, instr[31:20] };
+endfunction
+
+assign ras_valid = (RAS_DEPTH > 0) && (ras_count_q != 0);
+
+/*
+ * When COMPRESSED is set, instructions are fetched as aligned words split by
+ * the aligner module, the address of a jump target only being a multiple of 2.
+ * The word containing the target is requested, bit 1 of its address being kept
+ * in the output address so that its lower half is skipped. A word does not
+ * necessarily start with an instruction, which prevents the predecoding of the
+ * fetched words and the lookup of their address in the branch predictor.
+ */
+function automatic logic[31:0] word_address(input logic[31:0] pc);
+  word_address = COMPRESSED ? {pc[31:2], 2'b00} : pc;
+endfunction
+
+function automatic logic[31:0] next_address(input logic[31:0] pc);
+  next_address = word_address(pc) + 4;
+endfunction
+
+assign lookup_hit = bp_lookup_hit_i && !COMPRESSED;
+
+generate
+  if(PIPELINED_FETCH) begin : pipelined_fetch
+
+  //=================================
+  //    Pipelined mode
+  //
+  // Sequential requests are issued back-to-back using the wishbone pipelined
+  // mode. Each request allocates an entry in the instruction buffer which is
+  // filled when the associated acknowledge is received. Instructions are
+  // output from the buffer in order.
+
+  /*
+   * The address of the next request is looked up in the branch predictor
+   * when the request is issued. The static prediction is only used on
+   * responses for which the branch predictor had no entry.
+   */
+  always_comb begin : request_address
+    // A response is dropped while it belongs to a request issued before a jump
+    response_kept = wb_ack_i && (drop_q == 0);
+    response_pred_taken = response_kept && !buffer_hit_q[fill_q] &&
+                            (predecode_taken(wb_dat_i) || (predecode_return(wb_dat_i) && ras_valid));
+    response_pred_target = predecode_return(wb_dat_i) ? return_target(wb_dat_i)
+                                                      : predecode_target(wb_dat_i, buffer_pc_q[fill_q]);
+
+    issue_pc = req_pc_q;
+    if(response_pred_taken) begin
+      issue_pc = response_pred_target;
     end
-    MEMORY_STALL: begin
-      if(!wb_stall_i) begin
-        // The memory is unstalled
-        if(wb_ack_i) begin
-          // The response has been received directly
-          state_d = DONE;
-        end else begin
-          // Wait for the response to be received
-          state_d = MEMORY_WAIT;
-        end
-      end
+    if(branch_i) begin
+      issue_pc = branch_target_i;
     end
-    REQUEST: begin
-      if(wb_ack_i) begin
-        // The response has been received directly
-        state_d = DONE;
-      end else begin
-        // Wait for the response to be received
-        state_d = MEMORY_WAIT;
-      end
+  end
+
+  assign bp_lookup_pc_o = issue_pc;
+
+  // The return address stack is updated when the responses are received, in
+  // program order. The responses received along with a jump are discarded.
+  assign ras_push       = response_kept && !branch_i && predecode_call(wb_dat_i);
+  assign ras_pop        = response_kept && !branch_i && predecode_return(wb_dat_i);
+  assign ras_push_value = buffer_pc_q[fill_q] + 4;
+
+  always_comb begin : request_management
+    request_accepted = wb_stb_q && !wb_stall_i;
+    output_pop = (filled_q != 0) && output_ready_i;
+
+    req_pc_d  = req_pc_q;
+    head_d    = head_q;
+    fill_d    = fill_q;
+    tail_d    = tail_q;
+    count_d   = count_q;
+    filled_d  = filled_q;
+    pending_d = pending_q;
+    drop_d    = drop_q;
+
+    wb_adr_d = wb_adr_q;
+    wb_stb_d = wb_stb_q;
+
+    request_issued = 0;
+    issue_index = '0;
+    request_pc = req_pc_q;
+
+    if(response_kept) begin
+      fill_d    = next_index(fill_q);
+      filled_d  = filled_d + 1'b1;
+      pending_d = pending_d - 1'b1;
+    end else if(wb_ack_i) begin
+      drop_d = drop_d - 1'b1;
     end
-    MEMORY_WAIT: begin
-      if(wb_ack_i) begin
-        // The response has been received
-        state_d = DONE;
-      end
+
+    if(output_pop) begin
+      head_d   = next_index(head_q);
+      filled_d = filled_d - 1'b1;
+      count_d  = count_d - 1'b1;
     end
-    DONE: begin
-      if(output_ready_i) begin
-        // Successfull output handshake
-        state_d = IDLE;
-      end else begin
-        // Wait for the output to be ready
-        state_d = PIPELINE_STALL;
+
+    if(response_pred_taken) begin
+      // The requests issued after a branch predicted taken are dropped and
+      // their entries are released
+      drop_d    = drop_d + pending_d;
+      pending_d = '0;
+      count_d   = filled_d;
+      tail_d    = fill_d;
+      req_pc_d  = issue_pc;
+    end
+
+    if(branch_i) begin
+      // The buffer is flushed and every pending request is dropped
+      drop_d    = drop_d + pending_d;
+      pending_d = '0;
+      count_d   = '0;
+      filled_d  = '0;
+      head_d    = '0;
+      fill_d    = '0;
+      tail_d    = '0;
+      req_pc_d  = issue_pc;
+    end
+
+    // The request is released once accepted by the memory
+    if(request_accepted) begin
+      wb_stb_d = 0;
+    end
+
+    // A new request is issued when there is no request being held, when a
+    // buffer entry is available and when the number of responses still to be
+    // received is bounded by the buffer depth.
+    if(!wb_stb_d && (count_d < DEPTH) && ((pending_d + drop_d) < DEPTH)) begin
+      request_issued = 1;
+      issue_index = tail_d;
+
+      request_pc = req_pc_d;
+      wb_adr_d = word_address(req_pc_d);
+      wb_stb_d = 1;
+
+      // A branch predicted taken is followed by the request of its target
+      req_pc_d  = (lookup_hit && bp_lookup_taken_i) ? bp_lookup_target_i : next_address(req_pc_d);
+      tail_d    = next_index(tail_d);
+      count_d   = count_d + 1'b1;
+      pending_d = pending_d + 1'b1;
+    end
+
+    wb_cyc_d = wb_stb_d || (pending_d != 0) || (drop_d != 0);
+  end
+
+  always_ff @(posedge clk_i) begin
+    if(rst_i) begin
+      wb_adr_q   <=  '0;
+      wb_stb_q   <=   0;
+      wb_cyc_q   <=   0;
+      req_pc_q   <=  BOOT_ADDRESS;
+      head_q     <=  '0;
+      fill_q     <=  '0;
+      tail_q     <=  '0;
+      count_q    <=  '0;
+      filled_q   <=  '0;
+      pending_q  <=  '0;
+      drop_q     <=  '0;
+    end else begin
+      wb_adr_q   <=  wb_adr_d;
+      wb_stb_q   <=  wb_stb_d;
+      wb_cyc_q   <=  wb_cyc_d;
+      req_pc_q   <=  req_pc_d;
+      head_q     <=  head_d;
+      fill_q     <=  fill_d;
+      tail_q     <=  tail_d;
+      count_q    <=  count_d;
+      filled_q   <=  filled_d;
+      pending_q  <=  pending_d;
+      drop_q     <=  drop_d;
+
+      if(response_kept) begin
+        buffer_instr_q[fill_q] <= wb_dat_i;
+        if(!buffer_hit_q[fill_q]) begin
+          buffer_pred_q[fill_q]   <= response_pred_taken;
+          buffer_target_q[fill_q] <= response_pred_target;
+        end
+      end
+      // The entry allocated by a request takes precedence over the response
+      // received during a flush of the buffer
+      if(request_issued) begin
+        buffer_pc_q[issue_index]     <= request_pc;
+        buffer_pred_q[issue_index]   <= lookup_hit && bp_lookup_taken_i;
+        buffer_hit_q[issue_index]    <= lookup_hit;
+        buffer_target_q[issue_index] <= bp_lookup_target_i;
       end
     end
-    PIPELINE_STALL: begin
-      // Either the output is ready or a jump was requested which cancels
-      // the output
-      if(output_ready_i || pending_jump_q) begin
+  end
+
+  assign  output_valid_o  =  (filled_q != 0);
+  assign  instr_o         =  buffer_instr_q[head_q];
+  assign  pc_o            =  buffer_pc_q[head_q];
+  assign  pred_taken_o    =  buffer_pred_q[head_q];
+  assign  pred_target_o   =  buffer_target_q[head_q];
+
+  assign  state_q  =  IDLE;
+
+  end else begin : sequential_fetch
+
+  //=================================
+  //    Sequential mode
+  //
+  // A single request is performed at a time and the next request is only
+  // triggered after the output handshake.
+
+  state_t      state_d;
+  logic        rst_q,           rst_qq;
+  logic        pending_jump_d,  pending_jump_q;
+  logic        fetch_request;
+  logic        output_pred_taken;
+  logic[31:0]  output_pred_target;
+  logic[31:0]  pc_d,            pc_q;
+  logic[31:0]  instr_d,         instr_q;
+  logic        output_valid_d,  output_valid_q;
+
+  // A memory fetch is triggered in the following cases :
+  //   . After a falling edge of rst
+  //   . After a successfull output handshake
+  //   . After a jump was requested
+  assign fetch_request = (rst_qq && !rst_i) || (output_valid_q && output_ready_i) || (pending_jump_q);
+
+  always_comb begin : state_machine
+    state_d = state_q;
+
+    case(state_q)
+      IDLE: begin
         if(fetch_request) begin
           // A memory request shall be triggered
           if(wb_stall_i) begin
@@ -149,150 +408,260 @@ always_comb begin : state_machine
           end
         end
       end
-    end
-    default: begin
-    end
-  endcase
-end
-
-always_comb begin : wishbone_read
-  wb_adr_d = wb_adr_q;
-  wb_stb_d = wb_stb_q;
-  wb_cyc_d = wb_cyc_q;
-
-  case(state_q)
-    IDLE: begin
-      if(fetch_request) begin
-        wb_adr_d = pc_d;
-        wb_stb_d = 1;
-        wb_cyc_d = 1;
+      MEMORY_STALL: begin
+        if(!wb_stall_i) begin
+          // The memory is unstalled
+          if(wb_ack_i) begin
+            // The response has been received directly
+            state_d = DONE;
+          end else begin
+            // Wait for the response to be received
+            state_d = MEMORY_WAIT;
+          end
+        end
       end
-    end
-    MEMORY_STALL: begin
-      if(!wb_stall_i) begin
-        wb_stb_d = 0;
+      REQUEST: begin
+        if(wb_ack_i) begin
+          // The response has been received directly
+          state_d = DONE;
+        end else begin
+          // Wait for the response to be received
+          state_d = MEMORY_WAIT;
+        end
       end
-    end
-    REQUEST: begin
-      wb_stb_d = 0;
-    end
-    DONE: begin
-      wb_cyc_d = 0;
-    end
-    PIPELINE_STALL: begin
-      if(output_ready_i || pending_jump_q) begin
+      MEMORY_WAIT: begin
+        if(wb_ack_i) begin
+          // The response has been received
+          state_d = DONE;
+        end
+      end
+      DONE: begin
+        if(output_ready_i) begin
+          // Successfull output handshake
+          state_d = IDLE;
+        end else begin
+          // Wait for the output to be ready
+          state_d = PIPELINE_STALL;
+        end
+      end
+      PIPELINE_STALL: begin
+        // Either the output is ready or a jump was requested which cancels
+        // the output
+        if(output_ready_i || pending_jump_q) begin
+          if(fetch_request) begin
+            // A memory request shall be triggered
+            if(wb_stall_i) begin
+              // The memory is stalled
+              state_d = MEMORY_STALL;
+            end else begin
+              // The memory is ready
+              state_d = REQUEST;
+            end
+          end
+        end
+      end
+      default: begin
+      end
+    endcase
+  end
+
+  always_comb begin : wishbone_read
+    wb_adr_d = wb_adr_q;
+    wb_stb_d = wb_stb_q;
+    wb_cyc_d = wb_cyc_q;
+
+    case(state_q)
+      IDLE: begin
         if(fetch_request) begin
-          wb_adr_d = pc_d;
+          wb_adr_d = word_address(pc_d);
           wb_stb_d = 1;
           wb_cyc_d = 1;
         end
       end
-    end
-    default: begin
-    end
-  endcase
-end
+      MEMORY_STALL: begin
+        if(!wb_stall_i) begin
+          wb_stb_d = 0;
+        end
+      end
+      REQUEST: begin
+        wb_stb_d = 0;
+      end
+      DONE: begin
+        wb_cyc_d = 0;
+      end
+      PIPELINE_STALL: begin
+        if(output_ready_i || pending_jump_q) begin
+          if(fetch_request) begin
+            wb_adr_d = word_address(pc_d);
+            wb_stb_d = 1;
+            wb_cyc_d = 1;
+          end
+        end
+      end
+      default: begin
+      end
+    endcase
+  end
 
-always_comb begin : output_management
-  pending_jump_d = pending_jump_q;
+  always_comb begin : output_management
+    pending_jump_d = pending_jump_q;
 
-  output_valid_d = output_valid_q;
-  instr_d = instr_q;
+    output_valid_d = output_valid_q;
+    instr_d = instr_q;
 
-  case(state_q)
-    IDLE: begin
-      if(fetch_request) begin
-        output_valid_d = 0;
-        pending_jump_d = 0;
+    case(state_q)
+      IDLE: begin
+        if(fetch_request) begin
+          output_valid_d = 0;
+          pending_jump_d = 0;
+        end
       end
-    end
-    MEMORY_STALL: begin
-      if(!wb_stall_i) begin
-        // The memory is unstalled
+      MEMORY_STALL: begin
+        if(!wb_stall_i) begin
+          // The memory is unstalled
+          if(wb_ack_i) begin
+            instr_d = wb_dat_i;
+          end
+        end
+      end
+      REQUEST: begin
         if(wb_ack_i) begin
           instr_d = wb_dat_i;
         end
       end
-    end
-    REQUEST: begin
-      if(wb_ack_i) begin
-        instr_d = wb_dat_i;
-      end
-    end
-    MEMORY_WAIT: begin
-      if(wb_ack_i) begin
-        instr_d = wb_dat_i;
+      MEMORY_WAIT: begin
+        if(wb_ack_i) begin
+          instr_d = wb_dat_i;
+        end
       end
-    end
-    DONE: begin
-      if(pending_jump_q) begin
-        output_valid_d = 0;
-      end else begin
-        output_valid_d = 1;
+      DONE: begin
+        if(pending_jump_q) begin
+          output_valid_d = 0;
+        end else begin
+          output_valid_d = 1;
+        end
       end
-    end
-    PIPELINE_STALL: begin
-      if(output_ready_i || pending_jump_q) begin
-        output_valid_d = 0;
-        if(fetch_request) begin
-          pending_jump_d = 0;
+      PIPELINE_STALL: begin
+        if(output_ready_i || pending_jump_q) begin
+          output_valid_d = 0;
+          if(fetch_request) begin
+            pending_jump_d = 0;
+          end
         end
       end
+      default: begin
+      end
+    endcase
+  end
+
+  // The output instruction is looked up in the branch predictor and
+  // predecoded to fetch the predicted target. The static prediction is only
+  // used when the branch predictor has no entry for the instruction.
+  assign bp_lookup_pc_o     = pc_q;
+  assign output_pred_taken  = lookup_hit ? bp_lookup_taken_i
+                                         : (predecode_taken(instr_q) || (predecode_return(instr_q) && ras_valid));
+  assign output_pred_target = lookup_hit ? bp_lookup_target_i
+                                         : (predecode_return(instr_q) ? return_target(instr_q)
+                                                                      : predecode_target(instr_q, pc_q));
+
+  // The return address stack is updated on the output handshake
+  assign ras_push       = output_valid_q && output_ready_i && !branch_i && predecode_call(instr_q);
+  assign ras_pop        = output_valid_q && output_ready_i && !branch_i && predecode_return(instr_q);
+  assign ras_push_value = pc_q + 4;
+
+  /*
+   * The next value of PC comes from (in order of precedence):
+   *  0. Control flow change request (branch)
+   *  1. Predicted target of the output instruction
+   *  2. Default increment
+   */
+  always_comb begin : pc_update
+    pc_d = pc_q;
+    if (output_valid_q && output_ready_i) begin
+      if (output_pred_taken) begin
+        // 1. Predicted target
+        pc_d = output_pred_target;
+      end else begin
+        // 2. Default increment
+        pc_d = next_address(pc_q);
+      end
     end
-    default: begin
+    // 0. Control flow change request
+    if (branch_i && !pending_jump_q) begin
+      pc_d = branch_target_i;
     end
-  endcase
-end
+  end
 
-/*
- * The next value of PC comes from (in order of precedence):
- *  0. Control flow change request (branch)
- *  1. Default increment
- */
-always_comb begin : pc_update
-  pc_d = pc_q;
-  // 1. Default increment
-  if (output_valid_q && output_ready_i) begin
-    pc_d = pc_q + 4;
+  always_ff @(posedge clk_i) begin
+    if(rst_i) begin
+      state_q         <=  IDLE;
+      wb_adr_q        <=  0;
+      wb_stb_q        <=  0;
+      wb_cyc_q        <=  0;
+      output_valid_q  <=  0;
+      instr_q         <=  0;
+      pc_q            <=  BOOT_ADDRESS;
+      pending_jump_q  <=  0;
+    end else begin
+      state_q         <=  state_d;
+      wb_adr_q        <=  wb_adr_d;
+      wb_stb_q        <=  wb_stb_d;
+      wb_cyc_q        <=  wb_cyc_d;
+      instr_q         <=  instr_d;
+      pc_q            <=  pc_d;
+
+      // Jump triggering
+      if(branch_i) begin
+        pending_jump_q <=  1;
+        output_valid_q  <=  0;
+      end else begin
+        pending_jump_q <=  pending_jump_d;
+        output_valid_q  <=  output_valid_d;
+      end
+    end
+    // Store a delayed rst to detect a falling edge for instruction fetch trigger
+    rst_q   <=  rst_i;
+    rst_qq  <=  rst_q;
   end
-  // 0. Control flow change request
-  if (branch_i && !pending_jump_q) begin
-    pc_d = branch_target_i;
+
+  assign  output_valid_o  =  output_valid_q;
+  assign  instr_o         =  instr_q;
+  assign  pc_o            =  pc_q;
+  assign  pred_taken_o    =  output_pred_taken;
+  assign  pred_target_o   =  output_pred_target;
+
   end
-end
+endgenerate
 
+/*
+ * The return address stack is a circular buffer, the oldest entry being
+ * overwritten on overflow. As the calls and returns fetched on a wrong path
+ * may have pushed or popped entries, the stack is cleared upon branch request.
+ */
 always_ff @(posedge clk_i) begin
   if(rst_i) begin
-    state_q         <=  IDLE;
-    wb_adr_q        <=  0;
-    wb_stb_q        <=  0;
-    wb_cyc_q        <=  0;
-    output_valid_q  <=  0;
-    instr_q         <=  0;
-    pc_q            <=  BOOT_ADDRESS;
-    pending_jump_q  <=  0;
+    ras_top_q    <=  '0;
+    ras_count_q  <=  '0;
   end else begin
-    state_q         <=  state_d;
-    wb_adr_q        <=  wb_adr_d;
-    wb_stb_q        <=  wb_stb_d;
-    wb_cyc_q        <=  wb_cyc_d;
-    instr_q         <=  instr_d;
-    pc_q            <=  pc_d;
-
-    // Jump triggering
     if(branch_i) begin
-      pending_jump_q <=  1;
-      output_valid_q  <=  0;
-    end else begin
-      pending_jump_q <=  pending_jump_d;
-      output_valid_q  <=  output_valid_d;
+      ras_count_q <= '0;
+    end else if(ras_push && ras_pop) begin
+      // The return address is replaced
+      ras_q[ras_top_q] <= ras_push_value;
+      if(ras_count_q == 0) begin
+        ras_count_q <= 1;
+      end
+    end else if(ras_push) begin
+      ras_top_q <= (ras_top_q == RAS_PTR_WIDTH'(RAS_SIZE - 1)) ? '0 : ras_top_q + 1'b1;
+      ras_q[(ras_top_q == RAS_PTR_WIDTH'(RAS_SIZE - 1)) ? '0 : ras_top_q + 1'b1] <= ras_push_value;
+      if(ras_count_q != RAS_CNT_WIDTH'(RAS_SIZE)) begin
+        ras_count_q <= ras_count_q + 1'b1;
+      end
+    end else if(ras_pop && ras_valid) begin
+      ras_top_q   <= (ras_top_q == '0) ? RAS_PTR_WIDTH'(RAS_SIZE - 1) : ras_top_q - 1'b1;
+      ras_count_q <= ras_count_q - 1'b1;
     end
   end
-  // Store a delayed rst to detect a falling edge for instruction fetch trigger
-  rst_q   <=  rst_i;
-  rst_qq  <=  rst_q;
-  // store a delayed pc used to output the address of the current instruction
-  pc_qq   <=  pc_q;
 end
 
 /*****************************************/
@@ -305,8 +674,4 @@ assign  wb_sel_o  =  4'hF;
 assign  wb_stb_o  =  wb_stb_q;
 assign  wb_cyc_o  =  wb_cyc_q;
 
-assign  output_valid_o  =  output_valid_q;
-assign  instr_o         =  instr_q;
-assign  pc_o            =  pc_q;
-
 endmodule // fetch
@@ -22,12 +22,16 @@
  */
 
 module hazard import ecap5_dproc_pkg::*;
-(
+#(
+  parameter logic FORWARDING              = 0,
+  parameter logic REGISTER_WRITE_THROUGH  = 0
+)(
   input   logic         clk_i,
   input   logic         rst_i,
 
   input   logic  branch_i,
   output  logic  ex_discard_request_o,
+  output  logic  dec_discard_request_o,
 
   input   logic[4:0] reg_raddr1_i,
   input   logic[4:0] reg_raddr2_i,
@@ -37,14 +41,31 @@ module hazard import ecap5_dproc_pkg::*;
   input   logic[4:0] ex_reg_addr_i,
   input   logic      ls_reg_write_i,
   input   logic[4:0] ls_reg_addr_i,
+  input   logic[31:0] ls_scoreboard_i,
   input   logic      reg_write_i,
   input   logic[4:0] reg_waddr_i,
-  output  logic      dec_stall_request_o
+  output  logic      dec_stall_request_o,
+  input   logic      dec_branch_compare_i,
+
+  //=================================
+  //    Forwarding interface
+
+  input   logic[31:0] reg_rdata1_i,
+  input   logic[31:0] reg_rdata2_i,
+  input   logic       dec_ls_enable_i,
+  input   logic       ex_ls_enable_i,
+  input   logic[31:0] ex_result_i,
+  input   logic       ls_valid_i,
+  input   logic[31:0] ls_reg_data_i,
+  input   logic[31:0] reg_wdata_i,
+  output  logic[31:0] dec_rdata1_o,
+  output  logic[31:0] dec_rdata2_o
 );
 
 logic branch_q;
 logic control_hazard;
 logic dec_data_hazard, ex_data_hazard, ls_data_hazard, rw_data_hazard;
+logic pending_data_hazard;
 
 assign dec_data_hazard = dec_reg_write_i && ((reg_raddr1_i != 5'h0) && (reg_raddr1_i == dec_reg_addr_i) || 
                                             ((reg_raddr2_i != 5'h0) && (reg_raddr2_i == dec_reg_addr_i)));
@@ -54,6 +75,10 @@ assign ls_data_hazard  = ls_reg_write_i  && ((reg_raddr1_i != 5'h0) && (reg_radd
                                             ((reg_raddr2_i != 5'h0) && (reg_raddr2_i == ls_reg_addr_i)));
 assign rw_data_hazard  = reg_write_i     && ((reg_raddr1_i != 5'h0) && (reg_raddr1_i == reg_waddr_i) || 
                                             ((reg_raddr2_i != 5'h0) && (reg_raddr2_i == reg_waddr_i)));
+// The registers to be written by a non-blocking load are marked in the
+// scoreboard of the loadstore module until its result is output.
+assign pending_data_hazard = ((reg_raddr1_i != 5'h0) && ls_scoreboard_i[reg_raddr1_i]) ||
+                             ((reg_raddr2_i != 5'h0) && ls_scoreboard_i[reg_raddr2_i]);
 
 always_ff @(posedge clk_i) begin
   if(rst_i) begin
@@ -64,7 +89,69 @@ always_ff @(posedge clk_i) begin
 end
 
 assign ex_discard_request_o = branch_i || branch_q;
+// The instruction being decoded while the execute module branches is on the
+// wrong path and shall not trigger a branch itself.
+assign dec_discard_request_o = branch_i;
+
+generate
+  if(FORWARDING) begin : forwarding
+
+  /*
+   * The result of an instruction is forwarded to the register read ports of
+   * the decode module from (in order of precedence) :
+   *  0. The execute module's output, unless the instruction is a load
+   *  1. The loadstore module's output, once the result is valid
+   *  2. The writeback module's output
+   * The result of the instruction currently output by decode is forwarded
+   * by the execute module itself.
+   * A stall is only requested when the result is produced by a load which
+   * has not completed yet, or when a branch compared by decode depends on the
+   * instruction currently output by decode.
+   */
+  logic dec_load_hazard, ex_load_hazard, ls_load_hazard;
 
-assign dec_stall_request_o = dec_data_hazard || ex_data_hazard || ls_data_hazard || rw_data_hazard;
+  assign dec_load_hazard = dec_data_hazard && dec_ls_enable_i;
+  assign ex_load_hazard  = ex_data_hazard  && ex_ls_enable_i;
+  assign ls_load_hazard  = ls_data_hazard  && ~ls_valid_i;
+
+  always_comb begin : forwarding_mux
+    dec_rdata1_o = reg_rdata1_i;
+    if(reg_raddr1_i != 5'h0) begin
+      if(ex_reg_write_i && (reg_raddr1_i == ex_reg_addr_i)) begin
+        dec_rdata1_o = ex_result_i;
+      end else if(ls_reg_write_i && (reg_raddr1_i == ls_reg_addr_i)) begin
+        dec_rdata1_o = ls_reg_data_i;
+      end else if(reg_write_i && (reg_raddr1_i == reg_waddr_i)) begin
+        dec_rdata1_o = reg_wdata_i;
+      end
+    end
+
+    dec_rdata2_o = reg_rdata2_i;
+    if(reg_raddr2_i != 5'h0) begin
+      if(ex_reg_write_i && (reg_raddr2_i == ex_reg_addr_i)) begin
+        dec_rdata2_o = ex_result_i;
+      end else if(ls_reg_write_i && (reg_raddr2_i == ls_reg_addr_i)) begin
+        dec_rdata2_o = ls_reg_data_i;
+      end else if(reg_write_i && (reg_raddr2_i == reg_waddr_i)) begin
+        dec_rdata2_o = reg_wdata_i;
+      end
+    end
+  end
+
+  assign dec_stall_request_o = dec_load_hazard || ex_load_hazard || ls_load_hazard || pending_data_hazard ||
+                               (dec_data_hazard && dec_branch_compare_i);
+
+  end else begin : no_forwarding
+
+  assign dec_rdata1_o = reg_rdata1_i;
+  assign dec_rdata2_o = reg_rdata2_i;
+
+  // The register being written by writeback is read with its new value when
+  // the register file implements the write-through mode.
+  assign dec_stall_request_o = dec_data_hazard || ex_data_hazard || ls_data_hazard || pending_data_hazard ||
+                               (rw_data_hazard && ~REGISTER_WRITE_THROUGH);
+
+  end
+endgenerate
 
 endmodule // hazard
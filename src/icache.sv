@@ -0,0 +1,318 @@
+/*           __        _
+ *  ________/ /  ___ _(_)__  ___
+ * / __/ __/ _ \/ _ `/ / _ \/ -_)
+ * \__/\__/_//_/\_,_/_/_//_/\__/
+ *
+ * Copyright (C) Clément Chaine
+ * This file is part of ECAP5-DPROC <https://github.com/ecap5/ECAP5-DPROC>
+ *
+ * ECAP5-DPROC is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ECAP5-DPROC is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ECAP5-DPROC.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+module icache import ecap5_dproc_pkg::*; #(
+  parameter int SIZE      = 1024,
+  parameter int LINE_SIZE = 16,
+  parameter int WAYS      = 1
+)(
+  input   logic        clk_i,
+  input   logic        rst_i,
+
+  //=================================
+  //    Invalidation interface
+  //
+  // Raised by the execute module on FENCE.I, all the lines being invalidated.
+
+  input   logic        invalidate_i,
+
+  //=================================
+  //    Slave port
+  //
+  // Read requests of the fetch module, using the wishbone pipelined mode.
+
+  input   logic[31:0]  s_wb_adr_i,
+  output  logic[31:0]  s_wb_dat_o,
+  input   logic        s_wb_we_i,
+  input   logic[3:0]   s_wb_sel_i,
+  input   logic        s_wb_stb_i,
+  output  logic        s_wb_ack_o,
+  input   logic        s_wb_cyc_i,
+  output  logic        s_wb_stall_o,
+
+  //=================================
+  //    Master port
+  //
+  // Line refills, performed as sequential pipelined read requests identified
+  // as incrementing bursts.
+
+  output  logic[31:0]  m_wb_adr_o,
+  input   logic[31:0]  m_wb_dat_i,
+  output  logic        m_wb_we_o,
+  output  logic[3:0]   m_wb_sel_o,
+  output  logic        m_wb_stb_o,
+  input   logic        m_wb_ack_i,
+  output  logic        m_wb_cyc_o,
+  input   logic        m_wb_stall_i,
+  output  logic[2:0]   m_wb_cti_o,
+  output  logic[1:0]   m_wb_bte_o
+);
+
+localparam int LINES        = SIZE / LINE_SIZE;
+localparam int SETS         = LINES / WAYS;
+localparam int LINE_WORDS   = LINE_SIZE / 4;
+localparam int WORD_WIDTH   = (LINE_WORDS > 1) ? $clog2(LINE_WORDS) : 1;
+localparam int SET_WIDTH    = (SETS > 1) ? $clog2(SETS) : 1;
+localparam int WAY_WIDTH    = (WAYS > 1) ? $clog2(WAYS) : 1;
+localparam int LINE_WIDTH   = (LINES > 1) ? $clog2(LINES) : 1;
+localparam int INDEX_WIDTH  = (LINES * LINE_WORDS > 1) ? $clog2(LINES * LINE_WORDS) : 1;
+localparam int OFFSET_WIDTH = $clog2(LINE_SIZE);
+localparam int TAG_LSB      = OFFSET_WIDTH + ((SETS > 1) ? $clog2(SETS) : 0);
+localparam int TAG_WIDTH    = 32 - TAG_LSB;
+localparam int CNT_WIDTH    = $clog2(LINE_WORDS + 1);
+
+typedef enum logic {
+  IDLE,   // 0
+  REFILL  // 1
+} state_t;
+state_t state_d, state_q;
+
+/*****************************************/
+/*                Storage                */
+/*****************************************/
+
+logic                 valid_q   [LINES];
+logic[TAG_WIDTH-1:0]  tag_q     [LINES];
+logic[31:0]           data_q    [LINES * LINE_WORDS];
+// Way to be replaced next in each set. It follows the most recently used way,
+// which implements a least recently used policy with up to two ways.
+logic[WAY_WIDTH-1:0]  victim_q  [SETS];
+
+// The replacement policy only supports direct-mapped and two-way caches
+if((WAYS != 1) && (WAYS != 2)) begin : ways_check
+  $error("icache: WAYS shall be 1 or 2");
+end
+
+/*****************************************/
+/*          Performance counters         */
+/*****************************************/
+
+logic[31:0]  hit_count_q   /* verilator public */;
+logic[31:0]  miss_count_q  /* verilator public */;
+
+/*****************************************/
+/*            Internal signals           */
+/*****************************************/
+
+logic                  request;
+logic                  lookup_hit;
+logic[WAY_WIDTH-1:0]   lookup_way;
+
+logic[31:0]            miss_adr_d,      miss_adr_q;
+logic[WAY_WIDTH-1:0]   miss_way_d,      miss_way_q;
+logic[CNT_WIDTH-1:0]   req_count_d,     req_count_q;   // Number of words requested
+logic[CNT_WIDTH-1:0]   ack_count_d,     ack_count_q;   // Number of words received
+logic[31:0]            miss_data_d,     miss_data_q;   // Word requested by the fetch module
+logic                  invalidated_q;                  // Invalidation during the current refill
+
+logic[31:0]  m_wb_adr_d,  m_wb_adr_q;
+logic        m_wb_stb_d,  m_wb_stb_q;
+logic        m_wb_cyc_d,  m_wb_cyc_q;
+logic[31:0]  s_wb_dat_d,  s_wb_dat_q;
+logic        s_wb_ack_d,  s_wb_ack_q;
+
+function automatic logic[SET_WIDTH-1:0] set_index(input logic[31:0] adr);
+  set_index = (SETS > 1) ? adr[OFFSET_WIDTH +: SET_WIDTH] : '0;
+endfunction
+
+function automatic logic[WORD_WIDTH-1:0] word_index(input logic[31:0] adr);
+  word_index = (LINE_WORDS > 1) ? adr[2 +: WORD_WIDTH] : '0;
+endfunction
+
+function automatic logic[LINE_WIDTH-1:0] line_index(input logic[SET_WIDTH-1:0] set, input logic[WAY_WIDTH-1:0] way);
+  line_index = LINE_WIDTH'(set * WAYS + way);
+endfunction
+
+function automatic logic[INDEX_WIDTH-1:0] data_index(input logic[SET_WIDTH-1:0] set, input logic[WAY_WIDTH-1:0] way,
+                                                     input logic[WORD_WIDTH-1:0] word);
+  data_index = INDEX_WIDTH'((set * WAYS + way) * LINE_WORDS + word);
+endfunction
+
+function automatic logic[WAY_WIDTH-1:0] next_way(input logic[WAY_WIDTH-1:0] way);
+  next_way = (way == WAY_WIDTH'(WAYS - 1)) ? '0 : way + 1'b1;
+endfunction
+
+// A request is only accepted while no refill is being performed
+assign request = s_wb_stb_i && s_wb_cyc_i && (state_q == IDLE);
+
+always_comb begin : lookup
+  lookup_hit = 0;
+  lookup_way = '0;
+  for(int way = 0; way < WAYS; way++) begin
+    if(valid_q[line_index(set_index(s_wb_adr_i), WAY_WIDTH'(way))] &&
+       (tag_q[line_index(set_index(s_wb_adr_i), WAY_WIDTH'(way))] == s_wb_adr_i[31:TAG_LSB])) begin
+      lookup_hit = 1;
+      lookup_way = WAY_WIDTH'(way);
+    end
+  end
+end
+
+/*
+ * A hit is acknowledged on the following cycle, allowing back-to-back
+ * requests. On a miss, the whole line is requested from its first word
+ * before acknowledging the request.
+ */
+always_comb begin : state_machine
+  state_d     = state_q;
+  miss_adr_d  = miss_adr_q;
+  miss_way_d  = miss_way_q;
+  req_count_d = req_count_q;
+  ack_count_d = ack_count_q;
+  miss_data_d = miss_data_q;
+
+  m_wb_adr_d  = m_wb_adr_q;
+  m_wb_stb_d  = m_wb_stb_q;
+  m_wb_cyc_d  = m_wb_cyc_q;
+
+  s_wb_ack_d  = 0;
+  s_wb_dat_d  = s_wb_dat_q;
+
+  case(state_q)
+    IDLE: begin
+      if(request) begin
+        if(lookup_hit) begin
+          s_wb_ack_d = 1;
+          s_wb_dat_d = data_q[data_index(set_index(s_wb_adr_i), lookup_way, word_index(s_wb_adr_i))];
+        end else begin
+          state_d     = REFILL;
+          miss_adr_d  = s_wb_adr_i;
+          miss_way_d  = victim_q[set_index(s_wb_adr_i)];
+          req_count_d = '0;
+          ack_count_d = '0;
+
+          m_wb_adr_d  = { s_wb_adr_i[31:OFFSET_WIDTH], {OFFSET_WIDTH{1'b0}} };
+          m_wb_stb_d  = 1;
+          m_wb_cyc_d  = 1;
+        end
+      end
+    end
+    REFILL: begin
+      // The next word is requested once the current request is accepted
+      if(m_wb_stb_q && !m_wb_stall_i) begin
+        req_count_d = req_count_q + 1'b1;
+        m_wb_adr_d  = m_wb_adr_q + 4;
+        if(req_count_d == CNT_WIDTH'(LINE_WORDS)) begin
+          m_wb_stb_d = 0;
+        end
+      end
+      if(m_wb_ack_i) begin
+        ack_count_d = ack_count_q + 1'b1;
+        if(WORD_WIDTH'(ack_count_q) == word_index(miss_adr_q)) begin
+          miss_data_d = m_wb_dat_i;
+        end
+        if(ack_count_d == CNT_WIDTH'(LINE_WORDS)) begin
+          state_d    = IDLE;
+          m_wb_cyc_d = 0;
+          s_wb_ack_d = 1;
+          s_wb_dat_d = miss_data_d;
+        end
+      end
+    end
+    default: begin end
+  endcase
+end
+
+always_ff @(posedge clk_i) begin
+  if(rst_i) begin
+    state_q       <=  IDLE;
+    miss_adr_q    <=  '0;
+    miss_way_q    <=  '0;
+    req_count_q   <=  '0;
+    ack_count_q   <=  '0;
+    miss_data_q   <=  '0;
+    invalidated_q <=   0;
+    m_wb_adr_q    <=  '0;
+    m_wb_stb_q    <=   0;
+    m_wb_cyc_q    <=   0;
+    s_wb_ack_q    <=   0;
+    s_wb_dat_q    <=  '0;
+    for(int i = 0; i < LINES; i++) begin
+      valid_q[i]  <=  0;
+    end
+    for(int i = 0; i < SETS; i++) begin
+      victim_q[i] <=  '0;
+    end
+    hit_count_q   <=  '0;
+    miss_count_q  <=  '0;
+  end else begin
+    state_q       <=  state_d;
+    miss_adr_q    <=  miss_adr_d;
+    miss_way_q    <=  miss_way_d;
+    req_count_q   <=  req_count_d;
+    ack_count_q   <=  ack_count_d;
+    miss_data_q   <=  miss_data_d;
+    m_wb_adr_q    <=  m_wb_adr_d;
+    m_wb_stb_q    <=  m_wb_stb_d;
+    m_wb_cyc_q    <=  m_wb_cyc_d;
+    s_wb_ack_q    <=  s_wb_ack_d;
+    s_wb_dat_q    <=  s_wb_dat_d;
+
+    if(request) begin
+      if(lookup_hit) begin
+        victim_q[set_index(s_wb_adr_i)] <= next_way(lookup_way);
+        hit_count_q <= hit_count_q + 1;
+      end else begin
+        // The line is invalidated until refilled
+        valid_q[line_index(set_index(s_wb_adr_i), victim_q[set_index(s_wb_adr_i)])] <= 0;
+        miss_count_q <= miss_count_q + 1;
+      end
+    end
+
+    if((state_q == REFILL) && m_wb_ack_i) begin
+      data_q[data_index(set_index(miss_adr_q), miss_way_q, WORD_WIDTH'(ack_count_q))] <= m_wb_dat_i;
+      if(ack_count_d == CNT_WIDTH'(LINE_WORDS)) begin
+        // A line refilled across an invalidation may hold stale words
+        valid_q[line_index(set_index(miss_adr_q), miss_way_q)] <= ~(invalidated_q || invalidate_i);
+        tag_q[line_index(set_index(miss_adr_q), miss_way_q)]   <= miss_adr_q[31:TAG_LSB];
+        victim_q[set_index(miss_adr_q)] <= next_way(miss_way_q);
+      end
+    end
+
+    if(invalidate_i) begin
+      for(int i = 0; i < LINES; i++) begin
+        valid_q[i] <= 0;
+      end
+    end
+    invalidated_q <= (state_d == REFILL) && (invalidated_q || (invalidate_i && (state_q == REFILL)));
+  end
+end
+
+/*****************************************/
+/*         Assign output signals         */
+/*****************************************/
+
+assign  s_wb_dat_o    =  s_wb_dat_q;
+assign  s_wb_ack_o    =  s_wb_ack_q;
+assign  s_wb_stall_o  =  (state_q != IDLE);
+
+assign  m_wb_adr_o    =  m_wb_adr_q;
+assign  m_wb_we_o     =  0;
+assign  m_wb_sel_o    =  4'hF;
+assign  m_wb_stb_o    =  m_wb_stb_q;
+assign  m_wb_cyc_o    =  m_wb_cyc_q;
+// The last request of a refill ends the burst
+assign  m_wb_cti_o    =  (state_q != REFILL)                          ?  CTI_CLASSIC :
+                         (req_count_q == CNT_WIDTH'(LINE_WORDS - 1))  ?  CTI_END
+                                                                      :  CTI_INCREMENTING;
+assign  m_wb_bte_o    =  BTE_LINEAR;
+
+endmodule // icache
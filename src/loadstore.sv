@@ -20,8 +20,12 @@
  * along with ECAP5-DPROC.  If not, see <http://www.gnu.org/licenses/>.
  */
 
-module loadstore
-(
+module loadstore #(
+  parameter int   STORE_BUFFER_DEPTH = 0,
+  parameter logic NON_BLOCKING_LOADS = 0,
+  parameter logic MISALIGNED_ACCESS  = 0,
+  parameter logic ATOMIC             = 0
+)(
   input   logic        clk_i,
   input   logic        rst_i,
 
@@ -40,6 +44,15 @@ module loadstore
   input   logic[31:0]  write_data_i,
   input   logic[3:0]   sel_i,
   input   logic        unsigned_load_i,
+  input   logic        atomic_i,
+  input   logic[4:0]   atomic_op_i,
+
+  //`````````````````````````````````
+  //    Reservation interface
+
+  input   logic        reservation_kill_i,
+  output  logic        reservation_valid_o,
+  output  logic[31:0]  reservation_adr_o,
 
   //`````````````````````````````````
   //    Write-back pass-through
@@ -70,8 +83,14 @@ module loadstore
    
   output  logic        reg_write_o,
   output  logic[4:0]   reg_addr_o,
-  output  logic[31:0]  reg_data_o
+  output  logic[31:0]  reg_data_o,
+
+  //`````````````````````````````````
+  //    Hazard interface
+
+  output  logic[31:0]  scoreboard_o
 );
+import riscv_pkg::*;
 
 /*****************************************/
 /*           Internal signals            */
@@ -81,16 +100,102 @@ typedef enum logic [2:0] {
   REQUEST,        // 1
   MEMORY_WAIT,    // 2
   DONE,           // 3
-  MEMORY_STALL    // 4
+  MEMORY_STALL,   // 4
+  BUFFER_WAIT     // 5
 } state_t;
 state_t state_d, state_q;
 
 logic memory_request;
 logic[31:0] write_data;
+logic[31:0] read_data;
 logic[31:0] signed_read_data;
 logic[3:0] sel_q;
 logic unsigned_load_q;
 
+/*****************************************/
+/*              Store buffer             */
+/*****************************************/
+localparam int SB_SIZE      = (STORE_BUFFER_DEPTH > 0) ? STORE_BUFFER_DEPTH : 1;
+localparam int SB_PTR_WIDTH = (SB_SIZE > 1) ? $clog2(SB_SIZE) : 1;
+localparam int SB_CNT_WIDTH = $clog2(SB_SIZE + 1);
+
+// Stores are kept as they are requested on the wishbone interface
+logic[31:0]               sb_adr_q    [SB_SIZE];
+logic[31:0]               sb_dat_q    [SB_SIZE];
+logic[3:0]                sb_sel_q    [SB_SIZE];
+logic[SB_PTR_WIDTH-1:0]   sb_head_q;              // Oldest entry
+logic[SB_PTR_WIDTH-1:0]   sb_tail_q;              // Next entry to be written
+logic[SB_CNT_WIDTH-1:0]   sb_count_q;             // Number of valid entries
+logic                     sb_empty;
+logic                     sb_full;
+logic                     sb_push;
+logic                     sb_pop;
+logic[31:0]               sb_push_adr;
+logic[31:0]               sb_push_dat;
+logic[3:0]                sb_push_sel;
+
+// Request draining the oldest entry of the store buffer
+logic                     drain_stb_d, drain_stb_q;
+logic                     drain_cyc_d, drain_cyc_q;
+
+// Load served from the store buffer
+logic                     forward_hit;
+logic                     forward_wait;
+logic[31:0]               forward_word;
+logic[31:0]               forward_data;
+
+// Requests completed without waiting for the memory
+logic                     store_retired;
+logic                     load_forwarded;
+
+/*****************************************/
+/*          Non-blocking loads           */
+/*****************************************/
+// The load owns the memory request until its result is output
+logic                     load_issued;
+logic                     load_pending_d, load_pending_q;
+logic                     load_reg_write_d, load_reg_write_q;
+logic[4:0]                load_reg_addr_q;
+logic[31:0]               load_data_d, load_data_q;
+// Registers to be written by a pending load
+logic[31:0]               scoreboard_d, scoreboard_q;
+// Instruction passed through while a load is pending
+logic                     pass_through;
+
+/*****************************************/
+/*          Misaligned accesses          */
+/*****************************************/
+// Byte lanes of the requested bytes over the requested word and the next one
+logic[7:0]                split_lanes;
+// The request crosses a word boundary and is performed as two requests
+logic                     split;
+logic[2:0]                split_size;             // Bytes of the first request
+logic                     split_q;
+logic                     second_q;               // The second request is performed
+logic[2:0]                split_size_q;
+logic[31:0]               split_adr_q;
+logic[31:0]               split_dat_q;
+logic[3:0]                split_sel_q;
+logic[31:0]               split_data_q;           // Response of the first request
+logic                     split_ack;
+
+/*****************************************/
+/*           Atomic operations           */
+/*****************************************/
+logic                     atomic_request;
+logic                     sc_fail;                // SC completed without memory request
+logic                     atomic_q;
+logic[4:0]                atomic_op_q;
+logic[31:0]               atomic_operand_q;
+logic                     atomic_write_q;         // The write request is performed
+logic                     atomic_ack;             // Response of the read request
+logic                     atomic_write;           // The read request is followed by a write request
+logic[31:0]               atomic_result;          // Data of the write request
+// Word reserved by LR
+logic                     reservation_valid_q;
+logic[31:0]               reservation_adr_q;
+logic                     reservation_store;      // A store of the core hits the reservation
+
 /*****************************************/
 /*        Wishbone output signals        */
 /*****************************************/
@@ -112,12 +217,136 @@ logic[31:0] reg_data_d, reg_data_q;
 
 assign memory_request = (enable_i && input_valid_i);
 
+assign sb_empty = (STORE_BUFFER_DEPTH == 0) || (sb_count_q == 0);
+assign sb_full  = (STORE_BUFFER_DEPTH == 0) || (sb_count_q == SB_CNT_WIDTH'(SB_SIZE));
+
+// Byte lanes of the word selected by a right-aligned request
+function automatic logic[3:0] byte_mask(input logic[31:0] adr, input logic[3:0] sel);
+  byte_mask = sel << adr[1:0];
+endfunction
+
+// Bits of the data selected by byte lanes
+function automatic logic[31:0] lane_mask(input logic[3:0] lanes);
+  lane_mask = {{8{lanes[3]}}, {8{lanes[2]}}, {8{lanes[1]}}, {8{lanes[0]}}};
+endfunction
+
+/*
+ * A load is forwarded from the youngest entry of the store buffer writing
+ * the same word when that entry provides every byte of the load. A load
+ * overlapping an entry without being fully provided by it waits for the
+ * store buffer to be drained.
+ */
+always_comb begin : store_forwarding
+  logic[SB_PTR_WIDTH-1:0] index;
+  logic[3:0]              load_mask, entry_mask;
+
+  load_mask    = byte_mask(alu_result_i, sel_i);
+  forward_hit  = 0;
+  forward_wait = 0;
+  forward_word = '0;
+  // The entries are looked up from the oldest to the youngest
+  for(int i = 0; i < SB_SIZE; i++) begin
+    index = ((32'(sb_head_q) + i) >= SB_SIZE) ? SB_PTR_WIDTH'(32'(sb_head_q) + i - SB_SIZE)
+                                               : SB_PTR_WIDTH'(32'(sb_head_q) + i);
+    entry_mask = byte_mask(sb_adr_q[index], sb_sel_q[index]);
+    if((STORE_BUFFER_DEPTH > 0) && (i < 32'(sb_count_q)) &&
+       (sb_adr_q[index][31:2] == alu_result_i[31:2]) && ((entry_mask & load_mask) != 0)) begin
+      forward_hit  = ((load_mask & ~entry_mask) == 0);
+      forward_word = sb_dat_q[index] << {sb_adr_q[index][1:0], 3'b000};
+    end
+  end
+  // A misaligned load crossing a word boundary or an atomic operation is
+  // performed once drained
+  if(split || atomic_request) begin
+    forward_hit = 0;
+  end
+  forward_wait = !sb_empty && !forward_hit;
+
+  forward_data = forward_word >> {alu_result_i[1:0], 3'b000};
+  case(sel_i)
+    4'h1: forward_data = unsigned_load_i ? {24'h0, forward_data[7:0]}  : {{24{forward_data[7]}},  forward_data[7:0]};
+    4'h3: forward_data = unsigned_load_i ? {16'h0, forward_data[15:0]} : {{16{forward_data[15]}}, forward_data[15:0]};
+    default: begin end
+  endcase
+end
+
+/*
+ * The data of a request is right-aligned, the byte-enable selecting its lowest
+ * bytes. A request crossing a word boundary is performed as a request on the
+ * bytes of the first word followed by a request on the bytes of the next word.
+ * Both requests are word-aligned, their byte-enable selecting the byte lanes
+ * of the accessed bytes and their data being placed on these lanes, so that
+ * no request selects three bytes from an unaligned address.
+ */
+assign split_lanes = {4'h0, sel_i} << alu_result_i[1:0];
+assign split       = MISALIGNED_ACCESS && !atomic_request && (split_lanes[7:4] != 4'h0);
+assign split_size  = 3'd4 - {1'b0, alu_result_i[1:0]};
+assign split_ack   = split_q && !second_q && wb_ack_i && !drain_cyc_q &&
+                     ((state_q == REQUEST) || (state_q == MEMORY_WAIT) || ((state_q == MEMORY_STALL) && !wb_stall_i));
+
+assign store_retired  = (STORE_BUFFER_DEPTH > 0) && (state_q == IDLE) && memory_request && write_i && !sb_full && !split;
+assign load_forwarded = (STORE_BUFFER_DEPTH > 0) && (state_q == IDLE) && memory_request && !write_i && forward_hit;
+assign load_issued    = NON_BLOCKING_LOADS && (state_q == IDLE) && memory_request && !write_i && !load_forwarded
+                          && !atomic_request;
+
+/*
+ * When ATOMIC is set, an atomic operation is performed as a read request
+ * followed by a write request within the same bus cycle, the cycle signal
+ * being kept asserted in between so that no other master accesses the memory.
+ * LR registers a reservation on the read word. The reservation is invalidated
+ * by the stores and AMOs of the core on the word, including the stores
+ * retired in the store buffer and the second word of a misaligned store, and
+ * by the reservation kill input which reports the writes of other masters.
+ * SC fails without memory request when the word isn't reserved, and its write
+ * request is only performed when the reservation is still valid once read.
+ */
+assign atomic_request = ATOMIC && memory_request && atomic_i;
+assign sc_fail        = ATOMIC && (state_q == IDLE) && atomic_request && (atomic_op_i == FUNC5_SC) &&
+                        !(reservation_valid_q && (reservation_adr_q[31:2] == alu_result_i[31:2]));
+assign atomic_ack     = atomic_q && !atomic_write_q && wb_ack_i && !drain_cyc_q &&
+                        ((state_q == REQUEST) || (state_q == MEMORY_WAIT) || ((state_q == MEMORY_STALL) && !wb_stall_i));
+assign atomic_write   = (atomic_op_q != FUNC5_LR) && ((atomic_op_q != FUNC5_SC) || (reservation_valid_q && !reservation_kill_i));
+
+assign reservation_store = (state_q == IDLE) && memory_request &&
+                           (atomic_request ? ((atomic_op_i != FUNC5_LR) && (atomic_op_i != FUNC5_SC)) : write_i) &&
+                           ((reservation_adr_q[31:2] == alu_result_i[31:2]) ||
+                            (split && (reservation_adr_q[31:2] == alu_result_i[31:2] + 30'h1)));
+
+always_comb begin : atomic_alu
+  case(atomic_op_q)
+    FUNC5_AMOADD:  atomic_result = wb_dat_i + atomic_operand_q;
+    FUNC5_AMOXOR:  atomic_result = wb_dat_i ^ atomic_operand_q;
+    FUNC5_AMOAND:  atomic_result = wb_dat_i & atomic_operand_q;
+    FUNC5_AMOOR:   atomic_result = wb_dat_i | atomic_operand_q;
+    FUNC5_AMOMIN:  atomic_result = ($signed(wb_dat_i) < $signed(atomic_operand_q)) ? wb_dat_i : atomic_operand_q;
+    FUNC5_AMOMAX:  atomic_result = ($signed(wb_dat_i) > $signed(atomic_operand_q)) ? wb_dat_i : atomic_operand_q;
+    FUNC5_AMOMINU: atomic_result = (wb_dat_i < atomic_operand_q) ? wb_dat_i : atomic_operand_q;
+    FUNC5_AMOMAXU: atomic_result = (wb_dat_i > atomic_operand_q) ? wb_dat_i : atomic_operand_q;
+    // AMOSWAP, SC
+    default:       atomic_result = atomic_operand_q;
+  endcase
+end
+
+/*
+ * While a non-blocking load is pending, the following instructions are
+ * passed through unless they perform a memory request, which is held until
+ * the load completes. The result of the load is output on the cycle
+ * following its response, holding the input during this cycle.
+ */
+assign pass_through   = load_pending_q && (state_q != DONE) && !memory_request;
+
 always_comb begin : state_machine
   state_d = state_q;
 
   case(state_q)
     IDLE: begin
-      if(memory_request) begin
+      if(store_retired || load_forwarded || sc_fail) begin
+        // The request is completed by the store buffer, or without memory request
+        state_d = IDLE;
+      end else if(memory_request && (STORE_BUFFER_DEPTH > 0) && (write_i || forward_wait)) begin
+        // Wait for the store buffer to accept the store or to be drained
+        state_d = BUFFER_WAIT;
+      end else if(memory_request) begin
         // A memory request shall be triggered
         if(wb_stall_i) begin
           // The memory is stalled
@@ -155,9 +384,33 @@ always_comb begin : state_machine
     DONE: begin
       state_d = IDLE;
     end
+    BUFFER_WAIT: begin
+      if(wb_we_q && !split_q) begin
+        if(!sb_full) begin
+          // The store is pushed in the store buffer
+          state_d = DONE;
+        end
+      end else if(sb_empty) begin
+        // The load or the misaligned store is performed after the previous stores
+        if(wb_stall_i) begin
+          state_d = MEMORY_STALL;
+        end else begin
+          state_d = REQUEST;
+        end
+      end
+    end
     default: begin
     end
   endcase
+
+  if(split_ack || (atomic_ack && atomic_write)) begin
+    // The second request of a misaligned access or an atomic operation is performed
+    if(wb_stall_i) begin
+      state_d = MEMORY_STALL;
+    end else begin
+      state_d = REQUEST;
+    end
+  end
 end
 
 always_comb begin : data_size
@@ -169,11 +422,14 @@ always_comb begin : data_size
     default: begin end
   endcase
 
+  // The response of the second request of a misaligned access holds the upper bytes
+  read_data = second_q ? (split_data_q | ((wb_dat_i & lane_mask(wb_sel_q)) << {split_size_q, 3'b000})) : wb_dat_i;
+
   signed_read_data = 0;
   case(sel_q) // sel_i is used here as this is used after the inputs are invalidated
-    4'h1: signed_read_data = {{24{wb_dat_i[7]}}, wb_dat_i[7:0]};
-    4'h3: signed_read_data = {{16{wb_dat_i[15]}}, wb_dat_i[15:0]};
-    4'hF: signed_read_data = wb_dat_i[31:0];
+    4'h1: signed_read_data = {{24{read_data[7]}}, read_data[7:0]};
+    4'h3: signed_read_data = {{16{read_data[15]}}, read_data[15:0]};
+    4'hF: signed_read_data = read_data[31:0];
     default: begin end
   endcase
 end
@@ -188,11 +444,18 @@ always_comb begin : wishbone_read
 
   case(state_q)
     IDLE: begin
-      if(memory_request) begin
-        wb_adr_d = alu_result_i;
-        wb_dat_d = write_data;
+      if(memory_request && !store_retired && !load_forwarded && !sc_fail) begin
+        wb_adr_d = split ? {alu_result_i[31:2], 2'b00}               : alu_result_i;
+        wb_dat_d = split ? write_data << {alu_result_i[1:0], 3'b000} : write_data;
         wb_we_d  = write_i;
-        wb_sel_d = sel_i;
+        wb_sel_d = split ? split_lanes[3:0]                          : sel_i;
+        // The request is only latched while waiting for the store buffer
+        wb_stb_d = (STORE_BUFFER_DEPTH == 0) || (!write_i && !forward_wait);
+        wb_cyc_d = (STORE_BUFFER_DEPTH == 0) || (!write_i && !forward_wait);
+      end
+    end
+    BUFFER_WAIT: begin
+      if((!wb_we_q || split_q) && sb_empty) begin
         wb_stb_d = 1;
         wb_cyc_d = 1;
       end
@@ -211,6 +474,20 @@ always_comb begin : wishbone_read
     default: begin
     end
   endcase
+
+  if(split_ack) begin
+    wb_adr_d = split_adr_q;
+    wb_dat_d = split_dat_q;
+    wb_sel_d = split_sel_q;
+    wb_stb_d = 1;
+  end
+
+  if(atomic_ack && atomic_write) begin
+    // The bus cycle is kept for the write request
+    wb_dat_d = atomic_result;
+    wb_we_d  = 1;
+    wb_stb_d = 1;
+  end
 end
 
 always_comb begin : reg_output
@@ -222,8 +499,59 @@ always_comb begin : reg_output
     reg_addr_d = reg_addr_i;
     reg_data_d = alu_result_i;
     reg_write_d = input_valid_i ? reg_write_i : 0;
-  end else if(wb_ack_i) begin
-    reg_data_d = unsigned_load_q ? wb_dat_i : signed_read_data;
+    if(load_forwarded) begin
+      reg_data_d = forward_data;
+    end
+    if(sc_fail) begin
+      reg_data_d = 32'h1;
+    end
+    if(load_issued) begin
+      // The load is output as a bubble, its result being written later
+      reg_write_d = 0;
+    end
+  end else if(pass_through) begin
+    reg_addr_d = reg_addr_i;
+    reg_data_d = alu_result_i;
+    reg_write_d = input_valid_i ? reg_write_i : 0;
+  end else if(load_pending_q && (state_q == DONE)) begin
+    reg_addr_d = load_reg_addr_q;
+    reg_data_d = load_data_q;
+    reg_write_d = load_reg_write_q;
+  end else if(wb_ack_i && !drain_cyc_q && !load_pending_q && !split_ack && !atomic_write_q) begin
+    reg_data_d = unsigned_load_q ? read_data : signed_read_data;
+    // The result of SC is null upon success
+    if(atomic_q && (atomic_op_q == FUNC5_SC)) begin
+      reg_data_d = {31'h0, !atomic_write};
+    end
+  end
+end
+
+always_comb begin : non_blocking_load
+  load_pending_d = load_pending_q;
+  load_reg_write_d = load_reg_write_q;
+  load_data_d = load_data_q;
+  scoreboard_d = scoreboard_q;
+
+  if(load_issued) begin
+    load_pending_d = 1;
+    load_reg_write_d = reg_write_i;
+    if(reg_write_i) begin
+      scoreboard_d[reg_addr_i] = 1;
+    end
+  end
+  if(load_pending_q) begin
+    if(wb_ack_i && !drain_cyc_q && !split_ack) begin
+      load_data_d = unsigned_load_q ? read_data : signed_read_data;
+    end
+    // A later write to the same register supersedes the result of the load
+    if(pass_through && input_valid_i && reg_write_i && (reg_addr_i == load_reg_addr_q)) begin
+      load_reg_write_d = 0;
+      scoreboard_d[load_reg_addr_q] = 0;
+    end
+    if(state_q == DONE) begin
+      load_pending_d = 0;
+      scoreboard_d[load_reg_addr_q] = 0;
+    end
   end
 end
 
@@ -235,11 +563,39 @@ always_comb begin : input_ready
   if(state_q == DONE) begin
     input_ready_d = 1;
   end
-  if(state_q == IDLE && memory_request) begin
+  if(state_q == IDLE && memory_request && !store_retired && !load_forwarded && !load_issued && !sc_fail) begin
     input_ready_d = 0;
   end
 end
 
+/*
+ * The store buffer is drained in the background using the wishbone interface
+ * while it isn't used by a load.
+ */
+always_comb begin : store_buffer
+  sb_push     = store_retired || ((state_q == BUFFER_WAIT) && wb_we_q && !split_q && !sb_full);
+  sb_push_adr = store_retired ? alu_result_i : wb_adr_q;
+  sb_push_dat = store_retired ? write_data   : wb_dat_q;
+  sb_push_sel = store_retired ? sel_i        : wb_sel_q;
+
+  drain_stb_d = drain_stb_q;
+  drain_cyc_d = drain_cyc_q;
+  sb_pop      = 0;
+  if(drain_cyc_q) begin
+    if(drain_stb_q && !wb_stall_i) begin
+      drain_stb_d = 0;
+    end
+    if(wb_ack_i) begin
+      drain_stb_d = 0;
+      drain_cyc_d = 0;
+      sb_pop      = 1;
+    end
+  end else if(!sb_empty && ((state_q == IDLE) || (state_q == BUFFER_WAIT))) begin
+    drain_stb_d = 1;
+    drain_cyc_d = 1;
+  end
+end
+
 always_ff @(posedge clk_i) begin
   if(rst_i) begin
     state_q         <= IDLE;
@@ -270,7 +626,8 @@ always_ff @(posedge clk_i) begin
     wb_stb_q        <=  wb_stb_d;
     wb_cyc_q        <=  wb_cyc_d;
 
-    output_valid_q  <= (state_q == IDLE && ~enable_i) || (state_q == DONE);
+    output_valid_q  <= (state_q == IDLE && ~enable_i) || (state_q == DONE) || store_retired || load_forwarded
+                          || load_issued || pass_through || sc_fail;
 
     reg_write_q <= reg_write_d;
     reg_addr_q <= reg_addr_d;
@@ -284,17 +641,124 @@ always_ff @(posedge clk_i) begin
   end
 end
 
+always_ff @(posedge clk_i) begin
+  if(rst_i) begin
+    split_q       <=  0;
+    second_q      <=  0;
+    split_size_q  <= '0;
+    split_adr_q   <= '0;
+    split_dat_q   <= '0;
+    split_sel_q   <= '0;
+    split_data_q  <= '0;
+  end else if(MISALIGNED_ACCESS) begin
+    if(state_q == IDLE) begin
+      split_q       <=  split;
+      second_q      <=  0;
+      split_size_q  <=  split_size;
+      split_adr_q   <=  {alu_result_i[31:2] + 30'h1, 2'b00};
+      split_dat_q   <=  write_data >> {split_size, 3'b000};
+      split_sel_q   <=  split_lanes[7:4];
+    end
+    if(split_ack) begin
+      second_q      <=  1;
+      // The bytes of the first request are on the upper lanes
+      split_data_q  <=  wb_dat_i >> {3'd4 - split_size_q, 3'b000};
+    end
+  end
+end
+
+always_ff @(posedge clk_i) begin
+  if(rst_i) begin
+    atomic_q             <=  0;
+    atomic_op_q          <= '0;
+    atomic_operand_q     <= '0;
+    atomic_write_q       <=  0;
+    reservation_valid_q  <=  0;
+    reservation_adr_q    <= '0;
+  end else if(ATOMIC) begin
+    if(state_q == IDLE) begin
+      atomic_q          <=  atomic_request && !sc_fail;
+      atomic_op_q       <=  atomic_op_i;
+      atomic_operand_q  <=  write_data_i;
+      atomic_write_q    <=  0;
+    end
+    if(atomic_ack && atomic_write) begin
+      atomic_write_q    <=  1;
+    end
+    // The reservation is registered by LR and invalidated by SC, by the
+    // stores of the core on the reserved word and by other masters
+    if(sc_fail || (atomic_ack && (atomic_op_q == FUNC5_SC))) begin
+      reservation_valid_q  <=  0;
+    end
+    if(atomic_ack && (atomic_op_q == FUNC5_LR)) begin
+      reservation_valid_q  <=  1;
+      reservation_adr_q    <=  wb_adr_q;
+    end
+    if(reservation_store || reservation_kill_i) begin
+      reservation_valid_q  <=  0;
+    end
+  end
+end
+
+always_ff @(posedge clk_i) begin
+  if(rst_i) begin
+    load_pending_q    <=  0;
+    load_reg_write_q  <=  0;
+    load_reg_addr_q   <= '0;
+    load_data_q       <= '0;
+    scoreboard_q      <= '0;
+  end else if(NON_BLOCKING_LOADS) begin
+    load_pending_q    <=  load_pending_d;
+    load_reg_write_q  <=  load_reg_write_d;
+    load_data_q       <=  load_data_d;
+    scoreboard_q      <=  scoreboard_d;
+    if(load_issued) begin
+      load_reg_addr_q <=  reg_addr_i;
+    end
+  end
+end
+
+always_ff @(posedge clk_i) begin
+  if(rst_i) begin
+    sb_head_q    <=  '0;
+    sb_tail_q    <=  '0;
+    sb_count_q   <=  '0;
+    drain_stb_q  <=   0;
+    drain_cyc_q  <=   0;
+  end else if(STORE_BUFFER_DEPTH > 0) begin
+    drain_stb_q  <=  drain_stb_d;
+    drain_cyc_q  <=  drain_cyc_d;
+
+    if(sb_push) begin
+      sb_adr_q[sb_tail_q] <= sb_push_adr;
+      sb_dat_q[sb_tail_q] <= sb_push_dat;
+      sb_sel_q[sb_tail_q] <= sb_push_sel;
+      sb_tail_q <= (32'(sb_tail_q) == SB_SIZE - 1) ? '0 : sb_tail_q + 1'b1;
+    end
+    if(sb_pop) begin
+      sb_head_q <= (32'(sb_head_q) == SB_SIZE - 1) ? '0 : sb_head_q + 1'b1;
+    end
+    if(sb_push && !sb_pop) begin
+      sb_count_q <= sb_count_q + 1'b1;
+    end else if(!sb_push && sb_pop) begin
+      sb_count_q <= sb_count_q - 1'b1;
+    end
+  end
+end
+
 /*****************************************/
 /*         Assign output signals         */
 /*****************************************/
-assign input_ready_o = input_ready_q;
+// A memory request and the result of a pending load are held
+assign input_ready_o = input_ready_q && !(load_pending_q && (memory_request || (state_q == DONE)));
 
-assign wb_adr_o = wb_adr_q;
-assign wb_dat_o = wb_dat_q;
-assign wb_we_o  = wb_we_q;
-assign wb_sel_o = wb_sel_q;
-assign wb_stb_o = wb_stb_q;
-assign wb_cyc_o = wb_cyc_q;
+// The oldest entry of the store buffer is requested while it is drained
+assign wb_adr_o = drain_cyc_q ? sb_adr_q[sb_head_q] : wb_adr_q;
+assign wb_dat_o = drain_cyc_q ? sb_dat_q[sb_head_q] : wb_dat_q;
+assign wb_we_o  = drain_cyc_q ? 1'b1                : wb_we_q;
+assign wb_sel_o = drain_cyc_q ? sb_sel_q[sb_head_q] : wb_sel_q;
+assign wb_stb_o = drain_cyc_q ? drain_stb_q         : wb_stb_q;
+assign wb_cyc_o = drain_cyc_q ? 1'b1                : wb_cyc_q;
 
 assign reg_write_o = reg_write_q;
 assign reg_addr_o = reg_addr_q;
@@ -302,4 +766,9 @@ assign reg_data_o = reg_data_q;
 
 assign output_valid_o = output_valid_q;
 
+assign scoreboard_o = scoreboard_q;
+
+assign reservation_valid_o = reservation_valid_q;
+assign reservation_adr_o   = {reservation_adr_q[31:2], 2'b00};
+
 endmodule // loadstore
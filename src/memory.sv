@@ -20,8 +20,11 @@
  * along with ECAP5-DPROC.  If not, see <http://www.gnu.org/licenses/>.
  */
 
-module memory
-(
+module memory import ecap5_dproc_pkg::*; #(
+  parameter logic       FAST_SWITCH       = 0,
+  parameter int         OUTSTANDING_DEPTH = 0,
+  parameter logic[1:0]  ARBITRATION       = ARBITRATION_FETCH
+)(
   input   logic        clk_i,
   input   logic        rst_i,
 
@@ -37,6 +40,8 @@ module memory
   output  logic        s1_wb_ack_o,
   input   logic        s1_wb_cyc_i,
   output  logic        s1_wb_stall_o,
+  input   logic[2:0]   s1_wb_cti_i,
+  input   logic[1:0]   s1_wb_bte_i,
   
   //=================================
   //    Slave port 2
@@ -50,6 +55,8 @@ module memory
   output  logic        s2_wb_ack_o,
   input   logic        s2_wb_cyc_i,
   output  logic        s2_wb_stall_o,
+  input   logic[2:0]   s2_wb_cti_i,
+  input   logic[1:0]   s2_wb_bte_i,
 
   //=================================
   //    Master port
@@ -62,21 +69,28 @@ module memory
   output  logic        m_wb_stb_o,
   input   logic        m_wb_ack_i,
   output  logic        m_wb_cyc_o,
-  input   logic        m_wb_stall_i
+  input   logic        m_wb_stall_i,
+  output  logic[2:0]   m_wb_cti_o,
+  output  logic[1:0]   m_wb_bte_o
 );
 
-typedef enum logic [2:0] {
-  IDLE,      // 0
-  SWITCHING, // 1
-  REQUEST   // 2
-} state_t; 
-state_t state_d, state_q;
-
-logic switch_d, switch_q;
 logic s1_request, s2_request;
 
-logic s1_stall_d, s1_stall_q, 
-      s2_stall_d, s2_stall_q;
+// Port connected to the master port, s1 when null and s2 otherwise
+logic grant;
+logic s1_stall, s2_stall;
+// Port to which the response of the master port is routed
+logic response;
+// Stall of both ports while no more request can be tracked
+logic stall_all;
+// Bus cycle of the master port
+logic bus_cyc;
+// Port granted when both ports are requesting, s1 when null and s2 otherwise
+logic prefer;
+// A request is forwarded to the master port
+logic forward;
+logic last_d, last_q;  // Port of the last forwarded request
+logic burst_d, burst_q;  // The last forwarded request doesn't end its burst
 
 logic[31:0] sel_wb_adr;
 logic[31:0] sel_wb_dat_o;
@@ -85,78 +99,295 @@ logic[3:0]  sel_wb_sel;
 logic       sel_wb_stb;
 logic       sel_wb_ack;
 logic       sel_wb_cyc;
+logic[2:0]  sel_wb_cti;
+logic[1:0]  sel_wb_bte;
 
 
 assign s1_request = s1_wb_stb_i && s1_wb_cyc_i;
 assign s2_request = s2_wb_stb_i && s2_wb_cyc_i;
 
-always_comb begin : state_machine
-  state_d = state_q;
+/*
+ * The arbitration policy only applies to simultaneous requests, as a bus
+ * cycle is never interrupted. The loadstore module performing a read stalls
+ * the pipeline until the read is completed.
+ */
+always_comb begin : arbitration_policy
+  case(ARBITRATION)
+    ARBITRATION_FETCH:        prefer = 0;
+    ARBITRATION_DATA:         prefer = 1;
+    ARBITRATION_ROUND_ROBIN:  prefer = ~last_q;
+    ARBITRATION_LOAD:         prefer = ~s2_wb_we_i;
+    default:                  prefer = 0;
+  endcase
+
+  forward = m_wb_stb_o && m_wb_cyc_o && !m_wb_stall_i;
+  last_d  = forward ? grant : last_q;
+  burst_d = forward ? (m_wb_cti_o == CTI_INCREMENTING) : burst_q;
+end
+
+always_ff @(posedge clk_i) begin
+  if(rst_i) begin
+    last_q  <= 1;
+    burst_q <= 0;
+  end else begin
+    last_q  <= last_d;
+    burst_q <= burst_d;
+  end
+end
+
+generate
+  if(OUTSTANDING_DEPTH > 0) begin : pipelined_switch
 
-  switch_d = switch_q;
+  //=================================
+  //    Pipelined mode
+  //
+  // Requests of both ports are forwarded as they arrive, several requests
+  // being in flight using the wishbone pipelined mode. The port of each
+  // forwarded request is stored in a response routing queue, acknowledges
+  // being returned in order to the port at the head of the queue.
 
-  s1_stall_d = s1_stall_q;
-  s2_stall_d = s2_stall_q;
+  localparam int PTR_WIDTH = (OUTSTANDING_DEPTH > 1) ? $clog2(OUTSTANDING_DEPTH) : 1;
+  localparam int CNT_WIDTH = $clog2(OUTSTANDING_DEPTH + 1);
+  localparam logic[CNT_WIDTH-1:0] MAX_COUNT = CNT_WIDTH'(OUTSTANDING_DEPTH);
 
-  case(state_q)
-    IDLE: begin 
-      // if correct interface, go to request
-      if(s1_request) begin
-        state_d = REQUEST;
-      end else if(s2_request) begin
-        // if switch needed, go to switching
-        switch_d = 1;
-        s1_stall_d = 1;
-        s2_stall_d = 0;
-        state_d = SWITCHING;
+  logic[PTR_WIDTH-1:0]  head_d,   head_q;
+  logic[PTR_WIDTH-1:0]  tail_d,   tail_q;
+  logic[CNT_WIDTH-1:0]  count_d,  count_q;
+  logic                 port_q    [OUTSTANDING_DEPTH];
+  logic                 push, pop;
+
+  function automatic logic[PTR_WIDTH-1:0] next_index(input logic[PTR_WIDTH-1:0] index);
+    next_index = (index == PTR_WIDTH'(OUTSTANDING_DEPTH - 1)) ? '0 : index + 1'b1;
+  endfunction
+
+  always_comb begin : arbitration
+    if(burst_q) begin
+      // The requests of a burst are not interleaved with the other port
+      grant = last_q;
+    end else if(s1_request && s2_request) begin
+      grant = prefer;
+    end else if(s2_request) begin
+      grant = 1;
+    end else begin
+      grant = 0;
+    end
+  end
+
+  always_comb begin : response_routing
+    push = forward;
+    pop = m_wb_ack_i && ((count_q != 0) || push);
+
+    // A response provided during the cycle of its request belongs to the
+    // request being forwarded
+    response = (count_q == 0) ? grant : port_q[head_q];
+
+    head_d  = head_q;
+    tail_d  = tail_q;
+    count_d = count_q;
+
+    if(push) begin
+      tail_d = next_index(tail_q);
+    end
+    if(pop) begin
+      head_d = next_index(head_q);
+    end
+    if(push && !pop) begin
+      count_d = count_q + 1'b1;
+    end else if(!push && pop) begin
+      count_d = count_q - 1'b1;
+    end
+  end
+
+  always_ff @(posedge clk_i) begin
+    if(rst_i) begin
+      head_q   <=  '0;
+      tail_q   <=  '0;
+      count_q  <=  '0;
+    end else begin
+      head_q   <=  head_d;
+      tail_q   <=  tail_d;
+      count_q  <=  count_d;
+
+      if(push) begin
+        port_q[tail_q] <= grant;
       end
     end
-    SWITCHING: begin
-      state_d = REQUEST;
+  end
+
+  assign s1_stall  =  grant;
+  assign s2_stall  = ~grant;
+  assign stall_all =  (count_q == MAX_COUNT);
+  // The bus cycle is kept while any of the ports performs a bus cycle
+  assign bus_cyc   =  s1_wb_cyc_i || s2_wb_cyc_i;
+
+  end else if(FAST_SWITCH) begin : fast_switch
+
+  //=================================
+  //    Fast switching mode
+  //
+  // The grant is computed combinationally so that the master port is handed
+  // over to the other port during the same cycle the current bus cycle ends.
+
+  logic busy_d, busy_q;    // A bus cycle is being performed
+  logic owner_d, owner_q;  // Port performing the bus cycle
+
+  always_comb begin : arbitration
+    if(busy_q && (owner_q ? s2_wb_cyc_i : s1_wb_cyc_i)) begin
+      // The bus cycle is kept until its end
+      grant = owner_q;
+    end else if(busy_q && (owner_q ? s1_request : s2_request)) begin
+      // The other port is served first when the bus cycle ends
+      grant = ~owner_q;
+    end else if(s1_request && s2_request) begin
+      grant = prefer;
+    end else if(s1_request) begin
+      grant = 0;
+    end else if(s2_request) begin
+      grant = 1;
+    end else begin
+      grant = 0;
     end
-    REQUEST: begin
-      // Request is done
-      if(sel_wb_cyc == 0) begin
-        // If the other wants access
-        if((~switch_q && s2_request) || (switch_q && s1_request)) begin
-          switch_d = ~switch_q;
-          // Stall the current interface
-          if(~switch_q) begin
-            s1_stall_d = 1;
-            s2_stall_d = 0;
+
+    busy_d  = sel_wb_cyc;
+    owner_d = grant;
+  end
+
+  always_ff @(posedge clk_i) begin
+    if(rst_i) begin
+      busy_q  <= 0;
+      owner_q <= 0;
+    end else begin
+      busy_q  <= busy_d;
+      owner_q <= owner_d;
+    end
+  end
+
+  assign s1_stall  =  grant;
+  assign s2_stall  = ~grant;
+  assign response  =  grant;
+  assign stall_all =  0;
+  assign bus_cyc   =  sel_wb_cyc;
+
+  end else begin : switching
+
+  //=================================
+  //    Switching mode
+  //
+  // The master port is handed over to the other port through the SWITCHING
+  // state once the current bus cycle has ended.
+
+  typedef enum logic [2:0] {
+    IDLE,      // 0
+    SWITCHING, // 1
+    REQUEST   // 2
+  } state_t; 
+  state_t state_d, state_q;
+
+  logic switch_d, switch_q;
+
+  logic s1_stall_d, s1_stall_q, 
+        s2_stall_d, s2_stall_q;
+
+  // Port 1 is held off while idle so that port 2 is granted first
+  logic s1_hold;
+
+  assign s1_hold = (state_q == IDLE) && s1_request && s2_request && prefer;
+
+  always_comb begin : state_machine
+    state_d = state_q;
+
+    switch_d = switch_q;
+
+    s1_stall_d = s1_stall_q;
+    s2_stall_d = s2_stall_q;
+
+    case(state_q)
+      IDLE: begin 
+        // if correct interface, go to request
+        if(s1_request && !s1_hold) begin
+          state_d = REQUEST;
+        end else if(s2_request) begin
+          // if switch needed, go to switching
+          switch_d = 1;
+          s1_stall_d = 1;
+          s2_stall_d = 0;
+          state_d = SWITCHING;
+        end
+      end
+      SWITCHING: begin
+        state_d = REQUEST;
+      end
+      REQUEST: begin
+        // Request is done
+        if(sel_wb_cyc == 0) begin
+          // If the other wants access
+          if((~switch_q && s2_request) || (switch_q && s1_request)) begin
+            switch_d = ~switch_q;
+            // Stall the current interface
+            if(~switch_q) begin
+              s1_stall_d = 1;
+              s2_stall_d = 0;
+            end else begin
+              s1_stall_d = 0;
+              s2_stall_d = 1;
+            end
+            state_d = SWITCHING; 
           end else begin
+            // Switch back to default and idle
+            switch_d = 0;
             s1_stall_d = 0;
             s2_stall_d = 1;
+            state_d = IDLE;
           end
-          state_d = SWITCHING; 
-        end else begin
-          // Switch back to default and idle
-          switch_d = 0;
-          s1_stall_d = 0;
-          s2_stall_d = 1;
-          state_d = IDLE;
         end
       end
+      default: begin end
+    endcase
+  end
+
+  always_ff @(posedge clk_i) begin
+    if(rst_i) begin
+      state_q <= IDLE;
+      switch_q <= 0;
+      s1_stall_q <= 0;
+      s2_stall_q <= 1;
+    end else begin
+      state_q <= state_d;
+      switch_q <= switch_d;
+      s1_stall_q <= s1_stall_d;
+      s2_stall_q <= s2_stall_d;
     end
-    default: begin end
-  endcase
-end
+  end
+
+  assign grant     = switch_q;
+  assign s1_stall  = s1_stall_q || s1_hold;
+  assign s2_stall  = s2_stall_q;
+  assign response  = switch_q;
+  assign stall_all = 0;
+  assign bus_cyc   = sel_wb_cyc;
+
+  end
+endgenerate
 
 always_comb begin
-  if(~switch_q && ~s1_stall_q) begin
+  if(~grant && ~s1_stall) begin
     sel_wb_adr    =  s1_wb_adr_i;
     sel_wb_dat_o  =  s1_wb_dat_i;
     sel_wb_we     =  s1_wb_we_i;
     sel_wb_sel    =  s1_wb_sel_i;
     sel_wb_stb    =  s1_wb_stb_i;
     sel_wb_cyc    =  s1_wb_cyc_i;
-  end else if(switch_q && ~s2_stall_q) begin
+    sel_wb_cti    =  s1_wb_cti_i;
+    sel_wb_bte    =  s1_wb_bte_i;
+  end else if(grant && ~s2_stall) begin
     sel_wb_adr    =  s2_wb_adr_i;
     sel_wb_dat_o  =  s2_wb_dat_i;
     sel_wb_we     =  s2_wb_we_i;
     sel_wb_sel    =  s2_wb_sel_i;
     sel_wb_stb    =  s2_wb_stb_i;
     sel_wb_cyc    =  s2_wb_cyc_i;
+    sel_wb_cti    =  s2_wb_cti_i;
+    sel_wb_bte    =  s2_wb_bte_i;
   end else begin
     sel_wb_adr    =  '0; 
     sel_wb_dat_o  =  '0; 
@@ -164,20 +395,8 @@ always_comb begin
     sel_wb_sel    =  '0; 
     sel_wb_stb    =   0; 
     sel_wb_cyc    =   0; 
-  end
-end
-
-always_ff @(posedge clk_i) begin
-  if(rst_i) begin
-    state_q <= IDLE;
-    switch_q <= 0;
-    s1_stall_q <= 0;
-    s2_stall_q <= 1;
-  end else begin
-    state_q <= state_d;
-    switch_q <= switch_d;
-    s1_stall_q <= s1_stall_d;
-    s2_stall_q <= s2_stall_d;
+    sel_wb_cti    =  '0;
+    sel_wb_bte    =  '0;
   end
 end
 
@@ -185,16 +404,18 @@ assign m_wb_adr_o = sel_wb_adr;
 assign m_wb_dat_o = sel_wb_dat_o;
 assign m_wb_we_o = sel_wb_we;
 assign m_wb_sel_o = sel_wb_sel;
-assign m_wb_stb_o = sel_wb_stb;
-assign m_wb_cyc_o = sel_wb_cyc;
+assign m_wb_stb_o = sel_wb_stb && !stall_all;
+assign m_wb_cyc_o = bus_cyc;
+assign m_wb_cti_o = sel_wb_cti;
+assign m_wb_bte_o = sel_wb_bte;
 
-assign s1_wb_dat_o = ~switch_q ? m_wb_dat_i : '0;
-assign s2_wb_dat_o =  switch_q ? m_wb_dat_i : '0;
+assign s1_wb_dat_o = ~response ? m_wb_dat_i : '0;
+assign s2_wb_dat_o =  response ? m_wb_dat_i : '0;
 
-assign s1_wb_ack_o = ~switch_q ? m_wb_ack_i : 0;
-assign s2_wb_ack_o =  switch_q ? m_wb_ack_i : 0;
+assign s1_wb_ack_o = ~response ? m_wb_ack_i : 0;
+assign s2_wb_ack_o =  response ? m_wb_ack_i : 0;
 
-assign s1_wb_stall_o = s1_stall_q || m_wb_stall_i;
-assign s2_wb_stall_o = s2_stall_q || m_wb_stall_i;
+assign s1_wb_stall_o = s1_stall || stall_all || m_wb_stall_i;
+assign s2_wb_stall_o = s2_stall || stall_all || m_wb_stall_i;
 
 endmodule // memory
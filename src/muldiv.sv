@@ -0,0 +1,248 @@
+/*           __        _
+ *  ________/ /  ___ _(_)__  ___
+ * / __/ __/ _ \/ _ `/ / _ \/ -_)
+ * \__/\__/_//_/\_,_/_/_//_/\__/
+ *
+ * Copyright (C) Clément Chaine
+ * This file is part of ECAP5-DPROC <https://github.com/ecap5/ECAP5-DPROC>
+ *
+ * ECAP5-DPROC is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ECAP5-DPROC is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ECAP5-DPROC.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+module muldiv import ecap5_dproc_pkg::*; #(
+  parameter int MUL_STAGES = 1,
+  parameter int DIV_RADIX  = 2
+)(
+  input   logic        clk_i,
+  input   logic        rst_i,
+  // Request, held until the result is acknowledged
+  input   logic        request_i,
+  input   logic[2:0]   op_i,
+  input   logic[31:0]  operand1_i,
+  input   logic[31:0]  operand2_i,
+  // Result handshake
+  output  logic        valid_o,
+  input   logic        ack_i,
+  output  logic[31:0]  result_o
+);
+
+// Quotient bits computed per cycle by the divider
+localparam int DIV_BITS = $clog2(DIV_RADIX);
+
+/*****************************************/
+/*           Internal signals            */
+/*****************************************/
+typedef enum logic [1:0] {
+  IDLE,           // 0
+  MULTIPLY,       // 1
+  DIVIDE,         // 2
+  DONE            // 3
+} state_t;
+state_t state_d, state_q /* verilator public */;
+
+logic[2:0]   op_q;
+logic[5:0]   count_d, count_q;
+
+/*****************************************/
+/*          Multiplier signals           */
+/*****************************************/
+logic signed[32:0]  mul_operand1,
+                    mul_operand2;
+logic signed[65:0]  mul_product;
+logic[63:0]         mul_q  [MUL_STAGES];
+
+/*****************************************/
+/*            Divider signals            */
+/*****************************************/
+logic        div_signed;
+logic[31:0]  div_dividend,
+             div_divisor;
+logic[31:0]  div_dividend_q;                  // Dividend, as requested
+logic[31:0]  div_divisor_q;                   // Absolute value of the divisor
+logic        div_quotient_neg_d, div_quotient_neg_q;
+logic        div_remainder_neg_d, div_remainder_neg_q;
+logic[31:0]  div_quotient_d, div_quotient_q;
+logic[31:0]  div_remainder_d, div_remainder_q;
+logic[5:0]   div_skip;
+logic[32:0]  div_partial;
+logic[31:0]  div_quotient,
+             div_remainder;
+
+/*
+ * The operands are extended to 33 bits so that a single signed multiplication
+ * provides the upper bits of MULH (signed x signed), MULHSU (signed x
+ * unsigned) and MULHU (unsigned x unsigned). The product is registered through
+ * MUL_STAGES pipeline registers, to be absorbed by the DSP blocks.
+ */
+always_comb begin : multiplier
+  mul_operand1 = {(op_i != 3'b011) && operand1_i[31], operand1_i};
+  mul_operand2 = {(op_i == 3'b001) && operand2_i[31], operand2_i};
+  mul_product  = mul_operand1 * mul_operand2;
+end
+
+/*
+ * The divider computes DIV_BITS quotient bits per cycle on the absolute values
+ * of the operands. The leading zeros of the dividend are skipped so that the
+ * number of cycles depends on the magnitude of the dividend. A division by
+ * zero or a divisor greater than the dividend is completed without iterating.
+ */
+always_comb begin : divider
+  div_signed   = !op_i[0];
+  div_dividend = (div_signed && operand1_i[31]) ? -operand1_i : operand1_i;
+  div_divisor  = (div_signed && operand2_i[31]) ? -operand2_i : operand2_i;
+
+  div_skip = leading_zeros(div_quotient_q) & ~6'(DIV_BITS - 1);
+
+  div_quotient  = div_quotient_q;
+  div_remainder = div_remainder_q;
+  for(int i = 0; i < DIV_BITS; i++) begin
+    div_partial = {div_remainder, div_quotient[31]};
+    div_quotient = {div_quotient[30:0], 1'b0};
+    if(div_partial >= {1'b0, div_divisor_q}) begin
+      div_partial = div_partial - {1'b0, div_divisor_q};
+      div_quotient[0] = 1;
+    end
+    div_remainder = div_partial[31:0];
+  end
+end
+
+always_comb begin : state_machine
+  state_d = state_q;
+  count_d = count_q;
+  div_quotient_d = div_quotient_q;
+  div_remainder_d = div_remainder_q;
+  div_quotient_neg_d = div_quotient_neg_q;
+  div_remainder_neg_d = div_remainder_neg_q;
+
+  case(state_q)
+    IDLE: begin
+      if(request_i) begin
+        if(op_i[2]) begin
+          // The absolute value of the dividend is shifted into the quotient
+          state_d = DIVIDE;
+          count_d = '0;
+          div_quotient_d = div_dividend;
+          div_remainder_d = '0;
+          div_quotient_neg_d = div_signed && (operand1_i[31] ^ operand2_i[31]);
+          div_remainder_neg_d = div_signed && operand1_i[31];
+        end else begin
+          state_d = (MUL_STAGES > 1) ? MULTIPLY : DONE;
+          count_d = 6'(MUL_STAGES - 1);
+        end
+      end
+    end
+    MULTIPLY: begin
+      count_d = count_q - 1'b1;
+      if(count_q == 6'h1) begin
+        state_d = DONE;
+      end
+    end
+    DIVIDE: begin
+      if(count_q == '0) begin
+        // First cycle of the division
+        if(div_divisor_q == '0) begin
+          // The quotient of a division by zero has all bits set
+          state_d = DONE;
+          div_quotient_d = '1;
+          div_remainder_d = div_dividend_q;
+          div_quotient_neg_d = 0;
+          div_remainder_neg_d = 0;
+        end else if(div_quotient_q < div_divisor_q) begin
+          state_d = DONE;
+          div_remainder_d = div_quotient_q;
+          div_quotient_d = '0;
+        end else begin
+          count_d = 6'((32 - 32'(div_skip)) / DIV_BITS);
+          div_quotient_d = div_quotient_q << div_skip;
+        end
+      end else begin
+        count_d = count_q - 1'b1;
+        div_quotient_d = div_quotient;
+        div_remainder_d = div_remainder;
+        if(count_q == 6'h1) begin
+          state_d = DONE;
+        end
+      end
+    end
+    DONE: begin
+      if(ack_i) begin
+        state_d = IDLE;
+      end
+    end
+    default: begin
+    end
+  endcase
+end
+
+always_comb begin : result_mux
+  case(op_q)
+    3'b000:   result_o = mul_q[MUL_STAGES-1][31:0];
+    3'b001,
+    3'b010,
+    3'b011:   result_o = mul_q[MUL_STAGES-1][63:32];
+    3'b100,
+    3'b101:   result_o = div_quotient_neg_q  ? -div_quotient_q  : div_quotient_q;
+    default:  result_o = div_remainder_neg_q ? -div_remainder_q : div_remainder_q;
+  endcase
+end
+
+always_ff @(posedge clk_i) begin
+  if(rst_i) begin
+    state_q              <=  IDLE;
+    count_q              <=  '0;
+    op_q                 <=  '0;
+    div_dividend_q       <=  '0;
+    div_divisor_q        <=  '0;
+    div_quotient_q       <=  '0;
+    div_remainder_q      <=  '0;
+    div_quotient_neg_q   <=   0;
+    div_remainder_neg_q  <=   0;
+  end else begin
+    state_q              <=  state_d;
+    count_q              <=  count_d;
+    div_quotient_q       <=  div_quotient_d;
+    div_remainder_q      <=  div_remainder_d;
+    div_quotient_neg_q   <=  div_quotient_neg_d;
+    div_remainder_neg_q  <=  div_remainder_neg_d;
+
+    if((state_q == IDLE) && request_i) begin
+      op_q            <=  op_i;
+      div_dividend_q  <=  operand1_i;
+      div_divisor_q   <=  div_divisor;
+    end
+  end
+end
+
+/*
+ * The operands are only sampled when the request is accepted as they may be
+ * forwarded by the execute module during the first cycle only.
+ */
+always_ff @(posedge clk_i) begin
+  if((state_q == IDLE) && request_i) begin
+    mul_q[0] <= mul_product[63:0];
+  end
+  if(state_q == MULTIPLY) begin
+    for(int i = 1; i < MUL_STAGES; i++) begin
+      mul_q[i] <= mul_q[i-1];
+    end
+  end
+end
+
+/*****************************************/
+/*         Assign output signals         */
+/*****************************************/
+
+assign  valid_o  =  (state_q == DONE);
+
+endmodule // muldiv
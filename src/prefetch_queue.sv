@@ -0,0 +1,144 @@
+/*           __        _
+ *  ________/ /  ___ _(_)__  ___
+ * / __/ __/ _ \/ _ `/ / _ \/ -_)
+ * \__/\__/_//_/\_,_/_/_//_/\__/
+ * 
+ * Copyright (C) Clément Chaine
+ * This file is part of ECAP5-DPROC <https://github.com/ecap5/ECAP5-DPROC>
+ *
+ * ECAP5-DPROC is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ECAP5-DPROC is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ECAP5-DPROC.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+module prefetch_queue #(
+  parameter int DEPTH = 2
+)(
+  input   logic        clk_i,
+  input   logic        rst_i,
+  // Flush request
+  input   logic        flush_i,
+  // Input handshake
+  output  logic        input_ready_o,
+  input   logic        input_valid_i,
+  // Fetch inputs
+  input   logic[31:0]  instr_i,
+  input   logic[31:0]  pc_i,
+  input   logic        pred_taken_i,
+  input   logic[31:0]  pred_target_i,
+  // Output handshake
+  input   logic        output_ready_i,
+  output  logic        output_valid_o,
+  // Decode outputs
+  output  logic[31:0]  instr_o,
+  output  logic[31:0]  pc_o,
+  output  logic        pred_taken_o,
+  output  logic[31:0]  pred_target_o,
+  // Fusion window
+  input   logic        output_skip_i,
+  output  logic        next_valid_o,
+  output  logic[31:0]  next_instr_o,
+  output  logic        next_pred_taken_o
+);
+
+localparam int PTR_WIDTH = (DEPTH > 1) ? $clog2(DEPTH) : 1;
+localparam int CNT_WIDTH = $clog2(DEPTH + 1);
+localparam logic[CNT_WIDTH-1:0] MAX_COUNT = CNT_WIDTH'(DEPTH);
+
+/*****************************************/
+/*            Internal signals           */
+/*****************************************/
+logic[PTR_WIDTH-1:0]  head_d,   head_q;
+logic[PTR_WIDTH-1:0]  tail_d,   tail_q;
+logic[CNT_WIDTH-1:0]  count_d,  count_q /* verilator public */;
+logic[31:0]           instr_q   [DEPTH];
+logic[31:0]           pc_q      [DEPTH];
+logic                 pred_q    [DEPTH];
+logic[31:0]           target_q  [DEPTH];
+logic[PTR_WIDTH-1:0]  next_head;
+logic                 push, pop, skip;
+
+function automatic logic[PTR_WIDTH-1:0] next_index(input logic[PTR_WIDTH-1:0] index);
+  next_index = (index == PTR_WIDTH'(DEPTH - 1)) ? '0 : index + 1'b1;
+endfunction
+
+/*
+ * The readiness only depends on the queue occupancy so that no combinational
+ * path exists between the decode and fetch handshakes.
+ * A flush request discards the whole content of the queue and the instruction
+ * provided during the same cycle.
+ * The entry following the head is exposed to the decode module which may
+ * consume both entries at once, when it fuses them into a single operation.
+ */
+always_comb begin : queue_management
+  push = input_valid_i && input_ready_o && !flush_i;
+  pop = output_valid_o && output_ready_i;
+  skip = pop && output_skip_i && next_valid_o;
+
+  head_d = head_q;
+  tail_d = tail_q;
+  count_d = count_q;
+
+  if(flush_i) begin
+    head_d = '0;
+    tail_d = '0;
+    count_d = '0;
+  end else begin
+    if(push) begin
+      tail_d = next_index(tail_q);
+    end
+    if(skip) begin
+      head_d = next_index(next_head);
+    end else if(pop) begin
+      head_d = next_head;
+    end
+    count_d = count_q + CNT_WIDTH'(push) - CNT_WIDTH'(pop) - CNT_WIDTH'(skip);
+  end
+end
+
+always_ff @(posedge clk_i) begin
+  if(rst_i) begin
+    head_q   <=  '0;
+    tail_q   <=  '0;
+    count_q  <=  '0;
+  end else begin
+    head_q   <=  head_d;
+    tail_q   <=  tail_d;
+    count_q  <=  count_d;
+
+    if(push) begin
+      instr_q[tail_q]  <=  instr_i;
+      pc_q[tail_q]     <=  pc_i;
+      pred_q[tail_q]   <=  pred_taken_i;
+      target_q[tail_q] <=  pred_target_i;
+    end
+  end
+end
+
+assign next_head = next_index(head_q);
+
+/*****************************************/
+/*         Assign output signals         */
+/*****************************************/
+
+assign  input_ready_o   =  (count_q != MAX_COUNT);
+assign  output_valid_o  =  (count_q != 0);
+assign  instr_o         =  instr_q[head_q];
+assign  pc_o            =  pc_q[head_q];
+assign  pred_taken_o    =  pred_q[head_q];
+assign  pred_target_o   =  target_q[head_q];
+
+assign  next_valid_o       =  (DEPTH > 1) && (count_q > 1);
+assign  next_instr_o       =  instr_q[next_head];
+assign  next_pred_taken_o  =  pred_q[next_head];
+
+endmodule // prefetch_queue
@@ -20,7 +20,9 @@
  * along with ECAP5-DPROC.  If not, see <http://www.gnu.org/licenses/>.
  */
 
-module registers (
+module registers #(
+  parameter logic WRITE_THROUGH = 0
+)(
   input   logic        clk_i,     
   // First reading port
   input   logic[4:0]   raddr1_i,  
@@ -44,8 +46,26 @@ always @ (posedge clk_i) begin
   end
 end
 
-assign rdata1_o = raddr1_i == '0 ? '0 : registers[raddr1_i];
-assign rdata2_o = raddr2_i == '0 ? '0 : registers[raddr2_i];
+generate
+  if(WRITE_THROUGH) begin : write_through
+
+  // The data being written is output when reading the register being written
+  // during the same cycle.
+  logic bypass1, bypass2;
+
+  assign bypass1 = write_i && (waddr_i == raddr1_i);
+  assign bypass2 = write_i && (waddr_i == raddr2_i);
+
+  assign rdata1_o = raddr1_i == '0 ? '0 : (bypass1 ? wdata_i : registers[raddr1_i]);
+  assign rdata2_o = raddr2_i == '0 ? '0 : (bypass2 ? wdata_i : registers[raddr2_i]);
+
+  end else begin : read_before_write
+
+  assign rdata1_o = raddr1_i == '0 ? '0 : registers[raddr1_i];
+  assign rdata2_o = raddr2_i == '0 ? '0 : registers[raddr2_i];
+
+  end
+endgenerate
 
 `ifdef VERILATOR
   export "DPI-C" task set_register_value;
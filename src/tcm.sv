@@ -0,0 +1,255 @@
+/*           __        _
+ *  ________/ /  ___ _(_)__  ___
+ * / __/ __/ _ \/ _ `/ / _ \/ -_)
+ * \__/\__/_//_/\_,_/_/_//_/\__/
+ * 
+ * Copyright (C) Clément Chaine
+ * This file is part of ECAP5-DPROC <https://github.com/ecap5/ECAP5-DPROC>
+ *
+ * ECAP5-DPROC is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ECAP5-DPROC is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ECAP5-DPROC.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+module tcm #(
+  parameter logic[31:0]  BASE = 32'h00000000,
+  parameter int          SIZE = 4096
+)(
+  input   logic        clk_i,
+  input   logic        rst_i,
+
+  //=================================
+  //    Slave port
+  //
+  // Requests of the fetch or loadstore module. The address is a byte address
+  // and the data is right-aligned.
+
+  input   logic[31:0]  s_wb_adr_i,
+  output  logic[31:0]  s_wb_dat_o,
+  input   logic[31:0]  s_wb_dat_i,
+  input   logic        s_wb_we_i,
+  input   logic[3:0]   s_wb_sel_i,
+  input   logic        s_wb_stb_i,
+  output  logic        s_wb_ack_o,
+  input   logic        s_wb_cyc_i,
+  output  logic        s_wb_stall_o,
+
+  //=================================
+  //    Master port
+  //
+  // Requests of the slave port outside of the memory range, forwarded as is.
+
+  output  logic[31:0]  m_wb_adr_o,
+  input   logic[31:0]  m_wb_dat_i,
+  output  logic[31:0]  m_wb_dat_o,
+  output  logic        m_wb_we_o,
+  output  logic[3:0]   m_wb_sel_o,
+  output  logic        m_wb_stb_o,
+  input   logic        m_wb_ack_i,
+  output  logic        m_wb_cyc_o,
+  input   logic        m_wb_stall_i,
+
+  //=================================
+  //    Slave port 2
+  //
+  // Requests of the loadstore module to a tightly-coupled instruction memory.
+  // The port is unused when its stb and cyc inputs are tied to 0.
+
+  input   logic[31:0]  s2_wb_adr_i,
+  output  logic[31:0]  s2_wb_dat_o,
+  input   logic[31:0]  s2_wb_dat_i,
+  input   logic        s2_wb_we_i,
+  input   logic[3:0]   s2_wb_sel_i,
+  input   logic        s2_wb_stb_i,
+  output  logic        s2_wb_ack_o,
+  input   logic        s2_wb_cyc_i,
+  output  logic        s2_wb_stall_o,
+
+  //=================================
+  //    Master port 2
+  //
+  // Requests of the slave port 2 outside of the memory range, forwarded as is.
+
+  output  logic[31:0]  m2_wb_adr_o,
+  input   logic[31:0]  m2_wb_dat_i,
+  output  logic[31:0]  m2_wb_dat_o,
+  output  logic        m2_wb_we_o,
+  output  logic[3:0]   m2_wb_sel_o,
+  output  logic        m2_wb_stb_o,
+  input   logic        m2_wb_ack_i,
+  output  logic        m2_wb_cyc_o,
+  input   logic        m2_wb_stall_i
+);
+
+localparam int WORDS       = SIZE / 4;
+localparam int INDEX_WIDTH = (WORDS > 1) ? $clog2(WORDS) : 1;
+// Width of the count of forwarded requests in flight
+localparam int CNT_WIDTH   = 8;
+// Number of ports, each slave port being paired with a master port
+localparam int PORTS       = 2;
+
+/*****************************************/
+/*                Storage                */
+/*****************************************/
+
+logic[31:0]  data_q  [WORDS];
+
+/*****************************************/
+/*            Internal signals           */
+/*****************************************/
+
+// Inputs of the ports
+logic[31:0]  s_adr     [PORTS];
+logic[31:0]  s_dat     [PORTS];
+logic        s_we      [PORTS];
+logic[3:0]   s_sel     [PORTS];
+logic        s_stb     [PORTS];
+logic        s_cyc     [PORTS];
+logic        m_ack     [PORTS];
+logic        m_stall   [PORTS];
+
+logic                    request  [PORTS];
+logic                    hit      [PORTS];
+logic                    access   [PORTS];
+logic                    forward  [PORTS];
+logic                    m_stb    [PORTS];
+logic[INDEX_WIDTH-1:0]   index    [PORTS];
+
+logic[CNT_WIDTH-1:0]  pending_d  [PORTS], pending_q  [PORTS];
+logic[31:0]           s_wb_dat_d [PORTS], s_wb_dat_q [PORTS];
+logic                 s_wb_ack_d [PORTS], s_wb_ack_q [PORTS];
+
+// Extracts the right-aligned data of a load from a stored word
+function automatic logic[31:0] load_data(input logic[31:0] word, input logic[31:0] adr, input logic[3:0] sel);
+  logic[31:0] shifted;
+  shifted = word >> {adr[1:0], 3'b000};
+  case(sel)
+    4'h1:    load_data = {24'h0, shifted[7:0]};
+    4'h3:    load_data = {16'h0, shifted[15:0]};
+    4'h7:    load_data = {8'h0, shifted[23:0]};
+    default: load_data = shifted;
+  endcase
+endfunction
+
+// Merges the right-aligned data of a store into a stored word
+function automatic logic[31:0] store_data(input logic[31:0] word, input logic[31:0] adr, input logic[3:0] sel,
+                                          input logic[31:0] data);
+  logic[3:0]  mask;
+  logic[31:0] shifted;
+  mask    = sel << adr[1:0];
+  shifted = data << {adr[1:0], 3'b000};
+  store_data = word;
+  for(int i = 0; i < 4; i++) begin
+    if(mask[i]) begin
+      store_data[i*8 +: 8] = shifted[i*8 +: 8];
+    end
+  end
+endfunction
+
+assign s_adr   = '{s_wb_adr_i,   s2_wb_adr_i};
+assign s_dat   = '{s_wb_dat_i,   s2_wb_dat_i};
+assign s_we    = '{s_wb_we_i,    s2_wb_we_i};
+assign s_sel   = '{s_wb_sel_i,   s2_wb_sel_i};
+assign s_stb   = '{s_wb_stb_i,   s2_wb_stb_i};
+assign s_cyc   = '{s_wb_cyc_i,   s2_wb_cyc_i};
+assign m_ack   = '{m_wb_ack_i,   m2_wb_ack_i};
+assign m_stall = '{m_wb_stall_i, m2_wb_stall_i};
+
+/*
+ * Each port is served independently. A request hitting the memory is
+ * acknowledged on the following cycle. The responses are kept in order by
+ * holding a hitting request while forwarded requests are in flight, and by
+ * holding a forwarded request while the response of the memory is being
+ * provided.
+ */
+always_comb begin : request_routing
+  for(int p = 0; p < PORTS; p++) begin
+    request[p] = s_stb[p] && s_cyc[p];
+    hit[p]     = (s_adr[p] >= BASE) && ((s_adr[p] - BASE) < 32'(SIZE));
+    index[p]   = INDEX_WIDTH'((s_adr[p] - BASE) >> 2);
+    access[p]  = request[p] && hit[p] && (pending_q[p] == 0);
+    m_stb[p]   = request[p] && !hit[p] && !s_wb_ack_q[p];
+    forward[p] = m_stb[p] && !m_stall[p];
+
+    pending_d[p] = pending_q[p];
+    if(forward[p] && !m_ack[p]) begin
+      pending_d[p] = pending_q[p] + 1'b1;
+    end else if(!forward[p] && m_ack[p]) begin
+      pending_d[p] = pending_q[p] - 1'b1;
+    end
+
+    s_wb_ack_d[p] = access[p];
+    s_wb_dat_d[p] = (access[p] && !s_we[p]) ? load_data(data_q[index[p]], s_adr[p], s_sel[p]) : '0;
+  end
+end
+
+/*
+ * Both ports can write in the same cycle, the write of the slave port 2
+ * taking precedence when they target the same word.
+ */
+always_ff @(posedge clk_i) begin
+  for(int p = 0; p < PORTS; p++) begin
+    if(rst_i) begin
+      pending_q[p]   <=  '0;
+      s_wb_ack_q[p]  <=   0;
+      s_wb_dat_q[p]  <=  '0;
+    end else begin
+      pending_q[p]   <=  pending_d[p];
+      s_wb_ack_q[p]  <=  s_wb_ack_d[p];
+      s_wb_dat_q[p]  <=  s_wb_dat_d[p];
+
+      if(access[p] && s_we[p]) begin
+        data_q[index[p]] <= store_data(data_q[index[p]], s_adr[p], s_sel[p], s_dat[p]);
+      end
+    end
+  end
+end
+
+`ifdef VERILATOR
+  export "DPI-C" task set_tcm_word;
+  task automatic set_tcm_word(input logic[31:0] adr, input logic[31:0] value);
+    data_q[INDEX_WIDTH'((adr - BASE) >> 2)] = value;
+  endtask
+  export "DPI-C" task get_tcm_range;
+  task automatic get_tcm_range(output logic[31:0] base, output logic[31:0] size);
+    base = BASE;
+    size = 32'(SIZE);
+  endtask
+`endif
+
+/*****************************************/
+/*         Assign output signals         */
+/*****************************************/
+
+assign  s_wb_dat_o     =  s_wb_ack_q[0] ? s_wb_dat_q[0] : m_wb_dat_i;
+assign  s_wb_ack_o     =  s_wb_ack_q[0] || m_wb_ack_i;
+assign  s_wb_stall_o   =  hit[0] ? (pending_q[0] != 0) : (m_wb_stall_i || s_wb_ack_q[0]);
+
+assign  m_wb_adr_o     =  s_wb_adr_i;
+assign  m_wb_dat_o     =  s_wb_dat_i;
+assign  m_wb_we_o      =  s_wb_we_i;
+assign  m_wb_sel_o     =  s_wb_sel_i;
+assign  m_wb_stb_o     =  m_stb[0];
+assign  m_wb_cyc_o     =  m_stb[0] || (pending_q[0] != 0);
+
+assign  s2_wb_dat_o    =  s_wb_ack_q[1] ? s_wb_dat_q[1] : m2_wb_dat_i;
+assign  s2_wb_ack_o    =  s_wb_ack_q[1] || m2_wb_ack_i;
+assign  s2_wb_stall_o  =  hit[1] ? (pending_q[1] != 0) : (m2_wb_stall_i || s_wb_ack_q[1]);
+
+assign  m2_wb_adr_o    =  s2_wb_adr_i;
+assign  m2_wb_dat_o    =  s2_wb_dat_i;
+assign  m2_wb_we_o     =  s2_wb_we_i;
+assign  m2_wb_sel_o    =  s2_wb_sel_i;
+assign  m2_wb_stb_o    =  m_stb[1];
+assign  m2_wb_cyc_o    =  m_stb[1] || (pending_q[1] != 0);
+
+endmodule // tcm
@@ -0,0 +1,504 @@
+/*           __        _
+ *  ________/ /  ___ _(_)__  ___
+ * / __/ __/ _ \/ _ `/ / _ \/ -_)
+ * \__/\__/_//_/\_,_/_/_//_/\__/
+ *
+ * Copyright (C) Clément Chaine
+ * This file is part of ECAP5-DPROC <https://github.com/ecap5/ECAP5-DPROC>
+ *
+ * ECAP5-DPROC is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ECAP5-DPROC is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ECAP5-DPROC.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <verilated.h>
+#include <verilated_vcd_c.h>
+#include <svdpi.h>
+
+#include "Vtb_aligner.h"
+#include "testbench.h"
+
+enum CondId {
+  COND_input_ready,
+  COND_output,
+  COND_output_valid,
+  __CondIdEnd
+};
+
+enum TestcaseId {
+  T_RESET          =  1,
+  T_UNCOMPRESSED   =  2,
+  T_COMPRESSED     =  3,
+  T_CROSSING       =  4,
+  T_UPPER_HALF     =  5,
+  T_FLUSH          =  6
+};
+
+class TB_Aligner : public Testbench<Vtb_aligner> {
+public:
+  void reset() {
+    this->core->flush_i = 0;
+    this->core->input_valid_i = 0;
+    this->core->instr_i = 0;
+    this->core->pc_i = 0;
+    this->core->output_ready_i = 0;
+
+    this->core->rst_i = 1;
+    for(int i = 0; i < 5; i++) {
+      this->tick();
+    }
+    this->core->rst_i = 0;
+
+    Testbench<Vtb_aligner>::reset();
+  }
+
+  void _push(uint32_t instr, uint32_t pc) {
+    this->core->input_valid_i = 1;
+    this->core->instr_i = instr;
+    this->core->pc_i = pc;
+  }
+
+  // Returns a random 16-bit compressed instruction
+  static uint16_t compressed() {
+    return (rand() & 0xFFFC) | (rand() % 3);
+  }
+
+  // Returns a random 32-bit instruction
+  static uint32_t uncompressed() {
+    return rand() | 0x3;
+  }
+};
+
+void tb_aligner_reset(TB_Aligner * tb) {
+  Vtb_aligner * core = tb->core;
+  core->testcase = T_RESET;
+
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_output_valid,  (core->output_valid_o  ==  0));
+
+  //`````````````````````````````````
+  //      Formal Checks
+
+  CHECK("tb_aligner.reset.01",
+      tb->conditions[COND_output_valid],
+      "Failed to implement the output_valid_o signal", tb->err_cycles[COND_output_valid]);
+}
+
+void tb_aligner_uncompressed(TB_Aligner * tb) {
+  Vtb_aligner * core = tb->core;
+  core->testcase = T_UNCOMPRESSED;
+
+  // The following actions are performed in this test :
+  //    tick 0. Push a 32-bit instruction (aligner outputs it)
+  //    tick 1. Nothing (aligner is empty)
+
+  //=================================
+  //      Tick (0)
+
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  uint32_t instr = TB_Aligner::uncompressed();
+  uint32_t pc = rand() & ~0x3;
+  tb->_push(instr, pc);
+  core->output_ready_i = 1;
+
+  // this change is asynchronous
+  core->eval();
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_input_ready,   (core->input_ready_o   ==  1));
+  tb->check(COND_output_valid,  (core->output_valid_o  ==  1));
+  tb->check(COND_output,        (core->instr_o         ==  instr) &&
+                                (core->pc_o            ==  pc)    &&
+                                (core->compressed_o    ==  0));
+
+  //=================================
+  //      Tick (1)
+
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  core->input_valid_i = 0;
+  core->eval();
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_output_valid,  (core->output_valid_o  ==  0));
+
+  //`````````````````````````````````
+  //      Formal Checks
+
+  CHECK("tb_aligner.uncompressed.01",
+      tb->conditions[COND_input_ready],
+      "Failed to implement the input_ready_o signal", tb->err_cycles[COND_input_ready]);
+
+  CHECK("tb_aligner.uncompressed.02",
+      tb->conditions[COND_output_valid],
+      "Failed to implement the output_valid_o signal", tb->err_cycles[COND_output_valid]);
+
+  CHECK("tb_aligner.uncompressed.03",
+      tb->conditions[COND_output],
+      "Failed to implement the output signals", tb->err_cycles[COND_output]);
+}
+
+void tb_aligner_compressed(TB_Aligner * tb) {
+  Vtb_aligner * core = tb->core;
+  core->testcase = T_COMPRESSED;
+
+  // The following actions are performed in this test :
+  //    tick 0. Push a word holding the compressed instructions A and B (aligner outputs A)
+  //    tick 1. Push the next word (aligner outputs B and holds the word)
+  //    tick 2. Nothing (aligner outputs the next word)
+
+  //=================================
+  //      Tick (0)
+
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  uint16_t instr_a = TB_Aligner::compressed();
+  uint16_t instr_b = TB_Aligner::compressed();
+  uint32_t instr_c = TB_Aligner::uncompressed();
+  uint32_t pc = rand() & ~0x3;
+  tb->_push(((uint32_t)instr_b << 16) | instr_a, pc);
+  core->output_ready_i = 1;
+
+  core->eval();
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_input_ready,   (core->input_ready_o   ==  1));
+  tb->check(COND_output_valid,  (core->output_valid_o  ==  1));
+  tb->check(COND_output,        (core->instr_o         ==  instr_a) &&
+                                (core->pc_o            ==  pc)      &&
+                                (core->compressed_o    ==  1));
+
+  //=================================
+  //      Tick (1)
+
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  tb->_push(instr_c, pc + 4);
+  core->eval();
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_input_ready,   (core->input_ready_o   ==  0));
+  tb->check(COND_output_valid,  (core->output_valid_o  ==  1));
+  tb->check(COND_output,        (core->instr_o         ==  instr_b) &&
+                                (core->pc_o            ==  pc + 2)  &&
+                                (core->compressed_o    ==  1));
+
+  //=================================
+  //      Tick (2)
+
+  tb->tick();
+  core->eval();
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_input_ready,   (core->input_ready_o   ==  1));
+  tb->check(COND_output_valid,  (core->output_valid_o  ==  1));
+  tb->check(COND_output,        (core->instr_o         ==  instr_c) &&
+                                (core->pc_o            ==  pc + 4)  &&
+                                (core->compressed_o    ==  0));
+
+  //`````````````````````````````````
+  //      Formal Checks
+
+  CHECK("tb_aligner.compressed.01",
+      tb->conditions[COND_input_ready],
+      "Failed to implement the input_ready_o signal", tb->err_cycles[COND_input_ready]);
+
+  CHECK("tb_aligner.compressed.02",
+      tb->conditions[COND_output_valid],
+      "Failed to implement the output_valid_o signal", tb->err_cycles[COND_output_valid]);
+
+  CHECK("tb_aligner.compressed.03",
+      tb->conditions[COND_output],
+      "Failed to implement the output signals", tb->err_cycles[COND_output]);
+}
+
+void tb_aligner_crossing(TB_Aligner * tb) {
+  Vtb_aligner * core = tb->core;
+  core->testcase = T_CROSSING;
+
+  // The following actions are performed in this test :
+  //    tick 0. Push a word holding the compressed instruction A and the
+  //            lower half of B (aligner outputs A)
+  //    tick 1. Push a word holding the upper half of B and the compressed
+  //            instruction C (aligner outputs B)
+  //    tick 2. Nothing (aligner outputs C)
+
+  //=================================
+  //      Tick (0)
+
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  uint16_t instr_a = TB_Aligner::compressed();
+  uint32_t instr_b = TB_Aligner::uncompressed();
+  uint16_t instr_c = TB_Aligner::compressed();
+  uint32_t pc = rand() & ~0x3;
+  tb->_push((instr_b << 16) | instr_a, pc);
+  core->output_ready_i = 1;
+
+  core->eval();
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_output_valid,  (core->output_valid_o  ==  1));
+  tb->check(COND_output,        (core->instr_o         ==  instr_a) &&
+                                (core->pc_o            ==  pc)      &&
+                                (core->compressed_o    ==  1));
+
+  //=================================
+  //      Tick (1)
+
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  tb->_push(((uint32_t)instr_c << 16) | (instr_b >> 16), pc + 4);
+  core->eval();
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_input_ready,   (core->input_ready_o   ==  1));
+  tb->check(COND_output_valid,  (core->output_valid_o  ==  1));
+  tb->check(COND_output,        (core->instr_o         ==  instr_b) &&
+                                (core->pc_o            ==  pc + 2)  &&
+                                (core->compressed_o    ==  0));
+
+  //=================================
+  //      Tick (2)
+
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  core->input_valid_i = 0;
+  core->eval();
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_output_valid,  (core->output_valid_o  ==  1));
+  tb->check(COND_output,        (core->instr_o         ==  instr_c) &&
+                                (core->pc_o            ==  pc + 6)  &&
+                                (core->compressed_o    ==  1));
+
+  //`````````````````````````````````
+  //      Formal Checks
+
+  CHECK("tb_aligner.crossing.01",
+      tb->conditions[COND_input_ready],
+      "Failed to implement the input_ready_o signal", tb->err_cycles[COND_input_ready]);
+
+  CHECK("tb_aligner.crossing.02",
+      tb->conditions[COND_output_valid],
+      "Failed to implement the output_valid_o signal", tb->err_cycles[COND_output_valid]);
+
+  CHECK("tb_aligner.crossing.03",
+      tb->conditions[COND_output],
+      "Failed to implement the output signals", tb->err_cycles[COND_output]);
+}
+
+void tb_aligner_upper_half(TB_Aligner * tb) {
+  Vtb_aligner * core = tb->core;
+  core->testcase = T_UPPER_HALF;
+
+  // The following actions are performed in this test :
+  //    tick 0. Push a word fetched for a jump target located in its upper
+  //            half, holding the lower half of A (aligner holds it)
+  //    tick 1. Push the word holding the upper half of A (aligner outputs A)
+
+  //=================================
+  //      Tick (0)
+
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  uint32_t instr_a = TB_Aligner::uncompressed();
+  uint32_t pc = (rand() & ~0x3) | 0x2;
+  tb->_push((instr_a << 16) | (rand() & 0xFFFF), pc);
+  core->output_ready_i = 1;
+
+  core->eval();
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_input_ready,   (core->input_ready_o   ==  1));
+  tb->check(COND_output_valid,  (core->output_valid_o  ==  0));
+
+  //=================================
+  //      Tick (1)
+
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  tb->_push(((uint32_t)rand() << 16) | (instr_a >> 16), pc + 2);
+  core->eval();
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_output_valid,  (core->output_valid_o  ==  1));
+  tb->check(COND_output,        (core->instr_o         ==  instr_a) &&
+                                (core->pc_o            ==  pc)      &&
+                                (core->compressed_o    ==  0));
+
+  //`````````````````````````````````
+  //      Formal Checks
+
+  CHECK("tb_aligner.upper_half.01",
+      tb->conditions[COND_input_ready],
+      "Failed to implement the input_ready_o signal", tb->err_cycles[COND_input_ready]);
+
+  CHECK("tb_aligner.upper_half.02",
+      tb->conditions[COND_output_valid],
+      "Failed to implement the output_valid_o signal", tb->err_cycles[COND_output_valid]);
+
+  CHECK("tb_aligner.upper_half.03",
+      tb->conditions[COND_output],
+      "Failed to implement the output signals", tb->err_cycles[COND_output]);
+}
+
+void tb_aligner_flush(TB_Aligner * tb) {
+  Vtb_aligner * core = tb->core;
+  core->testcase = T_FLUSH;
+
+  // The following actions are performed in this test :
+  //    tick 0. Push a word holding the compressed instructions A and B (aligner outputs A)
+  //    tick 1. Flush the aligner with the output not ready (aligner drops B)
+  //    tick 2. Nothing (aligner is empty)
+
+  //=================================
+  //      Tick (0)
+
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  uint32_t pc = rand() & ~0x3;
+  tb->_push(((uint32_t)TB_Aligner::compressed() << 16) | TB_Aligner::compressed(), pc);
+  core->output_ready_i = 1;
+
+  //=================================
+  //      Tick (1)
+
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  core->input_valid_i = 0;
+  core->output_ready_i = 0;
+  core->flush_i = 1;
+
+  //=================================
+  //      Tick (2)
+
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  core->flush_i = 0;
+  core->eval();
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_output_valid,  (core->output_valid_o  ==  0));
+
+  //`````````````````````````````````
+  //      Formal Checks
+
+  CHECK("tb_aligner.flush.01",
+      tb->conditions[COND_output_valid],
+      "Failed to implement the output_valid_o signal", tb->err_cycles[COND_output_valid]);
+}
+
+int main(int argc, char ** argv, char ** env) {
+  srand(time(NULL));
+  Verilated::traceEverOn(true);
+
+  bool verbose = parse_verbose(argc, argv);
+
+  TB_Aligner * tb = new TB_Aligner;
+  tb->open_trace("waves/aligner.vcd");
+  tb->open_testdata("testdata/aligner.csv");
+  tb->set_debug_log(verbose);
+  tb->init_conditions(__CondIdEnd);
+
+  /************************************************************/
+
+  tb_aligner_reset(tb);
+
+  tb_aligner_uncompressed(tb);
+
+  tb_aligner_compressed(tb);
+
+  tb_aligner_crossing(tb);
+
+  tb_aligner_upper_half(tb);
+
+  tb_aligner_flush(tb);
+
+  /************************************************************/
+
+  printf("[ALIGNER]: ");
+  if(tb->success) {
+    printf("Done\n");
+  } else {
+    printf("Failed\n");
+  }
+
+  delete tb;
+  exit(EXIT_SUCCESS);
+}
@@ -0,0 +1,60 @@
+/*           __        _
+ *  ________/ /  ___ _(_)__  ___
+ * / __/ __/ _ \/ _ `/ / _ \/ -_)
+ * \__/\__/_//_/\_,_/_/_//_/\__/
+ *
+ * Copyright (C) Clément Chaine
+ * This file is part of ECAP5-DPROC <https://github.com/ecap5/ECAP5-DPROC>
+ *
+ * ECAP5-DPROC is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ECAP5-DPROC is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ECAP5-DPROC.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+module tb_aligner (
+  input   int          testcase,
+
+  input   logic        clk_i,
+  input   logic        rst_i,
+  // Flush request
+  input   logic        flush_i,
+  // Input handshake
+  output  logic        input_ready_o,
+  input   logic        input_valid_i,
+  // Fetch inputs
+  input   logic[31:0]  instr_i,
+  input   logic[31:0]  pc_i,
+  // Output handshake
+  input   logic        output_ready_i,
+  output  logic        output_valid_o,
+  // Decode outputs
+  output  logic[31:0]  instr_o,
+  output  logic[31:0]  pc_o,
+  output  logic        compressed_o
+);
+
+aligner dut (
+  .clk_i           (clk_i),
+  .rst_i           (rst_i),
+  .flush_i         (flush_i),
+  .input_ready_o   (input_ready_o),
+  .input_valid_i   (input_valid_i),
+  .instr_i         (instr_i),
+  .pc_i            (pc_i),
+  .output_ready_i  (output_ready_i),
+  .output_valid_o  (output_valid_o),
+  .instr_o         (instr_o),
+  .pc_o            (pc_o),
+  .compressed_o    (compressed_o)
+);
+
+endmodule // tb_aligner
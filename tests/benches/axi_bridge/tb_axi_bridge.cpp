@@ -0,0 +1,695 @@
+/*           __        _
+ *  ________/ /  ___ _(_)__  ___
+ * / __/ __/ _ \/ _ `/ / _ \/ -_)
+ * \__/\__/_//_/\_,_/_/_//_/\__/
+ * 
+ * Copyright (C) Clément Chaine
+ * This file is part of ECAP5-DPROC <https://github.com/ecap5/ECAP5-DPROC>
+ *
+ * ECAP5-DPROC is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ECAP5-DPROC is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ECAP5-DPROC.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <verilated.h>
+#include <verilated_vcd_c.h>
+#include <svdpi.h>
+#include <deque>
+#include <map>
+#include <vector>
+
+#include "Vtb_axi_bridge.h"
+#include "testbench.h"
+#include "Vtb_axi_bridge_tb_axi_bridge.h"
+
+enum CondId {
+  COND_wb,
+  COND_axi,
+  COND_data,
+  COND_throughput,
+  COND_outstanding,
+  COND_ordering,
+  __CondIdEnd
+};
+
+enum TestcaseId {
+  T_RESET        =  1,
+  T_READ         =  2,
+  T_WRITE        =  3,
+  T_ORDERING     =  4,
+  T_BYTE_LANES   =  5,
+  T_MEMORY_WAIT  =  6
+};
+
+struct Access {
+  bool we;
+  uint32_t adr;
+  uint32_t dat;
+  uint8_t sel;
+};
+
+struct Transaction {
+  uint32_t due;
+  uint32_t addr;
+  uint8_t size;
+  uint32_t data;
+  uint8_t strb;
+};
+
+class TB_Axi_bridge : public Testbench<Vtb_axi_bridge> {
+public:
+  // Pipelined wishbone master model
+  std::deque<Access> queue;
+  std::deque<Access> outstanding;
+  std::vector<Access> completed;
+  std::vector<uint32_t> responses;
+  uint32_t unexpected_acks;
+  // Cycles at which the requests were accepted
+  std::vector<uint32_t> issued;
+
+  // AXI4 slave model of the memory
+  uint32_t latency;
+  bool random_ready;
+  uint32_t cycle;
+  std::map<uint32_t, uint8_t> written;
+  std::deque<Transaction> aw, w, reads, writes;
+  // Transactions received by the memory
+  std::vector<Transaction> ar_transfers, aw_transfers, w_transfers;
+  // Maximum number of transactions in flight
+  uint32_t max_in_flight;
+  // A read and a write transaction were in flight simultaneously
+  bool mixed;
+
+  void reset() {
+    this->queue.clear();
+    this->outstanding.clear();
+    this->completed.clear();
+    this->responses.clear();
+    this->unexpected_acks = 0;
+    this->issued.clear();
+    this->latency = 0;
+    this->random_ready = false;
+    this->cycle = 0;
+    this->written.clear();
+    this->aw.clear();
+    this->w.clear();
+    this->reads.clear();
+    this->writes.clear();
+
+    this->drive();
+    this->core->m_axi_awready_i = 1;
+    this->core->m_axi_wready_i = 1;
+    this->core->m_axi_bresp_i = 0;
+    this->core->m_axi_bvalid_i = 0;
+    this->core->m_axi_arready_i = 1;
+    this->core->m_axi_rdata_i = 0;
+    this->core->m_axi_rresp_i = 0;
+    this->core->m_axi_rlast_i = 0;
+    this->core->m_axi_rvalid_i = 0;
+
+    this->core->rst_i = 1;
+    for(int i = 0; i < 5; i++) {
+      Testbench<Vtb_axi_bridge>::tick();
+    }
+    this->core->rst_i = 0;
+
+    this->ar_transfers.clear();
+    this->aw_transfers.clear();
+    this->w_transfers.clear();
+    this->max_in_flight = 0;
+    this->mixed = false;
+
+    Testbench<Vtb_axi_bridge>::reset();
+  }
+
+  uint8_t byte(uint32_t adr) {
+    auto it = this->written.find(adr);
+    if(it != this->written.end()) {
+      return it->second;
+    }
+    return ((adr * 2654435761u) >> 13) & 0xFF;
+  }
+
+  // Data of the aligned word containing adr, as provided on the byte lanes
+  uint32_t lanes(uint32_t adr) {
+    uint32_t base = adr & ~3u;
+    return this->byte(base) | (this->byte(base + 1) << 8) |
+           (this->byte(base + 2) << 16) | (this->byte(base + 3) << 24);
+  }
+
+  // Data expected by the wishbone master, aligned on the least significant bits
+  uint32_t expected(const Access & access) {
+    uint32_t data = 0;
+    for(int i = 0; i < 4; i++) {
+      if(access.sel & (1 << i)) {
+        data |= this->byte(access.adr + i) << (8 * i);
+      }
+    }
+    return data;
+  }
+
+  void drive() {
+    bool stb = !this->queue.empty();
+    this->core->s_wb_adr_i = stb ? this->queue.front().adr : 0;
+    this->core->s_wb_dat_i = stb ? this->queue.front().dat : 0;
+    this->core->s_wb_we_i  = stb ? this->queue.front().we  : 0;
+    this->core->s_wb_sel_i = stb ? this->queue.front().sel : 0;
+    this->core->s_wb_stb_i = stb;
+    this->core->s_wb_cyc_i = stb || !this->outstanding.empty();
+  }
+
+  void tick() {
+    this->drive();
+    // Responses are provided latency cycles after the transaction is received
+    bool rvalid = !this->reads.empty() && (this->reads.front().due <= this->cycle);
+    bool bvalid = !this->writes.empty() && (this->writes.front().due <= this->cycle);
+    this->core->m_axi_rvalid_i = rvalid;
+    this->core->m_axi_rdata_i = rvalid ? this->reads.front().data : 0;
+    this->core->m_axi_rlast_i = rvalid;
+    this->core->m_axi_bvalid_i = bvalid;
+    this->core->eval();
+
+    bool ar = this->core->m_axi_arvalid_o && this->core->m_axi_arready_i;
+    bool aw = this->core->m_axi_awvalid_o && this->core->m_axi_awready_i;
+    bool w  = this->core->m_axi_wvalid_o  && this->core->m_axi_wready_i;
+    bool r  = rvalid && this->core->m_axi_rready_o;
+    bool b  = bvalid && this->core->m_axi_bready_o;
+
+    // Wishbone master
+    bool stb = this->core->s_wb_stb_i;
+    bool accepted = stb && !this->core->s_wb_stall_o;
+    if(this->core->s_wb_ack_o) {
+      if(!this->outstanding.empty()) {
+        this->completed.push_back(this->outstanding.front());
+        this->responses.push_back(this->core->s_wb_dat_o);
+        this->outstanding.pop_front();
+      } else {
+        this->unexpected_acks += 1;
+      }
+    }
+    if(accepted) {
+      this->outstanding.push_back(this->queue.front());
+      this->issued.push_back(this->cycle);
+      this->queue.pop_front();
+    }
+
+    Testbench<Vtb_axi_bridge>::tick();
+
+    // AXI4 slave
+    if(r) {
+      this->reads.pop_front();
+    }
+    if(b) {
+      this->writes.pop_front();
+    }
+    if(ar) {
+      if(!this->writes.empty() || !this->aw.empty() || !this->w.empty()) {
+        this->mixed = true;
+      }
+      Transaction t = {this->cycle + 1 + this->latency, this->core->m_axi_araddr_o,
+                       this->core->m_axi_arsize_o, this->lanes(this->core->m_axi_araddr_o), 0};
+      this->reads.push_back(t);
+      this->ar_transfers.push_back(t);
+    }
+    if(aw) {
+      if(!this->reads.empty()) {
+        this->mixed = true;
+      }
+      Transaction t = {0, this->core->m_axi_awaddr_o, this->core->m_axi_awsize_o, 0, 0};
+      this->aw.push_back(t);
+      this->aw_transfers.push_back(t);
+    }
+    if(w) {
+      Transaction t = {0, 0, 0, this->core->m_axi_wdata_o, this->core->m_axi_wstrb_o};
+      this->w.push_back(t);
+      this->w_transfers.push_back(t);
+    }
+    // A write is performed once both its address and data are received
+    while(!this->aw.empty() && !this->w.empty()) {
+      Transaction t = this->aw.front();
+      t.data = this->w.front().data;
+      t.strb = this->w.front().strb;
+      t.due = this->cycle + 1 + this->latency;
+      uint32_t base = t.addr & ~3u;
+      for(int i = 0; i < 4; i++) {
+        if(t.strb & (1 << i)) {
+          this->written[base + i] = (t.data >> (8 * i)) & 0xFF;
+        }
+      }
+      this->writes.push_back(t);
+      this->aw.pop_front();
+      this->w.pop_front();
+    }
+    uint32_t in_flight = this->reads.size() + this->writes.size();
+    if(in_flight > this->max_in_flight) {
+      this->max_in_flight = in_flight;
+    }
+
+    this->cycle += 1;
+
+    if(this->random_ready) {
+      this->core->m_axi_awready_i = rand() % 2;
+      this->core->m_axi_wready_i = rand() % 2;
+      this->core->m_axi_arready_i = rand() % 2;
+    }
+  }
+
+  void run(uint32_t cycles) {
+    for(uint32_t i = 0; i < cycles; i++) {
+      this->tick();
+    }
+  }
+
+  static Access random_access() {
+    const uint8_t sels[3] = {0x1, 0x3, 0xF};
+    Access access;
+    access.we = rand() % 2;
+    access.sel = sels[rand() % 3];
+    access.adr = (rand() % 256) * 4 + ((access.sel == 0x1) ? (rand() % 4) :
+                                       (access.sel == 0x3) ? 2 * (rand() % 2) : 0);
+    access.dat = rand();
+    if(access.sel != 0xF) {
+      access.dat &= (access.sel == 0x1) ? 0xFF : 0xFFFF;
+    }
+    return access;
+  }
+
+  // Checks that the accesses were completed in order and that the read data
+  // matches the reference model
+  bool completions_match(const std::vector<Access> & accesses, const std::vector<uint32_t> & data) {
+    if((this->completed.size() != accesses.size()) || (this->unexpected_acks != 0)) {
+      return false;
+    }
+    for(size_t i = 0; i < accesses.size(); i++) {
+      if((this->completed[i].adr != accesses[i].adr) || (this->completed[i].we != accesses[i].we)) {
+        return false;
+      }
+      if(!accesses[i].we && (this->responses[i] != data[i])) {
+        return false;
+      }
+    }
+    return true;
+  }
+};
+
+void tb_axi_bridge_reset(TB_Axi_bridge * tb) {
+  Vtb_axi_bridge * core = tb->core;
+  core->testcase = T_RESET;
+
+  //=================================
+  //      Tick (0)
+
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_wb,  (core->s_wb_ack_o == 0));
+  tb->check(COND_axi, (core->m_axi_awvalid_o == 0) &&
+                      (core->m_axi_wvalid_o  == 0) &&
+                      (core->m_axi_arvalid_o == 0));
+
+  //`````````````````````````````````
+  //      Formal Checks
+
+  CHECK("tb_axi_bridge.reset.01",
+      tb->conditions[COND_wb],
+      "Failed to reset the wishbone slave port", tb->err_cycles[COND_wb]);
+
+  CHECK("tb_axi_bridge.reset.02",
+      tb->conditions[COND_axi],
+      "Failed to reset the AXI master port", tb->err_cycles[COND_axi]);
+}
+
+void tb_axi_bridge_read(TB_Axi_bridge * tb) {
+  Vtb_axi_bridge * core = tb->core;
+  core->testcase = T_READ;
+
+  // The following actions are performed in this test :
+  //    tick 0. Issue back-to-back word reads
+  //    tick 1-99. Nothing (core issues a read transaction every cycle)
+
+  //=================================
+  //      Tick (0)
+
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  tb->latency = rand() % (core->tb_axi_bridge->OUTSTANDING_DEPTH - 1);
+  const uint32_t count = 16;
+  std::vector<Access> accesses;
+  std::vector<uint32_t> data;
+  for(uint32_t i = 0; i < count; i++) {
+    accesses.push_back({false, (uint32_t)(rand() % 256) * 4, 0, 0xF});
+    data.push_back(tb->expected(accesses.back()));
+    tb->queue.push_back(accesses.back());
+  }
+
+  //=================================
+  //      Tick (0-99)
+
+  tb->run(100);
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_data, tb->completions_match(accesses, data));
+  tb->check(COND_axi,  (tb->ar_transfers.size() == count) && tb->aw_transfers.empty());
+  for(const Transaction & t : tb->ar_transfers) {
+    tb->check(COND_axi, (t.size == 2));
+  }
+  // A request is accepted every cycle as the responses arrive before the
+  // maximum number of transactions in flight is reached
+  tb->check(COND_throughput, (tb->issued.size() == count));
+  for(uint32_t i = 0; i < tb->issued.size(); i++) {
+    tb->check(COND_throughput, (tb->issued[i] == i));
+  }
+
+  //`````````````````````````````````
+  //      Formal Checks
+
+  CHECK("tb_axi_bridge.read.01",
+      tb->conditions[COND_data],
+      "Failed to respond with the read data", tb->err_cycles[COND_data]);
+
+  CHECK("tb_axi_bridge.read.02",
+      tb->conditions[COND_axi],
+      "Failed to issue the read transactions", tb->err_cycles[COND_axi]);
+
+  CHECK("tb_axi_bridge.read.03",
+      tb->conditions[COND_throughput],
+      "Failed to issue a transaction every cycle", tb->err_cycles[COND_throughput]);
+}
+
+void tb_axi_bridge_write(TB_Axi_bridge * tb) {
+  Vtb_axi_bridge * core = tb->core;
+  core->testcase = T_WRITE;
+
+  // The following actions are performed in this test :
+  //    tick 0. Issue word writes on a slow memory accepting the write
+  //            addresses and data independently
+  //    tick 1-299. Nothing
+
+  //=================================
+  //      Tick (0)
+
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  uint32_t depth = core->tb_axi_bridge->OUTSTANDING_DEPTH;
+  tb->latency = 2 * depth;
+  tb->random_ready = true;
+  const uint32_t count = 16;
+  std::vector<Access> accesses;
+  std::vector<uint32_t> data;
+  for(uint32_t i = 0; i < count; i++) {
+    accesses.push_back({true, i * 4, (uint32_t)rand(), 0xF});
+    data.push_back(0);
+    tb->queue.push_back(accesses.back());
+  }
+
+  //=================================
+  //      Tick (0-299)
+
+  tb->run(300);
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_data, tb->completions_match(accesses, data));
+  tb->check(COND_axi,  (tb->aw_transfers.size() == count) && (tb->w_transfers.size() == count));
+  for(uint32_t i = 0; i < tb->aw_transfers.size() && i < tb->w_transfers.size(); i++) {
+    tb->check(COND_axi, (tb->aw_transfers[i].addr == accesses[i].adr) &&
+                        (tb->aw_transfers[i].size == 2) &&
+                        (tb->w_transfers[i].data == accesses[i].dat) &&
+                        (tb->w_transfers[i].strb == 0xF));
+  }
+  tb->check(COND_outstanding, (tb->max_in_flight == depth));
+
+  //`````````````````````````````````
+  //      Formal Checks
+
+  CHECK("tb_axi_bridge.write.01",
+      tb->conditions[COND_data],
+      "Failed to acknowledge the writes", tb->err_cycles[COND_data]);
+
+  CHECK("tb_axi_bridge.write.02",
+      tb->conditions[COND_axi],
+      "Failed to issue the write transactions", tb->err_cycles[COND_axi]);
+
+  CHECK("tb_axi_bridge.write.03",
+      tb->conditions[COND_outstanding],
+      "Failed to limit the number of transactions in flight", tb->err_cycles[COND_outstanding]);
+}
+
+void tb_axi_bridge_ordering(TB_Axi_bridge * tb) {
+  Vtb_axi_bridge * core = tb->core;
+  core->testcase = T_ORDERING;
+
+  // The following actions are performed in this test :
+  //    tick 0. Issue writes each followed by a read of the same address
+  //    tick 1-299. Nothing (core waits for the write responses before
+  //                issuing the reads)
+
+  //=================================
+  //      Tick (0)
+
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  tb->latency = 1 + rand() % 4;
+  const uint32_t count = 8;
+  std::vector<Access> accesses;
+  std::vector<uint32_t> data;
+  for(uint32_t i = 0; i < count; i++) {
+    uint32_t adr = (rand() % 256) * 4;
+    uint32_t dat = rand();
+    accesses.push_back({true, adr, dat, 0xF});
+    data.push_back(0);
+    accesses.push_back({false, adr, 0, 0xF});
+    data.push_back(dat);
+  }
+  for(const Access & access : accesses) {
+    tb->queue.push_back(access);
+  }
+
+  //=================================
+  //      Tick (0-299)
+
+  tb->run(300);
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_data,     tb->completions_match(accesses, data));
+  tb->check(COND_ordering, !tb->mixed);
+
+  //`````````````````````````````````
+  //      Formal Checks
+
+  CHECK("tb_axi_bridge.ordering.01",
+      tb->conditions[COND_data],
+      "Failed to read the written data", tb->err_cycles[COND_data]);
+
+  CHECK("tb_axi_bridge.ordering.02",
+      tb->conditions[COND_ordering],
+      "Failed to complete the transactions before issuing the other type", tb->err_cycles[COND_ordering]);
+}
+
+void tb_axi_bridge_byte_lanes(TB_Axi_bridge * tb) {
+  Vtb_axi_bridge * core = tb->core;
+  core->testcase = T_BYTE_LANES;
+
+  // The following actions are performed in this test :
+  //    tick 0. Issue byte and halfword writes and reads at every offset
+  //    tick 1-199. Nothing
+
+  //=================================
+  //      Tick (0)
+
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  std::vector<Access> accesses;
+  std::vector<uint32_t> data;
+  uint32_t base = (rand() % 256) * 4;
+  for(uint32_t offset = 0; offset < 4; offset++) {
+    uint32_t dat = rand() & 0xFF;
+    accesses.push_back({true, base + offset, dat, 0x1});
+    data.push_back(0);
+    accesses.push_back({false, base + offset, 0, 0x1});
+    data.push_back(dat);
+  }
+  for(uint32_t offset = 0; offset < 4; offset += 2) {
+    uint32_t dat = rand() & 0xFFFF;
+    accesses.push_back({true, base + offset, dat, 0x3});
+    data.push_back(0);
+    accesses.push_back({false, base + offset, 0, 0x3});
+    data.push_back(dat);
+  }
+  for(const Access & access : accesses) {
+    tb->queue.push_back(access);
+  }
+
+  //=================================
+  //      Tick (0-199)
+
+  tb->run(200);
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_data, tb->completions_match(accesses, data));
+  std::vector<Access> writes;
+  for(const Access & access : accesses) {
+    if(access.we) {
+      writes.push_back(access);
+    }
+  }
+  tb->check(COND_axi, (tb->aw_transfers.size() == writes.size()) &&
+                      (tb->w_transfers.size() == writes.size()));
+  for(uint32_t i = 0; i < writes.size() && i < tb->aw_transfers.size() && i < tb->w_transfers.size(); i++) {
+    uint32_t offset = writes[i].adr & 3;
+    tb->check(COND_axi, (tb->aw_transfers[i].addr == writes[i].adr) &&
+                        (tb->aw_transfers[i].size == ((writes[i].sel == 0x1) ? 0 : 1)) &&
+                        (tb->w_transfers[i].strb == (writes[i].sel << offset)) &&
+                        ((tb->w_transfers[i].data >> (8 * offset)) & ((writes[i].sel == 0x1) ? 0xFF : 0xFFFF))
+                            == writes[i].dat);
+  }
+
+  //`````````````````````````````````
+  //      Formal Checks
+
+  CHECK("tb_axi_bridge.byte_lanes.01",
+      tb->conditions[COND_data],
+      "Failed to align the data on the byte lanes", tb->err_cycles[COND_data]);
+
+  CHECK("tb_axi_bridge.byte_lanes.02",
+      tb->conditions[COND_axi],
+      "Failed to select the byte lanes of the transfers", tb->err_cycles[COND_axi]);
+}
+
+void tb_axi_bridge_memory_wait(TB_Axi_bridge * tb) {
+  Vtb_axi_bridge * core = tb->core;
+  core->testcase = T_MEMORY_WAIT;
+
+  // The following actions are performed in this test :
+  //    tick 0. Issue random accesses on a slow memory with random readiness
+  //    tick 1-1999. Nothing
+
+  //=================================
+  //      Tick (0)
+
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  tb->latency = rand() % 8;
+  tb->random_ready = true;
+  const uint32_t count = 64;
+  std::vector<Access> accesses;
+  for(uint32_t i = 0; i < count; i++) {
+    accesses.push_back(TB_Axi_bridge::random_access());
+    tb->queue.push_back(accesses.back());
+  }
+
+  //=================================
+  //      Tick (0-1999)
+
+  tb->run(2000);
+
+  //`````````````````````````````````
+  //      Checks
+
+  // Replay the accesses in order to compute the expected read data
+  std::map<uint32_t, uint8_t> written = tb->written;
+  tb->written.clear();
+  std::vector<uint32_t> data;
+  for(const Access & access : accesses) {
+    if(access.we) {
+      for(int i = 0; i < 4; i++) {
+        if(access.sel & (1 << i)) {
+          tb->written[access.adr + i] = (access.dat >> (8 * i)) & 0xFF;
+        }
+      }
+      data.push_back(0);
+    } else {
+      data.push_back(tb->expected(access));
+    }
+  }
+  tb->check(COND_data,        tb->completions_match(accesses, data) && (written == tb->written));
+  tb->check(COND_ordering,    !tb->mixed);
+  tb->check(COND_outstanding, (tb->max_in_flight <= core->tb_axi_bridge->OUTSTANDING_DEPTH));
+
+  //`````````````````````````````````
+  //      Formal Checks
+
+  CHECK("tb_axi_bridge.memory_wait.01",
+      tb->conditions[COND_data],
+      "Failed to perform the accesses in order", tb->err_cycles[COND_data]);
+
+  CHECK("tb_axi_bridge.memory_wait.02",
+      tb->conditions[COND_ordering],
+      "Failed to complete the transactions before issuing the other type", tb->err_cycles[COND_ordering]);
+
+  CHECK("tb_axi_bridge.memory_wait.03",
+      tb->conditions[COND_outstanding],
+      "Failed to limit the number of transactions in flight", tb->err_cycles[COND_outstanding]);
+}
+
+int main(int argc, char ** argv, char ** env) {
+  srand(time(NULL));
+  Verilated::traceEverOn(true);
+
+  bool verbose = parse_verbose(argc, argv);
+
+  TB_Axi_bridge * tb = new TB_Axi_bridge;
+  tb->open_trace("waves/axi_bridge.vcd");
+  tb->open_testdata("testdata/axi_bridge.csv");
+  tb->set_debug_log(verbose);
+  tb->init_conditions(__CondIdEnd);
+
+  /************************************************************/
+
+  tb_axi_bridge_reset(tb);
+
+  tb_axi_bridge_read(tb);
+  tb_axi_bridge_write(tb);
+  tb_axi_bridge_ordering(tb);
+  tb_axi_bridge_byte_lanes(tb);
+
+  tb_axi_bridge_memory_wait(tb);
+
+  /************************************************************/
+
+  printf("[AXI_BRIDGE]: ");
+  if(tb->success) {
+    printf("Done\n");
+  } else {
+    printf("Failed\n");
+  }
+
+  delete tb;
+  exit(EXIT_SUCCESS);
+}
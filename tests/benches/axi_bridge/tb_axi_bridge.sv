@@ -0,0 +1,124 @@
+/*           __        _
+ *  ________/ /  ___ _(_)__  ___
+ * / __/ __/ _ \/ _ `/ / _ \/ -_)
+ * \__/\__/_//_/\_,_/_/_//_/\__/
+ * 
+ * Copyright (C) Clément Chaine
+ * This file is part of ECAP5-DPROC <https://github.com/ecap5/ECAP5-DPROC>
+ *
+ * ECAP5-DPROC is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ECAP5-DPROC is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ECAP5-DPROC.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+module tb_axi_bridge
+(
+  input   int          testcase,
+
+  input   logic        clk_i,
+  input   logic        rst_i,
+
+  //=================================
+  //    Slave port
+
+  input   logic[31:0]  s_wb_adr_i,
+  output  logic[31:0]  s_wb_dat_o,
+  input   logic[31:0]  s_wb_dat_i,
+  input   logic        s_wb_we_i,
+  input   logic[3:0]   s_wb_sel_i,
+  input   logic        s_wb_stb_i,
+  output  logic        s_wb_ack_o,
+  input   logic        s_wb_cyc_i,
+  output  logic        s_wb_stall_o,
+
+  //=================================
+  //    Master port
+
+  output  logic[31:0]  m_axi_awaddr_o,
+  output  logic[7:0]   m_axi_awlen_o,
+  output  logic[2:0]   m_axi_awsize_o,
+  output  logic[1:0]   m_axi_awburst_o,
+  output  logic        m_axi_awvalid_o,
+  input   logic        m_axi_awready_i,
+
+  output  logic[31:0]  m_axi_wdata_o,
+  output  logic[3:0]   m_axi_wstrb_o,
+  output  logic        m_axi_wlast_o,
+  output  logic        m_axi_wvalid_o,
+  input   logic        m_axi_wready_i,
+
+  input   logic[1:0]   m_axi_bresp_i,
+  input   logic        m_axi_bvalid_i,
+  output  logic        m_axi_bready_o,
+
+  output  logic[31:0]  m_axi_araddr_o,
+  output  logic[7:0]   m_axi_arlen_o,
+  output  logic[2:0]   m_axi_arsize_o,
+  output  logic[1:0]   m_axi_arburst_o,
+  output  logic        m_axi_arvalid_o,
+  input   logic        m_axi_arready_i,
+
+  input   logic[31:0]  m_axi_rdata_i,
+  input   logic[1:0]   m_axi_rresp_i,
+  input   logic        m_axi_rlast_i,
+  input   logic        m_axi_rvalid_i,
+  output  logic        m_axi_rready_o
+);
+
+localparam int OUTSTANDING_DEPTH = 4;
+
+axi_bridge #(
+  .OUTSTANDING_DEPTH (OUTSTANDING_DEPTH)
+) dut (
+  .clk_i           (clk_i),
+  .rst_i           (rst_i),
+  .s_wb_adr_i      (s_wb_adr_i),
+  .s_wb_dat_o      (s_wb_dat_o),
+  .s_wb_dat_i      (s_wb_dat_i),
+  .s_wb_we_i       (s_wb_we_i),
+  .s_wb_sel_i      (s_wb_sel_i),
+  .s_wb_stb_i      (s_wb_stb_i),
+  .s_wb_ack_o      (s_wb_ack_o),
+  .s_wb_cyc_i      (s_wb_cyc_i),
+  .s_wb_stall_o    (s_wb_stall_o),
+  .m_axi_awaddr_o  (m_axi_awaddr_o),
+  .m_axi_awlen_o   (m_axi_awlen_o),
+  .m_axi_awsize_o  (m_axi_awsize_o),
+  .m_axi_awburst_o (m_axi_awburst_o),
+  .m_axi_awvalid_o (m_axi_awvalid_o),
+  .m_axi_awready_i (m_axi_awready_i),
+  .m_axi_wdata_o   (m_axi_wdata_o),
+  .m_axi_wstrb_o   (m_axi_wstrb_o),
+  .m_axi_wlast_o   (m_axi_wlast_o),
+  .m_axi_wvalid_o  (m_axi_wvalid_o),
+  .m_axi_wready_i  (m_axi_wready_i),
+  .m_axi_bresp_i   (m_axi_bresp_i),
+  .m_axi_bvalid_i  (m_axi_bvalid_i),
+  .m_axi_bready_o  (m_axi_bready_o),
+  .m_axi_araddr_o  (m_axi_araddr_o),
+  .m_axi_arlen_o   (m_axi_arlen_o),
+  .m_axi_arsize_o  (m_axi_arsize_o),
+  .m_axi_arburst_o (m_axi_arburst_o),
+  .m_axi_arvalid_o (m_axi_arvalid_o),
+  .m_axi_arready_i (m_axi_arready_i),
+  .m_axi_rdata_i   (m_axi_rdata_i),
+  .m_axi_rresp_i   (m_axi_rresp_i),
+  .m_axi_rlast_i   (m_axi_rlast_i),
+  .m_axi_rvalid_i  (m_axi_rvalid_i),
+  .m_axi_rready_o  (m_axi_rready_o)
+);
+
+endmodule // tb_axi_bridge
+
+`verilator_config
+
+public -module "tb_axi_bridge" -var "OUTSTANDING_DEPTH"
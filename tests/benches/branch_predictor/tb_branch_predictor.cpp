@@ -0,0 +1,378 @@
+/*           __        _
+ *  ________/ /  ___ _(_)__  ___
+ * / __/ __/ _ \/ _ `/ / _ \/ -_)
+ * \__/\__/_//_/\_,_/_/_//_/\__/
+ *
+ * Copyright (C) Clément Chaine
+ * This file is part of ECAP5-DPROC <https://github.com/ecap5/ECAP5-DPROC>
+ *
+ * ECAP5-DPROC is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ECAP5-DPROC is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ECAP5-DPROC.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <verilated.h>
+#include <verilated_vcd_c.h>
+#include <svdpi.h>
+
+#include "Vtb_branch_predictor.h"
+#include "testbench.h"
+#include "Vtb_branch_predictor_ecap5_dproc_pkg.h"
+#include "Vtb_branch_predictor_tb_branch_predictor.h"
+
+enum CondId {
+  COND_lookup,
+  COND_counters,
+  __CondIdEnd
+};
+
+enum TestcaseId {
+  T_RESET          =  1,
+  T_ALLOCATION     =  2,
+  T_TRAINING       =  3,
+  T_ASSOCIATIVITY  =  4,
+  T_COUNTERS       =  5
+};
+
+class TB_Branch_predictor : public Testbench<Vtb_branch_predictor> {
+public:
+  void reset() {
+    this->_nop();
+
+    this->core->rst_i = 1;
+    for(int i = 0; i < 5; i++) {
+      this->tick();
+    }
+    this->core->rst_i = 0;
+
+    Testbench<Vtb_branch_predictor>::reset();
+  }
+
+  void _nop() {
+    this->core->lookup_pc_i = 0;
+    this->core->update_i = 0;
+    this->core->update_pc_i = 0;
+    this->core->update_taken_i = 0;
+    this->core->update_target_i = 0;
+    this->core->update_mispredict_i = 0;
+  }
+
+  // Trains the branch predictor with the outcome of a branch
+  void update(uint32_t pc, bool taken, uint32_t target, bool mispredict) {
+    this->core->update_i = 1;
+    this->core->update_pc_i = pc;
+    this->core->update_taken_i = taken;
+    this->core->update_target_i = target;
+    this->core->update_mispredict_i = mispredict;
+    this->tick();
+    this->core->update_i = 0;
+  }
+
+  void lookup(uint32_t pc) {
+    this->core->lookup_pc_i = pc;
+    // this change is asynchronous
+    this->core->eval();
+  }
+};
+
+void tb_branch_predictor_reset(TB_Branch_predictor * tb) {
+  Vtb_branch_predictor * core = tb->core;
+  core->testcase = T_RESET;
+
+  //=================================
+  //      Tick (0)
+
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->lookup(rand() & ~0x3);
+  tb->check(COND_lookup,    (core->lookup_hit_o    ==  0)  &&
+                            (core->lookup_taken_o  ==  0));
+  tb->check(COND_counters,  (core->tb_branch_predictor->branch_count_q      ==  0)  &&
+                            (core->tb_branch_predictor->hit_count_q         ==  0)  &&
+                            (core->tb_branch_predictor->mispredict_count_q  ==  0));
+
+  //`````````````````````````````````
+  //      Formal Checks
+
+  CHECK("tb_branch_predictor.reset.01",
+      tb->conditions[COND_lookup],
+      "Failed to reset the branch target buffer", tb->err_cycles[COND_lookup]);
+
+  CHECK("tb_branch_predictor.reset.02",
+      tb->conditions[COND_counters],
+      "Failed to reset the performance counters", tb->err_cycles[COND_counters]);
+}
+
+void tb_branch_predictor_allocation(TB_Branch_predictor * tb) {
+  Vtb_branch_predictor * core = tb->core;
+  core->testcase = T_ALLOCATION;
+
+  // The following actions are performed in this test :
+  //    tick 0. Update with a taken branch
+  //    tick 1. Update with a not taken branch (core allocates the taken branch)
+  //    tick 2. Nothing (core does not allocate the not taken branch)
+
+  //=================================
+  //      Tick (0)
+
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  uint32_t taken_pc = 0x1000;
+  uint32_t not_taken_pc = 0x1004;
+  uint32_t target = (rand() & ~0x3);
+
+  //=================================
+  //      Tick (1)
+
+  tb->update(taken_pc, 1, target, 1);
+
+  //=================================
+  //      Tick (2)
+
+  tb->update(not_taken_pc, 0, target + 4, 0);
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->lookup(taken_pc);
+  tb->check(COND_lookup,    (core->lookup_hit_o     ==  1)  &&
+                            (core->lookup_taken_o   ==  1)  &&
+                            (core->lookup_target_o  ==  target));
+
+  tb->lookup(not_taken_pc);
+  tb->check(COND_lookup,    (core->lookup_hit_o     ==  0)  &&
+                            (core->lookup_taken_o   ==  0));
+
+  //`````````````````````````````````
+  //      Formal Checks
+
+  CHECK("tb_branch_predictor.allocation.01",
+      tb->conditions[COND_lookup],
+      "Failed to allocate the taken branches only", tb->err_cycles[COND_lookup]);
+}
+
+void tb_branch_predictor_training(TB_Branch_predictor * tb) {
+  Vtb_branch_predictor * core = tb->core;
+  core->testcase = T_TRAINING;
+
+  // The following actions are performed in this test :
+  //    tick 0-1. Update with a taken branch twice
+  //    tick 2. Update with the branch not taken (core still predicts taken)
+  //    tick 3. Update with the branch not taken (core predicts not taken)
+  //    tick 4. Update with the branch taken (core predicts taken)
+
+  //=================================
+  //      Tick (0)
+
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  uint32_t pc = 0x2000;
+  uint32_t target = 0x1F00;
+
+  //=================================
+  //      Tick (0-1)
+
+  tb->update(pc, 1, target, 1);
+  tb->update(pc, 1, target, 0);
+
+  //=================================
+  //      Tick (2)
+
+  tb->update(pc, 0, target, 1);
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->lookup(pc);
+  tb->check(COND_lookup,    (core->lookup_hit_o     ==  1)  &&
+                            (core->lookup_taken_o   ==  1));
+
+  //=================================
+  //      Tick (3)
+
+  tb->update(pc, 0, target, 1);
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->lookup(pc);
+  tb->check(COND_lookup,    (core->lookup_hit_o     ==  1)  &&
+                            (core->lookup_taken_o   ==  0)  &&
+                            (core->lookup_target_o  ==  target));
+
+  //=================================
+  //      Tick (4)
+
+  tb->update(pc, 1, target, 1);
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->lookup(pc);
+  tb->check(COND_lookup,    (core->lookup_hit_o     ==  1)  &&
+                            (core->lookup_taken_o   ==  1));
+
+  //`````````````````````````````````
+  //      Formal Checks
+
+  CHECK("tb_branch_predictor.training.01",
+      tb->conditions[COND_lookup],
+      "Failed to implement the two-bit saturating counters", tb->err_cycles[COND_lookup]);
+}
+
+void tb_branch_predictor_associativity(TB_Branch_predictor * tb) {
+  Vtb_branch_predictor * core = tb->core;
+  core->testcase = T_ASSOCIATIVITY;
+
+  // The following actions are performed in this test :
+  //    tick 0-1. Update with two taken branches of the same set
+  //    tick 2. Update with a third taken branch of the same set (core evicts the first one)
+
+  //=================================
+  //      Tick (0)
+
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  // The three branches are mapped to the same set
+  uint32_t sets = core->tb_branch_predictor->ENTRIES / core->tb_branch_predictor->WAYS;
+  uint32_t pc1 = 0x3000;
+  uint32_t pc2 = pc1 + 4 * sets;
+  uint32_t pc3 = pc2 + 4 * sets;
+
+  //=================================
+  //      Tick (0-1)
+
+  tb->update(pc1, 1, 0x100, 1);
+  tb->update(pc2, 1, 0x200, 1);
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->lookup(pc1);
+  tb->check(COND_lookup,    (core->lookup_hit_o     ==  1)  &&
+                            (core->lookup_target_o  ==  0x100));
+  tb->lookup(pc2);
+  tb->check(COND_lookup,    (core->lookup_hit_o     ==  1)  &&
+                            (core->lookup_target_o  ==  0x200));
+
+  //=================================
+  //      Tick (2)
+
+  tb->update(pc3, 1, 0x300, 1);
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->lookup(pc1);
+  tb->check(COND_lookup,    (core->lookup_hit_o     ==  0));
+  tb->lookup(pc2);
+  tb->check(COND_lookup,    (core->lookup_hit_o     ==  1)  &&
+                            (core->lookup_target_o  ==  0x200));
+  tb->lookup(pc3);
+  tb->check(COND_lookup,    (core->lookup_hit_o     ==  1)  &&
+                            (core->lookup_target_o  ==  0x300));
+
+  //`````````````````````````````````
+  //      Formal Checks
+
+  CHECK("tb_branch_predictor.associativity.01",
+      tb->conditions[COND_lookup],
+      "Failed to implement the set associativity", tb->err_cycles[COND_lookup]);
+}
+
+void tb_branch_predictor_counters(TB_Branch_predictor * tb) {
+  Vtb_branch_predictor * core = tb->core;
+  core->testcase = T_COUNTERS;
+
+  // The following actions are performed in this test :
+  //    tick 0-9. Update with a branch taken then not taken
+
+  //=================================
+  //      Tick (0)
+
+  tb->reset();
+
+  //=================================
+  //      Tick (0-9)
+
+  uint32_t mispredictions = 0;
+  for(int i = 0; i < 10; i++) {
+    bool mispredict = rand() % 2;
+    mispredictions += mispredict;
+    tb->update(0x4000, i < 5, 0x4100, mispredict);
+  }
+
+  //`````````````````````````````````
+  //      Checks
+
+  // The branch is only allocated after the first update
+  tb->check(COND_counters,  (core->tb_branch_predictor->branch_count_q      ==  10)  &&
+                            (core->tb_branch_predictor->hit_count_q         ==  9)   &&
+                            (core->tb_branch_predictor->mispredict_count_q  ==  mispredictions));
+
+  //`````````````````````````````````
+  //      Formal Checks
+
+  CHECK("tb_branch_predictor.counters.01",
+      tb->conditions[COND_counters],
+      "Failed to implement the performance counters", tb->err_cycles[COND_counters]);
+}
+
+int main(int argc, char ** argv, char ** env) {
+  srand(time(NULL));
+  Verilated::traceEverOn(true);
+
+  bool verbose = parse_verbose(argc, argv);
+
+  TB_Branch_predictor * tb = new TB_Branch_predictor;
+  tb->open_trace("waves/branch_predictor.vcd");
+  tb->open_testdata("testdata/branch_predictor.csv");
+  tb->set_debug_log(verbose);
+  tb->init_conditions(__CondIdEnd);
+
+  /************************************************************/
+
+  tb_branch_predictor_reset(tb);
+
+  tb_branch_predictor_allocation(tb);
+  tb_branch_predictor_training(tb);
+  tb_branch_predictor_associativity(tb);
+
+  tb_branch_predictor_counters(tb);
+
+  /************************************************************/
+
+  printf("[BRANCH_PREDICTOR]: ");
+  if(tb->success) {
+    printf("Done\n");
+  } else {
+    printf("Failed\n");
+  }
+
+  delete tb;
+  exit(EXIT_SUCCESS);
+}
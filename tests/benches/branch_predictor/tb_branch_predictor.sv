@@ -0,0 +1,77 @@
+/*           __        _
+ *  ________/ /  ___ _(_)__  ___
+ * / __/ __/ _ \/ _ `/ / _ \/ -_)
+ * \__/\__/_//_/\_,_/_/_//_/\__/
+ * 
+ * Copyright (C) Clément Chaine
+ * This file is part of ECAP5-DPROC <https://github.com/ecap5/ECAP5-DPROC>
+ *
+ * ECAP5-DPROC is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ECAP5-DPROC is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ECAP5-DPROC.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+module tb_branch_predictor (
+  input   int          testcase,
+
+  input   logic        clk_i,
+  input   logic        rst_i,
+  // Lookup interface
+  input   logic[31:0]  lookup_pc_i,
+  output  logic        lookup_hit_o,
+  output  logic        lookup_taken_o,
+  output  logic[31:0]  lookup_target_o,
+  // Update interface
+  input   logic        update_i,
+  input   logic[31:0]  update_pc_i,
+  input   logic        update_taken_i,
+  input   logic[31:0]  update_target_i,
+  input   logic        update_mispredict_i
+);
+
+localparam int ENTRIES = 4;
+localparam int WAYS    = 2;
+
+// Performance counters of the parameterized branch predictor
+logic[31:0]  branch_count_q, hit_count_q, mispredict_count_q;
+
+branch_predictor #(
+  .ENTRIES              (ENTRIES),
+  .WAYS                 (WAYS),
+  .HISTORY_LENGTH       (0)
+) dut (
+  .clk_i                (clk_i),
+  .rst_i                (rst_i),
+  .lookup_pc_i          (lookup_pc_i),
+  .lookup_hit_o         (lookup_hit_o),
+  .lookup_taken_o       (lookup_taken_o),
+  .lookup_target_o      (lookup_target_o),
+  .update_i             (update_i),
+  .update_pc_i          (update_pc_i),
+  .update_taken_i       (update_taken_i),
+  .update_target_i      (update_target_i),
+  .update_mispredict_i  (update_mispredict_i)
+);
+
+assign branch_count_q     = dut.branch_count_q;
+assign hit_count_q        = dut.hit_count_q;
+assign mispredict_count_q = dut.mispredict_count_q;
+
+endmodule // tb_branch_predictor
+
+`verilator_config
+
+public -module "tb_branch_predictor" -var "ENTRIES"
+public -module "tb_branch_predictor" -var "WAYS"
+public -module "tb_branch_predictor" -var "branch_count_q"
+public -module "tb_branch_predictor" -var "hit_count_q"
+public -module "tb_branch_predictor" -var "mispredict_count_q"
@@ -0,0 +1,771 @@
+/*           __        _
+ *  ________/ /  ___ _(_)__  ___
+ * / __/ __/ _ \/ _ `/ / _ \/ -_)
+ * \__/\__/_//_/\_,_/_/_//_/\__/
+ *
+ * Copyright (C) Clément Chaine
+ * This file is part of ECAP5-DPROC <https://github.com/ecap5/ECAP5-DPROC>
+ *
+ * ECAP5-DPROC is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ECAP5-DPROC is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ECAP5-DPROC.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <verilated.h>
+#include <verilated_vcd_c.h>
+#include <svdpi.h>
+#include <deque>
+#include <map>
+#include <vector>
+
+#include "Vtb_dcache.h"
+#include "testbench.h"
+#include "wishbone_slave.h"
+#include "Vtb_dcache_tb_dcache.h"
+#include "Vtb_dcache_ecap5_dproc_pkg.h"
+
+enum CondId {
+  COND_slave,
+  COND_master,
+  COND_data,
+  COND_memory,
+  COND_counters,
+  COND_burst,
+  __CondIdEnd
+};
+
+enum TestcaseId {
+  T_RESET        =  1,
+  T_LOAD_MISS    =  2,
+  T_STORE_HIT    =  3,
+  T_WRITEBACK    =  4,
+  T_UNCACHED     =  5,
+  T_MEMORY_WAIT  =  6,
+  T_BURST        =  7,
+  T_LRU          =  8
+};
+
+struct Access {
+  bool we;
+  uint32_t adr;
+  uint8_t sel;
+  uint32_t dat;
+};
+
+struct Response {
+  uint32_t cycle;
+  uint32_t dat;
+  uint32_t expected;
+};
+
+// Byte-addressed memory with right-aligned data, unwritten words holding a
+// value derived from their address
+class Memory {
+public:
+  std::map<uint32_t, uint32_t> words;
+
+  static uint32_t initial(uint32_t adr) {
+    return (adr * 2654435761u) ^ 0xECA50000;
+  }
+
+  static uint32_t mask(uint8_t sel) {
+    switch(sel) {
+      case 0x1: return 0xFF;
+      case 0x3: return 0xFFFF;
+      default:  return 0xFFFFFFFF;
+    }
+  }
+
+  uint32_t word(uint32_t adr) {
+    auto it = this->words.find(adr & ~0x3);
+    return (it == this->words.end()) ? initial(adr & ~0x3) : it->second;
+  }
+
+  uint32_t read(uint32_t adr, uint8_t sel) {
+    return (this->word(adr) >> (8 * (adr & 0x3))) & mask(sel);
+  }
+
+  void write(uint32_t adr, uint8_t sel, uint32_t dat) {
+    uint32_t shift = 8 * (adr & 0x3);
+    uint32_t m = mask(sel) << shift;
+    this->words[adr & ~0x3] = (this->word(adr) & ~m) | ((dat << shift) & m);
+  }
+};
+
+class TB_Dcache : public Testbench<Vtb_dcache> {
+public:
+  // Pipelined wishbone slave model of the memory
+  WishboneSlave<Access> slave;
+  uint32_t cycle;
+  Memory memory;
+  // Requests performed by the cache to the memory
+  std::vector<Access> transfers;
+  // Cycle type identifiers and burst type extensions of the requests
+  std::vector<uint8_t> transfers_cti;
+  std::vector<uint8_t> transfers_bte;
+  // Wishbone master model of the loadstore module, performing one access at
+  // a time
+  std::deque<Access> pending;
+  // Reference memory updated as the accesses are acknowledged
+  Memory reference;
+  // Responses received from the cache for loads
+  std::vector<Response> responses;
+
+  void reset() {
+    this->core->s_wb_adr_i = 0;
+    this->core->s_wb_dat_i = 0;
+    this->core->s_wb_we_i = 0;
+    this->core->s_wb_sel_i = 0;
+    this->core->s_wb_stb_i = 0;
+    this->core->s_wb_cyc_i = 0;
+    this->core->m_wb_dat_i = 0;
+    this->core->m_wb_ack_i = 0;
+    this->core->m_wb_stall_i = 0;
+
+    this->slave.latency = 0;
+    this->slave.random_stall = false;
+    this->cycle = 0;
+    this->pending.clear();
+
+    this->core->rst_i = 1;
+    for(int i = 0; i < 5; i++) {
+      this->tick();
+    }
+    this->core->rst_i = 0;
+
+    this->memory.words.clear();
+    this->reference.words.clear();
+    this->slave.clear();
+    this->transfers.clear();
+    this->transfers_cti.clear();
+    this->transfers_bte.clear();
+    this->responses.clear();
+
+    Testbench<Vtb_dcache>::reset();
+  }
+
+  void tick() {
+    // Requests of the loadstore module model
+    if(!this->core->s_wb_cyc_i && !this->pending.empty()) {
+      Access access = this->pending.front();
+      this->pending.pop_front();
+      this->core->s_wb_we_i = access.we;
+      this->core->s_wb_adr_i = access.adr;
+      this->core->s_wb_sel_i = access.sel;
+      this->core->s_wb_dat_i = access.dat;
+      this->core->s_wb_stb_i = 1;
+      this->core->s_wb_cyc_i = 1;
+    }
+
+    Access request = {(bool)this->core->m_wb_we_o, this->core->m_wb_adr_o,
+                      this->core->m_wb_sel_o, this->core->m_wb_dat_o};
+    if(this->slave.accept(this->cycle, this->core->m_wb_stb_o, this->core->m_wb_cyc_o, this->core->m_wb_stall_i,
+                          request)) {
+      this->transfers.push_back(request);
+      this->transfers_cti.push_back(this->core->m_wb_cti_o);
+      this->transfers_bte.push_back(this->core->m_wb_bte_o);
+      if(request.we) {
+        this->memory.write(request.adr, request.sel, request.dat);
+      }
+    }
+    this->core->m_wb_ack_i = 0;
+    this->core->m_wb_dat_i = 0;
+    Access access;
+    if(this->slave.respond(this->cycle, access)) {
+      this->core->m_wb_ack_i = 1;
+      if(!access.we) {
+        this->core->m_wb_dat_i = this->memory.read(access.adr, access.sel);
+      }
+    }
+
+    this->core->eval();
+    bool accepted = this->core->s_wb_stb_i && !this->core->s_wb_stall_o;
+    bool acknowledged = this->core->s_wb_cyc_i && this->core->s_wb_ack_o;
+    if(acknowledged) {
+      if(this->core->s_wb_we_i) {
+        this->reference.write(this->core->s_wb_adr_i, this->core->s_wb_sel_i, this->core->s_wb_dat_i);
+      } else {
+        this->responses.push_back({this->cycle, this->core->s_wb_dat_o,
+                                   this->reference.read(this->core->s_wb_adr_i, this->core->s_wb_sel_i)});
+      }
+    }
+
+    Testbench<Vtb_dcache>::tick();
+    this->cycle += 1;
+
+    if(accepted) {
+      this->core->s_wb_stb_i = 0;
+    }
+    if(acknowledged) {
+      this->core->s_wb_cyc_i = 0;
+    }
+    this->core->m_wb_stall_i = this->slave.stall();
+  }
+
+  void run(uint32_t cycles) {
+    for(uint32_t i = 0; i < cycles; i++) {
+      this->tick();
+    }
+  }
+
+  void load(uint32_t adr, uint8_t sel) {
+    this->pending.push_back({false, adr, sel, 0});
+  }
+
+  void store(uint32_t adr, uint8_t sel, uint32_t dat) {
+    this->pending.push_back({true, adr, sel, dat});
+  }
+
+  // Checks that every load responded with the data of the reference memory
+  bool responses_match(size_t count) {
+    if(this->responses.size() != count) {
+      return false;
+    }
+    for(size_t i = 0; i < this->responses.size(); i++) {
+      if(this->responses[i].dat != this->responses[i].expected) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  size_t write_count() {
+    size_t count = 0;
+    for(size_t i = 0; i < this->transfers.size(); i++) {
+      count += this->transfers[i].we;
+    }
+    return count;
+  }
+};
+
+void tb_dcache_reset(TB_Dcache * tb) {
+  Vtb_dcache * core = tb->core;
+  core->testcase = T_RESET;
+
+  //=================================
+  //      Tick (0)
+
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_slave,     (core->s_wb_ack_o    ==  0)  &&
+                            (core->s_wb_stall_o  ==  0));
+  tb->check(COND_master,    (core->m_wb_stb_o    ==  0)  &&
+                            (core->m_wb_cyc_o    ==  0));
+  tb->check(COND_counters,  (core->tb_dcache->hit_count_q        ==  0)  &&
+                            (core->tb_dcache->miss_count_q       ==  0)  &&
+                            (core->tb_dcache->writeback_count_q  ==  0));
+
+  //`````````````````````````````````
+  //      Formal Checks
+
+  CHECK("tb_dcache.reset.01",
+      tb->conditions[COND_slave],
+      "Failed to reset the slave port", tb->err_cycles[COND_slave]);
+
+  CHECK("tb_dcache.reset.02",
+      tb->conditions[COND_master],
+      "Failed to reset the master port", tb->err_cycles[COND_master]);
+
+  CHECK("tb_dcache.reset.03",
+      tb->conditions[COND_counters],
+      "Failed to reset the performance counters", tb->err_cycles[COND_counters]);
+}
+
+void tb_dcache_load_miss(TB_Dcache * tb) {
+  Vtb_dcache * core = tb->core;
+  core->testcase = T_LOAD_MISS;
+
+  // The following actions are performed in this test :
+  //    tick 0. Load a byte absent from the cache
+  //    tick 1-19. Nothing (core refills the line and responds)
+
+  //=================================
+  //      Tick (0)
+
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  uint32_t line_size = core->tb_dcache->LINE_SIZE;
+  uint32_t adr = rand() & 0x7FFFFFFF;
+  uint32_t line = adr & ~(line_size - 1);
+  tb->load(adr, 0x1);
+
+  //=================================
+  //      Tick (1-19)
+
+  tb->run(20);
+
+  //`````````````````````````````````
+  //      Checks
+
+  // The whole line is read from its first word
+  tb->check(COND_master,    (tb->transfers.size() == line_size / 4));
+  for(size_t i = 0; i < tb->transfers.size(); i++) {
+    tb->check(COND_master,  (tb->transfers[i].we == 0) &&
+                            (tb->transfers[i].adr == line + 4 * i) &&
+                            (tb->transfers[i].sel == 0xF));
+  }
+  tb->check(COND_master,    (core->m_wb_cyc_o == 0));
+  tb->check(COND_data,      tb->responses_match(1));
+  tb->check(COND_counters,  (core->tb_dcache->hit_count_q        ==  0)  &&
+                            (core->tb_dcache->miss_count_q       ==  1)  &&
+                            (core->tb_dcache->writeback_count_q  ==  0));
+
+  //`````````````````````````````````
+  //      Formal Checks
+
+  CHECK("tb_dcache.load_miss.01",
+      tb->conditions[COND_master],
+      "Failed to refill the whole line", tb->err_cycles[COND_master]);
+
+  CHECK("tb_dcache.load_miss.02",
+      tb->conditions[COND_data],
+      "Failed to respond with the requested byte", tb->err_cycles[COND_data]);
+
+  CHECK("tb_dcache.load_miss.03",
+      tb->conditions[COND_counters],
+      "Failed to count the miss", tb->err_cycles[COND_counters]);
+}
+
+void tb_dcache_store_hit(TB_Dcache * tb) {
+  Vtb_dcache * core = tb->core;
+  core->testcase = T_STORE_HIT;
+
+  // The following actions are performed in this test :
+  //    tick 0. Store a word absent from the cache
+  //    tick 1-19. Nothing (core allocates the line)
+  //    tick 20. Store a byte and a halfword in the line, then load the
+  //             merged word back with every access size
+  //    tick 21-39. Nothing (core responds from the cache)
+
+  //=================================
+  //      Tick (0)
+
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  uint32_t line_size = core->tb_dcache->LINE_SIZE;
+  uint32_t line = rand() & 0x7FFFFFFF & ~(line_size - 1);
+  tb->store(line + 4, 0xF, rand());
+
+  //=================================
+  //      Tick (1-19)
+
+  tb->run(20);
+
+  //`````````````````````````````````
+  //      Checks
+
+  // The line is allocated without writing the word to memory
+  tb->check(COND_master,    (tb->transfers.size() == line_size / 4) &&
+                            (tb->write_count() == 0));
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  tb->transfers.clear();
+  tb->store(line + 4 + (rand() % 4), 0x1, rand());
+  tb->store(line + 8 + 2 * (rand() % 2), 0x3, rand());
+  tb->load(line + 4, 0xF);
+  tb->load(line + 8, 0xF);
+  tb->load(line + 4 + (rand() % 4), 0x1);
+  tb->load(line + 8 + 2 * (rand() % 2), 0x3);
+
+  //=================================
+  //      Tick (20-39)
+
+  tb->run(20);
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_master,    (tb->transfers.size() == 0));
+  tb->check(COND_data,      tb->responses_match(4));
+  tb->check(COND_counters,  (core->tb_dcache->hit_count_q        ==  6)  &&
+                            (core->tb_dcache->miss_count_q       ==  1)  &&
+                            (core->tb_dcache->writeback_count_q  ==  0));
+
+  //`````````````````````````````````
+  //      Formal Checks
+
+  CHECK("tb_dcache.store_hit.01",
+      tb->conditions[COND_master],
+      "Failed to store in the cache without accessing the memory", tb->err_cycles[COND_master]);
+
+  CHECK("tb_dcache.store_hit.02",
+      tb->conditions[COND_data],
+      "Failed to merge the stored bytes", tb->err_cycles[COND_data]);
+
+  CHECK("tb_dcache.store_hit.03",
+      tb->conditions[COND_counters],
+      "Failed to count the hits", tb->err_cycles[COND_counters]);
+}
+
+void tb_dcache_writeback(TB_Dcache * tb) {
+  Vtb_dcache * core = tb->core;
+  core->testcase = T_WRITEBACK;
+
+  // The following actions are performed in this test :
+  //    tick 0. Store a byte in a line, then load as many other lines of the
+  //            same set as there are ways and the first line again
+  //    tick 1-99. Nothing (core writes the dirty line back when replaced)
+
+  //=================================
+  //      Tick (0)
+
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  uint32_t line_size = core->tb_dcache->LINE_SIZE;
+  uint32_t ways = core->tb_dcache->WAYS;
+  uint32_t sets = core->tb_dcache->SIZE / line_size / ways;
+  uint32_t a = 0x1000;
+  uint32_t adr = a + (rand() % line_size);
+  tb->store(adr, 0x1, rand());
+  for(uint32_t i = 1; i <= ways; i++) {
+    tb->load(a + i * line_size * sets, 0xF);
+  }
+  tb->load(adr, 0x1);
+
+  //=================================
+  //      Tick (1-99)
+
+  tb->run(99);
+
+  //`````````````````````````````````
+  //      Checks
+
+  // The merged line is written back once replaced as least recently used
+  std::vector<Access> writes;
+  for(size_t i = 0; i < tb->transfers.size(); i++) {
+    if(tb->transfers[i].we) {
+      writes.push_back(tb->transfers[i]);
+    }
+  }
+  tb->check(COND_memory,    (writes.size() == line_size / 4));
+  for(size_t i = 0; i < writes.size(); i++) {
+    tb->check(COND_memory,  (writes[i].adr == a + 4 * i) &&
+                            (writes[i].sel == 0xF) &&
+                            (writes[i].dat == tb->reference.word(a + 4 * i)));
+  }
+  tb->check(COND_data,      tb->responses_match(ways + 1));
+  tb->check(COND_counters,  (core->tb_dcache->hit_count_q        ==  0)  &&
+                            (core->tb_dcache->miss_count_q       ==  ways + 2)  &&
+                            (core->tb_dcache->writeback_count_q  ==  1));
+
+  //`````````````````````````````````
+  //      Formal Checks
+
+  CHECK("tb_dcache.writeback.01",
+      tb->conditions[COND_memory],
+      "Failed to write the dirty line back", tb->err_cycles[COND_memory]);
+
+  CHECK("tb_dcache.writeback.02",
+      tb->conditions[COND_data],
+      "Failed to respond with the written back data", tb->err_cycles[COND_data]);
+
+  CHECK("tb_dcache.writeback.03",
+      tb->conditions[COND_counters],
+      "Failed to count the write-back", tb->err_cycles[COND_counters]);
+}
+
+void tb_dcache_uncached(TB_Dcache * tb) {
+  Vtb_dcache * core = tb->core;
+  core->testcase = T_UNCACHED;
+
+  // The following actions are performed in this test :
+  //    tick 0. Store a byte and load a halfword twice in the uncached range
+  //    tick 1-29. Nothing (core forwards the requests)
+
+  //=================================
+  //      Tick (0)
+
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  uint32_t base = core->tb_dcache->UNCACHED_BASE;
+  std::vector<Access> accesses = {
+    {true,  base + (rand() % 4),         0x1, (uint32_t)rand()},
+    {false, base + 4 + 2 * (rand() % 2), 0x3, 0},
+    {false, base + 4 + 2 * (rand() % 2), 0x3, 0}
+  };
+  for(size_t i = 0; i < accesses.size(); i++) {
+    tb->pending.push_back(accesses[i]);
+  }
+
+  //=================================
+  //      Tick (1-29)
+
+  tb->run(29);
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_master,    (tb->transfers.size() == accesses.size()));
+  for(size_t i = 0; i < tb->transfers.size(); i++) {
+    tb->check(COND_master,  (tb->transfers[i].we == accesses[i].we) &&
+                            (tb->transfers[i].adr == accesses[i].adr) &&
+                            (tb->transfers[i].sel == accesses[i].sel) &&
+                            (!accesses[i].we || (tb->transfers[i].dat == accesses[i].dat)));
+  }
+  tb->check(COND_data,      tb->responses_match(2));
+  tb->check(COND_counters,  (core->tb_dcache->hit_count_q        ==  0)  &&
+                            (core->tb_dcache->miss_count_q       ==  0)  &&
+                            (core->tb_dcache->writeback_count_q  ==  0));
+
+  //`````````````````````````````````
+  //      Formal Checks
+
+  CHECK("tb_dcache.uncached.01",
+      tb->conditions[COND_master],
+      "Failed to forward the uncached requests", tb->err_cycles[COND_master]);
+
+  CHECK("tb_dcache.uncached.02",
+      tb->conditions[COND_data],
+      "Failed to respond with the memory data", tb->err_cycles[COND_data]);
+
+  CHECK("tb_dcache.uncached.03",
+      tb->conditions[COND_counters],
+      "Failed to bypass the cache", tb->err_cycles[COND_counters]);
+}
+
+void tb_dcache_memory_wait(TB_Dcache * tb) {
+  Vtb_dcache * core = tb->core;
+  core->testcase = T_MEMORY_WAIT;
+
+  // The following actions are performed in this test :
+  //    tick 0. Perform random accesses on a slow and stalling memory
+  //    tick 1-4999. Nothing (core serves the accesses)
+
+  //=================================
+  //      Tick (0)
+
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  tb->slave.latency = 1 + rand() % 4;
+  tb->slave.random_stall = true;
+  const uint8_t sels[3] = {0x1, 0x3, 0xF};
+  size_t loads = 0;
+  for(int i = 0; i < 64; i++) {
+    uint8_t size = rand() % 3;
+    uint32_t adr = (0x2000 + (rand() % 256)) & ~((1 << size) - 1);
+    if(rand() % 2) {
+      tb->store(adr, sels[size], rand());
+    } else {
+      tb->load(adr, sels[size]);
+      loads += 1;
+    }
+  }
+
+  //=================================
+  //      Tick (1-4999)
+
+  tb->run(4999);
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_data,      tb->responses_match(loads));
+  tb->check(COND_counters,  (core->tb_dcache->hit_count_q + core->tb_dcache->miss_count_q  ==  64));
+
+  //`````````````````````````````````
+  //      Formal Checks
+
+  CHECK("tb_dcache.memory_wait.01",
+      tb->conditions[COND_data],
+      "Failed to respond with the stored data", tb->err_cycles[COND_data]);
+
+  CHECK("tb_dcache.memory_wait.02",
+      tb->conditions[COND_counters],
+      "Failed to count the accesses", tb->err_cycles[COND_counters]);
+}
+
+void tb_dcache_burst(TB_Dcache * tb) {
+  Vtb_dcache * core = tb->core;
+  core->testcase = T_BURST;
+
+  // The following actions are performed in this test :
+  //    tick 0. Store a byte in a line, load as many other lines of the same
+  //            set as there are ways and load a word in the uncached range,
+  //            on a slow and stalling memory
+  //    tick 1-299. Nothing (core performs the write-back and refills as
+  //                incrementing bursts)
+
+  //=================================
+  //      Tick (0)
+
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  tb->slave.latency = rand() % 4;
+  tb->slave.random_stall = true;
+  uint32_t line_size = core->tb_dcache->LINE_SIZE;
+  uint32_t ways = core->tb_dcache->WAYS;
+  uint32_t sets = core->tb_dcache->SIZE / line_size / ways;
+  uint32_t a = 0x1000;
+  tb->store(a + (rand() % line_size), 0x1, rand());
+  for(uint32_t i = 1; i <= ways; i++) {
+    tb->load(a + i * line_size * sets, 0xF);
+  }
+  tb->load(core->tb_dcache->UNCACHED_BASE, 0xF);
+
+  //=================================
+  //      Tick (1-299)
+
+  tb->run(299);
+
+  //`````````````````````````````````
+  //      Checks
+
+  // The refills and the write-back, each of them ending its burst, followed
+  // by the uncached classic request
+  uint32_t words = line_size / 4;
+  tb->check(COND_burst,     (tb->transfers_cti.size() == (ways + 2) * words + 1));
+  for(size_t i = 0; i + 1 < tb->transfers_cti.size(); i++) {
+    uint8_t cti = ((i % words) == words - 1) ? Vtb_dcache_ecap5_dproc_pkg::CTI_END
+                                             : Vtb_dcache_ecap5_dproc_pkg::CTI_INCREMENTING;
+    tb->check(COND_burst,   (tb->transfers_cti[i] == cti) &&
+                            (tb->transfers_bte[i] == Vtb_dcache_ecap5_dproc_pkg::BTE_LINEAR));
+  }
+  tb->check(COND_burst,     !tb->transfers_cti.empty() &&
+                            (tb->transfers_cti.back() == Vtb_dcache_ecap5_dproc_pkg::CTI_CLASSIC));
+  tb->check(COND_data,      tb->responses_match(ways + 1));
+
+  //`````````````````````````````````
+  //      Formal Checks
+
+  CHECK("tb_dcache.burst.01",
+      tb->conditions[COND_burst],
+      "Failed to identify the write-backs and refills as incrementing bursts", tb->err_cycles[COND_burst]);
+
+  CHECK("tb_dcache.burst.02",
+      tb->conditions[COND_data],
+      "Failed to respond with the loaded data", tb->err_cycles[COND_data]);
+}
+
+void tb_dcache_lru(TB_Dcache * tb) {
+  Vtb_dcache * core = tb->core;
+  core->testcase = T_LRU;
+
+  // The following actions are performed in this test :
+  //    tick 0. Fill a set, load its first and third lines again, load a new
+  //            line of the set, then load the fourth, first, third and
+  //            second lines
+  //    tick 1-299. Nothing (core replaces the second line, which is the
+  //                least recently used)
+
+  //=================================
+  //      Tick (0)
+
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  uint32_t line_size = core->tb_dcache->LINE_SIZE;
+  uint32_t ways = core->tb_dcache->WAYS;
+  uint32_t sets = core->tb_dcache->SIZE / line_size / ways;
+  uint32_t stride = line_size * sets;
+  uint32_t a = 0x1000;
+  for(uint32_t i = 0; i < ways; i++) {
+    tb->load(a + i * stride, 0xF);
+  }
+  tb->load(a, 0xF);
+  tb->load(a + 2 * stride, 0xF);
+  tb->load(a + ways * stride, 0xF);
+  tb->load(a + 3 * stride, 0xF);
+  tb->load(a, 0xF);
+  tb->load(a + 2 * stride, 0xF);
+  tb->load(a + stride, 0xF);
+
+  //=================================
+  //      Tick (1-299)
+
+  tb->run(299);
+
+  //`````````````````````````````````
+  //      Checks
+
+  // Only the fill, the new line and the replaced second line miss
+  tb->check(COND_data,      tb->responses_match(ways + 7));
+  tb->check(COND_counters,  (core->tb_dcache->hit_count_q        ==  5)  &&
+                            (core->tb_dcache->miss_count_q       ==  ways + 2)  &&
+                            (core->tb_dcache->writeback_count_q  ==  0));
+
+  //`````````````````````````````````
+  //      Formal Checks
+
+  CHECK("tb_dcache.lru.01",
+      tb->conditions[COND_data],
+      "Failed to respond with the loaded data", tb->err_cycles[COND_data]);
+
+  CHECK("tb_dcache.lru.02",
+      tb->conditions[COND_counters],
+      "Failed to replace the least recently used line", tb->err_cycles[COND_counters]);
+}
+
+int main(int argc, char ** argv, char ** env) {
+  srand(time(NULL));
+  Verilated::traceEverOn(true);
+
+  bool verbose = parse_verbose(argc, argv);
+
+  TB_Dcache * tb = new TB_Dcache;
+  tb->open_trace("waves/dcache.vcd");
+  tb->open_testdata("testdata/dcache.csv");
+  tb->set_debug_log(verbose);
+  tb->init_conditions(__CondIdEnd);
+
+  /************************************************************/
+
+  tb_dcache_reset(tb);
+
+  tb_dcache_load_miss(tb);
+  tb_dcache_store_hit(tb);
+  tb_dcache_writeback(tb);
+  tb_dcache_uncached(tb);
+  tb_dcache_burst(tb);
+  tb_dcache_lru(tb);
+
+  tb_dcache_memory_wait(tb);
+
+  /************************************************************/
+
+  printf("[DCACHE]: ");
+  if(tb->success) {
+    printf("Done\n");
+  } else {
+    printf("Failed\n");
+  }
+
+  delete tb;
+  exit(EXIT_SUCCESS);
+}
@@ -0,0 +1,107 @@
+/*           __        _
+ *  ________/ /  ___ _(_)__  ___
+ * / __/ __/ _ \/ _ `/ / _ \/ -_)
+ * \__/\__/_//_/\_,_/_/_//_/\__/
+ * 
+ * Copyright (C) Clément Chaine
+ * This file is part of ECAP5-DPROC <https://github.com/ecap5/ECAP5-DPROC>
+ *
+ * ECAP5-DPROC is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ECAP5-DPROC is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ECAP5-DPROC.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+module tb_dcache import ecap5_dproc_pkg::*;
+(
+  input   int          testcase,
+
+  input   logic        clk_i,
+  input   logic        rst_i,
+  // Slave port
+  input   logic[31:0]  s_wb_adr_i,
+  output  logic[31:0]  s_wb_dat_o,
+  input   logic[31:0]  s_wb_dat_i,
+  input   logic        s_wb_we_i,
+  input   logic[3:0]   s_wb_sel_i,
+  input   logic        s_wb_stb_i,
+  output  logic        s_wb_ack_o,
+  input   logic        s_wb_cyc_i,
+  output  logic        s_wb_stall_o,
+  // Master port
+  output  logic[31:0]  m_wb_adr_o,
+  input   logic[31:0]  m_wb_dat_i,
+  output  logic[31:0]  m_wb_dat_o,
+  output  logic        m_wb_we_o,
+  output  logic[3:0]   m_wb_sel_o,
+  output  logic        m_wb_stb_o,
+  input   logic        m_wb_ack_i,
+  output  logic        m_wb_cyc_o,
+  input   logic        m_wb_stall_i,
+  output  logic[2:0]   m_wb_cti_o,
+  output  logic[1:0]   m_wb_bte_o
+);
+
+localparam int          SIZE           = 128;
+localparam int          LINE_SIZE      = 16;
+localparam int          WAYS           = 4;
+localparam logic[31:0]  UNCACHED_BASE  = 32'h80000000;
+localparam logic[31:0]  UNCACHED_LIMIT = 32'hFFFFFFFF;
+
+// Performance counters of the parameterized data cache
+logic[31:0]  hit_count_q, miss_count_q, writeback_count_q;
+
+dcache #(
+  .SIZE           (SIZE),
+  .LINE_SIZE      (LINE_SIZE),
+  .WAYS           (WAYS),
+  .UNCACHED_BASE  (UNCACHED_BASE),
+  .UNCACHED_LIMIT (UNCACHED_LIMIT)
+) dut (
+  .clk_i          (clk_i),
+  .rst_i          (rst_i),
+  .s_wb_adr_i     (s_wb_adr_i),
+  .s_wb_dat_o     (s_wb_dat_o),
+  .s_wb_dat_i     (s_wb_dat_i),
+  .s_wb_we_i      (s_wb_we_i),
+  .s_wb_sel_i     (s_wb_sel_i),
+  .s_wb_stb_i     (s_wb_stb_i),
+  .s_wb_ack_o     (s_wb_ack_o),
+  .s_wb_cyc_i     (s_wb_cyc_i),
+  .s_wb_stall_o   (s_wb_stall_o),
+  .m_wb_adr_o     (m_wb_adr_o),
+  .m_wb_dat_i     (m_wb_dat_i),
+  .m_wb_dat_o     (m_wb_dat_o),
+  .m_wb_we_o      (m_wb_we_o),
+  .m_wb_sel_o     (m_wb_sel_o),
+  .m_wb_stb_o     (m_wb_stb_o),
+  .m_wb_ack_i     (m_wb_ack_i),
+  .m_wb_cyc_o     (m_wb_cyc_o),
+  .m_wb_stall_i   (m_wb_stall_i),
+  .m_wb_cti_o     (m_wb_cti_o),
+  .m_wb_bte_o     (m_wb_bte_o)
+);
+
+assign hit_count_q       = dut.hit_count_q;
+assign miss_count_q      = dut.miss_count_q;
+assign writeback_count_q = dut.writeback_count_q;
+
+endmodule // tb_dcache
+
+`verilator_config
+
+public -module "tb_dcache" -var "SIZE"
+public -module "tb_dcache" -var "LINE_SIZE"
+public -module "tb_dcache" -var "WAYS"
+public -module "tb_dcache" -var "UNCACHED_BASE"
+public -module "tb_dcache" -var "hit_count_q"
+public -module "tb_dcache" -var "miss_count_q"
+public -module "tb_dcache" -var "writeback_count_q"
@@ -41,6 +41,7 @@ enum CondId {
   COND_writeback,
   COND_loadstore,
   COND_output_valid,
+  COND_forwarding,
   __CondIdEnd
 };
 
@@ -85,7 +86,9 @@ enum TestcaseId {
   T_BUBBLE          =  37,
   T_PIPELINE_WAIT   =  38,
   T_HAZARD          =  39,
-  T_RESET           =  40
+  T_RESET           =  40,
+  T_FORWARDING      =  41,
+  T_BITMANIP        =  42
 };
 
 class TB_Decode : public Testbench<Vtb_decode> {
@@ -108,6 +111,7 @@ public:
     core->input_valid_i = 0;
     core->instr_i = 0;
     core->pc_i = 0;
+    core->compressed_i = 0;
     core->output_ready_i = 0;
   }
 };
@@ -3208,6 +3212,271 @@ void tb_decode_hazard(TB_Decode * tb) {
       "Failed to implement the output valid signal", tb->err_cycles[COND_output_valid]);
 }
 
+void tb_decode_forwarding(TB_Decode * tb) {
+  Vtb_decode * core = tb->core;
+  core->testcase = T_FORWARDING;
+
+  // The following actions are performed in this test :
+  //    tick 0. Set inputs with an ADD instruction
+  //    tick 1. Set inputs with an ADDI instruction
+  //    tick 2. Set inputs with a SW instruction
+  //    tick 3. Set inputs with a LUI instruction
+  //    tick 4. Set inputs with a bubble
+
+  //=================================
+  //      Tick (0)
+  
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  core->input_valid_i = 1;
+  core->output_ready_i = 1;
+  core->stall_request_i = 0;
+
+  uint32_t rd = rand() % 32;
+  uint32_t rs1 = rand() % 32;
+  uint32_t rs2 = rand() % 32;
+  uint32_t imm = rand() % 0xFFF;
+  core->instr_i = instr_add(rd, rs1, rs2);
+
+  //=================================
+  //      Tick (1)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  tb->check(COND_forwarding, (core->alu_operand1_reg_o   ==  rs1) &&
+                             (core->alu_operand2_reg_o   ==  rs2) &&
+                             (core->ls_write_data_reg_o  ==  0));
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  core->instr_i = instr_addi(rd, rs1, imm);
+
+  //=================================
+  //      Tick (2)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  tb->check(COND_forwarding, (core->alu_operand1_reg_o   ==  rs1) &&
+                             (core->alu_operand2_reg_o   ==  0)   &&
+                             (core->ls_write_data_reg_o  ==  0));
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  core->instr_i = instr_sw(rs1, rs2, imm);
+
+  //=================================
+  //      Tick (3)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  tb->check(COND_forwarding, (core->alu_operand1_reg_o   ==  rs1) &&
+                             (core->alu_operand2_reg_o   ==  0)   &&
+                             (core->ls_write_data_reg_o  ==  rs2));
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  core->instr_i = instr_lui(rd, imm);
+
+  //=================================
+  //      Tick (4)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  tb->check(COND_forwarding, (core->alu_operand1_reg_o   ==  0)   &&
+                             (core->alu_operand2_reg_o   ==  0)   &&
+                             (core->ls_write_data_reg_o  ==  0));
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  core->input_valid_i = 0;
+  core->instr_i = instr_add(rd, rs1, rs2);
+
+  //=================================
+  //      Tick (5)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  tb->check(COND_forwarding, (core->alu_operand1_reg_o   ==  0)   &&
+                             (core->alu_operand2_reg_o   ==  0)   &&
+                             (core->ls_write_data_reg_o  ==  0));
+
+  //`````````````````````````````````
+  //      Formal Checks 
+  
+  CHECK("tb_decode.forwarding.01",
+      tb->conditions[COND_forwarding],
+      "Failed to implement the forwarding interface", tb->err_cycles[COND_forwarding]);
+}
+
+void tb_decode_bitmanip(TB_Decode * tb) {
+  Vtb_decode * core = tb->core;
+  core->testcase = T_BITMANIP;
+
+  // The following actions are performed in this test :
+  //    tick 2*i.   Set inputs with the i-th bit-manipulation instruction
+  //    tick 2*i+1. Nothing (core outputs the decoded instruction)
+  //    tick 2*n.   Set inputs with a ZEXT.H instruction having a non-zero rs2
+  //    tick 2*n+1. Nothing (core outputs an XOR instruction)
+
+  // Encodings of the Zba, Zbb and Zbs instructions, the rs2 field being
+  // fixed for the unary instructions and random otherwise
+  struct Encoding {
+    uint32_t opcode;
+    uint32_t func7;
+    uint32_t func3;
+    int rs2;
+    uint32_t op;
+  } encodings[] = {
+    {0x33, 0x10, 0x2, -1,   Vtb_decode_ecap5_dproc_pkg::ALU_SH1ADD},
+    {0x33, 0x10, 0x4, -1,   Vtb_decode_ecap5_dproc_pkg::ALU_SH2ADD},
+    {0x33, 0x10, 0x6, -1,   Vtb_decode_ecap5_dproc_pkg::ALU_SH3ADD},
+    {0x33, 0x20, 0x7, -1,   Vtb_decode_ecap5_dproc_pkg::ALU_ANDN},
+    {0x33, 0x20, 0x6, -1,   Vtb_decode_ecap5_dproc_pkg::ALU_ORN},
+    {0x33, 0x20, 0x4, -1,   Vtb_decode_ecap5_dproc_pkg::ALU_XNOR},
+    {0x33, 0x05, 0x4, -1,   Vtb_decode_ecap5_dproc_pkg::ALU_MIN},
+    {0x33, 0x05, 0x5, -1,   Vtb_decode_ecap5_dproc_pkg::ALU_MINU},
+    {0x33, 0x05, 0x6, -1,   Vtb_decode_ecap5_dproc_pkg::ALU_MAX},
+    {0x33, 0x05, 0x7, -1,   Vtb_decode_ecap5_dproc_pkg::ALU_MAXU},
+    {0x33, 0x04, 0x4, 0x00, Vtb_decode_ecap5_dproc_pkg::ALU_ZEXT_H},
+    {0x33, 0x30, 0x1, -1,   Vtb_decode_ecap5_dproc_pkg::ALU_ROL},
+    {0x33, 0x30, 0x5, -1,   Vtb_decode_ecap5_dproc_pkg::ALU_ROR},
+    {0x33, 0x14, 0x1, -1,   Vtb_decode_ecap5_dproc_pkg::ALU_BSET},
+    {0x33, 0x24, 0x1, -1,   Vtb_decode_ecap5_dproc_pkg::ALU_BCLR},
+    {0x33, 0x34, 0x1, -1,   Vtb_decode_ecap5_dproc_pkg::ALU_BINV},
+    {0x33, 0x24, 0x5, -1,   Vtb_decode_ecap5_dproc_pkg::ALU_BEXT},
+    {0x13, 0x30, 0x1, 0x00, Vtb_decode_ecap5_dproc_pkg::ALU_CLZ},
+    {0x13, 0x30, 0x1, 0x01, Vtb_decode_ecap5_dproc_pkg::ALU_CTZ},
+    {0x13, 0x30, 0x1, 0x02, Vtb_decode_ecap5_dproc_pkg::ALU_CPOP},
+    {0x13, 0x30, 0x1, 0x04, Vtb_decode_ecap5_dproc_pkg::ALU_SEXT_B},
+    {0x13, 0x30, 0x1, 0x05, Vtb_decode_ecap5_dproc_pkg::ALU_SEXT_H},
+    {0x13, 0x30, 0x5, -1,   Vtb_decode_ecap5_dproc_pkg::ALU_ROR},
+    {0x13, 0x14, 0x5, 0x07, Vtb_decode_ecap5_dproc_pkg::ALU_ORC_B},
+    {0x13, 0x34, 0x5, 0x18, Vtb_decode_ecap5_dproc_pkg::ALU_REV8},
+    {0x13, 0x14, 0x1, -1,   Vtb_decode_ecap5_dproc_pkg::ALU_BSET},
+    {0x13, 0x24, 0x1, -1,   Vtb_decode_ecap5_dproc_pkg::ALU_BCLR},
+    {0x13, 0x34, 0x1, -1,   Vtb_decode_ecap5_dproc_pkg::ALU_BINV},
+    {0x13, 0x24, 0x5, -1,   Vtb_decode_ecap5_dproc_pkg::ALU_BEXT}
+  };
+
+  //=================================
+  //      Tick (0)
+  
+  tb->reset();
+
+  for(Encoding encoding : encodings) {
+    //`````````````````````````````````
+    //      Set inputs
+    
+    core->input_valid_i = 1;
+    core->output_ready_i = 1;
+
+    uint32_t pc = rand();
+    core->pc_i = pc;
+    uint32_t rd = rand() % 32;
+    uint32_t rs1 = rand() % 32;
+    uint32_t rs2 = (encoding.rs2 < 0) ? (rand() % 32) : encoding.rs2;
+    core->instr_i = (encoding.func7 << 25) | (rs2 << 20) | (rs1 << 15)
+                  | (encoding.func3 << 12) | (rd << 7) | encoding.opcode;
+
+    uint32_t rdata1 = rand() % 0x7FFFFFFF;
+    core->rdata1_i = rdata1;
+    uint32_t rdata2 = rand() % 0x7FFFFFFF;
+    core->rdata2_i = rdata2;
+
+    // The immediate forms only provide the rs2 field as second operand
+    uint32_t operand2 = (encoding.opcode == 0x13) ? rs2 : rdata2;
+
+    //=================================
+    //      Tick (2*i+1)
+    
+    tb->tick();
+
+    //`````````````````````````````````
+    //      Checks 
+    
+    tb->check(COND_alu,       (core->alu_operand1_o     ==  rdata1)    &&
+                              (core->alu_operand2_o     ==  operand2)  &&
+                              (core->alu_op_o           ==  encoding.op));
+    tb->check(COND_branch,    (core->branch_cond_o      ==  Vtb_decode_ecap5_dproc_pkg::NO_BRANCH));
+    tb->check(COND_writeback, (core->reg_write_o        ==  1) &&
+                              (core->reg_addr_o         ==  rd));
+    tb->check(COND_loadstore, (core->ls_enable_o        ==  0));
+    tb->check(COND_output_valid, (core->output_valid_o == 1));
+
+    //=================================
+    //      Tick (2*i+2)
+    
+    tb->_nop();
+    tb->tick();
+  }
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  core->input_valid_i = 1;
+  core->output_ready_i = 1;
+
+  uint32_t rd = rand() % 32;
+  uint32_t rs1 = rand() % 32;
+  uint32_t rs2 = 1 + rand() % 31;
+  core->instr_i = (0x04 << 25) | (rs2 << 20) | (rs1 << 15) | (0x4 << 12) | (rd << 7) | 0x33;
+
+  //=================================
+  //      Tick (2*n+1)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  tb->check(COND_alu,       (core->alu_op_o           ==  Vtb_decode_ecap5_dproc_pkg::ALU_XOR));
+
+  //`````````````````````````````````
+  //      Formal Checks 
+  
+  CHECK("tb_decode.bitmanip.01",
+      tb->conditions[COND_alu],
+      "Failed to implement the alu protocol", tb->err_cycles[COND_alu]);
+
+  CHECK("tb_decode.bitmanip.02",
+      tb->conditions[COND_branch],
+      "Failed to implement the branch protocol", tb->err_cycles[COND_branch]);
+
+  CHECK("tb_decode.bitmanip.03",
+      tb->conditions[COND_writeback],
+      "Failed to implement the writeback protocol", tb->err_cycles[COND_writeback]);
+
+  CHECK("tb_decode.bitmanip.04",
+      tb->conditions[COND_loadstore],
+      "Failed to implement the load-store protocol", tb->err_cycles[COND_loadstore]);
+
+  CHECK("tb_decode.bitmanip.05",
+      tb->conditions[COND_output_valid],
+      "Failed to implement the output valid signal", tb->err_cycles[COND_output_valid]);
+}
+
 int main(int argc, char ** argv, char ** env) {
   srand(time(NULL));
   Verilated::traceEverOn(true);
@@ -3268,6 +3537,10 @@ int main(int argc, char ** argv, char ** env) {
 
   tb_decode_hazard(tb);
 
+  tb_decode_forwarding(tb);
+
+  tb_decode_bitmanip(tb);
+
   /************************************************************/
 
   printf("[DECODE]: ");
@@ -38,6 +38,9 @@ module tb_decode import ecap5_dproc_pkg::*;
    
   input   logic[31:0]   instr_i,
   input   logic[31:0]   pc_i,
+  input   logic         compressed_i,
+  input   logic         pred_taken_i,
+  input   logic[31:0]   pred_target_i,
 
   //=================================
   //    Register interface
@@ -57,14 +60,22 @@ module tb_decode import ecap5_dproc_pkg::*;
   //    Execute interface 
    
   output   logic[31:0]  pc_o,
+  output   logic        compressed_o,
   output   logic[31:0]  alu_operand1_o,
   output   logic[31:0]  alu_operand2_o, 
-  output   logic[2:0]   alu_op_o,
+  output   logic[4:0]   alu_op_o,
   output   logic        alu_sub_o,
   output   logic        alu_shift_left_o,
   output   logic        alu_signed_shift_o,
+  output   logic        muldiv_enable_o,
+  output   logic[2:0]   muldiv_op_o,
   output   logic[2:0]   branch_cond_o,
   output   logic[19:0]  branch_offset_o,
+  output   logic        pred_taken_o,
+  output   logic[31:0]  pred_target_o,
+  output   logic[4:0]   alu_operand1_reg_o,
+  output   logic[4:0]   alu_operand2_reg_o,
+  output   logic[4:0]   ls_write_data_reg_o,
 
   //`````````````````````````````````
   //    Write-back pass-through 
@@ -81,16 +92,36 @@ module tb_decode import ecap5_dproc_pkg::*;
   output   logic[3:0]   ls_sel_o,
   output   logic        ls_unsigned_load_o,
 
-  input  logic  stall_request_i
+  output   logic        branch_o,
+  output   logic[31:0]  branch_target_o,
+
+  output   logic        bp_update_o,
+  output   logic[31:0]  bp_pc_o,
+  output   logic        bp_taken_o,
+  output   logic[31:0]  bp_target_o,
+  output   logic        bp_mispredict_o,
+
+  input  logic  stall_request_i,
+  input  logic  discard_request_i,
+  output logic  branch_compare_o
 );
 
-decode dut (
+decode #(
+  .BITMANIP            (1)
+) dut (
   .clk_i               (clk_i),
   .rst_i               (rst_i),
   .input_ready_o       (input_ready_o),
   .input_valid_i       (input_valid_i),
   .instr_i             (instr_i),
   .pc_i                (pc_i),
+  .compressed_i        (compressed_i),
+  .pred_taken_i        (pred_taken_i),
+  .pred_target_i       (pred_target_i),
+  .next_valid_i        (1'b0),
+  .next_instr_i        ('0),
+  .next_pred_taken_i   (1'b0),
+  .fuse_o              (),
   .raddr1_o            (raddr1_o),
   .rdata1_i            (rdata1_i),
   .raddr2_o            (raddr2_o),
@@ -98,14 +129,22 @@ decode dut (
   .output_ready_i      (output_ready_i),
   .output_valid_o      (output_valid_o),
   .pc_o                (pc_o),
+  .compressed_o        (compressed_o),
   .alu_operand1_o      (alu_operand1_o),
   .alu_operand2_o      (alu_operand2_o), 
   .alu_op_o            (alu_op_o),
   .alu_sub_o           (alu_sub_o),
   .alu_shift_left_o    (alu_shift_left_o),
   .alu_signed_shift_o  (alu_signed_shift_o),
+  .muldiv_enable_o     (muldiv_enable_o),
+  .muldiv_op_o         (muldiv_op_o),
   .branch_cond_o       (branch_cond_o),
   .branch_offset_o     (branch_offset_o),
+  .pred_taken_o        (pred_taken_o),
+  .pred_target_o       (pred_target_o),
+  .alu_operand1_reg_o  (alu_operand1_reg_o),
+  .alu_operand2_reg_o  (alu_operand2_reg_o),
+  .ls_write_data_reg_o (ls_write_data_reg_o),
   .reg_write_o         (reg_write_o),
   .reg_addr_o          (reg_addr_o),
   .ls_enable_o         (ls_enable_o),
@@ -113,7 +152,19 @@ decode dut (
   .ls_write_data_o     (ls_write_data_o),
   .ls_sel_o            (ls_sel_o),
   .ls_unsigned_load_o  (ls_unsigned_load_o),
-  .stall_request_i     (stall_request_i)
+  .ls_atomic_o         (),
+  .ls_atomic_op_o      (),
+  .fence_i_o           (),
+  .branch_o            (branch_o),
+  .branch_target_o     (branch_target_o),
+  .bp_update_o         (bp_update_o),
+  .bp_pc_o             (bp_pc_o),
+  .bp_taken_o          (bp_taken_o),
+  .bp_target_o         (bp_target_o),
+  .bp_mispredict_o     (bp_mispredict_o),
+  .stall_request_i     (stall_request_i),
+  .discard_request_i   (discard_request_i),
+  .branch_compare_o    (branch_compare_o)
 );
 
 endmodule // tb_decode
@@ -0,0 +1,656 @@
+/*           __        _
+ *  ________/ /  ___ _(_)__  ___
+ * / __/ __/ _ \/ _ `/ / _ \/ -_)
+ * \__/\__/_//_/\_,_/_/_//_/\__/
+ * 
+ * Copyright (C) Clément Chaine
+ * This file is part of ECAP5-DPROC <https://github.com/ecap5/ECAP5-DPROC>
+ *
+ * ECAP5-DPROC is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ECAP5-DPROC is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ECAP5-DPROC.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <verilated.h>
+#include <verilated_vcd_c.h>
+#include <svdpi.h>
+
+#include "Vtb_decode_w_branch.h"
+#include "testbench.h"
+#include "riscv.h"
+#include "Vtb_decode_w_branch_ecap5_dproc_pkg.h"
+#include "Vtb_decode_w_branch_riscv_pkg.h"
+
+enum CondId {
+  COND_alu,
+  COND_branch,
+  COND_writeback,
+  COND_hazard,
+  __CondIdEnd
+};
+
+enum TestcaseId {
+  T_JAL             =  1,
+  T_JALR            =  2,
+  T_BRANCH          =  3,
+  T_BRANCH_REQUEST  =  4,
+  T_PREDICTION      =  5,
+  T_JAL_COMPRESSED  =  6
+};
+
+class TB_Decode_w_branch : public Testbench<Vtb_decode_w_branch> {
+public:
+  void reset() {
+    this->_nop();
+
+    this->core->rst_i = 1;
+    for(int i = 0; i < 5; i++) {
+      this->tick();
+    }
+    this->core->rst_i = 0;
+
+    Testbench<Vtb_decode_w_branch>::reset();
+  }
+  
+  void _nop() {
+    core->input_valid_i = 0;
+    core->instr_i = 0;
+    core->pc_i = 0;
+    core->compressed_i = 0;
+    core->output_ready_i = 0;
+    core->stall_request_i = 0;
+    core->discard_request_i = 0;
+    core->pred_taken_i = 0;
+    core->pred_target_i = 0;
+  }
+
+  // Returns whether the branch condition of func3 is met
+  static bool branch_taken(uint32_t func3, uint32_t rdata1, uint32_t rdata2) {
+    switch(func3) {
+      case 0: return rdata1 == rdata2;
+      case 1: return rdata1 != rdata2;
+      case 4: return (int32_t)rdata1 <  (int32_t)rdata2;
+      case 5: return (int32_t)rdata1 >= (int32_t)rdata2;
+      case 6: return rdata1 <  rdata2;
+      default: return rdata1 >= rdata2;
+    }
+  }
+
+  static uint32_t instr_branch(uint32_t func3, uint32_t rs1, uint32_t rs2, uint32_t imm) {
+    switch(func3) {
+      case 0: return instr_beq(rs1, rs2, imm);
+      case 1: return instr_bne(rs1, rs2, imm);
+      case 4: return instr_blt(rs1, rs2, imm);
+      case 5: return instr_bge(rs1, rs2, imm);
+      case 6: return instr_bltu(rs1, rs2, imm);
+      default: return instr_bgeu(rs1, rs2, imm);
+    }
+  }
+};
+
+void tb_decode_w_branch_jal(TB_Decode_w_branch * tb) {
+  Vtb_decode_w_branch * core = tb->core;
+  core->testcase = T_JAL;
+
+  // The following actions are performed in this test :
+  //    tick 0. Set inputs for JAL (core requests the branch)
+  //    tick 1. Nothing (core outputs the return address computation)
+
+  //=================================
+  //      Tick (0)
+  
+  tb->reset();
+  
+  //`````````````````````````````````
+  //      Set inputs
+  
+  core->input_valid_i = 1;
+  core->output_ready_i = 1;
+
+  uint32_t pc = rand();
+  core->pc_i = pc;
+  uint32_t rd = rand() % 32;
+  uint32_t imm = (10 + rand() % (0x1FFFFF - 10)) & ~(0x1);
+  core->instr_i = instr_jal(rd, imm);
+
+  // this change is asynchronous
+  core->eval();
+
+  //`````````````````````````````````
+  //      Checks 
+
+  tb->check(COND_branch,    (core->branch_o          ==  1)  &&
+                            (core->branch_target_o   ==  pc + sign_extend(imm, 21)));
+  tb->check(COND_hazard,    (core->branch_compare_o  ==  0));
+
+  //=================================
+  //      Tick (1)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  core->input_valid_i = 0;
+
+  //`````````````````````````````````
+  //      Checks 
+
+  tb->check(COND_alu,       (core->alu_operand1_o  ==  pc)  &&
+                            (core->alu_operand2_o  ==  4)   &&
+                            (core->alu_op_o        ==  Vtb_decode_w_branch_ecap5_dproc_pkg::ALU_ADD) &&
+                            (core->alu_sub_o       ==  0));
+  tb->check(COND_branch,    (core->branch_cond_o   ==  Vtb_decode_w_branch_ecap5_dproc_pkg::NO_BRANCH));
+  tb->check(COND_writeback, (core->reg_write_o     ==  1)  &&
+                            (core->reg_addr_o      ==  rd));
+
+  //`````````````````````````````````
+  //      Formal Checks 
+  
+  CHECK("tb_decode_w_branch.jal.01",
+      tb->conditions[COND_alu],
+      "Failed to compute the return address", tb->err_cycles[COND_alu]);
+
+  CHECK("tb_decode_w_branch.jal.02",
+      tb->conditions[COND_branch],
+      "Failed to resolve the jump", tb->err_cycles[COND_branch]);
+
+  CHECK("tb_decode_w_branch.jal.03",
+      tb->conditions[COND_writeback],
+      "Failed to implement the writeback protocol", tb->err_cycles[COND_writeback]);
+
+  CHECK("tb_decode_w_branch.jal.04",
+      tb->conditions[COND_hazard],
+      "Failed to implement the hazard protocol", tb->err_cycles[COND_hazard]);
+}
+
+void tb_decode_w_branch_jal_compressed(TB_Decode_w_branch * tb) {
+  Vtb_decode_w_branch * core = tb->core;
+  core->testcase = T_JAL_COMPRESSED;
+
+  // The following actions are performed in this test :
+  //    tick 0. Set inputs for a compressed JAL (core requests the branch)
+  //    tick 1. Nothing (core outputs the return address computation)
+
+  //=================================
+  //      Tick (0)
+  
+  tb->reset();
+  
+  //`````````````````````````````````
+  //      Set inputs
+  
+  core->input_valid_i = 1;
+  core->output_ready_i = 1;
+
+  uint32_t pc = rand();
+  core->pc_i = pc;
+  uint32_t rd = rand() % 32;
+  uint32_t imm = (10 + rand() % (0x1FFFFF - 10)) & ~(0x1);
+  core->instr_i = instr_jal(rd, imm);
+  core->compressed_i = 1;
+
+  // this change is asynchronous
+  core->eval();
+
+  //`````````````````````````````````
+  //      Checks 
+
+  tb->check(COND_branch,    (core->branch_o          ==  1)  &&
+                            (core->branch_target_o   ==  pc + sign_extend(imm, 21)));
+  tb->check(COND_hazard,    (core->branch_compare_o  ==  0));
+
+  //=================================
+  //      Tick (1)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  core->input_valid_i = 0;
+
+  //`````````````````````````````````
+  //      Checks 
+
+  tb->check(COND_alu,       (core->alu_operand1_o  ==  pc)  &&
+                            (core->alu_operand2_o  ==  2)   &&
+                            (core->alu_op_o        ==  Vtb_decode_w_branch_ecap5_dproc_pkg::ALU_ADD) &&
+                            (core->alu_sub_o       ==  0));
+  tb->check(COND_branch,    (core->branch_cond_o   ==  Vtb_decode_w_branch_ecap5_dproc_pkg::NO_BRANCH));
+  tb->check(COND_writeback, (core->reg_write_o     ==  1)  &&
+                            (core->reg_addr_o      ==  rd));
+
+  //`````````````````````````````````
+  //      Formal Checks 
+  
+  CHECK("tb_decode_w_branch.jal_compressed.01",
+      tb->conditions[COND_alu],
+      "Failed to compute the return address", tb->err_cycles[COND_alu]);
+
+  CHECK("tb_decode_w_branch.jal_compressed.02",
+      tb->conditions[COND_branch],
+      "Failed to resolve the jump", tb->err_cycles[COND_branch]);
+
+  CHECK("tb_decode_w_branch.jal_compressed.03",
+      tb->conditions[COND_writeback],
+      "Failed to implement the writeback protocol", tb->err_cycles[COND_writeback]);
+
+  CHECK("tb_decode_w_branch.jal_compressed.04",
+      tb->conditions[COND_hazard],
+      "Failed to implement the hazard protocol", tb->err_cycles[COND_hazard]);
+}
+
+void tb_decode_w_branch_jalr(TB_Decode_w_branch * tb) {
+  Vtb_decode_w_branch * core = tb->core;
+  core->testcase = T_JALR;
+
+  // The following actions are performed in this test :
+  //    tick 0. Set inputs for JALR
+  //    tick 1. Nothing (core outputs the jump to the execute module)
+
+  //=================================
+  //      Tick (0)
+  
+  tb->reset();
+  
+  //`````````````````````````````````
+  //      Set inputs
+  
+  core->input_valid_i = 1;
+  core->output_ready_i = 1;
+
+  core->pc_i = rand();
+  uint32_t rd = rand() % 32;
+  uint32_t rs1 = rand() % 32;
+  uint32_t imm = (10 + rand() % (0xFFFF - 10));
+  core->instr_i = instr_jalr(rd, rs1, imm);
+  core->rdata1_i = rand();
+
+  // this change is asynchronous
+  core->eval();
+
+  //`````````````````````````````````
+  //      Checks 
+
+  tb->check(COND_branch,    (core->branch_o          ==  0));
+  tb->check(COND_hazard,    (core->branch_compare_o  ==  0));
+
+  //=================================
+  //      Tick (1)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  core->input_valid_i = 0;
+
+  //`````````````````````````````````
+  //      Checks 
+
+  tb->check(COND_branch,    (core->branch_cond_o   ==  Vtb_decode_w_branch_ecap5_dproc_pkg::BRANCH_UNCOND));
+
+  //`````````````````````````````````
+  //      Formal Checks 
+  
+  CHECK("tb_decode_w_branch.jalr.01",
+      tb->conditions[COND_branch],
+      "Failed to forward the jump to the execute module", tb->err_cycles[COND_branch]);
+
+  CHECK("tb_decode_w_branch.jalr.02",
+      tb->conditions[COND_hazard],
+      "Failed to implement the hazard protocol", tb->err_cycles[COND_hazard]);
+}
+
+void tb_decode_w_branch_branch(TB_Decode_w_branch * tb) {
+  Vtb_decode_w_branch * core = tb->core;
+  core->testcase = T_BRANCH;
+
+  // The following actions are performed in this test :
+  //    tick 0-N. Set inputs for a branch of each condition with random
+  //              operands (core requests the branch when taken)
+
+  //=================================
+  //      Tick (0)
+  
+  tb->reset();
+
+  const uint32_t func3s[] = {0, 1, 4, 5, 6, 7};
+  for(int i = 0; i < 64; i++) {
+    //`````````````````````````````````
+    //      Set inputs
+    
+    core->input_valid_i = 1;
+    core->output_ready_i = 1;
+
+    uint32_t func3 = func3s[rand() % 6];
+    uint32_t pc = rand();
+    core->pc_i = pc;
+    uint32_t rs1 = rand() % 32;
+    uint32_t rs2 = rand() % 32;
+    uint32_t imm = (10 + rand() % (0x1FFF - 10)) & ~(0x1);
+    core->instr_i = TB_Decode_w_branch::instr_branch(func3, rs1, rs2, imm);
+
+    uint32_t rdata1 = rand();
+    // Equal operands are tested as well
+    uint32_t rdata2 = (rand() % 4 == 0) ? rdata1 : rand();
+    core->rdata1_i = rdata1;
+    core->rdata2_i = rdata2;
+
+    // this change is asynchronous
+    core->eval();
+
+    //`````````````````````````````````
+    //      Checks 
+
+    tb->check(COND_branch,    (core->branch_o          ==  TB_Decode_w_branch::branch_taken(func3, rdata1, rdata2)) &&
+                              (core->branch_target_o   ==  pc + sign_extend(imm, 13)));
+    tb->check(COND_hazard,    (core->branch_compare_o  ==  1));
+
+    //=================================
+    //      Tick (1-N)
+    
+    tb->tick();
+
+    //`````````````````````````````````
+    //      Checks 
+
+    tb->check(COND_branch,    (core->branch_cond_o   ==  Vtb_decode_w_branch_ecap5_dproc_pkg::NO_BRANCH));
+    tb->check(COND_writeback, (core->reg_write_o     ==  0));
+  }
+
+  //`````````````````````````````````
+  //      Formal Checks 
+  
+  CHECK("tb_decode_w_branch.branch.01",
+      tb->conditions[COND_branch],
+      "Failed to resolve the branch", tb->err_cycles[COND_branch]);
+
+  CHECK("tb_decode_w_branch.branch.02",
+      tb->conditions[COND_writeback],
+      "Failed to implement the writeback protocol", tb->err_cycles[COND_writeback]);
+
+  CHECK("tb_decode_w_branch.branch.03",
+      tb->conditions[COND_hazard],
+      "Failed to implement the hazard protocol", tb->err_cycles[COND_hazard]);
+}
+
+void tb_decode_w_branch_request(TB_Decode_w_branch * tb) {
+  Vtb_decode_w_branch * core = tb->core;
+  core->testcase = T_BRANCH_REQUEST;
+
+  // The following actions are performed in this test :
+  //    tick 0. Set inputs for JAL without input handshake
+  //    tick 1. Set inputs for JAL with a stall request
+  //    tick 2. Set inputs for JAL with a discard request
+  //    tick 3. Set inputs for JAL (core requests the branch)
+
+  //=================================
+  //      Tick (0)
+  
+  tb->reset();
+  
+  //`````````````````````````````````
+  //      Set inputs
+  
+  core->input_valid_i = 0;
+  core->output_ready_i = 1;
+  core->pc_i = rand();
+  core->instr_i = instr_jal(rand() % 32, 0x100);
+
+  // this change is asynchronous
+  core->eval();
+
+  //`````````````````````````````````
+  //      Checks 
+
+  tb->check(COND_branch, (core->branch_o == 0));
+
+  //=================================
+  //      Tick (1)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  core->input_valid_i = 1;
+  core->output_ready_i = 0;
+
+  // this change is asynchronous
+  core->eval();
+
+  //`````````````````````````````````
+  //      Checks 
+
+  tb->check(COND_branch, (core->branch_o == 0));
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  core->output_ready_i = 1;
+  core->stall_request_i = 1;
+
+  // this change is asynchronous
+  core->eval();
+
+  //`````````````````````````````````
+  //      Checks 
+
+  tb->check(COND_branch, (core->branch_o == 0));
+
+  //=================================
+  //      Tick (2)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  core->stall_request_i = 0;
+  core->discard_request_i = 1;
+
+  // this change is asynchronous
+  core->eval();
+
+  //`````````````````````````````````
+  //      Checks 
+
+  tb->check(COND_branch, (core->branch_o == 0));
+
+  //=================================
+  //      Tick (3)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  core->discard_request_i = 0;
+
+  // this change is asynchronous
+  core->eval();
+
+  //`````````````````````````````````
+  //      Checks 
+
+  tb->check(COND_branch, (core->branch_o == 1));
+
+  //`````````````````````````````````
+  //      Formal Checks 
+  
+  CHECK("tb_decode_w_branch.request.01",
+      tb->conditions[COND_branch],
+      "Failed to request the branch upon input handshake only", tb->err_cycles[COND_branch]);
+}
+
+void tb_decode_w_branch_prediction(TB_Decode_w_branch * tb) {
+  Vtb_decode_w_branch * core = tb->core;
+  core->testcase = T_PREDICTION;
+
+  // The following actions are performed in this test :
+  //    tick 0. Set inputs for a predicted JAL
+  //    tick 1. Set inputs for a predicted taken BEQ (core outputs the prediction of JAL)
+  //    tick 2. Set inputs for a predicted not taken BEQ
+  //    tick 3. Set inputs for a predicted JALR (core leaves it to the execute module)
+
+  //=================================
+  //      Tick (0)
+  
+  tb->reset();
+  
+  //`````````````````````````````````
+  //      Set inputs
+  
+  core->input_valid_i = 1;
+  core->output_ready_i = 1;
+  core->pc_i = rand();
+  core->instr_i = instr_jal(rand() % 32, 0x100);
+  core->pred_taken_i = 1;
+
+  // this change is asynchronous
+  core->eval();
+
+  //`````````````````````````````````
+  //      Checks 
+
+  // The jump is already followed by the fetch module
+  tb->check(COND_branch, (core->branch_o == 0));
+
+  //=================================
+  //      Tick (1)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks 
+
+  tb->check(COND_branch, (core->pred_taken_o == 1));
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  uint32_t pc = rand();
+  uint32_t rdata = rand();
+  core->pc_i = pc;
+  core->instr_i = instr_beq(1, 2, -0x10);
+  core->rdata1_i = rdata;
+  core->rdata2_i = rdata;
+  core->pred_taken_i = 1;
+
+  // this change is asynchronous
+  core->eval();
+
+  //`````````````````````````````````
+  //      Checks 
+
+  tb->check(COND_branch, (core->branch_o == 0));
+
+  //=================================
+  //      Tick (2)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  core->rdata2_i = rdata + 1;
+
+  // this change is asynchronous
+  core->eval();
+
+  //`````````````````````````````````
+  //      Checks 
+
+  // The branch is not taken, the fall-through instruction is requested
+  tb->check(COND_branch, (core->branch_o         ==  1) &&
+                         (core->branch_target_o  ==  pc + 4));
+
+  //=================================
+  //      Tick (3)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  uint32_t target = rand();
+  core->pc_i = rand();
+  core->instr_i = instr_jalr(0, 1, 0);
+  core->pred_taken_i = 1;
+  core->pred_target_i = target;
+
+  // this change is asynchronous
+  core->eval();
+
+  //`````````````````````````````````
+  //      Checks 
+
+  tb->check(COND_branch, (core->branch_o == 0));
+
+  //=================================
+  //      Tick (4)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks 
+
+  // The predicted target is provided to the execute module
+  tb->check(COND_branch, (core->pred_taken_o   ==  1) &&
+                         (core->pred_target_o  ==  target));
+
+  //`````````````````````````````````
+  //      Formal Checks 
+  
+  CHECK("tb_decode_w_branch.prediction.01",
+      tb->conditions[COND_branch],
+      "Failed to request the branch upon misprediction only", tb->err_cycles[COND_branch]);
+}
+
+int main(int argc, char ** argv, char ** env) {
+  srand(time(NULL));
+  Verilated::traceEverOn(true);
+
+  bool verbose = parse_verbose(argc, argv);
+
+  TB_Decode_w_branch * tb = new TB_Decode_w_branch;
+  tb->open_trace("waves/decode_w_branch.vcd");
+  tb->open_testdata("testdata/decode_w_branch.csv");
+  tb->set_debug_log(verbose);
+  tb->init_conditions(__CondIdEnd);
+
+  /************************************************************/
+
+  tb_decode_w_branch_jal(tb);
+  tb_decode_w_branch_jal_compressed(tb);
+  tb_decode_w_branch_jalr(tb);
+  tb_decode_w_branch_branch(tb);
+  tb_decode_w_branch_request(tb);
+  tb_decode_w_branch_prediction(tb);
+
+  /************************************************************/
+
+  printf("[DECODE_W_BRANCH]: ");
+  if(tb->success) {
+    printf("Done\n");
+  } else {
+    printf("Failed\n");
+  }
+
+  delete tb;
+  exit(EXIT_SUCCESS);
+}
@@ -0,0 +1,660 @@
+/*           __        _
+ *  ________/ /  ___ _(_)__  ___
+ * / __/ __/ _ \/ _ `/ / _ \/ -_)
+ * \__/\__/_//_/\_,_/_/_//_/\__/
+ * 
+ * Copyright (C) Clément Chaine
+ * This file is part of ECAP5-DPROC <https://github.com/ecap5/ECAP5-DPROC>
+ *
+ * ECAP5-DPROC is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ECAP5-DPROC is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ECAP5-DPROC.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <verilated.h>
+#include <verilated_vcd_c.h>
+#include <svdpi.h>
+
+#include "Vtb_decode_w_fusion.h"
+#include "testbench.h"
+#include "riscv.h"
+#include "Vtb_decode_w_fusion_ecap5_dproc_pkg.h"
+#include "Vtb_decode_w_fusion_riscv_pkg.h"
+#include "Vtb_decode_w_fusion_tb_decode_w_fusion.h"
+#include "Vtb_decode_w_fusion_decode.h"
+
+enum CondId {
+  COND_fusion,
+  COND_alu,
+  COND_branch,
+  COND_writeback,
+  COND_counter,
+  __CondIdEnd
+};
+
+enum TestcaseId {
+  T_LUI_ADDI    =  1,
+  T_AUIPC_ADDI  =  2,
+  T_AUIPC_JALR  =  3,
+  T_SLLI_SRLI   =  4,
+  T_NO_FUSION   =  5,
+  T_COUNTER     =  6
+};
+
+class TB_Decode_w_fusion : public Testbench<Vtb_decode_w_fusion> {
+public:
+  void reset() {
+    this->_nop();
+
+    this->core->rst_i = 1;
+    for(int i = 0; i < 5; i++) {
+      this->tick();
+    }
+    this->core->rst_i = 0;
+
+    Testbench<Vtb_decode_w_fusion>::reset();
+  }
+  
+  void _nop() {
+    core->input_valid_i = 0;
+    core->instr_i = 0;
+    core->pc_i = 0;
+    core->compressed_i = 0;
+    core->output_ready_i = 0;
+    core->stall_request_i = 0;
+    core->discard_request_i = 0;
+    core->pred_taken_i = 0;
+    core->pred_target_i = 0;
+    core->next_valid_i = 0;
+    core->next_instr_i = 0;
+    core->next_pred_taken_i = 0;
+  }
+
+  void _pair(uint32_t pc, uint32_t instr, uint32_t next_instr) {
+    core->input_valid_i = 1;
+    core->output_ready_i = 1;
+    core->pc_i = pc;
+    core->instr_i = instr;
+    core->next_valid_i = 1;
+    core->next_instr_i = next_instr;
+  }
+};
+
+void tb_decode_w_fusion_lui_addi(TB_Decode_w_fusion * tb) {
+  Vtb_decode_w_fusion * core = tb->core;
+  core->testcase = T_LUI_ADDI;
+
+  // The following actions are performed in this test :
+  //    tick 0. Set inputs for LUI followed by ADDI (core fuses the pair)
+  //    tick 1. Nothing (core outputs the fused operation)
+
+  //=================================
+  //      Tick (0)
+  
+  tb->reset();
+  
+  //`````````````````````````````````
+  //      Set inputs
+  
+  uint32_t pc = rand() & ~0x3;
+  uint32_t rd = 1 + rand() % 31;
+  uint32_t upper = rand() % 0x100000;
+  uint32_t lower = rand() % 0x1000;
+  tb->_pair(pc, instr_lui(rd, upper), instr_addi(rd, rd, lower));
+
+  // this change is asynchronous
+  core->eval();
+
+  //`````````````````````````````````
+  //      Checks 
+
+  tb->check(COND_fusion,    (core->fuse_o  ==  1));
+
+  //=================================
+  //      Tick (1)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  tb->_nop();
+
+  //`````````````````````````````````
+  //      Checks 
+
+  tb->check(COND_alu,       (core->alu_operand1_o  ==  0)  &&
+                            (core->alu_operand2_o  ==  (upper << 12) + sign_extend(lower, 12)) &&
+                            (core->alu_op_o        ==  Vtb_decode_w_fusion_ecap5_dproc_pkg::ALU_ADD) &&
+                            (core->alu_sub_o       ==  0));
+  tb->check(COND_branch,    (core->branch_cond_o   ==  Vtb_decode_w_fusion_ecap5_dproc_pkg::NO_BRANCH));
+  tb->check(COND_writeback, (core->reg_write_o     ==  1)  &&
+                            (core->reg_addr_o      ==  rd));
+
+  //`````````````````````````````````
+  //      Formal Checks 
+  
+  CHECK("tb_decode_w_fusion.lui_addi.01",
+      tb->conditions[COND_fusion],
+      "Failed to detect the fused pair", tb->err_cycles[COND_fusion]);
+
+  CHECK("tb_decode_w_fusion.lui_addi.02",
+      tb->conditions[COND_alu],
+      "Failed to implement the alu protocol", tb->err_cycles[COND_alu]);
+
+  CHECK("tb_decode_w_fusion.lui_addi.03",
+      tb->conditions[COND_branch],
+      "Failed to implement the branch protocol", tb->err_cycles[COND_branch]);
+
+  CHECK("tb_decode_w_fusion.lui_addi.04",
+      tb->conditions[COND_writeback],
+      "Failed to implement the writeback protocol", tb->err_cycles[COND_writeback]);
+}
+
+void tb_decode_w_fusion_auipc_addi(TB_Decode_w_fusion * tb) {
+  Vtb_decode_w_fusion * core = tb->core;
+  core->testcase = T_AUIPC_ADDI;
+
+  // The following actions are performed in this test :
+  //    tick 0. Set inputs for AUIPC followed by ADDI (core fuses the pair)
+  //    tick 1. Nothing (core outputs the fused operation)
+
+  //=================================
+  //      Tick (0)
+  
+  tb->reset();
+  
+  //`````````````````````````````````
+  //      Set inputs
+  
+  uint32_t pc = rand() & ~0x3;
+  uint32_t rd = 1 + rand() % 31;
+  uint32_t upper = rand() % 0x100000;
+  uint32_t lower = rand() % 0x1000;
+  tb->_pair(pc, instr_auipc(rd, upper), instr_addi(rd, rd, lower));
+
+  // this change is asynchronous
+  core->eval();
+
+  //`````````````````````````````````
+  //      Checks 
+
+  tb->check(COND_fusion,    (core->fuse_o  ==  1));
+
+  //=================================
+  //      Tick (1)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  tb->_nop();
+
+  //`````````````````````````````````
+  //      Checks 
+
+  tb->check(COND_alu,       (core->alu_operand1_o  ==  pc)  &&
+                            (core->alu_operand2_o  ==  (upper << 12) + sign_extend(lower, 12)) &&
+                            (core->alu_op_o        ==  Vtb_decode_w_fusion_ecap5_dproc_pkg::ALU_ADD) &&
+                            (core->alu_sub_o       ==  0));
+  tb->check(COND_branch,    (core->branch_cond_o   ==  Vtb_decode_w_fusion_ecap5_dproc_pkg::NO_BRANCH));
+  tb->check(COND_writeback, (core->reg_write_o     ==  1)  &&
+                            (core->reg_addr_o      ==  rd));
+
+  //`````````````````````````````````
+  //      Formal Checks 
+  
+  CHECK("tb_decode_w_fusion.auipc_addi.01",
+      tb->conditions[COND_fusion],
+      "Failed to detect the fused pair", tb->err_cycles[COND_fusion]);
+
+  CHECK("tb_decode_w_fusion.auipc_addi.02",
+      tb->conditions[COND_alu],
+      "Failed to implement the alu protocol", tb->err_cycles[COND_alu]);
+
+  CHECK("tb_decode_w_fusion.auipc_addi.03",
+      tb->conditions[COND_branch],
+      "Failed to implement the branch protocol", tb->err_cycles[COND_branch]);
+
+  CHECK("tb_decode_w_fusion.auipc_addi.04",
+      tb->conditions[COND_writeback],
+      "Failed to implement the writeback protocol", tb->err_cycles[COND_writeback]);
+}
+
+void tb_decode_w_fusion_auipc_jalr(TB_Decode_w_fusion * tb) {
+  Vtb_decode_w_fusion * core = tb->core;
+  core->testcase = T_AUIPC_JALR;
+
+  // The following actions are performed in this test :
+  //    tick 0. Set inputs for AUIPC followed by JALR (core fuses the pair)
+  //    tick 1. Nothing (core outputs the fused jump)
+
+  //=================================
+  //      Tick (0)
+  
+  tb->reset();
+  
+  //`````````````````````````````````
+  //      Set inputs
+  
+  uint32_t pc = rand() & ~0x3;
+  uint32_t rd = 1 + rand() % 31;
+  uint32_t upper = rand() % 0x100000;
+  uint32_t lower = rand() % 0x1000;
+  tb->_pair(pc, instr_auipc(rd, upper), instr_jalr(rd, rd, lower));
+
+  // this change is asynchronous
+  core->eval();
+
+  //`````````````````````````````````
+  //      Checks 
+
+  tb->check(COND_fusion,    (core->fuse_o  ==  1));
+
+  //=================================
+  //      Tick (1)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  tb->_nop();
+
+  //`````````````````````````````````
+  //      Checks 
+
+  // The return address is computed from the pc of the JALR
+  tb->check(COND_alu,       (core->alu_operand1_o  ==  pc)  &&
+                            (core->alu_operand2_o  ==  (upper << 12) + sign_extend(lower, 12)) &&
+                            (core->pc_o            ==  pc + 4));
+  tb->check(COND_branch,    (core->branch_cond_o   ==  Vtb_decode_w_fusion_ecap5_dproc_pkg::BRANCH_UNCOND));
+  tb->check(COND_writeback, (core->reg_write_o     ==  1)  &&
+                            (core->reg_addr_o      ==  rd));
+
+  //`````````````````````````````````
+  //      Formal Checks 
+  
+  CHECK("tb_decode_w_fusion.auipc_jalr.01",
+      tb->conditions[COND_fusion],
+      "Failed to detect the fused pair", tb->err_cycles[COND_fusion]);
+
+  CHECK("tb_decode_w_fusion.auipc_jalr.02",
+      tb->conditions[COND_alu],
+      "Failed to implement the alu protocol", tb->err_cycles[COND_alu]);
+
+  CHECK("tb_decode_w_fusion.auipc_jalr.03",
+      tb->conditions[COND_branch],
+      "Failed to implement the branch protocol", tb->err_cycles[COND_branch]);
+
+  CHECK("tb_decode_w_fusion.auipc_jalr.04",
+      tb->conditions[COND_writeback],
+      "Failed to implement the writeback protocol", tb->err_cycles[COND_writeback]);
+}
+
+void tb_decode_w_fusion_slli_srli(TB_Decode_w_fusion * tb) {
+  Vtb_decode_w_fusion * core = tb->core;
+  core->testcase = T_SLLI_SRLI;
+
+  // The following actions are performed in this test :
+  //    tick 0. Set inputs for SLLI followed by SRLI (core fuses the pair)
+  //    tick 1. Nothing (core outputs the fused operation)
+
+  //=================================
+  //      Tick (0)
+  
+  tb->reset();
+  
+  //`````````````````````````````````
+  //      Set inputs
+  
+  uint32_t pc = rand() & ~0x3;
+  uint32_t rd = 1 + rand() % 31;
+  uint32_t rs1 = rand() % 32;
+  uint32_t rdata1 = rand();
+  uint32_t shamt = rand() % 32;
+  tb->_pair(pc, instr_slli(rd, rs1, shamt), instr_srli(rd, rd, shamt));
+  core->rdata1_i = rdata1;
+
+  // this change is asynchronous
+  core->eval();
+
+  //`````````````````````````````````
+  //      Checks 
+
+  tb->check(COND_fusion,    (core->fuse_o    ==  1)  &&
+                            (core->raddr1_o  ==  rs1));
+
+  //=================================
+  //      Tick (1)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  tb->_nop();
+
+  //`````````````````````````````````
+  //      Checks 
+
+  tb->check(COND_alu,       (core->alu_operand1_o      ==  rdata1)  &&
+                            (core->alu_operand2_o      ==  (0xFFFFFFFF >> shamt)) &&
+                            (core->alu_op_o            ==  Vtb_decode_w_fusion_ecap5_dproc_pkg::ALU_AND) &&
+                            (core->alu_operand1_reg_o  ==  rs1));
+  tb->check(COND_branch,    (core->branch_cond_o   ==  Vtb_decode_w_fusion_ecap5_dproc_pkg::NO_BRANCH));
+  tb->check(COND_writeback, (core->reg_write_o     ==  1)  &&
+                            (core->reg_addr_o      ==  rd));
+
+  //`````````````````````````````````
+  //      Formal Checks 
+  
+  CHECK("tb_decode_w_fusion.slli_srli.01",
+      tb->conditions[COND_fusion],
+      "Failed to detect the fused pair", tb->err_cycles[COND_fusion]);
+
+  CHECK("tb_decode_w_fusion.slli_srli.02",
+      tb->conditions[COND_alu],
+      "Failed to implement the alu protocol", tb->err_cycles[COND_alu]);
+
+  CHECK("tb_decode_w_fusion.slli_srli.03",
+      tb->conditions[COND_branch],
+      "Failed to implement the branch protocol", tb->err_cycles[COND_branch]);
+
+  CHECK("tb_decode_w_fusion.slli_srli.04",
+      tb->conditions[COND_writeback],
+      "Failed to implement the writeback protocol", tb->err_cycles[COND_writeback]);
+}
+
+void tb_decode_w_fusion_no_fusion(TB_Decode_w_fusion * tb) {
+  Vtb_decode_w_fusion * core = tb->core;
+  core->testcase = T_NO_FUSION;
+
+  // The following actions are performed in this test :
+  //    tick 0. Set inputs for LUI followed by ADDI writing another register
+  //    tick 1. Set inputs for LUI without the following instruction
+  //    tick 2. Set inputs for LUI followed by ADDI predicted taken
+  //    tick 3. Set inputs for LUI followed by ADDI writing x0
+  //    tick 4. Set inputs for SLLI followed by SRLI of another amount
+  //    tick 5. Nothing (core outputs the SLLI only)
+
+  //=================================
+  //      Tick (0)
+  
+  tb->reset();
+  
+  //`````````````````````````````````
+  //      Set inputs
+  
+  uint32_t pc = rand() & ~0x3;
+  uint32_t rd = 1 + rand() % 30;
+  uint32_t upper = rand() % 0x100000;
+  uint32_t lower = rand() % 0x1000;
+  tb->_pair(pc, instr_lui(rd, upper), instr_addi(rd + 1, rd, lower));
+
+  // this change is asynchronous
+  core->eval();
+
+  //`````````````````````````````````
+  //      Checks 
+
+  tb->check(COND_fusion,    (core->fuse_o  ==  0));
+
+  //=================================
+  //      Tick (1)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks 
+
+  tb->check(COND_alu,       (core->alu_operand2_o  ==  (upper << 12)) &&
+                            (core->pc_o            ==  pc));
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  tb->_pair(pc, instr_lui(rd, upper), instr_addi(rd, rd, lower));
+  core->next_valid_i = 0;
+
+  // this change is asynchronous
+  core->eval();
+
+  //`````````````````````````````````
+  //      Checks 
+
+  tb->check(COND_fusion,    (core->fuse_o  ==  0));
+
+  //=================================
+  //      Tick (2)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  tb->_pair(pc, instr_lui(rd, upper), instr_addi(rd, rd, lower));
+  core->next_pred_taken_i = 1;
+
+  // this change is asynchronous
+  core->eval();
+
+  //`````````````````````````````````
+  //      Checks 
+
+  tb->check(COND_fusion,    (core->fuse_o  ==  0));
+
+  //=================================
+  //      Tick (3)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  core->next_pred_taken_i = 0;
+  tb->_pair(pc, instr_lui(0, upper), instr_addi(0, 0, lower));
+
+  // this change is asynchronous
+  core->eval();
+
+  //`````````````````````````````````
+  //      Checks 
+
+  tb->check(COND_fusion,    (core->fuse_o  ==  0));
+
+  //=================================
+  //      Tick (4)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  uint32_t shamt = rand() % 31;
+  tb->_pair(pc, instr_slli(rd, rd, shamt), instr_srli(rd, rd, shamt + 1));
+
+  // this change is asynchronous
+  core->eval();
+
+  //`````````````````````````````````
+  //      Checks 
+
+  tb->check(COND_fusion,    (core->fuse_o  ==  0));
+
+  //=================================
+  //      Tick (5)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  tb->_nop();
+
+  //`````````````````````````````````
+  //      Checks 
+
+  tb->check(COND_alu,       (core->alu_operand2_o  ==  shamt) &&
+                            (core->alu_op_o        ==  Vtb_decode_w_fusion_ecap5_dproc_pkg::ALU_SHIFT));
+  tb->check(COND_counter,   (core->tb_decode_w_fusion->dut->fused_count_q  ==  0));
+
+  //`````````````````````````````````
+  //      Formal Checks 
+  
+  CHECK("tb_decode_w_fusion.no_fusion.01",
+      tb->conditions[COND_fusion],
+      "Failed to detect the fused pair", tb->err_cycles[COND_fusion]);
+
+  CHECK("tb_decode_w_fusion.no_fusion.02",
+      tb->conditions[COND_alu],
+      "Failed to implement the alu protocol", tb->err_cycles[COND_alu]);
+
+  CHECK("tb_decode_w_fusion.no_fusion.03",
+      tb->conditions[COND_counter],
+      "Failed to implement the fused pair counter", tb->err_cycles[COND_counter]);
+}
+
+void tb_decode_w_fusion_counter(TB_Decode_w_fusion * tb) {
+  Vtb_decode_w_fusion * core = tb->core;
+  core->testcase = T_COUNTER;
+
+  // The following actions are performed in this test :
+  //    tick 0. Set inputs for a fused pair
+  //    tick 1. Set inputs for a fused pair with a stall request
+  //    tick 2. Set inputs for a fused pair with a discard request
+  //    tick 3. Set inputs for a fused pair
+  //    tick 4. Nothing (two pairs were fused)
+
+  //=================================
+  //      Tick (0)
+  
+  tb->reset();
+  
+  //`````````````````````````````````
+  //      Checks 
+
+  tb->check(COND_counter,   (core->tb_decode_w_fusion->dut->fused_count_q  ==  0));
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  uint32_t pc = rand() & ~0x3;
+  uint32_t rd = 1 + rand() % 31;
+  tb->_pair(pc, instr_lui(rd, rand() % 0x100000), instr_addi(rd, rd, rand() % 0x1000));
+
+  //=================================
+  //      Tick (1)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks 
+
+  tb->check(COND_counter,   (core->tb_decode_w_fusion->dut->fused_count_q  ==  1));
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  core->stall_request_i = 1;
+
+  //=================================
+  //      Tick (2)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks 
+
+  tb->check(COND_counter,   (core->tb_decode_w_fusion->dut->fused_count_q  ==  1));
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  core->stall_request_i = 0;
+  core->discard_request_i = 1;
+
+  //=================================
+  //      Tick (3)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks 
+
+  tb->check(COND_counter,   (core->tb_decode_w_fusion->dut->fused_count_q  ==  1));
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  core->discard_request_i = 0;
+
+  //=================================
+  //      Tick (4)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  tb->_nop();
+
+  //`````````````````````````````````
+  //      Checks 
+
+  tb->check(COND_counter,   (core->tb_decode_w_fusion->dut->fused_count_q  ==  2));
+
+  //`````````````````````````````````
+  //      Formal Checks 
+  
+  CHECK("tb_decode_w_fusion.counter.01",
+      tb->conditions[COND_counter],
+      "Failed to implement the fused pair counter", tb->err_cycles[COND_counter]);
+}
+
+int main(int argc, char ** argv, char ** env) {
+  srand(time(NULL));
+  Verilated::traceEverOn(true);
+
+  bool verbose = parse_verbose(argc, argv);
+
+  TB_Decode_w_fusion * tb = new TB_Decode_w_fusion;
+  tb->open_trace("waves/decode_w_fusion.vcd");
+  tb->open_testdata("testdata/decode_w_fusion.csv");
+  tb->set_debug_log(verbose);
+  tb->init_conditions(__CondIdEnd);
+
+  /************************************************************/
+
+  tb_decode_w_fusion_lui_addi(tb);
+  tb_decode_w_fusion_auipc_addi(tb);
+  tb_decode_w_fusion_auipc_jalr(tb);
+  tb_decode_w_fusion_slli_srli(tb);
+  tb_decode_w_fusion_no_fusion(tb);
+  tb_decode_w_fusion_counter(tb);
+
+  /************************************************************/
+
+  printf("[DECODE_W_FUSION]: ");
+  if(tb->success) {
+    printf("Done\n");
+  } else {
+    printf("Failed\n");
+  }
+
+  delete tb;
+  exit(EXIT_SUCCESS);
+}
@@ -49,7 +49,62 @@ ecap5_dproc dut (
   .wb_stb_o   (wb_stb_o),
   .wb_ack_i   (wb_ack_i),
   .wb_cyc_o   (wb_cyc_o),
-  .wb_stall_i (wb_stall_i)
+  .wb_stall_i (wb_stall_i),
+  .wb_cti_o   (),
+  .wb_bte_o   (),
+
+  .ibus_adr_o   (),
+  .ibus_dat_i   ('0),
+  .ibus_sel_o   (),
+  .ibus_we_o    (),
+  .ibus_stb_o   (),
+  .ibus_ack_i   (0),
+  .ibus_cyc_o   (),
+  .ibus_stall_i (0),
+  .ibus_cti_o   (),
+  .ibus_bte_o   (),
+
+  .dbus_adr_o   (),
+  .dbus_dat_i   ('0),
+  .dbus_dat_o   (),
+  .dbus_sel_o   (),
+  .dbus_we_o    (),
+  .dbus_stb_o   (),
+  .dbus_ack_i   (0),
+  .dbus_cyc_o   (),
+  .dbus_stall_i (0),
+  .dbus_cti_o   (),
+  .dbus_bte_o   (),
+
+  .axi_awaddr_o   (),
+  .axi_awlen_o    (),
+  .axi_awsize_o   (),
+  .axi_awburst_o  (),
+  .axi_awvalid_o  (),
+  .axi_awready_i  (0),
+  .axi_wdata_o    (),
+  .axi_wstrb_o    (),
+  .axi_wlast_o    (),
+  .axi_wvalid_o   (),
+  .axi_wready_i   (0),
+  .axi_bresp_i    ('0),
+  .axi_bvalid_i   (0),
+  .axi_bready_o   (),
+  .axi_araddr_o   (),
+  .axi_arlen_o    (),
+  .axi_arsize_o   (),
+  .axi_arburst_o  (),
+  .axi_arvalid_o  (),
+  .axi_arready_i  (0),
+  .axi_rdata_i    ('0),
+  .axi_rresp_i    ('0),
+  .axi_rlast_i    (0),
+  .axi_rvalid_i   (0),
+  .axi_rready_o   (),
+
+  .reservation_valid_o (),
+  .reservation_adr_o   (),
+  .reservation_kill_i  (0)
 );
 
 endmodule // ecap5_dproc
@@ -0,0 +1,732 @@
+/*           __        _
+ *  ________/ /  ___ _(_)__  ___
+ * / __/ __/ _ \/ _ `/ / _ \/ -_)
+ * \__/\__/_//_/\_,_/_/_//_/\__/
+ * 
+ * Copyright (C) Clément Chaine
+ * This file is part of ECAP5-DPROC <https://github.com/ecap5/ECAP5-DPROC>
+ *
+ * ECAP5-DPROC is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ECAP5-DPROC is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ECAP5-DPROC.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <verilated.h>
+#include <verilated_vcd_c.h>
+#include <svdpi.h>
+#include <map>
+#include <vector>
+
+#include "Vtb_ecap5_dproc_perf_ecap5_dproc_pkg.h"
+#include "Vtb_ecap5_dproc_perf_riscv_pkg.h"
+#include "Vtb_ecap5_dproc_perf.h"
+#include "Vtb_ecap5_dproc_perf_tb_ecap5_dproc_perf.h"
+#include "testbench.h"
+#include "riscv.h"
+
+enum CondId {
+  COND_stall,
+  COND_throughput,
+  COND_registers,
+  COND_memory,
+  COND_branch,
+  __CondIdEnd
+};
+
+enum TestcaseId {
+  T_ALU_CHAIN       =  1,
+  T_ALU_DISTANCE    =  2,
+  T_LOAD_USE        =  3,
+  T_STORE_DATA      =  4,
+  T_BRANCH          =  5,
+  T_BRANCH_DEP      =  6,
+  T_LOOP            =  7,
+  T_FORWARD_BRANCH  =  8,
+  T_CALL_RETURN     =  9
+};
+
+struct RegWrite {
+  uint32_t cycle;
+  uint32_t addr;
+  uint32_t data;
+};
+
+class TB_Ecap5_dproc_perf : public Testbench<Vtb_ecap5_dproc_perf> {
+public:
+  // Memory model, unmapped addresses are read as NOP instructions
+  std::map<uint32_t, uint32_t> memory;
+  uint32_t cycle;
+  // Register writes performed by the writeback stage
+  std::vector<RegWrite> writes;
+  bool stalled;
+
+  void reset() {
+    this->_nop();
+    this->core->rst_i = 1;
+    for(int i = 0; i < 5; i++) {
+      this->tick();
+    }
+    this->core->rst_i = 0;
+
+    this->cycle = 0;
+    this->writes.clear();
+    this->stalled = false;
+
+    Testbench<Vtb_ecap5_dproc_perf>::reset();
+  }
+
+  void tick() {
+    // Requests are acknowledged during the cycle they are issued. As the bus
+    // is never stalled, a new request can be accepted on every cycle.
+    uint32_t data = 0;
+    uint8_t ack = 0;
+    if((this->core->wb_stb_o == 1) && (this->core->wb_cyc_o == 1)) {
+      if(this->core->wb_we_o == 0) {
+        data = this->read(this->core->wb_adr_o);
+      } else {
+        this->memory[this->core->wb_adr_o] = this->core->wb_dat_o;
+      }
+      ack = 1;
+    }
+    this->core->wb_dat_i = data;
+    this->core->wb_ack_i = ack;
+
+    Testbench<Vtb_ecap5_dproc_perf>::tick();
+
+    if(this->core->tb_ecap5_dproc_perf->reg_write && (this->core->tb_ecap5_dproc_perf->reg_waddr != 0)) {
+      this->writes.push_back({this->cycle,
+                              this->core->tb_ecap5_dproc_perf->reg_waddr,
+                              this->core->tb_ecap5_dproc_perf->reg_wdata});
+    }
+    if(this->core->tb_ecap5_dproc_perf->hzd_dec_stall_request) {
+      this->stalled = true;
+    }
+    this->cycle += 1;
+  }
+
+  void _nop() {
+    this->core->wb_dat_i = 0;
+    this->core->wb_ack_i = 0;
+    this->core->wb_stall_i = 0;
+  }
+
+  uint32_t read(uint32_t adr) {
+    auto it = this->memory.find(adr);
+    if(it == this->memory.end()) {
+      return instr_addi(0, 0, 0);
+    }
+    return it->second;
+  }
+
+  void load_program(std::vector<uint32_t> program) {
+    this->memory.clear();
+    for(size_t i = 0; i < program.size(); i++) {
+      this->memory[this->core->tb_ecap5_dproc_perf->BOOT_ADDRESS + 4 * i] = program[i];
+    }
+  }
+
+  void run(uint32_t cycles) {
+    for(uint32_t i = 0; i < cycles; i++) {
+      this->tick();
+    }
+  }
+
+  // Checks that the register writes were performed on consecutive cycles
+  bool back_to_back() {
+    for(size_t i = 1; i < this->writes.size(); i++) {
+      if(this->writes[i].cycle != this->writes[i-1].cycle + 1) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // Returns the index of the first write to a register, or -1
+  int find_write(uint32_t addr) {
+    for(size_t i = 0; i < this->writes.size(); i++) {
+      if(this->writes[i].addr == addr) {
+        return i;
+      }
+    }
+    return -1;
+  }
+
+  void set_register(uint8_t addr, uint32_t value) {
+    const svScope scope = svGetScopeFromName("TOP.tb_ecap5_dproc_perf.dut.registers_inst");
+    assert(scope);
+    svSetScope(scope);
+    this->core->set_register_value((svLogicVecVal*)&addr, (svLogicVecVal*)&value); 
+  }
+
+  uint32_t get_register(uint8_t addr) {
+    const svScope scope = svGetScopeFromName("TOP.tb_ecap5_dproc_perf.dut.registers_inst");
+    assert(scope);
+    svSetScope(scope);
+    svLogicVecVal value;
+    this->core->get_register_value((svLogicVecVal*)&addr, &value); 
+    return value.aval;
+  }
+};
+
+void tb_ecap5_dproc_perf_alu_chain(TB_Ecap5_dproc_perf * tb) {
+  Vtb_ecap5_dproc_perf * core = tb->core;
+  core->testcase = T_ALU_CHAIN;
+
+  // The following actions are performed in this test :
+  //    tick 0. Load a chain of dependent ADDI instructions
+  //    tick 1-59. Nothing (core executes the program)
+
+  //=================================
+  //      Tick (0)
+  
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  const uint32_t length = 16;
+  std::vector<uint32_t> program;
+  for(uint32_t i = 0; i < length; i++) {
+    program.push_back(instr_addi(1, 1, 1));
+  }
+  tb->load_program(program);
+  tb->set_register(1, 0);
+
+  //=================================
+  //      Tick (1-59)
+  
+  tb->run(59);
+
+  //`````````````````````````````````
+  //      Checks 
+
+  tb->check(COND_stall, !tb->stalled);
+  tb->check(COND_throughput, (tb->writes.size() == length) && tb->back_to_back());
+  for(size_t i = 0; i < tb->writes.size(); i++) {
+    tb->check(COND_registers, (tb->writes[i].addr == 1) &&
+                              (tb->writes[i].data == i + 1));
+  }
+  tb->check(COND_registers, (tb->get_register(1) == length));
+
+  //`````````````````````````````````
+  //      Formal Checks 
+  
+  CHECK("tb_ecap5_dproc_perf.alu_chain.01",
+      tb->conditions[COND_stall],
+      "Failed to execute dependent instructions without stalling", tb->err_cycles[COND_stall]);
+
+  CHECK("tb_ecap5_dproc_perf.alu_chain.02",
+      tb->conditions[COND_throughput],
+      "Failed to execute one instruction per cycle", tb->err_cycles[COND_throughput]);
+
+  CHECK("tb_ecap5_dproc_perf.alu_chain.03",
+      tb->conditions[COND_registers],
+      "Failed to forward the results", tb->err_cycles[COND_registers]);
+}
+
+void tb_ecap5_dproc_perf_alu_distance(TB_Ecap5_dproc_perf * tb) {
+  Vtb_ecap5_dproc_perf * core = tb->core;
+  core->testcase = T_ALU_DISTANCE;
+
+  // The following actions are performed in this test :
+  //    tick 0. Load instructions depending on results at every distance
+  //    tick 1-59. Nothing (core executes the program)
+
+  //=================================
+  //      Tick (0)
+  
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  uint32_t a = rand() % 0x7FF;
+  uint32_t b = rand() % 0x7FF;
+  tb->load_program({
+    instr_addi(1, 0, a),
+    instr_addi(2, 0, b),
+    instr_add(3, 1, 2),   // x1 at distance 2, x2 at distance 1
+    instr_addi(4, 0, 1),
+    instr_add(5, 3, 1),   // x3 at distance 2, x1 at distance 4
+    instr_add(6, 5, 5),   // x5 at distance 1 on both ports
+    instr_add(7, 6, 3)    // x6 at distance 1, x3 at distance 3
+  });
+
+  //=================================
+  //      Tick (1-59)
+  
+  tb->run(59);
+
+  //`````````````````````````````````
+  //      Checks 
+
+  tb->check(COND_stall, !tb->stalled);
+  tb->check(COND_throughput, (tb->writes.size() == 7) && tb->back_to_back());
+  tb->check(COND_registers, (tb->get_register(3) == a + b)           &&
+                            (tb->get_register(5) == 2 * a + b)       &&
+                            (tb->get_register(6) == 4 * a + 2 * b)   &&
+                            (tb->get_register(7) == 5 * a + 3 * b));
+
+  //`````````````````````````````````
+  //      Formal Checks 
+  
+  CHECK("tb_ecap5_dproc_perf.alu_distance.01",
+      tb->conditions[COND_stall],
+      "Failed to execute dependent instructions without stalling", tb->err_cycles[COND_stall]);
+
+  CHECK("tb_ecap5_dproc_perf.alu_distance.02",
+      tb->conditions[COND_throughput],
+      "Failed to execute one instruction per cycle", tb->err_cycles[COND_throughput]);
+
+  CHECK("tb_ecap5_dproc_perf.alu_distance.03",
+      tb->conditions[COND_registers],
+      "Failed to forward the results", tb->err_cycles[COND_registers]);
+}
+
+void tb_ecap5_dproc_perf_load_use(TB_Ecap5_dproc_perf * tb) {
+  Vtb_ecap5_dproc_perf * core = tb->core;
+  core->testcase = T_LOAD_USE;
+
+  // The following actions are performed in this test :
+  //    tick 0. Load a program using a loaded value right after the load
+  //    tick 1-79. Nothing (core executes the program)
+
+  //=================================
+  //      Tick (0)
+  
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  tb->load_program({
+    instr_lw(2, 0, 0x100),
+    instr_addi(3, 2, 1),
+    instr_addi(4, 3, 1)
+  });
+  uint32_t value = rand();
+  tb->memory[0x100] = value;
+
+  //=================================
+  //      Tick (1-79)
+  
+  tb->run(79);
+
+  //`````````````````````````````````
+  //      Checks 
+
+  tb->check(COND_stall, tb->stalled);
+  tb->check(COND_registers, (tb->get_register(2) == value)      &&
+                            (tb->get_register(3) == value + 1)  &&
+                            (tb->get_register(4) == value + 2));
+
+  //`````````````````````````````````
+  //      Formal Checks 
+  
+  CHECK("tb_ecap5_dproc_perf.load_use.01",
+      tb->conditions[COND_stall],
+      "Failed to stall on a load-use hazard", tb->err_cycles[COND_stall]);
+
+  CHECK("tb_ecap5_dproc_perf.load_use.02",
+      tb->conditions[COND_registers],
+      "Failed to forward the loaded data", tb->err_cycles[COND_registers]);
+}
+
+void tb_ecap5_dproc_perf_store_data(TB_Ecap5_dproc_perf * tb) {
+  Vtb_ecap5_dproc_perf * core = tb->core;
+  core->testcase = T_STORE_DATA;
+
+  // The following actions are performed in this test :
+  //    tick 0. Load a program storing results right after computing them
+  //    tick 1-79. Nothing (core executes the program)
+
+  //=================================
+  //      Tick (0)
+  
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  uint32_t a = rand() % 0x7FF;
+  tb->load_program({
+    instr_addi(5, 0, a),
+    instr_sw(0, 5, 0x200),
+    instr_addi(6, 5, 1),
+    instr_sw(0, 6, 0x204)
+  });
+
+  //=================================
+  //      Tick (1-79)
+  
+  tb->run(79);
+
+  //`````````````````````````````````
+  //      Checks 
+
+  tb->check(COND_stall, !tb->stalled);
+  tb->check(COND_memory, (tb->read(0x200) == a) &&
+                         (tb->read(0x204) == a + 1));
+
+  //`````````````````````````````````
+  //      Formal Checks 
+  
+  CHECK("tb_ecap5_dproc_perf.store_data.01",
+      tb->conditions[COND_stall],
+      "Failed to store a result without stalling", tb->err_cycles[COND_stall]);
+
+  CHECK("tb_ecap5_dproc_perf.store_data.02",
+      tb->conditions[COND_memory],
+      "Failed to forward the store data", tb->err_cycles[COND_memory]);
+}
+
+void tb_ecap5_dproc_perf_branch(TB_Ecap5_dproc_perf * tb) {
+  Vtb_ecap5_dproc_perf * core = tb->core;
+  core->testcase = T_BRANCH;
+
+  // The following actions are performed in this test :
+  //    tick 0. Load a program with a taken jump and a taken branch
+  //    tick 1-59. Nothing (core executes the program)
+
+  //=================================
+  //      Tick (0)
+  
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  tb->load_program({
+    instr_addi(1, 0, 1),
+    instr_jal(5, 8),
+    instr_addi(2, 0, 2),  // skipped
+    instr_addi(3, 0, 3),
+    instr_beq(0, 0, 8),
+    instr_addi(4, 0, 4),  // skipped
+    instr_addi(6, 0, 6)
+  });
+
+  //=================================
+  //      Tick (1-59)
+  
+  tb->run(59);
+
+  //`````````````````````````````````
+  //      Checks 
+
+  int x1 = tb->find_write(1);
+  int x5 = tb->find_write(5);
+  int x3 = tb->find_write(3);
+  int x6 = tb->find_write(6);
+  tb->check(COND_registers, (x1 >= 0) && (x5 >= 0) && (x3 >= 0) && (x6 >= 0) &&
+                            (tb->find_write(2) < 0) && (tb->find_write(4) < 0) &&
+                            (tb->writes[x5].data == core->tb_ecap5_dproc_perf->BOOT_ADDRESS + 8));
+  // When resolved in the execute module, the jump and branch are followed by
+  // four bubbles. Only two bubbles shall remain when resolved in decode.
+  tb->check(COND_branch, (x5 >= 0) && (x3 >= 0) && (x6 >= 0) &&
+                         (tb->writes[x3].cycle - tb->writes[x5].cycle <= 3) &&
+                         (tb->writes[x6].cycle - tb->writes[x3].cycle <= 4));
+
+  //`````````````````````````````````
+  //      Formal Checks 
+  
+  CHECK("tb_ecap5_dproc_perf.branch.01",
+      tb->conditions[COND_registers],
+      "Failed to perform the jump and branch", tb->err_cycles[COND_registers]);
+
+  CHECK("tb_ecap5_dproc_perf.branch.02",
+      tb->conditions[COND_branch],
+      "Failed to reduce the branch penalty", tb->err_cycles[COND_branch]);
+}
+
+void tb_ecap5_dproc_perf_branch_dependency(TB_Ecap5_dproc_perf * tb) {
+  Vtb_ecap5_dproc_perf * core = tb->core;
+  core->testcase = T_BRANCH_DEP;
+
+  // The following actions are performed in this test :
+  //    tick 0. Load a program with branches depending on previous results
+  //    tick 1-79. Nothing (core executes the program)
+
+  //=================================
+  //      Tick (0)
+  
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  tb->load_program({
+    instr_addi(1, 0, 5),
+    instr_bne(1, 0, 8),   // taken
+    instr_addi(2, 0, 2),  // skipped
+    instr_addi(3, 1, 1),
+    instr_beq(3, 0, 8),   // not taken
+    instr_addi(4, 0, 4),
+    instr_blt(0, 3, 8),   // taken
+    instr_addi(7, 0, 7),  // skipped
+    instr_addi(8, 0, 8)
+  });
+
+  //=================================
+  //      Tick (1-79)
+  
+  tb->run(79);
+
+  //`````````````````````````````````
+  //      Checks 
+
+  tb->check(COND_branch, (tb->find_write(2) < 0) &&
+                         (tb->find_write(4) >= 0) &&
+                         (tb->find_write(7) < 0) &&
+                         (tb->find_write(8) >= 0));
+  tb->check(COND_registers, (tb->get_register(3) == 6) &&
+                            (tb->get_register(4) == 4) &&
+                            (tb->get_register(8) == 8));
+
+  //`````````````````````````````````
+  //      Formal Checks 
+  
+  CHECK("tb_ecap5_dproc_perf.branch_dependency.01",
+      tb->conditions[COND_branch],
+      "Failed to resolve branches depending on previous results", tb->err_cycles[COND_branch]);
+
+  CHECK("tb_ecap5_dproc_perf.branch_dependency.02",
+      tb->conditions[COND_registers],
+      "Failed to execute the program", tb->err_cycles[COND_registers]);
+}
+
+void tb_ecap5_dproc_perf_loop(TB_Ecap5_dproc_perf * tb) {
+  Vtb_ecap5_dproc_perf * core = tb->core;
+  core->testcase = T_LOOP;
+
+  // The following actions are performed in this test :
+  //    tick 0. Load a program with a loop closed by a backward branch
+  //    tick 1-79. Nothing (core executes the program)
+
+  //=================================
+  //      Tick (0)
+  
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  const uint32_t iterations = 8;
+  tb->load_program({
+    instr_addi(1, 0, iterations),
+    instr_addi(1, 1, -1),
+    instr_addi(2, 2, 1),
+    instr_addi(4, 4, 2),
+    instr_bne(1, 0, -12),
+    instr_addi(3, 0, 3)
+  });
+  tb->set_register(2, 0);
+  tb->set_register(4, 0);
+
+  //=================================
+  //      Tick (1-79)
+  
+  tb->run(79);
+
+  //`````````````````````````````````
+  //      Checks 
+
+  tb->check(COND_registers, (tb->get_register(1) == 0) &&
+                            (tb->get_register(2) == iterations) &&
+                            (tb->get_register(4) == 2 * iterations) &&
+                            (tb->get_register(3) == 3));
+  // The backward branch is predicted taken, an iteration of the loop shall
+  // not take longer than the execution of its four instructions.
+  std::vector<uint32_t> cycles;
+  for(size_t i = 0; i < tb->writes.size(); i++) {
+    if(tb->writes[i].addr == 2) {
+      cycles.push_back(tb->writes[i].cycle);
+    }
+  }
+  tb->check(COND_branch, (cycles.size() == iterations));
+  for(size_t i = 1; i < cycles.size(); i++) {
+    tb->check(COND_branch, (cycles[i] - cycles[i-1] == 4));
+  }
+
+  //`````````````````````````````````
+  //      Formal Checks 
+  
+  CHECK("tb_ecap5_dproc_perf.loop.01",
+      tb->conditions[COND_registers],
+      "Failed to execute the loop", tb->err_cycles[COND_registers]);
+
+  CHECK("tb_ecap5_dproc_perf.loop.02",
+      tb->conditions[COND_branch],
+      "Failed to remove the penalty of the predicted branch", tb->err_cycles[COND_branch]);
+}
+
+void tb_ecap5_dproc_perf_forward_branch(TB_Ecap5_dproc_perf * tb) {
+  Vtb_ecap5_dproc_perf * core = tb->core;
+  core->testcase = T_FORWARD_BRANCH;
+
+  // The following actions are performed in this test :
+  //    tick 0. Load a loop containing an always taken forward branch
+  //    tick 1-99. Nothing (core executes the program)
+
+  //=================================
+  //      Tick (0)
+  
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  const uint32_t iterations = 8;
+  tb->load_program({
+    instr_addi(1, 0, iterations),
+    instr_addi(1, 1, -1),
+    instr_addi(2, 2, 1),
+    instr_beq(0, 0, 8),   // taken, predicted not taken by the static prediction
+    instr_addi(6, 0, 6),  // skipped
+    instr_bne(1, 0, -16),
+    instr_addi(3, 0, 3)
+  });
+  tb->set_register(2, 0);
+
+  //=================================
+  //      Tick (1-99)
+  
+  tb->run(99);
+
+  //`````````````````````````````````
+  //      Checks 
+
+  tb->check(COND_registers, (tb->get_register(2) == iterations) &&
+                            (tb->get_register(3) == 3) &&
+                            (tb->find_write(6) < 0));
+  // Both branches are resolved once per iteration. The forward branch is
+  // only mispredicted until allocated in the branch predictor, the loop
+  // branch being mispredicted on exit.
+  tb->check(COND_branch, (core->tb_ecap5_dproc_perf->bp_branch_count == 2 * iterations) &&
+                         (core->tb_ecap5_dproc_perf->bp_mispredict_count <= 2));
+
+  //`````````````````````````````````
+  //      Formal Checks 
+  
+  CHECK("tb_ecap5_dproc_perf.forward_branch.01",
+      tb->conditions[COND_registers],
+      "Failed to execute the loop", tb->err_cycles[COND_registers]);
+
+  CHECK("tb_ecap5_dproc_perf.forward_branch.02",
+      tb->conditions[COND_branch],
+      "Failed to predict the branches from their history", tb->err_cycles[COND_branch]);
+}
+
+void tb_ecap5_dproc_perf_call_return(TB_Ecap5_dproc_perf * tb) {
+  Vtb_ecap5_dproc_perf * core = tb->core;
+  core->testcase = T_CALL_RETURN;
+
+  // The following actions are performed in this test :
+  //    tick 0. Load a loop calling a function
+  //    tick 1-99. Nothing (core executes the program)
+
+  //=================================
+  //      Tick (0)
+  
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  const uint32_t iterations = 8;
+  tb->load_program({
+    instr_addi(10, 0, iterations),
+    instr_addi(10, 10, -1),
+    instr_jal(1, 16),     // call
+    instr_bne(10, 0, -8),
+    instr_addi(3, 0, 3),
+    instr_jal(0, 0),
+    instr_addi(11, 11, 1),
+    instr_jalr(0, 1, 0)   // return
+  });
+  tb->set_register(11, 0);
+
+  //=================================
+  //      Tick (1-99)
+  
+  tb->run(99);
+
+  //`````````````````````````````````
+  //      Checks 
+
+  tb->check(COND_registers, (tb->get_register(10) == 0) &&
+                            (tb->get_register(11) == iterations) &&
+                            (tb->get_register(3) == 3));
+  // The return is predicted from the return address stack, an iteration
+  // shall not take longer than the execution of its five instructions.
+  std::vector<uint32_t> cycles;
+  for(size_t i = 0; i < tb->writes.size(); i++) {
+    if(tb->writes[i].addr == 11) {
+      cycles.push_back(tb->writes[i].cycle);
+    }
+  }
+  tb->check(COND_branch, (cycles.size() == iterations));
+  for(size_t i = 1; i < cycles.size(); i++) {
+    tb->check(COND_branch, (cycles[i] - cycles[i-1] == 5));
+  }
+
+  //`````````````````````````````````
+  //      Formal Checks 
+  
+  CHECK("tb_ecap5_dproc_perf.call_return.01",
+      tb->conditions[COND_registers],
+      "Failed to execute the function calls", tb->err_cycles[COND_registers]);
+
+  CHECK("tb_ecap5_dproc_perf.call_return.02",
+      tb->conditions[COND_branch],
+      "Failed to remove the penalty of the predicted return", tb->err_cycles[COND_branch]);
+}
+
+int main(int argc, char ** argv, char ** env) {
+  srand(time(NULL));
+  Verilated::traceEverOn(true);
+
+  bool verbose = parse_verbose(argc, argv);
+
+  TB_Ecap5_dproc_perf * tb = new TB_Ecap5_dproc_perf;
+  tb->open_trace("waves/ecap5_dproc_perf.vcd");
+  tb->open_testdata("testdata/ecap5_dproc_perf.csv");
+  tb->set_debug_log(verbose);
+  tb->init_conditions(__CondIdEnd);
+
+  /************************************************************/
+
+  tb_ecap5_dproc_perf_alu_chain(tb);
+  tb_ecap5_dproc_perf_alu_distance(tb);
+  tb_ecap5_dproc_perf_load_use(tb);
+  tb_ecap5_dproc_perf_store_data(tb);
+  tb_ecap5_dproc_perf_branch(tb);
+  tb_ecap5_dproc_perf_branch_dependency(tb);
+  tb_ecap5_dproc_perf_loop(tb);
+  tb_ecap5_dproc_perf_forward_branch(tb);
+  tb_ecap5_dproc_perf_call_return(tb);
+
+  /************************************************************/
+
+  printf("[ECAP5_DPROC_PERF]: ");
+  if(tb->success) {
+    printf("Done\n");
+  } else {
+    printf("Failed\n");
+  }
+
+  delete tb;
+  exit(EXIT_SUCCESS);
+}
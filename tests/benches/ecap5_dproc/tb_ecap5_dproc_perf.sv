@@ -0,0 +1,146 @@
+/*           __        _
+ *  ________/ /  ___ _(_)__  ___
+ * / __/ __/ _ \/ _ `/ / _ \/ -_)
+ * \__/\__/_//_/\_,_/_/_//_/\__/
+ * 
+ * Copyright (C) Clément Chaine
+ * This file is part of ECAP5-DPROC <https://github.com/ecap5/ECAP5-DPROC>
+ *
+ * ECAP5-DPROC is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ECAP5-DPROC is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ECAP5-DPROC.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+module tb_ecap5_dproc_perf (
+  input   int          testcase,
+
+  input  logic        clk_i,
+  input  logic        rst_i,
+
+  output logic[31:0]  wb_adr_o,
+  input  logic[31:0]  wb_dat_i,
+  output logic[31:0]  wb_dat_o,
+  output logic[3:0]   wb_sel_o,
+  output logic        wb_we_o,
+  output logic        wb_stb_o,
+  input  logic        wb_ack_i,
+  output logic        wb_cyc_o,
+  input  logic        wb_stall_i
+);
+
+localparam logic[31:0] BOOT_ADDRESS = 32'h00001000;
+
+// Internal signals of the parameterized core
+logic        reg_write;
+logic[4:0]   reg_waddr;
+logic[31:0]  reg_wdata;
+logic        hzd_dec_stall_request;
+logic[31:0]  bp_branch_count;
+logic[31:0]  bp_mispredict_count;
+
+ecap5_dproc #(
+  .BOOT_ADDRESS         (BOOT_ADDRESS),
+  .PIPELINED_FETCH      (1),
+  .PREFETCH_QUEUE_DEPTH (2),
+  .FORWARDING           (1),
+  .DECODE_BRANCH        (1),
+  .BRANCH_PREDICTION    (1),
+  .BRANCH_PREDICTOR     (1),
+  .RAS_DEPTH            (4)
+) dut (
+  .clk_i      (clk_i),
+  .rst_i      (rst_i),
+
+  .wb_adr_o   (wb_adr_o),
+  .wb_dat_i   (wb_dat_i),
+  .wb_dat_o   (wb_dat_o),
+  .wb_sel_o   (wb_sel_o),
+  .wb_we_o    (wb_we_o),
+  .wb_stb_o   (wb_stb_o),
+  .wb_ack_i   (wb_ack_i),
+  .wb_cyc_o   (wb_cyc_o),
+  .wb_stall_i (wb_stall_i),
+  .wb_cti_o   (),
+  .wb_bte_o   (),
+
+  .ibus_adr_o   (),
+  .ibus_dat_i   ('0),
+  .ibus_sel_o   (),
+  .ibus_we_o    (),
+  .ibus_stb_o   (),
+  .ibus_ack_i   (0),
+  .ibus_cyc_o   (),
+  .ibus_stall_i (0),
+  .ibus_cti_o   (),
+  .ibus_bte_o   (),
+
+  .dbus_adr_o   (),
+  .dbus_dat_i   ('0),
+  .dbus_dat_o   (),
+  .dbus_sel_o   (),
+  .dbus_we_o    (),
+  .dbus_stb_o   (),
+  .dbus_ack_i   (0),
+  .dbus_cyc_o   (),
+  .dbus_stall_i (0),
+  .dbus_cti_o   (),
+  .dbus_bte_o   (),
+
+  .axi_awaddr_o   (),
+  .axi_awlen_o    (),
+  .axi_awsize_o   (),
+  .axi_awburst_o  (),
+  .axi_awvalid_o  (),
+  .axi_awready_i  (0),
+  .axi_wdata_o    (),
+  .axi_wstrb_o    (),
+  .axi_wlast_o    (),
+  .axi_wvalid_o   (),
+  .axi_wready_i   (0),
+  .axi_bresp_i    ('0),
+  .axi_bvalid_i   (0),
+  .axi_bready_o   (),
+  .axi_araddr_o   (),
+  .axi_arlen_o    (),
+  .axi_arsize_o   (),
+  .axi_arburst_o  (),
+  .axi_arvalid_o  (),
+  .axi_arready_i  (0),
+  .axi_rdata_i    ('0),
+  .axi_rresp_i    ('0),
+  .axi_rlast_i    (0),
+  .axi_rvalid_i   (0),
+  .axi_rready_o   (),
+
+  .reservation_valid_o (),
+  .reservation_adr_o   (),
+  .reservation_kill_i  (0)
+);
+
+assign reg_write              = dut.reg_write;
+assign reg_waddr              = dut.reg_waddr;
+assign reg_wdata              = dut.reg_wdata;
+assign hzd_dec_stall_request  = dut.hzd_dec_stall_request;
+assign bp_branch_count        = dut.branch_predictor_gen.branch_predictor_inst.branch_count_q;
+assign bp_mispredict_count    = dut.branch_predictor_gen.branch_predictor_inst.mispredict_count_q;
+
+endmodule // tb_ecap5_dproc_perf
+
+`verilator_config
+
+public -module "tb_ecap5_dproc_perf" -var "BOOT_ADDRESS"
+public -module "tb_ecap5_dproc_perf" -var "reg_write"
+public -module "tb_ecap5_dproc_perf" -var "reg_waddr"
+public -module "tb_ecap5_dproc_perf" -var "reg_wdata"
+public -module "tb_ecap5_dproc_perf" -var "hzd_dec_stall_request"
+public -module "tb_ecap5_dproc_perf" -var "bp_branch_count"
+public -module "tb_ecap5_dproc_perf" -var "bp_mispredict_count"
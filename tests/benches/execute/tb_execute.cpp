@@ -36,6 +36,7 @@ enum CondId {
   COND_result,
   COND_branch,
   COND_output_valid,
+  COND_predictor,
   __CondIdEnd
 };
 
@@ -62,7 +63,11 @@ enum TestcaseId {
   T_PIPELINE_WAIT              =  20,
   T_RESET                       =  21,
   T_BRANCH_JALR                 =  22,
-  T_HAZARD                      =  23
+  T_HAZARD                      =  23,
+  T_BRANCH_PREDICTED            =  24,
+  T_JALR_PREDICTED              =  25,
+  T_JALR_COMPRESSED             =  26,
+  T_ALU_BITMANIP                =  27
 };
 
 class TB_Execute : public Testbench<Vtb_execute> {
@@ -96,10 +101,15 @@ public:
     this->core->alu_sub_i = 0;
     this->core->alu_shift_left_i = 0;
     this->core->alu_signed_shift_i = 0;
+    this->core->muldiv_enable_i = 0;
+    this->core->muldiv_op_i = 0;
+    this->core->compressed_i = 0;
     this->core->reg_write_i = 0;
     this->core->reg_addr_i = 0;
     this->core->branch_cond_i = Vtb_execute_ecap5_dproc_pkg::NO_BRANCH;
     this->core->branch_offset_i = 0;
+    this->core->pred_taken_i = 0;
+    this->core->pred_target_i = 0;
   }
 
   void _add(uint32_t operand1, uint32_t operand2, uint32_t reg_addr) {
@@ -113,6 +123,68 @@ public:
     this->core->reg_addr_i = reg_addr;
   }
 
+  void _bitmanip(uint8_t op, uint32_t operand1, uint32_t operand2, uint32_t reg_addr) {
+    this->_nop();
+    this->core->alu_operand1_i = operand1;
+    this->core->alu_operand2_i = operand2;
+    this->core->alu_op_i = op;
+    this->core->branch_cond_i = 0;
+    this->core->reg_write_i = 1;
+    this->core->reg_addr_i = reg_addr;
+  }
+
+  // Reference model of the operations of the bit-manipulation extensions
+  static uint32_t bitmanip(uint8_t op, uint32_t a, uint32_t b) {
+    uint32_t shamt = b & 0x1F;
+    uint32_t result = 0;
+    switch(op) {
+      case Vtb_execute_ecap5_dproc_pkg::ALU_SH1ADD: return (a << 1) + b;
+      case Vtb_execute_ecap5_dproc_pkg::ALU_SH2ADD: return (a << 2) + b;
+      case Vtb_execute_ecap5_dproc_pkg::ALU_SH3ADD: return (a << 3) + b;
+      case Vtb_execute_ecap5_dproc_pkg::ALU_ANDN:   return a & ~b;
+      case Vtb_execute_ecap5_dproc_pkg::ALU_ORN:    return a | ~b;
+      case Vtb_execute_ecap5_dproc_pkg::ALU_XNOR:   return ~(a ^ b);
+      case Vtb_execute_ecap5_dproc_pkg::ALU_CLZ:
+        while((result < 32) && !((a << result) & 0x80000000)) {
+          result += 1;
+        }
+        return result;
+      case Vtb_execute_ecap5_dproc_pkg::ALU_CTZ:
+        while((result < 32) && !((a >> result) & 0x1)) {
+          result += 1;
+        }
+        return result;
+      case Vtb_execute_ecap5_dproc_pkg::ALU_CPOP:
+        for(int i = 0; i < 32; i++) {
+          result += (a >> i) & 0x1;
+        }
+        return result;
+      case Vtb_execute_ecap5_dproc_pkg::ALU_MIN:    return ((int32_t)a < (int32_t)b) ? a : b;
+      case Vtb_execute_ecap5_dproc_pkg::ALU_MAX:    return ((int32_t)a < (int32_t)b) ? b : a;
+      case Vtb_execute_ecap5_dproc_pkg::ALU_MINU:   return (a < b) ? a : b;
+      case Vtb_execute_ecap5_dproc_pkg::ALU_MAXU:   return (a < b) ? b : a;
+      case Vtb_execute_ecap5_dproc_pkg::ALU_SEXT_B: return (uint32_t)(int32_t)(int8_t)a;
+      case Vtb_execute_ecap5_dproc_pkg::ALU_SEXT_H: return (uint32_t)(int32_t)(int16_t)a;
+      case Vtb_execute_ecap5_dproc_pkg::ALU_ZEXT_H: return a & 0xFFFF;
+      case Vtb_execute_ecap5_dproc_pkg::ALU_ROL:    return shamt ? ((a << shamt) | (a >> (32 - shamt))) : a;
+      case Vtb_execute_ecap5_dproc_pkg::ALU_ROR:    return shamt ? ((a >> shamt) | (a << (32 - shamt))) : a;
+      case Vtb_execute_ecap5_dproc_pkg::ALU_ORC_B:
+        for(int i = 0; i < 4; i++) {
+          if((a >> (8 * i)) & 0xFF) {
+            result |= 0xFFu << (8 * i);
+          }
+        }
+        return result;
+      case Vtb_execute_ecap5_dproc_pkg::ALU_REV8:
+        return (a << 24) | ((a << 8) & 0xFF0000) | ((a >> 8) & 0xFF00) | (a >> 24);
+      case Vtb_execute_ecap5_dproc_pkg::ALU_BSET:   return a | (1u << shamt);
+      case Vtb_execute_ecap5_dproc_pkg::ALU_BCLR:   return a & ~(1u << shamt);
+      case Vtb_execute_ecap5_dproc_pkg::ALU_BINV:   return a ^ (1u << shamt);
+      case Vtb_execute_ecap5_dproc_pkg::ALU_BEXT:   return (a >> shamt) & 0x1;
+      default:                                      return 0;
+    }
+  }
+
   void _sub(uint32_t operand1, uint32_t operand2, uint32_t reg_addr) {
     this->_nop();
     this->core->alu_operand1_i = operand1;
@@ -880,6 +952,81 @@ void tb_execute_alu_sra(TB_Execute * tb) {
       "Failed to implement the output_valid_o", tb->err_cycles[COND_output_valid]);
 }
 
+void tb_execute_alu_bitmanip(TB_Execute * tb) {
+  Vtb_execute * core = tb->core;
+  core->testcase = T_ALU_BITMANIP;
+
+  // The following actions are performed in this test :
+  //    For each operation of the bit-manipulation extensions :
+  //      tick 0. Set inputs for the operation
+  //      tick 1. Nothing (core outputs result of the operation)
+
+  const uint8_t ops[] = {
+    Vtb_execute_ecap5_dproc_pkg::ALU_SH1ADD, Vtb_execute_ecap5_dproc_pkg::ALU_SH2ADD,
+    Vtb_execute_ecap5_dproc_pkg::ALU_SH3ADD, Vtb_execute_ecap5_dproc_pkg::ALU_ANDN,
+    Vtb_execute_ecap5_dproc_pkg::ALU_ORN,    Vtb_execute_ecap5_dproc_pkg::ALU_XNOR,
+    Vtb_execute_ecap5_dproc_pkg::ALU_CLZ,    Vtb_execute_ecap5_dproc_pkg::ALU_CTZ,
+    Vtb_execute_ecap5_dproc_pkg::ALU_CPOP,   Vtb_execute_ecap5_dproc_pkg::ALU_MIN,
+    Vtb_execute_ecap5_dproc_pkg::ALU_MAX,    Vtb_execute_ecap5_dproc_pkg::ALU_MINU,
+    Vtb_execute_ecap5_dproc_pkg::ALU_MAXU,   Vtb_execute_ecap5_dproc_pkg::ALU_SEXT_B,
+    Vtb_execute_ecap5_dproc_pkg::ALU_SEXT_H, Vtb_execute_ecap5_dproc_pkg::ALU_ZEXT_H,
+    Vtb_execute_ecap5_dproc_pkg::ALU_ROL,    Vtb_execute_ecap5_dproc_pkg::ALU_ROR,
+    Vtb_execute_ecap5_dproc_pkg::ALU_ORC_B,  Vtb_execute_ecap5_dproc_pkg::ALU_REV8,
+    Vtb_execute_ecap5_dproc_pkg::ALU_BSET,   Vtb_execute_ecap5_dproc_pkg::ALU_BCLR,
+    Vtb_execute_ecap5_dproc_pkg::ALU_BINV,   Vtb_execute_ecap5_dproc_pkg::ALU_BEXT
+  };
+
+  for(uint8_t op : ops) {
+    // The null operand covers the counts of 32 and the bytes without set bits
+    for(uint32_t operand1 : {0u, (uint32_t)rand() >> (rand() % 32), (uint32_t)rand()}) {
+      //=================================
+      //      Tick (0)
+
+      tb->reset();
+
+      //`````````````````````````````````
+      //      Set inputs
+
+      core->input_valid_i = 1;
+      core->output_ready_i = 1;
+
+      uint32_t operand2 = rand();
+      uint8_t reg_addr = rand() % 32;
+      tb->_bitmanip(op, operand1, operand2, reg_addr);
+
+      //=================================
+      //      Tick (1)
+
+      tb->tick();
+
+      //`````````````````````````````````
+      //      Checks
+
+      uint32_t result = tb->bitmanip(op, operand1, operand2);
+      tb->check(COND_result,       (core->result_o        ==  result)  &&
+                                   (core->reg_write_o  ==  1)       &&
+                                   (core->reg_addr_o   ==  reg_addr));
+      tb->check(COND_branch,       (core->branch_o        ==  0));
+      tb->check(COND_output_valid, (core->output_valid_o  ==  1));
+    }
+  }
+
+  //`````````````````````````````````
+  //      Formal Checks
+
+  CHECK("tb_execute.alu.BITMANIP_01",
+      tb->conditions[COND_result],
+      "Failed to implement the result protocol", tb->err_cycles[COND_result]);
+
+  CHECK("tb_execute.alu.BITMANIP_02",
+      tb->conditions[COND_branch],
+      "Failed to implement the branch protocol", tb->err_cycles[COND_branch]);
+
+  CHECK("tb_execute.alu.BITMANIP_03",
+      tb->conditions[COND_output_valid],
+      "Failed to implement the output_valid_o", tb->err_cycles[COND_output_valid]);
+}
+
 void tb_execute_branch_beq(TB_Execute * tb) {
   Vtb_execute * core = tb->core;
   core->testcase = T_BRANCH_BEQ;
@@ -2004,6 +2151,63 @@ void tb_execute_branch_jalr(TB_Execute * tb) {
       "Failed to implement the output_valid_o", tb->err_cycles[COND_output_valid]);
 }
 
+void tb_execute_branch_jalr_compressed(TB_Execute * tb) {
+  Vtb_execute * core = tb->core;
+  core->testcase = T_JALR_COMPRESSED;
+
+  // The following actions are performed in this test :
+  //    tick 0. Set inputs for a compressed JALR
+  //    tick 1. Nothing (core outputs result of JALR)
+
+  //=================================
+  //      Tick (0)
+  
+  tb->reset();
+  
+  //`````````````````````````````````
+  //      Set inputs
+  
+  core->input_valid_i = 1;
+  core->output_ready_i = 1;
+
+  uint32_t pc = rand() % 0x7FFFFFFF;
+  uint32_t operand1 = rand() % 0x7FFFFFFF;
+  uint32_t operand2 = rand() % 0x7FFFFFFF;
+  uint8_t reg_addr = rand() % 32;
+  tb->_jalr(pc, operand1, operand2, reg_addr);
+  core->compressed_i = 1;
+
+  //=================================
+  //      Tick (1)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  tb->check(COND_result,       (core->result_o         ==  pc + 2)  &&
+                               (core->reg_write_o   ==  1)       &&
+                               (core->reg_addr_o    ==  reg_addr));
+  tb->check(COND_branch,       (core->branch_o         ==  1) &&
+                               (core->branch_target_o  ==  operand1 + operand2));
+  tb->check(COND_output_valid, (core->output_valid_o   ==  1));
+  
+  //`````````````````````````````````
+  //      Formal Checks 
+   
+  CHECK("tb_execute.branch.JALR_COMPRESSED_01",
+      tb->conditions[COND_result],
+      "Failed to implement the result protocol", tb->err_cycles[COND_result]);
+
+  CHECK("tb_execute.branch.JALR_COMPRESSED_02",
+      tb->conditions[COND_branch],
+      "Failed to implement the branch protocol", tb->err_cycles[COND_branch]);
+
+  CHECK("tb_execute.branch.JALR_COMPRESSED_03",
+      tb->conditions[COND_output_valid],
+      "Failed to implement the output_valid_o", tb->err_cycles[COND_output_valid]);
+}
+
 void tb_execute_hazard(TB_Execute * tb) {
   Vtb_execute * core = tb->core;
   core->testcase = T_HAZARD;
@@ -2063,6 +2267,192 @@ void tb_execute_hazard(TB_Execute * tb) {
       "Failed to implement the output_valid_o", tb->err_cycles[COND_output_valid]);
 }
 
+void tb_execute_branch_predicted(TB_Execute * tb) {
+  Vtb_execute * core = tb->core;
+  core->testcase = T_BRANCH_PREDICTED;
+
+  // The following actions are performed in this test :
+  //    tick 0. Set inputs for a predicted BNE with different values
+  //    tick 1. Set inputs for a predicted BNE with equal values (core outputs result of BNE)
+  //    tick 2. Set inputs for ADD (core outputs result of BNE)
+  //    tick 3. Nothing (core outputs result of ADD)
+
+  //=================================
+  //      Tick (0)
+  
+  tb->reset();
+  
+  //`````````````````````````````````
+  //      Set inputs
+  
+  core->input_valid_i = 1;
+  core->output_ready_i = 1;
+
+  uint32_t pc = rand() % 0x7FFFFFFF;
+  uint32_t operand1 = rand();
+  uint32_t operand2 = operand1 + 1 + (rand() % 0xFF);
+  uint32_t branch_offset = 0x80000 | (rand() % 0x7FFFF);
+  tb->_bne(pc, operand1, operand2, branch_offset);
+  core->pred_taken_i = 1;
+
+  //=================================
+  //      Tick (1)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  // The branch was correctly predicted taken
+  tb->check(COND_result,       (core->reg_write_o     ==  0));
+  tb->check(COND_branch,       (core->branch_o        ==  0));
+  tb->check(COND_output_valid, (core->output_valid_o  ==  1));
+  tb->check(COND_predictor,    (core->bp_update_o      ==  1)   &&
+                               (core->bp_pc_o          ==  pc)  &&
+                               (core->bp_taken_o       ==  1)   &&
+                               (core->bp_target_o      ==  pc + tb->sign_extend(branch_offset, 20)) &&
+                               (core->bp_mispredict_o  ==  0));
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  tb->_bne(pc, operand1, operand1, branch_offset);
+  core->pred_taken_i = 1;
+
+  //=================================
+  //      Tick (2)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  // The branch was mispredicted, the next instruction is fetched instead
+  tb->check(COND_result,       (core->reg_write_o      ==  0));
+  tb->check(COND_branch,       (core->branch_o         ==  1) &&
+                               (core->branch_target_o  ==  pc + 4));
+  tb->check(COND_output_valid, (core->output_valid_o   ==  1));
+  tb->check(COND_predictor,    (core->bp_update_o      ==  1)   &&
+                               (core->bp_taken_o       ==  0)   &&
+                               (core->bp_mispredict_o  ==  1));
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  tb->_nop();
+
+  //=================================
+  //      Tick (3)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  tb->check(COND_predictor,    (core->bp_update_o      ==  0));
+
+  //`````````````````````````````````
+  //      Formal Checks 
+  
+  CHECK("tb_execute.branch.PREDICTED_01",
+      tb->conditions[COND_result],
+      "Failed to implement the result protocol", tb->err_cycles[COND_result]);
+
+  CHECK("tb_execute.branch.PREDICTED_02",
+      tb->conditions[COND_branch],
+      "Failed to only branch on a misprediction", tb->err_cycles[COND_branch]);
+
+  CHECK("tb_execute.branch.PREDICTED_03",
+      tb->conditions[COND_output_valid],
+      "Failed to implement the output_valid_o", tb->err_cycles[COND_output_valid]);
+
+  CHECK("tb_execute.branch.PREDICTED_04",
+      tb->conditions[COND_predictor],
+      "Failed to implement the branch predictor interface", tb->err_cycles[COND_predictor]);
+}
+
+void tb_execute_jalr_predicted(TB_Execute * tb) {
+  Vtb_execute * core = tb->core;
+  core->testcase = T_JALR_PREDICTED;
+
+  // The following actions are performed in this test :
+  //    tick 0. Set inputs for a jalr predicted with the right target
+  //    tick 1. Set inputs for a jalr predicted with a wrong target (core doesn't branch)
+  //    tick 2. Nothing (core branches to the computed target)
+
+  //=================================
+  //      Tick (0)
+  
+  tb->reset();
+  
+  //`````````````````````````````````
+  //      Set inputs
+  
+  core->input_valid_i = 1;
+  core->output_ready_i = 1;
+
+  uint32_t pc = rand() % 0x7FFFFFFF;
+  uint32_t operand1 = rand();
+  uint32_t operand2 = rand() % 0x7FF;
+  uint32_t reg_addr = rand() % 32;
+  tb->_jalr(pc, operand1, operand2, reg_addr);
+  core->pred_taken_i = 1;
+  core->pred_target_i = operand1 + operand2;
+
+  //=================================
+  //      Tick (1)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  // The target was correctly predicted
+  tb->check(COND_result,       (core->reg_write_o     ==  1)        &&
+                               (core->reg_addr_o      ==  reg_addr) &&
+                               (core->result_o        ==  pc + 4));
+  tb->check(COND_branch,       (core->branch_o        ==  0));
+  tb->check(COND_output_valid, (core->output_valid_o  ==  1));
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  tb->_jalr(pc, operand1, operand2, reg_addr);
+  core->pred_taken_i = 1;
+  core->pred_target_i = operand1 + operand2 + 4;
+
+  //=================================
+  //      Tick (2)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  // The target was mispredicted, the computed target is fetched instead
+  tb->check(COND_result,       (core->reg_write_o      ==  1)        &&
+                               (core->reg_addr_o       ==  reg_addr) &&
+                               (core->result_o         ==  pc + 4));
+  tb->check(COND_branch,       (core->branch_o         ==  1) &&
+                               (core->branch_target_o  ==  operand1 + operand2));
+  tb->check(COND_output_valid, (core->output_valid_o   ==  1));
+
+  //`````````````````````````````````
+  //      Formal Checks 
+  
+  CHECK("tb_execute.branch.JALR_PREDICTED_01",
+      tb->conditions[COND_result],
+      "Failed to implement the result protocol", tb->err_cycles[COND_result]);
+
+  CHECK("tb_execute.branch.JALR_PREDICTED_02",
+      tb->conditions[COND_branch],
+      "Failed to only branch on a mispredicted target", tb->err_cycles[COND_branch]);
+
+  CHECK("tb_execute.branch.JALR_PREDICTED_03",
+      tb->conditions[COND_output_valid],
+      "Failed to implement the output_valid_o", tb->err_cycles[COND_output_valid]);
+}
+
 int main(int argc, char ** argv, char ** env) {
   srand(time(NULL));
   Verilated::traceEverOn(true);
@@ -2089,6 +2479,7 @@ int main(int argc, char ** argv, char ** env) {
   tb_execute_alu_sll(tb);
   tb_execute_alu_srl(tb);
   tb_execute_alu_sra(tb);
+  tb_execute_alu_bitmanip(tb);
 
   tb_execute_branch_beq(tb);
   tb_execute_branch_bne(tb);
@@ -2098,6 +2489,10 @@ int main(int argc, char ** argv, char ** env) {
   tb_execute_branch_bgeu(tb);
 
   tb_execute_branch_jalr(tb);
+  tb_execute_branch_jalr_compressed(tb);
+
+  tb_execute_branch_predicted(tb);
+  tb_execute_jalr_predicted(tb);
 
   tb_execute_back_to_back(tb);
   tb_execute_bubble(tb);
@@ -33,22 +33,38 @@ module tb_execute import ecap5_dproc_pkg::*; (
   input   logic        input_valid_i,
 
   input   logic[31:0]  pc_i,
+  input   logic        compressed_i,
 
   //`````````````````````````````````
   //    ALU inputs 
    
   input   logic[31:0]  alu_operand1_i,
   input   logic[31:0]  alu_operand2_i, 
-  input   logic[2:0]   alu_op_i,
+  input   logic[4:0]   alu_op_i,
   input   logic        alu_sub_i,
   input   logic        alu_shift_left_i,
   input   logic        alu_signed_shift_i,
 
+  //`````````````````````````````````
+  //    Multiply/divide inputs
+
+  input   logic        muldiv_enable_i,
+  input   logic[2:0]   muldiv_op_i,
+
+  //`````````````````````````````````
+  //    Forwarding inputs 
+
+  input   logic[4:0]   alu_operand1_reg_i,
+  input   logic[4:0]   alu_operand2_reg_i,
+  input   logic[4:0]   ls_write_data_reg_i,
+
   //`````````````````````````````````
   //    Branch inputs 
    
   input   logic[2:0]   branch_cond_i,
   input   logic[19:0]  branch_offset_i,
+  input   logic        pred_taken_i,
+  input   logic[31:0]  pred_target_i,
 
   //`````````````````````````````````
   //    Load-Store pass-through inputs 
@@ -94,6 +110,16 @@ module tb_execute import ecap5_dproc_pkg::*; (
   output  logic        branch_o,
   output  logic[31:0]  branch_target_o,
 
+  //`````````````````````````````````
+  //    Branch predictor interface 
+  //
+
+  output  logic        bp_update_o,
+  output  logic[31:0]  bp_pc_o,
+  output  logic        bp_taken_o,
+  output  logic[31:0]  bp_target_o,
+  output  logic        bp_mispredict_o,
+
   //=================================
   //    Hazard interface 
   //
@@ -101,25 +127,38 @@ module tb_execute import ecap5_dproc_pkg::*; (
   input   logic  discard_request_i
 );
 
-execute dut (
+execute #(
+ .BITMANIP            (1)
+) dut (
  .clk_i               (clk_i),
  .rst_i               (rst_i),
  .input_ready_o       (input_ready_o),
  .input_valid_i       (input_valid_i),
  .pc_i                (pc_i),
+ .compressed_i        (compressed_i),
  .alu_operand1_i      (alu_operand1_i),
  .alu_operand2_i      (alu_operand2_i), 
  .alu_op_i            (alu_op_i),
  .alu_sub_i           (alu_sub_i),
  .alu_shift_left_i    (alu_shift_left_i),
  .alu_signed_shift_i  (alu_signed_shift_i),
+ .muldiv_enable_i     (muldiv_enable_i),
+ .muldiv_op_i         (muldiv_op_i),
+ .alu_operand1_reg_i  (alu_operand1_reg_i),
+ .alu_operand2_reg_i  (alu_operand2_reg_i),
+ .ls_write_data_reg_i (ls_write_data_reg_i),
  .ls_enable_i         (ls_enable_i),
  .ls_write_i          (ls_write_i),
  .ls_write_data_i     (ls_write_data_i),
  .ls_sel_i            (ls_sel_i),
  .ls_unsigned_load_i  (ls_unsigned_load_i),
+ .ls_atomic_i         (1'b0),
+ .ls_atomic_op_i      ('0),
+ .fence_i_i           (1'b0),
  .branch_cond_i       (branch_cond_i),
  .branch_offset_i     (branch_offset_i),
+ .pred_taken_i        (pred_taken_i),
+ .pred_target_i       (pred_target_i),
  .reg_write_i         (reg_write_i),
  .reg_addr_i          (reg_addr_i),
  .output_ready_i      (output_ready_i),
@@ -132,8 +171,16 @@ execute dut (
  .ls_write_data_o     (ls_write_data_o),
  .ls_sel_o            (ls_sel_o),
  .ls_unsigned_load_o  (ls_unsigned_load_o),
+ .ls_atomic_o         (),
+ .ls_atomic_op_o      (),
+ .fence_i_o           (),
  .branch_o            (branch_o),
  .branch_target_o     (branch_target_o),
+ .bp_update_o         (bp_update_o),
+ .bp_pc_o             (bp_pc_o),
+ .bp_taken_o          (bp_taken_o),
+ .bp_target_o         (bp_target_o),
+ .bp_mispredict_o     (bp_mispredict_o),
  .discard_request_i   (discard_request_i)
 );
 
@@ -0,0 +1,210 @@
+/*           __        _
+ *  ________/ /  ___ _(_)__  ___
+ * / __/ __/ _ \/ _ `/ / _ \/ -_)
+ * \__/\__/_//_/\_,_/_/_//_/\__/
+ *
+ * Copyright (C) Clément Chaine
+ * This file is part of ECAP5-DPROC <https://github.com/ecap5/ECAP5-DPROC>
+ *
+ * ECAP5-DPROC is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ECAP5-DPROC is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ECAP5-DPROC.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <verilated.h>
+#include <verilated_vcd_c.h>
+#include <svdpi.h>
+
+#include "Vtb_expander.h"
+#include "testbench.h"
+
+enum CondId {
+  COND_output,
+  __CondIdEnd
+};
+
+enum TestcaseId {
+  T_QUADRANT0  =  1,
+  T_QUADRANT1  =  2,
+  T_QUADRANT2  =  3,
+  T_INVALID    =  4
+};
+
+// Compressed instruction along with its expected 32-bit equivalent
+struct Expansion {
+  uint16_t compressed;
+  uint32_t expanded;
+};
+
+class TB_Expander : public Testbench<Vtb_expander> {
+public:
+  void reset() {
+    this->core->instr_i = 0;
+
+    Testbench<Vtb_expander>::reset();
+  }
+
+  void check_expansions(const Expansion * expansions, int count) {
+    for(int i = 0; i < count; i++) {
+      this->core->instr_i = expansions[i].compressed;
+      this->tick();
+      this->check(COND_output, (this->core->instr_o == expansions[i].expanded));
+    }
+  }
+};
+
+void tb_expander_quadrant0(TB_Expander * tb) {
+  Vtb_expander * core = tb->core;
+  core->testcase = T_QUADRANT0;
+
+  // The following actions are performed in this test :
+  //    tick 0-N. Set a compressed instruction (core outputs its expansion)
+
+  tb->reset();
+
+  const Expansion expansions[] = {
+    {0x0028, 0x00810513},   // c.addi4spn a0, sp, 8     -> addi a0, sp, 8
+    {0x4188, 0x0005a503},   // c.lw a0, 0(a1)           -> lw a0, 0(a1)
+    {0xc1c8, 0x00a5a223}    // c.sw a0, 4(a1)           -> sw a0, 4(a1)
+  };
+  tb->check_expansions(expansions, sizeof(expansions) / sizeof(Expansion));
+
+  //`````````````````````````````````
+  //      Formal Checks
+
+  CHECK("tb_expander.quadrant0.01",
+      tb->conditions[COND_output],
+      "Failed to expand the quadrant 0 instructions", tb->err_cycles[COND_output]);
+}
+
+void tb_expander_quadrant1(TB_Expander * tb) {
+  Vtb_expander * core = tb->core;
+  core->testcase = T_QUADRANT1;
+
+  // The following actions are performed in this test :
+  //    tick 0-N. Set a compressed instruction (core outputs its expansion)
+
+  tb->reset();
+
+  const Expansion expansions[] = {
+    {0x0001, 0x00000013},   // c.nop                    -> addi x0, x0, 0
+    {0x1141, 0xff010113},   // c.addi sp, -16           -> addi sp, sp, -16
+    {0x2001, 0x000000ef},   // c.jal 0                  -> jal ra, 0
+    {0x4505, 0x00100513},   // c.li a0, 1               -> addi a0, x0, 1
+    {0x7179, 0xfd010113},   // c.addi16sp sp, -48       -> addi sp, sp, -48
+    {0x6505, 0x00001537},   // c.lui a0, 1              -> lui a0, 1
+    {0x8105, 0x00155513},   // c.srli a0, 1             -> srli a0, a0, 1
+    {0x8d0d, 0x40b50533},   // c.sub a0, a1             -> sub a0, a0, a1
+    {0x8d6d, 0x00b57533},   // c.and a0, a1             -> and a0, a0, a1
+    {0xa001, 0x0000006f},   // c.j 0                    -> jal x0, 0
+    {0xbffd, 0xfffff06f},   // c.j -2                   -> jal x0, -2
+    {0xc101, 0x00050063},   // c.beqz a0, 0             -> beq a0, x0, 0
+    {0xfd7d, 0xfe051fe3}    // c.bnez a0, -2            -> bne a0, x0, -2
+  };
+  tb->check_expansions(expansions, sizeof(expansions) / sizeof(Expansion));
+
+  //`````````````````````````````````
+  //      Formal Checks
+
+  CHECK("tb_expander.quadrant1.01",
+      tb->conditions[COND_output],
+      "Failed to expand the quadrant 1 instructions", tb->err_cycles[COND_output]);
+}
+
+void tb_expander_quadrant2(TB_Expander * tb) {
+  Vtb_expander * core = tb->core;
+  core->testcase = T_QUADRANT2;
+
+  // The following actions are performed in this test :
+  //    tick 0-N. Set a compressed instruction (core outputs its expansion)
+
+  tb->reset();
+
+  const Expansion expansions[] = {
+    {0x050a, 0x00251513},   // c.slli a0, 2             -> slli a0, a0, 2
+    {0x40b2, 0x00c12083},   // c.lwsp ra, 12(sp)        -> lw ra, 12(sp)
+    {0x8082, 0x00008067},   // c.jr ra                  -> jalr x0, 0(ra)
+    {0x852e, 0x00b00533},   // c.mv a0, a1              -> add a0, x0, a1
+    {0x9002, 0x00100073},   // c.ebreak                 -> ebreak
+    {0x9502, 0x000500e7},   // c.jalr a0                -> jalr ra, 0(a0)
+    {0x952e, 0x00b50533},   // c.add a0, a1             -> add a0, a0, a1
+    {0xc606, 0x00112623}    // c.swsp ra, 12(sp)        -> sw ra, 12(sp)
+  };
+  tb->check_expansions(expansions, sizeof(expansions) / sizeof(Expansion));
+
+  //`````````````````````````````````
+  //      Formal Checks
+
+  CHECK("tb_expander.quadrant2.01",
+      tb->conditions[COND_output],
+      "Failed to expand the quadrant 2 instructions", tb->err_cycles[COND_output]);
+}
+
+void tb_expander_invalid(TB_Expander * tb) {
+  Vtb_expander * core = tb->core;
+  core->testcase = T_INVALID;
+
+  // The following actions are performed in this test :
+  //    tick 0-N. Set an unsupported instruction (core outputs zero)
+
+  tb->reset();
+
+  const Expansion expansions[] = {
+    {0x0000, 0x00000000},   // Illegal instruction
+    {0x2000, 0x00000000},   // c.fld
+    {0x6000, 0x00000000},   // c.flw
+    {0xe000, 0x00000000}    // c.fsw
+  };
+  tb->check_expansions(expansions, sizeof(expansions) / sizeof(Expansion));
+
+  //`````````````````````````````````
+  //      Formal Checks
+
+  CHECK("tb_expander.invalid.01",
+      tb->conditions[COND_output],
+      "Failed to reject the unsupported instructions", tb->err_cycles[COND_output]);
+}
+
+int main(int argc, char ** argv, char ** env) {
+  srand(time(NULL));
+  Verilated::traceEverOn(true);
+
+  bool verbose = parse_verbose(argc, argv);
+
+  TB_Expander * tb = new TB_Expander;
+  tb->open_trace("waves/expander.vcd");
+  tb->open_testdata("testdata/expander.csv");
+  tb->set_debug_log(verbose);
+  tb->init_conditions(__CondIdEnd);
+
+  /************************************************************/
+
+  tb_expander_quadrant0(tb);
+  tb_expander_quadrant1(tb);
+  tb_expander_quadrant2(tb);
+  tb_expander_invalid(tb);
+
+  /************************************************************/
+
+  printf("[EXPANDER]: ");
+  if(tb->success) {
+    printf("Done\n");
+  } else {
+    printf("Failed\n");
+  }
+
+  delete tb;
+  exit(EXIT_SUCCESS);
+}
@@ -42,7 +42,14 @@ module tb_fetch (
   output  logic        output_valid_o,
   // DECM outputs
   output  logic[31:0]  instr_o,
-  output  logic[31:0]  pc_o
+  output  logic[31:0]  pc_o,
+  output  logic        pred_taken_o,
+  output  logic[31:0]  pred_target_o,
+  // Branch predictor interface
+  output  logic[31:0]  bp_lookup_pc_o,
+  input   logic        bp_lookup_hit_i,
+  input   logic        bp_lookup_taken_i,
+  input   logic[31:0]  bp_lookup_target_i
 );
 
 fetch dut (
@@ -61,7 +68,13 @@ fetch dut (
   .output_ready_i  (output_ready_i),
   .output_valid_o  (output_valid_o),
   .instr_o         (instr_o),
-  .pc_o            (pc_o)
+  .pc_o            (pc_o),
+  .pred_taken_o    (pred_taken_o),
+  .pred_target_o   (pred_target_o),
+  .bp_lookup_pc_o     (bp_lookup_pc_o),
+  .bp_lookup_hit_i    (bp_lookup_hit_i),
+  .bp_lookup_taken_i  (bp_lookup_taken_i),
+  .bp_lookup_target_i (bp_lookup_target_i)
 );
 
 endmodule // tb_fetch
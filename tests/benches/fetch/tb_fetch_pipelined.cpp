@@ -0,0 +1,724 @@
+/*           __        _
+ *  ________/ /  ___ _(_)__  ___
+ * / __/ __/ _ \/ _ `/ / _ \/ -_)
+ * \__/\__/_//_/\_,_/_/_//_/\__/
+ *
+ * Copyright (C) Clément Chaine
+ * This file is part of ECAP5-DPROC <https://github.com/ecap5/ECAP5-DPROC>
+ *
+ * ECAP5-DPROC is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ECAP5-DPROC is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ECAP5-DPROC.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <verilated.h>
+#include <verilated_vcd_c.h>
+#include <svdpi.h>
+#include <deque>
+#include <vector>
+
+#include "Vtb_fetch_pipelined.h"
+#include "testbench.h"
+#include "wishbone_slave.h"
+#include "Vtb_fetch_pipelined_ecap5_dproc_pkg.h"
+#include "Vtb_fetch_pipelined_tb_fetch_pipelined.h"
+
+enum CondId {
+  COND_wishbone,
+  COND_output,
+  COND_output_valid,
+  COND_throughput,
+  COND_buffer,
+  __CondIdEnd
+};
+
+enum TestcaseId {
+  T_NO_STALL                         =  1,
+  T_MEMORY_STALL                     =  2,
+  T_MEMORY_WAIT                      =  3,
+  T_PIPELINE_WAIT                    =  4,
+  T_JUMP_DURING_WAIT                 =  5,
+  T_JUMP_DURING_MEMORY_STALL         =  6,
+  T_JUMP_BACK_TO_BACK                =  7,
+  T_RESET                            =  8
+};
+
+struct Output {
+  uint32_t pc;
+  uint32_t instr;
+};
+
+class TB_Fetch_pipelined : public Testbench<Vtb_fetch_pipelined> {
+public:
+  // Pipelined wishbone slave model
+  WishboneSlave<uint32_t> slave;
+  uint32_t cycle;
+  // Output handshakes performed by the fetch stage
+  std::vector<Output> outputs;
+
+  void reset() {
+    this->core->branch_i = 0;
+    this->core->branch_target_i = 0;
+    this->core->wb_stall_i = 0;
+    this->core->wb_ack_i = 0;
+    this->core->wb_dat_i = 0;
+    this->core->output_ready_i = 0;
+
+    this->core->rst_i = 1;
+    for(int i = 0; i < 5; i++) {
+      this->tick();
+    }
+    this->core->rst_i = 0;
+
+    this->slave.latency = 0;
+    this->cycle = 0;
+    this->slave.clear();
+    this->outputs.clear();
+
+    Testbench<Vtb_fetch_pipelined>::reset();
+  }
+
+  static uint32_t memory(uint32_t adr) {
+    return adr ^ 0xA5A5A5A5;
+  }
+
+  void tick() {
+    this->slave.accept(this->cycle, this->core->wb_stb_o, this->core->wb_cyc_o, this->core->wb_stall_i,
+                       this->core->wb_adr_o);
+    uint32_t adr = 0;
+    this->core->wb_ack_i = this->slave.respond(this->cycle, adr);
+    this->core->wb_dat_i = this->core->wb_ack_i ? memory(adr) : 0;
+
+    if(this->core->output_valid_o && this->core->output_ready_i) {
+      this->outputs.push_back({this->core->pc_o, this->core->instr_o});
+    }
+
+    Testbench<Vtb_fetch_pipelined>::tick();
+    this->cycle += 1;
+  }
+
+  // Checks that the outputs are sequential starting from start
+  bool outputs_from(uint32_t start) {
+    for(size_t i = 0; i < this->outputs.size(); i++) {
+      uint32_t pc = start + 4 * i;
+      if((this->outputs[i].pc != pc) || (this->outputs[i].instr != memory(pc))) {
+        return false;
+      }
+    }
+    return true;
+  }
+};
+
+void tb_fetch_pipelined_reset(TB_Fetch_pipelined * tb) {
+  Vtb_fetch_pipelined * core = tb->core;
+  core->testcase = T_RESET;
+
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_wishbone,      (core->wb_stb_o              ==  0)    &&
+                                (core->wb_cyc_o              ==  0));
+  tb->check(COND_output_valid,  (core->output_valid_o        ==  0));
+
+  //`````````````````````````````````
+  //      Formal Checks
+
+  CHECK("tb_fetch_pipelined.reset.01",
+      tb->conditions[COND_wishbone],
+      "Failed to implement the wishbone protocol", tb->err_cycles[COND_wishbone]);
+
+  CHECK("tb_fetch_pipelined.reset.02",
+      tb->conditions[COND_output_valid],
+      "Failed to implement the output_valid_o signal", tb->err_cycles[COND_output_valid]);
+}
+
+void tb_fetch_pipelined_no_stall(TB_Fetch_pipelined * tb) {
+  Vtb_fetch_pipelined * core = tb->core;
+  core->testcase = T_NO_STALL;
+
+  // The following actions are performed in this test :
+  //    tick 0. Set inputs for no stall
+  //    tick 1. Nothing (core makes the first request)
+  //    tick 2. Nothing (core outputs the first instruction)
+  //    tick 3-22. Nothing (core outputs one instruction per cycle)
+
+  //=================================
+  //      Tick (0)
+
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  core->wb_stall_i = 0;
+  core->output_ready_i = 1;
+
+  //=================================
+  //      Tick (1)
+
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_wishbone,      (core->wb_adr_o              ==  core->tb_fetch_pipelined->BOOT_ADDRESS) &&
+                                (core->wb_we_o               ==  0)    &&
+                                (core->wb_sel_o              ==  0xF)  &&
+                                (core->wb_stb_o              ==  1)    &&
+                                (core->wb_cyc_o              ==  1));
+  tb->check(COND_output_valid,  (core->output_valid_o        ==  0));
+
+  //=================================
+  //      Tick (2)
+
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_wishbone,      (core->wb_adr_o              ==  core->tb_fetch_pipelined->BOOT_ADDRESS + 4) &&
+                                (core->wb_stb_o              ==  1)    &&
+                                (core->wb_cyc_o              ==  1));
+  tb->check(COND_output_valid,  (core->output_valid_o        ==  1));
+  tb->check(COND_output,        (core->pc_o                  ==  core->tb_fetch_pipelined->BOOT_ADDRESS) &&
+                                (core->instr_o               ==  tb->memory(core->tb_fetch_pipelined->BOOT_ADDRESS)));
+
+  //=================================
+  //      Tick (3-22)
+
+  for(int i = 0; i < 20; i++) {
+    tb->tick();
+    tb->check(COND_output_valid, (core->output_valid_o == 1));
+  }
+
+  //`````````````````````````````````
+  //      Checks
+
+  // One instruction is output per cycle after the first response
+  tb->check(COND_throughput,    (tb->outputs.size()          ==  20));
+  tb->check(COND_output,        tb->outputs_from(core->tb_fetch_pipelined->BOOT_ADDRESS));
+
+  //`````````````````````````````````
+  //      Formal Checks
+
+  CHECK("tb_fetch_pipelined.no_stall.01",
+      tb->conditions[COND_wishbone],
+      "Failed to implement the wishbone protocol", tb->err_cycles[COND_wishbone]);
+
+  CHECK("tb_fetch_pipelined.no_stall.02",
+      tb->conditions[COND_output],
+      "Failed to implement the output signals", tb->err_cycles[COND_output]);
+
+  CHECK("tb_fetch_pipelined.no_stall.03",
+      tb->conditions[COND_output_valid],
+      "Failed to implement the output_valid_o signal", tb->err_cycles[COND_output_valid]);
+
+  CHECK("tb_fetch_pipelined.no_stall.04",
+      tb->conditions[COND_throughput],
+      "Failed to output one instruction per cycle", tb->err_cycles[COND_throughput]);
+}
+
+void tb_fetch_pipelined_memory_stall(TB_Fetch_pipelined * tb) {
+  Vtb_fetch_pipelined * core = tb->core;
+  core->testcase = T_MEMORY_STALL;
+
+  // The following actions are performed in this test :
+  //    tick 0. Set inputs with memory stall
+  //    tick 1-5. Nothing (core holds the first request)
+  //    tick 6. Unstall the memory
+  //    tick 7-16. Nothing (core outputs the instructions)
+
+  //=================================
+  //      Tick (0)
+
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  core->wb_stall_i = 1;
+  core->output_ready_i = 1;
+
+  //=================================
+  //      Tick (1-5)
+
+  tb->tick();
+  for(int i = 0; i < 5; i++) {
+    tb->check(COND_wishbone,      (core->wb_adr_o              ==  core->tb_fetch_pipelined->BOOT_ADDRESS) &&
+                                  (core->wb_stb_o              ==  1)    &&
+                                  (core->wb_cyc_o              ==  1));
+    tb->check(COND_output_valid,  (core->output_valid_o        ==  0));
+    tb->tick();
+  }
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  core->wb_stall_i = 0;
+
+  //=================================
+  //      Tick (6-16)
+
+  for(int i = 0; i < 11; i++) {
+    tb->tick();
+  }
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_throughput,    (tb->outputs.size()          ==  10));
+  tb->check(COND_output,        tb->outputs_from(core->tb_fetch_pipelined->BOOT_ADDRESS));
+
+  //`````````````````````````````````
+  //      Formal Checks
+
+  CHECK("tb_fetch_pipelined.memory_stall.01",
+      tb->conditions[COND_wishbone],
+      "Failed to implement the wishbone protocol", tb->err_cycles[COND_wishbone]);
+
+  CHECK("tb_fetch_pipelined.memory_stall.02",
+      tb->conditions[COND_output_valid],
+      "Failed to implement the output_valid_o signal", tb->err_cycles[COND_output_valid]);
+
+  CHECK("tb_fetch_pipelined.memory_stall.03",
+      tb->conditions[COND_output],
+      "Failed to implement the output signals", tb->err_cycles[COND_output]);
+
+  CHECK("tb_fetch_pipelined.memory_stall.04",
+      tb->conditions[COND_throughput],
+      "Failed to output one instruction per cycle", tb->err_cycles[COND_throughput]);
+}
+
+void tb_fetch_pipelined_memory_wait(TB_Fetch_pipelined * tb) {
+  Vtb_fetch_pipelined * core = tb->core;
+  core->testcase = T_MEMORY_WAIT;
+
+  // The following actions are performed in this test :
+  //    tick 0. Set inputs with a memory latency of 2 cycles
+  //    tick 1-30. Nothing (core keeps several requests in flight)
+
+  //=================================
+  //      Tick (0)
+
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  tb->slave.latency = 2;
+  core->wb_stall_i = 0;
+  core->output_ready_i = 1;
+
+  //=================================
+  //      Tick (1-30)
+
+  for(int i = 0; i < 30; i++) {
+    tb->tick();
+    tb->check(COND_buffer,      (core->tb_fetch_pipelined->pending_q <= core->tb_fetch_pipelined->FETCH_DEPTH));
+  }
+
+  //`````````````````````````````````
+  //      Checks
+
+  // The memory latency is only paid once
+  tb->check(COND_throughput,    (tb->outputs.size()          ==  30 - 2 - tb->slave.latency));
+  tb->check(COND_output,        tb->outputs_from(core->tb_fetch_pipelined->BOOT_ADDRESS));
+
+  //`````````````````````````````````
+  //      Formal Checks
+
+  CHECK("tb_fetch_pipelined.memory_wait.01",
+      tb->conditions[COND_buffer],
+      "Failed to bound the number of outstanding requests", tb->err_cycles[COND_buffer]);
+
+  CHECK("tb_fetch_pipelined.memory_wait.02",
+      tb->conditions[COND_output],
+      "Failed to implement the output signals", tb->err_cycles[COND_output]);
+
+  CHECK("tb_fetch_pipelined.memory_wait.03",
+      tb->conditions[COND_throughput],
+      "Failed to hide the memory latency", tb->err_cycles[COND_throughput]);
+}
+
+void tb_fetch_pipelined_pipeline_wait(TB_Fetch_pipelined * tb) {
+  Vtb_fetch_pipelined * core = tb->core;
+  core->testcase = T_PIPELINE_WAIT;
+
+  // The following actions are performed in this test :
+  //    tick 0. Set inputs with the output not ready
+  //    tick 1-10. Nothing (core fills its buffer)
+  //    tick 11. Set the output ready
+  //    tick 12-20. Nothing (core outputs the buffered instructions)
+
+  //=================================
+  //      Tick (0)
+
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  core->wb_stall_i = 0;
+  core->output_ready_i = 0;
+
+  //=================================
+  //      Tick (1-10)
+
+  for(int i = 0; i < 10; i++) {
+    tb->tick();
+  }
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_wishbone,      (core->wb_stb_o              ==  0)    &&
+                                (core->wb_cyc_o              ==  0));
+  tb->check(COND_buffer,        (core->tb_fetch_pipelined->count_q == core->tb_fetch_pipelined->FETCH_DEPTH));
+  tb->check(COND_output_valid,  (core->output_valid_o        ==  1));
+  tb->check(COND_output,        (core->pc_o                  ==  core->tb_fetch_pipelined->BOOT_ADDRESS) &&
+                                (core->instr_o               ==  tb->memory(core->tb_fetch_pipelined->BOOT_ADDRESS)));
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  core->output_ready_i = 1;
+
+  //=================================
+  //      Tick (11-20)
+
+  for(int i = 0; i < 10; i++) {
+    tb->tick();
+    tb->check(COND_output_valid, (core->output_valid_o == 1));
+  }
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_throughput,    (tb->outputs.size()          ==  10));
+  tb->check(COND_output,        tb->outputs_from(core->tb_fetch_pipelined->BOOT_ADDRESS));
+
+  //`````````````````````````````````
+  //      Formal Checks
+
+  CHECK("tb_fetch_pipelined.pipeline_wait.01",
+      tb->conditions[COND_wishbone],
+      "Failed to implement the wishbone protocol", tb->err_cycles[COND_wishbone]);
+
+  CHECK("tb_fetch_pipelined.pipeline_wait.02",
+      tb->conditions[COND_buffer],
+      "Failed to fill the instruction buffer", tb->err_cycles[COND_buffer]);
+
+  CHECK("tb_fetch_pipelined.pipeline_wait.03",
+      tb->conditions[COND_output_valid],
+      "Failed to implement the output_valid_o signal", tb->err_cycles[COND_output_valid]);
+
+  CHECK("tb_fetch_pipelined.pipeline_wait.04",
+      tb->conditions[COND_output],
+      "Failed to implement the output signals", tb->err_cycles[COND_output]);
+
+  CHECK("tb_fetch_pipelined.pipeline_wait.05",
+      tb->conditions[COND_throughput],
+      "Failed to output one instruction per cycle", tb->err_cycles[COND_throughput]);
+}
+
+void tb_fetch_pipelined_jump_during_wait(TB_Fetch_pipelined * tb) {
+  Vtb_fetch_pipelined * core = tb->core;
+  core->testcase = T_JUMP_DURING_WAIT;
+
+  // The following actions are performed in this test :
+  //    tick 0. Set inputs with a memory latency of 3 cycles
+  //    tick 1-5. Nothing (core has requests in flight)
+  //    tick 6. Request a jump
+  //    tick 7-30. Nothing (core drops the pending responses)
+
+  //=================================
+  //      Tick (0)
+
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  tb->slave.latency = 3;
+  core->wb_stall_i = 0;
+  core->output_ready_i = 1;
+
+  //=================================
+  //      Tick (1-5)
+
+  for(int i = 0; i < 5; i++) {
+    tb->tick();
+  }
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  uint32_t target = 0x2000 + (rand() % 0x100) * 4;
+  core->branch_i = 1;
+  core->branch_target_i = target;
+
+  //=================================
+  //      Tick (6)
+
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_output_valid,  (core->output_valid_o        ==  0));
+  tb->check(COND_buffer,        (core->tb_fetch_pipelined->drop_q  >  0));
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  core->branch_i = 0;
+  tb->outputs.clear();
+
+  //=================================
+  //      Tick (7-30)
+
+  for(int i = 0; i < 24; i++) {
+    tb->tick();
+  }
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_buffer,        (core->tb_fetch_pipelined->drop_q  ==  0));
+  tb->check(COND_throughput,    (tb->outputs.size()          >   0));
+  tb->check(COND_output,        tb->outputs_from(target));
+
+  //`````````````````````````````````
+  //      Formal Checks
+
+  CHECK("tb_fetch_pipelined.jump_during_wait.01",
+      tb->conditions[COND_output_valid],
+      "Failed to implement the output_valid_o signal", tb->err_cycles[COND_output_valid]);
+
+  CHECK("tb_fetch_pipelined.jump_during_wait.02",
+      tb->conditions[COND_buffer],
+      "Failed to drop the pending responses", tb->err_cycles[COND_buffer]);
+
+  CHECK("tb_fetch_pipelined.jump_during_wait.03",
+      tb->conditions[COND_output] && tb->conditions[COND_throughput],
+      "Failed to output the instructions from the jump target", tb->err_cycles[COND_output]);
+}
+
+void tb_fetch_pipelined_jump_during_memory_stall(TB_Fetch_pipelined * tb) {
+  Vtb_fetch_pipelined * core = tb->core;
+  core->testcase = T_JUMP_DURING_MEMORY_STALL;
+
+  // The following actions are performed in this test :
+  //    tick 0. Set inputs with memory stall
+  //    tick 1-3. Nothing (core holds the first request)
+  //    tick 4. Request a jump
+  //    tick 5. Unstall the memory
+  //    tick 6-20. Nothing (core outputs the instructions from the target)
+
+  //=================================
+  //      Tick (0)
+
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  core->wb_stall_i = 1;
+  core->output_ready_i = 1;
+
+  //=================================
+  //      Tick (1-3)
+
+  for(int i = 0; i < 3; i++) {
+    tb->tick();
+  }
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  uint32_t target = 0x2000 + (rand() % 0x100) * 4;
+  core->branch_i = 1;
+  core->branch_target_i = target;
+
+  //=================================
+  //      Tick (4)
+
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks
+
+  // The stalled request is held until accepted by the memory
+  tb->check(COND_wishbone,      (core->wb_adr_o              ==  core->tb_fetch_pipelined->BOOT_ADDRESS) &&
+                                (core->wb_stb_o              ==  1)    &&
+                                (core->wb_cyc_o              ==  1));
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  core->branch_i = 0;
+  core->wb_stall_i = 0;
+
+  //=================================
+  //      Tick (5-20)
+
+  for(int i = 0; i < 16; i++) {
+    tb->tick();
+  }
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_throughput,    (tb->outputs.size()          >   0));
+  tb->check(COND_output,        tb->outputs_from(target));
+
+  //`````````````````````````````````
+  //      Formal Checks
+
+  CHECK("tb_fetch_pipelined.jump_during_memory_stall.01",
+      tb->conditions[COND_wishbone],
+      "Failed to implement the wishbone protocol", tb->err_cycles[COND_wishbone]);
+
+  CHECK("tb_fetch_pipelined.jump_during_memory_stall.02",
+      tb->conditions[COND_output] && tb->conditions[COND_throughput],
+      "Failed to output the instructions from the jump target", tb->err_cycles[COND_output]);
+}
+
+void tb_fetch_pipelined_jump_back_to_back(TB_Fetch_pipelined * tb) {
+  Vtb_fetch_pipelined * core = tb->core;
+  core->testcase = T_JUMP_BACK_TO_BACK;
+
+  // The following actions are performed in this test :
+  //    tick 0. Set inputs with a memory latency of 2 cycles
+  //    tick 1-5. Nothing (core has requests in flight)
+  //    tick 6. Request a jump
+  //    tick 7. Request a second jump
+  //    tick 8-30. Nothing (core outputs the instructions from the second target)
+
+  //=================================
+  //      Tick (0)
+
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  tb->slave.latency = 2;
+  core->wb_stall_i = 0;
+  core->output_ready_i = 1;
+
+  //=================================
+  //      Tick (1-5)
+
+  for(int i = 0; i < 5; i++) {
+    tb->tick();
+  }
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  core->branch_i = 1;
+  core->branch_target_i = 0x2000;
+
+  //=================================
+  //      Tick (6)
+
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  core->branch_i = 1;
+  core->branch_target_i = 0x3000;
+
+  //=================================
+  //      Tick (7)
+
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  core->branch_i = 0;
+  tb->outputs.clear();
+
+  //=================================
+  //      Tick (8-30)
+
+  for(int i = 0; i < 23; i++) {
+    tb->tick();
+  }
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_buffer,        (core->tb_fetch_pipelined->drop_q  ==  0));
+  tb->check(COND_throughput,    (tb->outputs.size()          >   0));
+  tb->check(COND_output,        tb->outputs_from(0x3000));
+
+  //`````````````````````````````````
+  //      Formal Checks
+
+  CHECK("tb_fetch_pipelined.jump_back_to_back.01",
+      tb->conditions[COND_buffer],
+      "Failed to drop the pending responses", tb->err_cycles[COND_buffer]);
+
+  CHECK("tb_fetch_pipelined.jump_back_to_back.02",
+      tb->conditions[COND_output] && tb->conditions[COND_throughput],
+      "Failed to output the instructions from the jump target", tb->err_cycles[COND_output]);
+}
+
+int main(int argc, char ** argv, char ** env) {
+  srand(time(NULL));
+  Verilated::traceEverOn(true);
+
+  bool verbose = parse_verbose(argc, argv);
+
+  TB_Fetch_pipelined * tb = new TB_Fetch_pipelined;
+  tb->open_trace("waves/fetch_pipelined.vcd");
+  tb->open_testdata("testdata/fetch_pipelined.csv");
+  tb->set_debug_log(verbose);
+  tb->init_conditions(__CondIdEnd);
+
+  /************************************************************/
+
+  tb_fetch_pipelined_reset(tb);
+
+  tb_fetch_pipelined_no_stall(tb);
+
+  tb_fetch_pipelined_memory_stall(tb);
+
+  tb_fetch_pipelined_memory_wait(tb);
+
+  tb_fetch_pipelined_pipeline_wait(tb);
+
+  tb_fetch_pipelined_jump_during_wait(tb);
+  tb_fetch_pipelined_jump_during_memory_stall(tb);
+  tb_fetch_pipelined_jump_back_to_back(tb);
+
+  /************************************************************/
+
+  printf("[FETCH_PIPELINED]: ");
+  if(tb->success) {
+    printf("Done\n");
+  } else {
+    printf("Failed\n");
+  }
+
+  delete tb;
+  exit(EXIT_SUCCESS);
+}
@@ -0,0 +1,778 @@
+/*           __        _
+ *  ________/ /  ___ _(_)__  ___
+ * / __/ __/ _ \/ _ `/ / _ \/ -_)
+ * \__/\__/_//_/\_,_/_/_//_/\__/
+ *
+ * Copyright (C) Clément Chaine
+ * This file is part of ECAP5-DPROC <https://github.com/ecap5/ECAP5-DPROC>
+ *
+ * ECAP5-DPROC is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ECAP5-DPROC is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ECAP5-DPROC.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <verilated.h>
+#include <verilated_vcd_c.h>
+#include <svdpi.h>
+#include <deque>
+#include <map>
+#include <vector>
+
+#include "Vtb_fetch_w_prediction.h"
+#include "testbench.h"
+#include "wishbone_slave.h"
+#include "riscv.h"
+#include "Vtb_fetch_w_prediction_ecap5_dproc_pkg.h"
+#include "Vtb_fetch_w_prediction_tb_fetch_w_prediction.h"
+
+enum CondId {
+  COND_output,
+  COND_prediction,
+  COND_throughput,
+  COND_buffer,
+  __CondIdEnd
+};
+
+enum TestcaseId {
+  T_JAL                 =  1,
+  T_BACKWARD_BRANCH     =  2,
+  T_FORWARD_BRANCH      =  3,
+  T_MEMORY_WAIT         =  4,
+  T_MISPREDICTION       =  5,
+  T_PREDICTOR_TAKEN     =  6,
+  T_PREDICTOR_NOT_TAKEN =  7,
+  T_RETURN              =  8,
+  T_RETURN_EMPTY        =  9,
+  T_RETURN_BRANCH       =  10
+};
+
+struct Entry {
+  uint32_t target;
+  bool taken;
+};
+
+struct Output {
+  uint32_t pc;
+  uint32_t instr;
+  bool pred_taken;
+  uint32_t pred_target;
+};
+
+class TB_Fetch_w_prediction : public Testbench<Vtb_fetch_w_prediction> {
+public:
+  // Pipelined wishbone slave model
+  WishboneSlave<uint32_t> slave;
+  uint32_t cycle;
+  // Instructions stored in memory, NOP being read everywhere else
+  std::map<uint32_t, uint32_t> program;
+  // Branch predictor model
+  std::map<uint32_t, Entry> predictor;
+  // Output handshakes performed by the fetch stage
+  std::vector<Output> outputs;
+
+  void reset() {
+    this->core->branch_i = 0;
+    this->core->branch_target_i = 0;
+    this->core->wb_stall_i = 0;
+    this->core->wb_ack_i = 0;
+    this->core->wb_dat_i = 0;
+    this->core->output_ready_i = 0;
+    this->core->bp_lookup_hit_i = 0;
+    this->core->bp_lookup_taken_i = 0;
+    this->core->bp_lookup_target_i = 0;
+
+    this->core->rst_i = 1;
+    for(int i = 0; i < 5; i++) {
+      this->tick();
+    }
+    this->core->rst_i = 0;
+
+    this->slave.latency = 0;
+    this->cycle = 0;
+    this->slave.clear();
+    this->program.clear();
+    this->predictor.clear();
+    this->outputs.clear();
+
+    Testbench<Vtb_fetch_w_prediction>::reset();
+  }
+
+  uint32_t memory(uint32_t adr) {
+    auto it = this->program.find(adr);
+    if(it == this->program.end()) {
+      return instr_addi(0, 0, 0);
+    }
+    return it->second;
+  }
+
+  void tick() {
+    this->slave.accept(this->cycle, this->core->wb_stb_o, this->core->wb_cyc_o, this->core->wb_stall_i,
+                       this->core->wb_adr_o);
+    uint32_t adr = 0;
+    this->core->wb_ack_i = this->slave.respond(this->cycle, adr);
+    this->core->wb_dat_i = this->core->wb_ack_i ? memory(adr) : 0;
+
+    // The lookup address depends on the response
+    this->core->eval();
+    auto it = this->predictor.find(this->core->bp_lookup_pc_o);
+    this->core->bp_lookup_hit_i = (it != this->predictor.end());
+    this->core->bp_lookup_taken_i = (it != this->predictor.end()) && it->second.taken;
+    this->core->bp_lookup_target_i = (it != this->predictor.end()) ? it->second.target : 0;
+
+    if(this->core->output_valid_o && this->core->output_ready_i) {
+      this->outputs.push_back({this->core->pc_o, this->core->instr_o, (bool)this->core->pred_taken_o,
+                               this->core->pred_target_o});
+    }
+
+    Testbench<Vtb_fetch_w_prediction>::tick();
+    this->cycle += 1;
+  }
+
+  // Checks that the outputs start with the provided sequence of addresses
+  bool outputs_match(const std::vector<uint32_t> & pcs) {
+    if(this->outputs.size() < pcs.size()) {
+      return false;
+    }
+    for(size_t i = 0; i < pcs.size(); i++) {
+      if((this->outputs[i].pc != pcs[i]) || (this->outputs[i].instr != memory(pcs[i]))) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // Checks that only the provided address is output as predicted taken
+  bool predicted_only(uint32_t pc) {
+    for(size_t i = 0; i < this->outputs.size(); i++) {
+      if(this->outputs[i].pred_taken != (this->outputs[i].pc == pc)) {
+        return false;
+      }
+    }
+    return true;
+  }
+};
+
+void tb_fetch_w_prediction_jal(TB_Fetch_w_prediction * tb) {
+  Vtb_fetch_w_prediction * core = tb->core;
+  core->testcase = T_JAL;
+
+  // The following actions are performed in this test :
+  //    tick 0. Set inputs with a jump in memory
+  //    tick 1-12. Nothing (core follows the jump)
+
+  //=================================
+  //      Tick (0)
+
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  uint32_t boot = core->tb_fetch_w_prediction->BOOT_ADDRESS;
+  uint32_t offset = 0x100 + (rand() % 0x40) * 4;
+  tb->program[boot + 8] = instr_jal(rand() % 32, offset);
+
+  core->wb_stall_i = 0;
+  core->output_ready_i = 1;
+
+  //=================================
+  //      Tick (1-12)
+
+  for(int i = 0; i < 12; i++) {
+    tb->tick();
+  }
+
+  //`````````````````````````````````
+  //      Checks
+
+  uint32_t target = boot + 8 + offset;
+  tb->check(COND_output,        tb->outputs_match({boot, boot + 4, boot + 8, target, target + 4, target + 8}));
+  tb->check(COND_prediction,    tb->predicted_only(boot + 8));
+  // No cycle is lost when following the jump
+  tb->check(COND_throughput,    (tb->outputs.size()          ==  10));
+
+  //`````````````````````````````````
+  //      Formal Checks
+
+  CHECK("tb_fetch_w_prediction.jal.01",
+      tb->conditions[COND_output],
+      "Failed to fetch the target of the jump", tb->err_cycles[COND_output]);
+
+  CHECK("tb_fetch_w_prediction.jal.02",
+      tb->conditions[COND_prediction],
+      "Failed to implement the pred_taken_o signal", tb->err_cycles[COND_prediction]);
+
+  CHECK("tb_fetch_w_prediction.jal.03",
+      tb->conditions[COND_throughput],
+      "Failed to output one instruction per cycle", tb->err_cycles[COND_throughput]);
+}
+
+void tb_fetch_w_prediction_backward_branch(TB_Fetch_w_prediction * tb) {
+  Vtb_fetch_w_prediction * core = tb->core;
+  core->testcase = T_BACKWARD_BRANCH;
+
+  // The following actions are performed in this test :
+  //    tick 0. Set inputs with a loop in memory
+  //    tick 1-12. Nothing (core follows the backward branch)
+
+  //=================================
+  //      Tick (0)
+
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  uint32_t boot = core->tb_fetch_w_prediction->BOOT_ADDRESS;
+  tb->program[boot + 8] = instr_bne(rand() % 32, rand() % 32, -8);
+
+  core->wb_stall_i = 0;
+  core->output_ready_i = 1;
+
+  //=================================
+  //      Tick (1-12)
+
+  for(int i = 0; i < 12; i++) {
+    tb->tick();
+  }
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_output,        tb->outputs_match({boot + 0, boot + 4, boot + 8,
+                                                   boot + 0, boot + 4, boot + 8,
+                                                   boot + 0, boot + 4, boot + 8}));
+  tb->check(COND_prediction,    tb->predicted_only(boot + 8));
+  tb->check(COND_throughput,    (tb->outputs.size()          ==  10));
+
+  //`````````````````````````````````
+  //      Formal Checks
+
+  CHECK("tb_fetch_w_prediction.backward_branch.01",
+      tb->conditions[COND_output],
+      "Failed to fetch the target of the backward branch", tb->err_cycles[COND_output]);
+
+  CHECK("tb_fetch_w_prediction.backward_branch.02",
+      tb->conditions[COND_prediction],
+      "Failed to implement the pred_taken_o signal", tb->err_cycles[COND_prediction]);
+
+  CHECK("tb_fetch_w_prediction.backward_branch.03",
+      tb->conditions[COND_throughput],
+      "Failed to output one instruction per cycle", tb->err_cycles[COND_throughput]);
+}
+
+void tb_fetch_w_prediction_forward_branch(TB_Fetch_w_prediction * tb) {
+  Vtb_fetch_w_prediction * core = tb->core;
+  core->testcase = T_FORWARD_BRANCH;
+
+  // The following actions are performed in this test :
+  //    tick 0. Set inputs with a forward branch in memory
+  //    tick 1-8. Nothing (core fetches sequentially)
+
+  //=================================
+  //      Tick (0)
+
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  uint32_t boot = core->tb_fetch_w_prediction->BOOT_ADDRESS;
+  tb->program[boot + 4] = instr_beq(rand() % 32, rand() % 32, 0x100);
+
+  core->wb_stall_i = 0;
+  core->output_ready_i = 1;
+
+  //=================================
+  //      Tick (1-8)
+
+  for(int i = 0; i < 8; i++) {
+    tb->tick();
+  }
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_output,        tb->outputs_match({boot, boot + 4, boot + 8, boot + 12, boot + 16, boot + 20}));
+  tb->check(COND_prediction,    tb->predicted_only(0));
+
+  //`````````````````````````````````
+  //      Formal Checks
+
+  CHECK("tb_fetch_w_prediction.forward_branch.01",
+      tb->conditions[COND_output],
+      "Failed to fetch sequentially after a forward branch", tb->err_cycles[COND_output]);
+
+  CHECK("tb_fetch_w_prediction.forward_branch.02",
+      tb->conditions[COND_prediction],
+      "Failed to implement the pred_taken_o signal", tb->err_cycles[COND_prediction]);
+}
+
+void tb_fetch_w_prediction_memory_wait(TB_Fetch_w_prediction * tb) {
+  Vtb_fetch_w_prediction * core = tb->core;
+  core->testcase = T_MEMORY_WAIT;
+
+  // The following actions are performed in this test :
+  //    tick 0. Set inputs with a memory latency of 2 cycles and a jump in memory
+  //    tick 1-20. Nothing (core drops the requests following the jump)
+
+  //=================================
+  //      Tick (0)
+
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  uint32_t boot = core->tb_fetch_w_prediction->BOOT_ADDRESS;
+  tb->program[boot + 4] = instr_jal(0, 0x200);
+
+  tb->slave.latency = 2;
+  core->wb_stall_i = 0;
+  core->output_ready_i = 1;
+
+  //=================================
+  //      Tick (1-20)
+
+  for(int i = 0; i < 20; i++) {
+    tb->tick();
+  }
+
+  //`````````````````````````````````
+  //      Checks
+
+  uint32_t target = boot + 4 + 0x200;
+  tb->check(COND_output,        tb->outputs_match({boot, boot + 4, target, target + 4, target + 8}));
+  tb->check(COND_prediction,    tb->predicted_only(boot + 4));
+  tb->check(COND_buffer,        (core->tb_fetch_w_prediction->drop_q  ==  0));
+
+  //`````````````````````````````````
+  //      Formal Checks
+
+  CHECK("tb_fetch_w_prediction.memory_wait.01",
+      tb->conditions[COND_output],
+      "Failed to drop the requests following the jump", tb->err_cycles[COND_output]);
+
+  CHECK("tb_fetch_w_prediction.memory_wait.02",
+      tb->conditions[COND_prediction],
+      "Failed to implement the pred_taken_o signal", tb->err_cycles[COND_prediction]);
+
+  CHECK("tb_fetch_w_prediction.memory_wait.03",
+      tb->conditions[COND_buffer],
+      "Failed to receive the dropped responses", tb->err_cycles[COND_buffer]);
+}
+
+void tb_fetch_w_prediction_misprediction(TB_Fetch_w_prediction * tb) {
+  Vtb_fetch_w_prediction * core = tb->core;
+  core->testcase = T_MISPREDICTION;
+
+  // The following actions are performed in this test :
+  //    tick 0. Set inputs with a loop in memory
+  //    tick 1-4. Nothing (core follows the backward branch)
+  //    tick 5. Request a jump to the fall-through address
+  //    tick 6-15. Nothing (core exits the loop)
+
+  //=================================
+  //      Tick (0)
+
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  uint32_t boot = core->tb_fetch_w_prediction->BOOT_ADDRESS;
+  tb->program[boot + 4] = instr_bne(1, 2, -4);
+
+  core->wb_stall_i = 0;
+  core->output_ready_i = 1;
+
+  //=================================
+  //      Tick (1-4)
+
+  for(int i = 0; i < 4; i++) {
+    tb->tick();
+  }
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  // The branch is resolved as not taken
+  core->branch_i = 1;
+  core->branch_target_i = boot + 8;
+
+  //=================================
+  //      Tick (5)
+
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  core->branch_i = 0;
+  tb->outputs.clear();
+
+  //=================================
+  //      Tick (6-15)
+
+  for(int i = 0; i < 10; i++) {
+    tb->tick();
+  }
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_output,        tb->outputs_match({boot + 8, boot + 12, boot + 16, boot + 20}));
+  tb->check(COND_prediction,    tb->predicted_only(0));
+
+  //`````````````````````````````````
+  //      Formal Checks
+
+  CHECK("tb_fetch_w_prediction.misprediction.01",
+      tb->conditions[COND_output],
+      "Failed to recover from a misprediction", tb->err_cycles[COND_output]);
+
+  CHECK("tb_fetch_w_prediction.misprediction.02",
+      tb->conditions[COND_prediction],
+      "Failed to implement the pred_taken_o signal", tb->err_cycles[COND_prediction]);
+}
+
+void tb_fetch_w_prediction_predictor_taken(TB_Fetch_w_prediction * tb) {
+  Vtb_fetch_w_prediction * core = tb->core;
+  core->testcase = T_PREDICTOR_TAKEN;
+
+  // The following actions are performed in this test :
+  //    tick 0. Set inputs with a forward branch predicted taken by the branch predictor
+  //    tick 1-12. Nothing (core follows the branch)
+
+  //=================================
+  //      Tick (0)
+
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  uint32_t boot = core->tb_fetch_w_prediction->BOOT_ADDRESS;
+  uint32_t target = boot + 8 + 0x100;
+  tb->program[boot + 8] = instr_beq(rand() % 32, rand() % 32, 0x100);
+  tb->predictor[boot + 8] = {target, true};
+
+  core->wb_stall_i = 0;
+  core->output_ready_i = 1;
+
+  //=================================
+  //      Tick (1-12)
+
+  for(int i = 0; i < 12; i++) {
+    tb->tick();
+  }
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_output,        tb->outputs_match({boot, boot + 4, boot + 8, target, target + 4, target + 8}));
+  tb->check(COND_prediction,    tb->predicted_only(boot + 8));
+  tb->check(COND_throughput,    (tb->outputs.size()          ==  10));
+
+  //`````````````````````````````````
+  //      Formal Checks
+
+  CHECK("tb_fetch_w_prediction.predictor_taken.01",
+      tb->conditions[COND_output],
+      "Failed to fetch the target provided by the branch predictor", tb->err_cycles[COND_output]);
+
+  CHECK("tb_fetch_w_prediction.predictor_taken.02",
+      tb->conditions[COND_prediction],
+      "Failed to implement the pred_taken_o signal", tb->err_cycles[COND_prediction]);
+
+  CHECK("tb_fetch_w_prediction.predictor_taken.03",
+      tb->conditions[COND_throughput],
+      "Failed to output one instruction per cycle", tb->err_cycles[COND_throughput]);
+}
+
+void tb_fetch_w_prediction_predictor_not_taken(TB_Fetch_w_prediction * tb) {
+  Vtb_fetch_w_prediction * core = tb->core;
+  core->testcase = T_PREDICTOR_NOT_TAKEN;
+
+  // The following actions are performed in this test :
+  //    tick 0. Set inputs with a backward branch predicted not taken by the branch predictor
+  //    tick 1-8. Nothing (core fetches sequentially)
+
+  //=================================
+  //      Tick (0)
+
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  uint32_t boot = core->tb_fetch_w_prediction->BOOT_ADDRESS;
+  tb->program[boot + 8] = instr_bne(rand() % 32, rand() % 32, -8);
+  tb->predictor[boot + 8] = {boot, false};
+
+  core->wb_stall_i = 0;
+  core->output_ready_i = 1;
+
+  //=================================
+  //      Tick (1-8)
+
+  for(int i = 0; i < 8; i++) {
+    tb->tick();
+  }
+
+  //`````````````````````````````````
+  //      Checks
+
+  // The static prediction is overridden by the branch predictor
+  tb->check(COND_output,        tb->outputs_match({boot, boot + 4, boot + 8, boot + 12, boot + 16, boot + 20}));
+  tb->check(COND_prediction,    tb->predicted_only(0));
+
+  //`````````````````````````````````
+  //      Formal Checks
+
+  CHECK("tb_fetch_w_prediction.predictor_not_taken.01",
+      tb->conditions[COND_output],
+      "Failed to fetch sequentially after a branch predicted not taken", tb->err_cycles[COND_output]);
+
+  CHECK("tb_fetch_w_prediction.predictor_not_taken.02",
+      tb->conditions[COND_prediction],
+      "Failed to implement the pred_taken_o signal", tb->err_cycles[COND_prediction]);
+}
+
+void tb_fetch_w_prediction_return(TB_Fetch_w_prediction * tb) {
+  Vtb_fetch_w_prediction * core = tb->core;
+  core->testcase = T_RETURN;
+
+  // The following actions are performed in this test :
+  //    tick 0. Set inputs with two nested calls in memory
+  //    tick 1-14. Nothing (core follows the calls and the returns)
+
+  //=================================
+  //      Tick (0)
+
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  uint32_t boot = core->tb_fetch_w_prediction->BOOT_ADDRESS;
+  uint32_t link = (rand() % 2) ? 1 : 5;
+  tb->program[boot]         = instr_jal(link, 0x100);
+  tb->program[boot + 0x100] = instr_jal(link, 0x100);
+  tb->program[boot + 0x200] = instr_jalr(0, link, 0);
+  tb->program[boot + 0x104] = instr_jalr(0, link, 0);
+
+  core->wb_stall_i = 0;
+  core->output_ready_i = 1;
+
+  //=================================
+  //      Tick (1-14)
+
+  for(int i = 0; i < 14; i++) {
+    tb->tick();
+  }
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_output,        tb->outputs_match({boot, boot + 0x100, boot + 0x200, boot + 0x104, boot + 4, boot + 8}));
+
+  // The returns are predicted taken to the address following their call
+  tb->check(COND_prediction,    (tb->outputs.size()          >=  6)            &&
+                                (tb->outputs[2].pred_taken   ==  1)            &&
+                                (tb->outputs[2].pred_target  ==  boot + 0x104) &&
+                                (tb->outputs[3].pred_taken   ==  1)            &&
+                                (tb->outputs[3].pred_target  ==  boot + 4)     &&
+                                (tb->outputs[4].pred_taken   ==  0)            &&
+                                (tb->outputs[5].pred_taken   ==  0));
+
+  //`````````````````````````````````
+  //      Formal Checks
+
+  CHECK("tb_fetch_w_prediction.return.01",
+      tb->conditions[COND_output],
+      "Failed to fetch the return address of the calls", tb->err_cycles[COND_output]);
+
+  CHECK("tb_fetch_w_prediction.return.02",
+      tb->conditions[COND_prediction],
+      "Failed to implement the return address stack", tb->err_cycles[COND_prediction]);
+}
+
+void tb_fetch_w_prediction_return_empty(TB_Fetch_w_prediction * tb) {
+  Vtb_fetch_w_prediction * core = tb->core;
+  core->testcase = T_RETURN_EMPTY;
+
+  // The following actions are performed in this test :
+  //    tick 0. Set inputs with a return not preceded by a call in memory
+  //    tick 1-8. Nothing (core fetches sequentially)
+
+  //=================================
+  //      Tick (0)
+
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  uint32_t boot = core->tb_fetch_w_prediction->BOOT_ADDRESS;
+  tb->program[boot + 8] = instr_jalr(0, 1, 0);
+
+  core->wb_stall_i = 0;
+  core->output_ready_i = 1;
+
+  //=================================
+  //      Tick (1-8)
+
+  for(int i = 0; i < 8; i++) {
+    tb->tick();
+  }
+
+  //`````````````````````````````````
+  //      Checks
+
+  // The return is left to the execute module when the stack is empty
+  tb->check(COND_output,        tb->outputs_match({boot, boot + 4, boot + 8, boot + 12, boot + 16, boot + 20}));
+  tb->check(COND_prediction,    tb->predicted_only(0));
+
+  //`````````````````````````````````
+  //      Formal Checks
+
+  CHECK("tb_fetch_w_prediction.return_empty.01",
+      tb->conditions[COND_output],
+      "Failed to fetch sequentially after a return with an empty stack", tb->err_cycles[COND_output]);
+
+  CHECK("tb_fetch_w_prediction.return_empty.02",
+      tb->conditions[COND_prediction],
+      "Failed to implement the pred_taken_o signal", tb->err_cycles[COND_prediction]);
+}
+
+void tb_fetch_w_prediction_return_branch(TB_Fetch_w_prediction * tb) {
+  Vtb_fetch_w_prediction * core = tb->core;
+  core->testcase = T_RETURN_BRANCH;
+
+  // The following actions are performed in this test :
+  //    tick 0. Set inputs with a call in memory
+  //    tick 1-4. Nothing (core follows the call)
+  //    tick 5. Request a jump to a return
+  //    tick 6-15. Nothing (core fetches sequentially after the return)
+
+  //=================================
+  //      Tick (0)
+
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  uint32_t boot = core->tb_fetch_w_prediction->BOOT_ADDRESS;
+  uint32_t link = (rand() % 2) ? 1 : 5;
+  tb->program[boot]         = instr_jal(link, 0x100);
+  tb->program[boot + 0x200] = instr_jalr(0, link, 0);
+
+  core->wb_stall_i = 0;
+  core->output_ready_i = 1;
+
+  //=================================
+  //      Tick (1-4)
+
+  for(int i = 0; i < 4; i++) {
+    tb->tick();
+  }
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  // The call was fetched on a wrong path
+  core->branch_i = 1;
+  core->branch_target_i = boot + 0x200;
+
+  //=================================
+  //      Tick (5)
+
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  core->branch_i = 0;
+  tb->outputs.clear();
+
+  //=================================
+  //      Tick (6-15)
+
+  for(int i = 0; i < 10; i++) {
+    tb->tick();
+  }
+
+  //`````````````````````````````````
+  //      Checks
+
+  // The return is left to the execute module as the stack was emptied
+  tb->check(COND_output,        tb->outputs_match({boot + 0x200, boot + 0x204, boot + 0x208, boot + 0x20C}));
+  tb->check(COND_prediction,    tb->predicted_only(0));
+
+  //`````````````````````````````````
+  //      Formal Checks
+
+  CHECK("tb_fetch_w_prediction.return_branch.01",
+      tb->conditions[COND_output],
+      "Failed to fetch sequentially after a return following a branch request", tb->err_cycles[COND_output]);
+
+  CHECK("tb_fetch_w_prediction.return_branch.02",
+      tb->conditions[COND_prediction],
+      "Failed to empty the return address stack upon branch request", tb->err_cycles[COND_prediction]);
+}
+
+int main(int argc, char ** argv, char ** env) {
+  srand(time(NULL));
+  Verilated::traceEverOn(true);
+
+  bool verbose = parse_verbose(argc, argv);
+
+  TB_Fetch_w_prediction * tb = new TB_Fetch_w_prediction;
+  tb->open_trace("waves/fetch_w_prediction.vcd");
+  tb->open_testdata("testdata/fetch_w_prediction.csv");
+  tb->set_debug_log(verbose);
+  tb->init_conditions(__CondIdEnd);
+
+  /************************************************************/
+
+  tb_fetch_w_prediction_jal(tb);
+  tb_fetch_w_prediction_backward_branch(tb);
+  tb_fetch_w_prediction_forward_branch(tb);
+
+  tb_fetch_w_prediction_memory_wait(tb);
+
+  tb_fetch_w_prediction_misprediction(tb);
+
+  tb_fetch_w_prediction_predictor_taken(tb);
+  tb_fetch_w_prediction_predictor_not_taken(tb);
+
+  tb_fetch_w_prediction_return(tb);
+  tb_fetch_w_prediction_return_empty(tb);
+  tb_fetch_w_prediction_return_branch(tb);
+
+  /************************************************************/
+
+  printf("[FETCH_W_PREDICTION]: ");
+  if(tb->success) {
+    printf("Done\n");
+  } else {
+    printf("Failed\n");
+  }
+
+  delete tb;
+  exit(EXIT_SUCCESS);
+}
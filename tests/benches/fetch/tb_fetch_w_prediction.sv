@@ -0,0 +1,101 @@
+/*           __        _
+ *  ________/ /  ___ _(_)__  ___
+ * / __/ __/ _ \/ _ `/ / _ \/ -_)
+ * \__/\__/_//_/\_,_/_/_//_/\__/
+ * 
+ * Copyright (C) Clément Chaine
+ * This file is part of ECAP5-DPROC <https://github.com/ecap5/ECAP5-DPROC>
+ *
+ * ECAP5-DPROC is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ECAP5-DPROC is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ECAP5-DPROC.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+module tb_fetch_w_prediction (
+  input   int          testcase,
+  
+  input   logic        clk_i,
+  input   logic        rst_i,
+  // Jump inputs
+  input   logic        branch_i,
+  input   logic[31:0]  branch_target_i,
+  // Wishbone master
+  output  logic[31:0]  wb_adr_o,
+  input   logic[31:0]  wb_dat_i, 
+  output  logic        wb_we_o,
+  output  logic[3:0]   wb_sel_o,
+  output  logic        wb_stb_o, 
+  input   logic        wb_ack_i, 
+  output  logic        wb_cyc_o, 
+  input   logic        wb_stall_i,
+  // Output Handshake
+  input   logic        output_ready_i,
+  output  logic        output_valid_o,
+  // DECM outputs
+  output  logic[31:0]  instr_o,
+  output  logic[31:0]  pc_o,
+  output  logic        pred_taken_o,
+  output  logic[31:0]  pred_target_o,
+  // Branch predictor interface
+  output  logic[31:0]  bp_lookup_pc_o,
+  input   logic        bp_lookup_hit_i,
+  input   logic        bp_lookup_taken_i,
+  input   logic[31:0]  bp_lookup_target_i
+);
+
+localparam logic[31:0] BOOT_ADDRESS = 32'h00001000;
+localparam int         FETCH_DEPTH  = 4;
+localparam int         RAS_DEPTH    = 2;
+
+// Internal signals of the parameterized fetch module
+logic[2:0] drop_q;
+
+fetch #(
+  .BOOT_ADDRESS      (BOOT_ADDRESS),
+  .PIPELINED_FETCH   (1),
+  .FETCH_DEPTH       (FETCH_DEPTH),
+  .BRANCH_PREDICTION (1),
+  .RAS_DEPTH         (RAS_DEPTH)
+) dut (
+  .clk_i           (clk_i),
+  .rst_i           (rst_i),
+  .branch_i        (branch_i),
+  .branch_target_i (branch_target_i),
+  .wb_adr_o        (wb_adr_o),
+  .wb_dat_i        (wb_dat_i),
+  .wb_we_o         (wb_we_o),
+  .wb_sel_o        (wb_sel_o),
+  .wb_stb_o        (wb_stb_o),
+  .wb_ack_i        (wb_ack_i),
+  .wb_cyc_o        (wb_cyc_o),
+  .wb_stall_i      (wb_stall_i),
+  .output_ready_i  (output_ready_i),
+  .output_valid_o  (output_valid_o),
+  .instr_o         (instr_o),
+  .pc_o            (pc_o),
+  .pred_taken_o    (pred_taken_o),
+  .pred_target_o   (pred_target_o),
+  .bp_lookup_pc_o     (bp_lookup_pc_o),
+  .bp_lookup_hit_i    (bp_lookup_hit_i),
+  .bp_lookup_taken_i  (bp_lookup_taken_i),
+  .bp_lookup_target_i (bp_lookup_target_i)
+);
+
+assign drop_q = dut.drop_q;
+
+endmodule // tb_fetch_w_prediction
+
+`verilator_config
+
+public -module "tb_fetch_w_prediction" -var "BOOT_ADDRESS"
+public -module "tb_fetch_w_prediction" -var "FETCH_DEPTH"
+public -module "tb_fetch_w_prediction" -var "drop_q"
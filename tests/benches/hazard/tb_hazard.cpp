@@ -43,7 +43,8 @@ enum TestcaseId {
   T_DATA_PORT1 = 3,
   T_DATA_PORT2 = 4,
   T_DATA_MULTIPLE = 5,
-  T_RESET = 6
+  T_RESET = 6,
+  T_DATA_SCOREBOARD = 7
 };
 
 class TB_Hazard : public Testbench<Vtb_hazard> {
@@ -69,6 +70,7 @@ public:
     core->ls_reg_addr_i = 0;
     core->reg_write_i = 0;
     core->reg_waddr_i = 0;
+    core->ls_scoreboard_i = 0;
   }
 
 };
@@ -123,7 +125,8 @@ void tb_hazard_control(TB_Hazard * tb) {
   //`````````````````````````````````
   //      Checks 
 
-  tb->check(COND_control, (core->ex_discard_request_o == 1));
+  tb->check(COND_control, (core->ex_discard_request_o == 1) &&
+                          (core->dec_discard_request_o == 1));
 
   //=================================
   //      Tick (1)
@@ -140,6 +143,14 @@ void tb_hazard_control(TB_Hazard * tb) {
   
   core->branch_i = 0;
 
+  // the output is asynchrounous
+  core->eval();
+
+  //`````````````````````````````````
+  //      Checks 
+
+  tb->check(COND_control, (core->dec_discard_request_o == 0));
+
   //=================================
   //      Tick (2)
   
@@ -545,6 +556,97 @@ void tb_hazard_data_multiple(TB_Hazard * tb) {
       "Failed to protect against data hazards", tb->err_cycles[COND_data]);
 }
 
+void tb_hazard_data_scoreboard(TB_Hazard * tb) {
+  Vtb_hazard * core = tb->core;
+  core->testcase = T_DATA_SCOREBOARD;
+
+  // The following actions are performed in this test :
+  //    tick 0. Set inputs for data hazard with x0 marked in the scoreboard
+  //    tick 1. Set inputs for data hazard on each register marked in the scoreboard
+  //    tick 2. Set inputs without data hazard on registers not marked in the scoreboard
+
+  //=================================
+  //      Tick (0)
+  
+  tb->reset();
+  
+  //`````````````````````````````````
+  //      Set inputs
+  
+  core->reg_raddr1_i = 0;
+  core->reg_raddr2_i = 0;
+  core->ls_scoreboard_i = 0x1;
+
+  //=================================
+  //      Tick (1)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks 
+
+  tb->check(COND_data, (core->dec_stall_request_o == 0));
+
+  for(int i = 1; i < 32; i++) {
+    //`````````````````````````````````
+    //      Set inputs
+    
+    core->ls_scoreboard_i = (1 << i);
+    core->reg_raddr1_i = i;
+    core->reg_raddr2_i = 0;
+
+    //=================================
+    //      Tick (2)
+    
+    tb->tick();
+
+    //`````````````````````````````````
+    //      Checks 
+
+    tb->check(COND_data, (core->dec_stall_request_o == 1));
+
+    //`````````````````````````````````
+    //      Set inputs
+    
+    core->reg_raddr1_i = 0;
+    core->reg_raddr2_i = i;
+
+    //=================================
+    //      Tick (3)
+    
+    tb->tick();
+
+    //`````````````````````````````````
+    //      Checks 
+
+    tb->check(COND_data, (core->dec_stall_request_o == 1));
+
+    //`````````````````````````````````
+    //      Set inputs
+    
+    core->ls_scoreboard_i = ~(1 << i) & ~0x1;
+    core->reg_raddr1_i = i;
+    core->reg_raddr2_i = i;
+
+    //=================================
+    //      Tick (4)
+    
+    tb->tick();
+
+    //`````````````````````````````````
+    //      Checks 
+
+    tb->check(COND_data, (core->dec_stall_request_o == 0));
+  }
+
+  //`````````````````````````````````
+  //      Formal Checks 
+
+  CHECK("tb_hazard.data.SCOREBOARD_01",
+      tb->conditions[COND_data],
+      "Failed to protect against data hazards on pending loads", tb->err_cycles[COND_data]);
+}
+
 int main(int argc, char ** argv, char ** env) {
   srand(time(NULL));
   Verilated::traceEverOn(true);
@@ -567,6 +669,7 @@ int main(int argc, char ** argv, char ** env) {
   tb_hazard_data_port1(tb);
   tb_hazard_data_port2(tb);
   tb_hazard_data_multiple(tb);
+  tb_hazard_data_scoreboard(tb);
 
   /************************************************************/
 
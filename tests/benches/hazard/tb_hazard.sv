@@ -29,6 +29,7 @@ module tb_hazard import ecap5_dproc_pkg::*;
 
   input   logic  branch_i,
   output  logic  ex_discard_request_o,
+  output  logic  dec_discard_request_o,
 
   input   logic[4:0] reg_raddr1_i,
   input   logic[4:0] reg_raddr2_i,
@@ -38,9 +39,22 @@ module tb_hazard import ecap5_dproc_pkg::*;
   input   logic[4:0] ex_reg_addr_i,
   input   logic      ls_reg_write_i,
   input   logic[4:0] ls_reg_addr_i,
+  input   logic[31:0] ls_scoreboard_i,
   input   logic      reg_write_i,
   input   logic[4:0] reg_waddr_i,
-  output  logic      dec_stall_request_o
+  output  logic      dec_stall_request_o,
+  input   logic      dec_branch_compare_i,
+
+  input   logic[31:0] reg_rdata1_i,
+  input   logic[31:0] reg_rdata2_i,
+  input   logic       dec_ls_enable_i,
+  input   logic       ex_ls_enable_i,
+  input   logic[31:0] ex_result_i,
+  input   logic       ls_valid_i,
+  input   logic[31:0] ls_reg_data_i,
+  input   logic[31:0] reg_wdata_i,
+  output  logic[31:0] dec_rdata1_o,
+  output  logic[31:0] dec_rdata2_o
 );
 
 hazard dut (
@@ -49,6 +63,7 @@ hazard dut (
 
   .branch_i (branch_i),
   .ex_discard_request_o (ex_discard_request_o),
+  .dec_discard_request_o (dec_discard_request_o),
 
   .reg_raddr1_i         (reg_raddr1_i),
   .reg_raddr2_i         (reg_raddr2_i),
@@ -58,9 +73,21 @@ hazard dut (
   .ex_reg_addr_i        (ex_reg_addr_i),
   .ls_reg_write_i       (ls_reg_write_i),
   .ls_reg_addr_i        (ls_reg_addr_i),
+  .ls_scoreboard_i      (ls_scoreboard_i),
   .reg_write_i          (reg_write_i),
   .reg_waddr_i          (reg_waddr_i),
-  .dec_stall_request_o  (dec_stall_request_o)
+  .dec_stall_request_o  (dec_stall_request_o),
+  .dec_branch_compare_i (dec_branch_compare_i),
+  .reg_rdata1_i         (reg_rdata1_i),
+  .reg_rdata2_i         (reg_rdata2_i),
+  .dec_ls_enable_i      (dec_ls_enable_i),
+  .ex_ls_enable_i       (ex_ls_enable_i),
+  .ex_result_i          (ex_result_i),
+  .ls_valid_i           (ls_valid_i),
+  .ls_reg_data_i        (ls_reg_data_i),
+  .reg_wdata_i          (reg_wdata_i),
+  .dec_rdata1_o         (dec_rdata1_o),
+  .dec_rdata2_o         (dec_rdata2_o)
 );
 
 endmodule // tb_hazard
@@ -0,0 +1,623 @@
+/*           __        _
+ *  ________/ /  ___ _(_)__  ___
+ * / __/ __/ _ \/ _ `/ / _ \/ -_)
+ * \__/\__/_//_/\_,_/_/_//_/\__/
+ * 
+ * Copyright (C) Clément Chaine
+ * This file is part of ECAP5-DPROC <https://github.com/ecap5/ECAP5-DPROC>
+ *
+ * ECAP5-DPROC is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ECAP5-DPROC is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ECAP5-DPROC.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <verilated.h>
+#include <verilated_vcd_c.h>
+#include <svdpi.h>
+
+#include "Vtb_hazard_w_forwarding.h"
+#include "testbench.h"
+#include "Vtb_hazard_w_forwarding_ecap5_dproc_pkg.h"
+
+enum CondId {
+  COND_data,
+  COND_forwarding,
+  __CondIdEnd
+};
+
+enum TestcaseId {
+  T_FORWARDING_EX = 1,
+  T_FORWARDING_LS = 2,
+  T_FORWARDING_RW = 3,
+  T_FORWARDING_PRIORITY = 4,
+  T_FORWARDING_X0 = 5,
+  T_LOAD_USE = 6,
+  T_RESET = 7,
+  T_BRANCH_COMPARE = 8
+};
+
+class TB_Hazard_w_forwarding : public Testbench<Vtb_hazard_w_forwarding> {
+public:
+  void reset() {
+    this->_nop();
+
+    this->core->rst_i = 1;
+    for(int i = 0; i < 5; i++) {
+      this->tick();
+    }
+    this->core->rst_i = 0;
+
+    Testbench<Vtb_hazard_w_forwarding>::reset();
+  }
+  
+  void _nop() {
+    core->reg_raddr1_i = 0;
+    core->reg_raddr2_i = 0;
+    core->dec_reg_write_i = 0;
+    core->dec_reg_addr_i = 0;
+    core->ex_reg_write_i = 0;
+    core->ex_reg_addr_i = 0;
+    core->ls_reg_write_i = 0;
+    core->ls_reg_addr_i = 0;
+    core->reg_write_i = 0;
+    core->reg_waddr_i = 0;
+
+    core->reg_rdata1_i = 0;
+    core->reg_rdata2_i = 0;
+    core->dec_ls_enable_i = 0;
+    core->ex_ls_enable_i = 0;
+    core->ex_result_i = 0;
+    core->ls_valid_i = 1;
+    core->ls_reg_data_i = 0;
+    core->reg_wdata_i = 0;
+    core->dec_branch_compare_i = 0;
+  }
+
+};
+
+void tb_hazard_w_forwarding_reset(TB_Hazard_w_forwarding * tb) {
+  Vtb_hazard_w_forwarding * core = tb->core;
+  core->testcase = T_RESET;
+
+  //=================================
+  //      Tick (0)
+  
+  tb->reset();
+  
+  //`````````````````````````````````
+  //      Checks 
+
+  tb->check(COND_data, (core->dec_stall_request_o == 0));
+
+  //`````````````````````````````````
+  //      Formal Checks 
+
+  CHECK("tb_hazard_w_forwarding.reset.01",
+      tb->conditions[COND_data],
+      "Failed to reset the module", tb->err_cycles[COND_data]);
+}
+
+void tb_hazard_w_forwarding_ex(TB_Hazard_w_forwarding * tb) {
+  Vtb_hazard_w_forwarding * core = tb->core;
+  core->testcase = T_FORWARDING_EX;
+
+  // The following actions are performed in this test :
+  //    tick 0. Set inputs with a result in the execute stage
+  //    tick 1. Nothing (core forwards the result)
+
+  //=================================
+  //      Tick (0)
+  
+  tb->reset();
+  
+  //`````````````````````````````````
+  //      Set inputs
+  
+  uint32_t reg1 = 1 + rand() % 31;
+  uint32_t reg2 = 1 + rand() % 31;
+  uint32_t result = rand();
+  core->reg_raddr1_i = reg1;
+  core->reg_raddr2_i = reg2;
+  core->reg_rdata1_i = rand();
+  core->reg_rdata2_i = rand();
+
+  core->ex_reg_write_i = 1;
+  core->ex_reg_addr_i = reg1;
+  core->ex_result_i = result;
+
+  //=================================
+  //      Tick (1)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks 
+
+  tb->check(COND_data, (core->dec_stall_request_o == 0));
+  tb->check(COND_forwarding, (core->dec_rdata1_o == result));
+  tb->check(COND_forwarding, (core->dec_rdata2_o == ((reg2 == reg1) ? result : core->reg_rdata2_i)));
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  core->ex_reg_addr_i = reg2;
+
+  //=================================
+  //      Tick (2)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks 
+
+  tb->check(COND_data, (core->dec_stall_request_o == 0));
+  tb->check(COND_forwarding, (core->dec_rdata1_o == ((reg2 == reg1) ? result : core->reg_rdata1_i)));
+  tb->check(COND_forwarding, (core->dec_rdata2_o == result));
+
+  //`````````````````````````````````
+  //      Formal Checks 
+
+  CHECK("tb_hazard_w_forwarding.ex.01",
+      tb->conditions[COND_data],
+      "Failed to remove the stall on a forwarded result", tb->err_cycles[COND_data]);
+
+  CHECK("tb_hazard_w_forwarding.ex.02",
+      tb->conditions[COND_forwarding],
+      "Failed to forward the execute result", tb->err_cycles[COND_forwarding]);
+}
+
+void tb_hazard_w_forwarding_ls(TB_Hazard_w_forwarding * tb) {
+  Vtb_hazard_w_forwarding * core = tb->core;
+  core->testcase = T_FORWARDING_LS;
+
+  // The following actions are performed in this test :
+  //    tick 0. Set inputs with a result in the loadstore stage
+  //    tick 1. Nothing (core forwards the result)
+
+  //=================================
+  //      Tick (0)
+  
+  tb->reset();
+  
+  //`````````````````````````````````
+  //      Set inputs
+  
+  uint32_t reg1 = 1 + rand() % 31;
+  uint32_t result = rand();
+  core->reg_raddr1_i = reg1;
+  core->reg_raddr2_i = reg1;
+  core->reg_rdata1_i = rand();
+  core->reg_rdata2_i = rand();
+
+  core->ls_reg_write_i = 1;
+  core->ls_reg_addr_i = reg1;
+  core->ls_reg_data_i = result;
+
+  //=================================
+  //      Tick (1)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks 
+
+  tb->check(COND_data, (core->dec_stall_request_o == 0));
+  tb->check(COND_forwarding, (core->dec_rdata1_o == result));
+  tb->check(COND_forwarding, (core->dec_rdata2_o == result));
+
+  //`````````````````````````````````
+  //      Formal Checks 
+
+  CHECK("tb_hazard_w_forwarding.ls.01",
+      tb->conditions[COND_data],
+      "Failed to remove the stall on a forwarded result", tb->err_cycles[COND_data]);
+
+  CHECK("tb_hazard_w_forwarding.ls.02",
+      tb->conditions[COND_forwarding],
+      "Failed to forward the loadstore result", tb->err_cycles[COND_forwarding]);
+}
+
+void tb_hazard_w_forwarding_rw(TB_Hazard_w_forwarding * tb) {
+  Vtb_hazard_w_forwarding * core = tb->core;
+  core->testcase = T_FORWARDING_RW;
+
+  // The following actions are performed in this test :
+  //    tick 0. Set inputs with a result being written back
+  //    tick 1. Nothing (core forwards the result)
+
+  //=================================
+  //      Tick (0)
+  
+  tb->reset();
+  
+  //`````````````````````````````````
+  //      Set inputs
+  
+  uint32_t reg1 = 1 + rand() % 31;
+  uint32_t result = rand();
+  core->reg_raddr1_i = reg1;
+  core->reg_raddr2_i = reg1;
+  core->reg_rdata1_i = rand();
+  core->reg_rdata2_i = rand();
+
+  core->reg_write_i = 1;
+  core->reg_waddr_i = reg1;
+  core->reg_wdata_i = result;
+
+  //=================================
+  //      Tick (1)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks 
+
+  tb->check(COND_data, (core->dec_stall_request_o == 0));
+  tb->check(COND_forwarding, (core->dec_rdata1_o == result));
+  tb->check(COND_forwarding, (core->dec_rdata2_o == result));
+
+  //`````````````````````````````````
+  //      Formal Checks 
+
+  CHECK("tb_hazard_w_forwarding.rw.01",
+      tb->conditions[COND_data],
+      "Failed to remove the stall on a forwarded result", tb->err_cycles[COND_data]);
+
+  CHECK("tb_hazard_w_forwarding.rw.02",
+      tb->conditions[COND_forwarding],
+      "Failed to forward the writeback result", tb->err_cycles[COND_forwarding]);
+}
+
+void tb_hazard_w_forwarding_priority(TB_Hazard_w_forwarding * tb) {
+  Vtb_hazard_w_forwarding * core = tb->core;
+  core->testcase = T_FORWARDING_PRIORITY;
+
+  // The following actions are performed in this test :
+  //    tick 0. Set inputs with a result in every stage
+  //    tick 1. Remove the execute result
+  //    tick 2. Remove the loadstore result
+
+  //=================================
+  //      Tick (0)
+  
+  tb->reset();
+  
+  //`````````````````````````````````
+  //      Set inputs
+  
+  uint32_t reg1 = 1 + rand() % 31;
+  uint32_t ex_result = rand();
+  uint32_t ls_result = rand();
+  uint32_t rw_result = rand();
+  core->reg_raddr1_i = reg1;
+  core->reg_rdata1_i = rand();
+
+  core->ex_reg_write_i = 1;
+  core->ex_reg_addr_i = reg1;
+  core->ex_result_i = ex_result;
+  core->ls_reg_write_i = 1;
+  core->ls_reg_addr_i = reg1;
+  core->ls_reg_data_i = ls_result;
+  core->reg_write_i = 1;
+  core->reg_waddr_i = reg1;
+  core->reg_wdata_i = rw_result;
+
+  //=================================
+  //      Tick (1)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks 
+
+  tb->check(COND_forwarding, (core->dec_rdata1_o == ex_result));
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  core->ex_reg_write_i = 0;
+
+  //=================================
+  //      Tick (2)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks 
+
+  tb->check(COND_forwarding, (core->dec_rdata1_o == ls_result));
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  core->ls_reg_write_i = 0;
+
+  //=================================
+  //      Tick (3)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks 
+
+  tb->check(COND_forwarding, (core->dec_rdata1_o == rw_result));
+
+  //`````````````````````````````````
+  //      Formal Checks 
+
+  CHECK("tb_hazard_w_forwarding.priority.01",
+      tb->conditions[COND_forwarding],
+      "Failed to forward the most recent result", tb->err_cycles[COND_forwarding]);
+}
+
+void tb_hazard_w_forwarding_x0(TB_Hazard_w_forwarding * tb) {
+  Vtb_hazard_w_forwarding * core = tb->core;
+  core->testcase = T_FORWARDING_X0;
+
+  // The following actions are performed in this test :
+  //    tick 0. Set inputs with results targeting x0
+
+  //=================================
+  //      Tick (0)
+  
+  tb->reset();
+  
+  //`````````````````````````````````
+  //      Set inputs
+  
+  core->reg_raddr1_i = 0;
+  core->reg_raddr2_i = 0;
+  core->reg_rdata1_i = 0;
+  core->reg_rdata2_i = 0;
+
+  core->ex_reg_write_i = 1;
+  core->ex_reg_addr_i = 0;
+  core->ex_result_i = 1 + rand();
+  core->ls_reg_write_i = 1;
+  core->ls_reg_addr_i = 0;
+  core->ls_reg_data_i = 1 + rand();
+  core->reg_write_i = 1;
+  core->reg_waddr_i = 0;
+  core->reg_wdata_i = 1 + rand();
+
+  //=================================
+  //      Tick (1)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks 
+
+  tb->check(COND_data, (core->dec_stall_request_o == 0));
+  tb->check(COND_forwarding, (core->dec_rdata1_o == 0));
+  tb->check(COND_forwarding, (core->dec_rdata2_o == 0));
+
+  //`````````````````````````````````
+  //      Formal Checks 
+
+  CHECK("tb_hazard_w_forwarding.x0.01",
+      tb->conditions[COND_data],
+      "Failed to ignore results targeting x0", tb->err_cycles[COND_data]);
+
+  CHECK("tb_hazard_w_forwarding.x0.02",
+      tb->conditions[COND_forwarding],
+      "Failed to ignore results targeting x0", tb->err_cycles[COND_forwarding]);
+}
+
+void tb_hazard_w_forwarding_load_use(TB_Hazard_w_forwarding * tb) {
+  Vtb_hazard_w_forwarding * core = tb->core;
+  core->testcase = T_LOAD_USE;
+
+  // The following actions are performed in this test :
+  //    tick 0. Set inputs with a load output by decode
+  //    tick 1. Move the load to the execute stage
+  //    tick 2. Move the load to the loadstore stage
+  //    tick 3. Complete the load
+
+  //=================================
+  //      Tick (0)
+  
+  tb->reset();
+  
+  //`````````````````````````````````
+  //      Set inputs
+  
+  uint32_t reg2 = 1 + rand() % 31;
+  uint32_t result = rand();
+  core->reg_raddr2_i = reg2;
+  core->reg_rdata2_i = rand();
+
+  core->dec_reg_write_i = 1;
+  core->dec_reg_addr_i = reg2;
+  core->dec_ls_enable_i = 1;
+
+  //=================================
+  //      Tick (1)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks 
+
+  tb->check(COND_data, (core->dec_stall_request_o == 1));
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  core->dec_reg_write_i = 0;
+  core->dec_ls_enable_i = 0;
+  core->ex_reg_write_i = 1;
+  core->ex_reg_addr_i = reg2;
+  core->ex_ls_enable_i = 1;
+
+  //=================================
+  //      Tick (2)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks 
+
+  tb->check(COND_data, (core->dec_stall_request_o == 1));
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  core->ex_reg_write_i = 0;
+  core->ex_ls_enable_i = 0;
+  core->ls_reg_write_i = 1;
+  core->ls_reg_addr_i = reg2;
+  core->ls_valid_i = 0;
+
+  //=================================
+  //      Tick (3)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks 
+
+  tb->check(COND_data, (core->dec_stall_request_o == 1));
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  core->ls_valid_i = 1;
+  core->ls_reg_data_i = result;
+
+  //=================================
+  //      Tick (4)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks 
+
+  tb->check(COND_data, (core->dec_stall_request_o == 0));
+  tb->check(COND_forwarding, (core->dec_rdata2_o == result));
+
+  //`````````````````````````````````
+  //      Formal Checks 
+
+  CHECK("tb_hazard_w_forwarding.load_use.01",
+      tb->conditions[COND_data],
+      "Failed to stall on a load-use hazard", tb->err_cycles[COND_data]);
+
+  CHECK("tb_hazard_w_forwarding.load_use.02",
+      tb->conditions[COND_forwarding],
+      "Failed to forward the loaded data", tb->err_cycles[COND_forwarding]);
+}
+
+void tb_hazard_w_forwarding_branch_compare(TB_Hazard_w_forwarding * tb) {
+  Vtb_hazard_w_forwarding * core = tb->core;
+  core->testcase = T_BRANCH_COMPARE;
+
+  // The following actions are performed in this test :
+  //    tick 0. Set inputs with a branch compared by decode depending on the decode output
+  //    tick 1. Move the result to the execute stage
+
+  //=================================
+  //      Tick (0)
+  
+  tb->reset();
+  
+  //`````````````````````````````````
+  //      Set inputs
+  
+  uint32_t reg1 = 1 + rand() % 31;
+  uint32_t result = rand();
+  core->reg_raddr1_i = reg1;
+  core->dec_branch_compare_i = 1;
+
+  core->dec_reg_write_i = 1;
+  core->dec_reg_addr_i = reg1;
+
+  //=================================
+  //      Tick (1)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks 
+
+  tb->check(COND_data, (core->dec_stall_request_o == 1));
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  core->dec_reg_write_i = 0;
+  core->ex_reg_write_i = 1;
+  core->ex_reg_addr_i = reg1;
+  core->ex_result_i = result;
+
+  //=================================
+  //      Tick (2)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks 
+
+  tb->check(COND_data, (core->dec_stall_request_o == 0));
+  tb->check(COND_forwarding, (core->dec_rdata1_o == result));
+
+  //`````````````````````````````````
+  //      Formal Checks 
+
+  CHECK("tb_hazard_w_forwarding.branch_compare.01",
+      tb->conditions[COND_data],
+      "Failed to stall a branch compared by decode", tb->err_cycles[COND_data]);
+
+  CHECK("tb_hazard_w_forwarding.branch_compare.02",
+      tb->conditions[COND_forwarding],
+      "Failed to forward the result to a branch compared by decode", tb->err_cycles[COND_forwarding]);
+}
+
+int main(int argc, char ** argv, char ** env) {
+  srand(time(NULL));
+  Verilated::traceEverOn(true);
+
+  bool verbose = parse_verbose(argc, argv);
+
+  TB_Hazard_w_forwarding * tb = new TB_Hazard_w_forwarding;
+  tb->open_trace("waves/hazard_w_forwarding.vcd");
+  tb->open_testdata("testdata/hazard_w_forwarding.csv");
+  tb->set_debug_log(verbose);
+  tb->init_conditions(__CondIdEnd);
+
+  /************************************************************/
+
+  tb_hazard_w_forwarding_reset(tb);
+
+  tb_hazard_w_forwarding_ex(tb);
+  tb_hazard_w_forwarding_ls(tb);
+  tb_hazard_w_forwarding_rw(tb);
+  tb_hazard_w_forwarding_priority(tb);
+  tb_hazard_w_forwarding_x0(tb);
+  tb_hazard_w_forwarding_load_use(tb);
+  tb_hazard_w_forwarding_branch_compare(tb);
+
+  /************************************************************/
+
+  printf("[HAZARD_W_FORWARDING]: ");
+  if(tb->success) {
+    printf("Done\n");
+  } else {
+    printf("Failed\n");
+  }
+
+  delete tb;
+  exit(EXIT_SUCCESS);
+}
@@ -0,0 +1,219 @@
+/*           __        _
+ *  ________/ /  ___ _(_)__  ___
+ * / __/ __/ _ \/ _ `/ / _ \/ -_)
+ * \__/\__/_//_/\_,_/_/_//_/\__/
+ * 
+ * Copyright (C) Clément Chaine
+ * This file is part of ECAP5-DPROC <https://github.com/ecap5/ECAP5-DPROC>
+ *
+ * ECAP5-DPROC is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ECAP5-DPROC is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ECAP5-DPROC.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <verilated.h>
+#include <verilated_vcd_c.h>
+#include <svdpi.h>
+
+#include "Vtb_hazard_w_write_through.h"
+#include "testbench.h"
+#include "Vtb_hazard_w_write_through_ecap5_dproc_pkg.h"
+
+enum CondId {
+  COND_data,
+  __CondIdEnd
+};
+
+enum TestcaseId {
+  T_DATA_RW = 1,
+  T_RESET = 2
+};
+
+class TB_Hazard_w_write_through : public Testbench<Vtb_hazard_w_write_through> {
+public:
+  void reset() {
+    this->_nop();
+
+    this->core->rst_i = 1;
+    for(int i = 0; i < 5; i++) {
+      this->tick();
+    }
+    this->core->rst_i = 0;
+
+    Testbench<Vtb_hazard_w_write_through>::reset();
+  }
+  
+  void _nop() {
+    core->reg_raddr1_i = 0;
+    core->reg_raddr2_i = 0;
+    core->dec_reg_write_i = 0;
+    core->dec_reg_addr_i = 0;
+    core->ex_reg_write_i = 0;
+    core->ex_reg_addr_i = 0;
+    core->ls_reg_write_i = 0;
+    core->ls_reg_addr_i = 0;
+    core->reg_write_i = 0;
+    core->reg_waddr_i = 0;
+  }
+
+};
+
+void tb_hazard_w_write_through_reset(TB_Hazard_w_write_through * tb) {
+  Vtb_hazard_w_write_through * core = tb->core;
+  core->testcase = T_RESET;
+
+  //=================================
+  //      Tick (0)
+  
+  tb->reset();
+  
+  //`````````````````````````````````
+  //      Checks 
+
+  tb->check(COND_data, (core->dec_stall_request_o == 0));
+
+  //`````````````````````````````````
+  //      Formal Checks 
+
+  CHECK("tb_hazard_w_write_through.reset.01",
+      tb->conditions[COND_data],
+      "Failed to reset the module", tb->err_cycles[COND_data]);
+}
+
+void tb_hazard_w_write_through_data_rw(TB_Hazard_w_write_through * tb) {
+  Vtb_hazard_w_write_through * core = tb->core;
+  core->testcase = T_DATA_RW;
+
+  // The following actions are performed in this test :
+  //    tick 0. Set inputs with a register being written back
+  //    tick 1. Set inputs with a register being written by loadstore
+  //    tick 2. Set inputs with a register being written by execute
+  //    tick 3. Set inputs with a register being written by decode
+
+  //=================================
+  //      Tick (0)
+  
+  tb->reset();
+  
+  //`````````````````````````````````
+  //      Set inputs
+  
+  uint32_t reg1 = 1 + rand() % 31;
+  uint32_t reg2 = 1 + rand() % 31;
+  core->reg_raddr1_i = reg1;
+  core->reg_raddr2_i = reg2;
+
+  core->dec_reg_addr_i = reg1;
+  core->ex_reg_addr_i = reg2;
+  core->ls_reg_addr_i = reg1;
+  core->reg_waddr_i = reg2;
+
+  core->reg_write_i = 1;
+
+  //=================================
+  //      Tick (1)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks 
+
+  tb->check(COND_data, (core->dec_stall_request_o == 0));
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  core->ls_reg_write_i = 1;
+
+  //=================================
+  //      Tick (2)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks 
+
+  tb->check(COND_data, (core->dec_stall_request_o == 1));
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  core->ls_reg_write_i = 0;
+  core->ex_reg_write_i = 1;
+
+  //=================================
+  //      Tick (3)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks 
+
+  tb->check(COND_data, (core->dec_stall_request_o == 1));
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  core->ex_reg_write_i = 0;
+  core->dec_reg_write_i = 1;
+
+  //=================================
+  //      Tick (4)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks 
+
+  tb->check(COND_data, (core->dec_stall_request_o == 1));
+
+  //`````````````````````````````````
+  //      Formal Checks 
+
+  CHECK("tb_hazard_w_write_through.data.RW_01",
+      tb->conditions[COND_data],
+      "Failed to remove the writeback data hazard", tb->err_cycles[COND_data]);
+}
+
+int main(int argc, char ** argv, char ** env) {
+  srand(time(NULL));
+  Verilated::traceEverOn(true);
+
+  bool verbose = parse_verbose(argc, argv);
+
+  TB_Hazard_w_write_through * tb = new TB_Hazard_w_write_through;
+  tb->open_trace("waves/hazard_w_write_through.vcd");
+  tb->open_testdata("testdata/hazard_w_write_through.csv");
+  tb->set_debug_log(verbose);
+  tb->init_conditions(__CondIdEnd);
+
+  /************************************************************/
+
+  tb_hazard_w_write_through_reset(tb);
+
+  tb_hazard_w_write_through_data_rw(tb);
+
+  /************************************************************/
+
+  printf("[HAZARD_W_WRITE_THROUGH]: ");
+  if(tb->success) {
+    printf("Done\n");
+  } else {
+    printf("Failed\n");
+  }
+
+  delete tb;
+  exit(EXIT_SUCCESS);
+}
@@ -0,0 +1,629 @@
+/*           __        _
+ *  ________/ /  ___ _(_)__  ___
+ * / __/ __/ _ \/ _ `/ / _ \/ -_)
+ * \__/\__/_//_/\_,_/_/_//_/\__/
+ *
+ * Copyright (C) Clément Chaine
+ * This file is part of ECAP5-DPROC <https://github.com/ecap5/ECAP5-DPROC>
+ *
+ * ECAP5-DPROC is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ECAP5-DPROC is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ECAP5-DPROC.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <verilated.h>
+#include <verilated_vcd_c.h>
+#include <svdpi.h>
+#include <deque>
+#include <vector>
+
+#include "Vtb_icache.h"
+#include "testbench.h"
+#include "wishbone_slave.h"
+#include "Vtb_icache_tb_icache.h"
+#include "Vtb_icache_ecap5_dproc_pkg.h"
+
+enum CondId {
+  COND_slave,
+  COND_master,
+  COND_data,
+  COND_throughput,
+  COND_counters,
+  COND_burst,
+  __CondIdEnd
+};
+
+enum TestcaseId {
+  T_RESET        =  1,
+  T_MISS         =  2,
+  T_HIT          =  3,
+  T_REPLACEMENT  =  4,
+  T_MEMORY_WAIT  =  5,
+  T_BURST        =  6,
+  T_INVALIDATE   =  7
+};
+
+struct Response {
+  uint32_t cycle;
+  uint32_t dat;
+};
+
+class TB_Icache : public Testbench<Vtb_icache> {
+public:
+  // Pipelined wishbone slave model of the memory
+  WishboneSlave<uint32_t> slave;
+  uint32_t cycle;
+  // Addresses requested by the cache to the memory
+  std::vector<uint32_t> fetched;
+  // Cycle type identifiers and burst type extensions of the requests
+  std::vector<uint8_t> fetched_cti;
+  std::vector<uint8_t> fetched_bte;
+  // Pipelined wishbone master model of the fetch module
+  std::deque<uint32_t> pending;
+  uint32_t outstanding;
+  // Responses received from the cache
+  std::vector<Response> responses;
+
+  void reset() {
+    this->core->invalidate_i = 0;
+    this->core->s_wb_adr_i = 0;
+    this->core->s_wb_we_i = 0;
+    this->core->s_wb_sel_i = 0xF;
+    this->core->s_wb_stb_i = 0;
+    this->core->s_wb_cyc_i = 0;
+    this->core->m_wb_dat_i = 0;
+    this->core->m_wb_ack_i = 0;
+    this->core->m_wb_stall_i = 0;
+
+    this->slave.latency = 0;
+    this->slave.random_stall = false;
+    this->cycle = 0;
+    this->pending.clear();
+    this->outstanding = 0;
+
+    this->core->rst_i = 1;
+    for(int i = 0; i < 5; i++) {
+      this->tick();
+    }
+    this->core->rst_i = 0;
+
+    this->slave.clear();
+    this->fetched.clear();
+    this->fetched_cti.clear();
+    this->fetched_bte.clear();
+    this->responses.clear();
+
+    Testbench<Vtb_icache>::reset();
+  }
+
+  static uint32_t memory(uint32_t adr) {
+    return (adr * 2654435761u) ^ 0xECA50000;
+  }
+
+  void tick() {
+    // Requests of the fetch module model
+    this->core->s_wb_stb_i = !this->pending.empty();
+    this->core->s_wb_adr_i = this->pending.empty() ? 0 : this->pending.front();
+    this->core->s_wb_cyc_i = !this->pending.empty() || (this->outstanding > 0);
+
+    if(this->slave.accept(this->cycle, this->core->m_wb_stb_o, this->core->m_wb_cyc_o, this->core->m_wb_stall_i,
+                          this->core->m_wb_adr_o)) {
+      this->fetched.push_back(this->core->m_wb_adr_o);
+      this->fetched_cti.push_back(this->core->m_wb_cti_o);
+      this->fetched_bte.push_back(this->core->m_wb_bte_o);
+    }
+    uint32_t adr = 0;
+    this->core->m_wb_ack_i = this->slave.respond(this->cycle, adr);
+    this->core->m_wb_dat_i = this->core->m_wb_ack_i ? memory(adr) : 0;
+
+    this->core->eval();
+    bool accepted = this->core->s_wb_stb_i && !this->core->s_wb_stall_o;
+    if(this->core->s_wb_ack_o) {
+      this->responses.push_back({this->cycle, this->core->s_wb_dat_o});
+      this->outstanding -= 1;
+    }
+
+    Testbench<Vtb_icache>::tick();
+    this->cycle += 1;
+
+    if(accepted) {
+      this->pending.pop_front();
+      this->outstanding += 1;
+    }
+    this->core->m_wb_stall_i = this->slave.stall();
+  }
+
+  void run(uint32_t cycles) {
+    for(uint32_t i = 0; i < cycles; i++) {
+      this->tick();
+    }
+  }
+
+  // Checks that the responses match the provided sequence of addresses
+  bool responses_match(const std::vector<uint32_t> & adrs) {
+    if(this->responses.size() != adrs.size()) {
+      return false;
+    }
+    for(size_t i = 0; i < adrs.size(); i++) {
+      if(this->responses[i].dat != memory(adrs[i])) {
+        return false;
+      }
+    }
+    return true;
+  }
+};
+
+void tb_icache_reset(TB_Icache * tb) {
+  Vtb_icache * core = tb->core;
+  core->testcase = T_RESET;
+
+  //=================================
+  //      Tick (0)
+
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_slave,     (core->s_wb_ack_o    ==  0)  &&
+                            (core->s_wb_stall_o  ==  0));
+  tb->check(COND_master,    (core->m_wb_stb_o    ==  0)  &&
+                            (core->m_wb_cyc_o    ==  0));
+  tb->check(COND_counters,  (core->tb_icache->hit_count_q   ==  0)  &&
+                            (core->tb_icache->miss_count_q  ==  0));
+
+  //`````````````````````````````````
+  //      Formal Checks
+
+  CHECK("tb_icache.reset.01",
+      tb->conditions[COND_slave],
+      "Failed to reset the slave port", tb->err_cycles[COND_slave]);
+
+  CHECK("tb_icache.reset.02",
+      tb->conditions[COND_master],
+      "Failed to reset the master port", tb->err_cycles[COND_master]);
+
+  CHECK("tb_icache.reset.03",
+      tb->conditions[COND_counters],
+      "Failed to reset the performance counters", tb->err_cycles[COND_counters]);
+}
+
+void tb_icache_miss(TB_Icache * tb) {
+  Vtb_icache * core = tb->core;
+  core->testcase = T_MISS;
+
+  // The following actions are performed in this test :
+  //    tick 0. Request a word absent from the cache
+  //    tick 1-19. Nothing (core refills the line and responds)
+
+  //=================================
+  //      Tick (0)
+
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  uint32_t line_size = core->tb_icache->LINE_SIZE;
+  uint32_t adr = (rand() & ~0x3);
+  uint32_t line = adr & ~(line_size - 1);
+  tb->pending.push_back(adr);
+
+  //=================================
+  //      Tick (1-19)
+
+  tb->run(20);
+
+  //`````````````````````````````````
+  //      Checks
+
+  // The whole line is requested from its first word
+  tb->check(COND_master,    (tb->fetched.size() == line_size / 4));
+  for(size_t i = 0; i < tb->fetched.size(); i++) {
+    tb->check(COND_master,  (tb->fetched[i] == line + 4 * i));
+  }
+  tb->check(COND_master,    (core->m_wb_cyc_o == 0));
+  tb->check(COND_data,      tb->responses_match({adr}));
+  tb->check(COND_counters,  (core->tb_icache->hit_count_q   ==  0)  &&
+                            (core->tb_icache->miss_count_q  ==  1));
+
+  //`````````````````````````````````
+  //      Formal Checks
+
+  CHECK("tb_icache.miss.01",
+      tb->conditions[COND_master],
+      "Failed to refill the whole line", tb->err_cycles[COND_master]);
+
+  CHECK("tb_icache.miss.02",
+      tb->conditions[COND_data],
+      "Failed to respond with the requested word", tb->err_cycles[COND_data]);
+
+  CHECK("tb_icache.miss.03",
+      tb->conditions[COND_counters],
+      "Failed to count the miss", tb->err_cycles[COND_counters]);
+}
+
+void tb_icache_hit(TB_Icache * tb) {
+  Vtb_icache * core = tb->core;
+  core->testcase = T_HIT;
+
+  // The following actions are performed in this test :
+  //    tick 0. Request a word absent from the cache
+  //    tick 1-19. Nothing (core refills the line)
+  //    tick 20. Request every word of the line back-to-back
+  //    tick 21-29. Nothing (core responds from the cache)
+
+  //=================================
+  //      Tick (0)
+
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  uint32_t line_size = core->tb_icache->LINE_SIZE;
+  uint32_t line = (rand() & ~(line_size - 1));
+  tb->pending.push_back(line);
+
+  //=================================
+  //      Tick (1-19)
+
+  tb->run(20);
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  tb->fetched.clear();
+  tb->responses.clear();
+  std::vector<uint32_t> adrs;
+  for(uint32_t i = 0; i < line_size / 4; i++) {
+    adrs.push_back(line + 4 * i);
+    tb->pending.push_back(line + 4 * i);
+  }
+
+  //=================================
+  //      Tick (20-29)
+
+  tb->run(10);
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_master,      (tb->fetched.size() == 0));
+  tb->check(COND_data,        tb->responses_match(adrs));
+  // A response is provided on every cycle
+  for(size_t i = 1; i < tb->responses.size(); i++) {
+    tb->check(COND_throughput, (tb->responses[i].cycle - tb->responses[i-1].cycle == 1));
+  }
+  tb->check(COND_counters,    (core->tb_icache->hit_count_q   ==  line_size / 4)  &&
+                              (core->tb_icache->miss_count_q  ==  1));
+
+  //`````````````````````````````````
+  //      Formal Checks
+
+  CHECK("tb_icache.hit.01",
+      tb->conditions[COND_master],
+      "Failed to respond without accessing the memory", tb->err_cycles[COND_master]);
+
+  CHECK("tb_icache.hit.02",
+      tb->conditions[COND_data],
+      "Failed to respond with the cached words", tb->err_cycles[COND_data]);
+
+  CHECK("tb_icache.hit.03",
+      tb->conditions[COND_throughput],
+      "Failed to respond to back-to-back requests", tb->err_cycles[COND_throughput]);
+
+  CHECK("tb_icache.hit.04",
+      tb->conditions[COND_counters],
+      "Failed to count the hits", tb->err_cycles[COND_counters]);
+}
+
+void tb_icache_replacement(TB_Icache * tb) {
+  Vtb_icache * core = tb->core;
+  core->testcase = T_REPLACEMENT;
+
+  // The following actions are performed in this test :
+  //    tick 0. Request three lines of the same set, the first one being
+  //            requested again before the third one
+  //    tick 1-99. Nothing (core replaces the least recently used line)
+
+  //=================================
+  //      Tick (0)
+
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  uint32_t line_size = core->tb_icache->LINE_SIZE;
+  uint32_t sets = core->tb_icache->SIZE / line_size / core->tb_icache->WAYS;
+  uint32_t a = 0x1000;
+  uint32_t b = a + line_size * sets;
+  uint32_t c = b + line_size * sets;
+  std::vector<uint32_t> adrs = {a, b, a, c, a, b};
+  for(size_t i = 0; i < adrs.size(); i++) {
+    tb->pending.push_back(adrs[i]);
+  }
+
+  //=================================
+  //      Tick (1-99)
+
+  tb->run(99);
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_data,        tb->responses_match(adrs));
+  // The second line is replaced by the third one
+  tb->check(COND_counters,    (core->tb_icache->hit_count_q   ==  2)  &&
+                              (core->tb_icache->miss_count_q  ==  4));
+
+  //`````````````````````````````````
+  //      Formal Checks
+
+  CHECK("tb_icache.replacement.01",
+      tb->conditions[COND_data],
+      "Failed to respond with the requested words", tb->err_cycles[COND_data]);
+
+  CHECK("tb_icache.replacement.02",
+      tb->conditions[COND_counters],
+      "Failed to replace the least recently used line", tb->err_cycles[COND_counters]);
+}
+
+void tb_icache_memory_wait(TB_Icache * tb) {
+  Vtb_icache * core = tb->core;
+  core->testcase = T_MEMORY_WAIT;
+
+  // The following actions are performed in this test :
+  //    tick 0. Request random words from a slow and stalling memory
+  //    tick 1-499. Nothing (core refills the lines)
+
+  //=================================
+  //      Tick (0)
+
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  tb->slave.latency = 1 + rand() % 4;
+  tb->slave.random_stall = true;
+  std::vector<uint32_t> adrs;
+  for(int i = 0; i < 16; i++) {
+    adrs.push_back(0x2000 + 4 * (rand() % 64));
+    tb->pending.push_back(adrs.back());
+  }
+
+  //=================================
+  //      Tick (1-499)
+
+  tb->run(499);
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_data,        tb->responses_match(adrs));
+  tb->check(COND_counters,    (core->tb_icache->hit_count_q + core->tb_icache->miss_count_q  ==  adrs.size()));
+
+  //`````````````````````````````````
+  //      Formal Checks
+
+  CHECK("tb_icache.memory_wait.01",
+      tb->conditions[COND_data],
+      "Failed to respond with the requested words", tb->err_cycles[COND_data]);
+
+  CHECK("tb_icache.memory_wait.02",
+      tb->conditions[COND_counters],
+      "Failed to count the requests", tb->err_cycles[COND_counters]);
+}
+
+void tb_icache_burst(TB_Icache * tb) {
+  Vtb_icache * core = tb->core;
+  core->testcase = T_BURST;
+
+  // The following actions are performed in this test :
+  //    tick 0. Request a word absent from the cache on a slow and stalling
+  //            memory
+  //    tick 1-99. Nothing (core refills the line with an incrementing burst)
+
+  //=================================
+  //      Tick (0)
+
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  tb->slave.latency = rand() % 4;
+  tb->slave.random_stall = true;
+  uint32_t line_size = core->tb_icache->LINE_SIZE;
+  uint32_t adr = (rand() & ~0x3);
+  tb->pending.push_back(adr);
+
+  //=================================
+  //      Tick (1-99)
+
+  tb->run(99);
+
+  //`````````````````````````````````
+  //      Checks
+
+  // Every request of the refill continues the burst except the last one
+  tb->check(COND_burst,     (tb->fetched_cti.size() == line_size / 4));
+  for(size_t i = 0; i < tb->fetched_cti.size(); i++) {
+    uint8_t cti = (i == tb->fetched_cti.size() - 1) ? Vtb_icache_ecap5_dproc_pkg::CTI_END
+                                                    : Vtb_icache_ecap5_dproc_pkg::CTI_INCREMENTING;
+    tb->check(COND_burst,   (tb->fetched_cti[i] == cti) &&
+                            (tb->fetched_bte[i] == Vtb_icache_ecap5_dproc_pkg::BTE_LINEAR));
+  }
+  tb->check(COND_data,      tb->responses_match({adr}));
+
+  //`````````````````````````````````
+  //      Formal Checks
+
+  CHECK("tb_icache.burst.01",
+      tb->conditions[COND_burst],
+      "Failed to identify the refill as an incrementing burst", tb->err_cycles[COND_burst]);
+
+  CHECK("tb_icache.burst.02",
+      tb->conditions[COND_data],
+      "Failed to respond with the requested word", tb->err_cycles[COND_data]);
+}
+
+void tb_icache_invalidate(TB_Icache * tb) {
+  Vtb_icache * core = tb->core;
+  core->testcase = T_INVALIDATE;
+
+  // The following actions are performed in this test :
+  //    tick 0. Request a word absent from the cache
+  //    tick 1-19. Nothing (core refills the line)
+  //    tick 20. Invalidate the cache
+  //    tick 21. Request the word again
+  //    tick 22-40. Nothing (core refills the line)
+  //    tick 41. Request a word of another line
+  //    tick 42-43. Nothing (core starts refilling the line)
+  //    tick 44. Invalidate the cache
+  //    tick 45-63. Nothing (core completes the refill)
+  //    tick 64. Request the word again
+  //    tick 65-83. Nothing (core refills the line)
+
+  //=================================
+  //      Tick (0)
+
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  uint32_t line_size = core->tb_icache->LINE_SIZE;
+  uint32_t a = 0x1000;
+  uint32_t b = a + line_size;
+  tb->pending.push_back(a);
+
+  //=================================
+  //      Tick (1-19)
+
+  tb->run(20);
+
+  //=================================
+  //      Tick (20)
+
+  tb->fetched.clear();
+  core->invalidate_i = 1;
+
+  tb->tick();
+
+  //=================================
+  //      Tick (21)
+
+  core->invalidate_i = 0;
+  tb->pending.push_back(a);
+
+  //=================================
+  //      Tick (22-40)
+
+  tb->run(20);
+
+  //`````````````````````````````````
+  //      Checks
+
+  // The invalidated line is refilled
+  tb->check(COND_master,    (tb->fetched.size() == line_size / 4));
+
+  //=================================
+  //      Tick (41-43)
+
+  tb->pending.push_back(b);
+  tb->run(3);
+
+  //=================================
+  //      Tick (44)
+
+  core->invalidate_i = 1;
+
+  tb->tick();
+
+  //=================================
+  //      Tick (45-63)
+
+  core->invalidate_i = 0;
+  tb->run(19);
+
+  //=================================
+  //      Tick (64-83)
+
+  tb->pending.push_back(b);
+  tb->run(20);
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_data,      tb->responses_match({a, a, b, b}));
+  // The line refilled across the invalidation is not validated
+  tb->check(COND_counters,  (core->tb_icache->hit_count_q   ==  0)  &&
+                            (core->tb_icache->miss_count_q  ==  4));
+
+  //`````````````````````````````````
+  //      Formal Checks
+
+  CHECK("tb_icache.invalidate.01",
+      tb->conditions[COND_master],
+      "Failed to invalidate the cached lines", tb->err_cycles[COND_master]);
+
+  CHECK("tb_icache.invalidate.02",
+      tb->conditions[COND_data],
+      "Failed to respond with the requested words", tb->err_cycles[COND_data]);
+
+  CHECK("tb_icache.invalidate.03",
+      tb->conditions[COND_counters],
+      "Failed to invalidate a line being refilled", tb->err_cycles[COND_counters]);
+}
+
+int main(int argc, char ** argv, char ** env) {
+  srand(time(NULL));
+  Verilated::traceEverOn(true);
+
+  bool verbose = parse_verbose(argc, argv);
+
+  TB_Icache * tb = new TB_Icache;
+  tb->open_trace("waves/icache.vcd");
+  tb->open_testdata("testdata/icache.csv");
+  tb->set_debug_log(verbose);
+  tb->init_conditions(__CondIdEnd);
+
+  /************************************************************/
+
+  tb_icache_reset(tb);
+
+  tb_icache_miss(tb);
+  tb_icache_hit(tb);
+  tb_icache_replacement(tb);
+  tb_icache_burst(tb);
+  tb_icache_invalidate(tb);
+
+  tb_icache_memory_wait(tb);
+
+  /************************************************************/
+
+  printf("[ICACHE]: ");
+  if(tb->success) {
+    printf("Done\n");
+  } else {
+    printf("Failed\n");
+  }
+
+  delete tb;
+  exit(EXIT_SUCCESS);
+}
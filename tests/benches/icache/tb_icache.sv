@@ -0,0 +1,98 @@
+/*           __        _
+ *  ________/ /  ___ _(_)__  ___
+ * / __/ __/ _ \/ _ `/ / _ \/ -_)
+ * \__/\__/_//_/\_,_/_/_//_/\__/
+ * 
+ * Copyright (C) Clément Chaine
+ * This file is part of ECAP5-DPROC <https://github.com/ecap5/ECAP5-DPROC>
+ *
+ * ECAP5-DPROC is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ECAP5-DPROC is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ECAP5-DPROC.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+module tb_icache import ecap5_dproc_pkg::*;
+(
+  input   int          testcase,
+
+  input   logic        clk_i,
+  input   logic        rst_i,
+  input   logic        invalidate_i,
+  // Slave port
+  input   logic[31:0]  s_wb_adr_i,
+  output  logic[31:0]  s_wb_dat_o,
+  input   logic        s_wb_we_i,
+  input   logic[3:0]   s_wb_sel_i,
+  input   logic        s_wb_stb_i,
+  output  logic        s_wb_ack_o,
+  input   logic        s_wb_cyc_i,
+  output  logic        s_wb_stall_o,
+  // Master port
+  output  logic[31:0]  m_wb_adr_o,
+  input   logic[31:0]  m_wb_dat_i,
+  output  logic        m_wb_we_o,
+  output  logic[3:0]   m_wb_sel_o,
+  output  logic        m_wb_stb_o,
+  input   logic        m_wb_ack_i,
+  output  logic        m_wb_cyc_o,
+  input   logic        m_wb_stall_i,
+  output  logic[2:0]   m_wb_cti_o,
+  output  logic[1:0]   m_wb_bte_o
+);
+
+localparam int SIZE      = 64;
+localparam int LINE_SIZE = 16;
+localparam int WAYS      = 2;
+
+// Performance counters of the parameterized instruction cache
+logic[31:0]  hit_count_q, miss_count_q;
+
+icache #(
+  .SIZE          (SIZE),
+  .LINE_SIZE     (LINE_SIZE),
+  .WAYS          (WAYS)
+) dut (
+  .clk_i         (clk_i),
+  .rst_i         (rst_i),
+  .invalidate_i  (invalidate_i),
+  .s_wb_adr_i    (s_wb_adr_i),
+  .s_wb_dat_o    (s_wb_dat_o),
+  .s_wb_we_i     (s_wb_we_i),
+  .s_wb_sel_i    (s_wb_sel_i),
+  .s_wb_stb_i    (s_wb_stb_i),
+  .s_wb_ack_o    (s_wb_ack_o),
+  .s_wb_cyc_i    (s_wb_cyc_i),
+  .s_wb_stall_o  (s_wb_stall_o),
+  .m_wb_adr_o    (m_wb_adr_o),
+  .m_wb_dat_i    (m_wb_dat_i),
+  .m_wb_we_o     (m_wb_we_o),
+  .m_wb_sel_o    (m_wb_sel_o),
+  .m_wb_stb_o    (m_wb_stb_o),
+  .m_wb_ack_i    (m_wb_ack_i),
+  .m_wb_cyc_o    (m_wb_cyc_o),
+  .m_wb_stall_i  (m_wb_stall_i),
+  .m_wb_cti_o    (m_wb_cti_o),
+  .m_wb_bte_o    (m_wb_bte_o)
+);
+
+assign hit_count_q  = dut.hit_count_q;
+assign miss_count_q = dut.miss_count_q;
+
+endmodule // tb_icache
+
+`verilator_config
+
+public -module "tb_icache" -var "SIZE"
+public -module "tb_icache" -var "LINE_SIZE"
+public -module "tb_icache" -var "WAYS"
+public -module "tb_icache" -var "hit_count_q"
+public -module "tb_icache" -var "miss_count_q"
@@ -0,0 +1,912 @@
+/*           __        _
+ *  ________/ /  ___ _(_)__  ___
+ * / __/ __/ _ \/ _ `/ / _ \/ -_)
+ * \__/\__/_//_/\_,_/_/_//_/\__/
+ *
+ * Copyright (C) Clément Chaine
+ * This file is part of ECAP5-DPROC <https://github.com/ecap5/ECAP5-DPROC>
+ *
+ * ECAP5-DPROC is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ECAP5-DPROC is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ECAP5-DPROC.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <verilated.h>
+#include <verilated_vcd_c.h>
+#include <svdpi.h>
+
+#include "testbench.h"
+
+#include "Vtb_loadstore_w_atomic.h"
+#include "Vtb_loadstore_w_atomic_tb_loadstore_w_atomic.h"
+#include "Vtb_loadstore_w_atomic_loadstore.h"
+#include "Vtb_loadstore_w_atomic_ecap5_dproc_pkg.h"
+#include "Vtb_loadstore_w_atomic_riscv_pkg.h"
+
+enum CondId {
+  COND_state,
+  COND_wishbone,
+  COND_register,
+  COND_output_valid,
+  COND_reservation,
+  __CondIdEnd
+};
+
+enum TestcaseId {
+  T_AMO         =  1,
+  T_LR_SC       =  2,
+  T_SC_FAIL     =  3,
+  T_SC_KILLED   =  4,
+  T_SC_STORE    =  5
+};
+
+class TB_Loadstore_w_atomic : public Testbench<Vtb_loadstore_w_atomic> {
+public:
+  void reset() {
+    this->_nop();
+    this->core->input_valid_i = 0;
+    this->core->wb_ack_i = 0;
+    this->core->wb_stall_i = 0;
+    this->core->wb_dat_i = 0;
+    this->core->reservation_kill_i = 0;
+
+    this->core->rst_i = 1;
+    for(int i = 0; i < 5; i++) {
+      this->tick();
+    }
+    this->core->rst_i = 0;
+
+    Testbench<Vtb_loadstore_w_atomic>::reset();
+  }
+
+  void _nop() {
+    this->core->alu_result_i = 0;
+    this->core->enable_i = 0;
+    this->core->write_i = 0;
+    this->core->sel_i = 0x0;
+    this->core->write_data_i = 0;
+    this->core->unsigned_load_i = 0;
+    this->core->atomic_i = 0;
+    this->core->atomic_op_i = 0;
+    this->core->reg_write_i = 0;
+    this->core->reg_addr_i = 0;
+  }
+
+  void _atomic(uint32_t addr, uint8_t op, uint32_t data, uint8_t reg_addr) {
+    this->_nop();
+    this->core->alu_result_i = addr;
+    this->core->enable_i = 1;
+    this->core->write_i = 0;
+    this->core->write_data_i = data;
+    this->core->sel_i = 0xF;
+    this->core->atomic_i = 1;
+    this->core->atomic_op_i = op;
+    this->core->reg_write_i = 1;
+    this->core->reg_addr_i = reg_addr;
+  }
+
+  // System snooping the writes of another master, the reservation being
+  // killed when the written word is the exported reserved word
+  void _other_master_write(uint32_t addr) {
+    this->core->reservation_kill_i = this->core->reservation_valid_o &&
+                                     ((this->core->reservation_adr_o >> 2) == (addr >> 2));
+  }
+
+  // Value written by an atomic operation
+  static uint32_t amo(uint8_t op, uint32_t old, uint32_t operand) {
+    switch(op) {
+      case Vtb_loadstore_w_atomic_riscv_pkg::FUNC5_AMOADD:  return old + operand;
+      case Vtb_loadstore_w_atomic_riscv_pkg::FUNC5_AMOXOR:  return old ^ operand;
+      case Vtb_loadstore_w_atomic_riscv_pkg::FUNC5_AMOAND:  return old & operand;
+      case Vtb_loadstore_w_atomic_riscv_pkg::FUNC5_AMOOR:   return old | operand;
+      case Vtb_loadstore_w_atomic_riscv_pkg::FUNC5_AMOMIN:  return ((int32_t)old < (int32_t)operand) ? old : operand;
+      case Vtb_loadstore_w_atomic_riscv_pkg::FUNC5_AMOMAX:  return ((int32_t)old > (int32_t)operand) ? old : operand;
+      case Vtb_loadstore_w_atomic_riscv_pkg::FUNC5_AMOMINU: return (old < operand) ? old : operand;
+      case Vtb_loadstore_w_atomic_riscv_pkg::FUNC5_AMOMAXU: return (old > operand) ? old : operand;
+      default: return operand;
+    }
+  }
+};
+
+void tb_loadstore_w_atomic_operation(TB_Loadstore_w_atomic * tb, uint8_t op) {
+  Vtb_loadstore_w_atomic * core = tb->core;
+
+  // The following actions are performed in this test :
+  //    tick 0. Set the inputs to request an atomic operation
+  //    tick 1. Acknowledge the read request (core performs the write request)
+  //    tick 2. Acknowledge the write request
+  //    tick 3. Nothing (core outputs the read value)
+
+  tb->reset();
+
+  core->input_valid_i = 1;
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  uint32_t addr = rand() & ~0x3;
+  uint32_t reg_addr = 1 + rand() % 31;
+  uint32_t operand = rand();
+  uint32_t old = rand();
+  tb->_atomic(addr, op, operand, reg_addr);
+
+  //=================================
+  //      Tick (0)
+
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_state,         (core->tb_loadstore_w_atomic->dut->state_q  ==  1));
+  tb->check(COND_wishbone,      (core->wb_adr_o              ==  addr) &&
+                                (core->wb_we_o               ==  0)    &&
+                                (core->wb_sel_o              ==  0xF)  &&
+                                (core->wb_stb_o              ==  1)    &&
+                                (core->wb_cyc_o              ==  1));
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  tb->_nop();
+  core->wb_ack_i = 1;
+  core->wb_dat_i = old;
+
+  //=================================
+  //      Tick (1)
+
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks
+
+  // The bus cycle is kept for the write request
+  tb->check(COND_state,         (core->tb_loadstore_w_atomic->dut->state_q  ==  1));
+  tb->check(COND_wishbone,      (core->wb_adr_o              ==  addr) &&
+                                (core->wb_we_o               ==  1)    &&
+                                (core->wb_dat_o              ==  tb->amo(op, old, operand)) &&
+                                (core->wb_sel_o              ==  0xF)  &&
+                                (core->wb_stb_o              ==  1)    &&
+                                (core->wb_cyc_o              ==  1));
+  tb->check(COND_output_valid,  (core->output_valid_o        ==  0));
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  core->wb_ack_i = 1;
+  core->wb_dat_i = rand();
+
+  //=================================
+  //      Tick (2)
+
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_state,         (core->tb_loadstore_w_atomic->dut->state_q  ==  3));
+  tb->check(COND_wishbone,      (core->wb_stb_o              ==  0));
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  core->wb_ack_i = 0;
+  core->wb_dat_i = 0;
+
+  //=================================
+  //      Tick (3)
+
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_state,         (core->tb_loadstore_w_atomic->dut->state_q  ==  0));
+  tb->check(COND_wishbone,      (core->wb_cyc_o              ==  0));
+  tb->check(COND_register,      (core->reg_write_o           ==  1)    &&
+                                (core->reg_addr_o            ==  reg_addr) &&
+                                (core->reg_data_o            ==  old));
+  tb->check(COND_output_valid,  (core->output_valid_o        ==  1));
+}
+
+void tb_loadstore_w_atomic_amo(TB_Loadstore_w_atomic * tb) {
+  tb->core->testcase = T_AMO;
+
+  uint8_t ops[] = {
+    Vtb_loadstore_w_atomic_riscv_pkg::FUNC5_AMOSWAP,
+    Vtb_loadstore_w_atomic_riscv_pkg::FUNC5_AMOADD,
+    Vtb_loadstore_w_atomic_riscv_pkg::FUNC5_AMOXOR,
+    Vtb_loadstore_w_atomic_riscv_pkg::FUNC5_AMOAND,
+    Vtb_loadstore_w_atomic_riscv_pkg::FUNC5_AMOOR,
+    Vtb_loadstore_w_atomic_riscv_pkg::FUNC5_AMOMIN,
+    Vtb_loadstore_w_atomic_riscv_pkg::FUNC5_AMOMAX,
+    Vtb_loadstore_w_atomic_riscv_pkg::FUNC5_AMOMINU,
+    Vtb_loadstore_w_atomic_riscv_pkg::FUNC5_AMOMAXU
+  };
+  for(uint32_t i = 0; i < sizeof(ops); i++) {
+    tb_loadstore_w_atomic_operation(tb, ops[i]);
+  }
+
+  //`````````````````````````````````
+  //      Formal Checks
+
+  CHECK("tb_loadstore_w_atomic.amo.01",
+      tb->conditions[COND_state],
+      "Failed to implement the state machine", tb->err_cycles[COND_state]);
+
+  CHECK("tb_loadstore_w_atomic.amo.02",
+      tb->conditions[COND_wishbone],
+      "Failed to perform the read and write requests in a single bus cycle", tb->err_cycles[COND_wishbone]);
+
+  CHECK("tb_loadstore_w_atomic.amo.03",
+      tb->conditions[COND_register],
+      "Failed to implement the register protocol", tb->err_cycles[COND_register]);
+
+  CHECK("tb_loadstore_w_atomic.amo.04",
+      tb->conditions[COND_output_valid],
+      "Failed to implement the output_valid_o signal", tb->err_cycles[COND_output_valid]);
+}
+
+void tb_loadstore_w_atomic_lr_sc(TB_Loadstore_w_atomic * tb) {
+  Vtb_loadstore_w_atomic * core = tb->core;
+  core->testcase = T_LR_SC;
+
+  // The following actions are performed in this test :
+  //    tick 0. Set the inputs to request a LR
+  //    tick 1. Acknowledge the read request
+  //    tick 2. Nothing (core outputs the read value)
+  //    tick 3. Set the inputs to request a SC on the reserved word
+  //    tick 4. Acknowledge the read request
+  //    tick 5. Acknowledge the write request
+  //    tick 6. Nothing (core outputs the success of the SC)
+
+  tb->reset();
+
+  core->input_valid_i = 1;
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  uint32_t addr = rand() & ~0x3;
+  uint32_t reg_addr = 1 + rand() % 31;
+  uint32_t value = rand();
+  tb->_atomic(addr, Vtb_loadstore_w_atomic_riscv_pkg::FUNC5_LR, 0, reg_addr);
+
+  //=================================
+  //      Tick (0)
+
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_wishbone,      (core->wb_adr_o              ==  addr) &&
+                                (core->wb_we_o               ==  0)    &&
+                                (core->wb_stb_o              ==  1)    &&
+                                (core->wb_cyc_o              ==  1));
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  tb->_nop();
+  core->wb_ack_i = 1;
+  core->wb_dat_i = value;
+
+  //=================================
+  //      Tick (1)
+
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks
+
+  // LR only performs the read request
+  tb->check(COND_state,         (core->tb_loadstore_w_atomic->dut->state_q  ==  3));
+  tb->check(COND_wishbone,      (core->wb_stb_o              ==  0));
+  tb->check(COND_reservation,   (core->tb_loadstore_w_atomic->dut->reservation_valid_q  ==  1));
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  core->wb_ack_i = 0;
+  core->wb_dat_i = 0;
+
+  //=================================
+  //      Tick (2)
+
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_wishbone,      (core->wb_cyc_o              ==  0));
+  tb->check(COND_register,      (core->reg_write_o           ==  1)    &&
+                                (core->reg_addr_o            ==  reg_addr) &&
+                                (core->reg_data_o            ==  value));
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  uint32_t data = rand();
+  tb->_atomic(addr, Vtb_loadstore_w_atomic_riscv_pkg::FUNC5_SC, data, reg_addr);
+
+  //=================================
+  //      Tick (3)
+
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_wishbone,      (core->wb_adr_o              ==  addr) &&
+                                (core->wb_we_o               ==  0)    &&
+                                (core->wb_stb_o              ==  1)    &&
+                                (core->wb_cyc_o              ==  1));
+  tb->check(COND_reservation,   (core->tb_loadstore_w_atomic->dut->reservation_valid_q  ==  1));
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  tb->_nop();
+  core->wb_ack_i = 1;
+  core->wb_dat_i = rand();
+
+  //=================================
+  //      Tick (4)
+
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks
+
+  // The write request doesn't depend on the read value
+  tb->check(COND_wishbone,      (core->wb_adr_o              ==  addr) &&
+                                (core->wb_we_o               ==  1)    &&
+                                (core->wb_dat_o              ==  data) &&
+                                (core->wb_stb_o              ==  1)    &&
+                                (core->wb_cyc_o              ==  1));
+  tb->check(COND_reservation,   (core->tb_loadstore_w_atomic->dut->reservation_valid_q  ==  0));
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  core->wb_ack_i = 1;
+  core->wb_dat_i = rand();
+
+  //=================================
+  //      Tick (5)
+
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  core->wb_ack_i = 0;
+  core->wb_dat_i = 0;
+
+  //=================================
+  //      Tick (6)
+
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_wishbone,      (core->wb_cyc_o              ==  0));
+  tb->check(COND_register,      (core->reg_write_o           ==  1)    &&
+                                (core->reg_addr_o            ==  reg_addr) &&
+                                (core->reg_data_o            ==  0));
+  tb->check(COND_output_valid,  (core->output_valid_o        ==  1));
+
+  //`````````````````````````````````
+  //      Formal Checks
+
+  CHECK("tb_loadstore_w_atomic.lr_sc.01",
+      tb->conditions[COND_state],
+      "Failed to implement the state machine", tb->err_cycles[COND_state]);
+
+  CHECK("tb_loadstore_w_atomic.lr_sc.02",
+      tb->conditions[COND_wishbone],
+      "Failed to implement the wishbone protocol", tb->err_cycles[COND_wishbone]);
+
+  CHECK("tb_loadstore_w_atomic.lr_sc.03",
+      tb->conditions[COND_register],
+      "Failed to implement the register protocol", tb->err_cycles[COND_register]);
+
+  CHECK("tb_loadstore_w_atomic.lr_sc.04",
+      tb->conditions[COND_output_valid],
+      "Failed to implement the output_valid_o signal", tb->err_cycles[COND_output_valid]);
+
+  CHECK("tb_loadstore_w_atomic.lr_sc.05",
+      tb->conditions[COND_reservation],
+      "Failed to implement the reservation", tb->err_cycles[COND_reservation]);
+}
+
+void tb_loadstore_w_atomic_sc_fail(TB_Loadstore_w_atomic * tb) {
+  Vtb_loadstore_w_atomic * core = tb->core;
+  core->testcase = T_SC_FAIL;
+
+  // The following actions are performed in this test :
+  //    tick 0. Set the inputs to request a SC without reservation
+  //    tick 1. Nothing (core outputs the failure of the SC)
+
+  tb->reset();
+
+  core->input_valid_i = 1;
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  uint32_t addr = rand() & ~0x3;
+  uint32_t reg_addr = 1 + rand() % 31;
+  tb->_atomic(addr, Vtb_loadstore_w_atomic_riscv_pkg::FUNC5_SC, rand(), reg_addr);
+
+  //=================================
+  //      Tick (0)
+
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks
+
+  // No memory request is performed
+  tb->check(COND_state,         (core->tb_loadstore_w_atomic->dut->state_q  ==  0));
+  tb->check(COND_wishbone,      (core->wb_stb_o              ==  0)    &&
+                                (core->wb_cyc_o              ==  0));
+  tb->check(COND_register,      (core->reg_write_o           ==  1)    &&
+                                (core->reg_addr_o            ==  reg_addr) &&
+                                (core->reg_data_o            ==  1));
+  tb->check(COND_output_valid,  (core->output_valid_o        ==  1));
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  tb->_nop();
+
+  //=================================
+  //      Tick (1)
+
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_wishbone,      (core->wb_stb_o              ==  0)    &&
+                                (core->wb_cyc_o              ==  0));
+
+  //`````````````````````````````````
+  //      Formal Checks
+
+  CHECK("tb_loadstore_w_atomic.sc_fail.01",
+      tb->conditions[COND_state],
+      "Failed to implement the state machine", tb->err_cycles[COND_state]);
+
+  CHECK("tb_loadstore_w_atomic.sc_fail.02",
+      tb->conditions[COND_wishbone],
+      "Failed to skip the memory request", tb->err_cycles[COND_wishbone]);
+
+  CHECK("tb_loadstore_w_atomic.sc_fail.03",
+      tb->conditions[COND_register],
+      "Failed to implement the register protocol", tb->err_cycles[COND_register]);
+
+  CHECK("tb_loadstore_w_atomic.sc_fail.04",
+      tb->conditions[COND_output_valid],
+      "Failed to implement the output_valid_o signal", tb->err_cycles[COND_output_valid]);
+}
+
+void tb_loadstore_w_atomic_sc_killed(TB_Loadstore_w_atomic * tb) {
+  Vtb_loadstore_w_atomic * core = tb->core;
+  core->testcase = T_SC_KILLED;
+
+  // The following actions are performed in this test :
+  //    tick 0. Set the inputs to request a LR
+  //    tick 1. Acknowledge the read request
+  //    tick 2. Write the next word from another master
+  //    tick 3. Set the inputs to request a SC on the reserved word
+  //    tick 4. Acknowledge the read request with the reserved value while
+  //            writing the reserved word from another master
+  //    tick 5. Nothing (core outputs the failure of the SC)
+  //    tick 6. Set the inputs to request a LR
+  //    tick 7. Acknowledge the read request
+  //    tick 8. Write the reserved word from another master
+  //    tick 9. Set the inputs to request a SC on the reserved word
+  //    tick 10. Nothing (core outputs the failure of the SC)
+
+  tb->reset();
+
+  core->input_valid_i = 1;
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  uint32_t addr = rand() & ~0x3;
+  uint32_t reg_addr = 1 + rand() % 31;
+  uint32_t value = rand();
+  tb->_atomic(addr, Vtb_loadstore_w_atomic_riscv_pkg::FUNC5_LR, 0, reg_addr);
+
+  //=================================
+  //      Tick (0)
+
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  tb->_nop();
+  core->wb_ack_i = 1;
+  core->wb_dat_i = value;
+
+  //=================================
+  //      Tick (1)
+
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  core->wb_ack_i = 0;
+  core->wb_dat_i = 0;
+  tb->_other_master_write(addr + 4);
+
+  //=================================
+  //      Tick (2)
+
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks
+
+  // The reservation is exported and isn't killed by a write to another word
+  tb->check(COND_reservation,   (core->reservation_valid_o   ==  1)    &&
+                                (core->reservation_adr_o     ==  addr));
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  tb->_atomic(addr, Vtb_loadstore_w_atomic_riscv_pkg::FUNC5_SC, rand(), reg_addr);
+  core->reservation_kill_i = 0;
+
+  //=================================
+  //      Tick (3)
+
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  tb->_nop();
+  core->wb_ack_i = 1;
+  core->wb_dat_i = value;
+  tb->_other_master_write(addr);
+
+  //=================================
+  //      Tick (4)
+
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks
+
+  // The word was written back to the reserved value by another master, no
+  // write request is performed
+  tb->check(COND_state,         (core->tb_loadstore_w_atomic->dut->state_q  ==  3));
+  tb->check(COND_wishbone,      (core->wb_stb_o              ==  0));
+  tb->check(COND_reservation,   (core->reservation_valid_o   ==  0));
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  core->wb_ack_i = 0;
+  core->wb_dat_i = 0;
+  core->reservation_kill_i = 0;
+
+  //=================================
+  //      Tick (5)
+
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_wishbone,      (core->wb_cyc_o              ==  0));
+  tb->check(COND_register,      (core->reg_write_o           ==  1)    &&
+                                (core->reg_addr_o            ==  reg_addr) &&
+                                (core->reg_data_o            ==  1));
+  tb->check(COND_output_valid,  (core->output_valid_o        ==  1));
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  tb->_atomic(addr, Vtb_loadstore_w_atomic_riscv_pkg::FUNC5_LR, 0, reg_addr);
+
+  //=================================
+  //      Tick (6)
+
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  tb->_nop();
+  core->wb_ack_i = 1;
+  core->wb_dat_i = value;
+
+  //=================================
+  //      Tick (7)
+
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  core->wb_ack_i = 0;
+  core->wb_dat_i = 0;
+  tb->_other_master_write(addr);
+
+  //=================================
+  //      Tick (8)
+
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_reservation,   (core->reservation_valid_o   ==  0));
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  core->reservation_kill_i = 0;
+  tb->_atomic(addr, Vtb_loadstore_w_atomic_riscv_pkg::FUNC5_SC, rand(), reg_addr);
+
+  //=================================
+  //      Tick (9)
+
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks
+
+  // No memory request is performed
+  tb->check(COND_state,         (core->tb_loadstore_w_atomic->dut->state_q  ==  0));
+  tb->check(COND_wishbone,      (core->wb_stb_o              ==  0)    &&
+                                (core->wb_cyc_o              ==  0));
+  tb->check(COND_register,      (core->reg_write_o           ==  1)    &&
+                                (core->reg_addr_o            ==  reg_addr) &&
+                                (core->reg_data_o            ==  1));
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  tb->_nop();
+
+  //=================================
+  //      Tick (10)
+
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Formal Checks
+
+  CHECK("tb_loadstore_w_atomic.sc_killed.01",
+      tb->conditions[COND_state],
+      "Failed to implement the state machine", tb->err_cycles[COND_state]);
+
+  CHECK("tb_loadstore_w_atomic.sc_killed.02",
+      tb->conditions[COND_wishbone],
+      "Failed to skip the write request", tb->err_cycles[COND_wishbone]);
+
+  CHECK("tb_loadstore_w_atomic.sc_killed.03",
+      tb->conditions[COND_register],
+      "Failed to implement the register protocol", tb->err_cycles[COND_register]);
+
+  CHECK("tb_loadstore_w_atomic.sc_killed.04",
+      tb->conditions[COND_output_valid],
+      "Failed to implement the output_valid_o signal", tb->err_cycles[COND_output_valid]);
+
+  CHECK("tb_loadstore_w_atomic.sc_killed.05",
+      tb->conditions[COND_reservation],
+      "Failed to implement the reservation", tb->err_cycles[COND_reservation]);
+}
+
+void tb_loadstore_w_atomic_sc_store(TB_Loadstore_w_atomic * tb) {
+  Vtb_loadstore_w_atomic * core = tb->core;
+  core->testcase = T_SC_STORE;
+
+  // The following actions are performed in this test :
+  //    tick 0. Set the inputs to request a LR
+  //    tick 1. Acknowledge the read request
+  //    tick 2. Nothing (core outputs the read value)
+  //    tick 3. Set the inputs to request a byte store on the reserved word
+  //    tick 4. Acknowledge the write request
+  //    tick 5. Nothing (core outputs the store)
+  //    tick 6. Set the inputs to request a SC on the reserved word
+  //    tick 7. Nothing (core outputs the failure of the SC)
+
+  tb->reset();
+
+  core->input_valid_i = 1;
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  uint32_t addr = rand() & ~0x3;
+  uint32_t reg_addr = 1 + rand() % 31;
+  tb->_atomic(addr, Vtb_loadstore_w_atomic_riscv_pkg::FUNC5_LR, 0, reg_addr);
+
+  //=================================
+  //      Tick (0)
+
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  tb->_nop();
+  core->wb_ack_i = 1;
+  core->wb_dat_i = rand();
+
+  //=================================
+  //      Tick (1)
+
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  core->wb_ack_i = 0;
+  core->wb_dat_i = 0;
+
+  //=================================
+  //      Tick (2)
+
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  core->alu_result_i = addr + rand() % 4;
+  core->enable_i = 1;
+  core->write_i = 1;
+  core->write_data_i = rand();
+  core->sel_i = 0x1;
+
+  //=================================
+  //      Tick (3)
+
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks
+
+  // The store of the core invalidates the reservation
+  tb->check(COND_wishbone,      (core->wb_we_o               ==  1)    &&
+                                (core->wb_stb_o              ==  1)    &&
+                                (core->wb_cyc_o              ==  1));
+  tb->check(COND_reservation,   (core->tb_loadstore_w_atomic->dut->reservation_valid_q  ==  0));
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  tb->_nop();
+  core->wb_ack_i = 1;
+
+  //=================================
+  //      Tick (4)
+
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  core->wb_ack_i = 0;
+
+  //=================================
+  //      Tick (5)
+
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  tb->_atomic(addr, Vtb_loadstore_w_atomic_riscv_pkg::FUNC5_SC, rand(), reg_addr);
+
+  //=================================
+  //      Tick (6)
+
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks
+
+  // No memory request is performed
+  tb->check(COND_state,         (core->tb_loadstore_w_atomic->dut->state_q  ==  0));
+  tb->check(COND_wishbone,      (core->wb_stb_o              ==  0)    &&
+                                (core->wb_cyc_o              ==  0));
+  tb->check(COND_register,      (core->reg_write_o           ==  1)    &&
+                                (core->reg_addr_o            ==  reg_addr) &&
+                                (core->reg_data_o            ==  1));
+  tb->check(COND_output_valid,  (core->output_valid_o        ==  1));
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  tb->_nop();
+
+  //=================================
+  //      Tick (7)
+
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Formal Checks
+
+  CHECK("tb_loadstore_w_atomic.sc_store.01",
+      tb->conditions[COND_state],
+      "Failed to implement the state machine", tb->err_cycles[COND_state]);
+
+  CHECK("tb_loadstore_w_atomic.sc_store.02",
+      tb->conditions[COND_wishbone],
+      "Failed to skip the memory request", tb->err_cycles[COND_wishbone]);
+
+  CHECK("tb_loadstore_w_atomic.sc_store.03",
+      tb->conditions[COND_register],
+      "Failed to implement the register protocol", tb->err_cycles[COND_register]);
+
+  CHECK("tb_loadstore_w_atomic.sc_store.04",
+      tb->conditions[COND_output_valid],
+      "Failed to implement the output_valid_o signal", tb->err_cycles[COND_output_valid]);
+
+  CHECK("tb_loadstore_w_atomic.sc_store.05",
+      tb->conditions[COND_reservation],
+      "Failed to implement the reservation", tb->err_cycles[COND_reservation]);
+}
+
+int main(int argc, char ** argv, char ** env) {
+  srand(time(NULL));
+  Verilated::traceEverOn(true);
+
+  bool verbose = parse_verbose(argc, argv);
+
+  TB_Loadstore_w_atomic * tb = new TB_Loadstore_w_atomic;
+  tb->open_trace("waves/loadstore_w_atomic.vcd");
+  tb->open_testdata("testdata/loadstore_w_atomic.csv");
+  tb->set_debug_log(verbose);
+  tb->init_conditions(__CondIdEnd);
+
+  /************************************************************/
+
+  tb_loadstore_w_atomic_amo(tb);
+
+  tb_loadstore_w_atomic_lr_sc(tb);
+
+  tb_loadstore_w_atomic_sc_fail(tb);
+
+  tb_loadstore_w_atomic_sc_killed(tb);
+
+  tb_loadstore_w_atomic_sc_store(tb);
+
+  /************************************************************/
+
+  printf("[LOADSTORE_W_ATOMIC]: ");
+  if(tb->success) {
+    printf("Done\n");
+  } else {
+    printf("Failed\n");
+  }
+
+  delete tb;
+  exit(EXIT_SUCCESS);
+}
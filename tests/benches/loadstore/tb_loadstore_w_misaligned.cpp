@@ -0,0 +1,509 @@
+/*           __        _
+ *  ________/ /  ___ _(_)__  ___
+ * / __/ __/ _ \/ _ `/ / _ \/ -_)
+ * \__/\__/_//_/\_,_/_/_//_/\__/
+ *
+ * Copyright (C) Clément Chaine
+ * This file is part of ECAP5-DPROC <https://github.com/ecap5/ECAP5-DPROC>
+ *
+ * ECAP5-DPROC is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ECAP5-DPROC is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ECAP5-DPROC.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <verilated.h>
+#include <verilated_vcd_c.h>
+#include <svdpi.h>
+
+#include "testbench.h"
+
+#include "Vtb_loadstore_w_misaligned.h"
+#include "Vtb_loadstore_w_misaligned_tb_loadstore_w_misaligned.h"
+#include "Vtb_loadstore_w_misaligned_loadstore.h"
+#include "Vtb_loadstore_w_misaligned_ecap5_dproc_pkg.h"
+
+enum CondId {
+  COND_state,
+  COND_wishbone,
+  COND_register,
+  COND_output_valid,
+  __CondIdEnd
+};
+
+enum TestcaseId {
+  T_WITHIN_WORD  =  1,
+  T_SPLIT_LW     =  2,
+  T_SPLIT_LH     =  3,
+  T_SPLIT_SW     =  4
+};
+
+class TB_Loadstore_w_misaligned : public Testbench<Vtb_loadstore_w_misaligned> {
+public:
+  void reset() {
+    this->_nop();
+    this->core->input_valid_i = 0;
+    this->core->wb_ack_i = 0;
+    this->core->wb_stall_i = 0;
+    this->core->wb_dat_i = 0;
+
+    this->core->rst_i = 1;
+    for(int i = 0; i < 5; i++) {
+      this->tick();
+    }
+    this->core->rst_i = 0;
+
+    Testbench<Vtb_loadstore_w_misaligned>::reset();
+  }
+
+  void _nop() {
+    this->core->alu_result_i = 0;
+    this->core->enable_i = 0;
+    this->core->write_i = 0;
+    this->core->sel_i = 0x0;
+    this->core->write_data_i = 0;
+    this->core->unsigned_load_i = 0;
+    this->core->reg_write_i = 0;
+    this->core->reg_addr_i = 0;
+  }
+
+  void _load(uint32_t addr, uint8_t sel, uint8_t unsigned_load, uint8_t reg_addr) {
+    this->_nop();
+    this->core->alu_result_i = addr;
+    this->core->enable_i = 1;
+    this->core->write_i = 0;
+    this->core->sel_i = sel;
+    this->core->unsigned_load_i = unsigned_load;
+    this->core->reg_write_i = 1;
+    this->core->reg_addr_i = reg_addr;
+  }
+
+  void _store(uint32_t addr, uint8_t sel, uint32_t data) {
+    this->_nop();
+    this->core->alu_result_i = addr;
+    this->core->enable_i = 1;
+    this->core->write_i = 1;
+    this->core->write_data_i = data;
+    this->core->sel_i = sel;
+    this->core->reg_write_i = 0;
+  }
+
+  // Right-aligned bytes selected by sel
+  static uint32_t mask(uint8_t sel) {
+    uint32_t m = 0;
+    for(int i = 0; i < 4; i++) {
+      if(sel & (1 << i)) {
+        m |= (0xFFu << (8 * i));
+      }
+    }
+    return m;
+  }
+};
+
+void tb_loadstore_w_misaligned_within_word(TB_Loadstore_w_misaligned * tb) {
+  Vtb_loadstore_w_misaligned * core = tb->core;
+  core->testcase = T_WITHIN_WORD;
+
+  // The following actions are performed in this test :
+  //    tick 0. Set the inputs to request a LH on the second byte of a word
+  //    tick 1. Acknowledge the request
+  //    tick 2. Nothing (core detects end of request)
+
+  tb->reset();
+
+  core->input_valid_i = 1;
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  uint32_t addr = (rand() & ~0x3) + 1;
+  uint32_t reg_addr = 1 + rand() % 31;
+  tb->_load(addr, 0x3, 1, reg_addr);
+
+  //=================================
+  //      Tick (0)
+
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_state,         (core->tb_loadstore_w_misaligned->dut->state_q  ==  1));
+  tb->check(COND_wishbone,      (core->wb_adr_o              ==  addr) &&
+                                (core->wb_we_o               ==  0)    &&
+                                (core->wb_sel_o              ==  0x3)  &&
+                                (core->wb_stb_o              ==  1)    &&
+                                (core->wb_cyc_o              ==  1));
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  uint32_t data = rand() & 0xFFFF;
+  tb->_nop();
+  core->wb_ack_i = 1;
+  core->wb_dat_i = data;
+
+  //=================================
+  //      Tick (1)
+
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks
+
+  // The request doesn't cross a word boundary
+  tb->check(COND_state,         (core->tb_loadstore_w_misaligned->dut->state_q  ==  3));
+  tb->check(COND_wishbone,      (core->wb_stb_o              ==  0));
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  core->wb_ack_i = 0;
+  core->wb_dat_i = 0;
+
+  //=================================
+  //      Tick (2)
+
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_state,         (core->tb_loadstore_w_misaligned->dut->state_q  ==  0));
+  tb->check(COND_wishbone,      (core->wb_cyc_o              ==  0));
+  tb->check(COND_register,      (core->reg_write_o           ==  1)    &&
+                                (core->reg_addr_o            ==  reg_addr) &&
+                                (core->reg_data_o            ==  data));
+  tb->check(COND_output_valid,  (core->output_valid_o        ==  1));
+
+  //`````````````````````````````````
+  //      Formal Checks
+
+  CHECK("tb_loadstore_w_misaligned.within_word.01",
+      tb->conditions[COND_state],
+      "Failed to implement the state machine", tb->err_cycles[COND_state]);
+
+  CHECK("tb_loadstore_w_misaligned.within_word.02",
+      tb->conditions[COND_wishbone],
+      "Failed to perform a single request within a word", tb->err_cycles[COND_wishbone]);
+
+  CHECK("tb_loadstore_w_misaligned.within_word.03",
+      tb->conditions[COND_register],
+      "Failed to implement the register protocol", tb->err_cycles[COND_register]);
+
+  CHECK("tb_loadstore_w_misaligned.within_word.04",
+      tb->conditions[COND_output_valid],
+      "Failed to implement the output_valid_o signal", tb->err_cycles[COND_output_valid]);
+}
+
+void tb_loadstore_w_misaligned_split_load(TB_Loadstore_w_misaligned * tb, uint8_t sel, uint32_t offset) {
+  Vtb_loadstore_w_misaligned * core = tb->core;
+
+  // The following actions are performed in this test :
+  //    tick 0. Set the inputs to request a load crossing a word boundary
+  //    tick 1. Acknowledge the first request (core performs the second request)
+  //    tick 2. Acknowledge the second request
+  //    tick 3. Nothing (core outputs the load result)
+
+  tb->reset();
+
+  core->input_valid_i = 1;
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  uint32_t base = rand() & ~0x3;
+  uint32_t addr = base + offset;
+  uint32_t reg_addr = 1 + rand() % 31;
+  tb->_load(addr, sel, 0, reg_addr);
+
+  uint32_t word0 = rand();
+  uint32_t word1 = rand();
+  uint8_t sel0 = (sel << offset) & 0xF;
+  uint8_t sel1 = (sel << offset) >> 4;
+
+  //=================================
+  //      Tick (0)
+
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_state,         (core->tb_loadstore_w_misaligned->dut->state_q  ==  1));
+  tb->check(COND_wishbone,      (core->wb_adr_o              ==  base) &&
+                                (core->wb_we_o               ==  0)    &&
+                                (core->wb_sel_o              ==  sel0) &&
+                                (core->wb_stb_o              ==  1)    &&
+                                (core->wb_cyc_o              ==  1));
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  tb->_nop();
+  core->wb_ack_i = 1;
+  // The bytes of the lanes which are not selected are ignored
+  core->wb_dat_i = word0;
+
+  //=================================
+  //      Tick (1)
+
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_state,         (core->tb_loadstore_w_misaligned->dut->state_q  ==  1));
+  tb->check(COND_wishbone,      (core->wb_adr_o              ==  base + 4) &&
+                                (core->wb_we_o               ==  0)    &&
+                                (core->wb_sel_o              ==  sel1) &&
+                                (core->wb_stb_o              ==  1)    &&
+                                (core->wb_cyc_o              ==  1));
+  tb->check(COND_output_valid,  (core->output_valid_o        ==  0));
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  core->wb_ack_i = 1;
+  core->wb_dat_i = word1;
+
+  //=================================
+  //      Tick (2)
+
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_state,         (core->tb_loadstore_w_misaligned->dut->state_q  ==  3));
+  tb->check(COND_wishbone,      (core->wb_stb_o              ==  0));
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  core->wb_ack_i = 0;
+  core->wb_dat_i = 0;
+
+  //=================================
+  //      Tick (3)
+
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks
+
+  uint32_t value = (uint32_t)(((((uint64_t)word1 << 32) | word0) >> (8 * offset)) & tb->mask(sel));
+  if(sel == 0x3) {
+    value = (uint32_t)(int32_t)(int16_t)value;
+  }
+
+  tb->check(COND_state,         (core->tb_loadstore_w_misaligned->dut->state_q  ==  0));
+  tb->check(COND_wishbone,      (core->wb_cyc_o              ==  0));
+  tb->check(COND_register,      (core->reg_write_o           ==  1)    &&
+                                (core->reg_addr_o            ==  reg_addr) &&
+                                (core->reg_data_o            ==  value));
+  tb->check(COND_output_valid,  (core->output_valid_o        ==  1));
+}
+
+void tb_loadstore_w_misaligned_split_lw(TB_Loadstore_w_misaligned * tb) {
+  tb->core->testcase = T_SPLIT_LW;
+
+  for(uint32_t offset = 1; offset < 4; offset++) {
+    tb_loadstore_w_misaligned_split_load(tb, 0xF, offset);
+  }
+
+  //`````````````````````````````````
+  //      Formal Checks
+
+  CHECK("tb_loadstore_w_misaligned.split.LW_01",
+      tb->conditions[COND_state],
+      "Failed to implement the state machine", tb->err_cycles[COND_state]);
+
+  CHECK("tb_loadstore_w_misaligned.split.LW_02",
+      tb->conditions[COND_wishbone],
+      "Failed to split the request crossing a word boundary", tb->err_cycles[COND_wishbone]);
+
+  CHECK("tb_loadstore_w_misaligned.split.LW_03",
+      tb->conditions[COND_register],
+      "Failed to merge the responses of a split load", tb->err_cycles[COND_register]);
+
+  CHECK("tb_loadstore_w_misaligned.split.LW_04",
+      tb->conditions[COND_output_valid],
+      "Failed to implement the output_valid_o signal", tb->err_cycles[COND_output_valid]);
+}
+
+void tb_loadstore_w_misaligned_split_lh(TB_Loadstore_w_misaligned * tb) {
+  tb->core->testcase = T_SPLIT_LH;
+
+  tb_loadstore_w_misaligned_split_load(tb, 0x3, 3);
+
+  //`````````````````````````````````
+  //      Formal Checks
+
+  CHECK("tb_loadstore_w_misaligned.split.LH_01",
+      tb->conditions[COND_state],
+      "Failed to implement the state machine", tb->err_cycles[COND_state]);
+
+  CHECK("tb_loadstore_w_misaligned.split.LH_02",
+      tb->conditions[COND_wishbone],
+      "Failed to split the request crossing a word boundary", tb->err_cycles[COND_wishbone]);
+
+  CHECK("tb_loadstore_w_misaligned.split.LH_03",
+      tb->conditions[COND_register],
+      "Failed to merge and sign-extend the responses of a split load", tb->err_cycles[COND_register]);
+
+  CHECK("tb_loadstore_w_misaligned.split.LH_04",
+      tb->conditions[COND_output_valid],
+      "Failed to implement the output_valid_o signal", tb->err_cycles[COND_output_valid]);
+}
+
+void tb_loadstore_w_misaligned_split_sw(TB_Loadstore_w_misaligned * tb) {
+  Vtb_loadstore_w_misaligned * core = tb->core;
+  core->testcase = T_SPLIT_SW;
+
+  // The following actions are performed in this test :
+  //    tick 0. Set the inputs to request a SW crossing a word boundary
+  //    tick 1. Acknowledge the first request (core performs the second request)
+  //    tick 2. Acknowledge the second request
+  //    tick 3. Nothing (core completes the store)
+
+  for(uint32_t offset = 1; offset < 4; offset++) {
+    tb->reset();
+
+    core->input_valid_i = 1;
+
+    //`````````````````````````````````
+    //      Set inputs
+
+    uint32_t base = rand() & ~0x3;
+    uint32_t data = rand();
+    tb->_store(base + offset, 0xF, data);
+
+    //=================================
+    //      Tick (0)
+
+    tb->tick();
+
+    //`````````````````````````````````
+    //      Checks
+
+    tb->check(COND_wishbone,      (core->wb_adr_o              ==  base) &&
+                                  (core->wb_dat_o              ==  (data << (8 * offset))) &&
+                                  (core->wb_we_o               ==  1)    &&
+                                  (core->wb_sel_o              ==  ((0xF << offset) & 0xF)) &&
+                                  (core->wb_stb_o              ==  1)    &&
+                                  (core->wb_cyc_o              ==  1));
+
+    //`````````````````````````````````
+    //      Set inputs
+
+    tb->_nop();
+    core->wb_ack_i = 1;
+
+    //=================================
+    //      Tick (1)
+
+    tb->tick();
+
+    //`````````````````````````````````
+    //      Checks
+
+    tb->check(COND_wishbone,      (core->wb_adr_o              ==  base + 4) &&
+                                  (core->wb_dat_o              ==  (data >> (8 * (4 - offset)))) &&
+                                  (core->wb_we_o               ==  1)    &&
+                                  (core->wb_sel_o              ==  ((1 << offset) - 1)) &&
+                                  (core->wb_stb_o              ==  1)    &&
+                                  (core->wb_cyc_o              ==  1));
+
+    //=================================
+    //      Tick (2)
+
+    tb->tick();
+
+    //`````````````````````````````````
+    //      Checks
+
+    tb->check(COND_state,         (core->tb_loadstore_w_misaligned->dut->state_q  ==  3));
+
+    //`````````````````````````````````
+    //      Set inputs
+
+    core->wb_ack_i = 0;
+
+    //=================================
+    //      Tick (3)
+
+    tb->tick();
+
+    //`````````````````````````````````
+    //      Checks
+
+    tb->check(COND_state,         (core->tb_loadstore_w_misaligned->dut->state_q  ==  0));
+    tb->check(COND_wishbone,      (core->wb_cyc_o              ==  0));
+    tb->check(COND_register,      (core->reg_write_o           ==  0));
+    tb->check(COND_output_valid,  (core->output_valid_o        ==  1));
+  }
+
+  //`````````````````````````````````
+  //      Formal Checks
+
+  CHECK("tb_loadstore_w_misaligned.split.SW_01",
+      tb->conditions[COND_state],
+      "Failed to implement the state machine", tb->err_cycles[COND_state]);
+
+  CHECK("tb_loadstore_w_misaligned.split.SW_02",
+      tb->conditions[COND_wishbone],
+      "Failed to split the request crossing a word boundary", tb->err_cycles[COND_wishbone]);
+
+  CHECK("tb_loadstore_w_misaligned.split.SW_03",
+      tb->conditions[COND_register],
+      "Failed to implement the register protocol", tb->err_cycles[COND_register]);
+
+  CHECK("tb_loadstore_w_misaligned.split.SW_04",
+      tb->conditions[COND_output_valid],
+      "Failed to implement the output_valid_o signal", tb->err_cycles[COND_output_valid]);
+}
+
+int main(int argc, char ** argv, char ** env) {
+  srand(time(NULL));
+  Verilated::traceEverOn(true);
+
+  bool verbose = parse_verbose(argc, argv);
+
+  TB_Loadstore_w_misaligned * tb = new TB_Loadstore_w_misaligned;
+  tb->open_trace("waves/loadstore_w_misaligned.vcd");
+  tb->open_testdata("testdata/loadstore_w_misaligned.csv");
+  tb->set_debug_log(verbose);
+  tb->init_conditions(__CondIdEnd);
+
+  /************************************************************/
+
+  tb_loadstore_w_misaligned_within_word(tb);
+
+  tb_loadstore_w_misaligned_split_lw(tb);
+  tb_loadstore_w_misaligned_split_lh(tb);
+  tb_loadstore_w_misaligned_split_sw(tb);
+
+  /************************************************************/
+
+  printf("[LOADSTORE_W_MISALIGNED]: ");
+  if(tb->success) {
+    printf("Done\n");
+  } else {
+    printf("Failed\n");
+  }
+
+  delete tb;
+  exit(EXIT_SUCCESS);
+}
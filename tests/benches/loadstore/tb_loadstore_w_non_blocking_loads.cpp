@@ -0,0 +1,562 @@
+/*           __        _
+ *  ________/ /  ___ _(_)__  ___
+ * / __/ __/ _ \/ _ `/ / _ \/ -_)
+ * \__/\__/_//_/\_,_/_/_//_/\__/
+ *
+ * Copyright (C) Clément Chaine
+ * This file is part of ECAP5-DPROC <https://github.com/ecap5/ECAP5-DPROC>
+ *
+ * ECAP5-DPROC is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ECAP5-DPROC is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ECAP5-DPROC.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <verilated.h>
+#include <verilated_vcd_c.h>
+#include <svdpi.h>
+
+#include "testbench.h"
+
+#include "Vtb_loadstore_w_non_blocking_loads.h"
+#include "Vtb_loadstore_w_non_blocking_loads_tb_loadstore_w_non_blocking_loads.h"
+#include "Vtb_loadstore_w_non_blocking_loads_loadstore.h"
+#include "Vtb_loadstore_w_non_blocking_loads_ecap5_dproc_pkg.h"
+
+enum CondId {
+  COND_state,
+  COND_input_ready,
+  COND_wishbone,
+  COND_register,
+  COND_output_valid,
+  COND_scoreboard,
+  __CondIdEnd
+};
+
+enum TestcaseId {
+  T_RESET         =  1,
+  T_PASS_THROUGH  =  2,
+  T_MEMORY_HOLD   =  3,
+  T_OVERWRITE     =  4
+};
+
+class TB_Loadstore_w_non_blocking_loads : public Testbench<Vtb_loadstore_w_non_blocking_loads> {
+public:
+  void reset() {
+    this->_nop();
+    this->core->input_valid_i = 0;
+    this->core->wb_ack_i = 0;
+    this->core->wb_stall_i = 0;
+    this->core->wb_dat_i = 0;
+
+    this->core->rst_i = 1;
+    for(int i = 0; i < 5; i++) {
+      this->tick();
+    }
+    this->core->rst_i = 0;
+
+    Testbench<Vtb_loadstore_w_non_blocking_loads>::reset();
+  }
+
+  void _nop() {
+    this->core->alu_result_i = 0;
+    this->core->enable_i = 0;
+    this->core->write_i = 0;
+    this->core->sel_i = 0x0;
+    this->core->write_data_i = 0;
+    this->core->unsigned_load_i = 0;
+    this->core->reg_write_i = 0;
+    this->core->reg_addr_i = 0;
+  }
+
+  void _lw(uint32_t addr, uint8_t reg_addr) {
+    this->_nop();
+    this->core->alu_result_i = addr;
+    this->core->enable_i = 1;
+    this->core->write_i = 0;
+    this->core->sel_i = 0xF;
+    this->core->unsigned_load_i = 0;
+    this->core->reg_write_i = 1;
+    this->core->reg_addr_i = reg_addr;
+  }
+
+  void _sw(uint32_t addr, uint32_t data) {
+    this->_nop();
+    this->core->alu_result_i = addr;
+    this->core->enable_i = 1;
+    this->core->write_i = 1;
+    this->core->write_data_i = data;
+    this->core->sel_i = 0xF;
+    this->core->reg_write_i = 0;
+  }
+
+  void _bypass(uint32_t alu_result, uint8_t write, uint8_t reg_addr) {
+    this->_nop();
+    this->core->enable_i = 0;
+    this->core->alu_result_i = alu_result;
+    this->core->reg_write_i = write;
+    this->core->reg_addr_i = reg_addr;
+  }
+};
+
+void tb_loadstore_w_non_blocking_loads_reset(TB_Loadstore_w_non_blocking_loads * tb) {
+  Vtb_loadstore_w_non_blocking_loads * core = tb->core;
+  core->testcase = T_RESET;
+
+  //=================================
+  //      Tick (0)
+
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_wishbone,     (core->wb_stb_o        ==  0)        &&
+                               (core->wb_cyc_o        ==  0));
+  tb->check(COND_scoreboard,   (core->scoreboard_o    ==  0)        &&
+                               (core->tb_loadstore_w_non_blocking_loads->dut->load_pending_q  ==  0));
+
+  //`````````````````````````````````
+  //      Formal Checks
+
+  CHECK("tb_loadstore_w_non_blocking_loads.reset.01",
+      tb->conditions[COND_wishbone],
+      "Failed to implement the wishbone protocol", tb->err_cycles[COND_wishbone]);
+
+  CHECK("tb_loadstore_w_non_blocking_loads.reset.02",
+      tb->conditions[COND_scoreboard],
+      "Failed to reset the scoreboard", tb->err_cycles[COND_scoreboard]);
+}
+
+void tb_loadstore_w_non_blocking_loads_pass_through(TB_Loadstore_w_non_blocking_loads * tb) {
+  Vtb_loadstore_w_non_blocking_loads * core = tb->core;
+  core->testcase = T_PASS_THROUGH;
+
+  // The following actions are performed in this test :
+  //    tick 0. Set the inputs to request a LW
+  //    tick 1. Set the inputs to bypass a first result
+  //    tick 2. Acknowledge the load and set the inputs to bypass a second result
+  //    tick 3. Set the inputs to bypass a third result (core outputs the load result)
+  //    tick 4. Set the inputs to request a nop (core outputs the third result)
+
+  tb->reset();
+
+  core->input_valid_i = 1;
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  uint32_t addr = rand();
+  uint32_t reg_addr = 1 + rand() % 31;
+  tb->_lw(addr, reg_addr);
+
+  //=================================
+  //      Tick (0)
+
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_state,         (core->tb_loadstore_w_non_blocking_loads->dut->state_q  ==  1));
+  tb->check(COND_input_ready,   (core->input_ready_o         ==  1));
+  tb->check(COND_wishbone,      (core->wb_adr_o              ==  addr) &&
+                                (core->wb_we_o               ==  0)    &&
+                                (core->wb_sel_o              ==  0xF)  &&
+                                (core->wb_stb_o              ==  1)    &&
+                                (core->wb_cyc_o              ==  1));
+  tb->check(COND_register,      (core->reg_write_o           ==  0));
+  tb->check(COND_output_valid,  (core->output_valid_o        ==  1));
+  tb->check(COND_scoreboard,    (core->scoreboard_o          ==  (1u << reg_addr)));
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  uint32_t result1 = rand();
+  uint32_t reg_addr1 = 1 + (reg_addr % 31);
+  tb->_bypass(result1, 1, reg_addr1);
+
+  //=================================
+  //      Tick (1)
+
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_state,         (core->tb_loadstore_w_non_blocking_loads->dut->state_q  ==  2));
+  tb->check(COND_input_ready,   (core->input_ready_o         ==  1));
+  tb->check(COND_wishbone,      (core->wb_stb_o              ==  0)    &&
+                                (core->wb_cyc_o              ==  1));
+  tb->check(COND_register,      (core->reg_write_o           ==  1)    &&
+                                (core->reg_addr_o            ==  reg_addr1) &&
+                                (core->reg_data_o            ==  result1));
+  tb->check(COND_output_valid,  (core->output_valid_o        ==  1));
+  tb->check(COND_scoreboard,    (core->scoreboard_o          ==  (1u << reg_addr)));
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  uint32_t data = rand();
+  core->wb_ack_i = 1;
+  core->wb_dat_i = data;
+
+  uint32_t result2 = rand();
+  tb->_bypass(result2, 0, reg_addr);
+
+  //=================================
+  //      Tick (2)
+
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_state,         (core->tb_loadstore_w_non_blocking_loads->dut->state_q  ==  3));
+  tb->check(COND_input_ready,   (core->input_ready_o         ==  0));
+  tb->check(COND_register,      (core->reg_write_o           ==  0)    &&
+                                (core->reg_data_o            ==  result2));
+  tb->check(COND_output_valid,  (core->output_valid_o        ==  1));
+  tb->check(COND_scoreboard,    (core->scoreboard_o          ==  (1u << reg_addr)));
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  core->wb_ack_i = 0;
+  core->wb_dat_i = 0;
+
+  uint32_t result3 = rand();
+  tb->_bypass(result3, 1, reg_addr1);
+
+  //=================================
+  //      Tick (3)
+
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_state,         (core->tb_loadstore_w_non_blocking_loads->dut->state_q  ==  0));
+  tb->check(COND_input_ready,   (core->input_ready_o         ==  1));
+  tb->check(COND_wishbone,      (core->wb_stb_o              ==  0)    &&
+                                (core->wb_cyc_o              ==  0));
+  tb->check(COND_register,      (core->reg_write_o           ==  1)    &&
+                                (core->reg_addr_o            ==  reg_addr) &&
+                                (core->reg_data_o            ==  data));
+  tb->check(COND_output_valid,  (core->output_valid_o        ==  1));
+  tb->check(COND_scoreboard,    (core->scoreboard_o          ==  0));
+
+  //=================================
+  //      Tick (4)
+
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks
+
+  // The third result was held while the load result was output
+  tb->check(COND_register,      (core->reg_write_o           ==  1)    &&
+                                (core->reg_addr_o            ==  reg_addr1) &&
+                                (core->reg_data_o            ==  result3));
+  tb->check(COND_output_valid,  (core->output_valid_o        ==  1));
+
+  //`````````````````````````````````
+  //      Formal Checks
+
+  CHECK("tb_loadstore_w_non_blocking_loads.pass_through.01",
+      tb->conditions[COND_state],
+      "Failed to implement the state machine", tb->err_cycles[COND_state]);
+
+  CHECK("tb_loadstore_w_non_blocking_loads.pass_through.02",
+      tb->conditions[COND_input_ready],
+      "Failed to implement the input_ready_o signal", tb->err_cycles[COND_input_ready]);
+
+  CHECK("tb_loadstore_w_non_blocking_loads.pass_through.03",
+      tb->conditions[COND_wishbone],
+      "Failed to implement the wishbone protocol", tb->err_cycles[COND_wishbone]);
+
+  CHECK("tb_loadstore_w_non_blocking_loads.pass_through.04",
+      tb->conditions[COND_register],
+      "Failed to output the results while the load is pending", tb->err_cycles[COND_register]);
+
+  CHECK("tb_loadstore_w_non_blocking_loads.pass_through.05",
+      tb->conditions[COND_output_valid],
+      "Failed to implement the output_valid_o signal", tb->err_cycles[COND_output_valid]);
+
+  CHECK("tb_loadstore_w_non_blocking_loads.pass_through.06",
+      tb->conditions[COND_scoreboard],
+      "Failed to implement the scoreboard", tb->err_cycles[COND_scoreboard]);
+}
+
+void tb_loadstore_w_non_blocking_loads_memory_hold(TB_Loadstore_w_non_blocking_loads * tb) {
+  Vtb_loadstore_w_non_blocking_loads * core = tb->core;
+  core->testcase = T_MEMORY_HOLD;
+
+  // The following actions are performed in this test :
+  //    tick 0. Set the inputs to request a LW
+  //    tick 1. Set the inputs to request a SW (core holds the store)
+  //    tick 2. Acknowledge the load
+  //    tick 3. Nothing (core outputs the load result)
+  //    tick 4. Nothing (core requests the store)
+
+  tb->reset();
+
+  core->input_valid_i = 1;
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  uint32_t addr = rand();
+  uint32_t reg_addr = 1 + rand() % 31;
+  tb->_lw(addr, reg_addr);
+
+  //=================================
+  //      Tick (0)
+
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  uint32_t store_addr = rand();
+  uint32_t store_data = rand();
+  tb->_sw(store_addr, store_data);
+
+  // this change is asynchronous
+  core->eval();
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_input_ready,   (core->input_ready_o         ==  0));
+
+  //=================================
+  //      Tick (1)
+
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_state,         (core->tb_loadstore_w_non_blocking_loads->dut->state_q  ==  2));
+  tb->check(COND_input_ready,   (core->input_ready_o         ==  0));
+  tb->check(COND_wishbone,      (core->wb_adr_o              ==  addr) &&
+                                (core->wb_we_o               ==  0)    &&
+                                (core->wb_cyc_o              ==  1));
+  tb->check(COND_output_valid,  (core->output_valid_o        ==  0));
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  uint32_t data = rand();
+  core->wb_ack_i = 1;
+  core->wb_dat_i = data;
+
+  //=================================
+  //      Tick (2)
+
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_state,         (core->tb_loadstore_w_non_blocking_loads->dut->state_q  ==  3));
+  tb->check(COND_input_ready,   (core->input_ready_o         ==  0));
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  core->wb_ack_i = 0;
+  core->wb_dat_i = 0;
+
+  //=================================
+  //      Tick (3)
+
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_state,         (core->tb_loadstore_w_non_blocking_loads->dut->state_q  ==  0));
+  tb->check(COND_input_ready,   (core->input_ready_o         ==  1));
+  tb->check(COND_register,      (core->reg_write_o           ==  1)    &&
+                                (core->reg_addr_o            ==  reg_addr) &&
+                                (core->reg_data_o            ==  data));
+  tb->check(COND_output_valid,  (core->output_valid_o        ==  1));
+
+  //=================================
+  //      Tick (4)
+
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks
+
+  // The store is requested after the load completes
+  tb->check(COND_state,         (core->tb_loadstore_w_non_blocking_loads->dut->state_q  ==  1));
+  tb->check(COND_input_ready,   (core->input_ready_o         ==  0));
+  tb->check(COND_wishbone,      (core->wb_adr_o              ==  store_addr) &&
+                                (core->wb_dat_o              ==  store_data) &&
+                                (core->wb_we_o               ==  1)    &&
+                                (core->wb_stb_o              ==  1)    &&
+                                (core->wb_cyc_o              ==  1));
+
+  //`````````````````````````````````
+  //      Formal Checks
+
+  CHECK("tb_loadstore_w_non_blocking_loads.memory_hold.01",
+      tb->conditions[COND_state],
+      "Failed to implement the state machine", tb->err_cycles[COND_state]);
+
+  CHECK("tb_loadstore_w_non_blocking_loads.memory_hold.02",
+      tb->conditions[COND_input_ready],
+      "Failed to hold the memory request while the load is pending", tb->err_cycles[COND_input_ready]);
+
+  CHECK("tb_loadstore_w_non_blocking_loads.memory_hold.03",
+      tb->conditions[COND_wishbone],
+      "Failed to implement the wishbone protocol", tb->err_cycles[COND_wishbone]);
+
+  CHECK("tb_loadstore_w_non_blocking_loads.memory_hold.04",
+      tb->conditions[COND_register],
+      "Failed to implement the register protocol", tb->err_cycles[COND_register]);
+
+  CHECK("tb_loadstore_w_non_blocking_loads.memory_hold.05",
+      tb->conditions[COND_output_valid],
+      "Failed to implement the output_valid_o signal", tb->err_cycles[COND_output_valid]);
+}
+
+void tb_loadstore_w_non_blocking_loads_overwrite(TB_Loadstore_w_non_blocking_loads * tb) {
+  Vtb_loadstore_w_non_blocking_loads * core = tb->core;
+  core->testcase = T_OVERWRITE;
+
+  // The following actions are performed in this test :
+  //    tick 0. Set the inputs to request a LW
+  //    tick 1. Set the inputs to bypass a result to the register of the load
+  //    tick 2. Acknowledge the load
+  //    tick 3. Nothing (core discards the load result)
+
+  tb->reset();
+
+  core->input_valid_i = 1;
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  uint32_t addr = rand();
+  uint32_t reg_addr = 1 + rand() % 31;
+  tb->_lw(addr, reg_addr);
+
+  //=================================
+  //      Tick (0)
+
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  uint32_t result = rand();
+  tb->_bypass(result, 1, reg_addr);
+
+  //=================================
+  //      Tick (1)
+
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_register,      (core->reg_write_o           ==  1)    &&
+                                (core->reg_addr_o            ==  reg_addr) &&
+                                (core->reg_data_o            ==  result));
+  tb->check(COND_scoreboard,    (core->scoreboard_o          ==  0));
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  core->wb_ack_i = 1;
+  core->wb_dat_i = rand();
+  tb->_nop();
+
+  //=================================
+  //      Tick (2)
+
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  core->wb_ack_i = 0;
+  core->wb_dat_i = 0;
+
+  //=================================
+  //      Tick (3)
+
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_register,      (core->reg_write_o           ==  0));
+  tb->check(COND_output_valid,  (core->output_valid_o        ==  1));
+  tb->check(COND_scoreboard,    (core->scoreboard_o          ==  0)    &&
+                                (core->tb_loadstore_w_non_blocking_loads->dut->load_pending_q  ==  0));
+
+  //`````````````````````````````````
+  //      Formal Checks
+
+  CHECK("tb_loadstore_w_non_blocking_loads.overwrite.01",
+      tb->conditions[COND_register],
+      "Failed to discard the result of a load overwritten by a later instruction", tb->err_cycles[COND_register]);
+
+  CHECK("tb_loadstore_w_non_blocking_loads.overwrite.02",
+      tb->conditions[COND_output_valid],
+      "Failed to implement the output_valid_o signal", tb->err_cycles[COND_output_valid]);
+
+  CHECK("tb_loadstore_w_non_blocking_loads.overwrite.03",
+      tb->conditions[COND_scoreboard],
+      "Failed to implement the scoreboard", tb->err_cycles[COND_scoreboard]);
+}
+
+int main(int argc, char ** argv, char ** env) {
+  srand(time(NULL));
+  Verilated::traceEverOn(true);
+
+  bool verbose = parse_verbose(argc, argv);
+
+  TB_Loadstore_w_non_blocking_loads * tb = new TB_Loadstore_w_non_blocking_loads;
+  tb->open_trace("waves/loadstore_w_non_blocking_loads.vcd");
+  tb->open_testdata("testdata/loadstore_w_non_blocking_loads.csv");
+  tb->set_debug_log(verbose);
+  tb->init_conditions(__CondIdEnd);
+
+  /************************************************************/
+
+  tb_loadstore_w_non_blocking_loads_reset(tb);
+
+  tb_loadstore_w_non_blocking_loads_pass_through(tb);
+  tb_loadstore_w_non_blocking_loads_memory_hold(tb);
+  tb_loadstore_w_non_blocking_loads_overwrite(tb);
+
+  /************************************************************/
+
+  printf("[LOADSTORE_W_NON_BLOCKING_LOADS]: ");
+  if(tb->success) {
+    printf("Done\n");
+  } else {
+    printf("Failed\n");
+  }
+
+  delete tb;
+  exit(EXIT_SUCCESS);
+}
@@ -83,6 +83,11 @@ loadstore dut (
  .write_data_i    (write_data_i),
  .sel_i           (sel_i),
  .unsigned_load_i (unsigned_load_i),
+ .atomic_i        (1'b0),
+ .atomic_op_i     ('0),
+ .reservation_kill_i  (0),
+ .reservation_valid_o (),
+ .reservation_adr_o   (),
  .reg_write_i     (reg_write_i),
  .reg_addr_i      (reg_addr_i),
  .wb_adr_o        (wb_adr_o),
@@ -97,7 +102,8 @@ loadstore dut (
  .output_valid_o  (output_valid_o),
  .reg_write_o     (reg_write_o),
  .reg_addr_o      (reg_addr_o),
- .reg_data_o      (reg_data_o)
+ .reg_data_o      (reg_data_o),
+ .scoreboard_o    ()
 );
 
 instr_wb_slave wb_slave (
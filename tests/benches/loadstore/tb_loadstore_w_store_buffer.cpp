@@ -0,0 +1,721 @@
+/*           __        _
+ *  ________/ /  ___ _(_)__  ___
+ * / __/ __/ _ \/ _ `/ / _ \/ -_)
+ * \__/\__/_//_/\_,_/_/_//_/\__/
+ *
+ * Copyright (C) Clément Chaine
+ * This file is part of ECAP5-DPROC <https://github.com/ecap5/ECAP5-DPROC>
+ *
+ * ECAP5-DPROC is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ECAP5-DPROC is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ECAP5-DPROC.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <verilated.h>
+#include <verilated_vcd_c.h>
+#include <svdpi.h>
+
+#include "testbench.h"
+
+#include "Vtb_loadstore_w_store_buffer.h"
+#include "Vtb_loadstore_w_store_buffer_tb_loadstore_w_store_buffer.h"
+#include "Vtb_loadstore_w_store_buffer_loadstore.h"
+#include "Vtb_loadstore_w_store_buffer_ecap5_dproc_pkg.h"
+
+enum CondId {
+  COND_state,
+  COND_input_ready,
+  COND_wishbone,
+  COND_register,
+  COND_output_valid,
+  COND_buffer,
+  __CondIdEnd
+};
+
+enum TestcaseId {
+  T_RESET         =  1,
+  T_STORE_RETIRE  =  2,
+  T_FORWARD       =  3,
+  T_FORWARD_WAIT  =  4,
+  T_BUFFER_FULL   =  5
+};
+
+class TB_Loadstore_w_store_buffer : public Testbench<Vtb_loadstore_w_store_buffer> {
+public:
+  void reset() {
+    this->_nop();
+    this->core->input_valid_i = 0;
+    this->core->wb_ack_i = 0;
+    this->core->wb_stall_i = 0;
+    this->core->wb_dat_i = 0;
+
+    this->core->rst_i = 1;
+    for(int i = 0; i < 5; i++) {
+      this->tick();
+    }
+    this->core->rst_i = 0;
+
+    Testbench<Vtb_loadstore_w_store_buffer>::reset();
+  }
+
+  void _nop() {
+    this->core->alu_result_i = 0;
+    this->core->enable_i = 0;
+    this->core->write_i = 0;
+    this->core->sel_i = 0x0;
+    this->core->write_data_i = 0;
+    this->core->unsigned_load_i = 0;
+    this->core->reg_write_i = 0;
+    this->core->reg_addr_i = 0;
+  }
+
+  void _load(uint32_t addr, uint8_t sel, uint8_t unsigned_load, uint8_t reg_addr) {
+    this->_nop();
+    this->core->alu_result_i = addr;
+    this->core->enable_i = 1;
+    this->core->write_i = 0;
+    this->core->sel_i = sel;
+    this->core->unsigned_load_i = unsigned_load;
+    this->core->reg_write_i = 1;
+    this->core->reg_addr_i = reg_addr;
+  }
+
+  void _store(uint32_t addr, uint8_t sel, uint32_t data) {
+    this->_nop();
+    this->core->alu_result_i = addr;
+    this->core->enable_i = 1;
+    this->core->write_i = 1;
+    this->core->write_data_i = data;
+    this->core->sel_i = sel;
+    this->core->reg_write_i = 0;
+  }
+
+  uint32_t sign_extend(uint32_t data, uint32_t nb_bits) {
+    data &= (1 << nb_bits)-1;
+    if((data >> (nb_bits-1)) & 0x1){
+      data |= (((1 << (32 - (nb_bits-1))) - 1) << nb_bits);
+    }
+    return data;
+  }
+};
+
+void tb_loadstore_w_store_buffer_reset(TB_Loadstore_w_store_buffer * tb) {
+  Vtb_loadstore_w_store_buffer * core = tb->core;
+  core->testcase = T_RESET;
+
+  //=================================
+  //      Tick (0)
+
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_wishbone,     (core->wb_stb_o        ==  0)        &&
+                               (core->wb_cyc_o        ==  0));
+  tb->check(COND_buffer,       (core->tb_loadstore_w_store_buffer->dut->sb_count_q  ==  0));
+
+  //`````````````````````````````````
+  //      Formal Checks
+
+  CHECK("tb_loadstore_w_store_buffer.reset.01",
+      tb->conditions[COND_wishbone],
+      "Failed to implement the wishbone protocol", tb->err_cycles[COND_wishbone]);
+
+  CHECK("tb_loadstore_w_store_buffer.reset.02",
+      tb->conditions[COND_buffer],
+      "Failed to reset the store buffer", tb->err_cycles[COND_buffer]);
+}
+
+void tb_loadstore_w_store_buffer_store_retire(TB_Loadstore_w_store_buffer * tb) {
+  Vtb_loadstore_w_store_buffer * core = tb->core;
+  core->testcase = T_STORE_RETIRE;
+
+  // The following actions are performed in this test :
+  //    tick 0. Set the inputs to request a SW
+  //    tick 1. Set the inputs to request a nop (core drains the store)
+  //    tick 2. Acknowledge the drained store
+  //    tick 3. Nothing (core is idle)
+
+  tb->reset();
+
+  core->input_valid_i = 1;
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  uint32_t addr = rand() & ~0x3;
+  uint32_t data = rand();
+  tb->_store(addr, 0xF, data);
+
+  //=================================
+  //      Tick (0)
+
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_state,         (core->tb_loadstore_w_store_buffer->dut->state_q  ==  0));
+  tb->check(COND_input_ready,   (core->input_ready_o         ==  1));
+  tb->check(COND_wishbone,      (core->wb_stb_o              ==  0)    &&
+                                (core->wb_cyc_o              ==  0));
+  tb->check(COND_register,      (core->reg_write_o           ==  0));
+  tb->check(COND_output_valid,  (core->output_valid_o        ==  1));
+  tb->check(COND_buffer,        (core->tb_loadstore_w_store_buffer->dut->sb_count_q  ==  1));
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  tb->_nop();
+
+  //=================================
+  //      Tick (1)
+
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_state,         (core->tb_loadstore_w_store_buffer->dut->state_q  ==  0));
+  tb->check(COND_input_ready,   (core->input_ready_o         ==  1));
+  tb->check(COND_wishbone,      (core->wb_adr_o              ==  addr) &&
+                                (core->wb_dat_o              ==  data) &&
+                                (core->wb_we_o               ==  1)    &&
+                                (core->wb_sel_o              ==  0xF)  &&
+                                (core->wb_stb_o              ==  1)    &&
+                                (core->wb_cyc_o              ==  1));
+  tb->check(COND_output_valid,  (core->output_valid_o        ==  1));
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  core->wb_ack_i = 1;
+
+  //=================================
+  //      Tick (2)
+
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_wishbone,      (core->wb_stb_o              ==  0)    &&
+                                (core->wb_cyc_o              ==  0));
+  tb->check(COND_buffer,        (core->tb_loadstore_w_store_buffer->dut->sb_count_q  ==  0));
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  core->wb_ack_i = 0;
+
+  //=================================
+  //      Tick (3)
+
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_wishbone,      (core->wb_stb_o              ==  0)    &&
+                                (core->wb_cyc_o              ==  0));
+  tb->check(COND_buffer,        (core->tb_loadstore_w_store_buffer->dut->sb_count_q  ==  0));
+
+  //`````````````````````````````````
+  //      Formal Checks
+
+  CHECK("tb_loadstore_w_store_buffer.store_retire.01",
+      tb->conditions[COND_state],
+      "Failed to implement the state machine", tb->err_cycles[COND_state]);
+
+  CHECK("tb_loadstore_w_store_buffer.store_retire.02",
+      tb->conditions[COND_input_ready],
+      "Failed to implement the input_ready_o signal", tb->err_cycles[COND_input_ready]);
+
+  CHECK("tb_loadstore_w_store_buffer.store_retire.03",
+      tb->conditions[COND_wishbone],
+      "Failed to drain the store buffer", tb->err_cycles[COND_wishbone]);
+
+  CHECK("tb_loadstore_w_store_buffer.store_retire.04",
+      tb->conditions[COND_register],
+      "Failed to implement the register protocol", tb->err_cycles[COND_register]);
+
+  CHECK("tb_loadstore_w_store_buffer.store_retire.05",
+      tb->conditions[COND_output_valid],
+      "Failed to implement the output_valid_o signal", tb->err_cycles[COND_output_valid]);
+
+  CHECK("tb_loadstore_w_store_buffer.store_retire.06",
+      tb->conditions[COND_buffer],
+      "Failed to implement the store buffer", tb->err_cycles[COND_buffer]);
+}
+
+void tb_loadstore_w_store_buffer_forward(TB_Loadstore_w_store_buffer * tb) {
+  Vtb_loadstore_w_store_buffer * core = tb->core;
+  core->testcase = T_FORWARD;
+
+  // The following actions are performed in this test :
+  //    tick 0. Set the inputs to request a SW
+  //    tick 1. Set the inputs to request a SB on the third byte of the same word
+  //    tick 2. Set the inputs to request a LB on the second byte (forwarded from the SW)
+  //    tick 3. Set the inputs to request a LBU on the third byte (forwarded from the SB)
+  //    tick 4. Set the inputs to request a LH on the upper half (partially provided by the SB)
+
+  tb->reset();
+
+  core->input_valid_i = 1;
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  uint32_t addr = rand() & ~0x3;
+  uint32_t data = rand();
+  uint32_t byte = rand() & 0xFF;
+  tb->_store(addr, 0xF, data);
+
+  //=================================
+  //      Tick (0)
+
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  tb->_store(addr + 2, 0x1, byte);
+
+  //=================================
+  //      Tick (1)
+
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_buffer,        (core->tb_loadstore_w_store_buffer->dut->sb_count_q  ==  2));
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  uint32_t reg_addr = 1 + rand() % 31;
+  tb->_load(addr + 1, 0x1, 0, reg_addr);
+
+  //=================================
+  //      Tick (2)
+
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_state,         (core->tb_loadstore_w_store_buffer->dut->state_q  ==  0));
+  tb->check(COND_input_ready,   (core->input_ready_o         ==  1));
+  // The store buffer is drained without being interrupted by the load
+  tb->check(COND_wishbone,      (core->wb_adr_o              ==  addr) &&
+                                (core->wb_we_o               ==  1)    &&
+                                (core->wb_cyc_o              ==  1));
+  tb->check(COND_register,      (core->reg_write_o           ==  1)    &&
+                                (core->reg_addr_o            ==  reg_addr) &&
+                                (core->reg_data_o            ==  tb->sign_extend(data >> 8, 8)));
+  tb->check(COND_output_valid,  (core->output_valid_o        ==  1));
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  tb->_load(addr + 2, 0x1, 1, reg_addr);
+
+  //=================================
+  //      Tick (3)
+
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_state,         (core->tb_loadstore_w_store_buffer->dut->state_q  ==  0));
+  tb->check(COND_input_ready,   (core->input_ready_o         ==  1));
+  tb->check(COND_register,      (core->reg_write_o           ==  1)    &&
+                                (core->reg_data_o            ==  byte));
+  tb->check(COND_output_valid,  (core->output_valid_o        ==  1));
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  tb->_load(addr + 2, 0x3, 0, reg_addr);
+
+  //=================================
+  //      Tick (4)
+
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks
+
+  // The load is only partially provided by the youngest store
+  tb->check(COND_state,         (core->tb_loadstore_w_store_buffer->dut->state_q  ==  5));
+  tb->check(COND_input_ready,   (core->input_ready_o         ==  0));
+
+  //`````````````````````````````````
+  //      Formal Checks
+
+  CHECK("tb_loadstore_w_store_buffer.forward.01",
+      tb->conditions[COND_state],
+      "Failed to implement the state machine", tb->err_cycles[COND_state]);
+
+  CHECK("tb_loadstore_w_store_buffer.forward.02",
+      tb->conditions[COND_input_ready],
+      "Failed to implement the input_ready_o signal", tb->err_cycles[COND_input_ready]);
+
+  CHECK("tb_loadstore_w_store_buffer.forward.03",
+      tb->conditions[COND_wishbone],
+      "Failed to drain the store buffer during a forwarded load", tb->err_cycles[COND_wishbone]);
+
+  CHECK("tb_loadstore_w_store_buffer.forward.04",
+      tb->conditions[COND_register],
+      "Failed to forward the stored data", tb->err_cycles[COND_register]);
+
+  CHECK("tb_loadstore_w_store_buffer.forward.05",
+      tb->conditions[COND_output_valid],
+      "Failed to implement the output_valid_o signal", tb->err_cycles[COND_output_valid]);
+}
+
+void tb_loadstore_w_store_buffer_forward_wait(TB_Loadstore_w_store_buffer * tb) {
+  Vtb_loadstore_w_store_buffer * core = tb->core;
+  core->testcase = T_FORWARD_WAIT;
+
+  // The following actions are performed in this test :
+  //    tick 0. Set the inputs to request a SB
+  //    tick 1. Set the inputs to request a LW on the same word (core waits for the drain)
+  //    tick 2. Acknowledge the drained store
+  //    tick 3. Nothing (core requests the load)
+  //    tick 4. Acknowledge the load
+  //    tick 5. Nothing (core outputs the load)
+
+  tb->reset();
+
+  core->input_valid_i = 1;
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  uint32_t addr = rand() & ~0x3;
+  uint32_t byte = rand() & 0xFF;
+  tb->_store(addr, 0x1, byte);
+
+  //=================================
+  //      Tick (0)
+
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  uint32_t reg_addr = 1 + rand() % 31;
+  tb->_load(addr, 0xF, 0, reg_addr);
+
+  //=================================
+  //      Tick (1)
+
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_state,         (core->tb_loadstore_w_store_buffer->dut->state_q  ==  5));
+  tb->check(COND_input_ready,   (core->input_ready_o         ==  0));
+  tb->check(COND_wishbone,      (core->wb_adr_o              ==  addr) &&
+                                (core->wb_dat_o              ==  byte) &&
+                                (core->wb_we_o               ==  1)    &&
+                                (core->wb_sel_o              ==  0x1)  &&
+                                (core->wb_stb_o              ==  1)    &&
+                                (core->wb_cyc_o              ==  1));
+  tb->check(COND_output_valid,  (core->output_valid_o        ==  0));
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  tb->_nop();
+  core->wb_ack_i = 1;
+
+  //=================================
+  //      Tick (2)
+
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_state,         (core->tb_loadstore_w_store_buffer->dut->state_q  ==  5));
+  tb->check(COND_input_ready,   (core->input_ready_o         ==  0));
+  tb->check(COND_wishbone,      (core->wb_stb_o              ==  0)    &&
+                                (core->wb_cyc_o              ==  0));
+  tb->check(COND_output_valid,  (core->output_valid_o        ==  0));
+  tb->check(COND_buffer,        (core->tb_loadstore_w_store_buffer->dut->sb_count_q  ==  0));
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  core->wb_ack_i = 0;
+
+  //=================================
+  //      Tick (3)
+
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_state,         (core->tb_loadstore_w_store_buffer->dut->state_q  ==  1));
+  tb->check(COND_input_ready,   (core->input_ready_o         ==  0));
+  tb->check(COND_wishbone,      (core->wb_adr_o              ==  addr) &&
+                                (core->wb_we_o               ==  0)    &&
+                                (core->wb_sel_o              ==  0xF)  &&
+                                (core->wb_stb_o              ==  1)    &&
+                                (core->wb_cyc_o              ==  1));
+  tb->check(COND_output_valid,  (core->output_valid_o        ==  0));
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  uint32_t data = rand();
+  core->wb_ack_i = 1;
+  core->wb_dat_i = data;
+
+  //=================================
+  //      Tick (4)
+
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_state,         (core->tb_loadstore_w_store_buffer->dut->state_q  ==  3));
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  core->wb_ack_i = 0;
+  core->wb_dat_i = 0;
+
+  //=================================
+  //      Tick (5)
+
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_state,         (core->tb_loadstore_w_store_buffer->dut->state_q  ==  0));
+  tb->check(COND_input_ready,   (core->input_ready_o         ==  1));
+  tb->check(COND_wishbone,      (core->wb_stb_o              ==  0)    &&
+                                (core->wb_cyc_o              ==  0));
+  tb->check(COND_register,      (core->reg_write_o           ==  1)    &&
+                                (core->reg_addr_o            ==  reg_addr) &&
+                                (core->reg_data_o            ==  data));
+  tb->check(COND_output_valid,  (core->output_valid_o        ==  1));
+
+  //`````````````````````````````````
+  //      Formal Checks
+
+  CHECK("tb_loadstore_w_store_buffer.forward_wait.01",
+      tb->conditions[COND_state],
+      "Failed to implement the state machine", tb->err_cycles[COND_state]);
+
+  CHECK("tb_loadstore_w_store_buffer.forward_wait.02",
+      tb->conditions[COND_input_ready],
+      "Failed to implement the input_ready_o signal", tb->err_cycles[COND_input_ready]);
+
+  CHECK("tb_loadstore_w_store_buffer.forward_wait.03",
+      tb->conditions[COND_wishbone],
+      "Failed to perform the load after draining the store buffer", tb->err_cycles[COND_wishbone]);
+
+  CHECK("tb_loadstore_w_store_buffer.forward_wait.04",
+      tb->conditions[COND_register],
+      "Failed to implement the register protocol", tb->err_cycles[COND_register]);
+
+  CHECK("tb_loadstore_w_store_buffer.forward_wait.05",
+      tb->conditions[COND_output_valid],
+      "Failed to implement the output_valid_o signal", tb->err_cycles[COND_output_valid]);
+
+  CHECK("tb_loadstore_w_store_buffer.forward_wait.06",
+      tb->conditions[COND_buffer],
+      "Failed to implement the store buffer", tb->err_cycles[COND_buffer]);
+}
+
+void tb_loadstore_w_store_buffer_buffer_full(TB_Loadstore_w_store_buffer * tb) {
+  Vtb_loadstore_w_store_buffer * core = tb->core;
+  core->testcase = T_BUFFER_FULL;
+
+  // The following actions are performed in this test :
+  //    tick 0..N-1. Set the inputs to request N SW
+  //    tick N.      Set the inputs to request a SW (core waits for a free entry)
+  //    tick N+1.    Acknowledge the drained store
+  //    tick N+2.    Nothing (core pushes the store)
+  //    tick N+3.    Nothing (core outputs the store)
+
+  tb->reset();
+
+  core->input_valid_i = 1;
+
+  uint32_t depth = core->tb_loadstore_w_store_buffer->STORE_BUFFER_DEPTH;
+  uint32_t addr = rand() & ~0x3;
+
+  for(uint32_t i = 0; i < depth; i++) {
+    //`````````````````````````````````
+    //      Set inputs
+
+    tb->_store(addr + 4 * i, 0xF, rand());
+
+    //=================================
+    //      Tick (0..N-1)
+
+    tb->tick();
+
+    //`````````````````````````````````
+    //      Checks
+
+    tb->check(COND_state,         (core->tb_loadstore_w_store_buffer->dut->state_q  ==  0));
+    tb->check(COND_input_ready,   (core->input_ready_o         ==  1));
+    tb->check(COND_output_valid,  (core->output_valid_o        ==  1));
+  }
+
+  tb->check(COND_buffer,        (core->tb_loadstore_w_store_buffer->dut->sb_count_q  ==  depth));
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  tb->_store(addr + 4 * depth, 0xF, rand());
+
+  //=================================
+  //      Tick (N)
+
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_state,         (core->tb_loadstore_w_store_buffer->dut->state_q  ==  5));
+  tb->check(COND_input_ready,   (core->input_ready_o         ==  0));
+  tb->check(COND_wishbone,      (core->wb_adr_o              ==  addr) &&
+                                (core->wb_we_o               ==  1)    &&
+                                (core->wb_cyc_o              ==  1));
+  tb->check(COND_output_valid,  (core->output_valid_o        ==  0));
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  tb->_nop();
+  core->wb_ack_i = 1;
+
+  //=================================
+  //      Tick (N+1)
+
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_state,         (core->tb_loadstore_w_store_buffer->dut->state_q  ==  5));
+  tb->check(COND_buffer,        (core->tb_loadstore_w_store_buffer->dut->sb_count_q  ==  depth - 1));
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  core->wb_ack_i = 0;
+
+  //=================================
+  //      Tick (N+2)
+
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_state,         (core->tb_loadstore_w_store_buffer->dut->state_q  ==  3));
+  tb->check(COND_buffer,        (core->tb_loadstore_w_store_buffer->dut->sb_count_q  ==  depth));
+  // The next entry is drained
+  tb->check(COND_wishbone,      (core->wb_adr_o              ==  addr + 4) &&
+                                (core->wb_we_o               ==  1)    &&
+                                (core->wb_cyc_o              ==  1));
+
+  //=================================
+  //      Tick (N+3)
+
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_state,         (core->tb_loadstore_w_store_buffer->dut->state_q  ==  0));
+  tb->check(COND_input_ready,   (core->input_ready_o         ==  1));
+  tb->check(COND_output_valid,  (core->output_valid_o        ==  1));
+
+  //`````````````````````````````````
+  //      Formal Checks
+
+  CHECK("tb_loadstore_w_store_buffer.buffer_full.01",
+      tb->conditions[COND_state],
+      "Failed to implement the state machine", tb->err_cycles[COND_state]);
+
+  CHECK("tb_loadstore_w_store_buffer.buffer_full.02",
+      tb->conditions[COND_input_ready],
+      "Failed to implement the input_ready_o signal", tb->err_cycles[COND_input_ready]);
+
+  CHECK("tb_loadstore_w_store_buffer.buffer_full.03",
+      tb->conditions[COND_wishbone],
+      "Failed to drain the store buffer in order", tb->err_cycles[COND_wishbone]);
+
+  CHECK("tb_loadstore_w_store_buffer.buffer_full.04",
+      tb->conditions[COND_output_valid],
+      "Failed to implement the output_valid_o signal", tb->err_cycles[COND_output_valid]);
+
+  CHECK("tb_loadstore_w_store_buffer.buffer_full.05",
+      tb->conditions[COND_buffer],
+      "Failed to implement the store buffer", tb->err_cycles[COND_buffer]);
+}
+
+int main(int argc, char ** argv, char ** env) {
+  srand(time(NULL));
+  Verilated::traceEverOn(true);
+
+  bool verbose = parse_verbose(argc, argv);
+
+  TB_Loadstore_w_store_buffer * tb = new TB_Loadstore_w_store_buffer;
+  tb->open_trace("waves/loadstore_w_store_buffer.vcd");
+  tb->open_testdata("testdata/loadstore_w_store_buffer.csv");
+  tb->set_debug_log(verbose);
+  tb->init_conditions(__CondIdEnd);
+
+  /************************************************************/
+
+  tb_loadstore_w_store_buffer_reset(tb);
+
+  tb_loadstore_w_store_buffer_store_retire(tb);
+
+  tb_loadstore_w_store_buffer_forward(tb);
+  tb_loadstore_w_store_buffer_forward_wait(tb);
+
+  tb_loadstore_w_store_buffer_buffer_full(tb);
+
+  /************************************************************/
+
+  printf("[LOADSTORE_W_STORE_BUFFER]: ");
+  if(tb->success) {
+    printf("Done\n");
+  } else {
+    printf("Failed\n");
+  }
+
+  delete tb;
+  exit(EXIT_SUCCESS);
+}
@@ -39,6 +39,8 @@ module tb_memory import ecap5_dproc_pkg::*;
   output  logic        s1_wb_ack_o,
   input   logic        s1_wb_cyc_i,
   output  logic        s1_wb_stall_o,
+  input   logic[2:0]   s1_wb_cti_i,
+  input   logic[1:0]   s1_wb_bte_i,
   
   //=================================
   //    Slave port 2
@@ -52,6 +54,8 @@ module tb_memory import ecap5_dproc_pkg::*;
   output  logic        s2_wb_ack_o,
   input   logic        s2_wb_cyc_i,
   output  logic        s2_wb_stall_o,
+  input   logic[2:0]   s2_wb_cti_i,
+  input   logic[1:0]   s2_wb_bte_i,
 
   //=================================
   //    Master port
@@ -64,7 +68,9 @@ module tb_memory import ecap5_dproc_pkg::*;
   output  logic        m_wb_stb_o,
   input   logic        m_wb_ack_i,
   output  logic        m_wb_cyc_o,
-  input   logic        m_wb_stall_i
+  input   logic        m_wb_stall_i,
+  output  logic[2:0]   m_wb_cti_o,
+  output  logic[1:0]   m_wb_bte_o
 );
 
 memory dut (
@@ -79,6 +85,8 @@ memory dut (
   .s1_wb_ack_o   (s1_wb_ack_o),
   .s1_wb_cyc_i   (s1_wb_cyc_i),
   .s1_wb_stall_o (s1_wb_stall_o),
+  .s1_wb_cti_i   (s1_wb_cti_i),
+  .s1_wb_bte_i   (s1_wb_bte_i),
 
   .s2_wb_adr_i   (s2_wb_adr_i),
   .s2_wb_dat_o   (s2_wb_dat_o),
@@ -89,6 +97,8 @@ memory dut (
   .s2_wb_ack_o   (s2_wb_ack_o),
   .s2_wb_cyc_i   (s2_wb_cyc_i),
   .s2_wb_stall_o (s2_wb_stall_o),
+  .s2_wb_cti_i   (s2_wb_cti_i),
+  .s2_wb_bte_i   (s2_wb_bte_i),
 
   .m_wb_adr_o    (m_wb_adr_o),
   .m_wb_dat_i    (m_wb_dat_i),
@@ -98,7 +108,9 @@ memory dut (
   .m_wb_stb_o    (m_wb_stb_o),
   .m_wb_ack_i    (m_wb_ack_i),
   .m_wb_cyc_o    (m_wb_cyc_o),
-  .m_wb_stall_i  (m_wb_stall_i)
+  .m_wb_stall_i  (m_wb_stall_i),
+  .m_wb_cti_o    (m_wb_cti_o),
+  .m_wb_bte_o    (m_wb_bte_o)
 );
 
 endmodule // tb_memory
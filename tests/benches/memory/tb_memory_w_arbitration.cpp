@@ -0,0 +1,616 @@
+/*           __        _
+ *  ________/ /  ___ _(_)__  ___
+ * / __/ __/ _ \/ _ `/ / _ \/ -_)
+ * \__/\__/_//_/\_,_/_/_//_/\__/
+ * 
+ * Copyright (C) Clément Chaine
+ * This file is part of ECAP5-DPROC <https://github.com/ecap5/ECAP5-DPROC>
+ *
+ * ECAP5-DPROC is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ECAP5-DPROC is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ECAP5-DPROC.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <verilated.h>
+#include <verilated_vcd_c.h>
+#include <svdpi.h>
+#include <deque>
+#include <vector>
+
+#include "Vtb_memory_w_arbitration.h"
+#include "testbench.h"
+#include "wishbone_master.h"
+#include "wishbone_slave.h"
+#include "Vtb_memory_w_arbitration_ecap5_dproc_pkg.h"
+
+enum CondId {
+  COND_s1_stall,
+  COND_s2_stall,
+  COND_data,
+  COND_order,
+  COND_latency,
+  __CondIdEnd
+};
+
+enum TestcaseId {
+  T_RESET           =  1,
+  T_FETCH_PRIORITY  =  2,
+  T_DATA_PRIORITY   =  3,
+  T_ROUND_ROBIN     =  4,
+  T_LOAD_PRIORITY   =  5,
+  T_WAIT_CYCLES     =  6
+};
+
+// Accesses started during the same cycle on one or both ports
+struct Round {
+  bool s1, s2;
+  WishboneAccess s1_access, s2_access;
+};
+
+class TB_Memory : public Testbench<Vtb_memory_w_arbitration> {
+public:
+  WishboneMaster s1, s2;
+  // Pipelined wishbone slave model of the memory
+  WishboneSlave<WishboneAccess> slave;
+  uint32_t cycle;
+  // Requests received by the memory
+  std::vector<WishboneAccess> transfers;
+  std::vector<Round> rounds;
+  bool verbose;
+
+  void reset() {
+    this->s1.clear();
+    this->s2.clear();
+    this->slave.latency = 0;
+    this->slave.random_stall = false;
+    this->cycle = 0;
+    this->drive();
+    this->core->m_wb_dat_i = 0;
+    this->core->m_wb_ack_i = 0;
+    this->core->m_wb_stall_i = 0;
+
+    this->core->rst_i = 1;
+    for(int i = 0; i < 5; i++) {
+      Testbench<Vtb_memory_w_arbitration>::tick();
+    }
+    this->core->rst_i = 0;
+
+    this->slave.clear();
+    this->transfers.clear();
+    this->rounds.clear();
+
+    Testbench<Vtb_memory_w_arbitration>::reset();
+  }
+
+  static uint32_t memory(uint32_t adr) {
+    return (adr * 2654435761u) ^ 0xECA50000;
+  }
+
+  void drive() {
+    this->core->s1_wb_adr_i = this->s1.adr();
+    this->core->s1_wb_dat_i = this->s1.dat();
+    this->core->s1_wb_we_i  = this->s1.we();
+    this->core->s1_wb_sel_i = this->s1.sel();
+    this->core->s1_wb_stb_i = this->s1.stb;
+    this->core->s1_wb_cyc_i = this->s1.cyc();
+
+    this->core->s2_wb_adr_i = this->s2.adr();
+    this->core->s2_wb_dat_i = this->s2.dat();
+    this->core->s2_wb_we_i  = this->s2.we();
+    this->core->s2_wb_sel_i = this->s2.sel();
+    this->core->s2_wb_stb_i = this->s2.stb;
+    this->core->s2_wb_cyc_i = this->s2.cyc();
+  }
+
+  void tick() {
+    this->s1.start(this->cycle);
+    this->s2.start(this->cycle);
+    this->drive();
+    this->core->m_wb_ack_i = 0;
+    this->core->m_wb_dat_i = 0;
+    this->core->eval();
+
+    WishboneAccess request = {(bool)this->core->m_wb_we_o, this->core->m_wb_adr_o,
+                              this->core->m_wb_dat_o, this->core->m_wb_sel_o};
+    if(this->slave.accept(this->cycle, this->core->m_wb_stb_o, this->core->m_wb_cyc_o, this->core->m_wb_stall_i,
+                          request)) {
+      this->transfers.push_back(request);
+    }
+    WishboneAccess access;
+    if(this->slave.respond(this->cycle, access)) {
+      this->core->m_wb_ack_i = 1;
+      this->core->m_wb_dat_i = access.we ? 0 : memory(access.adr);
+    }
+    this->core->eval();
+
+    this->s1.sample(this->cycle, this->core->s1_wb_stall_o, this->core->s1_wb_ack_o, this->core->s1_wb_dat_o);
+    this->s2.sample(this->cycle, this->core->s2_wb_stall_o, this->core->s2_wb_ack_o, this->core->s2_wb_dat_o);
+
+    Testbench<Vtb_memory_w_arbitration>::tick();
+    this->cycle += 1;
+
+    this->s1.update();
+    this->s2.update();
+    this->core->m_wb_stall_i = this->slave.stall();
+  }
+
+  void run(uint32_t cycles) {
+    for(uint32_t i = 0; i < cycles; i++) {
+      this->tick();
+    }
+  }
+
+  static WishboneAccess random_access() {
+    WishboneAccess access;
+    access.we = rand() % 2;
+    access.adr = rand();
+    access.dat = rand();
+    access.sel = 0xF;
+    return access;
+  }
+
+  // Starts the accesses of a round during the same cycle and waits for the
+  // arbiter to be idle again
+  void run_round(bool s1, bool s2, WishboneAccess s1_access, WishboneAccess s2_access) {
+    if(s1) {
+      this->s1.queue.push_back(s1_access);
+    }
+    if(s2) {
+      this->s2.queue.push_back(s2_access);
+    }
+    this->rounds.push_back({s1, s2, s1_access, s2_access});
+    this->run(20);
+  }
+
+  /*
+   * Checks the port served first during each round with both ports, the
+   * expected port being computed from the arbitration policy. The first port
+   * is forwarded immediately when it is port 1, or after the switching cycle
+   * otherwise.
+   */
+  void check_rounds(uint8_t policy, bool & order, bool & latency) {
+    size_t s1_index = 0, s2_index = 0;
+    // Port of the last forwarded request, port 2 after reset
+    uint8_t last = 1;
+    order = true;
+    latency = true;
+    for(size_t i = 0; i < this->rounds.size(); i++) {
+      const Round & round = this->rounds[i];
+      if(round.s1 && round.s2) {
+        if((s1_index >= this->s1.completions.size()) || (s2_index >= this->s2.completions.size())) {
+          order = false;
+          latency = false;
+          return;
+        }
+        const WishboneCompletion & c1 = this->s1.completions[s1_index++];
+        const WishboneCompletion & c2 = this->s2.completions[s2_index++];
+
+        uint8_t expected = 0;
+        if(policy == Vtb_memory_w_arbitration_ecap5_dproc_pkg::ARBITRATION_DATA) {
+          expected = 1;
+        } else if(policy == Vtb_memory_w_arbitration_ecap5_dproc_pkg::ARBITRATION_ROUND_ROBIN) {
+          expected = !last;
+        } else if(policy == Vtb_memory_w_arbitration_ecap5_dproc_pkg::ARBITRATION_LOAD) {
+          expected = !round.s2_access.we;
+        }
+        uint8_t first = (c1.cycle < c2.cycle) ? 0 : 1;
+        if(first != expected) {
+          order = false;
+        }
+        if(( expected && (c2.wait != this->slave.latency + 1)) ||
+           (!expected && (c1.wait != this->slave.latency))) {
+          latency = false;
+        }
+        last = !first;
+      } else if(round.s1) {
+        s1_index += 1;
+        last = 0;
+      } else if(round.s2) {
+        s2_index += 1;
+        last = 1;
+      }
+    }
+  }
+
+  // Checks that every access of the port was completed with the memory data
+  bool completions_match(WishboneMaster & port, size_t count) {
+    if((port.completions.size() != count) || (port.unexpected_acks != 0)) {
+      return false;
+    }
+    for(size_t i = 0; i < port.completions.size(); i++) {
+      const WishboneCompletion & c = port.completions[i];
+      if(!c.access.we && (c.dat != memory(c.access.adr))) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // Checks that the memory received the accesses of both ports unmodified
+  bool transfers_match() {
+    if(this->transfers.size() != this->s1.completions.size() + this->s2.completions.size()) {
+      return false;
+    }
+    for(size_t i = 0; i < this->transfers.size(); i++) {
+      bool found = false;
+      for(WishboneMaster * port : {&this->s1, &this->s2}) {
+        for(size_t j = 0; j < port->completions.size(); j++) {
+          const WishboneAccess & a = port->completions[j].access;
+          if((a.adr == this->transfers[i].adr) && (a.we == this->transfers[i].we) &&
+             (a.sel == this->transfers[i].sel) && (!a.we || (a.dat == this->transfers[i].dat))) {
+            found = true;
+          }
+        }
+      }
+      if(!found) {
+        return false;
+      }
+    }
+    return true;
+  }
+};
+
+void tb_memory_reset(TB_Memory * tb) {
+  Vtb_memory_w_arbitration * core = tb->core;
+  core->testcase = T_RESET;
+
+  //=================================
+  //      Tick (0)
+
+  core->arbitration = Vtb_memory_w_arbitration_ecap5_dproc_pkg::ARBITRATION_FETCH;
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_s1_stall, (core->s1_wb_stall_o == 0));
+  tb->check(COND_s2_stall, (core->s2_wb_stall_o == 1));
+
+  //`````````````````````````````````
+  //      Formal Checks
+
+  CHECK("tb_memory_w_arbitration.reset.01",
+      tb->conditions[COND_s1_stall],
+      "Failed to implement s1 stalling", tb->err_cycles[COND_s1_stall]);
+
+  CHECK("tb_memory_w_arbitration.reset.02",
+      tb->conditions[COND_s2_stall],
+      "Failed to implement s2 stalling", tb->err_cycles[COND_s2_stall]);
+}
+
+void tb_memory_fetch_priority(TB_Memory * tb) {
+  Vtb_memory_w_arbitration * core = tb->core;
+  core->testcase = T_FETCH_PRIORITY;
+
+  // The following actions are performed in this test :
+  //    tick 0-159. Perform simultaneous accesses on both ports every 20
+  //                cycles (core serves port 1 first)
+
+  //=================================
+  //      Tick (0)
+
+  core->arbitration = Vtb_memory_w_arbitration_ecap5_dproc_pkg::ARBITRATION_FETCH;
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  tb->slave.latency = rand() % 4;
+
+  //=================================
+  //      Tick (0-159)
+
+  const uint32_t count = 8;
+  for(uint32_t i = 0; i < count; i++) {
+    tb->run_round(true, true, TB_Memory::random_access(), TB_Memory::random_access());
+  }
+
+  //`````````````````````````````````
+  //      Checks
+
+  bool order, latency;
+  tb->check_rounds(Vtb_memory_w_arbitration_ecap5_dproc_pkg::ARBITRATION_FETCH, order, latency);
+  tb->check(COND_data,     tb->completions_match(tb->s1, count) &&
+                           tb->completions_match(tb->s2, count) &&
+                           tb->transfers_match());
+  tb->check(COND_order,    order);
+  tb->check(COND_latency,  latency);
+
+  //`````````````````````````````````
+  //      Formal Checks
+
+  CHECK("tb_memory_w_arbitration.fetch_priority.01",
+      tb->conditions[COND_data],
+      "Failed to route the requests", tb->err_cycles[COND_data]);
+
+  CHECK("tb_memory_w_arbitration.fetch_priority.02",
+      tb->conditions[COND_order],
+      "Failed to serve port 1 first", tb->err_cycles[COND_order]);
+
+  CHECK("tb_memory_w_arbitration.fetch_priority.03",
+      tb->conditions[COND_latency],
+      "Failed to forward the request of port 1 immediately", tb->err_cycles[COND_latency]);
+}
+
+void tb_memory_data_priority(TB_Memory * tb) {
+  Vtb_memory_w_arbitration * core = tb->core;
+  core->testcase = T_DATA_PRIORITY;
+
+  // The following actions are performed in this test :
+  //    tick 0-159. Perform simultaneous accesses on both ports every 20
+  //                cycles (core serves port 2 first)
+
+  //=================================
+  //      Tick (0)
+
+  core->arbitration = Vtb_memory_w_arbitration_ecap5_dproc_pkg::ARBITRATION_DATA;
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  tb->slave.latency = rand() % 4;
+
+  //=================================
+  //      Tick (0-159)
+
+  const uint32_t count = 8;
+  for(uint32_t i = 0; i < count; i++) {
+    tb->run_round(true, true, TB_Memory::random_access(), TB_Memory::random_access());
+  }
+
+  //`````````````````````````````````
+  //      Checks
+
+  bool order, latency;
+  tb->check_rounds(Vtb_memory_w_arbitration_ecap5_dproc_pkg::ARBITRATION_DATA, order, latency);
+  tb->check(COND_data,     tb->completions_match(tb->s1, count) &&
+                           tb->completions_match(tb->s2, count) &&
+                           tb->transfers_match());
+  tb->check(COND_order,    order);
+  tb->check(COND_latency,  latency);
+
+  //`````````````````````````````````
+  //      Formal Checks
+
+  CHECK("tb_memory_w_arbitration.data_priority.01",
+      tb->conditions[COND_data],
+      "Failed to route the requests", tb->err_cycles[COND_data]);
+
+  CHECK("tb_memory_w_arbitration.data_priority.02",
+      tb->conditions[COND_order],
+      "Failed to serve port 2 first", tb->err_cycles[COND_order]);
+
+  CHECK("tb_memory_w_arbitration.data_priority.03",
+      tb->conditions[COND_latency],
+      "Failed to forward the request of port 2 after a single switching cycle", tb->err_cycles[COND_latency]);
+}
+
+void tb_memory_round_robin(TB_Memory * tb) {
+  Vtb_memory_w_arbitration * core = tb->core;
+  core->testcase = T_ROUND_ROBIN;
+
+  // The following actions are performed in this test :
+  //    tick 0-639. Perform accesses on port 1, port 2 or both ports every 20
+  //                cycles (core serves first the port which wasn't served
+  //                last)
+
+  //=================================
+  //      Tick (0)
+
+  core->arbitration = Vtb_memory_w_arbitration_ecap5_dproc_pkg::ARBITRATION_ROUND_ROBIN;
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  tb->slave.latency = rand() % 4;
+
+  //=================================
+  //      Tick (0-639)
+
+  uint32_t s1_count = 0, s2_count = 0;
+  for(uint32_t i = 0; i < 32; i++) {
+    uint32_t ports = 1 + rand() % 3;
+    bool s1 = ports & 1;
+    bool s2 = ports & 2;
+    tb->run_round(s1, s2, TB_Memory::random_access(), TB_Memory::random_access());
+    s1_count += s1;
+    s2_count += s2;
+  }
+
+  //`````````````````````````````````
+  //      Checks
+
+  bool order, latency;
+  tb->check_rounds(Vtb_memory_w_arbitration_ecap5_dproc_pkg::ARBITRATION_ROUND_ROBIN, order, latency);
+  tb->check(COND_data,     tb->completions_match(tb->s1, s1_count) &&
+                           tb->completions_match(tb->s2, s2_count) &&
+                           tb->transfers_match());
+  tb->check(COND_order,    order);
+  tb->check(COND_latency,  latency);
+
+  //`````````````````````````````````
+  //      Formal Checks
+
+  CHECK("tb_memory_w_arbitration.round_robin.01",
+      tb->conditions[COND_data],
+      "Failed to route the requests", tb->err_cycles[COND_data]);
+
+  CHECK("tb_memory_w_arbitration.round_robin.02",
+      tb->conditions[COND_order],
+      "Failed to serve first the port which wasn't served last", tb->err_cycles[COND_order]);
+
+  CHECK("tb_memory_w_arbitration.round_robin.03",
+      tb->conditions[COND_latency],
+      "Failed to forward the request of the first port", tb->err_cycles[COND_latency]);
+}
+
+void tb_memory_load_priority(TB_Memory * tb) {
+  Vtb_memory_w_arbitration * core = tb->core;
+  core->testcase = T_LOAD_PRIORITY;
+
+  // The following actions are performed in this test :
+  //    tick 0-319. Perform simultaneous accesses on both ports every 20
+  //                cycles (core serves port 2 first on reads and port 1
+  //                first on writes)
+
+  //=================================
+  //      Tick (0)
+
+  core->arbitration = Vtb_memory_w_arbitration_ecap5_dproc_pkg::ARBITRATION_LOAD;
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  tb->slave.latency = rand() % 4;
+
+  //=================================
+  //      Tick (0-319)
+
+  const uint32_t count = 16;
+  for(uint32_t i = 0; i < count; i++) {
+    tb->run_round(true, true, TB_Memory::random_access(), TB_Memory::random_access());
+  }
+
+  //`````````````````````````````````
+  //      Checks
+
+  bool order, latency;
+  tb->check_rounds(Vtb_memory_w_arbitration_ecap5_dproc_pkg::ARBITRATION_LOAD, order, latency);
+  tb->check(COND_data,     tb->completions_match(tb->s1, count) &&
+                           tb->completions_match(tb->s2, count) &&
+                           tb->transfers_match());
+  tb->check(COND_order,    order);
+  tb->check(COND_latency,  latency);
+
+  //`````````````````````````````````
+  //      Formal Checks
+
+  CHECK("tb_memory_w_arbitration.load_priority.01",
+      tb->conditions[COND_data],
+      "Failed to route the requests", tb->err_cycles[COND_data]);
+
+  CHECK("tb_memory_w_arbitration.load_priority.02",
+      tb->conditions[COND_order],
+      "Failed to serve the reads of port 2 first", tb->err_cycles[COND_order]);
+
+  CHECK("tb_memory_w_arbitration.load_priority.03",
+      tb->conditions[COND_latency],
+      "Failed to forward the request of the first port", tb->err_cycles[COND_latency]);
+}
+
+void tb_memory_wait_cycles(TB_Memory * tb) {
+  Vtb_memory_w_arbitration * core = tb->core;
+  core->testcase = T_WAIT_CYCLES;
+
+  // The following actions are performed in this test, for each arbitration
+  // policy :
+  //    tick 0. Perform the same random accesses on both ports, separated by
+  //            random gaps, on a slow and stalling memory
+  //    tick 1-1999. Nothing (the wait cycles of each port are measured)
+
+  const uint32_t count = 64;
+  std::vector<WishboneAccess> s1_accesses, s2_accesses;
+  for(uint32_t i = 0; i < count; i++) {
+    s1_accesses.push_back(TB_Memory::random_access());
+    s2_accesses.push_back(TB_Memory::random_access());
+  }
+  const uint32_t latency = rand() % 4;
+
+  bool data = true;
+  const char * names[4] = {"fetch", "data", "round-robin", "load"};
+  for(uint8_t policy = 0; policy < 4; policy++) {
+    //=================================
+    //      Tick (0)
+
+    core->arbitration = policy;
+    tb->reset();
+
+    //`````````````````````````````````
+    //      Set inputs
+
+    tb->slave.latency = latency;
+    tb->slave.random_stall = true;
+    tb->s1.max_gap = 3;
+    tb->s2.max_gap = 3;
+    tb->s1.queue.assign(s1_accesses.begin(), s1_accesses.end());
+    tb->s2.queue.assign(s2_accesses.begin(), s2_accesses.end());
+
+    //=================================
+    //      Tick (1-1999)
+
+    tb->run(2000);
+
+    //`````````````````````````````````
+    //      Checks
+
+    data = data && tb->completions_match(tb->s1, count) &&
+                   tb->completions_match(tb->s2, count) &&
+                   tb->transfers_match();
+
+    if(tb->verbose) {
+      printf("  %-12s port 1 : %5d wait cycles, port 2 : %5d wait cycles\n",
+          names[policy], tb->s1.total_wait(), tb->s2.total_wait());
+    }
+  }
+
+  tb->check(COND_data, data);
+
+  //`````````````````````````````````
+  //      Formal Checks
+
+  CHECK("tb_memory_w_arbitration.wait_cycles.01",
+      tb->conditions[COND_data],
+      "Failed to route the requests", tb->err_cycles[COND_data]);
+}
+
+int main(int argc, char ** argv, char ** env) {
+  srand(time(NULL));
+  Verilated::traceEverOn(true);
+
+  bool verbose = parse_verbose(argc, argv);
+
+  TB_Memory * tb = new TB_Memory;
+  tb->open_trace("waves/memory_w_arbitration.vcd");
+  tb->open_testdata("testdata/memory_w_arbitration.csv");
+  tb->set_debug_log(verbose);
+  tb->init_conditions(__CondIdEnd);
+  tb->verbose = verbose;
+
+  /************************************************************/
+
+  tb_memory_reset(tb);
+
+  tb_memory_fetch_priority(tb);
+  tb_memory_data_priority(tb);
+  tb_memory_round_robin(tb);
+  tb_memory_load_priority(tb);
+
+  tb_memory_wait_cycles(tb);
+
+  /************************************************************/
+
+  printf("[MEMORY_W_ARBITRATION]: ");
+  if(tb->success) {
+    printf("Done\n");
+  } else {
+    printf("Failed\n");
+  }
+
+  delete tb;
+  exit(EXIT_SUCCESS);
+}
@@ -0,0 +1,160 @@
+/*           __        _
+ *  ________/ /  ___ _(_)__  ___
+ * / __/ __/ _ \/ _ `/ / _ \/ -_)
+ * \__/\__/_//_/\_,_/_/_//_/\__/
+ * 
+ * Copyright (C) Clément Chaine
+ * This file is part of ECAP5-DPROC <https://github.com/ecap5/ECAP5-DPROC>
+ *
+ * ECAP5-DPROC is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ECAP5-DPROC is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ECAP5-DPROC.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+module tb_memory_w_arbitration import ecap5_dproc_pkg::*;
+(
+  input   int          testcase,
+  // Arbitration policy of the observed memory module
+  input   logic[1:0]   arbitration,
+
+  input   logic        clk_i,
+  input   logic        rst_i,
+
+  //=================================
+  //    Slave port 1
+  
+  input   logic[31:0]  s1_wb_adr_i,
+  output  logic[31:0]  s1_wb_dat_o,
+  input   logic[31:0]  s1_wb_dat_i,
+  input   logic        s1_wb_we_i,
+  input   logic[3:0]   s1_wb_sel_i,
+  input   logic        s1_wb_stb_i,
+  output  logic        s1_wb_ack_o,
+  input   logic        s1_wb_cyc_i,
+  output  logic        s1_wb_stall_o,
+  input   logic[2:0]   s1_wb_cti_i,
+  input   logic[1:0]   s1_wb_bte_i,
+  
+  //=================================
+  //    Slave port 2
+  
+  input   logic[31:0]  s2_wb_adr_i,
+  output  logic[31:0]  s2_wb_dat_o,
+  input   logic[31:0]  s2_wb_dat_i,
+  input   logic        s2_wb_we_i,
+  input   logic[3:0]   s2_wb_sel_i,
+  input   logic        s2_wb_stb_i,
+  output  logic        s2_wb_ack_o,
+  input   logic        s2_wb_cyc_i,
+  output  logic        s2_wb_stall_o,
+  input   logic[2:0]   s2_wb_cti_i,
+  input   logic[1:0]   s2_wb_bte_i,
+
+  //=================================
+  //    Master port
+  
+  output  logic[31:0]  m_wb_adr_o,
+  input   logic[31:0]  m_wb_dat_i,
+  output  logic[31:0]  m_wb_dat_o,
+  output  logic        m_wb_we_o,
+  output  logic[3:0]   m_wb_sel_o,
+  output  logic        m_wb_stb_o,
+  input   logic        m_wb_ack_i,
+  output  logic        m_wb_cyc_o,
+  input   logic        m_wb_stall_i,
+  output  logic[2:0]   m_wb_cti_o,
+  output  logic[1:0]   m_wb_bte_o
+);
+
+// Outputs of the memory modules, one per arbitration policy
+logic[31:0]  s1_wb_dat    [4];
+logic        s1_wb_ack    [4];
+logic        s1_wb_stall  [4];
+logic[31:0]  s2_wb_dat    [4];
+logic        s2_wb_ack    [4];
+logic        s2_wb_stall  [4];
+logic[31:0]  m_wb_adr     [4];
+logic[31:0]  m_wb_dat     [4];
+logic        m_wb_we      [4];
+logic[3:0]   m_wb_sel     [4];
+logic        m_wb_stb     [4];
+logic        m_wb_cyc     [4];
+logic[2:0]   m_wb_cti     [4];
+logic[1:0]   m_wb_bte     [4];
+
+/*
+ * A memory module is instanciated for each arbitration policy, all of them
+ * receiving the same inputs. Only the outputs of the memory module selected
+ * by the arbitration input are observed.
+ */
+generate
+  for(genvar i = 0; i < 4; i++) begin : policy_gen
+    memory #(
+      .ARBITRATION   (2'(i))
+    ) dut (
+      .clk_i (clk_i),
+      .rst_i (rst_i),
+      .s1_wb_adr_i   (s1_wb_adr_i),
+      .s1_wb_dat_o   (s1_wb_dat[i]),
+      .s1_wb_dat_i   (s1_wb_dat_i),
+      .s1_wb_we_i    (s1_wb_we_i),
+      .s1_wb_sel_i   (s1_wb_sel_i),
+      .s1_wb_stb_i   (s1_wb_stb_i),
+      .s1_wb_ack_o   (s1_wb_ack[i]),
+      .s1_wb_cyc_i   (s1_wb_cyc_i),
+      .s1_wb_stall_o (s1_wb_stall[i]),
+      .s1_wb_cti_i   (s1_wb_cti_i),
+      .s1_wb_bte_i   (s1_wb_bte_i),
+
+      .s2_wb_adr_i   (s2_wb_adr_i),
+      .s2_wb_dat_o   (s2_wb_dat[i]),
+      .s2_wb_dat_i   (s2_wb_dat_i),
+      .s2_wb_we_i    (s2_wb_we_i),
+      .s2_wb_sel_i   (s2_wb_sel_i),
+      .s2_wb_stb_i   (s2_wb_stb_i),
+      .s2_wb_ack_o   (s2_wb_ack[i]),
+      .s2_wb_cyc_i   (s2_wb_cyc_i),
+      .s2_wb_stall_o (s2_wb_stall[i]),
+      .s2_wb_cti_i   (s2_wb_cti_i),
+      .s2_wb_bte_i   (s2_wb_bte_i),
+
+      .m_wb_adr_o    (m_wb_adr[i]),
+      .m_wb_dat_i    (m_wb_dat_i),
+      .m_wb_dat_o    (m_wb_dat[i]),
+      .m_wb_we_o     (m_wb_we[i]),
+      .m_wb_sel_o    (m_wb_sel[i]),
+      .m_wb_stb_o    (m_wb_stb[i]),
+      .m_wb_ack_i    (m_wb_ack_i),
+      .m_wb_cyc_o    (m_wb_cyc[i]),
+      .m_wb_stall_i  (m_wb_stall_i),
+      .m_wb_cti_o    (m_wb_cti[i]),
+      .m_wb_bte_o    (m_wb_bte[i])
+    );
+  end
+endgenerate
+
+assign s1_wb_dat_o   = s1_wb_dat[arbitration];
+assign s1_wb_ack_o   = s1_wb_ack[arbitration];
+assign s1_wb_stall_o = s1_wb_stall[arbitration];
+assign s2_wb_dat_o   = s2_wb_dat[arbitration];
+assign s2_wb_ack_o   = s2_wb_ack[arbitration];
+assign s2_wb_stall_o = s2_wb_stall[arbitration];
+assign m_wb_adr_o    = m_wb_adr[arbitration];
+assign m_wb_dat_o    = m_wb_dat[arbitration];
+assign m_wb_we_o     = m_wb_we[arbitration];
+assign m_wb_sel_o    = m_wb_sel[arbitration];
+assign m_wb_stb_o    = m_wb_stb[arbitration];
+assign m_wb_cyc_o    = m_wb_cyc[arbitration];
+assign m_wb_cti_o    = m_wb_cti[arbitration];
+assign m_wb_bte_o    = m_wb_bte[arbitration];
+
+endmodule // tb_memory_w_arbitration
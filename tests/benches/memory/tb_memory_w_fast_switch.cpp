@@ -0,0 +1,484 @@
+/*           __        _
+ *  ________/ /  ___ _(_)__  ___
+ * / __/ __/ _ \/ _ `/ / _ \/ -_)
+ * \__/\__/_//_/\_,_/_/_//_/\__/
+ * 
+ * Copyright (C) Clément Chaine
+ * This file is part of ECAP5-DPROC <https://github.com/ecap5/ECAP5-DPROC>
+ *
+ * ECAP5-DPROC is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ECAP5-DPROC is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ECAP5-DPROC.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <verilated.h>
+#include <verilated_vcd_c.h>
+#include <svdpi.h>
+#include <algorithm>
+#include <deque>
+#include <vector>
+
+#include "Vtb_memory_w_fast_switch.h"
+#include "testbench.h"
+#include "wishbone_master.h"
+#include "wishbone_slave.h"
+#include "Vtb_memory_w_fast_switch_ecap5_dproc_pkg.h"
+
+enum CondId {
+  COND_s1_stall,
+  COND_s2_stall,
+  COND_m_wb,
+  COND_data,
+  COND_latency,
+  COND_throughput,
+  __CondIdEnd
+};
+
+enum TestcaseId {
+  T_RESET        =  1,
+  T_PORT2_READ   =  2,
+  T_SWITCH       =  3,
+  T_CONTENTION   =  4,
+  T_MEMORY_WAIT  =  5
+};
+
+class TB_Memory : public Testbench<Vtb_memory_w_fast_switch> {
+public:
+  WishboneMaster s1, s2;
+  // Pipelined wishbone slave model of the memory
+  WishboneSlave<WishboneAccess> slave;
+  uint32_t cycle;
+  // Requests received by the memory
+  std::vector<WishboneAccess> transfers;
+  // Number of cycles during which a port was requesting while the master
+  // port was not performing any bus cycle
+  uint32_t dead_cycles;
+
+  void reset() {
+    this->s1.clear();
+    this->s2.clear();
+    this->slave.latency = 0;
+    this->slave.random_stall = false;
+    this->cycle = 0;
+    this->drive();
+    this->core->m_wb_dat_i = 0;
+    this->core->m_wb_ack_i = 0;
+    this->core->m_wb_stall_i = 0;
+
+    this->core->rst_i = 1;
+    for(int i = 0; i < 5; i++) {
+      Testbench<Vtb_memory_w_fast_switch>::tick();
+    }
+    this->core->rst_i = 0;
+
+    this->slave.clear();
+    this->transfers.clear();
+    this->dead_cycles = 0;
+
+    Testbench<Vtb_memory_w_fast_switch>::reset();
+  }
+
+  static uint32_t memory(uint32_t adr) {
+    return (adr * 2654435761u) ^ 0xECA50000;
+  }
+
+  void drive() {
+    this->core->s1_wb_adr_i = this->s1.adr();
+    this->core->s1_wb_dat_i = this->s1.dat();
+    this->core->s1_wb_we_i  = this->s1.we();
+    this->core->s1_wb_sel_i = this->s1.sel();
+    this->core->s1_wb_stb_i = this->s1.stb;
+    this->core->s1_wb_cyc_i = this->s1.cyc();
+
+    this->core->s2_wb_adr_i = this->s2.adr();
+    this->core->s2_wb_dat_i = this->s2.dat();
+    this->core->s2_wb_we_i  = this->s2.we();
+    this->core->s2_wb_sel_i = this->s2.sel();
+    this->core->s2_wb_stb_i = this->s2.stb;
+    this->core->s2_wb_cyc_i = this->s2.cyc();
+  }
+
+  void tick() {
+    this->s1.start(this->cycle);
+    this->s2.start(this->cycle);
+    this->drive();
+    this->core->m_wb_ack_i = 0;
+    this->core->m_wb_dat_i = 0;
+    this->core->eval();
+
+    WishboneAccess request = {(bool)this->core->m_wb_we_o, this->core->m_wb_adr_o,
+                              this->core->m_wb_dat_o, this->core->m_wb_sel_o};
+    if(this->slave.accept(this->cycle, this->core->m_wb_stb_o, this->core->m_wb_cyc_o, this->core->m_wb_stall_i,
+                          request)) {
+      this->transfers.push_back(request);
+    }
+    WishboneAccess access;
+    if(this->slave.respond(this->cycle, access)) {
+      this->core->m_wb_ack_i = 1;
+      this->core->m_wb_dat_i = access.we ? 0 : memory(access.adr);
+    }
+    this->core->eval();
+
+    bool s1_request = this->core->s1_wb_stb_i && this->core->s1_wb_cyc_i;
+    bool s2_request = this->core->s2_wb_stb_i && this->core->s2_wb_cyc_i;
+    if((s1_request || s2_request) && !this->core->m_wb_cyc_o) {
+      this->dead_cycles += 1;
+    }
+
+    this->s1.sample(this->cycle, this->core->s1_wb_stall_o, this->core->s1_wb_ack_o, this->core->s1_wb_dat_o);
+    this->s2.sample(this->cycle, this->core->s2_wb_stall_o, this->core->s2_wb_ack_o, this->core->s2_wb_dat_o);
+
+    Testbench<Vtb_memory_w_fast_switch>::tick();
+    this->cycle += 1;
+
+    this->s1.update();
+    this->s2.update();
+    this->core->m_wb_stall_i = this->slave.stall();
+  }
+
+  void run(uint32_t cycles) {
+    for(uint32_t i = 0; i < cycles; i++) {
+      this->tick();
+    }
+  }
+
+  static WishboneAccess random_access() {
+    WishboneAccess access;
+    access.we = rand() % 2;
+    access.adr = rand();
+    access.dat = rand();
+    access.sel = 0xF;
+    return access;
+  }
+
+  // Checks that every access of the port was completed with the memory data
+  bool completions_match(WishboneMaster & port, size_t count) {
+    if((port.completions.size() != count) || (port.unexpected_acks != 0)) {
+      return false;
+    }
+    for(size_t i = 0; i < port.completions.size(); i++) {
+      const WishboneCompletion & c = port.completions[i];
+      if(!c.access.we && (c.dat != memory(c.access.adr))) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // Checks that the memory received the accesses of both ports unmodified
+  bool transfers_match() {
+    if(this->transfers.size() != this->s1.completions.size() + this->s2.completions.size()) {
+      return false;
+    }
+    for(size_t i = 0; i < this->transfers.size(); i++) {
+      bool found = false;
+      for(WishboneMaster * port : {&this->s1, &this->s2}) {
+        for(size_t j = 0; j < port->completions.size(); j++) {
+          const WishboneAccess & a = port->completions[j].access;
+          if((a.adr == this->transfers[i].adr) && (a.we == this->transfers[i].we) &&
+             (a.sel == this->transfers[i].sel) && (!a.we || (a.dat == this->transfers[i].dat))) {
+            found = true;
+          }
+        }
+      }
+      if(!found) {
+        return false;
+      }
+    }
+    return true;
+  }
+};
+
+void tb_memory_reset(TB_Memory * tb) {
+  Vtb_memory_w_fast_switch * core = tb->core;
+  core->testcase = T_RESET;
+
+  //=================================
+  //      Tick (0)
+
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_s1_stall, (core->s1_wb_stall_o == 0));
+  tb->check(COND_s2_stall, (core->s2_wb_stall_o == 1));
+  tb->check(COND_m_wb, (core->m_wb_stb_o == core->s1_wb_stb_i)  &&
+                       (core->m_wb_cyc_o == core->s1_wb_cyc_i));
+
+  //`````````````````````````````````
+  //      Formal Checks
+
+  CHECK("tb_memory_w_fast_switch.reset.01",
+      tb->conditions[COND_s1_stall],
+      "Failed to implement s1 stalling", tb->err_cycles[COND_s1_stall]);
+
+  CHECK("tb_memory_w_fast_switch.reset.02",
+      tb->conditions[COND_s2_stall],
+      "Failed to implement s2 stalling", tb->err_cycles[COND_s2_stall]);
+
+  CHECK("tb_memory_w_fast_switch.reset.03",
+      tb->conditions[COND_m_wb],
+      "Failed to implement master muxing", tb->err_cycles[COND_m_wb]);
+}
+
+void tb_memory_port2_read(TB_Memory * tb) {
+  Vtb_memory_w_fast_switch * core = tb->core;
+  core->testcase = T_PORT2_READ;
+
+  // The following actions are performed in this test :
+  //    tick 0. Read on port 2 (core forwards the request without switching)
+  //    tick 1-9. Nothing
+
+  //=================================
+  //      Tick (0)
+
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  tb->s2.queue.push_back({false, (uint32_t)rand(), 0, 0x3});
+
+  //=================================
+  //      Tick (0-9)
+
+  tb->run(10);
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_data,        tb->completions_match(tb->s1, 0) &&
+                              tb->completions_match(tb->s2, 1) &&
+                              tb->transfers_match());
+  // The request is acknowledged during the cycle it is issued
+  tb->check(COND_latency,     (tb->s2.completions.size() == 1) &&
+                              (tb->s2.completions[0].cycle == 0));
+  tb->check(COND_throughput,  (tb->dead_cycles == 0));
+
+  //`````````````````````````````````
+  //      Formal Checks
+
+  CHECK("tb_memory_w_fast_switch.port2_read.01",
+      tb->conditions[COND_data],
+      "Failed to route the request", tb->err_cycles[COND_data]);
+
+  CHECK("tb_memory_w_fast_switch.port2_read.02",
+      tb->conditions[COND_latency],
+      "Failed to grant port 2 without switching cycles", tb->err_cycles[COND_latency]);
+
+  CHECK("tb_memory_w_fast_switch.port2_read.03",
+      tb->conditions[COND_throughput],
+      "Failed to forward the request immediately", tb->err_cycles[COND_throughput]);
+}
+
+void tb_memory_switch(TB_Memory * tb) {
+  Vtb_memory_w_fast_switch * core = tb->core;
+  core->testcase = T_SWITCH;
+
+  // The following actions are performed in this test :
+  //    tick 0. Read on both ports on a slow memory
+  //    tick 1-29. Nothing (core grants port 2 as soon as port 1 releases
+  //               the bus cycle)
+
+  //=================================
+  //      Tick (0)
+
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  tb->slave.latency = 1 + rand() % 4;
+  tb->s1.queue.push_back({false, (uint32_t)rand(), 0, 0xF});
+  tb->s2.queue.push_back({false, (uint32_t)rand(), 0, 0xF});
+
+  //=================================
+  //      Tick (0-29)
+
+  tb->run(30);
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_data,        tb->completions_match(tb->s1, 1) &&
+                              tb->completions_match(tb->s2, 1) &&
+                              tb->transfers_match());
+  // Port 1 is served first, port 2 being granted on the cycle following the
+  // acknowledge, when port 1 releases the bus cycle
+  tb->check(COND_latency,     (tb->s1.completions.size() == 1) &&
+                              (tb->s2.completions.size() == 1) &&
+                              (tb->s1.completions[0].cycle == tb->slave.latency) &&
+                              (tb->s2.completions[0].cycle == 2 * tb->slave.latency + 1));
+  tb->check(COND_throughput,  (tb->dead_cycles == 0));
+
+  //`````````````````````````````````
+  //      Formal Checks
+
+  CHECK("tb_memory_w_fast_switch.switch.01",
+      tb->conditions[COND_data],
+      "Failed to route the requests", tb->err_cycles[COND_data]);
+
+  CHECK("tb_memory_w_fast_switch.switch.02",
+      tb->conditions[COND_latency],
+      "Failed to switch port during the cycle the bus cycle ends", tb->err_cycles[COND_latency]);
+
+  CHECK("tb_memory_w_fast_switch.switch.03",
+      tb->conditions[COND_throughput],
+      "Failed to keep the master port busy", tb->err_cycles[COND_throughput]);
+}
+
+void tb_memory_contention(TB_Memory * tb) {
+  Vtb_memory_w_fast_switch * core = tb->core;
+  core->testcase = T_CONTENTION;
+
+  // The following actions are performed in this test :
+  //    tick 0. Perform back-to-back accesses on both ports
+  //    tick 1-99. Nothing (core alternates between the ports)
+
+  //=================================
+  //      Tick (0)
+
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  const uint32_t count = 16;
+  for(uint32_t i = 0; i < count; i++) {
+    tb->s1.queue.push_back(TB_Memory::random_access());
+    tb->s2.queue.push_back(TB_Memory::random_access());
+  }
+
+  //=================================
+  //      Tick (0-99)
+
+  tb->run(100);
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_data,        tb->completions_match(tb->s1, count) &&
+                              tb->completions_match(tb->s2, count) &&
+                              tb->transfers_match());
+  // One access is completed every cycle, while the switching arbiter takes
+  // two additional cycles on every change of port
+  uint32_t last = 0;
+  if(!tb->s1.completions.empty() && !tb->s2.completions.empty()) {
+    last = std::max(tb->s1.completions.back().cycle, tb->s2.completions.back().cycle);
+  }
+  tb->check(COND_latency,     (last == 2 * count - 1));
+  tb->check(COND_throughput,  (tb->dead_cycles == 0));
+
+  //`````````````````````````````````
+  //      Formal Checks
+
+  CHECK("tb_memory_w_fast_switch.contention.01",
+      tb->conditions[COND_data],
+      "Failed to route the requests", tb->err_cycles[COND_data]);
+
+  CHECK("tb_memory_w_fast_switch.contention.02",
+      tb->conditions[COND_latency],
+      "Failed to complete one access per cycle", tb->err_cycles[COND_latency]);
+
+  CHECK("tb_memory_w_fast_switch.contention.03",
+      tb->conditions[COND_throughput],
+      "Failed to keep the master port busy", tb->err_cycles[COND_throughput]);
+}
+
+void tb_memory_memory_wait(TB_Memory * tb) {
+  Vtb_memory_w_fast_switch * core = tb->core;
+  core->testcase = T_MEMORY_WAIT;
+
+  // The following actions are performed in this test :
+  //    tick 0. Perform random accesses on both ports on a slow and stalling
+  //            memory
+  //    tick 1-999. Nothing
+
+  //=================================
+  //      Tick (0)
+
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  tb->slave.latency = rand() % 4;
+  tb->slave.random_stall = true;
+  const uint32_t count = 32;
+  for(uint32_t i = 0; i < count; i++) {
+    tb->s1.queue.push_back(TB_Memory::random_access());
+    tb->s2.queue.push_back(TB_Memory::random_access());
+  }
+
+  //=================================
+  //      Tick (0-999)
+
+  tb->run(1000);
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_data,        tb->completions_match(tb->s1, count) &&
+                              tb->completions_match(tb->s2, count) &&
+                              tb->transfers_match());
+  tb->check(COND_throughput,  (tb->dead_cycles == 0));
+
+  //`````````````````````````````````
+  //      Formal Checks
+
+  CHECK("tb_memory_w_fast_switch.memory_wait.01",
+      tb->conditions[COND_data],
+      "Failed to route the requests", tb->err_cycles[COND_data]);
+
+  CHECK("tb_memory_w_fast_switch.memory_wait.02",
+      tb->conditions[COND_throughput],
+      "Failed to keep the master port busy", tb->err_cycles[COND_throughput]);
+}
+
+int main(int argc, char ** argv, char ** env) {
+  srand(time(NULL));
+  Verilated::traceEverOn(true);
+
+  bool verbose = parse_verbose(argc, argv);
+
+  TB_Memory * tb = new TB_Memory;
+  tb->open_trace("waves/memory_w_fast_switch.vcd");
+  tb->open_testdata("testdata/memory_w_fast_switch.csv");
+  tb->set_debug_log(verbose);
+  tb->init_conditions(__CondIdEnd);
+
+  /************************************************************/
+
+  tb_memory_reset(tb);
+
+  tb_memory_port2_read(tb);
+  tb_memory_switch(tb);
+  tb_memory_contention(tb);
+
+  tb_memory_memory_wait(tb);
+
+  /************************************************************/
+
+  printf("[MEMORY_W_FAST_SWITCH]: ");
+  if(tb->success) {
+    printf("Done\n");
+  } else {
+    printf("Failed\n");
+  }
+
+  delete tb;
+  exit(EXIT_SUCCESS);
+}
@@ -0,0 +1,558 @@
+/*           __        _
+ *  ________/ /  ___ _(_)__  ___
+ * / __/ __/ _ \/ _ `/ / _ \/ -_)
+ * \__/\__/_//_/\_,_/_/_//_/\__/
+ * 
+ * Copyright (C) Clément Chaine
+ * This file is part of ECAP5-DPROC <https://github.com/ecap5/ECAP5-DPROC>
+ *
+ * ECAP5-DPROC is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ECAP5-DPROC is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ECAP5-DPROC.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <verilated.h>
+#include <verilated_vcd_c.h>
+#include <svdpi.h>
+#include <deque>
+#include <vector>
+
+#include "Vtb_memory_w_outstanding.h"
+#include "testbench.h"
+#include "wishbone_slave.h"
+#include "Vtb_memory_w_outstanding_tb_memory_w_outstanding.h"
+#include "Vtb_memory_w_outstanding_ecap5_dproc_pkg.h"
+
+enum CondId {
+  COND_s1_stall,
+  COND_s2_stall,
+  COND_m_wb,
+  COND_data,
+  COND_throughput,
+  COND_outstanding,
+  COND_burst,
+  __CondIdEnd
+};
+
+enum TestcaseId {
+  T_RESET        =  1,
+  T_INTERLEAVED  =  2,
+  T_FULL         =  3,
+  T_MEMORY_WAIT  =  4,
+  T_BURST        =  5
+};
+
+struct Access {
+  bool we;
+  uint32_t adr;
+  uint32_t dat;
+  uint8_t sel;
+  uint8_t cti;
+};
+
+struct Completion {
+  uint32_t cycle;
+  Access access;
+  uint32_t dat;
+};
+
+// Pipelined wishbone master model issuing requests back-to-back while
+// keeping the bus cycle until every response is received
+struct Port {
+  std::deque<Access> queue;
+  std::deque<Access> outstanding;
+  std::vector<Completion> completions;
+  // Cycles at which the requests were accepted
+  std::vector<uint32_t> issued;
+  // Number of acknowledges received without pending request
+  uint32_t unexpected_acks;
+
+  void clear() {
+    this->queue.clear();
+    this->outstanding.clear();
+    this->completions.clear();
+    this->issued.clear();
+    this->unexpected_acks = 0;
+  }
+};
+
+class TB_Memory : public Testbench<Vtb_memory_w_outstanding> {
+public:
+  Port s1, s2;
+  // Pipelined wishbone slave model of the memory
+  WishboneSlave<Access> slave;
+  uint32_t cycle;
+  // Requests received by the memory
+  std::vector<Access> transfers;
+  // Maximum number of requests in flight on the master port
+  uint32_t max_in_flight;
+
+  void reset() {
+    this->s1.clear();
+    this->s2.clear();
+    this->slave.latency = 0;
+    this->slave.random_stall = false;
+    this->cycle = 0;
+    this->drive();
+    this->core->m_wb_dat_i = 0;
+    this->core->m_wb_ack_i = 0;
+    this->core->m_wb_stall_i = 0;
+
+    this->core->rst_i = 1;
+    for(int i = 0; i < 5; i++) {
+      Testbench<Vtb_memory_w_outstanding>::tick();
+    }
+    this->core->rst_i = 0;
+
+    this->slave.clear();
+    this->transfers.clear();
+    this->max_in_flight = 0;
+
+    Testbench<Vtb_memory_w_outstanding>::reset();
+  }
+
+  static uint32_t memory(uint32_t adr) {
+    return (adr * 2654435761u) ^ 0xECA50000;
+  }
+
+  void drive() {
+    bool s1_stb = !this->s1.queue.empty();
+    this->core->s1_wb_adr_i = s1_stb ? this->s1.queue.front().adr : 0;
+    this->core->s1_wb_dat_i = s1_stb ? this->s1.queue.front().dat : 0;
+    this->core->s1_wb_we_i  = s1_stb ? this->s1.queue.front().we  : 0;
+    this->core->s1_wb_sel_i = s1_stb ? this->s1.queue.front().sel : 0;
+    this->core->s1_wb_cti_i = s1_stb ? this->s1.queue.front().cti : 0;
+    this->core->s1_wb_bte_i = 0;
+    this->core->s1_wb_stb_i = s1_stb;
+    this->core->s1_wb_cyc_i = s1_stb || !this->s1.outstanding.empty();
+
+    bool s2_stb = !this->s2.queue.empty();
+    this->core->s2_wb_adr_i = s2_stb ? this->s2.queue.front().adr : 0;
+    this->core->s2_wb_dat_i = s2_stb ? this->s2.queue.front().dat : 0;
+    this->core->s2_wb_we_i  = s2_stb ? this->s2.queue.front().we  : 0;
+    this->core->s2_wb_sel_i = s2_stb ? this->s2.queue.front().sel : 0;
+    this->core->s2_wb_cti_i = s2_stb ? this->s2.queue.front().cti : 0;
+    this->core->s2_wb_bte_i = 0;
+    this->core->s2_wb_stb_i = s2_stb;
+    this->core->s2_wb_cyc_i = s2_stb || !this->s2.outstanding.empty();
+  }
+
+  void sample(Port & port, bool stb, bool stall, bool ack, uint32_t dat, bool & accepted) {
+    if(ack) {
+      if(!port.outstanding.empty()) {
+        port.completions.push_back({this->cycle, port.outstanding.front(), dat});
+        port.outstanding.pop_front();
+      } else if(stb && !stall) {
+        // Response provided during the cycle of the request
+        port.completions.push_back({this->cycle, port.queue.front(), dat});
+        port.issued.push_back(this->cycle);
+        port.queue.pop_front();
+        accepted = false;
+        return;
+      } else {
+        port.unexpected_acks += 1;
+      }
+    }
+    accepted = stb && !stall;
+  }
+
+  void update(Port & port, bool accepted) {
+    if(accepted) {
+      port.outstanding.push_back(port.queue.front());
+      port.issued.push_back(this->cycle - 1);
+      port.queue.pop_front();
+    }
+  }
+
+  void tick() {
+    this->drive();
+    this->core->m_wb_ack_i = 0;
+    this->core->m_wb_dat_i = 0;
+    this->core->eval();
+
+    Access request = {(bool)this->core->m_wb_we_o, this->core->m_wb_adr_o,
+                      this->core->m_wb_dat_o, this->core->m_wb_sel_o,
+                      this->core->m_wb_cti_o};
+    if(this->slave.accept(this->cycle, this->core->m_wb_stb_o, this->core->m_wb_cyc_o, this->core->m_wb_stall_i,
+                          request)) {
+      this->transfers.push_back(request);
+    }
+    if(this->slave.in_flight() > this->max_in_flight) {
+      this->max_in_flight = this->slave.in_flight();
+    }
+    Access access;
+    if(this->slave.respond(this->cycle, access)) {
+      this->core->m_wb_ack_i = 1;
+      this->core->m_wb_dat_i = access.we ? 0 : memory(access.adr);
+    }
+    this->core->eval();
+
+    bool s1_accepted, s2_accepted;
+    this->sample(this->s1, this->core->s1_wb_stb_i, this->core->s1_wb_stall_o, this->core->s1_wb_ack_o,
+                 this->core->s1_wb_dat_o, s1_accepted);
+    this->sample(this->s2, this->core->s2_wb_stb_i, this->core->s2_wb_stall_o, this->core->s2_wb_ack_o,
+                 this->core->s2_wb_dat_o, s2_accepted);
+
+    Testbench<Vtb_memory_w_outstanding>::tick();
+    this->cycle += 1;
+
+    this->update(this->s1, s1_accepted);
+    this->update(this->s2, s2_accepted);
+    this->core->m_wb_stall_i = this->slave.stall();
+  }
+
+  void run(uint32_t cycles) {
+    for(uint32_t i = 0; i < cycles; i++) {
+      this->tick();
+    }
+  }
+
+  static Access random_access() {
+    Access access;
+    access.we = rand() % 2;
+    access.adr = rand();
+    access.dat = rand();
+    access.sel = 0xF;
+    access.cti = Vtb_memory_w_outstanding_ecap5_dproc_pkg::CTI_CLASSIC;
+    return access;
+  }
+
+  // Builds an incrementing burst of the given length starting at adr
+  static std::vector<Access> burst(uint32_t adr, uint32_t length) {
+    std::vector<Access> accesses;
+    for(uint32_t i = 0; i < length; i++) {
+      uint8_t cti = (i == length - 1) ? Vtb_memory_w_outstanding_ecap5_dproc_pkg::CTI_END
+                                      : Vtb_memory_w_outstanding_ecap5_dproc_pkg::CTI_INCREMENTING;
+      accesses.push_back({false, adr + 4 * i, 0, 0xF, cti});
+    }
+    return accesses;
+  }
+
+  // Checks that every incrementing burst transfer received by the memory is
+  // directly followed by the next transfer of the same burst
+  bool bursts_contiguous() {
+    for(size_t i = 0; i < this->transfers.size(); i++) {
+      if(this->transfers[i].cti != Vtb_memory_w_outstanding_ecap5_dproc_pkg::CTI_INCREMENTING) {
+        continue;
+      }
+      if((i + 1 >= this->transfers.size()) ||
+         (this->transfers[i + 1].adr != this->transfers[i].adr + 4)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // Checks that the accesses of the port were completed in order with the
+  // memory data
+  bool completions_match(Port & port, const std::vector<Access> & accesses) {
+    if((port.completions.size() != accesses.size()) || (port.unexpected_acks != 0)) {
+      return false;
+    }
+    for(size_t i = 0; i < accesses.size(); i++) {
+      const Completion & c = port.completions[i];
+      if((c.access.adr != accesses[i].adr) || (c.access.we != accesses[i].we)) {
+        return false;
+      }
+      if(!c.access.we && (c.dat != memory(c.access.adr))) {
+        return false;
+      }
+    }
+    return true;
+  }
+};
+
+void tb_memory_reset(TB_Memory * tb) {
+  Vtb_memory_w_outstanding * core = tb->core;
+  core->testcase = T_RESET;
+
+  //=================================
+  //      Tick (0)
+
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_s1_stall, (core->s1_wb_stall_o == 0));
+  tb->check(COND_s2_stall, (core->s2_wb_stall_o == 1));
+  tb->check(COND_m_wb, (core->m_wb_stb_o == 0)  &&
+                       (core->m_wb_cyc_o == 0));
+
+  //`````````````````````````````````
+  //      Formal Checks
+
+  CHECK("tb_memory_w_outstanding.reset.01",
+      tb->conditions[COND_s1_stall],
+      "Failed to implement s1 stalling", tb->err_cycles[COND_s1_stall]);
+
+  CHECK("tb_memory_w_outstanding.reset.02",
+      tb->conditions[COND_s2_stall],
+      "Failed to implement s2 stalling", tb->err_cycles[COND_s2_stall]);
+
+  CHECK("tb_memory_w_outstanding.reset.03",
+      tb->conditions[COND_m_wb],
+      "Failed to implement master muxing", tb->err_cycles[COND_m_wb]);
+}
+
+void tb_memory_interleaved(TB_Memory * tb) {
+  Vtb_memory_w_outstanding * core = tb->core;
+  core->testcase = T_INTERLEAVED;
+
+  // The following actions are performed in this test :
+  //    tick 0. Issue back-to-back reads on both ports
+  //    tick 1-99. Nothing (core forwards one request per cycle)
+
+  //=================================
+  //      Tick (0)
+
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  tb->slave.latency = rand() % core->tb_memory_w_outstanding->OUTSTANDING_DEPTH;
+  const uint32_t count = 16;
+  std::vector<Access> s1_accesses, s2_accesses;
+  for(uint32_t i = 0; i < count; i++) {
+    s1_accesses.push_back({false, (uint32_t)rand(), 0, 0xF});
+    s2_accesses.push_back({false, (uint32_t)rand(), 0, 0xF});
+    tb->s1.queue.push_back(s1_accesses.back());
+    tb->s2.queue.push_back(s2_accesses.back());
+  }
+
+  //=================================
+  //      Tick (0-99)
+
+  tb->run(100);
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_data,        tb->completions_match(tb->s1, s1_accesses) &&
+                              tb->completions_match(tb->s2, s2_accesses));
+  // The ports are granted alternately, a request being forwarded every cycle
+  tb->check(COND_throughput,  (tb->s1.issued.size() == count) &&
+                              (tb->s2.issued.size() == count));
+  for(uint32_t i = 0; i < tb->s1.issued.size() && i < tb->s2.issued.size(); i++) {
+    tb->check(COND_throughput, (tb->s1.issued[i] == 2 * i) &&
+                               (tb->s2.issued[i] == 2 * i + 1));
+  }
+
+  //`````````````````````````````````
+  //      Formal Checks
+
+  CHECK("tb_memory_w_outstanding.interleaved.01",
+      tb->conditions[COND_data],
+      "Failed to route the responses to their port", tb->err_cycles[COND_data]);
+
+  CHECK("tb_memory_w_outstanding.interleaved.02",
+      tb->conditions[COND_throughput],
+      "Failed to forward a request every cycle", tb->err_cycles[COND_throughput]);
+}
+
+void tb_memory_full(TB_Memory * tb) {
+  Vtb_memory_w_outstanding * core = tb->core;
+  core->testcase = T_FULL;
+
+  // The following actions are performed in this test :
+  //    tick 0. Issue back-to-back reads on both ports on a slow memory
+  //    tick 1-199. Nothing (core stalls the ports while the response routing
+  //                queue is full)
+
+  //=================================
+  //      Tick (0)
+
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  uint32_t depth = core->tb_memory_w_outstanding->OUTSTANDING_DEPTH;
+  tb->slave.latency = 2 * depth;
+  const uint32_t count = 8;
+  std::vector<Access> s1_accesses, s2_accesses;
+  for(uint32_t i = 0; i < count; i++) {
+    s1_accesses.push_back({false, (uint32_t)rand(), 0, 0xF});
+    s2_accesses.push_back({false, (uint32_t)rand(), 0, 0xF});
+    tb->s1.queue.push_back(s1_accesses.back());
+    tb->s2.queue.push_back(s2_accesses.back());
+  }
+
+  //=================================
+  //      Tick (0-199)
+
+  tb->run(200);
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_data,        tb->completions_match(tb->s1, s1_accesses) &&
+                              tb->completions_match(tb->s2, s2_accesses));
+  tb->check(COND_outstanding, (tb->max_in_flight == depth));
+
+  //`````````````````````````````````
+  //      Formal Checks
+
+  CHECK("tb_memory_w_outstanding.full.01",
+      tb->conditions[COND_data],
+      "Failed to route the responses to their port", tb->err_cycles[COND_data]);
+
+  CHECK("tb_memory_w_outstanding.full.02",
+      tb->conditions[COND_outstanding],
+      "Failed to limit the number of requests in flight", tb->err_cycles[COND_outstanding]);
+}
+
+void tb_memory_memory_wait(TB_Memory * tb) {
+  Vtb_memory_w_outstanding * core = tb->core;
+  core->testcase = T_MEMORY_WAIT;
+
+  // The following actions are performed in this test :
+  //    tick 0. Issue random accesses on both ports on a slow and stalling
+  //            memory
+  //    tick 1-999. Nothing
+
+  //=================================
+  //      Tick (0)
+
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  tb->slave.latency = rand() % 8;
+  tb->slave.random_stall = true;
+  const uint32_t count = 32;
+  std::vector<Access> s1_accesses, s2_accesses;
+  for(uint32_t i = 0; i < count; i++) {
+    s1_accesses.push_back(TB_Memory::random_access());
+    s2_accesses.push_back(TB_Memory::random_access());
+    tb->s1.queue.push_back(s1_accesses.back());
+    tb->s2.queue.push_back(s2_accesses.back());
+  }
+
+  //=================================
+  //      Tick (0-999)
+
+  tb->run(1000);
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_data,        tb->completions_match(tb->s1, s1_accesses) &&
+                              tb->completions_match(tb->s2, s2_accesses));
+  tb->check(COND_outstanding, (tb->max_in_flight <= core->tb_memory_w_outstanding->OUTSTANDING_DEPTH));
+
+  //`````````````````````````````````
+  //      Formal Checks
+
+  CHECK("tb_memory_w_outstanding.memory_wait.01",
+      tb->conditions[COND_data],
+      "Failed to route the responses to their port", tb->err_cycles[COND_data]);
+
+  CHECK("tb_memory_w_outstanding.memory_wait.02",
+      tb->conditions[COND_outstanding],
+      "Failed to limit the number of requests in flight", tb->err_cycles[COND_outstanding]);
+}
+
+void tb_memory_burst(TB_Memory * tb) {
+  Vtb_memory_w_outstanding * core = tb->core;
+  core->testcase = T_BURST;
+
+  // The following actions are performed in this test :
+  //    tick 0. Issue an incrementing burst on both ports simultaneously
+  //    tick 1-99. Nothing (core forwards each burst without interleaving)
+
+  //=================================
+  //      Tick (0)
+
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  tb->slave.latency = rand() % core->tb_memory_w_outstanding->OUTSTANDING_DEPTH;
+  const uint32_t length = 4;
+  std::vector<Access> s1_accesses = TB_Memory::burst(0x1000 + ((rand() % 256) << 4), length);
+  std::vector<Access> s2_accesses = TB_Memory::burst(0x8000 + ((rand() % 256) << 4), length);
+  for(uint32_t i = 0; i < length; i++) {
+    tb->s1.queue.push_back(s1_accesses[i]);
+    tb->s2.queue.push_back(s2_accesses[i]);
+  }
+
+  //=================================
+  //      Tick (0-99)
+
+  tb->run(100);
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_data,   tb->completions_match(tb->s1, s1_accesses) &&
+                         tb->completions_match(tb->s2, s2_accesses));
+  uint32_t ends = 0;
+  for(const Access & transfer : tb->transfers) {
+    ends += (transfer.cti == Vtb_memory_w_outstanding_ecap5_dproc_pkg::CTI_END);
+  }
+  tb->check(COND_burst,  (tb->transfers.size() == 2 * length) && (ends == 2) &&
+                         tb->bursts_contiguous());
+
+  //`````````````````````````````````
+  //      Formal Checks
+
+  CHECK("tb_memory_w_outstanding.burst.01",
+      tb->conditions[COND_data],
+      "Failed to route the responses to their port", tb->err_cycles[COND_data]);
+
+  CHECK("tb_memory_w_outstanding.burst.02",
+      tb->conditions[COND_burst],
+      "Failed to forward the bursts without interleaving", tb->err_cycles[COND_burst]);
+}
+
+int main(int argc, char ** argv, char ** env) {
+  srand(time(NULL));
+  Verilated::traceEverOn(true);
+
+  bool verbose = parse_verbose(argc, argv);
+
+  TB_Memory * tb = new TB_Memory;
+  tb->open_trace("waves/memory_w_outstanding.vcd");
+  tb->open_testdata("testdata/memory_w_outstanding.csv");
+  tb->set_debug_log(verbose);
+  tb->init_conditions(__CondIdEnd);
+
+  /************************************************************/
+
+  tb_memory_reset(tb);
+
+  tb_memory_interleaved(tb);
+  tb_memory_full(tb);
+
+  tb_memory_memory_wait(tb);
+
+  tb_memory_burst(tb);
+
+  /************************************************************/
+
+  printf("[MEMORY_W_OUTSTANDING]: ");
+  if(tb->success) {
+    printf("Done\n");
+  } else {
+    printf("Failed\n");
+  }
+
+  delete tb;
+  exit(EXIT_SUCCESS);
+}
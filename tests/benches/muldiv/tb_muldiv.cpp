@@ -0,0 +1,394 @@
+/*           __        _
+ *  ________/ /  ___ _(_)__  ___
+ * / __/ __/ _ \/ _ `/ / _ \/ -_)
+ * \__/\__/_//_/\_,_/_/_//_/\__/
+ *
+ * Copyright (C) Clément Chaine
+ * This file is part of ECAP5-DPROC <https://github.com/ecap5/ECAP5-DPROC>
+ *
+ * ECAP5-DPROC is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ECAP5-DPROC is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ECAP5-DPROC.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <verilated.h>
+#include <verilated_vcd_c.h>
+#include <svdpi.h>
+
+#include "Vtb_muldiv.h"
+#include "testbench.h"
+#include "Vtb_muldiv_ecap5_dproc_pkg.h"
+#include "Vtb_muldiv_muldiv.h"
+#include "Vtb_muldiv_tb_muldiv.h"
+
+#define MUL_STAGES 2
+#define MAX_LATENCY 40
+
+enum CondId {
+  COND_valid,
+  COND_result,
+  COND_latency,
+  __CondIdEnd
+};
+
+enum TestcaseId {
+  T_RESET               =  1,
+  T_MUL                 =  2,
+  T_DIV                 =  3,
+  T_DIV_SPECIAL         =  4,
+  T_EARLY_TERMINATION   =  5,
+  T_HOLD                =  6
+};
+
+enum Op {
+  OP_MUL     =  0,
+  OP_MULH    =  1,
+  OP_MULHSU  =  2,
+  OP_MULHU   =  3,
+  OP_DIV     =  4,
+  OP_DIVU    =  5,
+  OP_REM     =  6,
+  OP_REMU    =  7
+};
+
+class TB_Muldiv : public Testbench<Vtb_muldiv> {
+public:
+  void reset() {
+    this->core->request_i = 0;
+    this->core->op_i = 0;
+    this->core->operand1_i = 0;
+    this->core->operand2_i = 0;
+    this->core->ack_i = 0;
+
+    this->core->rst_i = 1;
+    for(int i = 0; i < 5; i++) {
+      this->tick();
+    }
+    this->core->rst_i = 0;
+
+    Testbench<Vtb_muldiv>::reset();
+  }
+
+  // Reference model of the M extension operations
+  static uint32_t expected(uint8_t op, uint32_t a, uint32_t b) {
+    int32_t sa = (int32_t)a, sb = (int32_t)b;
+    switch(op) {
+      case OP_MUL:    return a * b;
+      case OP_MULH:   return (uint32_t)(((int64_t)sa * (int64_t)sb) >> 32);
+      case OP_MULHSU: return (uint32_t)(((int64_t)sa * (int64_t)(uint64_t)b) >> 32);
+      case OP_MULHU:  return (uint32_t)(((uint64_t)a * (uint64_t)b) >> 32);
+      case OP_DIV:
+        if(b == 0) return 0xFFFFFFFF;
+        if((a == 0x80000000) && (b == 0xFFFFFFFF)) return 0x80000000;
+        return (uint32_t)(sa / sb);
+      case OP_DIVU:
+        if(b == 0) return 0xFFFFFFFF;
+        return a / b;
+      case OP_REM:
+        if(b == 0) return a;
+        if((a == 0x80000000) && (b == 0xFFFFFFFF)) return 0;
+        return (uint32_t)(sa % sb);
+      default:
+        if(b == 0) return a;
+        return a % b;
+    }
+  }
+
+  /*
+   * Requests an operation and waits for its result, which is acknowledged.
+   * Returns the number of cycles between the request and the result.
+   */
+  uint32_t run(uint8_t op, uint32_t a, uint32_t b) {
+    this->core->request_i = 1;
+    this->core->op_i = op;
+    this->core->operand1_i = a;
+    this->core->operand2_i = b;
+    this->core->ack_i = 1;
+
+    uint32_t latency = 0;
+    do {
+      this->tick();
+      latency += 1;
+    } while(!this->core->valid_o && (latency < MAX_LATENCY));
+
+    this->check(COND_valid,   (this->core->valid_o   ==  1));
+    this->check(COND_result,  (this->core->result_o  ==  expected(op, a, b)));
+
+    // The result is acknowledged
+    this->tick();
+    this->core->request_i = 0;
+    this->check(COND_valid,   (this->core->valid_o   ==  0));
+
+    return latency;
+  }
+};
+
+void tb_muldiv_reset(TB_Muldiv * tb) {
+  Vtb_muldiv * core = tb->core;
+  core->testcase = T_RESET;
+
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_valid,   (core->valid_o  ==  0));
+
+  //`````````````````````````````````
+  //      Formal Checks
+
+  CHECK("tb_muldiv.reset.01",
+      tb->conditions[COND_valid],
+      "Failed to implement the valid_o signal", tb->err_cycles[COND_valid]);
+}
+
+void tb_muldiv_mul(TB_Muldiv * tb) {
+  Vtb_muldiv * core = tb->core;
+  core->testcase = T_MUL;
+
+  // The following actions are performed in this test :
+  //    Each multiplication is requested with random operands, its result
+  //    being expected after MUL_STAGES cycles.
+
+  tb->reset();
+
+  for(int i = 0; i < 64; i++) {
+    uint8_t op = OP_MUL + (i % 4);
+    uint32_t latency = tb->run(op, rand() ^ (rand() << 16), rand() ^ (rand() << 16));
+    tb->check(COND_latency, (latency == MUL_STAGES));
+  }
+
+  //`````````````````````````````````
+  //      Formal Checks
+
+  CHECK("tb_muldiv.mul.01",
+      tb->conditions[COND_valid],
+      "Failed to implement the valid_o signal", tb->err_cycles[COND_valid]);
+
+  CHECK("tb_muldiv.mul.02",
+      tb->conditions[COND_result],
+      "Failed to implement the multiplication", tb->err_cycles[COND_result]);
+
+  CHECK("tb_muldiv.mul.03",
+      tb->conditions[COND_latency],
+      "Failed to implement the multiplier pipeline", tb->err_cycles[COND_latency]);
+}
+
+void tb_muldiv_div(TB_Muldiv * tb) {
+  Vtb_muldiv * core = tb->core;
+  core->testcase = T_DIV;
+
+  // The following actions are performed in this test :
+  //    Each division is requested with random operands of random magnitude.
+
+  tb->reset();
+
+  for(int i = 0; i < 128; i++) {
+    uint8_t op = OP_DIV + (i % 4);
+    uint32_t a = (rand() ^ (rand() << 16)) >> (rand() % 32);
+    uint32_t b = (rand() ^ (rand() << 16)) >> (rand() % 32);
+    if(rand() % 2) {
+      a = -a;
+    }
+    if(rand() % 2) {
+      b = -b;
+    }
+    tb->run(op, a, b);
+  }
+
+  //`````````````````````````````````
+  //      Formal Checks
+
+  CHECK("tb_muldiv.div.01",
+      tb->conditions[COND_valid],
+      "Failed to implement the valid_o signal", tb->err_cycles[COND_valid]);
+
+  CHECK("tb_muldiv.div.02",
+      tb->conditions[COND_result],
+      "Failed to implement the division", tb->err_cycles[COND_result]);
+}
+
+void tb_muldiv_div_special(TB_Muldiv * tb) {
+  Vtb_muldiv * core = tb->core;
+  core->testcase = T_DIV_SPECIAL;
+
+  // The following actions are performed in this test :
+  //    The division by zero and the signed overflow are requested for each
+  //    division operation.
+
+  tb->reset();
+
+  for(uint8_t op = OP_DIV; op <= OP_REMU; op++) {
+    tb->run(op, rand(), 0);
+    tb->run(op, 0x80000000, 0xFFFFFFFF);
+    tb->run(op, 0, rand() | 1);
+  }
+
+  //`````````````````````````````````
+  //      Formal Checks
+
+  CHECK("tb_muldiv.div_special.01",
+      tb->conditions[COND_valid],
+      "Failed to implement the valid_o signal", tb->err_cycles[COND_valid]);
+
+  CHECK("tb_muldiv.div_special.02",
+      tb->conditions[COND_result],
+      "Failed to implement the division by zero and overflow", tb->err_cycles[COND_result]);
+}
+
+void tb_muldiv_early_termination(TB_Muldiv * tb) {
+  Vtb_muldiv * core = tb->core;
+  core->testcase = T_EARLY_TERMINATION;
+
+  // The following actions are performed in this test :
+  //    The latency of a division is compared between a small and a large
+  //    dividend, and for a divisor greater than the dividend.
+
+  tb->reset();
+
+  uint32_t small = tb->run(OP_DIVU, 0x1F, 3);
+  uint32_t large = tb->run(OP_DIVU, 0xFFFFFFF0, 3);
+  uint32_t greater = tb->run(OP_DIVU, 3, 0x1F);
+
+  // The 32 bits of the dividend are processed 2 bits per cycle (radix 4)
+  tb->check(COND_latency, (large == 2 + 32 / 2));
+  tb->check(COND_latency, (small == 2 + 6 / 2));
+  tb->check(COND_latency, (greater == 2));
+
+  //`````````````````````````````````
+  //      Formal Checks
+
+  CHECK("tb_muldiv.early_termination.01",
+      tb->conditions[COND_result],
+      "Failed to implement the division", tb->err_cycles[COND_result]);
+
+  CHECK("tb_muldiv.early_termination.02",
+      tb->conditions[COND_latency],
+      "Failed to skip the leading zeros of the dividend", tb->err_cycles[COND_latency]);
+}
+
+void tb_muldiv_hold(TB_Muldiv * tb) {
+  Vtb_muldiv * core = tb->core;
+  core->testcase = T_HOLD;
+
+  // The following actions are performed in this test :
+  //    tick 0. Request a multiplication without acknowledging the result
+  //    tick 1. Change the operands (unit outputs the result)
+  //    tick 2. Nothing (unit holds the result)
+  //    tick 3. Acknowledge the result (unit is idle)
+
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  uint32_t a = rand();
+  uint32_t b = rand();
+  core->request_i = 1;
+  core->op_i = OP_MULHU;
+  core->operand1_i = a;
+  core->operand2_i = b;
+  core->ack_i = 0;
+
+  //=================================
+  //      Tick (0-1)
+
+  tb->tick();
+
+  // The operands are only sampled when the request is accepted
+  core->operand1_i = rand();
+  core->operand2_i = rand();
+
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_valid,   (core->valid_o   ==  1));
+  tb->check(COND_result,  (core->result_o  ==  tb->expected(OP_MULHU, a, b)));
+
+  //=================================
+  //      Tick (2)
+
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_valid,   (core->valid_o   ==  1));
+  tb->check(COND_result,  (core->result_o  ==  tb->expected(OP_MULHU, a, b)));
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  core->ack_i = 1;
+
+  //=================================
+  //      Tick (3)
+
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_valid,   (core->valid_o   ==  0));
+
+  //`````````````````````````````````
+  //      Formal Checks
+
+  CHECK("tb_muldiv.hold.01",
+      tb->conditions[COND_valid],
+      "Failed to implement the valid_o signal", tb->err_cycles[COND_valid]);
+
+  CHECK("tb_muldiv.hold.02",
+      tb->conditions[COND_result],
+      "Failed to hold the result until acknowledged", tb->err_cycles[COND_result]);
+}
+
+int main(int argc, char ** argv, char ** env) {
+  srand(time(NULL));
+  Verilated::traceEverOn(true);
+
+  bool verbose = parse_verbose(argc, argv);
+
+  TB_Muldiv * tb = new TB_Muldiv;
+  tb->open_trace("waves/muldiv.vcd");
+  tb->open_testdata("testdata/muldiv.csv");
+  tb->set_debug_log(verbose);
+  tb->init_conditions(__CondIdEnd);
+
+  /************************************************************/
+
+  tb_muldiv_reset(tb);
+
+  tb_muldiv_mul(tb);
+  tb_muldiv_div(tb);
+  tb_muldiv_div_special(tb);
+  tb_muldiv_early_termination(tb);
+
+  tb_muldiv_hold(tb);
+
+  /************************************************************/
+
+  printf("[MULDIV]: ");
+  if(tb->success) {
+    printf("Done\n");
+  } else {
+    printf("Failed\n");
+  }
+
+  delete tb;
+  exit(EXIT_SUCCESS);
+}
@@ -0,0 +1,58 @@
+/*           __        _
+ *  ________/ /  ___ _(_)__  ___
+ * / __/ __/ _ \/ _ `/ / _ \/ -_)
+ * \__/\__/_//_/\_,_/_/_//_/\__/
+ * 
+ * Copyright (C) Clément Chaine
+ * This file is part of ECAP5-DPROC <https://github.com/ecap5/ECAP5-DPROC>
+ *
+ * ECAP5-DPROC is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ECAP5-DPROC is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ECAP5-DPROC.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+module tb_muldiv (
+  input   int          testcase,
+
+  input   logic        clk_i,
+  input   logic        rst_i,
+  // Request, held until the result is acknowledged
+  input   logic        request_i,
+  input   logic[2:0]   op_i,
+  input   logic[31:0]  operand1_i,
+  input   logic[31:0]  operand2_i,
+  // Result handshake
+  output  logic        valid_o,
+  input   logic        ack_i,
+  output  logic[31:0]  result_o
+);
+
+muldiv #(
+  .MUL_STAGES  (2),
+  .DIV_RADIX   (4)
+) dut (
+  .clk_i       (clk_i),
+  .rst_i       (rst_i),
+  .request_i   (request_i),
+  .op_i        (op_i),
+  .operand1_i  (operand1_i),
+  .operand2_i  (operand2_i),
+  .valid_o     (valid_o),
+  .ack_i       (ack_i),
+  .result_o    (result_o)
+);
+
+endmodule // tb_muldiv
+
+`verilator_config
+
+public -module "muldiv" -var "MUL_STAGES"
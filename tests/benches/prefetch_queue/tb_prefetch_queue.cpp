@@ -0,0 +1,575 @@
+/*           __        _
+ *  ________/ /  ___ _(_)__  ___
+ * / __/ __/ _ \/ _ `/ / _ \/ -_)
+ * \__/\__/_//_/\_,_/_/_//_/\__/
+ *
+ * Copyright (C) Clément Chaine
+ * This file is part of ECAP5-DPROC <https://github.com/ecap5/ECAP5-DPROC>
+ *
+ * ECAP5-DPROC is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ECAP5-DPROC is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ECAP5-DPROC.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <verilated.h>
+#include <verilated_vcd_c.h>
+#include <svdpi.h>
+
+#include "Vtb_prefetch_queue.h"
+#include "testbench.h"
+#include "Vtb_prefetch_queue_ecap5_dproc_pkg.h"
+#include "Vtb_prefetch_queue_prefetch_queue.h"
+#include "Vtb_prefetch_queue_tb_prefetch_queue.h"
+
+enum CondId {
+  COND_input_ready,
+  COND_output,
+  COND_output_valid,
+  COND_next,
+  __CondIdEnd
+};
+
+enum TestcaseId {
+  T_NO_STALL      =  1,
+  T_PIPELINE_WAIT =  2,
+  T_FLUSH         =  3,
+  T_RESET         =  4,
+  T_SKIP          =  5
+};
+
+class TB_Prefetch_queue : public Testbench<Vtb_prefetch_queue> {
+public:
+  void reset() {
+    this->core->flush_i = 0;
+    this->core->input_valid_i = 0;
+    this->core->instr_i = 0;
+    this->core->pc_i = 0;
+    this->core->output_ready_i = 0;
+    this->core->output_skip_i = 0;
+
+    this->core->rst_i = 1;
+    for(int i = 0; i < 5; i++) {
+      this->tick();
+    }
+    this->core->rst_i = 0;
+
+    Testbench<Vtb_prefetch_queue>::reset();
+  }
+
+  void _push(uint32_t instr, uint32_t pc) {
+    this->core->input_valid_i = 1;
+    this->core->instr_i = instr;
+    this->core->pc_i = pc;
+  }
+};
+
+void tb_prefetch_queue_reset(TB_Prefetch_queue * tb) {
+  Vtb_prefetch_queue * core = tb->core;
+  core->testcase = T_RESET;
+
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_input_ready,   (core->input_ready_o   ==  1));
+  tb->check(COND_output_valid,  (core->output_valid_o  ==  0));
+
+  //`````````````````````````````````
+  //      Formal Checks
+
+  CHECK("tb_prefetch_queue.reset.01",
+      tb->conditions[COND_input_ready],
+      "Failed to implement the input_ready_o signal", tb->err_cycles[COND_input_ready]);
+
+  CHECK("tb_prefetch_queue.reset.02",
+      tb->conditions[COND_output_valid],
+      "Failed to implement the output_valid_o signal", tb->err_cycles[COND_output_valid]);
+}
+
+void tb_prefetch_queue_no_stall(TB_Prefetch_queue * tb) {
+  Vtb_prefetch_queue * core = tb->core;
+  core->testcase = T_NO_STALL;
+
+  // The following actions are performed in this test :
+  //    tick 0. Push instruction A
+  //    tick 1. Push instruction B (queue outputs A)
+  //    tick 2. Nothing (queue outputs B)
+  //    tick 3. Nothing (queue is empty)
+
+  //=================================
+  //      Tick (0)
+
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  uint32_t instr_a = rand();
+  uint32_t pc_a = rand() & ~0x3;
+  tb->_push(instr_a, pc_a);
+  core->output_ready_i = 1;
+
+  //=================================
+  //      Tick (1)
+
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_input_ready,   (core->input_ready_o   ==  1));
+  tb->check(COND_output_valid,  (core->output_valid_o  ==  1));
+  tb->check(COND_output,        (core->instr_o         ==  instr_a) &&
+                                (core->pc_o            ==  pc_a));
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  uint32_t instr_b = rand();
+  uint32_t pc_b = rand() & ~0x3;
+  tb->_push(instr_b, pc_b);
+
+  //=================================
+  //      Tick (2)
+
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_input_ready,   (core->input_ready_o   ==  1));
+  tb->check(COND_output_valid,  (core->output_valid_o  ==  1));
+  tb->check(COND_output,        (core->instr_o         ==  instr_b) &&
+                                (core->pc_o            ==  pc_b));
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  core->input_valid_i = 0;
+
+  //=================================
+  //      Tick (3)
+
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_input_ready,   (core->input_ready_o   ==  1));
+  tb->check(COND_output_valid,  (core->output_valid_o  ==  0));
+
+  //`````````````````````````````````
+  //      Formal Checks
+
+  CHECK("tb_prefetch_queue.no_stall.01",
+      tb->conditions[COND_input_ready],
+      "Failed to implement the input_ready_o signal", tb->err_cycles[COND_input_ready]);
+
+  CHECK("tb_prefetch_queue.no_stall.02",
+      tb->conditions[COND_output_valid],
+      "Failed to implement the output_valid_o signal", tb->err_cycles[COND_output_valid]);
+
+  CHECK("tb_prefetch_queue.no_stall.03",
+      tb->conditions[COND_output],
+      "Failed to implement the output signals", tb->err_cycles[COND_output]);
+}
+
+void tb_prefetch_queue_pipeline_wait(TB_Prefetch_queue * tb) {
+  Vtb_prefetch_queue * core = tb->core;
+  core->testcase = T_PIPELINE_WAIT;
+
+  // The following actions are performed in this test :
+  //    tick 0. Push instruction A with the output not ready
+  //    tick 1. Push instruction B
+  //    tick 2. Push instruction C (queue is full)
+  //    tick 3. Set the output ready (queue holds A)
+  //    tick 4. Nothing (queue outputs B)
+  //    tick 5. Stop pushing (queue accepts and outputs C)
+  //    tick 6. Nothing (queue is empty)
+
+  //=================================
+  //      Tick (0)
+
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  uint32_t instr[3], pc[3];
+  for(int i = 0; i < 3; i++) {
+    instr[i] = rand();
+    pc[i] = rand() & ~0x3;
+  }
+
+  tb->_push(instr[0], pc[0]);
+  core->output_ready_i = 0;
+
+  //=================================
+  //      Tick (1)
+
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_input_ready,   (core->input_ready_o   ==  1));
+  tb->check(COND_output_valid,  (core->output_valid_o  ==  1));
+  tb->check(COND_output,        (core->instr_o         ==  instr[0]) &&
+                                (core->pc_o            ==  pc[0]));
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  tb->_push(instr[1], pc[1]);
+
+  //=================================
+  //      Tick (2)
+
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_input_ready,   (core->input_ready_o   ==  0));
+  tb->check(COND_output_valid,  (core->output_valid_o  ==  1));
+  tb->check(COND_output,        (core->instr_o         ==  instr[0]) &&
+                                (core->pc_o            ==  pc[0]));
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  tb->_push(instr[2], pc[2]);
+
+  //=================================
+  //      Tick (3)
+
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_input_ready,   (core->input_ready_o   ==  0));
+  tb->check(COND_output_valid,  (core->output_valid_o  ==  1));
+  tb->check(COND_output,        (core->instr_o         ==  instr[0]) &&
+                                (core->pc_o            ==  pc[0]));
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  core->output_ready_i = 1;
+
+  //=================================
+  //      Tick (4)
+
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_input_ready,   (core->input_ready_o   ==  1));
+  tb->check(COND_output_valid,  (core->output_valid_o  ==  1));
+  tb->check(COND_output,        (core->instr_o         ==  instr[1]) &&
+                                (core->pc_o            ==  pc[1]));
+
+  //=================================
+  //      Tick (5)
+
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_output_valid,  (core->output_valid_o  ==  1));
+  tb->check(COND_output,        (core->instr_o         ==  instr[2]) &&
+                                (core->pc_o            ==  pc[2]));
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  core->input_valid_i = 0;
+
+  //=================================
+  //      Tick (6)
+
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_output_valid,  (core->output_valid_o  ==  0));
+
+  //`````````````````````````````````
+  //      Formal Checks
+
+  CHECK("tb_prefetch_queue.pipeline_wait.01",
+      tb->conditions[COND_input_ready],
+      "Failed to implement the input_ready_o signal", tb->err_cycles[COND_input_ready]);
+
+  CHECK("tb_prefetch_queue.pipeline_wait.02",
+      tb->conditions[COND_output_valid],
+      "Failed to implement the output_valid_o signal", tb->err_cycles[COND_output_valid]);
+
+  CHECK("tb_prefetch_queue.pipeline_wait.03",
+      tb->conditions[COND_output],
+      "Failed to implement the output signals", tb->err_cycles[COND_output]);
+}
+
+void tb_prefetch_queue_flush(TB_Prefetch_queue * tb) {
+  Vtb_prefetch_queue * core = tb->core;
+  core->testcase = T_FLUSH;
+
+  // The following actions are performed in this test :
+  //    tick 0. Push instruction A with the output not ready
+  //    tick 1. Push instruction B
+  //    tick 2. Flush the queue while pushing instruction C
+  //    tick 3. Push instruction D (queue is empty)
+  //    tick 4. Nothing (queue outputs D)
+
+  //=================================
+  //      Tick (0)
+
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  uint32_t instr[4], pc[4];
+  for(int i = 0; i < 4; i++) {
+    instr[i] = rand();
+    pc[i] = rand() & ~0x3;
+  }
+
+  tb->_push(instr[0], pc[0]);
+  core->output_ready_i = 0;
+
+  //=================================
+  //      Tick (1)
+
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  tb->_push(instr[1], pc[1]);
+
+  //=================================
+  //      Tick (2)
+
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  tb->_push(instr[2], pc[2]);
+  core->flush_i = 1;
+
+  //=================================
+  //      Tick (3)
+
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_input_ready,   (core->input_ready_o   ==  1));
+  tb->check(COND_output_valid,  (core->output_valid_o  ==  0));
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  tb->_push(instr[3], pc[3]);
+  core->flush_i = 0;
+  core->output_ready_i = 1;
+
+  //=================================
+  //      Tick (4)
+
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_output_valid,  (core->output_valid_o  ==  1));
+  tb->check(COND_output,        (core->instr_o         ==  instr[3]) &&
+                                (core->pc_o            ==  pc[3]));
+
+  //`````````````````````````````````
+  //      Formal Checks
+
+  CHECK("tb_prefetch_queue.flush.01",
+      tb->conditions[COND_input_ready],
+      "Failed to implement the input_ready_o signal", tb->err_cycles[COND_input_ready]);
+
+  CHECK("tb_prefetch_queue.flush.02",
+      tb->conditions[COND_output_valid],
+      "Failed to implement the output_valid_o signal", tb->err_cycles[COND_output_valid]);
+
+  CHECK("tb_prefetch_queue.flush.03",
+      tb->conditions[COND_output],
+      "Failed to implement the output signals", tb->err_cycles[COND_output]);
+}
+
+void tb_prefetch_queue_skip(TB_Prefetch_queue * tb) {
+  Vtb_prefetch_queue * core = tb->core;
+  core->testcase = T_SKIP;
+
+  // The following actions are performed in this test :
+  //    tick 0. Push instruction A with the output not ready
+  //    tick 1. Push instruction B (queue exposes A only)
+  //    tick 2. Consume both instructions (queue exposes A and B)
+  //    tick 3. Push instruction C (queue is empty)
+  //    tick 4. Nothing (queue outputs C)
+
+  //=================================
+  //      Tick (0)
+
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  uint32_t instr[3], pc[3];
+  for(int i = 0; i < 3; i++) {
+    instr[i] = rand();
+    pc[i] = rand() & ~0x3;
+  }
+
+  tb->_push(instr[0], pc[0]);
+  core->output_ready_i = 0;
+
+  //=================================
+  //      Tick (1)
+
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_output_valid,  (core->output_valid_o  ==  1));
+  tb->check(COND_next,          (core->next_valid_o    ==  0));
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  tb->_push(instr[1], pc[1]);
+
+  //=================================
+  //      Tick (2)
+
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_output_valid,  (core->output_valid_o  ==  1));
+  tb->check(COND_output,        (core->instr_o         ==  instr[0]) &&
+                                (core->pc_o            ==  pc[0]));
+  tb->check(COND_next,          (core->next_valid_o    ==  1) &&
+                                (core->next_instr_o    ==  instr[1]));
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  core->input_valid_i = 0;
+  core->output_ready_i = 1;
+  core->output_skip_i = 1;
+
+  //=================================
+  //      Tick (3)
+
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_input_ready,   (core->input_ready_o   ==  1));
+  tb->check(COND_output_valid,  (core->output_valid_o  ==  0));
+  tb->check(COND_next,          (core->next_valid_o    ==  0));
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  tb->_push(instr[2], pc[2]);
+  core->output_skip_i = 0;
+
+  //=================================
+  //      Tick (4)
+
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_output_valid,  (core->output_valid_o  ==  1));
+  tb->check(COND_output,        (core->instr_o         ==  instr[2]) &&
+                                (core->pc_o            ==  pc[2]));
+
+  //`````````````````````````````````
+  //      Formal Checks
+
+  CHECK("tb_prefetch_queue.skip.01",
+      tb->conditions[COND_input_ready],
+      "Failed to implement the input_ready_o signal", tb->err_cycles[COND_input_ready]);
+
+  CHECK("tb_prefetch_queue.skip.02",
+      tb->conditions[COND_output_valid],
+      "Failed to implement the output_valid_o signal", tb->err_cycles[COND_output_valid]);
+
+  CHECK("tb_prefetch_queue.skip.03",
+      tb->conditions[COND_output],
+      "Failed to implement the output signals", tb->err_cycles[COND_output]);
+
+  CHECK("tb_prefetch_queue.skip.04",
+      tb->conditions[COND_next],
+      "Failed to implement the fusion window", tb->err_cycles[COND_next]);
+}
+
+int main(int argc, char ** argv, char ** env) {
+  srand(time(NULL));
+  Verilated::traceEverOn(true);
+
+  bool verbose = parse_verbose(argc, argv);
+
+  TB_Prefetch_queue * tb = new TB_Prefetch_queue;
+  tb->open_trace("waves/prefetch_queue.vcd");
+  tb->open_testdata("testdata/prefetch_queue.csv");
+  tb->set_debug_log(verbose);
+  tb->init_conditions(__CondIdEnd);
+
+  /************************************************************/
+
+  tb_prefetch_queue_reset(tb);
+
+  tb_prefetch_queue_no_stall(tb);
+
+  tb_prefetch_queue_pipeline_wait(tb);
+
+  tb_prefetch_queue_flush(tb);
+
+  tb_prefetch_queue_skip(tb);
+
+  /************************************************************/
+
+  printf("[PREFETCH_QUEUE]: ");
+  if(tb->success) {
+    printf("Done\n");
+  } else {
+    printf("Failed\n");
+  }
+
+  delete tb;
+  exit(EXIT_SUCCESS);
+}
@@ -0,0 +1,253 @@
+/*           __        _
+ *  ________/ /  ___ _(_)__  ___
+ * / __/ __/ _ \/ _ `/ / _ \/ -_)
+ * \__/\__/_//_/\_,_/_/_//_/\__/
+ * 
+ * Copyright (C) Clément Chaine
+ * This file is part of ECAP5-DPROC <https://github.com/ecap5/ECAP5-DPROC>
+ *
+ * ECAP5-DPROC is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ECAP5-DPROC is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ECAP5-DPROC.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <verilated.h>
+#include <verilated_vcd_c.h>
+#include <svdpi.h>
+
+#include "Vtb_registers_w_write_through.h"
+#include "testbench.h"
+
+enum CondId {
+  COND_read,
+  COND_write,
+  __CondIdEnd
+};
+
+enum TestcaseId {
+  T_WRITE_THROUGH      =  1,
+  T_WRITE_THROUGH_X0   =  2,
+  T_WRITE_OTHER        =  3
+};
+
+class TB_Registers_w_write_through : public Testbench<Vtb_registers_w_write_through> {
+public:
+  void reset() {
+    this->set_register(0, 0);
+
+    Testbench<Vtb_registers_w_write_through>::reset();
+  }
+
+  void set_register(uint8_t addr, uint32_t value) {
+    const svScope scope = svGetScopeFromName("TOP.tb_registers_w_write_through.dut");
+    assert(scope);
+    svSetScope(scope);
+    this->core->set_register_value((svLogicVecVal*)&addr, (svLogicVecVal*)&value); 
+  }
+};
+
+void tb_registers_w_write_through_write_through(TB_Registers_w_write_through * tb) {
+  Vtb_registers_w_write_through * core = tb->core;
+  core->testcase = T_WRITE_THROUGH;
+
+  // The following actions are performed in this test :
+  //    tick 0. Set inputs to read register i on both ports and write random data to register i
+  //    tick 1. Set inputs to read register i
+
+  tb->reset();
+
+  for(int i = 1; i < 32; i++) {
+    //`````````````````````````````````
+    //      Set inputs
+    
+    uint32_t previous_value = rand();
+    tb->set_register(i, previous_value);
+
+    uint32_t value = rand();
+    core->raddr1_i = i;
+    core->raddr2_i = i;
+    core->waddr_i = i;
+    core->wdata_i = value;
+    core->write_i = 1;
+
+    // this change is asynchronous
+    core->eval();
+
+    //`````````````````````````````````
+    //      Checks 
+    
+    tb->check(COND_read, (core->rdata1_o == value) &&
+                         (core->rdata2_o == value));
+
+    //=================================
+    //      Tick (0)
+    
+    tb->tick();
+
+    //`````````````````````````````````
+    //      Set inputs
+    
+    core->write_i = 0;
+
+    //=================================
+    //      Tick (1)
+    
+    tb->tick();
+
+    //`````````````````````````````````
+    //      Checks 
+    
+    tb->check(COND_write, (core->rdata1_o == value) &&
+                          (core->rdata2_o == value));
+  }
+
+  //`````````````````````````````````
+  //      Formal Checks 
+  
+  CHECK("tb_registers_w_write_through.write_through.01",
+    tb->conditions[COND_read],
+    "Failed to read the data being written", tb->err_cycles[COND_read]);
+
+  CHECK("tb_registers_w_write_through.write_through.02",
+    tb->conditions[COND_write],
+    "Failed writing to registers", tb->err_cycles[COND_write]);
+}
+
+void tb_registers_w_write_through_x0(TB_Registers_w_write_through * tb) {
+  Vtb_registers_w_write_through * core = tb->core;
+  core->testcase = T_WRITE_THROUGH_X0;
+
+  // The following actions are performed in this test :
+  //    tick 0. Set inputs to read x0 on both ports and write random data to x0
+
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  core->raddr1_i = 0;
+  core->raddr2_i = 0;
+  core->waddr_i = 0;
+  core->wdata_i = 1 + rand();
+  core->write_i = 1;
+
+  // this change is asynchronous
+  core->eval();
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  tb->check(COND_read, (core->rdata1_o == 0) &&
+                       (core->rdata2_o == 0));
+
+  //=================================
+  //      Tick (0)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  core->write_i = 0;
+
+  //`````````````````````````````````
+  //      Formal Checks 
+  
+  CHECK("tb_registers_w_write_through.x0.01",
+    tb->conditions[COND_read],
+    "Failed to prevent reading the data written to x0", tb->err_cycles[COND_read]);
+}
+
+void tb_registers_w_write_through_other(TB_Registers_w_write_through * tb) {
+  Vtb_registers_w_write_through * core = tb->core;
+  core->testcase = T_WRITE_OTHER;
+
+  // The following actions are performed in this test :
+  //    tick 0. Set inputs to read register 5 on port a, 6 on port b and write random data to register 7
+
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  uint32_t value1 = rand();
+  tb->set_register(5, value1);
+  uint32_t value2 = rand();
+  tb->set_register(6, value2);
+
+  core->raddr1_i = 5;
+  core->raddr2_i = 6;
+  core->waddr_i = 7;
+  core->wdata_i = rand();
+  core->write_i = 1;
+
+  // this change is asynchronous
+  core->eval();
+
+  //`````````````````````````````````
+  //      Checks 
+  
+  tb->check(COND_read, (core->rdata1_o == value1) &&
+                       (core->rdata2_o == value2));
+
+  //=================================
+  //      Tick (0)
+  
+  tb->tick();
+
+  //`````````````````````````````````
+  //      Set inputs
+  
+  core->write_i = 0;
+
+  //`````````````````````````````````
+  //      Formal Checks 
+  
+  CHECK("tb_registers_w_write_through.other.01",
+    tb->conditions[COND_read],
+    "Failed to read registers not being written", tb->err_cycles[COND_read]);
+}
+
+int main(int argc, char ** argv, char ** env) {
+  srand(time(NULL));
+  Verilated::traceEverOn(true);
+
+  // Check arguments
+  bool verbose = parse_verbose(argc, argv);
+
+  TB_Registers_w_write_through * tb = new TB_Registers_w_write_through();
+  tb->open_trace("waves/registers_w_write_through.vcd");
+  tb->open_testdata("testdata/registers_w_write_through.csv");
+  tb->set_debug_log(verbose);
+  tb->init_conditions(__CondIdEnd);
+
+  /************************************************************/
+
+  tb_registers_w_write_through_write_through(tb);
+  tb_registers_w_write_through_x0(tb);
+  tb_registers_w_write_through_other(tb);
+
+  /************************************************************/
+
+  printf("[REGISTERS_W_WRITE_THROUGH]: ");
+  if(tb->success) {
+    printf("Done\n");
+  } else {
+    printf("Failed\n");
+  }
+
+  delete tb;
+  exit(EXIT_SUCCESS);
+}
@@ -0,0 +1,756 @@
+/*           __        _
+ *  ________/ /  ___ _(_)__  ___
+ * / __/ __/ _ \/ _ `/ / _ \/ -_)
+ * \__/\__/_//_/\_,_/_/_//_/\__/
+ * 
+ * Copyright (C) Clément Chaine
+ * This file is part of ECAP5-DPROC <https://github.com/ecap5/ECAP5-DPROC>
+ *
+ * ECAP5-DPROC is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ECAP5-DPROC is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ECAP5-DPROC.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <verilated.h>
+#include <verilated_vcd_c.h>
+#include <svdpi.h>
+#include <deque>
+#include <map>
+#include <vector>
+
+#include "Vtb_tcm.h"
+#include "testbench.h"
+#include "wishbone_slave.h"
+#include "Vtb_tcm_tb_tcm.h"
+
+enum CondId {
+  COND_wb,
+  COND_data,
+  COND_forward,
+  COND_throughput,
+  COND_shared,
+  __CondIdEnd
+};
+
+enum TestcaseId {
+  T_RESET        =  1,
+  T_ACCESS       =  2,
+  T_BYTE_ENABLE  =  3,
+  T_FORWARD      =  4,
+  T_MEMORY_WAIT  =  5,
+  T_SECOND_PORT  =  6
+};
+
+struct Access {
+  bool we;
+  uint32_t adr;
+  uint32_t dat;
+  uint8_t sel;
+};
+
+// Signals of a slave port and of its master port
+struct Signals {
+  uint32_t * s_wb_adr_i;
+  uint32_t * s_wb_dat_o;
+  uint32_t * s_wb_dat_i;
+  uint8_t * s_wb_we_i;
+  uint8_t * s_wb_sel_i;
+  uint8_t * s_wb_stb_i;
+  uint8_t * s_wb_ack_o;
+  uint8_t * s_wb_cyc_i;
+  uint8_t * s_wb_stall_o;
+  uint32_t * m_wb_adr_o;
+  uint32_t * m_wb_dat_i;
+  uint32_t * m_wb_dat_o;
+  uint8_t * m_wb_we_o;
+  uint8_t * m_wb_sel_o;
+  uint8_t * m_wb_stb_o;
+  uint8_t * m_wb_ack_i;
+  uint8_t * m_wb_cyc_o;
+  uint8_t * m_wb_stall_i;
+};
+
+struct Port {
+  Signals sig;
+
+  // Pipelined wishbone master model
+  std::deque<Access> queue;
+  std::deque<Access> outstanding;
+  std::vector<Access> completed;
+  std::vector<uint32_t> responses;
+  // Cycles at which the requests were accepted and acknowledged
+  std::vector<uint32_t> issued, acknowledged;
+  uint32_t unexpected_acks;
+  // Set when the request at the front of the queue was accepted
+  bool accepted;
+
+  // Pipelined wishbone slave model of the memory behind the port
+  WishboneSlave<Access> slave;
+  // Requests received by the memory
+  std::vector<Access> transfers;
+  // Bytes written to the memory
+  std::map<uint32_t, uint8_t> written;
+
+  void clear() {
+    this->completed.clear();
+    this->responses.clear();
+    this->issued.clear();
+    this->acknowledged.clear();
+  }
+};
+
+class TB_Tcm : public Testbench<Vtb_tcm> {
+public:
+  // Slave port and slave port 2
+  Port ports[2];
+  uint32_t cycle;
+
+  void reset() {
+    this->ports[0].sig = {&this->core->s_wb_adr_i, &this->core->s_wb_dat_o, &this->core->s_wb_dat_i,
+                          &this->core->s_wb_we_i, &this->core->s_wb_sel_i, &this->core->s_wb_stb_i,
+                          &this->core->s_wb_ack_o, &this->core->s_wb_cyc_i, &this->core->s_wb_stall_o,
+                          &this->core->m_wb_adr_o, &this->core->m_wb_dat_i, &this->core->m_wb_dat_o,
+                          &this->core->m_wb_we_o, &this->core->m_wb_sel_o, &this->core->m_wb_stb_o,
+                          &this->core->m_wb_ack_i, &this->core->m_wb_cyc_o, &this->core->m_wb_stall_i};
+    this->ports[1].sig = {&this->core->s2_wb_adr_i, &this->core->s2_wb_dat_o, &this->core->s2_wb_dat_i,
+                          &this->core->s2_wb_we_i, &this->core->s2_wb_sel_i, &this->core->s2_wb_stb_i,
+                          &this->core->s2_wb_ack_o, &this->core->s2_wb_cyc_i, &this->core->s2_wb_stall_o,
+                          &this->core->m2_wb_adr_o, &this->core->m2_wb_dat_i, &this->core->m2_wb_dat_o,
+                          &this->core->m2_wb_we_o, &this->core->m2_wb_sel_o, &this->core->m2_wb_stb_o,
+                          &this->core->m2_wb_ack_i, &this->core->m2_wb_cyc_o, &this->core->m2_wb_stall_i};
+
+    for(Port & port : this->ports) {
+      port.queue.clear();
+      port.outstanding.clear();
+      port.clear();
+      port.unexpected_acks = 0;
+      port.slave.latency = 0;
+      port.slave.random_stall = false;
+      this->drive(port);
+      *port.sig.m_wb_dat_i = 0;
+      *port.sig.m_wb_ack_i = 0;
+      *port.sig.m_wb_stall_i = 0;
+    }
+    this->cycle = 0;
+
+    this->core->rst_i = 1;
+    for(int i = 0; i < 5; i++) {
+      Testbench<Vtb_tcm>::tick();
+    }
+    this->core->rst_i = 0;
+
+    for(Port & port : this->ports) {
+      port.slave.clear();
+      port.transfers.clear();
+      port.written.clear();
+    }
+
+    Testbench<Vtb_tcm>::reset();
+  }
+
+  bool in_tcm(uint32_t adr) {
+    return (adr >= this->core->tb_tcm->BASE) &&
+           (adr < this->core->tb_tcm->BASE + (uint32_t)this->core->tb_tcm->SIZE);
+  }
+
+  static uint8_t initial_byte(uint32_t adr) {
+    return ((adr * 2654435761u) >> 13) & 0xFF;
+  }
+
+  uint8_t byte(const std::map<uint32_t, uint8_t> & bytes, uint32_t adr) {
+    auto it = bytes.find(adr);
+    return (it != bytes.end()) ? it->second : initial_byte(adr);
+  }
+
+  static void store(std::map<uint32_t, uint8_t> & bytes, const Access & access) {
+    for(int i = 0; i < 4; i++) {
+      if(access.sel & (1 << i)) {
+        bytes[access.adr + i] = (access.dat >> (8 * i)) & 0xFF;
+      }
+    }
+  }
+
+  uint32_t load(const std::map<uint32_t, uint8_t> & bytes, const Access & access) {
+    uint32_t data = 0;
+    for(int i = 0; i < 4; i++) {
+      if(access.sel & (1 << i)) {
+        data |= this->byte(bytes, access.adr + i) << (8 * i);
+      }
+    }
+    return data;
+  }
+
+  void drive(Port & port) {
+    bool stb = !port.queue.empty();
+    *port.sig.s_wb_adr_i = stb ? port.queue.front().adr : 0;
+    *port.sig.s_wb_dat_i = stb ? port.queue.front().dat : 0;
+    *port.sig.s_wb_we_i  = stb ? port.queue.front().we  : 0;
+    *port.sig.s_wb_sel_i = stb ? port.queue.front().sel : 0;
+    *port.sig.s_wb_stb_i = stb;
+    *port.sig.s_wb_cyc_i = stb || !port.outstanding.empty();
+  }
+
+  void respond(Port & port) {
+    Access request = {(bool)*port.sig.m_wb_we_o, *port.sig.m_wb_adr_o,
+                      *port.sig.m_wb_dat_o, *port.sig.m_wb_sel_o};
+    if(port.slave.accept(this->cycle, *port.sig.m_wb_stb_o, *port.sig.m_wb_cyc_o, *port.sig.m_wb_stall_i,
+                         request)) {
+      port.transfers.push_back(request);
+    }
+    Access access;
+    if(port.slave.respond(this->cycle, access)) {
+      *port.sig.m_wb_ack_i = 1;
+      if(access.we) {
+        store(port.written, access);
+      } else {
+        *port.sig.m_wb_dat_i = this->load(port.written, access);
+      }
+    }
+  }
+
+  void complete(Port & port) {
+    bool stb = *port.sig.s_wb_stb_i;
+    port.accepted = stb && !*port.sig.s_wb_stall_o;
+    if(*port.sig.s_wb_ack_o) {
+      if(!port.outstanding.empty()) {
+        port.completed.push_back(port.outstanding.front());
+        port.responses.push_back(*port.sig.s_wb_dat_o);
+        port.acknowledged.push_back(this->cycle);
+        port.outstanding.pop_front();
+      } else if(port.accepted) {
+        // Response provided during the cycle of the request
+        port.completed.push_back(port.queue.front());
+        port.responses.push_back(*port.sig.s_wb_dat_o);
+        port.acknowledged.push_back(this->cycle);
+        port.issued.push_back(this->cycle);
+        port.queue.pop_front();
+        port.accepted = false;
+      } else {
+        port.unexpected_acks += 1;
+      }
+    }
+  }
+
+  void tick() {
+    for(Port & port : this->ports) {
+      this->drive(port);
+      *port.sig.m_wb_ack_i = 0;
+      *port.sig.m_wb_dat_i = 0;
+    }
+    this->core->eval();
+
+    for(Port & port : this->ports) {
+      this->respond(port);
+    }
+    this->core->eval();
+
+    for(Port & port : this->ports) {
+      this->complete(port);
+    }
+
+    Testbench<Vtb_tcm>::tick();
+
+    for(Port & port : this->ports) {
+      if(port.accepted) {
+        port.outstanding.push_back(port.queue.front());
+        port.issued.push_back(this->cycle);
+        port.queue.pop_front();
+      }
+      *port.sig.m_wb_stall_i = port.slave.stall();
+    }
+    this->cycle += 1;
+  }
+
+  void run(uint32_t cycles) {
+    for(uint32_t i = 0; i < cycles; i++) {
+      this->tick();
+    }
+  }
+
+  // Random access in the given words of the memory range, or outside of the
+  // memory range
+  Access random_access(bool tcm, uint32_t first_word, uint32_t words) {
+    const uint8_t sels[3] = {0x1, 0x3, 0xF};
+    Access access;
+    access.we = rand() % 2;
+    access.sel = sels[rand() % 3];
+    uint32_t base = tcm ? this->core->tb_tcm->BASE + 4 * first_word : 0x8000;
+    access.adr = base + (rand() % words) * 4 +
+                 ((access.sel == 0x1) ? (rand() % 4) : (access.sel == 0x3) ? 2 * (rand() % 2) : 0);
+    access.dat = rand();
+    if(access.sel != 0xF) {
+      access.dat &= (access.sel == 0x1) ? 0xFF : 0xFFFF;
+    }
+    return access;
+  }
+
+  Access random_access(bool tcm) {
+    return this->random_access(tcm, 0, this->core->tb_tcm->SIZE / 4);
+  }
+
+  // Checks that the accesses were completed in order with the data of a
+  // reference model replaying them
+  bool completions_match(const Port & port, const std::vector<Access> & accesses) {
+    if((port.completed.size() != accesses.size()) || (port.unexpected_acks != 0)) {
+      return false;
+    }
+    std::map<uint32_t, uint8_t> tcm, memory;
+    for(size_t i = 0; i < accesses.size(); i++) {
+      const Access & access = accesses[i];
+      if((port.completed[i].adr != access.adr) || (port.completed[i].we != access.we)) {
+        return false;
+      }
+      std::map<uint32_t, uint8_t> & bytes = this->in_tcm(access.adr) ? tcm : memory;
+      if(access.we) {
+        store(bytes, access);
+      } else if(port.responses[i] != this->load(bytes, access)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // Checks that only the accesses outside of the memory range were forwarded
+  bool transfers_match(const Port & port, const std::vector<Access> & accesses) {
+    std::vector<Access> forwarded;
+    for(const Access & access : accesses) {
+      if(!this->in_tcm(access.adr)) {
+        forwarded.push_back(access);
+      }
+    }
+    if(forwarded.size() != port.transfers.size()) {
+      return false;
+    }
+    for(size_t i = 0; i < forwarded.size(); i++) {
+      if((forwarded[i].adr != port.transfers[i].adr) || (forwarded[i].we != port.transfers[i].we) ||
+         (forwarded[i].sel != port.transfers[i].sel) ||
+         (forwarded[i].we && (forwarded[i].dat != port.transfers[i].dat))) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // Initializes the whole memory range with the reference content
+  void fill() {
+    for(uint32_t i = 0; i < (uint32_t)this->core->tb_tcm->SIZE; i += 4) {
+      uint32_t adr = this->core->tb_tcm->BASE + i;
+      this->ports[0].queue.push_back({true, adr, this->load(std::map<uint32_t, uint8_t>(), {false, adr, 0, 0xF}), 0xF});
+    }
+    this->run(this->core->tb_tcm->SIZE / 4 + 2);
+    for(Port & port : this->ports) {
+      port.clear();
+    }
+    this->cycle = 0;
+  }
+};
+
+void tb_tcm_reset(TB_Tcm * tb) {
+  Vtb_tcm * core = tb->core;
+  core->testcase = T_RESET;
+
+  //=================================
+  //      Tick (0)
+
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_wb, (core->s_wb_ack_o == 0) &&
+                     (core->s2_wb_ack_o == 0) &&
+                     (core->m_wb_stb_o == 0) &&
+                     (core->m_wb_cyc_o == 0) &&
+                     (core->m2_wb_stb_o == 0) &&
+                     (core->m2_wb_cyc_o == 0));
+
+  //`````````````````````````````````
+  //      Formal Checks
+
+  CHECK("tb_tcm.reset.01",
+      tb->conditions[COND_wb],
+      "Failed to reset the module", tb->err_cycles[COND_wb]);
+}
+
+void tb_tcm_access(TB_Tcm * tb) {
+  Vtb_tcm * core = tb->core;
+  core->testcase = T_ACCESS;
+
+  // The following actions are performed in this test :
+  //    tick 0. Issue back-to-back word writes and reads in the memory range
+  //    tick 1-99. Nothing (core acknowledges each request on the following
+  //               cycle)
+
+  //=================================
+  //      Tick (0)
+
+  tb->reset();
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  const uint32_t count = 16;
+  std::vector<Access> accesses;
+  for(uint32_t i = 0; i < count; i++) {
+    accesses.push_back({true, core->tb_tcm->BASE + 4 * i, (uint32_t)rand(), 0xF});
+  }
+  for(uint32_t i = 0; i < count; i++) {
+    accesses.push_back({false, core->tb_tcm->BASE + 4 * i, 0, 0xF});
+  }
+  for(const Access & access : accesses) {
+    tb->ports[0].queue.push_back(access);
+  }
+
+  //=================================
+  //      Tick (0-99)
+
+  tb->run(100);
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_data,       tb->completions_match(tb->ports[0], accesses));
+  tb->check(COND_forward,    tb->ports[0].transfers.empty());
+  tb->check(COND_throughput, (tb->ports[0].issued.size() == 2 * count) &&
+                             (tb->ports[0].acknowledged.size() == 2 * count));
+  for(uint32_t i = 0; i < tb->ports[0].issued.size() && i < tb->ports[0].acknowledged.size(); i++) {
+    tb->check(COND_throughput, (tb->ports[0].issued[i] == i) && (tb->ports[0].acknowledged[i] == i + 1));
+  }
+
+  //`````````````````````````````````
+  //      Formal Checks
+
+  CHECK("tb_tcm.access.01",
+      tb->conditions[COND_data],
+      "Failed to read the written data", tb->err_cycles[COND_data]);
+
+  CHECK("tb_tcm.access.02",
+      tb->conditions[COND_forward],
+      "Failed to serve the requests without forwarding them", tb->err_cycles[COND_forward]);
+
+  CHECK("tb_tcm.access.03",
+      tb->conditions[COND_throughput],
+      "Failed to acknowledge each request on the following cycle", tb->err_cycles[COND_throughput]);
+}
+
+void tb_tcm_byte_enable(TB_Tcm * tb) {
+  Vtb_tcm * core = tb->core;
+  core->testcase = T_BYTE_ENABLE;
+
+  // The following actions are performed in this test :
+  //    tick 0. Fill the memory, then issue byte and halfword writes and
+  //            reads at every offset
+  //    tick 1-99. Nothing
+
+  //=================================
+  //      Tick (0)
+
+  tb->reset();
+  tb->fill();
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  std::vector<Access> accesses;
+  uint32_t base = core->tb_tcm->BASE + 4 * (rand() % (core->tb_tcm->SIZE / 4));
+  for(uint32_t offset = 0; offset < 4; offset++) {
+    accesses.push_back({true, base + offset, (uint32_t)rand() & 0xFF, 0x1});
+    accesses.push_back({false, base, 0, 0xF});
+  }
+  for(uint32_t offset = 0; offset < 4; offset += 2) {
+    accesses.push_back({true, base + offset, (uint32_t)rand() & 0xFFFF, 0x3});
+    accesses.push_back({false, base + offset, 0, 0x3});
+    accesses.push_back({false, base + offset + 1, 0, 0x1});
+  }
+  for(const Access & access : accesses) {
+    tb->ports[0].queue.push_back(access);
+  }
+
+  //=================================
+  //      Tick (0-99)
+
+  tb->run(100);
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_data, tb->completions_match(tb->ports[0], accesses));
+
+  //`````````````````````````````````
+  //      Formal Checks
+
+  CHECK("tb_tcm.byte_enable.01",
+      tb->conditions[COND_data],
+      "Failed to implement the byte enables", tb->err_cycles[COND_data]);
+}
+
+void tb_tcm_forward(TB_Tcm * tb) {
+  Vtb_tcm * core = tb->core;
+  core->testcase = T_FORWARD;
+
+  // The following actions are performed in this test :
+  //    tick 0. Fill the memory, then issue back-to-back reads alternating
+  //            between the memory range and the forwarded range on a slow
+  //            memory
+  //    tick 1-299. Nothing (core returns the responses in order)
+
+  //=================================
+  //      Tick (0)
+
+  tb->reset();
+  tb->fill();
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  tb->ports[0].slave.latency = 1 + rand() % 4;
+  const uint32_t count = 16;
+  std::vector<Access> accesses;
+  for(uint32_t i = 0; i < count; i++) {
+    accesses.push_back({false, core->tb_tcm->BASE + 4 * (rand() % (core->tb_tcm->SIZE / 4)), 0, 0xF});
+    accesses.push_back({false, 0x8000 + 4 * (uint32_t)(rand() % 256), 0, 0xF});
+    accesses.push_back({false, 0x8000 + 4 * (uint32_t)(rand() % 256), 0, 0xF});
+  }
+  for(const Access & access : accesses) {
+    tb->ports[0].queue.push_back(access);
+  }
+
+  //=================================
+  //      Tick (0-299)
+
+  tb->run(300);
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_data,    tb->completions_match(tb->ports[0], accesses));
+  tb->check(COND_forward, tb->transfers_match(tb->ports[0], accesses));
+
+  //`````````````````````````````````
+  //      Formal Checks
+
+  CHECK("tb_tcm.forward.01",
+      tb->conditions[COND_data],
+      "Failed to return the responses in order", tb->err_cycles[COND_data]);
+
+  CHECK("tb_tcm.forward.02",
+      tb->conditions[COND_forward],
+      "Failed to forward the requests outside of the memory range", tb->err_cycles[COND_forward]);
+}
+
+void tb_tcm_memory_wait(TB_Tcm * tb) {
+  Vtb_tcm * core = tb->core;
+  core->testcase = T_MEMORY_WAIT;
+
+  // The following actions are performed in this test :
+  //    tick 0. Fill the memory, then issue random accesses on both ranges
+  //            on a slow and stalling memory
+  //    tick 1-1999. Nothing
+
+  //=================================
+  //      Tick (0)
+
+  tb->reset();
+  tb->fill();
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  tb->ports[0].slave.latency = rand() % 8;
+  tb->ports[0].slave.random_stall = true;
+  const uint32_t count = 64;
+  std::vector<Access> accesses;
+  for(uint32_t i = 0; i < count; i++) {
+    accesses.push_back(tb->random_access(rand() % 2));
+    tb->ports[0].queue.push_back(accesses.back());
+  }
+
+  //=================================
+  //      Tick (0-1999)
+
+  tb->run(2000);
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_data,    tb->completions_match(tb->ports[0], accesses));
+  tb->check(COND_forward, tb->transfers_match(tb->ports[0], accesses));
+
+  //`````````````````````````````````
+  //      Formal Checks
+
+  CHECK("tb_tcm.memory_wait.01",
+      tb->conditions[COND_data],
+      "Failed to return the responses in order", tb->err_cycles[COND_data]);
+
+  CHECK("tb_tcm.memory_wait.02",
+      tb->conditions[COND_forward],
+      "Failed to forward the requests outside of the memory range", tb->err_cycles[COND_forward]);
+}
+
+void tb_tcm_second_port(TB_Tcm * tb) {
+  Vtb_tcm * core = tb->core;
+  core->testcase = T_SECOND_PORT;
+
+  // The following actions are performed in this test :
+  //    tick 0. Fill the memory, then issue back-to-back reads in the lower
+  //            half of the memory range on the slave port and random
+  //            accesses in the upper half and in the forwarded range on the
+  //            slave port 2, with a slow and stalling memory behind the
+  //            master port 2
+  //    tick 1-1999. Nothing (core serves both ports independently)
+  //    tick 2000. Write words of the lower half on the slave port 2
+  //    tick 2001-2099. Nothing
+  //    tick 2100. Read the words back on the slave port
+  //    tick 2101-2199. Nothing
+
+  //=================================
+  //      Tick (0)
+
+  tb->reset();
+  tb->fill();
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  const uint32_t words = core->tb_tcm->SIZE / 4;
+  const uint32_t count = 32;
+  std::vector<Access> accesses, accesses2;
+  for(uint32_t i = 0; i < count; i++) {
+    accesses.push_back({false, core->tb_tcm->BASE + 4 * (rand() % (words / 2)), 0, 0xF});
+    tb->ports[0].queue.push_back(accesses.back());
+  }
+  tb->ports[1].slave.latency = rand() % 8;
+  tb->ports[1].slave.random_stall = true;
+  for(uint32_t i = 0; i < 2 * count; i++) {
+    accesses2.push_back(tb->random_access(rand() % 2, words / 2, words / 2));
+    tb->ports[1].queue.push_back(accesses2.back());
+  }
+
+  //=================================
+  //      Tick (0-1999)
+
+  tb->run(2000);
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_data,       tb->completions_match(tb->ports[0], accesses) &&
+                             tb->completions_match(tb->ports[1], accesses2));
+  tb->check(COND_forward,    tb->transfers_match(tb->ports[0], accesses) &&
+                             tb->transfers_match(tb->ports[1], accesses2));
+  tb->check(COND_throughput, (tb->ports[0].issued.size() == count) &&
+                             (tb->ports[0].acknowledged.size() == count));
+  for(uint32_t i = 0; i < tb->ports[0].issued.size() && i < tb->ports[0].acknowledged.size(); i++) {
+    tb->check(COND_throughput, (tb->ports[0].issued[i] == i) && (tb->ports[0].acknowledged[i] == i + 1));
+  }
+
+  //=================================
+  //      Tick (2000)
+
+  for(Port & port : tb->ports) {
+    port.clear();
+  }
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  std::vector<uint32_t> data;
+  for(uint32_t i = 0; i < words / 2; i++) {
+    data.push_back(rand());
+    tb->ports[1].queue.push_back({true, core->tb_tcm->BASE + 4 * i, data.back(), 0xF});
+  }
+
+  //=================================
+  //      Tick (2000-2099)
+
+  tb->run(100);
+
+  //=================================
+  //      Tick (2100)
+
+  //`````````````````````````````````
+  //      Set inputs
+
+  for(uint32_t i = 0; i < words / 2; i++) {
+    tb->ports[0].queue.push_back({false, core->tb_tcm->BASE + 4 * i, 0, 0xF});
+  }
+
+  //=================================
+  //      Tick (2100-2199)
+
+  tb->run(100);
+
+  //`````````````````````````````````
+  //      Checks
+
+  tb->check(COND_shared, tb->ports[0].responses == data);
+
+  //`````````````````````````````````
+  //      Formal Checks
+
+  CHECK("tb_tcm.second_port.01",
+      tb->conditions[COND_data],
+      "Failed to return the responses of both ports in order", tb->err_cycles[COND_data]);
+
+  CHECK("tb_tcm.second_port.02",
+      tb->conditions[COND_forward],
+      "Failed to forward the requests of each port to its master port", tb->err_cycles[COND_forward]);
+
+  CHECK("tb_tcm.second_port.03",
+      tb->conditions[COND_throughput],
+      "Failed to serve the slave port independently of the slave port 2", tb->err_cycles[COND_throughput]);
+
+  CHECK("tb_tcm.second_port.04",
+      tb->conditions[COND_shared],
+      "Failed to share the memory between the ports", tb->err_cycles[COND_shared]);
+}
+
+int main(int argc, char ** argv, char ** env) {
+  srand(time(NULL));
+  Verilated::traceEverOn(true);
+
+  bool verbose = parse_verbose(argc, argv);
+
+  TB_Tcm * tb = new TB_Tcm;
+  tb->open_trace("waves/tcm.vcd");
+  tb->open_testdata("testdata/tcm.csv");
+  tb->set_debug_log(verbose);
+  tb->init_conditions(__CondIdEnd);
+
+  /************************************************************/
+
+  tb_tcm_reset(tb);
+
+  tb_tcm_access(tb);
+  tb_tcm_byte_enable(tb);
+  tb_tcm_forward(tb);
+
+  tb_tcm_memory_wait(tb);
+
+  tb_tcm_second_port(tb);
+
+  /************************************************************/
+
+  printf("[TCM]: ");
+  if(tb->success) {
+    printf("Done\n");
+  } else {
+    printf("Failed\n");
+  }
+
+  delete tb;
+  exit(EXIT_SUCCESS);
+}
@@ -0,0 +1,142 @@
+/*           __        _
+ *  ________/ /  ___ _(_)__  ___
+ * / __/ __/ _ \/ _ `/ / _ \/ -_)
+ * \__/\__/_//_/\_,_/_/_//_/\__/
+ *
+ * Copyright (C) Clément Chaine
+ * This file is part of ECAP5-DPROC <https://github.com/ecap5/ECAP5-DPROC>
+ *
+ * ECAP5-DPROC is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ECAP5-DPROC is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ECAP5-DPROC.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef WISHBONE_MASTER_H
+#define WISHBONE_MASTER_H
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <deque>
+#include <vector>
+
+struct WishboneAccess {
+  bool we;
+  uint32_t adr;
+  uint32_t dat;
+  uint8_t sel;
+};
+
+struct WishboneCompletion {
+  uint32_t cycle;
+  WishboneAccess access;
+  uint32_t dat;
+  // Number of cycles between the start of the bus cycle and the acknowledge
+  uint32_t wait;
+};
+
+/*
+ * Wishbone master model shared by the benches, performing one access at a
+ * time. The bus cycle is released after each acknowledge for one cycle, plus
+ * up to max_gap random cycles. The signals are driven and sampled by the
+ * bench, the model being updated after the clock edge.
+ */
+class WishboneMaster {
+public:
+  std::deque<WishboneAccess> queue;
+  WishboneAccess current;
+  bool active;
+  bool stb;
+  // Maximum number of additional cycles released after each acknowledge
+  uint32_t max_gap;
+  std::vector<WishboneCompletion> completions;
+  // Number of acknowledges received outside of a bus cycle
+  uint32_t unexpected_acks;
+
+  WishboneMaster() {
+    this->clear();
+  }
+
+  void clear() {
+    this->queue.clear();
+    this->active = false;
+    this->stb = false;
+    this->max_gap = 0;
+    this->completions.clear();
+    this->unexpected_acks = 0;
+    this->start_cycle = 0;
+    this->rest = 0;
+    this->accepted = false;
+    this->acknowledged = false;
+  }
+
+  // Starts the next access of the queue once the bus cycle was released
+  void start(uint32_t cycle) {
+    if(!this->active && (this->rest == 0) && !this->queue.empty()) {
+      this->current = this->queue.front();
+      this->queue.pop_front();
+      this->active = true;
+      this->stb = true;
+      this->start_cycle = cycle;
+    }
+  }
+
+  // Values of the signals driven during the cycle
+  uint32_t adr() const { return this->active ? this->current.adr : 0; }
+  uint32_t dat() const { return this->active ? this->current.dat : 0; }
+  uint8_t  we()  const { return this->active ? this->current.we  : 0; }
+  uint8_t  sel() const { return this->active ? this->current.sel : 0; }
+  uint8_t  cyc() const { return this->active; }
+
+  // Registers the response of the slave during the cycle
+  void sample(uint32_t cycle, bool stall, bool ack, uint32_t dat) {
+    this->accepted = this->stb && !stall;
+    this->acknowledged = false;
+    if(ack) {
+      if(this->active) {
+        this->completions.push_back({cycle, this->current, dat, cycle - this->start_cycle});
+        this->acknowledged = true;
+      } else {
+        this->unexpected_acks += 1;
+      }
+    }
+  }
+
+  // Updates the model after the clock edge
+  void update() {
+    if(this->accepted) {
+      this->stb = false;
+    }
+    if(this->acknowledged) {
+      this->active = false;
+      this->rest = 1 + ((this->max_gap > 0) ? (rand() % (this->max_gap + 1)) : 0);
+    } else if(!this->active && (this->rest > 0)) {
+      this->rest -= 1;
+    }
+  }
+
+  uint32_t total_wait() const {
+    uint32_t total = 0;
+    for(size_t i = 0; i < this->completions.size(); i++) {
+      total += this->completions[i].wait;
+    }
+    return total;
+  }
+
+private:
+  uint32_t start_cycle;
+  // Number of cycles before the next access can be started
+  uint32_t rest;
+  bool accepted;
+  bool acknowledged;
+};
+
+#endif // WISHBONE_MASTER_H
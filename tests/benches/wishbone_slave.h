@@ -0,0 +1,89 @@
+/*           __        _
+ *  ________/ /  ___ _(_)__  ___
+ * / __/ __/ _ \/ _ `/ / _ \/ -_)
+ * \__/\__/_//_/\_,_/_/_//_/\__/
+ *
+ * Copyright (C) Clément Chaine
+ * This file is part of ECAP5-DPROC <https://github.com/ecap5/ECAP5-DPROC>
+ *
+ * ECAP5-DPROC is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ECAP5-DPROC is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ECAP5-DPROC.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef WISHBONE_SLAVE_H
+#define WISHBONE_SLAVE_H
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <deque>
+
+/*
+ * Pipelined wishbone slave model shared by the benches.
+ * A request is accepted when not stalled and acknowledged after latency
+ * cycles. The acknowledge is provided during the same cycle when latency is
+ * null. The responses are provided in order, the data of the acknowledged
+ * request being left to the bench.
+ */
+template<typename T>
+class WishboneSlave {
+public:
+  uint32_t latency;
+  bool random_stall;
+
+  WishboneSlave() : latency(0), random_stall(false) {}
+
+  // Drops the requests in flight
+  void clear() {
+    this->requests.clear();
+  }
+
+  // Registers the request driven by the master during the cycle, returning
+  // whether it was accepted
+  bool accept(uint32_t cycle, bool stb, bool cyc, bool stall, const T & request) {
+    if(stb && cyc && !stall) {
+      this->requests.push_back({cycle + this->latency, request});
+      return true;
+    }
+    return false;
+  }
+
+  // Returns whether a request is acknowledged during the cycle, the
+  // acknowledged request being provided through request
+  bool respond(uint32_t cycle, T & request) {
+    if(!this->requests.empty() && (this->requests.front().due <= cycle)) {
+      request = this->requests.front().request;
+      this->requests.pop_front();
+      return true;
+    }
+    return false;
+  }
+
+  // Number of requests accepted and not yet acknowledged
+  uint32_t in_flight() const {
+    return this->requests.size();
+  }
+
+  // Value of the stall signal for the next cycle
+  uint8_t stall() const {
+    return this->random_stall ? (rand() % 2) : 0;
+  }
+
+private:
+  struct Pending {
+    uint32_t due;
+    T request;
+  };
+  std::deque<Pending> requests;
+};
+
+#endif // WISHBONE_SLAVE_H
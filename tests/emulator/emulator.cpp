@@ -26,7 +26,9 @@
 #include <verilated.h>
 #include <verilated_vcd_c.h>
 #include <svdpi.h>
+#include <deque>
 
+#include "Vecap5_dproc_ecap5_dproc_pkg.h"
 #include "Vecap5_dproc.h"
 #include "testbench.h"
 #include "elf.h"
@@ -39,14 +41,44 @@
 #define OUTPUT_ADDRESS 0x80000000
 #define END_ADDRESS 0xA0000000
 
+// State of the memory model serving a wishbone bus
+struct Bus {
+  bool pending;   // A request is being stalled
+  uint32_t wait;  // Remaining stall cycles of the pending request
+  bool burst;     // The last request was part of an incrementing burst
+  uint32_t next;  // Address of the next request of the burst
+};
+
+// Transaction received by the AXI4 memory model
+struct Transaction {
+  uint32_t due;   // Cycle from which the response is provided
+  uint32_t addr;
+  uint32_t data;
+  uint8_t strb;
+};
+
 class TB_Emulator: public Testbench<Vecap5_dproc> {
 public:
   uint8_t memory[MAX_BINARY_SIZE];
   bool is_done;
+  // Cycles during which the first request of a bus cycle is stalled
+  uint32_t latency = 0;
+  Bus wb, ibus, dbus;
+  // State of the AXI4 memory model
+  std::deque<Transaction> axi_aw, axi_w, axi_reads, axi_writes;
+  uint32_t axi_read_count, axi_write_count, axi_max_in_flight;
 
   void reset() {
     this->is_done = 0;
     this->tickcount = 0;
+    this->wb = this->ibus = this->dbus = {0, 0, 0, 0};
+    this->axi_aw.clear();
+    this->axi_w.clear();
+    this->axi_reads.clear();
+    this->axi_writes.clear();
+    this->axi_read_count = 0;
+    this->axi_write_count = 0;
+    this->axi_max_in_flight = 0;
 
     this->core->rst_i = 1;
     for(int i = 0; i < 5; i++) {
@@ -57,73 +89,198 @@ public:
     Testbench<Vecap5_dproc>::reset();
   }
 
-  void tick() {
-    static uint8_t state = 0;
-
-    // handle wishbone bus
-    switch(state) {
-      case 0: {
-        if((this->core->wb_stb_o == 1) && (this->core->wb_cyc_o == 1)) {
-          uint32_t data = 0;
-          // check test end
-          if(this->core->wb_adr_o == END_ADDRESS) {
-            this->is_done = 1;
-          } else if(this->core->wb_adr_o == OUTPUT_ADDRESS && this->core->wb_we_o == 1) {
-            char c = this->core->wb_dat_o & 0xFF;
-            printf("%c", c);
-          // check overflow
-          } else if(this->core->wb_adr_o >= MAX_BINARY_SIZE) {
-            printf("Runtime memory overflow\n  Requested address : %08x, Memory end address : %08x\n\n", this->core->wb_adr_o, MAX_BINARY_SIZE-1);
-          } else {
-            if(this->core->wb_we_o == 0) {
-              // Read
-              memcpy(&data, memory + this->core->wb_adr_o, 4);
-              switch(this->core->wb_sel_o) {
-                case 0x1:
-                  data &= 0xFF;
-                  break;
-                case 0x3:
-                  data &= 0xFFFF;
-                  break;
-                case 0xF:
-                  break;
-                default:
-                  printf("Invalid wishbone sel signal during read: %08x\n", this->core->wb_sel_o);
-                  break;
+  /*
+   * Serves a request of one of the wishbone masters of the core.
+   * The first request of a bus cycle is stalled during latency cycles before
+   * being acknowledged, the following requests of an incrementing burst
+   * being acknowledged during the cycle they are issued.
+   */
+  void serve(Bus & bus, uint32_t adr, uint32_t dat_o, uint8_t we, uint8_t sel, uint8_t stb, uint8_t cyc,
+             uint8_t cti, uint32_t * dat_i, uint8_t * ack, uint8_t * stall) {
+    uint32_t data = 0;
+    *ack = 0;
+    *stall = 0;
+    if(cyc == 0) {
+      bus.burst = 0;
+    }
+    if((stb == 1) && (cyc == 1)) {
+      if(!bus.burst || (adr != bus.next)) {
+        bus.burst = 0;
+        if(!bus.pending) {
+          bus.pending = 1;
+          bus.wait = this->latency;
+        }
+        if(bus.wait > 0) {
+          // The request is held by the master until accepted
+          bus.wait -= 1;
+          *stall = 1;
+          *dat_i = 0;
+          return;
+        }
+      }
+      bus.pending = 0;
+      bus.burst = (cti == Vecap5_dproc_ecap5_dproc_pkg::CTI_INCREMENTING);
+      bus.next = adr + 4;
+      // check test end
+      if(adr == END_ADDRESS) {
+        this->is_done = 1;
+      } else if(adr == OUTPUT_ADDRESS && we == 1) {
+        char c = dat_o & 0xFF;
+        printf("%c", c);
+      // check overflow
+      } else if(adr >= MAX_BINARY_SIZE) {
+        printf("Runtime memory overflow\n  Requested address : %08x, Memory end address : %08x\n\n", adr, MAX_BINARY_SIZE-1);
+      } else {
+        if(we == 0) {
+          // Read
+          memcpy(&data, memory + adr, 4);
+          switch(sel) {
+            case 0x1:
+              data &= 0xFF;
+              break;
+            case 0x3:
+              data &= 0xFFFF;
+              break;
+            case 0xF:
+              break;
+            default:
+              if((sel != 0) && ((adr & 0x3) == 0)) {
+                // Byte lanes of a word-aligned request
+                for(int i = 0; i < 4; i++) {
+                  if(!(sel & (1 << i))) {
+                    data &= ~(0xFFu << (8 * i));
+                  }
+                }
+              } else {
+                printf("Invalid wishbone sel signal during read: %08x\n", sel);
               }
-            } else {
-              // Write
-              uint8_t size = 0;
-              switch(this->core->wb_sel_o) {
-                case 0x1:
-                  size = 1;
-                  break;
-                case 0x3:
-                  size = 2;
-                  break;
-                case 0xF:
-                  size = 4;
-                  break;
-                default:
-                  printf("Invalid wishbone sel signal during write: %08x\n", this->core->wb_sel_o);
-                  break;
+              break;
+          }
+        } else {
+          // Write
+          uint8_t size = 0;
+          switch(sel) {
+            case 0x1:
+              size = 1;
+              break;
+            case 0x3:
+              size = 2;
+              break;
+            case 0xF:
+              size = 4;
+              break;
+            default:
+              if((sel != 0) && ((adr & 0x3) == 0)) {
+                // Byte lanes of a word-aligned request
+                for(int i = 0; i < 4; i++) {
+                  if(sel & (1 << i)) {
+                    memory[adr + i] = (dat_o >> (8 * i)) & 0xFF;
+                  }
+                }
+              } else {
+                printf("Invalid wishbone sel signal during write: %08x\n", sel);
               }
-              memcpy(memory + this->core->wb_adr_o, &this->core->wb_dat_o, size);
-            }
+              break;
           }
-          this->core->wb_dat_i = data;
-          this->core->wb_ack_i = 1;
-          state = 1;
-          break;
+          memcpy(memory + adr, &dat_o, size);
         }
       }
-      case 1: {
-        this->core->wb_dat_i = 0;
-        this->core->wb_ack_i = 0;
-        state = 0;
-        break;
+      *ack = 1;
+    }
+    *dat_i = data;
+  }
+
+  /*
+   * Serves the transactions of the AXI4 bus of the core.
+   * The address and data channels are always ready, the responses being
+   * provided latency cycles after the cycle following the transaction.
+   */
+  void serve_axi() {
+    bool rvalid = !this->axi_reads.empty() && (this->axi_reads.front().due <= this->tickcount);
+    bool bvalid = !this->axi_writes.empty() && (this->axi_writes.front().due <= this->tickcount);
+    this->core->axi_awready_i = 1;
+    this->core->axi_wready_i  = 1;
+    this->core->axi_arready_i = 1;
+    this->core->axi_rvalid_i  = rvalid;
+    this->core->axi_rdata_i   = rvalid ? this->axi_reads.front().data : 0;
+    this->core->axi_rresp_i   = 0;
+    this->core->axi_rlast_i   = rvalid;
+    this->core->axi_bvalid_i  = bvalid;
+    this->core->axi_bresp_i   = 0;
+    this->core->eval();
+
+    if(rvalid && this->core->axi_rready_o) {
+      this->axi_reads.pop_front();
+    }
+    if(bvalid && this->core->axi_bready_o) {
+      this->axi_writes.pop_front();
+    }
+    if(this->core->axi_arvalid_o) {
+      uint32_t addr = this->core->axi_araddr_o;
+      uint32_t data = 0;
+      if(addr == END_ADDRESS) {
+        this->is_done = 1;
+      } else if(addr >= MAX_BINARY_SIZE) {
+        printf("Runtime memory overflow\n  Requested address : %08x, Memory end address : %08x\n\n", addr, MAX_BINARY_SIZE-1);
+      } else {
+        // The data of the aligned word is provided on the byte lanes
+        memcpy(&data, memory + (addr & ~3u), 4);
       }
+      this->axi_reads.push_back({this->tickcount + 1 + this->latency, addr, data, 0});
+      this->axi_read_count += 1;
+    }
+    if(this->core->axi_awvalid_o) {
+      this->axi_aw.push_back({0, this->core->axi_awaddr_o, 0, 0});
+    }
+    if(this->core->axi_wvalid_o) {
+      this->axi_w.push_back({0, 0, this->core->axi_wdata_o, this->core->axi_wstrb_o});
     }
+    // A write is performed once both its address and data are received
+    while(!this->axi_aw.empty() && !this->axi_w.empty()) {
+      Transaction t = this->axi_aw.front();
+      t.data = this->axi_w.front().data;
+      t.strb = this->axi_w.front().strb;
+      t.due = this->tickcount + 1 + this->latency;
+      if(t.addr == END_ADDRESS) {
+        this->is_done = 1;
+      } else if(t.addr == OUTPUT_ADDRESS) {
+        char c = (t.data >> (8 * (t.addr & 3))) & 0xFF;
+        printf("%c", c);
+      } else if(t.addr >= MAX_BINARY_SIZE) {
+        printf("Runtime memory overflow\n  Requested address : %08x, Memory end address : %08x\n\n", t.addr, MAX_BINARY_SIZE-1);
+      } else {
+        for(int i = 0; i < 4; i++) {
+          if(t.strb & (1 << i)) {
+            memory[(t.addr & ~3u) + i] = (t.data >> (8 * i)) & 0xFF;
+          }
+        }
+      }
+      this->axi_writes.push_back(t);
+      this->axi_aw.pop_front();
+      this->axi_w.pop_front();
+      this->axi_write_count += 1;
+    }
+    uint32_t in_flight = this->axi_reads.size() + this->axi_writes.size();
+    if(in_flight > this->axi_max_in_flight) {
+      this->axi_max_in_flight = in_flight;
+    }
+  }
+
+  void tick() {
+    // handle the wishbone bus of the memory module
+    serve(this->wb, this->core->wb_adr_o, this->core->wb_dat_o, this->core->wb_we_o, this->core->wb_sel_o,
+          this->core->wb_stb_o, this->core->wb_cyc_o, this->core->wb_cti_o,
+          &this->core->wb_dat_i, &this->core->wb_ack_i, &this->core->wb_stall_i);
+    // handle the instruction and data buses of the harvard configuration,
+    // both of them being connected to a different port of the memory
+    serve(this->ibus, this->core->ibus_adr_o, 0, this->core->ibus_we_o, this->core->ibus_sel_o,
+          this->core->ibus_stb_o, this->core->ibus_cyc_o, this->core->ibus_cti_o,
+          &this->core->ibus_dat_i, &this->core->ibus_ack_i, &this->core->ibus_stall_i);
+    serve(this->dbus, this->core->dbus_adr_o, this->core->dbus_dat_o, this->core->dbus_we_o, this->core->dbus_sel_o,
+          this->core->dbus_stb_o, this->core->dbus_cyc_o, this->core->dbus_cti_o,
+          &this->core->dbus_dat_i, &this->core->dbus_ack_i, &this->core->dbus_stall_i);
+    // handle the bus of the AXI configuration
+    serve_axi();
 
     Testbench<Vecap5_dproc>::tick();
   }
@@ -131,7 +288,37 @@ public:
   void set_memory(std::string path) {
     memset(memory, 0, MAX_BINARY_SIZE);
     load_elf(path, memory, MAX_BINARY_SIZE);
+#ifdef TCM
+    // the tightly-coupled memories are not loaded through the bus
+    preload_tcm("TOP.ecap5_dproc.itcm_gen.itcm_inst");
+    preload_tcm("TOP.ecap5_dproc.dtcm_gen.dtcm_inst");
+#endif
+  }
+
+#ifdef TCM
+  // Copies the part of the binary mapped on a tightly-coupled memory
+  void preload_tcm(const char * name) {
+    const svScope scope = svGetScopeFromName(name);
+    if(scope == NULL) {
+      return;
+    }
+    svSetScope(scope);
+    svLogicVecVal base, size;
+    this->core->get_tcm_range(&base, &size);
+    for(uint32_t offset = 0; offset < size.aval; offset += 4) {
+      uint32_t addr = base.aval + offset;
+      if(addr + 4 > MAX_BINARY_SIZE) {
+        break;
+      }
+      svLogicVecVal value = {0, 0};
+      for(int i = 0; i < 4; i++) {
+        value.aval |= memory[addr + i] << (8 * i);
+      }
+      svLogicVecVal address = {addr, 0};
+      this->core->set_tcm_word(&address, &value);
+    }
   }
+#endif
 };
 
 int main(int argc, char ** argv, char ** env) {
@@ -147,12 +334,15 @@ int main(int argc, char ** argv, char ** env) {
     tb->set_memory(argv[1]);
     if(argc >= 3) {
       tb->open_trace(argv[2]);
-      if(argc == 4) {
+      if(argc >= 4) {
         max_tickcount = atoi(argv[3]); 
+        if(argc == 5) {
+          tb->latency = atoi(argv[4]);
+        }
       }
     }
   } else {
-    printf("Usage: %s elf_binary vcd_output max_tickcount\n", argv[0]);
+    printf("Usage: %s elf_binary vcd_output max_tickcount memory_latency\n", argv[0]);
     return -1;
   }
 
@@ -164,6 +354,12 @@ int main(int argc, char ** argv, char ** env) {
 
   if(tb->tickcount >= max_tickcount) {
     printf("\nKilled: Timeout\n");
+  } else {
+    printf("\nDone in %d cycles\n", (int)tb->tickcount);
+    if(tb->axi_read_count + tb->axi_write_count > 0) {
+      printf("AXI: %d reads, %d writes, %d transactions in flight at most\n",
+             (int)tb->axi_read_count, (int)tb->axi_write_count, (int)tb->axi_max_in_flight);
+    }
   }
 
   delete tb;
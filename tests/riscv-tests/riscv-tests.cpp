@@ -26,6 +26,7 @@
 #include <verilated.h>
 #include <verilated_vcd_c.h>
 #include <svdpi.h>
+#include <deque>
 
 #include "Vecap5_dproc_ecap5_dproc_pkg.h"
 #include "Vecap5_dproc.h"
@@ -39,14 +40,58 @@
 
 #define END_ADDRESS 0xFFEEBBCC
 
+// Stall cycles of the first request of a bus cycle
+#ifndef MEMORY_LATENCY
+#define MEMORY_LATENCY 0
+#endif
+
+// Name of the testdata file and label of the configuration, provided by the
+// build for the configurations other than the default one
+#ifndef RISCV_TESTS_NAME
+#define RISCV_TESTS_NAME "riscv-tests"
+#endif
+#ifndef RISCV_TESTS_LABEL
+#define RISCV_TESTS_LABEL "RISCV-TESTS"
+#endif
+
+// State of the memory model serving a wishbone bus
+struct Bus {
+  bool pending;   // A request is being stalled
+  uint32_t wait;  // Remaining stall cycles of the pending request
+  bool burst;     // The last request was part of an incrementing burst
+  uint32_t next;  // Address of the next request of the burst
+};
+
+// Transaction received by the AXI4 memory model
+struct Transaction {
+  uint32_t due;   // Cycle from which the response is provided
+  uint32_t addr;
+  uint32_t data;
+  uint8_t strb;
+};
+
 class TB_Riscv_tests: public Testbench<Vecap5_dproc> {
 public:
   uint8_t memory[MAX_BINARY_SIZE];
   bool is_done;
+  // Cycles during which the first request of a bus cycle is stalled
+  uint32_t latency = MEMORY_LATENCY;
+  Bus wb, ibus, dbus;
+  // State of the AXI4 memory model
+  std::deque<Transaction> axi_aw, axi_w, axi_reads, axi_writes;
+  uint32_t axi_read_count, axi_write_count, axi_max_in_flight;
 
   void reset() {
     this->is_done = 0;
     this->tickcount = 0;
+    this->wb = this->ibus = this->dbus = {0, 0, 0, 0};
+    this->axi_aw.clear();
+    this->axi_w.clear();
+    this->axi_reads.clear();
+    this->axi_writes.clear();
+    this->axi_read_count = 0;
+    this->axi_write_count = 0;
+    this->axi_max_in_flight = 0;
 
     this->core->rst_i = 1;
     for(int i = 0; i < 5; i++) {
@@ -60,70 +105,192 @@ public:
     memset(memory, 0, MAX_BINARY_SIZE);
   }
 
-  void tick() {
-    static uint8_t state = 0;
-
-    // handle wishbone bus
-    switch(state) {
-      case 0: {
-        if((this->core->wb_stb_o == 1) && (this->core->wb_cyc_o == 1)) {
-          uint32_t data = 0;
-          // check test end
-          if(this->core->wb_adr_o == END_ADDRESS) {
-            this->is_done = 1;
-          // check overflow
-          } else if(this->core->wb_adr_o >= MAX_BINARY_SIZE) {
-            printf("Runtime memory overflow\n  Requested address : %08x, Memory end address : %08x\n\n", this->core->wb_adr_o, MAX_BINARY_SIZE-1);
-          } else {
-            if(this->core->wb_we_o == 0) {
-              // Read
-              memcpy(&data, memory + this->core->wb_adr_o, 4);
-              switch(this->core->wb_sel_o) {
-                case 0x1:
-                  data &= 0xFF;
-                  break;
-                case 0x3:
-                  data &= 0xFFFF;
-                  break;
-                case 0xF:
-                  break;
-                default:
-                  printf("Invalid wishbone sel signal during read: %08x\n", this->core->wb_sel_o);
-                  break;
+  /*
+   * Serves a request of one of the wishbone masters of the core.
+   * The first request of a bus cycle is stalled during latency cycles before
+   * being acknowledged, the following requests of an incrementing burst
+   * being acknowledged during the cycle they are issued.
+   */
+  void serve(Bus & bus, uint32_t adr, uint32_t dat_o, uint8_t we, uint8_t sel, uint8_t stb, uint8_t cyc,
+             uint8_t cti, uint32_t * dat_i, uint8_t * ack, uint8_t * stall) {
+    uint32_t data = 0;
+    *ack = 0;
+    *stall = 0;
+    if(cyc == 0) {
+      bus.burst = 0;
+    }
+    if((stb == 1) && (cyc == 1)) {
+      if(!bus.burst || (adr != bus.next)) {
+        bus.burst = 0;
+        if(!bus.pending) {
+          bus.pending = 1;
+          bus.wait = this->latency;
+        }
+        if(bus.wait > 0) {
+          // The request is held by the master until accepted
+          bus.wait -= 1;
+          *stall = 1;
+          *dat_i = 0;
+          return;
+        }
+      }
+      bus.pending = 0;
+      bus.burst = (cti == Vecap5_dproc_ecap5_dproc_pkg::CTI_INCREMENTING);
+      bus.next = adr + 4;
+      // check test end
+      if(adr == END_ADDRESS) {
+        this->is_done = 1;
+      // check overflow
+      } else if(adr >= MAX_BINARY_SIZE) {
+        printf("Runtime memory overflow\n  Requested address : %08x, Memory end address : %08x\n\n", adr, MAX_BINARY_SIZE-1);
+      } else {
+        if(we == 0) {
+          // Read
+          memcpy(&data, memory + adr, 4);
+          switch(sel) {
+            case 0x1:
+              data &= 0xFF;
+              break;
+            case 0x3:
+              data &= 0xFFFF;
+              break;
+            case 0xF:
+              break;
+            default:
+              if((sel != 0) && ((adr & 0x3) == 0)) {
+                // Byte lanes of a word-aligned request
+                for(int i = 0; i < 4; i++) {
+                  if(!(sel & (1 << i))) {
+                    data &= ~(0xFFu << (8 * i));
+                  }
+                }
+              } else {
+                printf("Invalid wishbone sel signal during read: %08x\n", sel);
               }
-            } else {
-              // Write
-              uint8_t size = 0;
-              switch(this->core->wb_sel_o) {
-                case 0x1:
-                  size = 1;
-                  break;
-                case 0x3:
-                  size = 2;
-                  break;
-                case 0xF:
-                  size = 4;
-                  break;
-                default:
-                  printf("Invalid wishbone sel signal during write: %08x\n", this->core->wb_sel_o);
-                  break;
+              break;
+          }
+        } else {
+          // Write
+          uint8_t size = 0;
+          switch(sel) {
+            case 0x1:
+              size = 1;
+              break;
+            case 0x3:
+              size = 2;
+              break;
+            case 0xF:
+              size = 4;
+              break;
+            default:
+              if((sel != 0) && ((adr & 0x3) == 0)) {
+                // Byte lanes of a word-aligned request
+                for(int i = 0; i < 4; i++) {
+                  if(sel & (1 << i)) {
+                    memory[adr + i] = (dat_o >> (8 * i)) & 0xFF;
+                  }
+                }
+              } else {
+                printf("Invalid wishbone sel signal during write: %08x\n", sel);
               }
-              memcpy(memory + this->core->wb_adr_o, &this->core->wb_dat_o, size);
-            }
+              break;
           }
-          this->core->wb_dat_i = data;
-          this->core->wb_ack_i = 1;
-          state = 1;
-          break;
+          memcpy(memory + adr, &dat_o, size);
         }
       }
-      case 1: {
-        this->core->wb_dat_i = 0;
-        this->core->wb_ack_i = 0;
-        state = 0;
-        break;
+      *ack = 1;
+    }
+    *dat_i = data;
+  }
+
+  /*
+   * Serves the transactions of the AXI4 bus of the core.
+   * The address and data channels are always ready, the responses being
+   * provided latency cycles after the cycle following the transaction.
+   */
+  void serve_axi() {
+    bool rvalid = !this->axi_reads.empty() && (this->axi_reads.front().due <= this->tickcount);
+    bool bvalid = !this->axi_writes.empty() && (this->axi_writes.front().due <= this->tickcount);
+    this->core->axi_awready_i = 1;
+    this->core->axi_wready_i  = 1;
+    this->core->axi_arready_i = 1;
+    this->core->axi_rvalid_i  = rvalid;
+    this->core->axi_rdata_i   = rvalid ? this->axi_reads.front().data : 0;
+    this->core->axi_rresp_i   = 0;
+    this->core->axi_rlast_i   = rvalid;
+    this->core->axi_bvalid_i  = bvalid;
+    this->core->axi_bresp_i   = 0;
+    this->core->eval();
+
+    if(rvalid && this->core->axi_rready_o) {
+      this->axi_reads.pop_front();
+    }
+    if(bvalid && this->core->axi_bready_o) {
+      this->axi_writes.pop_front();
+    }
+    if(this->core->axi_arvalid_o) {
+      uint32_t addr = this->core->axi_araddr_o;
+      uint32_t data = 0;
+      if(addr == END_ADDRESS) {
+        this->is_done = 1;
+      } else if(addr >= MAX_BINARY_SIZE) {
+        printf("Runtime memory overflow\n  Requested address : %08x, Memory end address : %08x\n\n", addr, MAX_BINARY_SIZE-1);
+      } else {
+        // The data of the aligned word is provided on the byte lanes
+        memcpy(&data, memory + (addr & ~3u), 4);
+      }
+      this->axi_reads.push_back({this->tickcount + 1 + this->latency, addr, data, 0});
+      this->axi_read_count += 1;
+    }
+    if(this->core->axi_awvalid_o) {
+      this->axi_aw.push_back({0, this->core->axi_awaddr_o, 0, 0});
+    }
+    if(this->core->axi_wvalid_o) {
+      this->axi_w.push_back({0, 0, this->core->axi_wdata_o, this->core->axi_wstrb_o});
+    }
+    // A write is performed once both its address and data are received
+    while(!this->axi_aw.empty() && !this->axi_w.empty()) {
+      Transaction t = this->axi_aw.front();
+      t.data = this->axi_w.front().data;
+      t.strb = this->axi_w.front().strb;
+      t.due = this->tickcount + 1 + this->latency;
+      if(t.addr == END_ADDRESS) {
+        this->is_done = 1;
+      } else if(t.addr >= MAX_BINARY_SIZE) {
+        printf("Runtime memory overflow\n  Requested address : %08x, Memory end address : %08x\n\n", t.addr, MAX_BINARY_SIZE-1);
+      } else {
+        for(int i = 0; i < 4; i++) {
+          if(t.strb & (1 << i)) {
+            memory[(t.addr & ~3u) + i] = (t.data >> (8 * i)) & 0xFF;
+          }
+        }
       }
+      this->axi_writes.push_back(t);
+      this->axi_aw.pop_front();
+      this->axi_w.pop_front();
+      this->axi_write_count += 1;
+    }
+    uint32_t in_flight = this->axi_reads.size() + this->axi_writes.size();
+    if(in_flight > this->axi_max_in_flight) {
+      this->axi_max_in_flight = in_flight;
     }
+  }
+
+  void tick() {
+    // handle the wishbone bus of the memory module
+    serve(this->wb, this->core->wb_adr_o, this->core->wb_dat_o, this->core->wb_we_o, this->core->wb_sel_o,
+          this->core->wb_stb_o, this->core->wb_cyc_o, this->core->wb_cti_o,
+          &this->core->wb_dat_i, &this->core->wb_ack_i, &this->core->wb_stall_i);
+    // handle the instruction and data buses of the harvard configuration,
+    // both of them being connected to a different port of the memory
+    serve(this->ibus, this->core->ibus_adr_o, 0, this->core->ibus_we_o, this->core->ibus_sel_o,
+          this->core->ibus_stb_o, this->core->ibus_cyc_o, this->core->ibus_cti_o,
+          &this->core->ibus_dat_i, &this->core->ibus_ack_i, &this->core->ibus_stall_i);
+    serve(this->dbus, this->core->dbus_adr_o, this->core->dbus_dat_o, this->core->dbus_we_o, this->core->dbus_sel_o,
+          this->core->dbus_stb_o, this->core->dbus_cyc_o, this->core->dbus_cti_o,
+          &this->core->dbus_dat_i, &this->core->dbus_ack_i, &this->core->dbus_stall_i);
+    // handle the bus of the AXI configuration
+    serve_axi();
 
     Testbench<Vecap5_dproc>::tick();
   }
@@ -1256,63 +1423,1471 @@ void tb_riscv_tests_xori(TB_Riscv_tests * tb) {
   tb->close_trace();
 }
 
-int main(int argc, char ** argv, char ** env) {
-  srand(time(NULL));
-  Verilated::traceEverOn(true);
+void tb_riscv_tests_mul(TB_Riscv_tests * tb) {
+  tb->open_trace("waves/riscv-tests-mul.vcd");
 
-  // Check arguments
-  bool verbose = parse_verbose(argc, argv);
+  Vecap5_dproc * core = tb->core;
+  tb->reset();  
 
-  TB_Riscv_tests * tb = new TB_Riscv_tests();
-  tb->open_testdata("testdata/riscv-tests.csv");
-  tb->set_debug_log(verbose);
+  tb->set_memory("riscv-tests/tests/rv32um-p-mul.elf");
 
-  /************************************************************/
+  while(!tb->is_done && tb->tickcount < MAX_TICKCOUNT) {
+    tb->tick();
+  }
 
-  tb_riscv_tests_simple(tb);
-  tb_riscv_tests_add(tb);
-  tb_riscv_tests_addi(tb);
-  tb_riscv_tests_and(tb);
-  tb_riscv_tests_andi(tb);
-  tb_riscv_tests_auipc(tb);
-  tb_riscv_tests_beq(tb);
-  tb_riscv_tests_bge(tb);
-  tb_riscv_tests_bgeu(tb);
-  tb_riscv_tests_blt(tb);
-  tb_riscv_tests_bltu(tb);
-  tb_riscv_tests_bne(tb);
-  // tb_riscv_tests_fence_i(tb);
-  tb_riscv_tests_jal(tb);
-  tb_riscv_tests_jalr(tb);
-  tb_riscv_tests_lb(tb);
-  tb_riscv_tests_lbu(tb);
-  tb_riscv_tests_lh(tb);
-  tb_riscv_tests_lhu(tb);
-  tb_riscv_tests_lw(tb);
-  tb_riscv_tests_lui(tb);
-  // tb_riscv_tests_ma_data(tb);
-  tb_riscv_tests_or(tb);
-  tb_riscv_tests_ori(tb);
-  tb_riscv_tests_sb(tb);
-  tb_riscv_tests_sh(tb);
-  tb_riscv_tests_sw(tb);
-  tb_riscv_tests_sll(tb);
-  tb_riscv_tests_slli(tb);
-  tb_riscv_tests_slt(tb);
-  tb_riscv_tests_slti(tb);
-  tb_riscv_tests_sltiu(tb);
-  tb_riscv_tests_sltu(tb);
-  tb_riscv_tests_sra(tb);
-  tb_riscv_tests_srai(tb);
-  tb_riscv_tests_srl(tb);
-  tb_riscv_tests_srli(tb);
-  tb_riscv_tests_sub(tb);
-  tb_riscv_tests_xor(tb);
-  tb_riscv_tests_xori(tb);
+  uint32_t testcase;
+  tb->get_register(3, &testcase);
+  uint32_t result;
+  tb->get_register(4, &result);
+
+  CHECK("riscv-tests.mul.01",
+      tb->is_done,
+      "Failed to terminate (timeout)");
+
+  CHECK("riscv-tests.mul.02",
+      result == 1,
+      "Failed during testcase", testcase);
+
+  tb->close_trace();
+}
+
+void tb_riscv_tests_mulh(TB_Riscv_tests * tb) {
+  tb->open_trace("waves/riscv-tests-mulh.vcd");
+
+  Vecap5_dproc * core = tb->core;
+  tb->reset();  
+
+  tb->set_memory("riscv-tests/tests/rv32um-p-mulh.elf");
+
+  while(!tb->is_done && tb->tickcount < MAX_TICKCOUNT) {
+    tb->tick();
+  }
+
+  uint32_t testcase;
+  tb->get_register(3, &testcase);
+  uint32_t result;
+  tb->get_register(4, &result);
+
+  CHECK("riscv-tests.mulh.01",
+      tb->is_done,
+      "Failed to terminate (timeout)");
+
+  CHECK("riscv-tests.mulh.02",
+      result == 1,
+      "Failed during testcase", testcase);
+
+  tb->close_trace();
+}
+
+void tb_riscv_tests_mulhsu(TB_Riscv_tests * tb) {
+  tb->open_trace("waves/riscv-tests-mulhsu.vcd");
+
+  Vecap5_dproc * core = tb->core;
+  tb->reset();  
+
+  tb->set_memory("riscv-tests/tests/rv32um-p-mulhsu.elf");
+
+  while(!tb->is_done && tb->tickcount < MAX_TICKCOUNT) {
+    tb->tick();
+  }
+
+  uint32_t testcase;
+  tb->get_register(3, &testcase);
+  uint32_t result;
+  tb->get_register(4, &result);
+
+  CHECK("riscv-tests.mulhsu.01",
+      tb->is_done,
+      "Failed to terminate (timeout)");
+
+  CHECK("riscv-tests.mulhsu.02",
+      result == 1,
+      "Failed during testcase", testcase);
+
+  tb->close_trace();
+}
+
+void tb_riscv_tests_mulhu(TB_Riscv_tests * tb) {
+  tb->open_trace("waves/riscv-tests-mulhu.vcd");
+
+  Vecap5_dproc * core = tb->core;
+  tb->reset();  
+
+  tb->set_memory("riscv-tests/tests/rv32um-p-mulhu.elf");
+
+  while(!tb->is_done && tb->tickcount < MAX_TICKCOUNT) {
+    tb->tick();
+  }
+
+  uint32_t testcase;
+  tb->get_register(3, &testcase);
+  uint32_t result;
+  tb->get_register(4, &result);
+
+  CHECK("riscv-tests.mulhu.01",
+      tb->is_done,
+      "Failed to terminate (timeout)");
+
+  CHECK("riscv-tests.mulhu.02",
+      result == 1,
+      "Failed during testcase", testcase);
+
+  tb->close_trace();
+}
+
+void tb_riscv_tests_div(TB_Riscv_tests * tb) {
+  tb->open_trace("waves/riscv-tests-div.vcd");
+
+  Vecap5_dproc * core = tb->core;
+  tb->reset();  
+
+  tb->set_memory("riscv-tests/tests/rv32um-p-div.elf");
+
+  while(!tb->is_done && tb->tickcount < MAX_TICKCOUNT) {
+    tb->tick();
+  }
+
+  uint32_t testcase;
+  tb->get_register(3, &testcase);
+  uint32_t result;
+  tb->get_register(4, &result);
+
+  CHECK("riscv-tests.div.01",
+      tb->is_done,
+      "Failed to terminate (timeout)");
+
+  CHECK("riscv-tests.div.02",
+      result == 1,
+      "Failed during testcase", testcase);
+
+  tb->close_trace();
+}
+
+void tb_riscv_tests_divu(TB_Riscv_tests * tb) {
+  tb->open_trace("waves/riscv-tests-divu.vcd");
+
+  Vecap5_dproc * core = tb->core;
+  tb->reset();  
+
+  tb->set_memory("riscv-tests/tests/rv32um-p-divu.elf");
+
+  while(!tb->is_done && tb->tickcount < MAX_TICKCOUNT) {
+    tb->tick();
+  }
+
+  uint32_t testcase;
+  tb->get_register(3, &testcase);
+  uint32_t result;
+  tb->get_register(4, &result);
+
+  CHECK("riscv-tests.divu.01",
+      tb->is_done,
+      "Failed to terminate (timeout)");
+
+  CHECK("riscv-tests.divu.02",
+      result == 1,
+      "Failed during testcase", testcase);
+
+  tb->close_trace();
+}
+
+void tb_riscv_tests_rem(TB_Riscv_tests * tb) {
+  tb->open_trace("waves/riscv-tests-rem.vcd");
+
+  Vecap5_dproc * core = tb->core;
+  tb->reset();  
+
+  tb->set_memory("riscv-tests/tests/rv32um-p-rem.elf");
+
+  while(!tb->is_done && tb->tickcount < MAX_TICKCOUNT) {
+    tb->tick();
+  }
+
+  uint32_t testcase;
+  tb->get_register(3, &testcase);
+  uint32_t result;
+  tb->get_register(4, &result);
+
+  CHECK("riscv-tests.rem.01",
+      tb->is_done,
+      "Failed to terminate (timeout)");
+
+  CHECK("riscv-tests.rem.02",
+      result == 1,
+      "Failed during testcase", testcase);
+
+  tb->close_trace();
+}
+
+void tb_riscv_tests_remu(TB_Riscv_tests * tb) {
+  tb->open_trace("waves/riscv-tests-remu.vcd");
+
+  Vecap5_dproc * core = tb->core;
+  tb->reset();  
+
+  tb->set_memory("riscv-tests/tests/rv32um-p-remu.elf");
+
+  while(!tb->is_done && tb->tickcount < MAX_TICKCOUNT) {
+    tb->tick();
+  }
+
+  uint32_t testcase;
+  tb->get_register(3, &testcase);
+  uint32_t result;
+  tb->get_register(4, &result);
+
+  CHECK("riscv-tests.remu.01",
+      tb->is_done,
+      "Failed to terminate (timeout)");
+
+  CHECK("riscv-tests.remu.02",
+      result == 1,
+      "Failed during testcase", testcase);
+
+  tb->close_trace();
+}
+
+void tb_riscv_tests_amoadd_w(TB_Riscv_tests * tb) {
+  tb->open_trace("waves/riscv-tests-amoadd_w.vcd");
+
+  Vecap5_dproc * core = tb->core;
+  tb->reset();  
+
+  tb->set_memory("riscv-tests/tests/rv32ua-p-amoadd_w.elf");
+
+  while(!tb->is_done && tb->tickcount < MAX_TICKCOUNT) {
+    tb->tick();
+  }
+
+  uint32_t testcase;
+  tb->get_register(3, &testcase);
+  uint32_t result;
+  tb->get_register(4, &result);
+
+  CHECK("riscv-tests.amoadd_w.01",
+      tb->is_done,
+      "Failed to terminate (timeout)");
+
+  CHECK("riscv-tests.amoadd_w.02",
+      result == 1,
+      "Failed during testcase", testcase);
+
+  tb->close_trace();
+}
+
+void tb_riscv_tests_amoand_w(TB_Riscv_tests * tb) {
+  tb->open_trace("waves/riscv-tests-amoand_w.vcd");
+
+  Vecap5_dproc * core = tb->core;
+  tb->reset();  
+
+  tb->set_memory("riscv-tests/tests/rv32ua-p-amoand_w.elf");
+
+  while(!tb->is_done && tb->tickcount < MAX_TICKCOUNT) {
+    tb->tick();
+  }
+
+  uint32_t testcase;
+  tb->get_register(3, &testcase);
+  uint32_t result;
+  tb->get_register(4, &result);
+
+  CHECK("riscv-tests.amoand_w.01",
+      tb->is_done,
+      "Failed to terminate (timeout)");
+
+  CHECK("riscv-tests.amoand_w.02",
+      result == 1,
+      "Failed during testcase", testcase);
+
+  tb->close_trace();
+}
+
+void tb_riscv_tests_amomax_w(TB_Riscv_tests * tb) {
+  tb->open_trace("waves/riscv-tests-amomax_w.vcd");
+
+  Vecap5_dproc * core = tb->core;
+  tb->reset();  
+
+  tb->set_memory("riscv-tests/tests/rv32ua-p-amomax_w.elf");
+
+  while(!tb->is_done && tb->tickcount < MAX_TICKCOUNT) {
+    tb->tick();
+  }
+
+  uint32_t testcase;
+  tb->get_register(3, &testcase);
+  uint32_t result;
+  tb->get_register(4, &result);
+
+  CHECK("riscv-tests.amomax_w.01",
+      tb->is_done,
+      "Failed to terminate (timeout)");
+
+  CHECK("riscv-tests.amomax_w.02",
+      result == 1,
+      "Failed during testcase", testcase);
+
+  tb->close_trace();
+}
+
+void tb_riscv_tests_amomaxu_w(TB_Riscv_tests * tb) {
+  tb->open_trace("waves/riscv-tests-amomaxu_w.vcd");
+
+  Vecap5_dproc * core = tb->core;
+  tb->reset();  
+
+  tb->set_memory("riscv-tests/tests/rv32ua-p-amomaxu_w.elf");
+
+  while(!tb->is_done && tb->tickcount < MAX_TICKCOUNT) {
+    tb->tick();
+  }
+
+  uint32_t testcase;
+  tb->get_register(3, &testcase);
+  uint32_t result;
+  tb->get_register(4, &result);
+
+  CHECK("riscv-tests.amomaxu_w.01",
+      tb->is_done,
+      "Failed to terminate (timeout)");
+
+  CHECK("riscv-tests.amomaxu_w.02",
+      result == 1,
+      "Failed during testcase", testcase);
+
+  tb->close_trace();
+}
+
+void tb_riscv_tests_amomin_w(TB_Riscv_tests * tb) {
+  tb->open_trace("waves/riscv-tests-amomin_w.vcd");
+
+  Vecap5_dproc * core = tb->core;
+  tb->reset();  
+
+  tb->set_memory("riscv-tests/tests/rv32ua-p-amomin_w.elf");
+
+  while(!tb->is_done && tb->tickcount < MAX_TICKCOUNT) {
+    tb->tick();
+  }
+
+  uint32_t testcase;
+  tb->get_register(3, &testcase);
+  uint32_t result;
+  tb->get_register(4, &result);
+
+  CHECK("riscv-tests.amomin_w.01",
+      tb->is_done,
+      "Failed to terminate (timeout)");
+
+  CHECK("riscv-tests.amomin_w.02",
+      result == 1,
+      "Failed during testcase", testcase);
+
+  tb->close_trace();
+}
+
+void tb_riscv_tests_amominu_w(TB_Riscv_tests * tb) {
+  tb->open_trace("waves/riscv-tests-amominu_w.vcd");
+
+  Vecap5_dproc * core = tb->core;
+  tb->reset();  
+
+  tb->set_memory("riscv-tests/tests/rv32ua-p-amominu_w.elf");
+
+  while(!tb->is_done && tb->tickcount < MAX_TICKCOUNT) {
+    tb->tick();
+  }
+
+  uint32_t testcase;
+  tb->get_register(3, &testcase);
+  uint32_t result;
+  tb->get_register(4, &result);
+
+  CHECK("riscv-tests.amominu_w.01",
+      tb->is_done,
+      "Failed to terminate (timeout)");
+
+  CHECK("riscv-tests.amominu_w.02",
+      result == 1,
+      "Failed during testcase", testcase);
+
+  tb->close_trace();
+}
+
+void tb_riscv_tests_amoor_w(TB_Riscv_tests * tb) {
+  tb->open_trace("waves/riscv-tests-amoor_w.vcd");
+
+  Vecap5_dproc * core = tb->core;
+  tb->reset();  
+
+  tb->set_memory("riscv-tests/tests/rv32ua-p-amoor_w.elf");
+
+  while(!tb->is_done && tb->tickcount < MAX_TICKCOUNT) {
+    tb->tick();
+  }
+
+  uint32_t testcase;
+  tb->get_register(3, &testcase);
+  uint32_t result;
+  tb->get_register(4, &result);
+
+  CHECK("riscv-tests.amoor_w.01",
+      tb->is_done,
+      "Failed to terminate (timeout)");
+
+  CHECK("riscv-tests.amoor_w.02",
+      result == 1,
+      "Failed during testcase", testcase);
+
+  tb->close_trace();
+}
+
+void tb_riscv_tests_amoxor_w(TB_Riscv_tests * tb) {
+  tb->open_trace("waves/riscv-tests-amoxor_w.vcd");
+
+  Vecap5_dproc * core = tb->core;
+  tb->reset();  
+
+  tb->set_memory("riscv-tests/tests/rv32ua-p-amoxor_w.elf");
+
+  while(!tb->is_done && tb->tickcount < MAX_TICKCOUNT) {
+    tb->tick();
+  }
+
+  uint32_t testcase;
+  tb->get_register(3, &testcase);
+  uint32_t result;
+  tb->get_register(4, &result);
+
+  CHECK("riscv-tests.amoxor_w.01",
+      tb->is_done,
+      "Failed to terminate (timeout)");
+
+  CHECK("riscv-tests.amoxor_w.02",
+      result == 1,
+      "Failed during testcase", testcase);
+
+  tb->close_trace();
+}
+
+void tb_riscv_tests_amoswap_w(TB_Riscv_tests * tb) {
+  tb->open_trace("waves/riscv-tests-amoswap_w.vcd");
+
+  Vecap5_dproc * core = tb->core;
+  tb->reset();  
+
+  tb->set_memory("riscv-tests/tests/rv32ua-p-amoswap_w.elf");
+
+  while(!tb->is_done && tb->tickcount < MAX_TICKCOUNT) {
+    tb->tick();
+  }
+
+  uint32_t testcase;
+  tb->get_register(3, &testcase);
+  uint32_t result;
+  tb->get_register(4, &result);
+
+  CHECK("riscv-tests.amoswap_w.01",
+      tb->is_done,
+      "Failed to terminate (timeout)");
+
+  CHECK("riscv-tests.amoswap_w.02",
+      result == 1,
+      "Failed during testcase", testcase);
+
+  tb->close_trace();
+}
+
+void tb_riscv_tests_lrsc(TB_Riscv_tests * tb) {
+  tb->open_trace("waves/riscv-tests-lrsc.vcd");
+
+  Vecap5_dproc * core = tb->core;
+  tb->reset();  
+
+  tb->set_memory("riscv-tests/tests/rv32ua-p-lrsc.elf");
+
+  while(!tb->is_done && tb->tickcount < MAX_TICKCOUNT) {
+    tb->tick();
+  }
+
+  uint32_t testcase;
+  tb->get_register(3, &testcase);
+  uint32_t result;
+  tb->get_register(4, &result);
+
+  CHECK("riscv-tests.lrsc.01",
+      tb->is_done,
+      "Failed to terminate (timeout)");
+
+  CHECK("riscv-tests.lrsc.02",
+      result == 1,
+      "Failed during testcase", testcase);
+
+  tb->close_trace();
+}
+
+void tb_riscv_tests_rvc(TB_Riscv_tests * tb) {
+  tb->open_trace("waves/riscv-tests-rvc.vcd");
+
+  Vecap5_dproc * core = tb->core;
+  tb->reset();  
+
+  tb->set_memory("riscv-tests/tests/rv32uc-p-rvc.elf");
+
+  while(!tb->is_done && tb->tickcount < MAX_TICKCOUNT) {
+    tb->tick();
+  }
+
+  uint32_t testcase;
+  tb->get_register(3, &testcase);
+  uint32_t result;
+  tb->get_register(4, &result);
+
+  CHECK("riscv-tests.rvc.01",
+      tb->is_done,
+      "Failed to terminate (timeout)");
+
+  CHECK("riscv-tests.rvc.02",
+      result == 1,
+      "Failed during testcase", testcase);
+
+  tb->close_trace();
+}
+
+void tb_riscv_tests_sh1add(TB_Riscv_tests * tb) {
+  tb->open_trace("waves/riscv-tests-sh1add.vcd");
+
+  Vecap5_dproc * core = tb->core;
+  tb->reset();  
+
+  tb->set_memory("riscv-tests/tests/rv32uzba-p-sh1add.elf");
+
+  while(!tb->is_done && tb->tickcount < MAX_TICKCOUNT) {
+    tb->tick();
+  }
+
+  uint32_t testcase;
+  tb->get_register(3, &testcase);
+  uint32_t result;
+  tb->get_register(4, &result);
+
+  CHECK("riscv-tests.sh1add.01",
+      tb->is_done,
+      "Failed to terminate (timeout)");
+
+  CHECK("riscv-tests.sh1add.02",
+      result == 1,
+      "Failed during testcase", testcase);
+
+  tb->close_trace();
+}
+
+void tb_riscv_tests_sh2add(TB_Riscv_tests * tb) {
+  tb->open_trace("waves/riscv-tests-sh2add.vcd");
+
+  Vecap5_dproc * core = tb->core;
+  tb->reset();  
+
+  tb->set_memory("riscv-tests/tests/rv32uzba-p-sh2add.elf");
+
+  while(!tb->is_done && tb->tickcount < MAX_TICKCOUNT) {
+    tb->tick();
+  }
+
+  uint32_t testcase;
+  tb->get_register(3, &testcase);
+  uint32_t result;
+  tb->get_register(4, &result);
+
+  CHECK("riscv-tests.sh2add.01",
+      tb->is_done,
+      "Failed to terminate (timeout)");
+
+  CHECK("riscv-tests.sh2add.02",
+      result == 1,
+      "Failed during testcase", testcase);
+
+  tb->close_trace();
+}
+
+void tb_riscv_tests_sh3add(TB_Riscv_tests * tb) {
+  tb->open_trace("waves/riscv-tests-sh3add.vcd");
+
+  Vecap5_dproc * core = tb->core;
+  tb->reset();  
+
+  tb->set_memory("riscv-tests/tests/rv32uzba-p-sh3add.elf");
+
+  while(!tb->is_done && tb->tickcount < MAX_TICKCOUNT) {
+    tb->tick();
+  }
+
+  uint32_t testcase;
+  tb->get_register(3, &testcase);
+  uint32_t result;
+  tb->get_register(4, &result);
+
+  CHECK("riscv-tests.sh3add.01",
+      tb->is_done,
+      "Failed to terminate (timeout)");
+
+  CHECK("riscv-tests.sh3add.02",
+      result == 1,
+      "Failed during testcase", testcase);
+
+  tb->close_trace();
+}
+
+void tb_riscv_tests_andn(TB_Riscv_tests * tb) {
+  tb->open_trace("waves/riscv-tests-andn.vcd");
+
+  Vecap5_dproc * core = tb->core;
+  tb->reset();  
+
+  tb->set_memory("riscv-tests/tests/rv32uzbb-p-andn.elf");
+
+  while(!tb->is_done && tb->tickcount < MAX_TICKCOUNT) {
+    tb->tick();
+  }
+
+  uint32_t testcase;
+  tb->get_register(3, &testcase);
+  uint32_t result;
+  tb->get_register(4, &result);
+
+  CHECK("riscv-tests.andn.01",
+      tb->is_done,
+      "Failed to terminate (timeout)");
+
+  CHECK("riscv-tests.andn.02",
+      result == 1,
+      "Failed during testcase", testcase);
+
+  tb->close_trace();
+}
+
+void tb_riscv_tests_orn(TB_Riscv_tests * tb) {
+  tb->open_trace("waves/riscv-tests-orn.vcd");
+
+  Vecap5_dproc * core = tb->core;
+  tb->reset();  
+
+  tb->set_memory("riscv-tests/tests/rv32uzbb-p-orn.elf");
+
+  while(!tb->is_done && tb->tickcount < MAX_TICKCOUNT) {
+    tb->tick();
+  }
+
+  uint32_t testcase;
+  tb->get_register(3, &testcase);
+  uint32_t result;
+  tb->get_register(4, &result);
+
+  CHECK("riscv-tests.orn.01",
+      tb->is_done,
+      "Failed to terminate (timeout)");
+
+  CHECK("riscv-tests.orn.02",
+      result == 1,
+      "Failed during testcase", testcase);
+
+  tb->close_trace();
+}
+
+void tb_riscv_tests_xnor(TB_Riscv_tests * tb) {
+  tb->open_trace("waves/riscv-tests-xnor.vcd");
+
+  Vecap5_dproc * core = tb->core;
+  tb->reset();  
+
+  tb->set_memory("riscv-tests/tests/rv32uzbb-p-xnor.elf");
+
+  while(!tb->is_done && tb->tickcount < MAX_TICKCOUNT) {
+    tb->tick();
+  }
+
+  uint32_t testcase;
+  tb->get_register(3, &testcase);
+  uint32_t result;
+  tb->get_register(4, &result);
+
+  CHECK("riscv-tests.xnor.01",
+      tb->is_done,
+      "Failed to terminate (timeout)");
+
+  CHECK("riscv-tests.xnor.02",
+      result == 1,
+      "Failed during testcase", testcase);
+
+  tb->close_trace();
+}
+
+void tb_riscv_tests_clz(TB_Riscv_tests * tb) {
+  tb->open_trace("waves/riscv-tests-clz.vcd");
+
+  Vecap5_dproc * core = tb->core;
+  tb->reset();  
+
+  tb->set_memory("riscv-tests/tests/rv32uzbb-p-clz.elf");
+
+  while(!tb->is_done && tb->tickcount < MAX_TICKCOUNT) {
+    tb->tick();
+  }
+
+  uint32_t testcase;
+  tb->get_register(3, &testcase);
+  uint32_t result;
+  tb->get_register(4, &result);
+
+  CHECK("riscv-tests.clz.01",
+      tb->is_done,
+      "Failed to terminate (timeout)");
+
+  CHECK("riscv-tests.clz.02",
+      result == 1,
+      "Failed during testcase", testcase);
+
+  tb->close_trace();
+}
+
+void tb_riscv_tests_ctz(TB_Riscv_tests * tb) {
+  tb->open_trace("waves/riscv-tests-ctz.vcd");
+
+  Vecap5_dproc * core = tb->core;
+  tb->reset();  
+
+  tb->set_memory("riscv-tests/tests/rv32uzbb-p-ctz.elf");
+
+  while(!tb->is_done && tb->tickcount < MAX_TICKCOUNT) {
+    tb->tick();
+  }
+
+  uint32_t testcase;
+  tb->get_register(3, &testcase);
+  uint32_t result;
+  tb->get_register(4, &result);
+
+  CHECK("riscv-tests.ctz.01",
+      tb->is_done,
+      "Failed to terminate (timeout)");
+
+  CHECK("riscv-tests.ctz.02",
+      result == 1,
+      "Failed during testcase", testcase);
+
+  tb->close_trace();
+}
+
+void tb_riscv_tests_cpop(TB_Riscv_tests * tb) {
+  tb->open_trace("waves/riscv-tests-cpop.vcd");
+
+  Vecap5_dproc * core = tb->core;
+  tb->reset();  
+
+  tb->set_memory("riscv-tests/tests/rv32uzbb-p-cpop.elf");
+
+  while(!tb->is_done && tb->tickcount < MAX_TICKCOUNT) {
+    tb->tick();
+  }
+
+  uint32_t testcase;
+  tb->get_register(3, &testcase);
+  uint32_t result;
+  tb->get_register(4, &result);
+
+  CHECK("riscv-tests.cpop.01",
+      tb->is_done,
+      "Failed to terminate (timeout)");
+
+  CHECK("riscv-tests.cpop.02",
+      result == 1,
+      "Failed during testcase", testcase);
+
+  tb->close_trace();
+}
+
+void tb_riscv_tests_max(TB_Riscv_tests * tb) {
+  tb->open_trace("waves/riscv-tests-max.vcd");
+
+  Vecap5_dproc * core = tb->core;
+  tb->reset();  
+
+  tb->set_memory("riscv-tests/tests/rv32uzbb-p-max.elf");
+
+  while(!tb->is_done && tb->tickcount < MAX_TICKCOUNT) {
+    tb->tick();
+  }
+
+  uint32_t testcase;
+  tb->get_register(3, &testcase);
+  uint32_t result;
+  tb->get_register(4, &result);
+
+  CHECK("riscv-tests.max.01",
+      tb->is_done,
+      "Failed to terminate (timeout)");
+
+  CHECK("riscv-tests.max.02",
+      result == 1,
+      "Failed during testcase", testcase);
+
+  tb->close_trace();
+}
+
+void tb_riscv_tests_maxu(TB_Riscv_tests * tb) {
+  tb->open_trace("waves/riscv-tests-maxu.vcd");
+
+  Vecap5_dproc * core = tb->core;
+  tb->reset();  
+
+  tb->set_memory("riscv-tests/tests/rv32uzbb-p-maxu.elf");
+
+  while(!tb->is_done && tb->tickcount < MAX_TICKCOUNT) {
+    tb->tick();
+  }
+
+  uint32_t testcase;
+  tb->get_register(3, &testcase);
+  uint32_t result;
+  tb->get_register(4, &result);
+
+  CHECK("riscv-tests.maxu.01",
+      tb->is_done,
+      "Failed to terminate (timeout)");
+
+  CHECK("riscv-tests.maxu.02",
+      result == 1,
+      "Failed during testcase", testcase);
+
+  tb->close_trace();
+}
+
+void tb_riscv_tests_min(TB_Riscv_tests * tb) {
+  tb->open_trace("waves/riscv-tests-min.vcd");
+
+  Vecap5_dproc * core = tb->core;
+  tb->reset();  
+
+  tb->set_memory("riscv-tests/tests/rv32uzbb-p-min.elf");
+
+  while(!tb->is_done && tb->tickcount < MAX_TICKCOUNT) {
+    tb->tick();
+  }
+
+  uint32_t testcase;
+  tb->get_register(3, &testcase);
+  uint32_t result;
+  tb->get_register(4, &result);
+
+  CHECK("riscv-tests.min.01",
+      tb->is_done,
+      "Failed to terminate (timeout)");
+
+  CHECK("riscv-tests.min.02",
+      result == 1,
+      "Failed during testcase", testcase);
+
+  tb->close_trace();
+}
+
+void tb_riscv_tests_minu(TB_Riscv_tests * tb) {
+  tb->open_trace("waves/riscv-tests-minu.vcd");
+
+  Vecap5_dproc * core = tb->core;
+  tb->reset();  
+
+  tb->set_memory("riscv-tests/tests/rv32uzbb-p-minu.elf");
+
+  while(!tb->is_done && tb->tickcount < MAX_TICKCOUNT) {
+    tb->tick();
+  }
+
+  uint32_t testcase;
+  tb->get_register(3, &testcase);
+  uint32_t result;
+  tb->get_register(4, &result);
+
+  CHECK("riscv-tests.minu.01",
+      tb->is_done,
+      "Failed to terminate (timeout)");
+
+  CHECK("riscv-tests.minu.02",
+      result == 1,
+      "Failed during testcase", testcase);
+
+  tb->close_trace();
+}
+
+void tb_riscv_tests_orc_b(TB_Riscv_tests * tb) {
+  tb->open_trace("waves/riscv-tests-orc_b.vcd");
+
+  Vecap5_dproc * core = tb->core;
+  tb->reset();  
+
+  tb->set_memory("riscv-tests/tests/rv32uzbb-p-orc_b.elf");
+
+  while(!tb->is_done && tb->tickcount < MAX_TICKCOUNT) {
+    tb->tick();
+  }
+
+  uint32_t testcase;
+  tb->get_register(3, &testcase);
+  uint32_t result;
+  tb->get_register(4, &result);
+
+  CHECK("riscv-tests.orc_b.01",
+      tb->is_done,
+      "Failed to terminate (timeout)");
+
+  CHECK("riscv-tests.orc_b.02",
+      result == 1,
+      "Failed during testcase", testcase);
+
+  tb->close_trace();
+}
+
+void tb_riscv_tests_rev8(TB_Riscv_tests * tb) {
+  tb->open_trace("waves/riscv-tests-rev8.vcd");
+
+  Vecap5_dproc * core = tb->core;
+  tb->reset();  
+
+  tb->set_memory("riscv-tests/tests/rv32uzbb-p-rev8.elf");
+
+  while(!tb->is_done && tb->tickcount < MAX_TICKCOUNT) {
+    tb->tick();
+  }
+
+  uint32_t testcase;
+  tb->get_register(3, &testcase);
+  uint32_t result;
+  tb->get_register(4, &result);
+
+  CHECK("riscv-tests.rev8.01",
+      tb->is_done,
+      "Failed to terminate (timeout)");
+
+  CHECK("riscv-tests.rev8.02",
+      result == 1,
+      "Failed during testcase", testcase);
+
+  tb->close_trace();
+}
+
+void tb_riscv_tests_rol(TB_Riscv_tests * tb) {
+  tb->open_trace("waves/riscv-tests-rol.vcd");
+
+  Vecap5_dproc * core = tb->core;
+  tb->reset();  
+
+  tb->set_memory("riscv-tests/tests/rv32uzbb-p-rol.elf");
+
+  while(!tb->is_done && tb->tickcount < MAX_TICKCOUNT) {
+    tb->tick();
+  }
+
+  uint32_t testcase;
+  tb->get_register(3, &testcase);
+  uint32_t result;
+  tb->get_register(4, &result);
+
+  CHECK("riscv-tests.rol.01",
+      tb->is_done,
+      "Failed to terminate (timeout)");
+
+  CHECK("riscv-tests.rol.02",
+      result == 1,
+      "Failed during testcase", testcase);
+
+  tb->close_trace();
+}
+
+void tb_riscv_tests_ror(TB_Riscv_tests * tb) {
+  tb->open_trace("waves/riscv-tests-ror.vcd");
+
+  Vecap5_dproc * core = tb->core;
+  tb->reset();  
+
+  tb->set_memory("riscv-tests/tests/rv32uzbb-p-ror.elf");
+
+  while(!tb->is_done && tb->tickcount < MAX_TICKCOUNT) {
+    tb->tick();
+  }
+
+  uint32_t testcase;
+  tb->get_register(3, &testcase);
+  uint32_t result;
+  tb->get_register(4, &result);
+
+  CHECK("riscv-tests.ror.01",
+      tb->is_done,
+      "Failed to terminate (timeout)");
+
+  CHECK("riscv-tests.ror.02",
+      result == 1,
+      "Failed during testcase", testcase);
+
+  tb->close_trace();
+}
+
+void tb_riscv_tests_rori(TB_Riscv_tests * tb) {
+  tb->open_trace("waves/riscv-tests-rori.vcd");
+
+  Vecap5_dproc * core = tb->core;
+  tb->reset();  
+
+  tb->set_memory("riscv-tests/tests/rv32uzbb-p-rori.elf");
+
+  while(!tb->is_done && tb->tickcount < MAX_TICKCOUNT) {
+    tb->tick();
+  }
+
+  uint32_t testcase;
+  tb->get_register(3, &testcase);
+  uint32_t result;
+  tb->get_register(4, &result);
+
+  CHECK("riscv-tests.rori.01",
+      tb->is_done,
+      "Failed to terminate (timeout)");
+
+  CHECK("riscv-tests.rori.02",
+      result == 1,
+      "Failed during testcase", testcase);
+
+  tb->close_trace();
+}
+
+void tb_riscv_tests_sext_b(TB_Riscv_tests * tb) {
+  tb->open_trace("waves/riscv-tests-sext_b.vcd");
+
+  Vecap5_dproc * core = tb->core;
+  tb->reset();  
+
+  tb->set_memory("riscv-tests/tests/rv32uzbb-p-sext_b.elf");
+
+  while(!tb->is_done && tb->tickcount < MAX_TICKCOUNT) {
+    tb->tick();
+  }
+
+  uint32_t testcase;
+  tb->get_register(3, &testcase);
+  uint32_t result;
+  tb->get_register(4, &result);
+
+  CHECK("riscv-tests.sext_b.01",
+      tb->is_done,
+      "Failed to terminate (timeout)");
+
+  CHECK("riscv-tests.sext_b.02",
+      result == 1,
+      "Failed during testcase", testcase);
+
+  tb->close_trace();
+}
+
+void tb_riscv_tests_sext_h(TB_Riscv_tests * tb) {
+  tb->open_trace("waves/riscv-tests-sext_h.vcd");
+
+  Vecap5_dproc * core = tb->core;
+  tb->reset();  
+
+  tb->set_memory("riscv-tests/tests/rv32uzbb-p-sext_h.elf");
+
+  while(!tb->is_done && tb->tickcount < MAX_TICKCOUNT) {
+    tb->tick();
+  }
+
+  uint32_t testcase;
+  tb->get_register(3, &testcase);
+  uint32_t result;
+  tb->get_register(4, &result);
+
+  CHECK("riscv-tests.sext_h.01",
+      tb->is_done,
+      "Failed to terminate (timeout)");
+
+  CHECK("riscv-tests.sext_h.02",
+      result == 1,
+      "Failed during testcase", testcase);
+
+  tb->close_trace();
+}
+
+void tb_riscv_tests_zext_h(TB_Riscv_tests * tb) {
+  tb->open_trace("waves/riscv-tests-zext_h.vcd");
+
+  Vecap5_dproc * core = tb->core;
+  tb->reset();  
+
+  tb->set_memory("riscv-tests/tests/rv32uzbb-p-zext_h.elf");
+
+  while(!tb->is_done && tb->tickcount < MAX_TICKCOUNT) {
+    tb->tick();
+  }
+
+  uint32_t testcase;
+  tb->get_register(3, &testcase);
+  uint32_t result;
+  tb->get_register(4, &result);
+
+  CHECK("riscv-tests.zext_h.01",
+      tb->is_done,
+      "Failed to terminate (timeout)");
+
+  CHECK("riscv-tests.zext_h.02",
+      result == 1,
+      "Failed during testcase", testcase);
+
+  tb->close_trace();
+}
+
+void tb_riscv_tests_bclr(TB_Riscv_tests * tb) {
+  tb->open_trace("waves/riscv-tests-bclr.vcd");
+
+  Vecap5_dproc * core = tb->core;
+  tb->reset();  
+
+  tb->set_memory("riscv-tests/tests/rv32uzbs-p-bclr.elf");
+
+  while(!tb->is_done && tb->tickcount < MAX_TICKCOUNT) {
+    tb->tick();
+  }
+
+  uint32_t testcase;
+  tb->get_register(3, &testcase);
+  uint32_t result;
+  tb->get_register(4, &result);
+
+  CHECK("riscv-tests.bclr.01",
+      tb->is_done,
+      "Failed to terminate (timeout)");
+
+  CHECK("riscv-tests.bclr.02",
+      result == 1,
+      "Failed during testcase", testcase);
+
+  tb->close_trace();
+}
+
+void tb_riscv_tests_bclri(TB_Riscv_tests * tb) {
+  tb->open_trace("waves/riscv-tests-bclri.vcd");
+
+  Vecap5_dproc * core = tb->core;
+  tb->reset();  
+
+  tb->set_memory("riscv-tests/tests/rv32uzbs-p-bclri.elf");
+
+  while(!tb->is_done && tb->tickcount < MAX_TICKCOUNT) {
+    tb->tick();
+  }
+
+  uint32_t testcase;
+  tb->get_register(3, &testcase);
+  uint32_t result;
+  tb->get_register(4, &result);
+
+  CHECK("riscv-tests.bclri.01",
+      tb->is_done,
+      "Failed to terminate (timeout)");
+
+  CHECK("riscv-tests.bclri.02",
+      result == 1,
+      "Failed during testcase", testcase);
+
+  tb->close_trace();
+}
+
+void tb_riscv_tests_bext(TB_Riscv_tests * tb) {
+  tb->open_trace("waves/riscv-tests-bext.vcd");
+
+  Vecap5_dproc * core = tb->core;
+  tb->reset();  
+
+  tb->set_memory("riscv-tests/tests/rv32uzbs-p-bext.elf");
+
+  while(!tb->is_done && tb->tickcount < MAX_TICKCOUNT) {
+    tb->tick();
+  }
+
+  uint32_t testcase;
+  tb->get_register(3, &testcase);
+  uint32_t result;
+  tb->get_register(4, &result);
+
+  CHECK("riscv-tests.bext.01",
+      tb->is_done,
+      "Failed to terminate (timeout)");
+
+  CHECK("riscv-tests.bext.02",
+      result == 1,
+      "Failed during testcase", testcase);
+
+  tb->close_trace();
+}
+
+void tb_riscv_tests_bexti(TB_Riscv_tests * tb) {
+  tb->open_trace("waves/riscv-tests-bexti.vcd");
+
+  Vecap5_dproc * core = tb->core;
+  tb->reset();  
+
+  tb->set_memory("riscv-tests/tests/rv32uzbs-p-bexti.elf");
+
+  while(!tb->is_done && tb->tickcount < MAX_TICKCOUNT) {
+    tb->tick();
+  }
+
+  uint32_t testcase;
+  tb->get_register(3, &testcase);
+  uint32_t result;
+  tb->get_register(4, &result);
+
+  CHECK("riscv-tests.bexti.01",
+      tb->is_done,
+      "Failed to terminate (timeout)");
+
+  CHECK("riscv-tests.bexti.02",
+      result == 1,
+      "Failed during testcase", testcase);
+
+  tb->close_trace();
+}
+
+void tb_riscv_tests_binv(TB_Riscv_tests * tb) {
+  tb->open_trace("waves/riscv-tests-binv.vcd");
+
+  Vecap5_dproc * core = tb->core;
+  tb->reset();  
+
+  tb->set_memory("riscv-tests/tests/rv32uzbs-p-binv.elf");
+
+  while(!tb->is_done && tb->tickcount < MAX_TICKCOUNT) {
+    tb->tick();
+  }
+
+  uint32_t testcase;
+  tb->get_register(3, &testcase);
+  uint32_t result;
+  tb->get_register(4, &result);
+
+  CHECK("riscv-tests.binv.01",
+      tb->is_done,
+      "Failed to terminate (timeout)");
+
+  CHECK("riscv-tests.binv.02",
+      result == 1,
+      "Failed during testcase", testcase);
+
+  tb->close_trace();
+}
+
+void tb_riscv_tests_binvi(TB_Riscv_tests * tb) {
+  tb->open_trace("waves/riscv-tests-binvi.vcd");
+
+  Vecap5_dproc * core = tb->core;
+  tb->reset();  
+
+  tb->set_memory("riscv-tests/tests/rv32uzbs-p-binvi.elf");
+
+  while(!tb->is_done && tb->tickcount < MAX_TICKCOUNT) {
+    tb->tick();
+  }
+
+  uint32_t testcase;
+  tb->get_register(3, &testcase);
+  uint32_t result;
+  tb->get_register(4, &result);
+
+  CHECK("riscv-tests.binvi.01",
+      tb->is_done,
+      "Failed to terminate (timeout)");
+
+  CHECK("riscv-tests.binvi.02",
+      result == 1,
+      "Failed during testcase", testcase);
+
+  tb->close_trace();
+}
+
+void tb_riscv_tests_bset(TB_Riscv_tests * tb) {
+  tb->open_trace("waves/riscv-tests-bset.vcd");
+
+  Vecap5_dproc * core = tb->core;
+  tb->reset();  
+
+  tb->set_memory("riscv-tests/tests/rv32uzbs-p-bset.elf");
+
+  while(!tb->is_done && tb->tickcount < MAX_TICKCOUNT) {
+    tb->tick();
+  }
+
+  uint32_t testcase;
+  tb->get_register(3, &testcase);
+  uint32_t result;
+  tb->get_register(4, &result);
+
+  CHECK("riscv-tests.bset.01",
+      tb->is_done,
+      "Failed to terminate (timeout)");
+
+  CHECK("riscv-tests.bset.02",
+      result == 1,
+      "Failed during testcase", testcase);
+
+  tb->close_trace();
+}
+
+void tb_riscv_tests_bseti(TB_Riscv_tests * tb) {
+  tb->open_trace("waves/riscv-tests-bseti.vcd");
+
+  Vecap5_dproc * core = tb->core;
+  tb->reset();  
+
+  tb->set_memory("riscv-tests/tests/rv32uzbs-p-bseti.elf");
+
+  while(!tb->is_done && tb->tickcount < MAX_TICKCOUNT) {
+    tb->tick();
+  }
+
+  uint32_t testcase;
+  tb->get_register(3, &testcase);
+  uint32_t result;
+  tb->get_register(4, &result);
+
+  CHECK("riscv-tests.bseti.01",
+      tb->is_done,
+      "Failed to terminate (timeout)");
+
+  CHECK("riscv-tests.bseti.02",
+      result == 1,
+      "Failed during testcase", testcase);
+
+  tb->close_trace();
+}
+
+int main(int argc, char ** argv, char ** env) {
+  srand(time(NULL));
+  Verilated::traceEverOn(true);
+
+  // Check arguments
+  bool verbose = parse_verbose(argc, argv);
+
+  TB_Riscv_tests * tb = new TB_Riscv_tests();
+  tb->open_testdata("testdata/" RISCV_TESTS_NAME ".csv");
+  tb->set_debug_log(verbose);
+
+  /************************************************************/
+
+  tb_riscv_tests_simple(tb);
+  tb_riscv_tests_add(tb);
+  tb_riscv_tests_addi(tb);
+  tb_riscv_tests_and(tb);
+  tb_riscv_tests_andi(tb);
+  tb_riscv_tests_auipc(tb);
+  tb_riscv_tests_beq(tb);
+  tb_riscv_tests_bge(tb);
+  tb_riscv_tests_bgeu(tb);
+  tb_riscv_tests_blt(tb);
+  tb_riscv_tests_bltu(tb);
+  tb_riscv_tests_bne(tb);
+#ifdef ICACHE
+  tb_riscv_tests_fence_i(tb);
+#endif
+  tb_riscv_tests_jal(tb);
+  tb_riscv_tests_jalr(tb);
+  tb_riscv_tests_lb(tb);
+  tb_riscv_tests_lbu(tb);
+  tb_riscv_tests_lh(tb);
+  tb_riscv_tests_lhu(tb);
+  tb_riscv_tests_lw(tb);
+  tb_riscv_tests_lui(tb);
+#ifdef MISALIGNED_ACCESS
+  tb_riscv_tests_ma_data(tb);
+#endif
+  tb_riscv_tests_or(tb);
+  tb_riscv_tests_ori(tb);
+  tb_riscv_tests_sb(tb);
+  tb_riscv_tests_sh(tb);
+  tb_riscv_tests_sw(tb);
+  tb_riscv_tests_sll(tb);
+  tb_riscv_tests_slli(tb);
+  tb_riscv_tests_slt(tb);
+  tb_riscv_tests_slti(tb);
+  tb_riscv_tests_sltiu(tb);
+  tb_riscv_tests_sltu(tb);
+  tb_riscv_tests_sra(tb);
+  tb_riscv_tests_srai(tb);
+  tb_riscv_tests_srl(tb);
+  tb_riscv_tests_srli(tb);
+  tb_riscv_tests_sub(tb);
+  tb_riscv_tests_xor(tb);
+  tb_riscv_tests_xori(tb);
+
+#ifdef MULDIV
+  tb_riscv_tests_mul(tb);
+  tb_riscv_tests_mulh(tb);
+  tb_riscv_tests_mulhsu(tb);
+  tb_riscv_tests_mulhu(tb);
+  tb_riscv_tests_div(tb);
+  tb_riscv_tests_divu(tb);
+  tb_riscv_tests_rem(tb);
+  tb_riscv_tests_remu(tb);
+#endif
+
+#ifdef ATOMIC
+  tb_riscv_tests_amoadd_w(tb);
+  tb_riscv_tests_amoand_w(tb);
+  tb_riscv_tests_amomax_w(tb);
+  tb_riscv_tests_amomaxu_w(tb);
+  tb_riscv_tests_amomin_w(tb);
+  tb_riscv_tests_amominu_w(tb);
+  tb_riscv_tests_amoor_w(tb);
+  tb_riscv_tests_amoxor_w(tb);
+  tb_riscv_tests_amoswap_w(tb);
+  tb_riscv_tests_lrsc(tb);
+#endif
+
+#ifdef COMPRESSED
+  tb_riscv_tests_rvc(tb);
+#endif
+
+#ifdef BITMANIP
+  tb_riscv_tests_sh1add(tb);
+  tb_riscv_tests_sh2add(tb);
+  tb_riscv_tests_sh3add(tb);
+  tb_riscv_tests_andn(tb);
+  tb_riscv_tests_orn(tb);
+  tb_riscv_tests_xnor(tb);
+  tb_riscv_tests_clz(tb);
+  tb_riscv_tests_ctz(tb);
+  tb_riscv_tests_cpop(tb);
+  tb_riscv_tests_max(tb);
+  tb_riscv_tests_maxu(tb);
+  tb_riscv_tests_min(tb);
+  tb_riscv_tests_minu(tb);
+  tb_riscv_tests_orc_b(tb);
+  tb_riscv_tests_rev8(tb);
+  tb_riscv_tests_rol(tb);
+  tb_riscv_tests_ror(tb);
+  tb_riscv_tests_rori(tb);
+  tb_riscv_tests_sext_b(tb);
+  tb_riscv_tests_sext_h(tb);
+  tb_riscv_tests_zext_h(tb);
+  tb_riscv_tests_bclr(tb);
+  tb_riscv_tests_bclri(tb);
+  tb_riscv_tests_bext(tb);
+  tb_riscv_tests_bexti(tb);
+  tb_riscv_tests_binv(tb);
+  tb_riscv_tests_binvi(tb);
+  tb_riscv_tests_bset(tb);
+  tb_riscv_tests_bseti(tb);
+#endif
 
   /************************************************************/
 
-  printf("[RISCV-TESTS]: ");
+  printf("[" RISCV_TESTS_LABEL "]: ");
   if(tb->success) {
     printf("Done\n");
   } else {